@@ -0,0 +1,1804 @@
+// Console commands for measuring WorldForge generation and rendering costs in a running game.
+// Each command logs its results with the "WorldForge Bench:" prefix.
+
+#include "WorldForgeSubsystem.h"
+#include "WorldForgeSettlementActor.h"
+#include "WorldForgeMaterialCache.h"
+#include "WorldForgeLayoutGenerator.h"
+#include "WorldForgeTerrainGenerator.h"
+#include "WorldForgeHeightCache.h"
+#include "WorldForgeHydrology.h"
+#include "WorldForgeTerritory.h"
+#include "WorldForgeRoads.h"
+#include "WorldForgeScatter.h"
+#include "WorldForgeParameterGraph.h"
+#include "WorldForgeTransitions.h"
+#include "WorldForgeEconomy.h"
+#include "WorldForgeHistory.h"
+#include "WorldForgeSignificance.h"
+#include "WorldForgeNavBatch.h"
+#include "WorldForgePaths.h"
+#include "WorldForgeSpeculation.h"
+#include "WorldForgeWorldStore.h"
+#include "WorldForgeUndo.h"
+#include "WorldForgeReplica.h"
+#include "Async/ParallelFor.h"
+#include "WorldForgeTypes.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Containers/Ticker.h"
+#include "Misc/App.h"
+#include "Math/RandomStream.h"
+#include "Misc/Crc.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "NavigationSystem.h"
+
+namespace WorldForgeBenchmarks
+{
+    static UWorldForgeSubsystem* GetSubsystem(UWorld* World)
+    {
+        UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+        return GameInstance ? GameInstance->GetSubsystem<UWorldForgeSubsystem>() : nullptr;
+    }
+
+    /** Build a synthetic landmark on a square grid centered on the origin */
+    static FWorldForgeLandmark MakeGridLandmark(int32 Index, int32 GridSize, float Spacing)
+    {
+        FWorldForgeLandmark Landmark;
+        Landmark.Id = FString::Printf(TEXT("bench-%d"), Index);
+        Landmark.Name = FString::Printf(TEXT("Bench %d"), Index);
+        Landmark.Type = static_cast<EWorldForgeLandmarkType>(Index % 5);
+        const float HalfExtent = GridSize * Spacing * 0.5f;
+        Landmark.Location = FVector(
+            (Index % GridSize) * Spacing - HalfExtent,
+            (Index / GridSize) * Spacing - HalfExtent,
+            0.0f);
+        return Landmark;
+    }
+
+    /** WorldForge.Bench.Landmarks <Count> <0=Actors|1=Instanced> */
+    static void BenchLandmarks(const TArray<FString>& Args, UWorld* World)
+    {
+        UWorldForgeSubsystem* Subsystem = GetSubsystem(World);
+        if (!Subsystem)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("WorldForge Bench: No WorldForge subsystem for this world"));
+            return;
+        }
+
+        const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000;
+        const EWorldForgeLandmarkRenderMode Mode = (Args.Num() > 1 && FCString::Atoi(*Args[1]) == 0)
+            ? EWorldForgeLandmarkRenderMode::Actors
+            : EWorldForgeLandmarkRenderMode::Instanced;
+
+        Subsystem->DestroyAllSettlements();
+        Subsystem->SetLandmarkRenderMode(Mode);
+
+        const int32 GridSize = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count))));
+        TArray<FWorldForgeLandmark> Landmarks;
+        Landmarks.Reserve(Count);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Landmarks.Add(MakeGridLandmark(Index, GridSize, 3000.0f));
+        }
+
+        const double StartTime = FPlatformTime::Seconds();
+        Subsystem->AddLandmarks(Landmarks);
+        const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Spawned %d landmarks (%s) in %.1f ms (%.2f us/landmark)"),
+               Count,
+               Mode == EWorldForgeLandmarkRenderMode::Instanced ? TEXT("Instanced") : TEXT("Actors"),
+               ElapsedMs,
+               Count > 0 ? ElapsedMs * 1000.0 / Count : 0.0);
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs BenchLandmarksCommand(
+        TEXT("WorldForge.Bench.Landmarks"),
+        TEXT("Spawn N synthetic landmarks and log the time taken. Usage: WorldForge.Bench.Landmarks <Count> <0=Actors|1=Instanced>"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchLandmarks));
+
+    /** WorldForge.Bench.Materials - report shared material usage against one instance per landmark */
+    static void BenchMaterials(const TArray<FString>& Args, UWorld* World)
+    {
+        UWorldForgeSubsystem* Subsystem = GetSubsystem(World);
+        UWorldForgeMaterialCache* Cache = Subsystem ? Subsystem->GetMaterialCache() : nullptr;
+        if (!Cache)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("WorldForge Bench: No WorldForge material cache for this world"));
+            return;
+        }
+
+        const int32 LandmarkCount = Subsystem->GetSpawnedLandmarkCount();
+        const int32 InstanceCount = Cache->GetMaterialInstanceCount();
+        const SIZE_T CachedBytes = Cache->GetMaterialMemoryBytes();
+        const SIZE_T BytesPerInstance = InstanceCount > 0 ? CachedBytes / InstanceCount : 0;
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: %d landmarks share %d material instances (%.1f KB); one instance per landmark would be ~%.1f KB"),
+               LandmarkCount,
+               InstanceCount,
+               CachedBytes / 1024.0,
+               (static_cast<double>(BytesPerInstance) * LandmarkCount) / 1024.0);
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs BenchMaterialsCommand(
+        TEXT("WorldForge.Bench.Materials"),
+        TEXT("Log the shared landmark material count and memory against the per-landmark instance baseline"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchMaterials));
+
+    /** WorldForge.Bench.FrameTime [Frames] - average and worst frame time over the next N frames */
+    static void BenchFrameTime(const TArray<FString>& Args, UWorld* World)
+    {
+        const int32 NumFrames = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 300;
+        UWorldForgeSubsystem* Subsystem = GetSubsystem(World);
+        const int32 LandmarkCount = Subsystem ? Subsystem->GetSpawnedLandmarkCount() : 0;
+
+        struct FFrameSamples
+        {
+            TArray<double> DeltaMs;
+        };
+        TSharedRef<FFrameSamples> Samples = MakeShared<FFrameSamples>();
+        Samples->DeltaMs.Reserve(NumFrames);
+
+        FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Samples, NumFrames, LandmarkCount](float)
+        {
+            Samples->DeltaMs.Add(FApp::GetDeltaTime() * 1000.0);
+            if (Samples->DeltaMs.Num() < NumFrames)
+            {
+                return true;
+            }
+
+            Samples->DeltaMs.Sort();
+            double TotalMs = 0.0;
+            for (double Ms : Samples->DeltaMs)
+            {
+                TotalMs += Ms;
+            }
+
+            UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: %d landmarks, %d frames: avg %.2f ms, p95 %.2f ms, max %.2f ms"),
+                   LandmarkCount,
+                   NumFrames,
+                   TotalMs / NumFrames,
+                   Samples->DeltaMs[FMath::Min(NumFrames - 1, FMath::FloorToInt32(NumFrames * 0.95f))],
+                   Samples->DeltaMs.Last());
+            return false;
+        }));
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs BenchFrameTimeCommand(
+        TEXT("WorldForge.Bench.FrameTime"),
+        TEXT("Log average, p95 and max frame time over the next N frames. Usage: WorldForge.Bench.FrameTime [Frames]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchFrameTime));
+
+    /** WorldForge.Bench.Layouts [Count] - parallel layout generation throughput and determinism */
+    static void BenchLayouts(const TArray<FString>& Args)
+    {
+        const int32 Count = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+
+        FWorldForgeState State;
+        State.Militarism = 0.7f;
+        State.Prosperity = 0.8f;
+        State.Religiosity = 0.6f;
+
+        TArray<FWorldForgeLayoutParams> Params;
+        Params.SetNum(Count);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Params[Index] = FWorldForgeLayoutParams::FromLandmark(MakeGridLandmark(Index, 1, 0.0f), State);
+        }
+
+        TArray<uint32> Hashes;
+        Hashes.SetNumZeroed(Count);
+        TArray<int32> PieceCounts;
+        PieceCounts.SetNumZeroed(Count);
+
+        const double StartTime = FPlatformTime::Seconds();
+        ParallelFor(Count, [&](int32 Index)
+        {
+            const FWorldForgeSettlementLayout Layout = FWorldForgeLayoutGenerator::Generate(Params[Index]);
+            Hashes[Index] = Layout.ComputeHash();
+            PieceCounts[Index] = Layout.NumPieces();
+        });
+        const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        // Regenerate a sample serially; any hash difference means generation is not deterministic
+        int32 Mismatches = 0;
+        for (int32 Index = 0; Index < Count; Index += FMath::Max(1, Count / 32))
+        {
+            if (FWorldForgeLayoutGenerator::Generate(Params[Index]).ComputeHash() != Hashes[Index])
+            {
+                ++Mismatches;
+            }
+        }
+
+        int64 TotalPieces = 0;
+        for (int32 Pieces : PieceCounts)
+        {
+            TotalPieces += Pieces;
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Generated %d layouts (%lld pieces) in %.1f ms, %d determinism mismatches"),
+               Count, TotalPieces, ElapsedMs, Mismatches);
+    }
+
+    static FAutoConsoleCommandWithArgs BenchLayoutsCommand(
+        TEXT("WorldForge.Bench.Layouts"),
+        TEXT("Generate N settlement layouts in parallel, log the time taken and check determinism. Usage: WorldForge.Bench.Layouts [Count]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchLayouts));
+
+    /** WorldForge.Bench.Terrain [Resolution] [Tiles] - heightfield throughput per core and determinism per seed */
+    static void BenchTerrain(const TArray<FString>& Args)
+    {
+        const int32 Resolution = Args.Num() > 0 ? FMath::Max(2, FCString::Atoi(*Args[0])) : 257;
+        const int32 NumTiles = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 64;
+        const float SampleSpacing = 200.0f;
+        const int64 SamplesPerTile = static_cast<int64>(Resolution) * Resolution;
+
+        FWorldForgeState State;
+        State.Seed = 1337;
+        State.Militarism = 0.6f;
+        State.Atmosphere = EWorldForgeAtmosphere::Desolate;
+        const FWorldForgeTerrainParams Params = FWorldForgeTerrainParams::FromState(State);
+
+        // Single core: vectorized tile generation
+        FWorldForgeHeightfieldTile Tile;
+        const int32 SerialTiles = FMath::Max(1, NumTiles / 8);
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < SerialTiles; ++Index)
+        {
+            FWorldForgeTerrainGenerator::GenerateTile(Params, FIntPoint(Index, 0), Resolution, SampleSpacing, Tile);
+        }
+        const double VectorSeconds = FPlatformTime::Seconds() - StartTime;
+
+        // Single core: scalar reference over the same samples
+        TArray<float> Scalar;
+        Scalar.SetNumUninitialized(SamplesPerTile);
+        StartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < SerialTiles; ++Index)
+        {
+            const FVector2D Origin(Index * (Resolution - 1) * SampleSpacing, 0.0);
+            for (int32 Y = 0; Y < Resolution; ++Y)
+            {
+                for (int32 X = 0; X < Resolution; ++X)
+                {
+                    Scalar[Y * Resolution + X] = FWorldForgeTerrainGenerator::SampleHeight(Params,
+                        static_cast<float>(Origin.X) + static_cast<float>(X) * SampleSpacing,
+                        static_cast<float>(Origin.Y) + static_cast<float>(Y) * SampleSpacing);
+                }
+            }
+        }
+        const double ScalarSeconds = FPlatformTime::Seconds() - StartTime;
+
+        // The last tile of both loops covers the same samples; compare the two paths
+        float MaxDifference = 0.0f;
+        for (int64 Index = 0; Index < SamplesPerTile; ++Index)
+        {
+            MaxDifference = FMath::Max(MaxDifference, FMath::Abs(Scalar[Index] - Tile.Heights[Index]));
+        }
+
+        // All cores: one tile per task
+        TArray<uint32> Hashes;
+        Hashes.SetNumZeroed(NumTiles);
+        StartTime = FPlatformTime::Seconds();
+        ParallelFor(NumTiles, [&](int32 Index)
+        {
+            FWorldForgeHeightfieldTile ParallelTile;
+            FWorldForgeTerrainGenerator::GenerateTile(Params, FIntPoint(Index % 8, Index / 8), Resolution, SampleSpacing, ParallelTile);
+            Hashes[Index] = FCrc::MemCrc32(ParallelTile.Heights.GetData(), ParallelTile.Heights.Num() * sizeof(float));
+        });
+        const double ParallelSeconds = FPlatformTime::Seconds() - StartTime;
+        const int32 NumWorkers = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+
+        // Determinism: regenerate serially and compare; another seed must change the result
+        int32 Mismatches = 0;
+        for (int32 Index = 0; Index < NumTiles; Index += FMath::Max(1, NumTiles / 16))
+        {
+            FWorldForgeTerrainGenerator::GenerateTile(Params, FIntPoint(Index % 8, Index / 8), Resolution, SampleSpacing, Tile);
+            if (FCrc::MemCrc32(Tile.Heights.GetData(), Tile.Heights.Num() * sizeof(float)) != Hashes[Index])
+            {
+                ++Mismatches;
+            }
+        }
+
+        FWorldForgeTerrainParams OtherSeed = Params;
+        OtherSeed.Seed += 1;
+        FWorldForgeTerrainGenerator::GenerateTile(OtherSeed, FIntPoint(0, 0), Resolution, SampleSpacing, Tile);
+        const bool bSeedChangesTerrain = FCrc::MemCrc32(Tile.Heights.GetData(), Tile.Heights.Num() * sizeof(float)) != Hashes[0];
+
+        const double SerialSamples = static_cast<double>(SamplesPerTile) * SerialTiles;
+        const double ParallelSamples = static_cast<double>(SamplesPerTile) * NumTiles;
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Terrain %dx%d, %d octaves: vector %.2f M samples/s/core, scalar %.2f M samples/s/core (%.2fx)"),
+               Resolution, Resolution, Params.Octaves,
+               SerialSamples / VectorSeconds / 1.0e6, SerialSamples / ScalarSeconds / 1.0e6, ScalarSeconds / VectorSeconds);
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: %d tiles in parallel in %.1f ms, %.2f M samples/s over %d threads (%.2f M/s/core)"),
+               NumTiles, ParallelSeconds * 1000.0, ParallelSamples / ParallelSeconds / 1.0e6, NumWorkers,
+               ParallelSamples / ParallelSeconds / 1.0e6 / NumWorkers);
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Terrain determinism: %d mismatches, vector/scalar max difference %.6f, seed changes terrain: %s"),
+               Mismatches, MaxDifference, bSeedChangesTerrain ? TEXT("yes") : TEXT("NO"));
+    }
+
+    static FAutoConsoleCommandWithArgs BenchTerrainCommand(
+        TEXT("WorldForge.Bench.Terrain"),
+        TEXT("Generate heightfield tiles, log samples per second per core and check determinism. Usage: WorldForge.Bench.Terrain [Resolution] [Tiles]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchTerrain));
+
+    /** WorldForge.Bench.Streaming - current terrain streaming latency, miss rate and memory */
+    static void BenchStreaming(const TArray<FString>& Args, UWorld* World)
+    {
+        UWorldForgeSubsystem* Subsystem = GetSubsystem(World);
+        if (!Subsystem)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("WorldForge Bench: No WorldForge subsystem for this world"));
+            return;
+        }
+        if (!Subsystem->IsTerrainStreamingEnabled())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("WorldForge Bench: Terrain streaming is off (WorldForge.TerrainStreaming 1 or SetTerrainStreamingEnabled)"));
+            return;
+        }
+
+        const FWorldForgeTileStreamingStats Stats = Subsystem->GetTerrainStreamingStats();
+        const float MissRate = Stats.TileEntries > 0 ? 100.0f * Stats.TileMisses / Stats.TileEntries : 0.0f;
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Streaming %d resident tiles (%.1f MB), %d in flight, %d pending"),
+               Stats.ResidentTiles, Stats.ResidentBytes / (1024.0 * 1024.0), Stats.InFlightJobs, Stats.PendingTiles);
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Tile latency avg %.1f ms, max %.1f ms; %d loaded, %d evicted, %d cancelled; misses %d/%d tile entries (%.1f%%)"),
+               Stats.AverageLatencyMs, Stats.MaxLatencyMs, Stats.TilesLoaded, Stats.TilesEvicted, Stats.JobsCancelled,
+               Stats.TileMisses, Stats.TileEntries, MissRate);
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs BenchStreamingCommand(
+        TEXT("WorldForge.Bench.Streaming"),
+        TEXT("Log terrain streaming tile latency, miss rate, job and memory counters"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchStreaming));
+
+    /** WorldForge.Bench.HeightQueries [Count] - terrain height cache throughput against physics traces */
+    static void BenchHeightQueries(const TArray<FString>& Args, UWorld* World)
+    {
+        const int32 Count = Args.Num() > 0 ? FMath::Max(4, FCString::Atoi(*Args[0])) : 4000000;
+        const int32 TilesPerSide = 4;
+        const int32 Resolution = 129;
+        const float SampleSpacing = 200.0f;
+
+        // Standalone cache so the benchmark does not depend on what terrain is loaded
+        FWorldForgeState State;
+        State.Seed = 7;
+        const FWorldForgeTerrainParams Params = FWorldForgeTerrainParams::FromState(State);
+        FWorldForgeHeightCache Cache;
+        for (int32 TileY = 0; TileY < TilesPerSide; ++TileY)
+        {
+            for (int32 TileX = 0; TileX < TilesPerSide; ++TileX)
+            {
+                TSharedPtr<FWorldForgeHeightfieldTile, ESPMode::ThreadSafe> Tile = MakeShared<FWorldForgeHeightfieldTile, ESPMode::ThreadSafe>();
+                FWorldForgeTerrainGenerator::GenerateTile(Params, FIntPoint(TileX, TileY), Resolution, SampleSpacing, *Tile);
+                Cache.AddTile(Tile);
+            }
+        }
+
+        // Clustered candidates, like a scatterer or placement pass would produce
+        const float Extent = TilesPerSide * (Resolution - 1) * SampleSpacing;
+        FRandomStream Random(42);
+        TArray<FVector2f> Positions;
+        Positions.SetNumUninitialized(Count);
+        for (int32 Index = 0; Index < Count; Index += 64)
+        {
+            const FVector2f Center(Random.FRandRange(0.0f, Extent - 2000.0f), Random.FRandRange(0.0f, Extent - 2000.0f));
+            for (int32 Offset = 0; Offset < 64 && Index + Offset < Count; ++Offset)
+            {
+                Positions[Index + Offset] = Center + FVector2f(Random.FRandRange(0.0f, 2000.0f), Random.FRandRange(0.0f, 2000.0f));
+            }
+        }
+
+        TArray<float> Heights;
+        Heights.SetNumUninitialized(Count);
+        TArray<float> ScalarHeights;
+        ScalarHeights.SetNumUninitialized(Count);
+        TArray<bool> Found;
+        Found.SetNumUninitialized(Count);
+
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Cache.QueryHeight(Positions[Index].X, Positions[Index].Y, ScalarHeights[Index]);
+        }
+        const double SingleSeconds = FPlatformTime::Seconds() - StartTime;
+
+        StartTime = FPlatformTime::Seconds();
+        Cache.QueryHeights(Positions, ScalarHeights, Found, false);
+        const double BatchedScalarSeconds = FPlatformTime::Seconds() - StartTime;
+
+        StartTime = FPlatformTime::Seconds();
+        const int32 NumFound = Cache.QueryHeights(Positions, Heights, Found, true);
+        const double BatchedVectorSeconds = FPlatformTime::Seconds() - StartTime;
+
+        int32 Mismatches = 0;
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Mismatches += Heights[Index] != ScalarHeights[Index] ? 1 : 0;
+        }
+
+        // Batched queries from every worker at once
+        const int32 NumChunks = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+        const int32 ChunkSize = FMath::DivideAndRoundUp(Count, NumChunks);
+        StartTime = FPlatformTime::Seconds();
+        ParallelFor(NumChunks, [&](int32 Chunk)
+        {
+            const int32 First = Chunk * ChunkSize;
+            const int32 Num = FMath::Min(ChunkSize, Count - First);
+            if (Num > 0)
+            {
+                Cache.QueryHeights(MakeArrayView(Positions).Slice(First, Num), MakeArrayView(Heights).Slice(First, Num), MakeArrayView(Found).Slice(First, Num));
+            }
+        });
+        const double ParallelSeconds = FPlatformTime::Seconds() - StartTime;
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: %d height queries (%d on terrain): single %.1f M/s, batched scalar %.1f M/s, batched vector %.1f M/s, parallel %.1f M/s over %d threads; %d vector/scalar mismatches"),
+               Count, NumFound,
+               Count / SingleSeconds / 1.0e6, Count / BatchedScalarSeconds / 1.0e6, Count / BatchedVectorSeconds / 1.0e6,
+               Count / ParallelSeconds / 1.0e6, NumChunks, Mismatches);
+
+        // Physics trace baseline against whatever terrain the subsystem has loaded
+        UWorldForgeSubsystem* Subsystem = GetSubsystem(World);
+        if (!World || !Subsystem || Subsystem->GetTerrainTileCount() == 0)
+        {
+            UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: No generated terrain in this world, skipping the line trace baseline (call GenerateTerrain first)"));
+            return;
+        }
+
+        const int32 NumTraces = FMath::Min(Count, 100000);
+        const float TraceExtent = 2000.0f;
+        int32 NumHits = 0;
+        StartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < NumTraces; ++Index)
+        {
+            const FVector Start(Random.FRandRange(-TraceExtent, TraceExtent), Random.FRandRange(-TraceExtent, TraceExtent), 100000.0f);
+            FHitResult Hit;
+            if (World->LineTraceSingleByChannel(Hit, Start, Start - FVector(0.0, 0.0, 200000.0), ECC_WorldStatic))
+            {
+                ++NumHits;
+            }
+        }
+        const double TraceSeconds = FPlatformTime::Seconds() - StartTime;
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: %d line traces (%d hits): %.2f M/s; batched vector cache is %.0fx faster"),
+               NumTraces, NumHits, NumTraces / TraceSeconds / 1.0e6, (NumTraces / TraceSeconds) > 0.0 ? (Count / BatchedVectorSeconds) / (NumTraces / TraceSeconds) : 0.0);
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs BenchHeightQueriesCommand(
+        TEXT("WorldForge.Bench.HeightQueries"),
+        TEXT("Compare terrain height cache queries (single, batched, vectorized, parallel) against line traces. Usage: WorldForge.Bench.HeightQueries [Count]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchHeightQueries));
+
+    /** WorldForge.Bench.Hydrology [Size] - depression fill, flow directions, accumulation and rivers on a Size x Size grid */
+    static void BenchHydrology(const TArray<FString>& Args)
+    {
+        const int32 Size = Args.Num() > 0 ? FMath::Max(16, FCString::Atoi(*Args[0])) : 4096;
+        const float SampleSpacing = 200.0f;
+
+        FWorldForgeState State;
+        State.Seed = 99;
+        State.Prosperity = 0.7f;
+        State.Openness = 0.7f;
+        const FWorldForgeTerrainParams Params = FWorldForgeTerrainParams::FromState(State);
+        const FWorldForgeHydrologySettings Settings = FWorldForgeHydrologySettings::FromState(State);
+
+        double StartTime = FPlatformTime::Seconds();
+        TArray<float> Heights;
+        FWorldForgeTerrainGenerator::GenerateRegion(Params, FVector2D::ZeroVector, Size, Size, SampleSpacing, Heights, true);
+        const double GenerateSeconds = FPlatformTime::Seconds() - StartTime;
+
+        FWorldForgeHydrologyGrid Grid;
+        Grid.Width = Size;
+        Grid.Height = Size;
+        Grid.SampleSpacing = SampleSpacing;
+        Grid.Filled = Heights;
+
+        StartTime = FPlatformTime::Seconds();
+        FWorldForgeHydrology::FillDepressions(Grid.Filled, Size, Size);
+        const double FillSeconds = FPlatformTime::Seconds() - StartTime;
+
+        StartTime = FPlatformTime::Seconds();
+        FWorldForgeHydrology::ComputeFlowDirections(Grid.Filled, Size, Size, Grid.FlowDirection);
+        const double DirectionSeconds = FPlatformTime::Seconds() - StartTime;
+
+        StartTime = FPlatformTime::Seconds();
+        FWorldForgeHydrology::AccumulateFlow(Grid.FlowDirection, Size, Size, Settings.Rainfall, Grid.Accumulation);
+        const double AccumulateSeconds = FPlatformTime::Seconds() - StartTime;
+
+        StartTime = FPlatformTime::Seconds();
+        FWorldForgeHydrology::ExtractRivers(Grid, Settings);
+        const double RiverSeconds = FPlatformTime::Seconds() - StartTime;
+
+        int64 WaterCells = 0;
+        for (const uint8 Water : Grid.WaterMask)
+        {
+            WaterCells += Water;
+        }
+
+        // Parallel accumulation must not depend on scheduling: a second run has to match bit for bit
+        TArray<float> SecondAccumulation;
+        FWorldForgeHydrology::AccumulateFlow(Grid.FlowDirection, Size, Size, Settings.Rainfall, SecondAccumulation);
+        const bool bDeterministic = FMemory::Memcmp(Grid.Accumulation.GetData(), SecondAccumulation.GetData(), Grid.Accumulation.Num() * sizeof(float)) == 0;
+
+        // Filled heights must drain: every interior cell has a flow direction
+        int64 Undrained = 0;
+        for (int32 Y = 1; Y < Size - 1; ++Y)
+        {
+            for (int32 X = 1; X < Size - 1; ++X)
+            {
+                Undrained += Grid.FlowDirection[Y * Size + X] == FWorldForgeHydrologyGrid::NoFlow ? 1 : 0;
+            }
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Hydrology %dx%d: heights %.1f ms, fill %.1f ms, D8 %.1f ms, accumulation %.1f ms, rivers %.1f ms (total %.1f ms excluding heights)"),
+               Size, Size, GenerateSeconds * 1000.0, FillSeconds * 1000.0, DirectionSeconds * 1000.0, AccumulateSeconds * 1000.0, RiverSeconds * 1000.0,
+               (FillSeconds + DirectionSeconds + AccumulateSeconds + RiverSeconds) * 1000.0);
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: %d rivers, %lld water cells, %lld undrained interior cells, accumulation deterministic: %s"),
+               Grid.Rivers.Num(), WaterCells, Undrained, bDeterministic ? TEXT("yes") : TEXT("NO"));
+    }
+
+    static FAutoConsoleCommandWithArgs BenchHydrologyCommand(
+        TEXT("WorldForge.Bench.Hydrology"),
+        TEXT("Time each hydrology stage on a generated Size x Size heightfield and check determinism. Usage: WorldForge.Bench.Hydrology [Size]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchHydrology));
+
+    /** WorldForge.Bench.Territory [Sites] [Changes] - full jump flooding rebuild vs incremental spawn/destroy updates */
+    static void BenchTerritory(const TArray<FString>& Args)
+    {
+        const int32 NumSites = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 500;
+        const int32 NumChanges = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 200;
+
+        FWorldForgeState State;
+        State.Militarism = 0.6f;
+        State.Openness = 0.4f;
+        const FWorldForgeTerritorySettings Settings = FWorldForgeTerritorySettings::FromState(State);
+        const float HalfExtent = 0.5f * Settings.Resolution * Settings.CellSize;
+
+        FRandomStream Random(1234);
+        auto MakeSite = [&Random, HalfExtent](int32 Index)
+        {
+            FWorldForgeLandmark Landmark;
+            Landmark.Id = FString::Printf(TEXT("bench-%d"), Index);
+            Landmark.Type = static_cast<EWorldForgeLandmarkType>(Random.RandRange(0, 3));
+            Landmark.Location = FVector(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.0f);
+            return Landmark;
+        };
+
+        FWorldForgeTerritoryMap Map;
+        Map.SetSettings(Settings);
+        for (int32 Index = 0; Index < NumSites; ++Index)
+        {
+            Map.AddSite(MakeSite(Index));
+        }
+
+        TArray<FIntPoint> DirtyChunks;
+        double StartTime = FPlatformTime::Seconds();
+        Map.Update(DirtyChunks);
+        const double FullSeconds = FPlatformTime::Seconds() - StartTime;
+
+        // One spawn or destroy per Update, as when commands arrive one at a time
+        int64 IncrementalChunks = 0;
+        StartTime = FPlatformTime::Seconds();
+        for (int32 Change = 0; Change < NumChanges; ++Change)
+        {
+            const int32 Index = NumSites + Change;
+            Map.AddSite(MakeSite(Index));
+            Map.Update(DirtyChunks);
+            IncrementalChunks += DirtyChunks.Num();
+
+            if (Change % 2 == 1)
+            {
+                Map.RemoveSite(FString::Printf(TEXT("bench-%d"), Index - 1));
+                Map.Update(DirtyChunks);
+                IncrementalChunks += DirtyChunks.Num();
+            }
+        }
+        const int32 NumUpdates = NumChanges + NumChanges / 2;
+        const double IncrementalSeconds = (FPlatformTime::Seconds() - StartTime) / NumUpdates;
+
+        // The incremental result should agree with rebuilding from scratch, up to jump flooding's rare misses
+        TArray<const FString*> IncrementalOwners;
+        const int32 NumCells = Settings.Resolution * Settings.Resolution;
+        IncrementalOwners.SetNumUninitialized(NumCells);
+        for (int32 Cell = 0; Cell < NumCells; ++Cell)
+        {
+            IncrementalOwners[Cell] = Map.GetCellOwner(Cell);
+        }
+
+        StartTime = FPlatformTime::Seconds();
+        Map.Rebuild();
+        const double RebuildSeconds = FPlatformTime::Seconds() - StartTime;
+
+        int32 Mismatches = 0;
+        int32 Claimed = 0;
+        for (int32 Cell = 0; Cell < NumCells; ++Cell)
+        {
+            const FString* Owner = Map.GetCellOwner(Cell);
+            Claimed += Owner ? 1 : 0;
+            Mismatches += (Owner == nullptr) != (IncrementalOwners[Cell] == nullptr) || (Owner && *Owner != *IncrementalOwners[Cell]) ? 1 : 0;
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Territory %dx%d with %d sites: full rebuild %.2f ms (again %.2f ms), incremental update %.3f ms (%.0fx faster, %.1f chunks redrawn per update)"),
+               Settings.Resolution, Settings.Resolution, Map.NumSites(), FullSeconds * 1000.0, RebuildSeconds * 1000.0, IncrementalSeconds * 1000.0,
+               IncrementalSeconds > 0.0 ? RebuildSeconds / IncrementalSeconds : 0.0, static_cast<double>(IncrementalChunks) / NumUpdates);
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: %d claimed cells, %d cells differ between incremental and rebuilt maps (%.4f%%)"),
+               Claimed, Mismatches, 100.0 * Mismatches / NumCells);
+    }
+
+    static FAutoConsoleCommandWithArgs BenchTerritoryCommand(
+        TEXT("WorldForge.Bench.Territory"),
+        TEXT("Compare a full territory rebuild with incremental updates for single spawns and destroys. Usage: WorldForge.Bench.Territory [Sites] [Changes]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchTerritory));
+
+    /** WorldForge.Bench.Roads [Sites] - road selection, serial vs parallel A* routing, and re-routing after one spawn */
+    static void BenchRoads(const TArray<FString>& Args)
+    {
+        const int32 NumSites = Args.Num() > 0 ? FMath::Max(2, FCString::Atoi(*Args[0])) : 300;
+        constexpr int32 TilesPerSide = 4;
+        constexpr int32 Resolution = 129;
+        constexpr float SampleSpacing = 200.0f;
+
+        FWorldForgeState State;
+        State.Seed = 7;
+        State.Militarism = 0.6f;
+        State.Openness = 0.6f;
+        const FWorldForgeTerrainParams Params = FWorldForgeTerrainParams::FromState(State);
+        const FWorldForgeRoadSettings Settings = FWorldForgeRoadSettings::FromState(State);
+
+        // Terrain for the routes to climb around
+        FWorldForgeHeightCache Heights;
+        for (int32 TileY = -TilesPerSide / 2; TileY < TilesPerSide / 2; ++TileY)
+        {
+            for (int32 TileX = -TilesPerSide / 2; TileX < TilesPerSide / 2; ++TileX)
+            {
+                TSharedPtr<FWorldForgeHeightfieldTile, ESPMode::ThreadSafe> Tile = MakeShared<FWorldForgeHeightfieldTile, ESPMode::ThreadSafe>();
+                FWorldForgeTerrainGenerator::GenerateTile(Params, FIntPoint(TileX, TileY), Resolution, SampleSpacing, *Tile);
+                Heights.AddTile(Tile);
+            }
+        }
+
+        const float HalfExtent = 0.5f * TilesPerSide * (Resolution - 1) * SampleSpacing;
+        FRandomStream Random(4321);
+        TArray<FWorldForgeLandmark> Landmarks;
+        TArray<FVector2D> Locations;
+        for (int32 Index = 0; Index < NumSites + 1; ++Index)
+        {
+            FWorldForgeLandmark& Landmark = Landmarks.AddDefaulted_GetRef();
+            Landmark.Id = FString::Printf(TEXT("bench-%05d"), Index);
+            Landmark.Type = EWorldForgeLandmarkType::Settlement;
+            Landmark.Location = FVector(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.0f);
+            float Ground = 0.0f;
+            if (Heights.QueryHeight(static_cast<float>(Landmark.Location.X), static_cast<float>(Landmark.Location.Y), Ground))
+            {
+                Landmark.Location.Z = Ground;
+            }
+
+            // The last landmark is held back for the incremental run
+            if (Index < NumSites)
+            {
+                Locations.Add(FVector2D(Landmark.Location));
+            }
+        }
+
+        double StartTime = FPlatformTime::Seconds();
+        TArray<FWorldForgeRoadEdge> Candidates;
+        TArray<FWorldForgeRoadEdge> Selected;
+        FWorldForgeRoadPlanner::BuildCandidateGraph(Locations, Settings.MaxEdgeLength, Candidates);
+        FWorldForgeRoadPlanner::SelectRoads(NumSites, Candidates, Settings.MaxDetour, Selected);
+        const double SelectSeconds = FPlatformTime::Seconds() - StartTime;
+
+        TArray<FWorldForgeRoad> SerialRoads;
+        SerialRoads.SetNum(Selected.Num());
+        StartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < Selected.Num(); ++Index)
+        {
+            FWorldForgeRoadPlanner::Route(Landmarks[Selected[Index].A].Location, Landmarks[Selected[Index].B].Location, Settings, &Heights, nullptr, SerialRoads[Index]);
+        }
+        const double SerialSeconds = FPlatformTime::Seconds() - StartTime;
+
+        TArray<FWorldForgeRoad> ParallelRoads;
+        ParallelRoads.SetNum(Selected.Num());
+        StartTime = FPlatformTime::Seconds();
+        ParallelFor(Selected.Num(), [&](int32 Index)
+        {
+            FWorldForgeRoadPlanner::Route(Landmarks[Selected[Index].A].Location, Landmarks[Selected[Index].B].Location, Settings, &Heights, nullptr, ParallelRoads[Index]);
+        });
+        const double ParallelSeconds = FPlatformTime::Seconds() - StartTime;
+
+        int32 Mismatches = 0;
+        int64 RoutePoints = 0;
+        for (int32 Index = 0; Index < Selected.Num(); ++Index)
+        {
+            Mismatches += SerialRoads[Index].Cost != ParallelRoads[Index].Cost || SerialRoads[Index].Points.Num() != ParallelRoads[Index].Points.Num() ? 1 : 0;
+            RoutePoints += SerialRoads[Index].Points.Num();
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Roads over %d sites: %d candidates, %d roads selected in %.2f ms; routing serial %.1f ms, parallel %.1f ms (%.1fx), %lld route points, %d serial/parallel mismatches"),
+               NumSites, Candidates.Num(), Selected.Num(), SelectSeconds * 1000.0, SerialSeconds * 1000.0, ParallelSeconds * 1000.0,
+               ParallelSeconds > 0.0 ? SerialSeconds / ParallelSeconds : 0.0, RoutePoints, Mismatches);
+
+        // One more landmark only routes the roads that appear because of it
+        FWorldForgeRoadNetwork Network;
+        Network.SetSettings(Settings);
+        for (int32 Index = 0; Index < NumSites; ++Index)
+        {
+            Network.AddSite(Landmarks[Index]);
+        }
+
+        TArray<FWorldForgeRoadNetwork::FRouteRequest> Requests;
+        TArray<FString> Removed;
+        Network.Update(Requests, Removed);
+        const int32 InitialRoads = Requests.Num();
+
+        StartTime = FPlatformTime::Seconds();
+        Network.AddSite(Landmarks[NumSites]);
+        Network.Update(Requests, Removed);
+        ParallelFor(Requests.Num(), [&](int32 Index)
+        {
+            FWorldForgeRoad Road;
+            FWorldForgeRoadPlanner::Route(Requests[Index].Start, Requests[Index].End, Settings, &Heights, nullptr, Road);
+        });
+        const double IncrementalSeconds = FPlatformTime::Seconds() - StartTime;
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Adding a landmark to %d roads re-routed %d and removed %d in %.2f ms, vs %.1f ms to route the whole network"),
+               InitialRoads, Requests.Num(), Removed.Num(), IncrementalSeconds * 1000.0, ParallelSeconds * 1000.0);
+    }
+
+    static FAutoConsoleCommandWithArgs BenchRoadsCommand(
+        TEXT("WorldForge.Bench.Roads"),
+        TEXT("Time road selection and A* routing (serial vs parallel) over generated terrain, and re-routing after one spawn. Usage: WorldForge.Bench.Roads [Sites]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchRoads));
+
+    /** WorldForge.Bench.Scatter [Landmarks] - scatter every cell serial vs parallel, then the cells redone after a trait change and a spawn */
+    static void BenchScatter(const TArray<FString>& Args)
+    {
+        const int32 NumLandmarks = Args.Num() > 0 ? FMath::Max(0, FCString::Atoi(*Args[0])) : 100;
+        constexpr int32 TilesPerSide = 4;
+        constexpr int32 Resolution = 129;
+        constexpr float SampleSpacing = 200.0f;
+        constexpr float CellSize = 12800.0f;
+
+        FWorldForgeState State;
+        State.Seed = 7;
+        const FWorldForgeTerrainParams Params = FWorldForgeTerrainParams::FromState(State);
+
+        FWorldForgeHeightCache Heights;
+        for (int32 TileY = -TilesPerSide / 2; TileY < TilesPerSide / 2; ++TileY)
+        {
+            for (int32 TileX = -TilesPerSide / 2; TileX < TilesPerSide / 2; ++TileX)
+            {
+                TSharedPtr<FWorldForgeHeightfieldTile, ESPMode::ThreadSafe> Tile = MakeShared<FWorldForgeHeightfieldTile, ESPMode::ThreadSafe>();
+                FWorldForgeTerrainGenerator::GenerateTile(Params, FIntPoint(TileX, TileY), Resolution, SampleSpacing, *Tile);
+                Heights.AddTile(Tile);
+            }
+        }
+
+        const float HalfExtent = 0.5f * TilesPerSide * (Resolution - 1) * SampleSpacing;
+        const int32 CellsPerSide = FMath::CeilToInt32(2.0f * HalfExtent / CellSize);
+        FRandomStream Random(4321);
+        TArray<FVector2D> Landmarks;
+        for (int32 Index = 0; Index < NumLandmarks; ++Index)
+        {
+            Landmarks.Add(FVector2D(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent)));
+        }
+
+        FWorldForgeScatterGrid Grid;
+        Grid.SetGrid(CellsPerSide, CellSize);
+        TArray<FWorldForgeScatterLayerParams> Layers;
+        FWorldForgeScatter::MakeLayers(State, Layers);
+        Grid.SetLayers(MoveTemp(Layers));
+
+        // Every (cell, layer) of the requests, generated with all landmarks as the exclusion set
+        auto Generate = [&](const TArray<FWorldForgeScatterGrid::FCellRequest>& Requests, bool bParallel, int64& OutInstances)
+        {
+            TArray<TPair<int32, int32>> Jobs;
+            for (int32 Index = 0; Index < Requests.Num(); ++Index)
+            {
+                for (int32 Layer = 0; Layer < FWorldForgeScatter::NumLayers; ++Layer)
+                {
+                    if (Requests[Index].LayerMask & (1u << Layer))
+                    {
+                        Jobs.Emplace(Index, Layer);
+                    }
+                }
+            }
+
+            TArray<TArray<FTransform>> Results;
+            Results.SetNum(Jobs.Num());
+            const double StartTime = FPlatformTime::Seconds();
+            auto RunJob = [&](int32 Job)
+            {
+                const FWorldForgeScatterGrid::FCellRequest& Request = Requests[Jobs[Job].Key];
+                FWorldForgeScatter::GenerateCell(Grid.GetLayers()[Jobs[Job].Value], Request.Cell, Grid.GetCellBounds(Request.Cell),
+                                                 Landmarks, Heights, nullptr, Results[Job]);
+            };
+            if (bParallel)
+            {
+                ParallelFor(Jobs.Num(), RunJob);
+            }
+            else
+            {
+                for (int32 Job = 0; Job < Jobs.Num(); ++Job)
+                {
+                    RunJob(Job);
+                }
+            }
+            const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+            OutInstances = 0;
+            for (const TArray<FTransform>& Result : Results)
+            {
+                OutInstances += Result.Num();
+            }
+            return Seconds;
+        };
+
+        TArray<FWorldForgeScatterGrid::FCellRequest> Requests;
+        Grid.TakeDirtyCells(FVector2D::ZeroVector, MAX_int32, Requests);
+        int64 SerialInstances = 0;
+        int64 ParallelInstances = 0;
+        const double SerialSeconds = Generate(Requests, false, SerialInstances);
+        const double ParallelSeconds = Generate(Requests, true, ParallelInstances);
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Scatter over %dx%d cells, %d landmarks: %lld instances, serial %.1f ms, parallel %.1f ms (%.1fx)%s"),
+               CellsPerSide, CellsPerSide, NumLandmarks, SerialInstances, SerialSeconds * 1000.0, ParallelSeconds * 1000.0,
+               ParallelSeconds > 0.0 ? SerialSeconds / ParallelSeconds : 0.0,
+               SerialInstances != ParallelInstances ? TEXT(" - MISMATCH") : TEXT(""));
+
+        // A religiosity change only touches the layers whose density depends on it
+        State.Religiosity = 0.9f;
+        FWorldForgeScatter::MakeLayers(State, Layers);
+        Grid.SetLayers(MoveTemp(Layers));
+        Grid.TakeDirtyCells(FVector2D::ZeroVector, MAX_int32, Requests);
+        int64 TraitInstances = 0;
+        const double TraitSeconds = Generate(Requests, true, TraitInstances);
+
+        int32 TraitJobs = 0;
+        for (const FWorldForgeScatterGrid::FCellRequest& Request : Requests)
+        {
+            TraitJobs += FMath::CountBits(Request.LayerMask);
+        }
+
+        // A spawn only touches the cells within the largest landmark radius
+        const FVector2D Spawn(0.0, 0.0);
+        Landmarks.Add(Spawn);
+        const FVector2D Extent(Grid.GetMaxLandmarkRadius());
+        Grid.MarkRegionDirty(FBox2D(Spawn - Extent, Spawn + Extent));
+        Grid.TakeDirtyCells(FVector2D::ZeroVector, MAX_int32, Requests);
+        int64 SpawnInstances = 0;
+        const double SpawnSeconds = Generate(Requests, true, SpawnInstances);
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Religiosity change regenerated %d of %d cell layers in %.2f ms; a spawn regenerated %d cells in %.2f ms"),
+               TraitJobs, CellsPerSide * CellsPerSide * FWorldForgeScatter::NumLayers, TraitSeconds * 1000.0, Requests.Num(), SpawnSeconds * 1000.0);
+    }
+
+    static FAutoConsoleCommandWithArgs BenchScatterCommand(
+        TEXT("WorldForge.Bench.Scatter"),
+        TEXT("Time trait-driven scatter generation (serial vs parallel) over generated terrain, and the partial regeneration after a trait change and a spawn. Usage: WorldForge.Bench.Scatter [Landmarks]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchScatter));
+
+    /** WorldForge.Bench.Parameters [Steps] - a slider drag on each trait through the parameter graph vs re-deriving every system */
+    static void BenchParameters(const TArray<FString>& Args)
+    {
+        const int32 NumSteps = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+
+        for (int32 Trait = 0; Trait < 5; ++Trait)
+        {
+            const EWorldForgeTrait TraitEnum = static_cast<EWorldForgeTrait>(Trait);
+
+            FWorldForgeParameterGraph Graph;
+            const FWorldForgeParameterRules Rules = FWorldForgeParameterRules::AddDefaultRules(Graph);
+            int32 Notifications = 0;
+            Graph.AddConsumer(Rules.Roads, TEXT("Roads"), [&Notifications]() { ++Notifications; });
+            Graph.AddConsumer(Rules.Scatter, TEXT("Scatter"), [&Notifications]() { ++Notifications; });
+
+            FWorldForgeState State;
+            Graph.SetState(State);
+            Graph.Evaluate();
+            const int64 InitialEvaluations = Graph.GetStats().Evaluations;
+            Notifications = 0;
+
+            // Drag the trait from 0 to 1 in small steps, evaluating after each one as a tick would
+            double StartTime = FPlatformTime::Seconds();
+            for (int32 Step = 0; Step < NumSteps; ++Step)
+            {
+                State.SetTrait(TraitEnum, static_cast<float>(Step) / (NumSteps - 1 > 0 ? NumSteps - 1 : 1));
+                Graph.SetState(State);
+                Graph.Evaluate();
+            }
+            const double GraphSeconds = FPlatformTime::Seconds() - StartTime;
+            const FWorldForgeParameterGraph::FStats Stats = Graph.GetStats();
+
+            // The same drag re-deriving every system's parameters on every step
+            uint32 Checksum = 0;
+            StartTime = FPlatformTime::Seconds();
+            for (int32 Step = 0; Step < NumSteps; ++Step)
+            {
+                State.SetTrait(TraitEnum, static_cast<float>(Step) / (NumSteps - 1 > 0 ? NumSteps - 1 : 1));
+                const FWorldForgeTerritorySettings Territory = FWorldForgeTerritorySettings::FromState(State);
+                const FWorldForgeRoadSettings Roads = FWorldForgeRoadSettings::FromState(State);
+                TArray<FWorldForgeScatterLayerParams> Layers;
+                FWorldForgeScatter::MakeLayers(State, Layers);
+                Checksum += GetTypeHash(Territory.ContestedRatio) ^ GetTypeHash(Roads.MaxDetour) ^ GetTypeHash(Layers[0].Density);
+            }
+            const double FullSeconds = FPlatformTime::Seconds() - StartTime;
+
+            UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Parameters, %d-step drag on trait %d: %lld rule evaluations (%lld unchanged) of %d rules, %d consumer notifications, %.3f ms; re-deriving everything %.3f ms (checksum %u)"),
+                   NumSteps, Trait, Stats.Evaluations - InitialEvaluations, Stats.UnchangedEvaluations, Stats.NumRules, Notifications,
+                   GraphSeconds * 1000.0, FullSeconds * 1000.0, Checksum);
+        }
+    }
+
+    static FAutoConsoleCommandWithArgs BenchParametersCommand(
+        TEXT("WorldForge.Bench.Parameters"),
+        TEXT("Drag each trait through the trait-to-parameter rule graph and count the rules and consumers it touches. Usage: WorldForge.Bench.Parameters [Steps]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchParameters));
+
+    /** WorldForge.Bench.Transitions [Seconds] - eased trait and atmosphere channels under frequent retargeting at 60 Hz */
+    static void BenchTransitions(const TArray<FString>& Args)
+    {
+        const float SimSeconds = Args.Num() > 0 ? FMath::Max(1.0f, FCString::Atof(*Args[0])) : 600.0f;
+        const float DeltaTime = 1.0f / 60.0f;
+        const int32 NumTicks = FMath::CeilToInt(SimSeconds / DeltaTime);
+
+        FWorldForgeTransitions Transitions;
+        FWorldForgeState State;
+        Transitions.Reset(State);
+        FRandomStream Random(1234);
+
+        // A trait changes every half second and the atmosphere every two, so most ticks interrupt a running fade
+        float Previous[FWorldForgeTransitions::NumChannels];
+        float MaxStep = 0.0f;
+        float MaxWeightError = 0.0f;
+        int32 ActiveTicks = 0;
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+        {
+            if (Tick % 30 == 0)
+            {
+                State.SetTrait(static_cast<EWorldForgeTrait>(Random.RandHelper(5)), Random.GetFraction());
+            }
+            if (Tick % 120 == 0)
+            {
+                State.Atmosphere = static_cast<EWorldForgeAtmosphere>(Random.RandHelper(6));
+            }
+
+            FMemory::Memcpy(Previous, Transitions.GetValues().GetData(), sizeof(Previous));
+            Transitions.SetTargets(State);
+            ActiveTicks += Transitions.Advance(DeltaTime) ? 1 : 0;
+
+            const TConstArrayView<float> Values = Transitions.GetValues();
+            float WeightSum = 0.0f;
+            for (int32 Channel = 0; Channel < FWorldForgeTransitions::NumChannels; ++Channel)
+            {
+                MaxStep = FMath::Max(MaxStep, FMath::Abs(Values[Channel] - Previous[Channel]));
+                if (Channel >= FWorldForgeTransitions::FirstAtmosphereChannel && Channel < FWorldForgeTransitions::FirstAtmosphereChannel + 6)
+                {
+                    WeightSum += Values[Channel];
+                }
+            }
+            MaxWeightError = FMath::Max(MaxWeightError, FMath::Abs(WeightSum - 1.0f));
+        }
+        const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Transitions, %d ticks (%.0f s at 60 Hz), %d active: %.3f ms total, %.1f ns/tick for %d channels; largest per-tick change %.4f, atmosphere weight sum error %.5f"),
+               NumTicks, SimSeconds, ActiveTicks, Seconds * 1000.0, Seconds * 1e9 / NumTicks, FWorldForgeTransitions::NumChannels,
+               MaxStep, MaxWeightError);
+    }
+
+    static FAutoConsoleCommandWithArgs BenchTransitionsCommand(
+        TEXT("WorldForge.Bench.Transitions"),
+        TEXT("Advance the eased trait and atmosphere channels at 60 Hz under frequent retargeting and report the per-tick cost and largest jump. Usage: WorldForge.Bench.Transitions [Seconds]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchTransitions));
+
+    /** WorldForge.Bench.Economy [Settlements] [Steps] - fixed-step economy cost, parallel vs serial, and determinism */
+    static void BenchEconomy(const TArray<FString>& Args)
+    {
+        const int32 NumSettlements = Args.Num() > 0 ? FMath::Max(2, FCString::Atoi(*Args[0])) : 10000;
+        const int32 NumSteps = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 100;
+
+        // About one settlement per 5000 x 5000 units, so each has a handful of trade partners in range
+        FRandomStream Random(42);
+        const float HalfSize = FMath::Sqrt(static_cast<float>(NumSettlements)) * 2500.0f;
+        TArray<FWorldForgeLandmark> Landmarks;
+        Landmarks.Reserve(NumSettlements);
+        for (int32 Index = 0; Index < NumSettlements; ++Index)
+        {
+            FWorldForgeLandmark& Landmark = Landmarks.AddDefaulted_GetRef();
+            Landmark.Id = FString::Printf(TEXT("econ_%d"), Index);
+            const int32 Roll = Random.RandHelper(10);
+            Landmark.Type = Roll < 7 ? EWorldForgeLandmarkType::Settlement : (Roll < 9 ? EWorldForgeLandmarkType::Fortress : EWorldForgeLandmarkType::Monastery);
+            Landmark.Location = FVector(Random.FRandRange(-HalfSize, HalfSize), Random.FRandRange(-HalfSize, HalfSize), 0.0f);
+        }
+
+        FWorldForgeState State;
+        State.Seed = 7;
+        const FWorldForgeEconomySettings Settings = FWorldForgeEconomySettings::FromState(State);
+
+        auto Run = [&](bool bParallel, bool bReverse, double& OutRebuildMs, double& OutAverageMs, double& OutMaxMs) -> uint32
+        {
+            FWorldForgeEconomy Economy;
+            Economy.SetSettings(Settings);
+            for (int32 Index = 0; Index < NumSettlements; ++Index)
+            {
+                Economy.AddSettlement(Landmarks[bReverse ? NumSettlements - 1 - Index : Index]);
+            }
+
+            // The first step also sorts the settlements and builds the routes
+            double StartTime = FPlatformTime::Seconds();
+            Economy.Step(bParallel);
+            OutRebuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+            OutMaxMs = 0.0;
+            StartTime = FPlatformTime::Seconds();
+            for (int32 Step = 1; Step < NumSteps; ++Step)
+            {
+                const double StepStart = FPlatformTime::Seconds();
+                Economy.Step(bParallel);
+                OutMaxMs = FMath::Max(OutMaxMs, (FPlatformTime::Seconds() - StepStart) * 1000.0);
+            }
+            OutAverageMs = NumSteps > 1 ? (FPlatformTime::Seconds() - StartTime) * 1000.0 / (NumSteps - 1) : 0.0;
+
+            const FWorldForgeEconomyMetrics& Metrics = Economy.GetMetrics();
+            UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Economy %s%s, %d settlements, %d routes: first step %.2f ms, then %.3f ms avg / %.3f ms max per step; population %.0f, wealth %.0f, trade %.1f, %d starving"),
+                   bParallel ? TEXT("parallel") : TEXT("serial"), bReverse ? TEXT(" (reverse insertion)") : TEXT(""),
+                   Economy.Num(), Economy.NumTradeRoutes(), OutRebuildMs, OutAverageMs, OutMaxMs,
+                   Metrics.TotalPopulation, Metrics.TotalWealth, Metrics.TradeVolume, Metrics.StarvingSettlements);
+            return Economy.GetChecksum();
+        };
+
+        double RebuildMs, ParallelMs, ParallelMaxMs, SerialMs, SerialMaxMs, ReverseMs, ReverseMaxMs;
+        const uint32 ParallelChecksum = Run(true, false, RebuildMs, ParallelMs, ParallelMaxMs);
+        const uint32 SerialChecksum = Run(false, false, RebuildMs, SerialMs, SerialMaxMs);
+        const uint32 ReverseChecksum = Run(true, true, RebuildMs, ReverseMs, ReverseMaxMs);
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Economy, %d steps: parallel %.3f ms/step vs serial %.3f ms/step (%.1fx); at 10 Hz %.2f ms of game thread per second (budget 1 ms per step %s); deterministic across threads %s, across insertion order %s"),
+               NumSteps, ParallelMs, SerialMs, ParallelMs > 0.0 ? SerialMs / ParallelMs : 0.0, ParallelMs * 10.0,
+               ParallelMaxMs <= 1.0 ? TEXT("met") : TEXT("exceeded"),
+               ParallelChecksum == SerialChecksum ? TEXT("yes") : TEXT("NO"),
+               ParallelChecksum == ReverseChecksum ? TEXT("yes") : TEXT("NO"));
+    }
+
+    static FAutoConsoleCommandWithArgs BenchEconomyCommand(
+        TEXT("WorldForge.Bench.Economy"),
+        TEXT("Step the settlement economy and trade simulation in parallel and serially, and check the results match. Usage: WorldForge.Bench.Economy [Settlements] [Steps]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchEconomy));
+
+    /** WorldForge.Bench.History [Years] [Landmarks] - simulated years per second of the fast-forward history model */
+    static void BenchHistory(const TArray<FString>& Args)
+    {
+        const int32 NumYears = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 500;
+        const int32 NumLandmarks = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 200;
+
+        // A spread-out starting world with room to grow, weighted toward ordinary settlements
+        FWorldForgeState State;
+        State.Seed = 11;
+        FRandomStream Random(State.Seed);
+        const float HalfSize = FMath::Sqrt(static_cast<float>(NumLandmarks)) * 10000.0f;
+        for (int32 Index = 0; Index < NumLandmarks; ++Index)
+        {
+            FWorldForgeLandmark& Landmark = State.Landmarks.AddDefaulted_GetRef();
+            Landmark.Id = FString::Printf(TEXT("history_%d"), Index);
+            Landmark.Name = Landmark.Id;
+            const int32 Roll = Random.RandHelper(10);
+            Landmark.Type = Roll < 6 ? EWorldForgeLandmarkType::Settlement
+                : Roll < 7 ? EWorldForgeLandmarkType::Fortress
+                : Roll < 8 ? EWorldForgeLandmarkType::Monastery
+                : Roll < 9 ? EWorldForgeLandmarkType::Ruin
+                : EWorldForgeLandmarkType::Natural;
+            Landmark.Location = FVector(Random.FRandRange(-HalfSize, HalfSize), Random.FRandRange(-HalfSize, HalfSize), 0.0f);
+        }
+
+        uint32 Checksums[2] = {};
+        for (int32 Pass = 0; Pass < 2; ++Pass)
+        {
+            const bool bParallel = Pass == 0;
+            FWorldForgeHistoryModel Model(State);
+            const double StartTime = FPlatformTime::Seconds();
+            for (int32 Year = 0; Year < NumYears; ++Year)
+            {
+                Model.SimulateYear(bParallel);
+            }
+            const double Seconds = FPlatformTime::Seconds() - StartTime;
+            Checksums[Pass] = Model.GetChecksum();
+
+            const FWorldForgeHistoryDelta Delta = Model.MakeDelta();
+            UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: History %s, %d years from %d landmarks: %.3f s, %.0f years/s; %d sites (%d settlements, %d fortresses, %d monasteries, %d ruins); %d founded, %d ruined, %d resettled; delta adds %d, removes %d"),
+                   bParallel ? TEXT("parallel") : TEXT("serial"), NumYears, NumLandmarks, Seconds, Seconds > 0.0 ? NumYears / Seconds : 0.0,
+                   Model.NumSites(), Model.NumSites(EWorldForgeLandmarkType::Settlement), Model.NumSites(EWorldForgeLandmarkType::Fortress),
+                   Model.NumSites(EWorldForgeLandmarkType::Monastery), Model.NumSites(EWorldForgeLandmarkType::Ruin),
+                   Delta.Founded, Delta.Ruined, Delta.Resettled, Delta.Added.Num(), Delta.Removed.Num());
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: History deterministic across threads: %s"), Checksums[0] == Checksums[1] ? TEXT("yes") : TEXT("NO"));
+    }
+
+    static FAutoConsoleCommandWithArgs BenchHistoryCommand(
+        TEXT("WorldForge.Bench.History"),
+        TEXT("Fast-forward a generated world and report simulated years per second. Usage: WorldForge.Bench.History [Years] [Landmarks]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchHistory));
+
+    /** WorldForge.Bench.Significance [Landmarks] [Passes] - cost of scoring and tiering landmarks, and the resulting tiers */
+    static void BenchSignificance(const TArray<FString>& Args)
+    {
+        const int32 NumLandmarks = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 2000;
+        const int32 NumPasses = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 100;
+
+        const int32 GridSize = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(NumLandmarks)));
+        TArray<FWorldForgeLandmark> Landmarks;
+        TArray<float> Relevance;
+        for (int32 Index = 0; Index < NumLandmarks; ++Index)
+        {
+            Landmarks.Add(MakeGridLandmark(Index, GridSize, 3000.0f));
+            Relevance.Add(FWorldForgeSignificance::GetRelevance(Landmarks.Last().Type, 0.5f, 0.5f, 0.5f));
+        }
+
+        // Same work the significance manager and the subsystem do per pass: score, sort, hand out tiers
+        const FWorldForgeSignificanceSettings Settings;
+        TArray<float> Scores;
+        TArray<EWorldForgeSignificanceTier> Tiers;
+        int32 Counts[FWorldForgeSignificance::NumTiers] = {};
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+        {
+            // Walk the viewer across the grid so the order changes every pass
+            const float Angle = 2.0f * PI * Pass / NumPasses;
+            const FTransform Viewpoint(FRotator(0.0f, FMath::RadiansToDegrees(Angle), 0.0f), FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * GridSize * 1000.0f);
+
+            Scores.SetNumUninitialized(NumLandmarks);
+            ParallelFor(NumLandmarks, [&](int32 Index)
+            {
+                const FVector TypeScale = AWorldForgeSettlementActor::GetScaleForType(Landmarks[Index].Type);
+                Scores[Index] = FWorldForgeSignificance::Score(Viewpoint, Landmarks[Index].Location, FMath::Max(TypeScale.X, TypeScale.Y) * 50.0f, Relevance[Index]);
+            });
+            Scores.Sort(TGreater<float>());
+            FWorldForgeSignificance::AssignTiers(Scores, Settings, Tiers, Counts);
+        }
+        const double PassMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumPasses;
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Significance, %d landmarks: %.3f ms per pass; last pass high %d (cap %d), medium %d (cap %d), low %d, dormant %d"),
+               NumLandmarks, PassMs, Counts[0], Settings.MaxHigh, Counts[1], Settings.MaxMedium, Counts[2], Counts[3]);
+    }
+
+    static FAutoConsoleCommandWithArgs BenchSignificanceCommand(
+        TEXT("WorldForge.Bench.Significance"),
+        TEXT("Score and tier a grid of landmarks from a moving viewpoint. Usage: WorldForge.Bench.Significance [Landmarks] [Passes]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchSignificance));
+
+    /**
+     * WorldForge.Bench.NavBatch [Settlements] - dirty tile merging for a bulk import, then, if the world has a
+     * navigation system, the same import through the spawn queue with the batched rebuild timed to completion
+     */
+    static void BenchNavBatch(const TArray<FString>& Args, UWorld* World)
+    {
+        const int32 NumSettlements = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+
+        const int32 GridSize = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(NumSettlements)));
+        TArray<FWorldForgeLandmark> Landmarks;
+        Landmarks.Reserve(NumSettlements);
+        for (int32 Index = 0; Index < NumSettlements; ++Index)
+        {
+            Landmarks.Add(MakeGridLandmark(Index, GridSize, 3000.0f));
+        }
+
+        // Headless: what one request per settlement would rebuild against the merged batch
+        FWorldForgeNavBatch Batch;
+        TArray<FBox> Boxes;
+        const double StartTime = FPlatformTime::Seconds();
+        for (const FWorldForgeLandmark& Landmark : Landmarks)
+        {
+            Batch.AddArea(AWorldForgeSettlementActor::GetNavigationBounds(Landmark));
+        }
+        Batch.Flush(Boxes);
+        const double MergeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        const FWorldForgeNavBatch::FStats& BatchStats = Batch.GetStats();
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: NavBatch, %d settlements at tile size %.0f: %d tile rebuilds unbatched vs %d tiles in %d boxes batched (%.1fx fewer), merged in %.2f ms"),
+               NumSettlements, Batch.GetTileSize(), BatchStats.LastUnbatchedTiles, BatchStats.LastTiles, BatchStats.LastBoxes,
+               BatchStats.LastTiles > 0 ? static_cast<double>(BatchStats.LastUnbatchedTiles) / BatchStats.LastTiles : 0.0, MergeMs);
+
+        UWorldForgeSubsystem* Subsystem = GetSubsystem(World);
+        if (!Subsystem || !FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+        {
+            UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: NavBatch, no navigation system in this world; skipping the live rebuild"));
+            return;
+        }
+
+        Subsystem->DestroyAllSettlements();
+        const int32 RebuildsBefore = Subsystem->GetNavBatch().GetStats().RebuildsCompleted;
+        const double ImportStart = FPlatformTime::Seconds();
+        Subsystem->QueueLandmarks(Landmarks);
+
+        TWeakObjectPtr<UWorldForgeSubsystem> WeakSubsystem(Subsystem);
+        FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakSubsystem, RebuildsBefore, ImportStart, NumSettlements](float)
+        {
+            UWorldForgeSubsystem* Subsystem = WeakSubsystem.Get();
+            if (!Subsystem)
+            {
+                return false;
+            }
+
+            const FWorldForgeNavBatch::FStats& Stats = Subsystem->GetNavBatch().GetStats();
+            const double Elapsed = FPlatformTime::Seconds() - ImportStart;
+            if (Stats.RebuildsCompleted == RebuildsBefore)
+            {
+                if (Elapsed > 300.0)
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("WorldForge Bench: NavBatch, rebuild did not complete within 300 s"));
+                    return false;
+                }
+                return true;
+            }
+
+            UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: NavBatch live import of %d settlements: %d batches, last %d tiles in %d boxes; held %.2f s during the burst, rebuilt in %.2f s (agent downtime), %.2f s end to end"),
+                   NumSettlements, Stats.RebuildsCompleted - RebuildsBefore, Stats.LastTiles, Stats.LastBoxes,
+                   Stats.LastDeferredSeconds, Stats.LastRebuildSeconds, Elapsed);
+            return false;
+        }));
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs BenchNavBatchCommand(
+        TEXT("WorldForge.Bench.NavBatch"),
+        TEXT("Merge the navmesh tiles a bulk import dirties, and time the batched rebuild if the world has navigation. Usage: WorldForge.Bench.NavBatch [Settlements]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchNavBatch));
+
+    /**
+     * WorldForge.Bench.Paths [Sites] [Queries] [BatchSize] - caravan-style path queries over a road network:
+     * one search per query against batched, cached queries, then the paths one destroyed landmark invalidates
+     */
+    static void BenchPaths(const TArray<FString>& Args)
+    {
+        const int32 NumSites = Args.Num() > 0 ? FMath::Max(2, FCString::Atoi(*Args[0])) : 400;
+        const int32 NumQueries = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 20000;
+        const int32 BatchSize = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : 256;
+
+        // Straight roads stand in for routed ones; only the graph matters here
+        const int32 GridSize = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(NumSites)));
+        TArray<FWorldForgeLandmark> Landmarks;
+        FWorldForgeRoadNetwork Network;
+        for (int32 Index = 0; Index < NumSites; ++Index)
+        {
+            FWorldForgeLandmark& Landmark = Landmarks.Add_GetRef(MakeGridLandmark(Index, GridSize, 3000.0f));
+            Landmark.Type = EWorldForgeLandmarkType::Settlement;
+            Network.AddSite(Landmark);
+        }
+
+        TArray<FWorldForgeRoadNetwork::FRouteRequest> Requests;
+        TArray<FString> Removed;
+        Network.Update(Requests, Removed);
+        for (const FWorldForgeRoadNetwork::FRouteRequest& Request : Requests)
+        {
+            FWorldForgeRoad Road;
+            Road.FromId = Request.FromId;
+            Road.ToId = Request.ToId;
+            Road.Points = { Request.Start, (Request.Start + Request.End) * 0.5f, Request.End };
+            Road.Cost = FVector::Dist(Request.Start, Request.End);
+            Network.CommitRoute(Request.Key, Request.Version, MoveTemp(Road));
+        }
+
+        // Most traffic runs over a few trade routes; the rest goes anywhere
+        FRandomStream Random(1);
+        TArray<FWorldForgePathQuery> PopularRoutes;
+        for (int32 Index = 0; Index < 64; ++Index)
+        {
+            PopularRoutes.Add({ Landmarks[Random.RandHelper(NumSites)].Id, Landmarks[Random.RandHelper(NumSites)].Id });
+        }
+        TArray<FWorldForgePathQuery> Queries;
+        Queries.Reserve(NumQueries);
+        for (int32 Index = 0; Index < NumQueries; ++Index)
+        {
+            Queries.Add(Random.FRand() < 0.8f
+                ? PopularRoutes[Random.RandHelper(PopularRoutes.Num())]
+                : FWorldForgePathQuery{ Landmarks[Random.RandHelper(NumSites)].Id, Landmarks[Random.RandHelper(NumSites)].Id });
+        }
+
+        // Baseline: every agent searches for itself
+        const FWorldForgePathGraph Graph(Network);
+        TArray<FWorldForgePath> Paths;
+        double StartTime = FPlatformTime::Seconds();
+        for (const FWorldForgePathQuery& Query : Queries)
+        {
+            Graph.Solve(Query.FromId, MakeArrayView(&Query.ToId, 1), Paths);
+        }
+        const double SingleSeconds = FPlatformTime::Seconds() - StartTime;
+
+        FWorldForgePathService Service;
+        int32 Found = 0;
+        StartTime = FPlatformTime::Seconds();
+        for (int32 First = 0; First < NumQueries; First += BatchSize)
+        {
+            TArray<FWorldForgePathQuery> BatchQueries(Queries.GetData() + First, FMath::Min(BatchSize, NumQueries - First));
+            TSharedRef<FWorldForgePathBatch, ESPMode::ThreadSafe> Batch = Service.BeginBatch(MoveTemp(BatchQueries), Network);
+            if (!Batch->IsSolved())
+            {
+                Batch->Run();
+            }
+            Service.CommitBatch(*Batch);
+            for (const FWorldForgePathPtr& Path : Batch->GetResults())
+            {
+                Found += Path->IsFound() ? 1 : 0;
+            }
+        }
+        const double BatchedSeconds = FPlatformTime::Seconds() - StartTime;
+
+        const FWorldForgePathService::FStats& Stats = Service.GetStats();
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Paths, %d queries over %d landmarks and %d roads: one search each %.1f ms (%.0f queries/s); batches of %d with cache %.1f ms (%.0f queries/s, %.1fx), hit rate %.1f%%, %lld solved at %.0f/s, %d found"),
+               NumQueries, Graph.NumNodes(), Graph.NumRoads(), SingleSeconds * 1000.0, NumQueries / FMath::Max(SingleSeconds, 1e-9),
+               BatchSize, BatchedSeconds * 1000.0, NumQueries / FMath::Max(BatchedSeconds, 1e-9), SingleSeconds / FMath::Max(BatchedSeconds, 1e-9),
+               Stats.GetHitRate() * 100.0f, Stats.Solved, Stats.GetSolvedPerSecond(), Found);
+
+        // Destroying a landmark on a popular route drops only the paths through it
+        const FString& Destroyed = PopularRoutes[0].FromId;
+        const int32 CachedBefore = Service.NumCached();
+        Network.RemoveSite(Destroyed);
+        Network.Update(Requests, Removed);
+        for (const FString& Key : Removed)
+        {
+            Service.InvalidateRoad(Key);
+        }
+        Service.InvalidateLandmark(Destroyed);
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Paths, destroying '%s' removed %d roads and invalidated %d of %d cached paths"),
+               *Destroyed, Removed.Num(), CachedBefore - Service.NumCached(), CachedBefore);
+    }
+
+    static FAutoConsoleCommandWithArgs BenchPathsCommand(
+        TEXT("WorldForge.Bench.Paths"),
+        TEXT("Time landmark-to-landmark path queries one search at a time vs batched and cached, and cache invalidation after a destroy. Usage: WorldForge.Bench.Paths [Sites] [Queries] [BatchSize]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchPaths));
+
+    static void BenchOutcomes(const TArray<FString>& Args)
+    {
+        const int32 NumLandmarks = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 4;
+        const int32 NumNearestCells = Args.Num() > 1 ? FMath::Max(0, FCString::Atoi(*Args[1])) : 64;
+        constexpr int32 TilesPerSide = 4;
+        constexpr int32 Resolution = 65;
+        constexpr float SampleSpacing = 200.0f;
+
+        FWorldForgeState Current;
+        Current.Seed = 11;
+        const FWorldForgeTerrainParams Params = FWorldForgeTerrainParams::FromState(Current);
+        TSharedRef<FWorldForgeHeightCache, ESPMode::ThreadSafe> Heights = MakeShared<FWorldForgeHeightCache, ESPMode::ThreadSafe>();
+        for (int32 TileY = -TilesPerSide / 2; TileY < TilesPerSide / 2; ++TileY)
+        {
+            for (int32 TileX = -TilesPerSide / 2; TileX < TilesPerSide / 2; ++TileX)
+            {
+                TSharedPtr<FWorldForgeHeightfieldTile, ESPMode::ThreadSafe> Tile = MakeShared<FWorldForgeHeightfieldTile, ESPMode::ThreadSafe>();
+                FWorldForgeTerrainGenerator::GenerateTile(Params, FIntPoint(TileX, TileY), Resolution, SampleSpacing, *Tile);
+                Heights->AddTile(Tile);
+            }
+        }
+
+        FWorldForgeScatterGrid Grid;
+        Grid.SetGrid(16, 2000.0f);
+        TArray<FWorldForgeScatterLayerParams> CurrentLayers;
+        FWorldForgeScatter::MakeLayers(Current, CurrentLayers);
+        Grid.SetLayers(CopyTemp(CurrentLayers));
+        const float LandmarkRadius = Grid.GetMaxLandmarkRadius();
+
+        // A militant and a pious outcome, each founding its own landmarks near the player at the origin
+        const float HalfExtent = 0.5f * TilesPerSide * (Resolution - 1) * SampleSpacing * 0.5f;
+        FRandomStream Random(2024);
+        TArray<FWorldForgeOutcome> Outcomes;
+        TArray<TArray<FWorldForgeOutcomeScatterCell>> ScatterCells;
+        for (const TCHAR* Choice : { TEXT("A"), TEXT("B") })
+        {
+            FWorldForgeOutcome& Outcome = Outcomes.AddDefaulted_GetRef();
+            Outcome.Choice = Choice;
+            Outcome.State = Current;
+            Outcome.State.Militarism = Outcomes.Num() == 1 ? 0.85f : 0.3f;
+            Outcome.State.Religiosity = Outcomes.Num() == 1 ? 0.4f : 0.9f;
+            Outcome.State.Atmosphere = Outcomes.Num() == 1 ? EWorldForgeAtmosphere::WarTorn : EWorldForgeAtmosphere::Sacred;
+
+            TMap<FIntPoint, uint32> CellMasks;
+            TArray<FIntPoint> Cells;
+            TArray<FVector2D> Excluders;
+            for (int32 Index = 0; Index < NumLandmarks; ++Index)
+            {
+                FWorldForgeLandmark& Landmark = Outcome.Landmarks.AddDefaulted_GetRef();
+                Landmark.Id = FString::Printf(TEXT("bench-%s-%d"), Choice, Index);
+                Landmark.Type = Outcomes.Num() == 1 ? EWorldForgeLandmarkType::Fortress : EWorldForgeLandmarkType::Monastery;
+                Landmark.Location = FVector(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.0f);
+                const FVector2D Location(Landmark.Location);
+                Excluders.Add(Location);
+                Grid.GetCellsInRegion(FBox2D(Location - FVector2D(LandmarkRadius), Location + FVector2D(LandmarkRadius)), Cells);
+                for (const FIntPoint& Cell : Cells)
+                {
+                    CellMasks.Add(Cell, FWorldForgeScatterGrid::AllLayers);
+                }
+            }
+
+            TArray<FWorldForgeScatterLayerParams> OutcomeLayers;
+            FWorldForgeScatter::MakeLayers(Outcome.State, OutcomeLayers);
+            uint32 ChangedLayers = 0;
+            for (int32 Layer = 0; Layer < OutcomeLayers.Num(); ++Layer)
+            {
+                ChangedLayers |= OutcomeLayers[Layer] != CurrentLayers[Layer] ? 1u << Layer : 0u;
+            }
+            Grid.GetNearestCells(FVector2D::ZeroVector, NumNearestCells, Cells);
+            for (const FIntPoint& Cell : Cells)
+            {
+                CellMasks.FindOrAdd(Cell) |= ChangedLayers;
+            }
+
+            TArray<FWorldForgeOutcomeScatterCell>& OutcomeCells = ScatterCells.AddDefaulted_GetRef();
+            for (const TPair<FIntPoint, uint32>& CellMask : CellMasks)
+            {
+                if (CellMask.Value == 0)
+                {
+                    continue;
+                }
+                FWorldForgeOutcomeScatterCell& Cell = OutcomeCells.AddDefaulted_GetRef();
+                Cell.Cell = CellMask.Key;
+                Cell.LayerMask = CellMask.Value;
+                Cell.Bounds = Grid.GetCellBounds(CellMask.Key);
+                Cell.Landmarks = Excluders;
+            }
+        }
+
+        // What choosing outcome A costs when nothing was prepared: its layouts and scatter, one after another
+        const FWorldForgeOutcome& Chosen = Outcomes[0];
+        int32 ChosenLayers = 0;
+        double StartTime = FPlatformTime::Seconds();
+        for (const FWorldForgeLandmark& Landmark : Chosen.Landmarks)
+        {
+            FWorldForgeSettlementLayout Layout = FWorldForgeLayoutGenerator::Generate(FWorldForgeLayoutParams::FromLandmark(Landmark, Chosen.State));
+        }
+        TArray<FWorldForgeScatterLayerParams> ChosenLayerParams;
+        FWorldForgeScatter::MakeLayers(Chosen.State, ChosenLayerParams);
+        TArray<FTransform> Transforms;
+        for (const FWorldForgeOutcomeScatterCell& Cell : ScatterCells[0])
+        {
+            for (int32 Layer = 0; Layer < ChosenLayerParams.Num(); ++Layer)
+            {
+                if (Cell.LayerMask & (1u << Layer))
+                {
+                    FWorldForgeScatter::GenerateCell(ChosenLayerParams[Layer], Cell.Cell, Cell.Bounds, Cell.Landmarks, *Heights, nullptr, Transforms);
+                    ++ChosenLayers;
+                }
+            }
+        }
+        const double OnDemandSeconds = FPlatformTime::Seconds() - StartTime;
+
+        // Both outcomes prepared while the player reads the cards
+        const int32 NumCellsA = ScatterCells[0].Num();
+        const int32 NumCellsB = ScatterCells[1].Num();
+        FWorldForgeSpeculation Speculation(TEXT("bench"), MoveTemp(Outcomes), MoveTemp(ScatterCells), 0, Heights, nullptr);
+        Speculation.Run();
+
+        // Committing only moves the prepared content
+        StartTime = FPlatformTime::Seconds();
+        FWorldForgeOutcomeContent* Content = Speculation.FindContent(TEXT("A"));
+        TMap<FString, FWorldForgeOutcomeContent::FLayout> Layouts = MoveTemp(Content->Layouts);
+        int64 Instances = 0;
+        for (const FWorldForgeOutcomeScatterCell& Cell : Content->ScatterCells)
+        {
+            for (const TArray<FTransform>& Layer : Cell.Layers)
+            {
+                Instances += Layer.Num();
+            }
+        }
+        const double CommitSeconds = FPlatformTime::Seconds() - StartTime;
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Outcomes, %d landmarks and %d/%d scatter cells per outcome: on demand %.1f ms for the chosen outcome (%d layouts, %d cell layers); both prepared in %.1f ms while deciding, commit %.3f ms (%d layouts, %lld scatter instances ready)"),
+               NumLandmarks, NumCellsA, NumCellsB, OnDemandSeconds * 1000.0, NumLandmarks, ChosenLayers,
+               Speculation.GetSeconds() * 1000.0, CommitSeconds * 1000.0, Layouts.Num(), Instances);
+    }
+
+    static FAutoConsoleCommandWithArgs BenchOutcomesCommand(
+        TEXT("WorldForge.Bench.Outcomes"),
+        TEXT("Time generating a chosen outcome's layouts and scatter on demand vs preparing both outcomes ahead and committing one. Usage: WorldForge.Bench.Outcomes [LandmarksPerOutcome] [NearestCells]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchOutcomes));
+
+    static void BenchSnapshots(const TArray<FString>& Args)
+    {
+        const int32 NumLandmarks = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+        const int32 NumChanges = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, NumLandmarks) : 100;
+        constexpr int32 NumCopies = 100;
+
+        FWorldForgeState State;
+        FWorldForgeLandmarkStore Store;
+        const int32 GridSize = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(NumLandmarks)));
+        for (int32 Index = 0; Index < NumLandmarks; ++Index)
+        {
+            const FWorldForgeLandmark Landmark = MakeGridLandmark(Index, GridSize, 1000.0f);
+            State.Landmarks.Add(Landmark);
+            Store.Set(Landmark);
+        }
+
+        // Copying the world as the getters and history do today, vs taking a snapshot
+        int32 Sink = 0;
+        double StartTime = FPlatformTime::Seconds();
+        for (int32 Copy = 0; Copy < NumCopies; ++Copy)
+        {
+            const FWorldForgeState Copied = State;
+            Sink += Copied.Landmarks.Num();
+        }
+        const double DeepSeconds = (FPlatformTime::Seconds() - StartTime) / NumCopies;
+
+        StartTime = FPlatformTime::Seconds();
+        for (int32 Copy = 0; Copy < NumCopies; ++Copy)
+        {
+            const FWorldForgeWorldSnapshot Snapshot = FWorldForgeWorldSnapshot::Make(State, Store);
+            Sink += Snapshot.Landmarks.Num();
+        }
+        const double SnapshotSeconds = (FPlatformTime::Seconds() - StartTime) / NumCopies;
+
+        // A fork that moves some landmarks, removes one and adds one
+        FRandomStream Random(77);
+        FWorldForgeLandmarkStore Fork = Store;
+        StartTime = FPlatformTime::Seconds();
+        for (int32 Change = 0; Change < NumChanges; ++Change)
+        {
+            FWorldForgeLandmark Moved = State.Landmarks[Random.RandHelper(NumLandmarks)];
+            Moved.Location.Z += 100.0f;
+            Fork.Set(Moved);
+        }
+        Fork.Remove(State.Landmarks[0].Id);
+        Fork.Set(MakeGridLandmark(NumLandmarks, GridSize, 1000.0f));
+        const double WriteSeconds = FPlatformTime::Seconds() - StartTime;
+
+        FWorldForgeLandmarkDiff Diff;
+        StartTime = FPlatformTime::Seconds();
+        FWorldForgeLandmarkStore::Diff(Store, Fork, Diff);
+        const double DiffSeconds = FPlatformTime::Seconds() - StartTime;
+
+        // The same diff between two flat arrays, through a map of one of them
+        TArray<FWorldForgeLandmark> ForkArray;
+        Fork.ToArray(ForkArray);
+        StartTime = FPlatformTime::Seconds();
+        TMap<FString, const FWorldForgeLandmark*> ById;
+        ById.Reserve(ForkArray.Num());
+        for (const FWorldForgeLandmark& Landmark : ForkArray)
+        {
+            ById.Add(Landmark.Id, &Landmark);
+        }
+        int32 FlatDiffs = 0;
+        for (const FWorldForgeLandmark& Landmark : State.Landmarks)
+        {
+            const FWorldForgeLandmark* const* Found = ById.Find(Landmark.Id);
+            FlatDiffs += !Found || !FWorldForgeLandmarkStore::IsSameLandmark(Landmark, **Found) ? 1 : 0;
+            ById.Remove(Landmark.Id);
+        }
+        FlatDiffs += ById.Num();
+        const double FlatDiffSeconds = FPlatformTime::Seconds() - StartTime;
+
+        const FWorldForgeLandmarkStore::FStats& Stats = Fork.GetStats();
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Snapshots of %d landmarks in %d chunks: deep copy %.3f ms, snapshot %.4f ms (%.0fx)"),
+               NumLandmarks, Store.NumChunks(), DeepSeconds * 1000.0, SnapshotSeconds * 1000.0, DeepSeconds / FMath::Max(SnapshotSeconds, 1e-9));
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Snapshots, %d writes to a fork in %.3f ms copied %d of %d chunks; diff %.3f ms (%d added, %d removed, %d changed) vs flat %.3f ms (%d differences) [%d]"),
+               NumChanges + 2, WriteSeconds * 1000.0, Stats.ChunkCopies, Fork.NumChunks(), DiffSeconds * 1000.0,
+               Diff.Added.Num(), Diff.Removed.Num(), Diff.Changed.Num(), FlatDiffSeconds * 1000.0, FlatDiffs, Sink);
+    }
+
+    static FAutoConsoleCommandWithArgs BenchSnapshotsCommand(
+        TEXT("WorldForge.Bench.Snapshots"),
+        TEXT("Time deep copies of the world state vs copy-on-write snapshots, writes to a fork, and snapshot diffs vs flat diffs. Usage: WorldForge.Bench.Snapshots [Landmarks] [Changes]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchSnapshots));
+
+    static void BenchUndo(const TArray<FString>& Args)
+    {
+        const int32 NumSteps = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+        const int32 MemoryKB = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 256;
+        constexpr int32 NumLandmarks = 2000;
+
+        FWorldForgeState State;
+        FWorldForgeLandmarkStore Store;
+        const int32 GridSize = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(NumLandmarks + NumSteps)));
+        for (int32 Index = 0; Index < NumLandmarks; ++Index)
+        {
+            const FWorldForgeLandmark Landmark = MakeGridLandmark(Index, GridSize, 1000.0f);
+            State.Landmarks.Add(Landmark);
+            Store.Set(Landmark);
+        }
+
+        // Alternate trait changes, spawns and a replacement, as a session of commands would
+        auto RecordSession = [&State, &Store, NumSteps, GridSize](FWorldForgeUndoHistory& History)
+        {
+            FRandomStream Random(31);
+            FWorldForgeState Session = State;
+            FWorldForgeLandmarkStore SessionStore = Store;
+            for (int32 Step = 0; Step < NumSteps; ++Step)
+            {
+                History.BeginStep(TEXT("BENCH"), Session);
+                switch (Step % 3)
+                {
+                case 0:
+                    Session.Militarism = Random.FRand();
+                    break;
+                case 1:
+                {
+                    const FWorldForgeLandmark Landmark = MakeGridLandmark(NumLandmarks + Step, GridSize, 1000.0f);
+                    SessionStore.Set(Landmark);
+                    History.RecordAdded(Landmark, true);
+                    break;
+                }
+                default:
+                    if (const FWorldForgeLandmark* Old = SessionStore.Find(FString::Printf(TEXT("bench-%d"), Random.RandHelper(NumLandmarks))))
+                    {
+                        FWorldForgeLandmark Replaced = *Old;
+                        Replaced.Location.Z += 100.0f;
+                        History.RecordRemoved(*Old);
+                        History.RecordAdded(Replaced, true);
+                        SessionStore.Set(Replaced);
+                    }
+                    break;
+                }
+                History.EndStep(Session);
+            }
+        };
+
+        FWorldForgeUndoHistory Unbounded;
+        Unbounded.SetLimits(NumSteps, TNumericLimits<SIZE_T>::Max());
+        double StartTime = FPlatformTime::Seconds();
+        RecordSession(Unbounded);
+        const double RecordSeconds = FPlatformTime::Seconds() - StartTime;
+        const FWorldForgeUndoHistory::FStats Full = Unbounded.GetStats();
+
+        // What keeping a copy of the world per step would hold instead
+        SIZE_T StateBytes = State.Landmarks.GetAllocatedSize();
+        for (const FWorldForgeLandmark& Landmark : State.Landmarks)
+        {
+            StateBytes += Landmark.Id.GetAllocatedSize() + Landmark.Name.GetAllocatedSize() + Landmark.Description.GetAllocatedSize();
+        }
+
+        int32 Undone = 0;
+        StartTime = FPlatformTime::Seconds();
+        while (const FWorldForgeUndoStep* Step = Unbounded.Undo())
+        {
+            Step->ApplyFields(State, true);
+            for (const FWorldForgeUndoStep::FAdded& Entry : Step->Added)
+            {
+                Store.Remove(Entry.Landmark.Id);
+            }
+            for (const FWorldForgeLandmark& Landmark : Step->Removed)
+            {
+                Store.Set(Landmark);
+            }
+            ++Undone;
+        }
+        const double UndoSeconds = FPlatformTime::Seconds() - StartTime;
+
+        FWorldForgeUndoHistory Bounded;
+        Bounded.SetLimits(NumSteps, static_cast<SIZE_T>(MemoryKB) * 1024);
+        RecordSession(Bounded);
+        const FWorldForgeUndoHistory::FStats Capped = Bounded.GetStats();
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Undo, %d steps over %d landmarks: recorded in %.3f ms, %.0f bytes per step vs %llu per world copy (%.0fx); undid all in %.3f ms (%d steps, %d landmarks)"),
+               NumSteps, NumLandmarks, RecordSeconds * 1000.0, static_cast<double>(Full.Bytes) / FMath::Max(Full.UndoSteps, 1),
+               static_cast<uint64>(StateBytes), static_cast<double>(StateBytes) * FMath::Max(Full.UndoSteps, 1) / FMath::Max<double>(Full.Bytes, 1.0),
+               UndoSeconds * 1000.0, Undone, Store.Num());
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Undo, capped at %d KB: kept %d steps in %llu bytes, evicted %d"),
+               MemoryKB, Capped.UndoSteps, static_cast<uint64>(Capped.Bytes), Capped.Evicted);
+    }
+
+    static FAutoConsoleCommandWithArgs BenchUndoCommand(
+        TEXT("WorldForge.Bench.Undo"),
+        TEXT("Time recording and undoing a session of world commands as inverse deltas, their memory vs a world copy per step, and eviction under a memory cap. Usage: WorldForge.Bench.Undo [Steps] [MemoryKB]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchUndo));
+
+    static void BenchMerge(const TArray<FString>& Args)
+    {
+        const int32 NumEditors = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 2, 64) : 8;
+        const int32 OpsPerEditor = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 5000;
+
+        // Each editor edits its own replica with a skewed clock, unaware of the others
+        FRandomStream Random(1234);
+        const int64 BaseMs = FWorldForgeHybridClock::GetPhysicalMs();
+        TArray<FWorldForgeReplica> Replicas;
+        TArray<FWorldForgeReplicaOp> Ops;
+        Replicas.SetNum(NumEditors);
+        Ops.Reserve(NumEditors * OpsPerEditor);
+        double EditSeconds = 0.0;
+        for (int32 Editor = 0; Editor < NumEditors; ++Editor)
+        {
+            FWorldForgeHybridClock Clock(Editor + 1);
+            const int64 SkewMs = Random.RandRange(-500, 500);
+            TArray<FString> Known;
+            const double StartTime = FPlatformTime::Seconds();
+            for (int32 Index = 0; Index < OpsPerEditor; ++Index)
+            {
+                const FWorldForgeHlc Stamp = Clock.Tick(BaseMs + SkewMs + Index / 4);
+                const int32 Roll = Random.RandHelper(100);
+                FWorldForgeReplicaOp Op;
+                if (Roll < 50)
+                {
+                    Op = FWorldForgeReplica::MakeTrait(static_cast<EWorldForgeTrait>(Random.RandHelper(5)), Random.FRand(), Stamp);
+                }
+                else if (Roll < 60)
+                {
+                    Op = FWorldForgeReplica::MakeAtmosphere(static_cast<EWorldForgeAtmosphere>(Random.RandHelper(6)), Stamp);
+                }
+                else if (Roll < 85 || Known.Num() == 0)
+                {
+                    // IDs shared across editors, so concurrent adds and removes of the same landmark happen
+                    const FWorldForgeLandmark Landmark = MakeGridLandmark(Random.RandHelper(OpsPerEditor / 4 + 1), 64, 1000.0f);
+                    Known.AddUnique(Landmark.Id);
+                    Op = FWorldForgeReplica::MakeAdd(Landmark, Stamp);
+                }
+                else
+                {
+                    Op = Replicas[Editor].MakeRemove(Known[Random.RandHelper(Known.Num())], Stamp);
+                }
+                Replicas[Editor].Merge(Op);
+                Ops.Add(MoveTemp(Op));
+            }
+            EditSeconds += FPlatformTime::Seconds() - StartTime;
+        }
+
+        // Every replica then receives every op, in its own order and with some delivered twice
+        double MergeSeconds = 0.0;
+        int32 NumMerges = 0;
+        TArray<int32> Order;
+        for (int32 Editor = 0; Editor < NumEditors; ++Editor)
+        {
+            Order.Reset(Ops.Num());
+            for (int32 Index = 0; Index < Ops.Num(); ++Index)
+            {
+                Order.Add(Index);
+                if (Random.RandHelper(10) == 0)
+                {
+                    Order.Add(Index);
+                }
+            }
+            for (int32 Index = Order.Num() - 1; Index > 0; --Index)
+            {
+                Order.Swap(Index, Random.RandHelper(Index + 1));
+            }
+
+            const double StartTime = FPlatformTime::Seconds();
+            for (const int32 OpIndex : Order)
+            {
+                Replicas[Editor].Merge(Ops[OpIndex]);
+            }
+            MergeSeconds += FPlatformTime::Seconds() - StartTime;
+            NumMerges += Order.Num();
+        }
+
+        FWorldForgeState Reference;
+        Replicas[0].ToState(Reference);
+        int32 NumDiverged = 0;
+        for (int32 Editor = 1; Editor < NumEditors; ++Editor)
+        {
+            FWorldForgeState State;
+            Replicas[Editor].ToState(State);
+            bool bSame = State.Atmosphere == Reference.Atmosphere && State.Landmarks.Num() == Reference.Landmarks.Num();
+            for (int32 Trait = 0; Trait < 5 && bSame; ++Trait)
+            {
+                bSame = State.GetTrait(static_cast<EWorldForgeTrait>(Trait)) == Reference.GetTrait(static_cast<EWorldForgeTrait>(Trait));
+            }
+            for (int32 Index = 0; Index < State.Landmarks.Num() && bSame; ++Index)
+            {
+                bSame = FWorldForgeLandmarkStore::IsSameLandmark(State.Landmarks[Index], Reference.Landmarks[Index]);
+            }
+            NumDiverged += bSame ? 0 : 1;
+        }
+
+        const FWorldForgeReplica::FStats& Stats = Replicas[0].GetStats();
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Merge, %d editors x %d ops: local edits %.0f ops/s; merged %d deliveries in %.1f ms (%.0f merges/s, %.1f%% stale or duplicate)"),
+               NumEditors, OpsPerEditor, Ops.Num() / FMath::Max(EditSeconds, 1e-9), NumMerges, MergeSeconds * 1000.0,
+               NumMerges / FMath::Max(MergeSeconds, 1e-9), 100.0 * Stats.Stale / FMath::Max(Stats.Merged + Stats.Stale, 1));
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Merge, %s: %d landmarks, %d tombstones per replica, %d of %d replicas diverged"),
+               NumDiverged == 0 ? TEXT("converged") : TEXT("DIVERGED"), Reference.Landmarks.Num(), Stats.Tombstones, NumDiverged, NumEditors);
+
+        // Every op has reached every replica, so all of them are causally stable
+        FWorldForgeHlc Stable;
+        for (const FWorldForgeReplicaOp& Op : Ops)
+        {
+            Stable = Stable < Op.Stamp ? Op.Stamp : Stable;
+        }
+        const int32 HeldBefore = Stats.Tombstones;
+        const double CollectStart = FPlatformTime::Seconds();
+        Replicas[0].CollectTombstones(Stable);
+        FWorldForgeState Collected;
+        Replicas[0].ToState(Collected);
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Merge, collected %d of %d tombstones in %.2f ms, %d held, landmarks %s"),
+               Stats.Collected, HeldBefore, (FPlatformTime::Seconds() - CollectStart) * 1000.0, Stats.Tombstones,
+               Collected.Landmarks.Num() == Reference.Landmarks.Num() ? TEXT("unchanged") : TEXT("CHANGED"));
+    }
+
+    static FAutoConsoleCommandWithArgs BenchMergeCommand(
+        TEXT("WorldForge.Bench.Merge"),
+        TEXT("Simulate concurrent editors changing traits, atmosphere and landmarks, then merge every edit into every replica in a different order and check they converge. Usage: WorldForge.Bench.Merge [Editors] [OpsPerEditor]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchMerge));
+}
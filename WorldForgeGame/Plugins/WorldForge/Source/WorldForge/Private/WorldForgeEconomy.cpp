@@ -0,0 +1,444 @@
+#include "WorldForgeEconomy.h"
+#include "WorldForgeRoads.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/Crc.h"
+
+namespace WorldForgeEconomy
+{
+    /** Food eaten per person per step */
+    constexpr float FoodPerPerson = 0.01f;
+
+    /** Goods wanted per person per step */
+    constexpr float GoodsPerPerson = 0.003f;
+
+    /** Steps of consumption a settlement wants in store; prices rise as stock falls below it */
+    constexpr float ReserveSteps = 10.0f;
+
+    /** Route capacity halves at this length */
+    constexpr float CapacityFalloff = 5000.0f;
+
+    /** Share of stock and wealth a settlement commits to trade per step, split across its routes */
+    constexpr float TradeShare = 0.5f;
+
+    struct FTypeProfile
+    {
+        float Capacity;
+        float FoodPerWorker;
+        float GoodsPerWorker;
+    };
+
+    /** Settlements farm, fortresses depend on food imports, monasteries produce both and craft goods */
+    FTypeProfile GetProfile(EWorldForgeLandmarkType Type)
+    {
+        switch (Type)
+        {
+        case EWorldForgeLandmarkType::Fortress: return { 600.0f, 0.006f, 0.003f };
+        case EWorldForgeLandmarkType::Monastery: return { 300.0f, 0.013f, 0.006f };
+        case EWorldForgeLandmarkType::Settlement:
+        default: return { 2000.0f, 0.012f, 0.004f };
+        }
+    }
+
+    float GetPrice(float Stock, float Demand)
+    {
+        const float Reserve = Demand * ReserveSteps;
+        return Reserve / (Stock + Reserve + KINDA_SMALL_NUMBER);
+    }
+
+    /** Reorder every array by Order, where Order[NewIndex] = OldIndex */
+    template <typename T>
+    void Permute(TArray<T>& Array, TConstArrayView<int32> Order)
+    {
+        TArray<T> Sorted;
+        Sorted.Reserve(Array.Num());
+        for (const int32 OldIndex : Order)
+        {
+            Sorted.Add(MoveTemp(Array[OldIndex]));
+        }
+        Array = MoveTemp(Sorted);
+    }
+}
+
+FWorldForgeEconomySettings FWorldForgeEconomySettings::FromState(const FWorldForgeState& State)
+{
+    FWorldForgeEconomySettings Settings;
+    Settings.Seed = State.Seed;
+    Settings.ProductionScale = 0.6f + 0.8f * State.Prosperity;
+    Settings.GrowthRate = 0.001f + 0.003f * State.Prosperity;
+    Settings.TradeRate = 0.1f * State.Openness;
+    Settings.TradeLoss = FMath::Lerp(0.35f, 0.02f, State.Lawfulness);
+    return Settings;
+}
+
+bool FWorldForgeEconomySettings::operator==(const FWorldForgeEconomySettings& Other) const
+{
+    return Seed == Other.Seed
+        && ProductionScale == Other.ProductionScale
+        && GrowthRate == Other.GrowthRate
+        && TradeRate == Other.TradeRate
+        && TradeLoss == Other.TradeLoss
+        && TradeRange == Other.TradeRange;
+}
+
+void FWorldForgeEconomy::SetSettings(const FWorldForgeEconomySettings& InSettings)
+{
+    const bool bSeedChanged = InSettings.Seed != Settings.Seed;
+    bTopologyDirty |= InSettings.TradeRange != Settings.TradeRange;
+    Settings = InSettings;
+
+    if (bSeedChanged)
+    {
+        Reset();
+    }
+}
+
+bool FWorldForgeEconomy::AddSettlement(const FWorldForgeLandmark& Landmark)
+{
+    if (!FWorldForgeRoadPlanner::ConnectsType(Landmark.Type) || IdToIndex.Contains(Landmark.Id))
+    {
+        return false;
+    }
+
+    const int32 Index = Ids.Add(Landmark.Id);
+    Locations.Add(FVector2D(Landmark.Location.X, Landmark.Location.Y));
+    Types.Add(Landmark.Type);
+    Capacity.AddZeroed();
+    Productivity.AddZeroed();
+    Population.AddZeroed();
+    Food.AddZeroed();
+    Goods.AddZeroed();
+    Wealth.AddZeroed();
+    IdToIndex.Add(Landmark.Id, Index);
+
+    InitializeSettlement(Index);
+    bTopologyDirty = true;
+    return true;
+}
+
+bool FWorldForgeEconomy::RemoveSettlement(const FString& LandmarkId)
+{
+    int32 Index = INDEX_NONE;
+    if (!IdToIndex.RemoveAndCopyValue(LandmarkId, Index))
+    {
+        return false;
+    }
+
+    // Routes still reference the old indices; they are rebuilt before the next step reads them
+    Ids.RemoveAtSwap(Index, EAllowShrinking::No);
+    Locations.RemoveAtSwap(Index, EAllowShrinking::No);
+    Types.RemoveAtSwap(Index, EAllowShrinking::No);
+    Capacity.RemoveAtSwap(Index, EAllowShrinking::No);
+    Productivity.RemoveAtSwap(Index, EAllowShrinking::No);
+    Population.RemoveAtSwap(Index, EAllowShrinking::No);
+    Food.RemoveAtSwap(Index, EAllowShrinking::No);
+    Goods.RemoveAtSwap(Index, EAllowShrinking::No);
+    Wealth.RemoveAtSwap(Index, EAllowShrinking::No);
+    if (Ids.IsValidIndex(Index))
+    {
+        IdToIndex.Add(Ids[Index], Index);
+    }
+
+    bTopologyDirty = true;
+    return true;
+}
+
+void FWorldForgeEconomy::Clear()
+{
+    Ids.Reset();
+    Locations.Reset();
+    Types.Reset();
+    Capacity.Reset();
+    Productivity.Reset();
+    Population.Reset();
+    Food.Reset();
+    Goods.Reset();
+    Wealth.Reset();
+    EdgeA.Reset();
+    EdgeB.Reset();
+    EdgeCapacity.Reset();
+    FoodFlow.Reset();
+    GoodsFlow.Reset();
+    AdjacencyOffsets.Reset();
+    AdjacencyEdges.Reset();
+    IdToIndex.Reset();
+    bTopologyDirty = false;
+    Accumulator = 0.0f;
+    Metrics = FWorldForgeEconomyMetrics();
+}
+
+void FWorldForgeEconomy::Reset()
+{
+    for (int32 Index = 0; Index < Ids.Num(); ++Index)
+    {
+        InitializeSettlement(Index);
+    }
+    FMemory::Memzero(FoodFlow.GetData(), FoodFlow.Num() * sizeof(float));
+    FMemory::Memzero(GoodsFlow.GetData(), GoodsFlow.Num() * sizeof(float));
+    Accumulator = 0.0f;
+    Metrics.Steps = 0;
+    UpdateMetrics();
+}
+
+void FWorldForgeEconomy::InitializeSettlement(int32 Index)
+{
+    using namespace WorldForgeEconomy;
+
+    // Seeded from the ID rather than the index, so a settlement starts the same wherever it sorts
+    FRandomStream Random(static_cast<int32>(HashCombine(GetTypeHash(Settings.Seed), FCrc::StrCrc32(*Ids[Index]))));
+    const FTypeProfile Profile = GetProfile(Types[Index]);
+
+    Capacity[Index] = Profile.Capacity * Random.FRandRange(0.7f, 1.3f);
+    Productivity[Index] = Random.FRandRange(0.8f, 1.2f);
+    Population[Index] = Capacity[Index] * Random.FRandRange(0.3f, 0.6f);
+    Food[Index] = Population[Index] * FoodPerPerson * ReserveSteps;
+    Goods[Index] = Population[Index] * GoodsPerPerson * ReserveSteps * 0.5f;
+    Wealth[Index] = Population[Index] * 0.1f;
+}
+
+int32 FWorldForgeEconomy::Advance(float DeltaSeconds, float StepSeconds, int32 MaxSteps)
+{
+    if (IsEmpty() || StepSeconds <= 0.0f)
+    {
+        Accumulator = 0.0f;
+        return 0;
+    }
+
+    Accumulator += DeltaSeconds;
+    int32 NumSteps = 0;
+    while (Accumulator >= StepSeconds && NumSteps < MaxSteps)
+    {
+        Accumulator -= StepSeconds;
+        Step();
+        ++NumSteps;
+    }
+    Accumulator = FMath::Min(Accumulator, StepSeconds);
+    return NumSteps;
+}
+
+void FWorldForgeEconomy::RebuildTopology()
+{
+    const int32 NumSettlements = Ids.Num();
+
+    TArray<int32> Order;
+    Order.SetNumUninitialized(NumSettlements);
+    for (int32 Index = 0; Index < NumSettlements; ++Index)
+    {
+        Order[Index] = Index;
+    }
+    Order.Sort([this](int32 A, int32 B) { return Ids[A] < Ids[B]; });
+
+    WorldForgeEconomy::Permute(Ids, Order);
+    WorldForgeEconomy::Permute(Locations, Order);
+    WorldForgeEconomy::Permute(Types, Order);
+    WorldForgeEconomy::Permute(Capacity, Order);
+    WorldForgeEconomy::Permute(Productivity, Order);
+    WorldForgeEconomy::Permute(Population, Order);
+    WorldForgeEconomy::Permute(Food, Order);
+    WorldForgeEconomy::Permute(Goods, Order);
+    WorldForgeEconomy::Permute(Wealth, Order);
+
+    IdToIndex.Reset();
+    IdToIndex.Reserve(NumSettlements);
+    for (int32 Index = 0; Index < NumSettlements; ++Index)
+    {
+        IdToIndex.Add(Ids[Index], Index);
+    }
+
+    // Trade follows the same neighbourhood graph roads are planned from, so routes and roads line up
+    TArray<FWorldForgeRoadEdge> Edges;
+    FWorldForgeRoadPlanner::BuildCandidateGraph(Locations, Settings.TradeRange, Edges);
+    Edges.Sort([](const FWorldForgeRoadEdge& X, const FWorldForgeRoadEdge& Y)
+    {
+        return X.A != Y.A ? X.A < Y.A : X.B < Y.B;
+    });
+
+    const int32 NumEdges = Edges.Num();
+    EdgeA.SetNumUninitialized(NumEdges);
+    EdgeB.SetNumUninitialized(NumEdges);
+    EdgeCapacity.SetNumUninitialized(NumEdges);
+    FoodFlow.SetNumZeroed(NumEdges);
+    GoodsFlow.SetNumZeroed(NumEdges);
+
+    AdjacencyOffsets.SetNumZeroed(NumSettlements + 1);
+    for (int32 Edge = 0; Edge < NumEdges; ++Edge)
+    {
+        EdgeA[Edge] = FMath::Min(Edges[Edge].A, Edges[Edge].B);
+        EdgeB[Edge] = FMath::Max(Edges[Edge].A, Edges[Edge].B);
+        EdgeCapacity[Edge] = 1.0f / (1.0f + Edges[Edge].Length / WorldForgeEconomy::CapacityFalloff);
+        ++AdjacencyOffsets[EdgeA[Edge] + 1];
+        ++AdjacencyOffsets[EdgeB[Edge] + 1];
+    }
+    for (int32 Index = 0; Index < NumSettlements; ++Index)
+    {
+        AdjacencyOffsets[Index + 1] += AdjacencyOffsets[Index];
+    }
+
+    // Filled in edge order, so each settlement applies its shipments in the same order every step
+    AdjacencyEdges.SetNumUninitialized(NumEdges * 2);
+    TArray<int32> Cursor(AdjacencyOffsets.GetData(), NumSettlements);
+    for (int32 Edge = 0; Edge < NumEdges; ++Edge)
+    {
+        AdjacencyEdges[Cursor[EdgeA[Edge]]++] = Edge;
+        AdjacencyEdges[Cursor[EdgeB[Edge]]++] = Edge;
+    }
+
+    FoodPrice.SetNumUninitialized(NumSettlements);
+    GoodsPrice.SetNumUninitialized(NumSettlements);
+    FoodExport.SetNumUninitialized(NumSettlements);
+    GoodsExport.SetNumUninitialized(NumSettlements);
+    Budget.SetNumUninitialized(NumSettlements);
+    Starving.SetNumUninitialized(NumSettlements);
+
+    bTopologyDirty = false;
+    ++Stats.TopologyRebuilds;
+}
+
+void FWorldForgeEconomy::Step(bool bParallel)
+{
+    using namespace WorldForgeEconomy;
+
+    const double StartTime = FPlatformTime::Seconds();
+    if (bTopologyDirty)
+    {
+        RebuildTopology();
+    }
+
+    const EParallelForFlags Flags = bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+    const int32 NumSettlements = Ids.Num();
+    const int32 NumEdges = EdgeA.Num();
+    const FWorldForgeEconomySettings StepSettings = Settings;
+
+    // Production, consumption and growth; then prices and what each route may carry
+    ParallelFor(NumSettlements, [this, &StepSettings](int32 Index)
+    {
+        const FTypeProfile Profile = GetProfile(Types[Index]);
+        const float Workers = Population[Index];
+        const float Scale = StepSettings.ProductionScale * Productivity[Index];
+
+        const float FoodNeeded = Workers * FoodPerPerson;
+        const float FoodAvailable = Food[Index] + Workers * Profile.FoodPerWorker * Scale;
+        const float FoodEaten = FMath::Min(FoodAvailable, FoodNeeded);
+        Food[Index] = FoodAvailable - FoodEaten;
+
+        const float GoodsProduced = Workers * Profile.GoodsPerWorker * Scale;
+        const float GoodsUsed = FMath::Min(Goods[Index] + GoodsProduced, Workers * GoodsPerPerson);
+        Goods[Index] += GoodsProduced - GoodsUsed;
+
+        // Fed settlements grow toward capacity; starving ones lose people in proportion to the shortfall
+        const float Fed = FoodNeeded > 0.0f ? FoodEaten / FoodNeeded : 1.0f;
+        Starving[Index] = Fed < 1.0f ? 1 : 0;
+        const float Growth = Fed >= 1.0f
+            ? StepSettings.GrowthRate * Workers * (1.0f - Workers / Capacity[Index])
+            : -0.05f * Workers * (1.0f - Fed);
+        Population[Index] = FMath::Max(1.0f, Workers + Growth);
+
+        const int32 Degree = FMath::Max(1, AdjacencyOffsets[Index + 1] - AdjacencyOffsets[Index]);
+        FoodPrice[Index] = GetPrice(Food[Index], Population[Index] * FoodPerPerson);
+        GoodsPrice[Index] = GetPrice(Goods[Index], Population[Index] * GoodsPerPerson);
+        FoodExport[Index] = TradeShare * Food[Index] / Degree;
+        GoodsExport[Index] = TradeShare * Goods[Index] / Degree;
+        Budget[Index] = TradeShare * Wealth[Index] / Degree;
+    }, Flags);
+
+    // Shipments along each route from the cheap end to the dear end, within stock and the buyer's budget
+    ParallelFor(NumEdges, [this, &StepSettings](int32 Edge)
+    {
+        const int32 A = EdgeA[Edge];
+        const int32 B = EdgeB[Edge];
+        const float Rate = StepSettings.TradeRate * EdgeCapacity[Edge];
+
+        auto Ship = [&](const TArray<float>& Price, const TArray<float>& Export, float PerPerson)
+        {
+            const float Gap = Price[B] - Price[A];
+            const float Volume = 0.5f * (Population[A] + Population[B]) * PerPerson * ReserveSteps;
+            const float UnitPrice = 0.5f * (Price[A] + Price[B]);
+            float Amount = Rate * Gap * Volume;
+            if (Amount > 0.0f)
+            {
+                Amount = FMath::Min3(Amount, Export[A], Budget[B] / (UnitPrice + KINDA_SMALL_NUMBER));
+            }
+            else
+            {
+                Amount = -FMath::Min3(-Amount, Export[B], Budget[A] / (UnitPrice + KINDA_SMALL_NUMBER));
+            }
+            return Amount;
+        };
+
+        FoodFlow[Edge] = Ship(FoodPrice, FoodExport, FoodPerPerson);
+        GoodsFlow[Edge] = Ship(GoodsPrice, GoodsExport, GoodsPerPerson);
+    }, Flags);
+
+    // Each settlement applies its own routes' shipments; the seller is paid for what it sent, the buyer receives what survived the road
+    ParallelFor(NumSettlements, [this, &StepSettings](int32 Index)
+    {
+        const float Kept = 1.0f - StepSettings.TradeLoss;
+        for (int32 Slot = AdjacencyOffsets[Index]; Slot < AdjacencyOffsets[Index + 1]; ++Slot)
+        {
+            const int32 Edge = AdjacencyEdges[Slot];
+            const int32 Other = EdgeA[Edge] == Index ? EdgeB[Edge] : EdgeA[Edge];
+
+            // Positive when this settlement sends
+            const float Sign = EdgeA[Edge] == Index ? 1.0f : -1.0f;
+            const float FoodSent = Sign * FoodFlow[Edge];
+            const float GoodsSent = Sign * GoodsFlow[Edge];
+            const float FoodUnit = 0.5f * (FoodPrice[Index] + FoodPrice[Other]);
+            const float GoodsUnit = 0.5f * (GoodsPrice[Index] + GoodsPrice[Other]);
+
+            Food[Index] -= FoodSent > 0.0f ? FoodSent : FoodSent * Kept;
+            Goods[Index] -= GoodsSent > 0.0f ? GoodsSent : GoodsSent * Kept;
+            Wealth[Index] += FoodSent * FoodUnit + GoodsSent * GoodsUnit;
+        }
+
+        Food[Index] = FMath::Max(0.0f, Food[Index]);
+        Goods[Index] = FMath::Max(0.0f, Goods[Index]);
+        Wealth[Index] = FMath::Max(0.0f, Wealth[Index]);
+    }, Flags);
+
+    ++Metrics.Steps;
+    UpdateMetrics();
+
+    const double StepMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    Stats.LastStepMs = StepMs;
+    Stats.MaxStepMs = FMath::Max(Stats.MaxStepMs, StepMs);
+    Stats.AverageStepMs = Stats.AverageStepMs > 0.0 ? FMath::Lerp(Stats.AverageStepMs, StepMs, 0.05) : StepMs;
+}
+
+void FWorldForgeEconomy::UpdateMetrics()
+{
+    // Summed in index order so the totals are as deterministic as the per-settlement state
+    FWorldForgeEconomyMetrics NewMetrics;
+    NewMetrics.Settlements = Ids.Num();
+    NewMetrics.TradeRoutes = EdgeA.Num();
+    NewMetrics.Steps = Metrics.Steps;
+
+    for (int32 Index = 0; Index < Ids.Num(); ++Index)
+    {
+        NewMetrics.TotalPopulation += Population[Index];
+        NewMetrics.TotalFood += Food[Index];
+        NewMetrics.TotalGoods += Goods[Index];
+        NewMetrics.TotalWealth += Wealth[Index];
+        NewMetrics.StarvingSettlements += Starving.IsValidIndex(Index) ? Starving[Index] : 0;
+    }
+    for (int32 Edge = 0; Edge < EdgeA.Num(); ++Edge)
+    {
+        NewMetrics.TradeVolume += FMath::Abs(FoodFlow[Edge]) + FMath::Abs(GoodsFlow[Edge]);
+    }
+
+    Metrics = NewMetrics;
+}
+
+int32 FWorldForgeEconomy::FindIndex(const FString& LandmarkId) const
+{
+    const int32* Index = IdToIndex.Find(LandmarkId);
+    return Index ? *Index : INDEX_NONE;
+}
+
+uint32 FWorldForgeEconomy::GetChecksum() const
+{
+    uint32 Checksum = FCrc::MemCrc32(Population.GetData(), Population.Num() * sizeof(float));
+    Checksum = FCrc::MemCrc32(Food.GetData(), Food.Num() * sizeof(float), Checksum);
+    Checksum = FCrc::MemCrc32(Goods.GetData(), Goods.Num() * sizeof(float), Checksum);
+    return FCrc::MemCrc32(Wealth.GetData(), Wealth.Num() * sizeof(float), Checksum);
+}
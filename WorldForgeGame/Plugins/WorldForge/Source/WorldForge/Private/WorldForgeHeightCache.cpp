@@ -0,0 +1,224 @@
+#include "WorldForgeHeightCache.h"
+#include "Math/VectorRegister.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace WorldForgeHeightQuery
+{
+    /** Cell and fractional position of a tile-local coordinate, clamped so border samples stay in range */
+    static void LocateCell(const FWorldForgeHeightfieldTile& Tile, float X, float Y, int32& OutCellX, int32& OutCellY, float& OutFracX, float& OutFracY)
+    {
+        const FVector2D Origin = Tile.GetOrigin();
+        const float InverseSpacing = 1.0f / Tile.SampleSpacing;
+        const float GridX = (X - static_cast<float>(Origin.X)) * InverseSpacing;
+        const float GridY = (Y - static_cast<float>(Origin.Y)) * InverseSpacing;
+
+        OutCellX = FMath::Clamp(FMath::FloorToInt32(GridX), 0, Tile.Resolution - 2);
+        OutCellY = FMath::Clamp(FMath::FloorToInt32(GridY), 0, Tile.Resolution - 2);
+        OutFracX = FMath::Clamp(GridX - static_cast<float>(OutCellX), 0.0f, 1.0f);
+        OutFracY = FMath::Clamp(GridY - static_cast<float>(OutCellY), 0.0f, 1.0f);
+    }
+
+    static float SampleTile(const FWorldForgeHeightfieldTile& Tile, float X, float Y, FVector* OutNormal)
+    {
+        int32 CellX, CellY;
+        float FracX, FracY;
+        LocateCell(Tile, X, Y, CellX, CellY, FracX, FracY);
+
+        const float H00 = Tile.GetHeight(CellX, CellY);
+        const float H10 = Tile.GetHeight(CellX + 1, CellY);
+        const float H01 = Tile.GetHeight(CellX, CellY + 1);
+        const float H11 = Tile.GetHeight(CellX + 1, CellY + 1);
+
+        const float Top = H00 + (H10 - H00) * FracX;
+        const float Bottom = H01 + (H11 - H01) * FracX;
+
+        if (OutNormal)
+        {
+            // Gradient of the bilinear patch at the sample point
+            const float DX = ((H10 - H00) + ((H11 - H01) - (H10 - H00)) * FracY) / Tile.SampleSpacing;
+            const float DY = (Bottom - Top) / Tile.SampleSpacing;
+            *OutNormal = FVector(-DX, -DY, 1.0f).GetSafeNormal();
+        }
+        return Top + (Bottom - Top) * FracY;
+    }
+
+    /** Four positions known to lie on the same tile */
+    static void SampleTile4(const FWorldForgeHeightfieldTile& Tile, const FVector2f* Positions, float* OutHeights)
+    {
+        const FVector2D Origin = Tile.GetOrigin();
+        const VectorRegister4Float InverseSpacing = VectorSetFloat1(1.0f / Tile.SampleSpacing);
+        const VectorRegister4Float X = MakeVectorRegisterFloat(Positions[0].X, Positions[1].X, Positions[2].X, Positions[3].X);
+        const VectorRegister4Float Y = MakeVectorRegisterFloat(Positions[0].Y, Positions[1].Y, Positions[2].Y, Positions[3].Y);
+        const VectorRegister4Float GridX = VectorMultiply(VectorSubtract(X, VectorSetFloat1(static_cast<float>(Origin.X))), InverseSpacing);
+        const VectorRegister4Float GridY = VectorMultiply(VectorSubtract(Y, VectorSetFloat1(static_cast<float>(Origin.Y))), InverseSpacing);
+
+        const VectorRegister4Float MaxCell = VectorSetFloat1(static_cast<float>(Tile.Resolution - 2));
+        const VectorRegister4Float CellX = VectorMin(VectorMax(VectorFloor(GridX), VectorZero()), MaxCell);
+        const VectorRegister4Float CellY = VectorMin(VectorMax(VectorFloor(GridY), VectorZero()), MaxCell);
+        const VectorRegister4Float FracX = VectorMin(VectorMax(VectorSubtract(GridX, CellX), VectorZero()), VectorOne());
+        const VectorRegister4Float FracY = VectorMin(VectorMax(VectorSubtract(GridY, CellY), VectorZero()), VectorOne());
+
+        // No gather instruction in the baseline ISA, so the four corners are loaded per lane
+        const VectorRegister4Int Index = VectorIntAdd(
+            VectorIntMultiply(VectorFloatToInt(CellY), VectorIntSet1(Tile.Resolution)),
+            VectorFloatToInt(CellX));
+        alignas(16) int32 Indices[4];
+        VectorIntStoreAligned(Index, Indices);
+
+        const float* Heights = Tile.Heights.GetData();
+        const int32 Row = Tile.Resolution;
+        const VectorRegister4Float H00 = MakeVectorRegisterFloat(Heights[Indices[0]], Heights[Indices[1]], Heights[Indices[2]], Heights[Indices[3]]);
+        const VectorRegister4Float H10 = MakeVectorRegisterFloat(Heights[Indices[0] + 1], Heights[Indices[1] + 1], Heights[Indices[2] + 1], Heights[Indices[3] + 1]);
+        const VectorRegister4Float H01 = MakeVectorRegisterFloat(Heights[Indices[0] + Row], Heights[Indices[1] + Row], Heights[Indices[2] + Row], Heights[Indices[3] + Row]);
+        const VectorRegister4Float H11 = MakeVectorRegisterFloat(Heights[Indices[0] + Row + 1], Heights[Indices[1] + Row + 1], Heights[Indices[2] + Row + 1], Heights[Indices[3] + Row + 1]);
+
+        // Same operation order as SampleTile
+        const VectorRegister4Float Top = VectorAdd(H00, VectorMultiply(VectorSubtract(H10, H00), FracX));
+        const VectorRegister4Float Bottom = VectorAdd(H01, VectorMultiply(VectorSubtract(H11, H01), FracX));
+        VectorStore(VectorAdd(Top, VectorMultiply(VectorSubtract(Bottom, Top), FracY)), OutHeights);
+    }
+}
+
+void FWorldForgeHeightCache::AddTile(const FTilePtr& Tile)
+{
+    if (!Tile.IsValid() || Tile->Resolution < 2)
+    {
+        return;
+    }
+
+    FWriteScopeLock WriteLock(Lock);
+    const float NewTileSize = Tile->GetSize();
+    if (NewTileSize != TileSize)
+    {
+        Tiles.Empty();
+        TileSize = NewTileSize;
+        InverseTileSize = 1.0f / NewTileSize;
+    }
+    Tiles.Add(Tile->Coord, Tile);
+}
+
+bool FWorldForgeHeightCache::RemoveTile(FIntPoint Coord)
+{
+    FWriteScopeLock WriteLock(Lock);
+    return Tiles.Remove(Coord) > 0;
+}
+
+void FWorldForgeHeightCache::Clear()
+{
+    FWriteScopeLock WriteLock(Lock);
+    Tiles.Empty();
+}
+
+int32 FWorldForgeHeightCache::Num() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Tiles.Num();
+}
+
+const FWorldForgeHeightfieldTile* FWorldForgeHeightCache::FindTile(float X, float Y) const
+{
+    if (Tiles.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    const FIntPoint Coord(FMath::FloorToInt32(X * InverseTileSize), FMath::FloorToInt32(Y * InverseTileSize));
+    const FTilePtr* Tile = Tiles.Find(Coord);
+    return Tile ? Tile->Get() : nullptr;
+}
+
+bool FWorldForgeHeightCache::QueryHeight(float X, float Y, float& OutHeight) const
+{
+    FReadScopeLock ReadLock(Lock);
+    const FWorldForgeHeightfieldTile* Tile = FindTile(X, Y);
+    if (!Tile)
+    {
+        return false;
+    }
+
+    OutHeight = WorldForgeHeightQuery::SampleTile(*Tile, X, Y, nullptr);
+    return true;
+}
+
+bool FWorldForgeHeightCache::QueryHeightAndNormal(float X, float Y, float& OutHeight, FVector& OutNormal) const
+{
+    FReadScopeLock ReadLock(Lock);
+    const FWorldForgeHeightfieldTile* Tile = FindTile(X, Y);
+    if (!Tile)
+    {
+        return false;
+    }
+
+    OutHeight = WorldForgeHeightQuery::SampleTile(*Tile, X, Y, &OutNormal);
+    return true;
+}
+
+int32 FWorldForgeHeightCache::QueryHeights(TConstArrayView<FVector2f> Positions, TArrayView<float> OutHeights, TArrayView<bool> OutFound,
+                                           bool bAllowVectorized) const
+{
+    check(OutHeights.Num() >= Positions.Num() && OutFound.Num() >= Positions.Num());
+
+    FReadScopeLock ReadLock(Lock);
+    const int32 Count = Positions.Num();
+    int32 NumFound = 0;
+    int32 Index = 0;
+
+    // Candidate arrays are usually spatially coherent, so runs of four tend to share a tile
+    if (bAllowVectorized)
+    {
+        for (; Index + 4 <= Count; Index += 4)
+        {
+            const FWorldForgeHeightfieldTile* Tile = FindTile(Positions[Index].X, Positions[Index].Y);
+            bool bSameTile = Tile != nullptr;
+            for (int32 Lane = 1; Lane < 4 && bSameTile; ++Lane)
+            {
+                bSameTile = FMath::FloorToInt32(Positions[Index + Lane].X * InverseTileSize) == Tile->Coord.X
+                    && FMath::FloorToInt32(Positions[Index + Lane].Y * InverseTileSize) == Tile->Coord.Y;
+            }
+
+            if (bSameTile)
+            {
+                WorldForgeHeightQuery::SampleTile4(*Tile, &Positions[Index], &OutHeights[Index]);
+                for (int32 Lane = 0; Lane < 4; ++Lane)
+                {
+                    OutFound[Index + Lane] = true;
+                }
+                NumFound += 4;
+                continue;
+            }
+
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                const FVector2f& Position = Positions[Index + Lane];
+                const FWorldForgeHeightfieldTile* LaneTile = FindTile(Position.X, Position.Y);
+                OutFound[Index + Lane] = LaneTile != nullptr;
+                if (LaneTile)
+                {
+                    OutHeights[Index + Lane] = WorldForgeHeightQuery::SampleTile(*LaneTile, Position.X, Position.Y, nullptr);
+                    ++NumFound;
+                }
+            }
+        }
+    }
+
+    // Scalar path, also used for the tail
+    const FWorldForgeHeightfieldTile* LastTile = nullptr;
+    for (; Index < Count; ++Index)
+    {
+        const FVector2f& Position = Positions[Index];
+        const FIntPoint Coord(FMath::FloorToInt32(Position.X * InverseTileSize), FMath::FloorToInt32(Position.Y * InverseTileSize));
+        if (!LastTile || LastTile->Coord != Coord)
+        {
+            LastTile = FindTile(Position.X, Position.Y);
+        }
+
+        OutFound[Index] = LastTile != nullptr;
+        if (LastTile)
+        {
+            OutHeights[Index] = WorldForgeHeightQuery::SampleTile(*LastTile, Position.X, Position.Y, nullptr);
+            ++NumFound;
+        }
+    }
+
+    return NumFound;
+}
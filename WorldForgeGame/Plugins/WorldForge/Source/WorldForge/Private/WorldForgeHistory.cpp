@@ -0,0 +1,334 @@
+#include "WorldForgeHistory.h"
+#include "WorldForgeHydrology.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Crc.h"
+
+namespace WorldForgeHistory
+{
+    /** Sites per crowding cell; founding into a full cell fails */
+    constexpr float CrowdingCellSize = 8000.0f;
+    constexpr int32 MaxSitesPerCell = 2;
+
+    /** A site whose population falls below this share of its capacity is abandoned */
+    constexpr float RuinShare = 0.08f;
+
+    constexpr uint8 NoBirth = 0xFF;
+
+    enum EEvent : uint8
+    {
+        None,
+        Ruined,
+        Resettled
+    };
+
+    float GetCapacity(EWorldForgeLandmarkType Type)
+    {
+        switch (Type)
+        {
+        case EWorldForgeLandmarkType::Settlement: return 2000.0f;
+        case EWorldForgeLandmarkType::Fortress: return 800.0f;
+        case EWorldForgeLandmarkType::Monastery: return 300.0f;
+        default: return 0.0f;
+        }
+    }
+
+    float GetFoundingPopulation(EWorldForgeLandmarkType Type)
+    {
+        switch (Type)
+        {
+        case EWorldForgeLandmarkType::Fortress: return 200.0f;
+        case EWorldForgeLandmarkType::Monastery: return 60.0f;
+        default: return 150.0f;
+        }
+    }
+
+    bool IsInhabited(EWorldForgeLandmarkType Type)
+    {
+        return Type == EWorldForgeLandmarkType::Settlement
+            || Type == EWorldForgeLandmarkType::Fortress
+            || Type == EWorldForgeLandmarkType::Monastery;
+    }
+
+    FIntPoint GetCrowdingCell(const FVector& Location)
+    {
+        return FIntPoint(FMath::FloorToInt32(Location.X / CrowdingCellSize), FMath::FloorToInt32(Location.Y / CrowdingCellSize));
+    }
+
+    /** Murmur3 finalizer */
+    uint32 Mix(uint32 Hash)
+    {
+        Hash ^= Hash >> 16;
+        Hash *= 0x85EBCA6Bu;
+        Hash ^= Hash >> 13;
+        Hash *= 0xC2B2AE35u;
+        Hash ^= Hash >> 16;
+        return Hash;
+    }
+
+    FString MakeName(uint32 Key, EWorldForgeLandmarkType Type)
+    {
+        static const TCHAR* Prefixes[] = {
+            TEXT("Ash"), TEXT("Bel"), TEXT("Cor"), TEXT("Dun"), TEXT("Eld"), TEXT("Fen"), TEXT("Gal"), TEXT("Hol"), TEXT("Ir"),
+            TEXT("Kel"), TEXT("Lor"), TEXT("Mar"), TEXT("Nor"), TEXT("Oak"), TEXT("Ril"), TEXT("Stan"), TEXT("Thorn"), TEXT("Wyn")
+        };
+        static const TCHAR* Suffixes[] = {
+            TEXT("ford"), TEXT("holm"), TEXT("wick"), TEXT("ton"), TEXT("bury"), TEXT("mere"), TEXT("gate"), TEXT("dale"), TEXT("haven"), TEXT("stead")
+        };
+
+        const uint32 Hash = Mix(Key);
+        const FString Base = FString(Prefixes[Hash % UE_ARRAY_COUNT(Prefixes)]) + Suffixes[(Hash >> 8) % UE_ARRAY_COUNT(Suffixes)];
+        switch (Type)
+        {
+        case EWorldForgeLandmarkType::Fortress: return Base + TEXT(" Keep");
+        case EWorldForgeLandmarkType::Monastery: return TEXT("Abbey of ") + Base;
+        case EWorldForgeLandmarkType::Ruin: return TEXT("Ruins of ") + Base;
+        default: return Base;
+        }
+    }
+}
+
+FWorldForgeHistoryModel::FWorldForgeHistoryModel(const FWorldForgeState& State, const FWorldForgeWaterMap* InWater)
+    : Militarism(State.Militarism)
+    , Prosperity(State.Prosperity)
+    , Religiosity(State.Religiosity)
+    , Lawfulness(State.Lawfulness)
+    , Openness(State.Openness)
+    , Seed(State.Seed)
+    , Water(InWater)
+    , Original(State.Landmarks)
+{
+    for (const FWorldForgeLandmark& Landmark : Original)
+    {
+        // Existing sites start at a seeded share of their capacity, so a young world still has room to grow
+        const uint32 Key = FCrc::StrCrc32(*Landmark.Id);
+        const float Start = 0.3f + 0.4f * (WorldForgeHistory::Mix(Key ^ static_cast<uint32>(Seed)) >> 8) / 16777216.0f;
+        AddSite(Key, Landmark.Location, Landmark.Type, WorldForgeHistory::GetCapacity(Landmark.Type) * Start);
+    }
+}
+
+void FWorldForgeHistoryModel::AddSite(uint32 Key, const FVector& Location, EWorldForgeLandmarkType Type, float InPopulation)
+{
+    while (UsedKeys.Contains(Key))
+    {
+        ++Key;
+    }
+    UsedKeys.Add(Key);
+
+    Keys.Add(Key);
+    Locations.Add(Location);
+    Types.Add(Type);
+    Population.Add(InPopulation);
+    FoundedYear.Add(Year);
+    Events.Add(WorldForgeHistory::None);
+    BirthTypes.Add(WorldForgeHistory::NoBirth);
+    BirthLocations.Add(FVector::ZeroVector);
+    ++Crowding.FindOrAdd(WorldForgeHistory::GetCrowdingCell(Location));
+}
+
+float FWorldForgeHistoryModel::Random(int32 Site, uint32 Salt) const
+{
+    uint32 Hash = Keys[Site] ^ (static_cast<uint32>(Seed) * 0x9E3779B9u);
+    Hash = WorldForgeHistory::Mix(Hash ^ (static_cast<uint32>(Year) * 0x85EBCA6Bu));
+    Hash = WorldForgeHistory::Mix(Hash ^ (Salt * 0xC2B2AE35u));
+    return (Hash >> 8) / 16777216.0f;
+}
+
+void FWorldForgeHistoryModel::SimulateYear(bool bParallel)
+{
+    using namespace WorldForgeHistory;
+
+    const int32 NumExisting = Keys.Num();
+    const float GrowthRate = 0.005f + 0.02f * Prosperity;
+    const float WarChance = 0.001f + 0.01f * Militarism * (1.2f - Lawfulness);
+    const float FamineChance = 0.002f * (1.0f - Prosperity);
+    const float ResettleChance = 0.004f * Prosperity * (0.5f + Openness);
+    const float SettlementChance = 0.01f * (0.3f + Openness);
+    const float FortressChance = 0.004f * Militarism;
+    const float MonasteryChance = 0.003f * Religiosity;
+
+    // Each site only writes its own slots and draws from its own stream, so the pass is order-independent
+    ParallelFor(NumExisting, [&](int32 Site)
+    {
+        Events[Site] = None;
+        BirthTypes[Site] = NoBirth;
+
+        const EWorldForgeLandmarkType Type = Types[Site];
+        if (Type == EWorldForgeLandmarkType::Ruin)
+        {
+            if (Random(Site, 1) < ResettleChance)
+            {
+                Types[Site] = EWorldForgeLandmarkType::Settlement;
+                Population[Site] = GetFoundingPopulation(EWorldForgeLandmarkType::Settlement);
+                Events[Site] = Resettled;
+            }
+            return;
+        }
+        if (!IsInhabited(Type))
+        {
+            return;
+        }
+
+        const float Capacity = GetCapacity(Type);
+        float People = Population[Site];
+        People += GrowthRate * People * (1.0f - People / Capacity);
+
+        // Fortresses weather wars better than open towns
+        const float SiteWarChance = Type == EWorldForgeLandmarkType::Fortress ? WarChance * 0.3f : WarChance;
+        if (Random(Site, 2) < SiteWarChance)
+        {
+            People *= 0.3f + 0.4f * Random(Site, 3);
+        }
+        if (Random(Site, 4) < FamineChance)
+        {
+            People *= 0.7f;
+        }
+
+        Population[Site] = People;
+        if (People < RuinShare * Capacity)
+        {
+            Types[Site] = EWorldForgeLandmarkType::Ruin;
+            Events[Site] = Ruined;
+            return;
+        }
+
+        // Crowded settlements send out settlers, soldiers or monks
+        if (Type != EWorldForgeLandmarkType::Settlement || People < 0.7f * Capacity)
+        {
+            return;
+        }
+
+        const float Roll = Random(Site, 5);
+        EWorldForgeLandmarkType Birth = EWorldForgeLandmarkType::Settlement;
+        if (Roll < SettlementChance) Birth = EWorldForgeLandmarkType::Settlement;
+        else if (Roll < SettlementChance + FortressChance) Birth = EWorldForgeLandmarkType::Fortress;
+        else if (Roll < SettlementChance + FortressChance + MonasteryChance) Birth = EWorldForgeLandmarkType::Monastery;
+        else return;
+
+        const float Angle = 2.0f * PI * Random(Site, 6);
+        const float Distance = 4000.0f + 5000.0f * Random(Site, 7);
+        BirthTypes[Site] = static_cast<uint8>(Birth);
+        BirthLocations[Site] = Locations[Site] + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.0f);
+    }, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+    // Count events and accept foundings in site order, so which of two competing sites wins a cell is fixed
+    for (int32 Site = 0; Site < NumExisting; ++Site)
+    {
+        Ruined += Events[Site] == WorldForgeHistory::Ruined ? 1 : 0;
+        Resettled += Events[Site] == WorldForgeHistory::Resettled ? 1 : 0;
+
+        if (BirthTypes[Site] == NoBirth)
+        {
+            continue;
+        }
+
+        const FVector Location = BirthLocations[Site];
+        const int32* Count = Crowding.Find(GetCrowdingCell(Location));
+        if ((Count && *Count >= MaxSitesPerCell)
+            || (Water && Water->IsWater(static_cast<float>(Location.X), static_cast<float>(Location.Y))))
+        {
+            continue;
+        }
+
+        const EWorldForgeLandmarkType Type = static_cast<EWorldForgeLandmarkType>(BirthTypes[Site]);
+        const float People = GetFoundingPopulation(Type);
+        Population[Site] = FMath::Max(0.5f * GetCapacity(Types[Site]), Population[Site] - People);
+        AddSite(Mix(Keys[Site] ^ static_cast<uint32>(Year) * 0x27D4EB2Du), Location, Type, People);
+        ++Founded;
+    }
+
+    ++Year;
+}
+
+int32 FWorldForgeHistoryModel::NumSites(EWorldForgeLandmarkType Type) const
+{
+    int32 Count = 0;
+    for (const EWorldForgeLandmarkType SiteType : Types)
+    {
+        Count += SiteType == Type ? 1 : 0;
+    }
+    return Count;
+}
+
+FWorldForgeHistoryDelta FWorldForgeHistoryModel::MakeDelta() const
+{
+    FWorldForgeHistoryDelta Delta;
+    Delta.YearsSimulated = Year;
+    Delta.Founded = Founded;
+    Delta.Ruined = Ruined;
+    Delta.Resettled = Resettled;
+
+    for (int32 Site = 0; Site < Original.Num(); ++Site)
+    {
+        const FWorldForgeLandmark& Landmark = Original[Site];
+        if (Types[Site] == Landmark.Type)
+        {
+            continue;
+        }
+
+        FWorldForgeLandmark& Changed = Delta.Added.Add_GetRef(Landmark);
+        Changed.Type = Types[Site];
+        if (Changed.Type == EWorldForgeLandmarkType::Ruin)
+        {
+            Changed.Name = TEXT("Ruins of ") + Landmark.Name;
+            Changed.Description = FString::Printf(TEXT("Abandoned within %d years"), Year);
+        }
+        else
+        {
+            Changed.Name.RemoveFromStart(TEXT("Ruins of "));
+            Changed.Description = FString::Printf(TEXT("Resettled within %d years"), Year);
+        }
+        Delta.Removed.Add(Landmark.Id);
+    }
+
+    for (int32 Site = Original.Num(); Site < Keys.Num(); ++Site)
+    {
+        FWorldForgeLandmark& Landmark = Delta.Added.AddDefaulted_GetRef();
+        Landmark.Id = FString::Printf(TEXT("hist_%08x"), Keys[Site]);
+        Landmark.Type = Types[Site];
+        Landmark.Name = WorldForgeHistory::MakeName(Keys[Site], Landmark.Type);
+        Landmark.Description = FString::Printf(TEXT("Founded in year %d of %d"), FoundedYear[Site] + 1, Year);
+        Landmark.Location = Locations[Site];
+    }
+
+    return Delta;
+}
+
+uint32 FWorldForgeHistoryModel::GetChecksum() const
+{
+    uint32 Checksum = FCrc::MemCrc32(Types.GetData(), Types.Num() * sizeof(EWorldForgeLandmarkType));
+    Checksum = FCrc::MemCrc32(Locations.GetData(), Locations.Num() * sizeof(FVector), Checksum);
+    return FCrc::MemCrc32(Population.GetData(), Population.Num() * sizeof(float), Checksum);
+}
+
+FWorldForgeHistoryJob::FWorldForgeHistoryJob(const FWorldForgeWorldSnapshot& InSnapshot, int32 InYears, TSharedPtr<const FWorldForgeWaterMap, ESPMode::ThreadSafe> InWater)
+    : Water(MoveTemp(InWater))
+    , Snapshot(InSnapshot)
+    , Years(InYears)
+{
+}
+
+void FWorldForgeHistoryJob::Run()
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    FWorldForgeState State;
+    Snapshot.ToState(State);
+    FWorldForgeHistoryModel Model(State, Water.Get());
+    for (int32 YearIndex = 0; YearIndex < Years; ++YearIndex)
+    {
+        if (bCancelRequested)
+        {
+            break;
+        }
+        Model.SimulateYear();
+        YearsCompleted = YearIndex + 1;
+    }
+
+    if (!bCancelRequested)
+    {
+        Delta = Model.MakeDelta();
+    }
+    Seconds = FPlatformTime::Seconds() - StartTime;
+    bDone = true;
+}
@@ -0,0 +1,884 @@
+#include "WorldForgeHydrology.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformAtomics.h"
+#include "Misc/ScopeRWLock.h"
+
+namespace WorldForgeHydrology
+{
+    // D8 neighbour offsets: E, SE, S, SW, W, NW, N, NE. The opposite of direction D is (D + 4) % 8.
+    static constexpr int32 OffsetX[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+    static constexpr int32 OffsetY[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+    static constexpr float InverseDistance[8] = { 1.0f, UE_INV_SQRT_2, 1.0f, UE_INV_SQRT_2, 1.0f, UE_INV_SQRT_2, 1.0f, UE_INV_SQRT_2 };
+
+    static int32 Opposite(int32 Direction)
+    {
+        return (Direction + 4) & 7;
+    }
+
+    /** Blocks filled independently (and in parallel) before their results are stitched together */
+    static constexpr int32 BlockSize = 512;
+
+    struct FBlock
+    {
+        int32 MinX;
+        int32 MinY;
+        int32 MaxX;
+        int32 MaxY;
+    };
+
+    struct FOpenCell
+    {
+        float Elevation;
+        int32 Index;
+
+        /** Min-heap order, ties broken by index so results do not depend on insertion order */
+        struct FLower
+        {
+            bool operator()(const FOpenCell& A, const FOpenCell& B) const
+            {
+                return A.Elevation < B.Elevation || (A.Elevation == B.Elevation && A.Index < B.Index);
+            }
+        };
+    };
+
+    /** Minimax edge between two perimeter cells: the lowest level at which water passes from one to the other */
+    struct FSpillEdge
+    {
+        int32 A;
+        int32 B;
+        float Spill;
+    };
+
+    /**
+     * Priority-Flood (Barnes et al. 2014) inside a block: flood inward from the block perimeter in height
+     * order, raising every cell to at least the level it was reached from. Cells raised into a depression
+     * go through a plain FIFO instead of the heap, which skips most heap operations on filled areas.
+     * If Labels is set, each cell records the perimeter cell it was flooded from.
+     */
+    static void FloodBlock(TArray<float>& Heights, int32 Width, const FBlock& Block, int32* Labels)
+    {
+        const int32 BlockWidth = Block.MaxX - Block.MinX;
+        const int32 BlockHeight = Block.MaxY - Block.MinY;
+        TArray<uint8> Closed;
+        Closed.SetNumZeroed(BlockWidth * BlockHeight);
+
+        TArray<FOpenCell> Open;
+        Open.Reserve(2 * (BlockWidth + BlockHeight));
+        auto Seed = [&](int32 X, int32 Y)
+        {
+            uint8& bClosed = Closed[(Y - Block.MinY) * BlockWidth + (X - Block.MinX)];
+            if (!bClosed)
+            {
+                bClosed = 1;
+                const int32 Cell = Y * Width + X;
+                Open.Add({ Heights[Cell], Cell });
+                if (Labels)
+                {
+                    Labels[Cell] = Cell;
+                }
+            }
+        };
+        for (int32 X = Block.MinX; X < Block.MaxX; ++X)
+        {
+            Seed(X, Block.MinY);
+            Seed(X, Block.MaxY - 1);
+        }
+        for (int32 Y = Block.MinY; Y < Block.MaxY; ++Y)
+        {
+            Seed(Block.MinX, Y);
+            Seed(Block.MaxX - 1, Y);
+        }
+        Open.Heapify(FOpenCell::FLower());
+
+        TArray<int32> Pit;
+        int32 PitHead = 0;
+
+        while (Open.Num() > 0 || PitHead < Pit.Num())
+        {
+            int32 Cell;
+            if (PitHead < Pit.Num())
+            {
+                Cell = Pit[PitHead++];
+                if (PitHead == Pit.Num())
+                {
+                    Pit.Reset();
+                    PitHead = 0;
+                }
+            }
+            else
+            {
+                FOpenCell Top;
+                Open.HeapPop(Top, FOpenCell::FLower(), EAllowShrinking::No);
+                Cell = Top.Index;
+            }
+
+            const int32 X = Cell % Width;
+            const int32 Y = Cell / Width;
+            for (int32 Direction = 0; Direction < 8; ++Direction)
+            {
+                const int32 NX = X + OffsetX[Direction];
+                const int32 NY = Y + OffsetY[Direction];
+                if (NX < Block.MinX || NY < Block.MinY || NX >= Block.MaxX || NY >= Block.MaxY)
+                {
+                    continue;
+                }
+
+                uint8& bClosed = Closed[(NY - Block.MinY) * BlockWidth + (NX - Block.MinX)];
+                if (bClosed)
+                {
+                    continue;
+                }
+                bClosed = 1;
+
+                const int32 Neighbor = NY * Width + NX;
+                if (Labels)
+                {
+                    Labels[Neighbor] = Labels[Cell];
+                }
+                if (Heights[Neighbor] <= Heights[Cell])
+                {
+                    Heights[Neighbor] = Heights[Cell];
+                    Pit.Add(Neighbor);
+                }
+                else
+                {
+                    Open.HeapPush({ Heights[Neighbor], Neighbor }, FOpenCell::FLower());
+                }
+            }
+        }
+    }
+
+    /** Sum of the cell's own rainfall and everything its donors pass on. Donors must be final. */
+    static float PullAccumulation(const TArray<uint8>& Directions, const TArray<float>& Accumulation, int32 Width, int32 Height, int32 Cell, float Rainfall)
+    {
+        const int32 X = Cell % Width;
+        const int32 Y = Cell / Width;
+        float Total = Rainfall;
+        for (int32 Direction = 0; Direction < 8; ++Direction)
+        {
+            const int32 NX = X + OffsetX[Direction];
+            const int32 NY = Y + OffsetY[Direction];
+            if (NX < 0 || NY < 0 || NX >= Width || NY >= Height)
+            {
+                continue;
+            }
+
+            const int32 Neighbor = NY * Width + NX;
+            if (Directions[Neighbor] == Opposite(Direction))
+            {
+                Total += Accumulation[Neighbor];
+            }
+        }
+        return Total;
+    }
+
+    /** Split a river into the runs that touch [Min, Max], keeping one point past each border so neighbours connect */
+    static void ClipRiver(const FWorldForgeRiver& River, const FVector2D& Min, const FVector2D& Max, TArray<FWorldForgeRiver>& OutRivers)
+    {
+        FWorldForgeRiver Run;
+        auto FinishRun = [&Run, &OutRivers]()
+        {
+            if (Run.Points.Num() >= 2)
+            {
+                OutRivers.Add(MoveTemp(Run));
+            }
+            Run = FWorldForgeRiver();
+        };
+
+        for (int32 Index = 0; Index < River.Points.Num(); ++Index)
+        {
+            const FVector& Point = River.Points[Index];
+            const bool bInside = Point.X >= Min.X && Point.Y >= Min.Y && Point.X <= Max.X && Point.Y <= Max.Y;
+            if (bInside)
+            {
+                if (Run.Points.Num() == 0 && Index > 0)
+                {
+                    Run.Points.Add(River.Points[Index - 1]);
+                    Run.Flow.Add(River.Flow[Index - 1]);
+                }
+                Run.Points.Add(Point);
+                Run.Flow.Add(River.Flow[Index]);
+            }
+            else if (Run.Points.Num() > 0)
+            {
+                Run.Points.Add(Point);
+                Run.Flow.Add(River.Flow[Index]);
+                FinishRun();
+            }
+        }
+        FinishRun();
+    }
+}
+
+FWorldForgeHydrologySettings FWorldForgeHydrologySettings::FromState(const FWorldForgeState& State)
+{
+    FWorldForgeHydrologySettings Settings;
+    Settings.Rainfall = 0.6f + 0.8f * State.Prosperity;
+    Settings.RiverThreshold = FMath::Lerp(900.0f, 300.0f, State.Openness);
+
+    switch (State.Atmosphere)
+    {
+    case EWorldForgeAtmosphere::Desolate:
+        Settings.Rainfall *= 0.3f;
+        break;
+
+    case EWorldForgeAtmosphere::Prosperous:
+    case EWorldForgeAtmosphere::Vibrant:
+        Settings.Rainfall *= 1.25f;
+        break;
+
+    default:
+        break;
+    }
+
+    return Settings;
+}
+
+SIZE_T FWorldForgeWaterTile::GetAllocatedSize() const
+{
+    SIZE_T Size = WaterMask.GetAllocatedSize() + Rivers.GetAllocatedSize();
+    for (const FWorldForgeRiver& River : Rivers)
+    {
+        Size += River.Points.GetAllocatedSize() + River.Flow.GetAllocatedSize();
+    }
+    return Size;
+}
+
+void FWorldForgeHydrology::Compute(TArray<float> Heights, int32 Width, int32 Height, float SampleSpacing, const FVector2D& Origin,
+                                   const FWorldForgeHydrologySettings& Settings, FWorldForgeHydrologyGrid& OutGrid)
+{
+    check(Heights.Num() == Width * Height);
+
+    OutGrid.Width = Width;
+    OutGrid.Height = Height;
+    OutGrid.SampleSpacing = SampleSpacing;
+    OutGrid.Origin = Origin;
+
+    FillDepressions(Heights, Width, Height);
+    OutGrid.Filled = MoveTemp(Heights);
+    ComputeFlowDirections(OutGrid.Filled, Width, Height, OutGrid.FlowDirection);
+    AccumulateFlow(OutGrid.FlowDirection, Width, Height, Settings.Rainfall, OutGrid.Accumulation);
+    ExtractRivers(OutGrid, Settings);
+}
+
+void FWorldForgeHydrology::FillDepressions(TArray<float>& Heights, int32 Width, int32 Height)
+{
+    using namespace WorldForgeHydrology;
+
+    const int32 BlocksX = FMath::DivideAndRoundUp(Width, BlockSize);
+    const int32 BlocksY = FMath::DivideAndRoundUp(Height, BlockSize);
+    if (BlocksX * BlocksY == 1)
+    {
+        FloodBlock(Heights, Width, { 0, 0, Width, Height }, nullptr);
+        return;
+    }
+
+    auto GetBlock = [&](int32 Block) -> FBlock
+    {
+        const int32 MinX = (Block % BlocksX) * BlockSize;
+        const int32 MinY = (Block / BlocksX) * BlockSize;
+        return { MinX, MinY, FMath::Min(MinX + BlockSize, Width), FMath::Min(MinY + BlockSize, Height) };
+    };
+
+    // 1. Fill every block on its own, as if its perimeter drained freely, labelling each cell with the
+    //    perimeter cell it was flooded from. Where two labels meet is where water can spill between them.
+    TArray<int32> Labels;
+    Labels.SetNumUninitialized(Width * Height);
+    TArray<TArray<FSpillEdge>> BlockEdges;
+    BlockEdges.SetNum(BlocksX * BlocksY);
+
+    ParallelFor(BlocksX * BlocksY, [&](int32 Block)
+    {
+        const FBlock Bounds = GetBlock(Block);
+        FloodBlock(Heights, Width, Bounds, Labels.GetData());
+
+        TMap<uint64, float> Spills;
+        for (int32 Y = Bounds.MinY; Y < Bounds.MaxY; ++Y)
+        {
+            for (int32 X = Bounds.MinX; X < Bounds.MaxX; ++X)
+            {
+                const int32 Cell = Y * Width + X;
+
+                // E, SE, S and SW cover every neighbouring pair once
+                for (int32 Direction = 0; Direction < 4; ++Direction)
+                {
+                    const int32 NX = X + OffsetX[Direction];
+                    const int32 NY = Y + OffsetY[Direction];
+                    if (NX < Bounds.MinX || NY < Bounds.MinY || NX >= Bounds.MaxX || NY >= Bounds.MaxY)
+                    {
+                        continue;
+                    }
+
+                    const int32 Neighbor = NY * Width + NX;
+                    if (Labels[Cell] == Labels[Neighbor])
+                    {
+                        continue;
+                    }
+
+                    const uint64 Key = (static_cast<uint64>(FMath::Min(Labels[Cell], Labels[Neighbor])) << 32) | static_cast<uint32>(FMath::Max(Labels[Cell], Labels[Neighbor]));
+                    const float Spill = FMath::Max(Heights[Cell], Heights[Neighbor]);
+                    float& Existing = Spills.FindOrAdd(Key, Spill);
+                    Existing = FMath::Min(Existing, Spill);
+                }
+            }
+        }
+
+        BlockEdges[Block].Reserve(Spills.Num());
+        for (const TPair<uint64, float>& Spill : Spills)
+        {
+            BlockEdges[Block].Add({ static_cast<int32>(Spill.Key >> 32), static_cast<int32>(Spill.Key & 0xffffffffu), Spill.Value });
+        }
+    });
+
+    // 2. Graph of perimeter cells: spill edges inside blocks, neighbours across block borders, and the
+    //    grid border draining to a single outlet node. The lowest possible spill level from each perimeter
+    //    cell to the outlet (a minimax path) is its final filled height.
+    TMap<int32, int32> NodeOfCell;
+    TArray<int32> NodeCells;
+    auto GetNode = [&](int32 Cell)
+    {
+        if (const int32* Node = NodeOfCell.Find(Cell))
+        {
+            return *Node;
+        }
+        NodeOfCell.Add(Cell, NodeCells.Num());
+        return NodeCells.Add(Cell);
+    };
+
+    TArray<FSpillEdge> Edges;
+    for (const TArray<FSpillEdge>& Block : BlockEdges)
+    {
+        for (const FSpillEdge& Edge : Block)
+        {
+            Edges.Add({ GetNode(Edge.A), GetNode(Edge.B), Edge.Spill });
+        }
+    }
+    auto AddCrossing = [&](int32 A, int32 B)
+    {
+        Edges.Add({ GetNode(A), GetNode(B), FMath::Max(Heights[A], Heights[B]) });
+    };
+    for (int32 BlockX = 1; BlockX < BlocksX; ++BlockX)
+    {
+        const int32 X = BlockX * BlockSize - 1;
+        for (int32 Y = 0; Y < Height; ++Y)
+        {
+            for (int32 DY = -1; DY <= 1; ++DY)
+            {
+                if (Y + DY >= 0 && Y + DY < Height)
+                {
+                    AddCrossing(Y * Width + X, (Y + DY) * Width + X + 1);
+                }
+            }
+        }
+    }
+    for (int32 BlockY = 1; BlockY < BlocksY; ++BlockY)
+    {
+        const int32 Y = BlockY * BlockSize - 1;
+        for (int32 X = 0; X < Width; ++X)
+        {
+            for (int32 DX = -1; DX <= 1; ++DX)
+            {
+                if (X + DX >= 0 && X + DX < Width)
+                {
+                    AddCrossing(Y * Width + X, (Y + 1) * Width + X + DX);
+                }
+            }
+        }
+    }
+
+    TArray<int32> BorderNodes;
+    for (int32 X = 0; X < Width; ++X)
+    {
+        BorderNodes.Add(GetNode(X));
+        BorderNodes.Add(GetNode((Height - 1) * Width + X));
+    }
+    for (int32 Y = 1; Y < Height - 1; ++Y)
+    {
+        BorderNodes.Add(GetNode(Y * Width));
+        BorderNodes.Add(GetNode(Y * Width + Width - 1));
+    }
+    const int32 Outlet = NodeCells.Num();
+    for (const int32 Node : BorderNodes)
+    {
+        Edges.Add({ Outlet, Node, Heights[NodeCells[Node]] });
+    }
+
+    // Compressed adjacency lists
+    const int32 NumNodes = Outlet + 1;
+    TArray<int32> FirstEdge;
+    FirstEdge.SetNumZeroed(NumNodes + 1);
+    for (const FSpillEdge& Edge : Edges)
+    {
+        ++FirstEdge[Edge.A + 1];
+        ++FirstEdge[Edge.B + 1];
+    }
+    for (int32 Node = 0; Node < NumNodes; ++Node)
+    {
+        FirstEdge[Node + 1] += FirstEdge[Node];
+    }
+    TArray<TPair<int32, float>> Adjacent;
+    Adjacent.SetNumUninitialized(FirstEdge[NumNodes]);
+    TArray<int32> Cursor(FirstEdge.GetData(), NumNodes);
+    for (const FSpillEdge& Edge : Edges)
+    {
+        Adjacent[Cursor[Edge.A]++] = TPair<int32, float>(Edge.B, Edge.Spill);
+        Adjacent[Cursor[Edge.B]++] = TPair<int32, float>(Edge.A, Edge.Spill);
+    }
+
+    TArray<float> SpillLevel;
+    SpillLevel.Init(TNumericLimits<float>::Max(), NumNodes);
+    TArray<uint8> Settled;
+    Settled.SetNumZeroed(NumNodes);
+    TArray<FOpenCell> Open;
+    SpillLevel[Outlet] = TNumericLimits<float>::Lowest();
+    Open.HeapPush({ SpillLevel[Outlet], Outlet }, FOpenCell::FLower());
+    while (Open.Num() > 0)
+    {
+        FOpenCell Top;
+        Open.HeapPop(Top, FOpenCell::FLower(), EAllowShrinking::No);
+        if (Settled[Top.Index])
+        {
+            continue;
+        }
+        Settled[Top.Index] = 1;
+
+        for (int32 EdgeIndex = FirstEdge[Top.Index]; EdgeIndex < FirstEdge[Top.Index + 1]; ++EdgeIndex)
+        {
+            const int32 Next = Adjacent[EdgeIndex].Key;
+            const float Level = FMath::Max(Top.Elevation, Adjacent[EdgeIndex].Value);
+            if (Level < SpillLevel[Next])
+            {
+                SpillLevel[Next] = Level;
+                Open.HeapPush({ Level, Next }, FOpenCell::FLower());
+            }
+        }
+    }
+
+    // 3. Refill every block from its perimeter at the final spill levels
+    for (int32 Node = 0; Node < Outlet; ++Node)
+    {
+        Heights[NodeCells[Node]] = SpillLevel[Node];
+    }
+    ParallelFor(BlocksX * BlocksY, [&](int32 Block)
+    {
+        FloodBlock(Heights, Width, GetBlock(Block), nullptr);
+    });
+}
+
+void FWorldForgeHydrology::ComputeFlowDirections(const TArray<float>& Filled, int32 Width, int32 Height, TArray<uint8>& OutDirections)
+{
+    using namespace WorldForgeHydrology;
+
+    OutDirections.SetNumUninitialized(Width * Height);
+    ParallelFor(Height, [&](int32 Y)
+    {
+        for (int32 X = 0; X < Width; ++X)
+        {
+            const int32 Cell = Y * Width + X;
+            uint8 Best = FWorldForgeHydrologyGrid::NoFlow;
+
+            // Border cells are outlets
+            if (X > 0 && Y > 0 && X < Width - 1 && Y < Height - 1)
+            {
+                float BestSlope = 0.0f;
+                for (int32 Direction = 0; Direction < 8; ++Direction)
+                {
+                    const int32 Neighbor = (Y + OffsetY[Direction]) * Width + X + OffsetX[Direction];
+                    const float Slope = (Filled[Cell] - Filled[Neighbor]) * InverseDistance[Direction];
+                    if (Slope > BestSlope)
+                    {
+                        BestSlope = Slope;
+                        Best = static_cast<uint8>(Direction);
+                    }
+                }
+            }
+            OutDirections[Cell] = Best;
+        }
+    });
+
+    // Filled depressions are flat. Drain them breadth-first toward the cells where they spill, so every
+    // flat cell flows along the shortest route to its outlet.
+    auto IsFlat = [&](int32 X, int32 Y)
+    {
+        return X > 0 && Y > 0 && X < Width - 1 && Y < Height - 1 && OutDirections[Y * Width + X] == FWorldForgeHydrologyGrid::NoFlow;
+    };
+
+    TArray<TArray<int32>> RowSeeds;
+    RowSeeds.SetNum(Height);
+    ParallelFor(Height, [&](int32 Y)
+    {
+        for (int32 X = 0; X < Width; ++X)
+        {
+            if (IsFlat(X, Y))
+            {
+                continue;
+            }
+
+            const int32 Cell = Y * Width + X;
+            for (int32 Direction = 0; Direction < 8; ++Direction)
+            {
+                const int32 NX = X + OffsetX[Direction];
+                const int32 NY = Y + OffsetY[Direction];
+                if (IsFlat(NX, NY) && Filled[NY * Width + NX] == Filled[Cell])
+                {
+                    RowSeeds[Y].Add(Cell);
+                    break;
+                }
+            }
+        }
+    });
+
+    TArray<int32> Queue;
+    for (const TArray<int32>& Seeds : RowSeeds)
+    {
+        Queue.Append(Seeds);
+    }
+
+    for (int32 Head = 0; Head < Queue.Num(); ++Head)
+    {
+        const int32 Cell = Queue[Head];
+        const int32 X = Cell % Width;
+        const int32 Y = Cell / Width;
+        for (int32 Direction = 0; Direction < 8; ++Direction)
+        {
+            const int32 NX = X + OffsetX[Direction];
+            const int32 NY = Y + OffsetY[Direction];
+            const int32 Neighbor = NY * Width + NX;
+            if (IsFlat(NX, NY) && Filled[Neighbor] == Filled[Cell])
+            {
+                OutDirections[Neighbor] = static_cast<uint8>(Opposite(Direction));
+                Queue.Add(Neighbor);
+            }
+        }
+    }
+}
+
+void FWorldForgeHydrology::AccumulateFlow(const TArray<uint8>& Directions, int32 Width, int32 Height, float Rainfall, TArray<float>& OutAccumulation)
+{
+    using namespace WorldForgeHydrology;
+
+    const int32 NumCells = Width * Height;
+    OutAccumulation.SetNumZeroed(NumCells);
+
+    // Donor count per cell; cells without donors are where walks start
+    TArray<int32> PendingDonors;
+    PendingDonors.SetNumUninitialized(NumCells);
+    TArray<uint8> IsSource;
+    IsSource.SetNumUninitialized(NumCells);
+
+    ParallelFor(Height, [&](int32 Y)
+    {
+        for (int32 X = 0; X < Width; ++X)
+        {
+            int32 Donors = 0;
+            for (int32 Direction = 0; Direction < 8; ++Direction)
+            {
+                const int32 NX = X + OffsetX[Direction];
+                const int32 NY = Y + OffsetY[Direction];
+                if (NX >= 0 && NY >= 0 && NX < Width && NY < Height && Directions[NY * Width + NX] == Opposite(Direction))
+                {
+                    ++Donors;
+                }
+            }
+            PendingDonors[Y * Width + X] = Donors;
+            IsSource[Y * Width + X] = Donors == 0 ? 1 : 0;
+        }
+    });
+
+    // Walk downstream from every source. The donor that finishes a cell last carries on from it, so each
+    // cell is summed exactly once, after all of its donors, and always in the same neighbour order.
+    ParallelFor(Height, [&](int32 Y)
+    {
+        for (int32 X = 0; X < Width; ++X)
+        {
+            int32 Cell = Y * Width + X;
+            if (!IsSource[Cell])
+            {
+                continue;
+            }
+
+            OutAccumulation[Cell] = Rainfall;
+            while (Directions[Cell] != FWorldForgeHydrologyGrid::NoFlow)
+            {
+                const int32 Direction = Directions[Cell];
+                const int32 Receiver = Cell + OffsetY[Direction] * Width + OffsetX[Direction];
+                if (FPlatformAtomics::InterlockedDecrement(&PendingDonors[Receiver]) != 0)
+                {
+                    break;
+                }
+
+                OutAccumulation[Receiver] = PullAccumulation(Directions, OutAccumulation, Width, Height, Receiver, Rainfall);
+                Cell = Receiver;
+            }
+        }
+    });
+}
+
+void FWorldForgeHydrology::ExtractRivers(FWorldForgeHydrologyGrid& Grid, const FWorldForgeHydrologySettings& Settings)
+{
+    using namespace WorldForgeHydrology;
+
+    const int32 Width = Grid.Width;
+    const int32 Height = Grid.Height;
+    Grid.WaterMask.SetNumUninitialized(Width * Height);
+    ParallelFor(Height, [&](int32 Y)
+    {
+        for (int32 X = 0; X < Width; ++X)
+        {
+            Grid.WaterMask[Y * Width + X] = Grid.Accumulation[Y * Width + X] >= Settings.RiverThreshold ? 1 : 0;
+        }
+    });
+
+    auto MakePoint = [&Grid, Width](int32 Cell)
+    {
+        return FVector(
+            Grid.Origin.X + (Cell % Width) * Grid.SampleSpacing,
+            Grid.Origin.Y + (Cell / Width) * Grid.SampleSpacing,
+            Grid.Filled[Cell]);
+    };
+
+    // Trace from every river head (a river cell no other river cell drains into) until the river
+    // leaves the grid or joins one traced earlier
+    TArray<uint8> Traced;
+    Traced.SetNumZeroed(Width * Height);
+    const int32 Stride = FMath::Max(1, Settings.SplineStride);
+    Grid.Rivers.Reset();
+
+    for (int32 Head = 0; Head < Width * Height; ++Head)
+    {
+        if (!Grid.WaterMask[Head])
+        {
+            continue;
+        }
+
+        bool bHasRiverDonor = false;
+        const int32 HX = Head % Width;
+        const int32 HY = Head / Width;
+        for (int32 Direction = 0; Direction < 8 && !bHasRiverDonor; ++Direction)
+        {
+            const int32 NX = HX + OffsetX[Direction];
+            const int32 NY = HY + OffsetY[Direction];
+            if (NX >= 0 && NY >= 0 && NX < Width && NY < Height)
+            {
+                const int32 Neighbor = NY * Width + NX;
+                bHasRiverDonor = Grid.WaterMask[Neighbor] && Grid.FlowDirection[Neighbor] == Opposite(Direction);
+            }
+        }
+        if (bHasRiverDonor)
+        {
+            continue;
+        }
+
+        FWorldForgeRiver River;
+        int32 Cell = Head;
+        int32 Steps = 0;
+        while (true)
+        {
+            const bool bJoins = Traced[Cell] != 0;
+            const bool bOutlet = Grid.FlowDirection[Cell] == FWorldForgeHydrologyGrid::NoFlow;
+            if (bJoins || bOutlet || Steps % Stride == 0)
+            {
+                River.Points.Add(MakePoint(Cell));
+                River.Flow.Add(Grid.Accumulation[Cell]);
+            }
+            if (bJoins || bOutlet)
+            {
+                Traced[Cell] = 1;
+                break;
+            }
+
+            Traced[Cell] = 1;
+            const int32 Direction = Grid.FlowDirection[Cell];
+            Cell += OffsetY[Direction] * Width + OffsetX[Direction];
+            ++Steps;
+        }
+
+        if (Steps >= Settings.MinRiverCells && River.Points.Num() >= 2)
+        {
+            Grid.Rivers.Add(MoveTemp(River));
+        }
+    }
+}
+
+void FWorldForgeHydrology::ComputeTile(const FWorldForgeTerrainParams& TerrainParams, const FWorldForgeHydrologySettings& Settings,
+                                       FIntPoint Coord, int32 Resolution, float SampleSpacing, int32 ApronSamples, FWorldForgeWaterTile& OutTile)
+{
+    OutTile.Coord = Coord;
+    OutTile.Resolution = FMath::Max(Resolution, 2);
+    OutTile.SampleSpacing = SampleSpacing;
+
+    // Neighbouring terrain is a pure function of the same parameters, so the apron is generated, not loaded
+    const FVector2D TileOrigin = OutTile.GetOrigin();
+    const int32 RegionSize = OutTile.Resolution + 2 * ApronSamples;
+    const FVector2D RegionOrigin = TileOrigin - FVector2D(ApronSamples * SampleSpacing);
+
+    TArray<float> Heights;
+    FWorldForgeTerrainGenerator::GenerateRegion(TerrainParams, RegionOrigin, RegionSize, RegionSize, SampleSpacing, Heights);
+
+    FWorldForgeHydrologyGrid Grid;
+    Compute(MoveTemp(Heights), RegionSize, RegionSize, SampleSpacing, RegionOrigin, Settings, Grid);
+
+    OutTile.WaterMask.SetNumUninitialized(OutTile.Resolution * OutTile.Resolution);
+    for (int32 Y = 0; Y < OutTile.Resolution; ++Y)
+    {
+        FMemory::Memcpy(&OutTile.WaterMask[Y * OutTile.Resolution], &Grid.WaterMask[(Y + ApronSamples) * RegionSize + ApronSamples], OutTile.Resolution);
+    }
+
+    OutTile.Rivers.Reset();
+    const FVector2D TileMax = TileOrigin + FVector2D(OutTile.GetSize());
+    for (const FWorldForgeRiver& River : Grid.Rivers)
+    {
+        WorldForgeHydrology::ClipRiver(River, TileOrigin, TileMax, OutTile.Rivers);
+    }
+}
+
+void FWorldForgeHydrology::BuildTerrainTile(const FWorldForgeTerrainParams& TerrainParams, const FWorldForgeHydrologySettings& Settings,
+                                            FIntPoint Coord, int32 Resolution, float SampleSpacing, FWorldForgeTerrainTileData& OutData)
+{
+    TSharedPtr<FWorldForgeHeightfieldTile, ESPMode::ThreadSafe> Heightfield = MakeShared<FWorldForgeHeightfieldTile, ESPMode::ThreadSafe>();
+    FWorldForgeTerrainGenerator::GenerateTile(TerrainParams, Coord, Resolution, SampleSpacing, *Heightfield);
+    FWorldForgeTerrainGenerator::BuildMeshData(*Heightfield, OutData.Mesh);
+
+    // Half a tile of apron on each side is enough for rivers to agree across tile borders
+    TSharedPtr<FWorldForgeWaterTile, ESPMode::ThreadSafe> Water = MakeShared<FWorldForgeWaterTile, ESPMode::ThreadSafe>();
+    ComputeTile(TerrainParams, Settings, Coord, Resolution, SampleSpacing, (Resolution - 1) / 2, *Water);
+    BuildRiverMeshData(*Water, OutData.WaterMesh);
+
+    OutData.Heightfield = Heightfield;
+    OutData.Water = Water;
+}
+
+void FWorldForgeHydrology::BuildRiverMeshData(const FWorldForgeWaterTile& Tile, FWorldForgeTerrainMeshData& OutMesh)
+{
+    // Sits just above the filled surface so it covers the terrain mesh in river beds and lakes
+    const float SurfaceOffset = 20.0f;
+
+    OutMesh = FWorldForgeTerrainMeshData();
+    for (const FWorldForgeRiver& River : Tile.Rivers)
+    {
+        float Distance = 0.0f;
+        for (int32 Index = 0; Index < River.Points.Num(); ++Index)
+        {
+            const FVector& Point = River.Points[Index];
+            const FVector& Previous = River.Points[FMath::Max(Index - 1, 0)];
+            const FVector& Next = River.Points[FMath::Min(Index + 1, River.Points.Num() - 1)];
+            const FVector Tangent = FVector(Next.X - Previous.X, Next.Y - Previous.Y, 0.0f).GetSafeNormal();
+            const FVector Across(-Tangent.Y, Tangent.X, 0.0f);
+            const float HalfWidth = FMath::Clamp(FMath::Sqrt(River.Flow[Index]) * 8.0f, 100.0f, 1500.0f);
+
+            if (Index > 0)
+            {
+                Distance += FVector::Dist2D(Point, Previous);
+                const int32 Base = OutMesh.Vertices.Num() - 2;
+                OutMesh.Triangles.Append({ Base, Base + 2, Base + 1, Base + 1, Base + 2, Base + 3 });
+            }
+
+            const FVector Surface = Point + FVector(0.0f, 0.0f, SurfaceOffset);
+            OutMesh.Vertices.Add(Surface - Across * HalfWidth);
+            OutMesh.Vertices.Add(Surface + Across * HalfWidth);
+            OutMesh.Normals.Add(FVector::UpVector);
+            OutMesh.Normals.Add(FVector::UpVector);
+            OutMesh.UVs.Add(FVector2D(0.0f, Distance / 1000.0f));
+            OutMesh.UVs.Add(FVector2D(1.0f, Distance / 1000.0f));
+        }
+    }
+}
+
+void FWorldForgeWaterMap::AddTile(const FTilePtr& Tile)
+{
+    if (!Tile.IsValid() || Tile->Resolution < 2)
+    {
+        return;
+    }
+
+    FWriteScopeLock WriteLock(Lock);
+    if (Tile->GetSize() != TileSize)
+    {
+        Tiles.Empty();
+        TileSize = Tile->GetSize();
+    }
+    Tiles.Add(Tile->Coord, Tile);
+}
+
+bool FWorldForgeWaterMap::RemoveTile(FIntPoint Coord)
+{
+    FWriteScopeLock WriteLock(Lock);
+    return Tiles.Remove(Coord) > 0;
+}
+
+void FWorldForgeWaterMap::Clear()
+{
+    FWriteScopeLock WriteLock(Lock);
+    Tiles.Empty();
+}
+
+int32 FWorldForgeWaterMap::Num() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Tiles.Num();
+}
+
+bool FWorldForgeWaterMap::IsWater(float X, float Y) const
+{
+    FReadScopeLock ReadLock(Lock);
+    if (Tiles.Num() == 0)
+    {
+        return false;
+    }
+
+    const FIntPoint Coord(FMath::FloorToInt32(X / TileSize), FMath::FloorToInt32(Y / TileSize));
+    const FTilePtr* Tile = Tiles.Find(Coord);
+    if (!Tile)
+    {
+        return false;
+    }
+
+    const FVector2D Origin = (*Tile)->GetOrigin();
+    const int32 Resolution = (*Tile)->Resolution;
+    const int32 SampleX = FMath::Clamp(FMath::RoundToInt32((X - Origin.X) / (*Tile)->SampleSpacing), 0, Resolution - 1);
+    const int32 SampleY = FMath::Clamp(FMath::RoundToInt32((Y - Origin.Y) / (*Tile)->SampleSpacing), 0, Resolution - 1);
+    return (*Tile)->WaterMask[SampleY * Resolution + SampleX] != 0;
+}
+
+bool FWorldForgeWaterMap::FindNearestRiverPoint(const FVector& Location, float MaxDistance, FVector& OutPoint) const
+{
+    FReadScopeLock ReadLock(Lock);
+    if (Tiles.Num() == 0)
+    {
+        return false;
+    }
+
+    const int32 MinX = FMath::FloorToInt32((Location.X - MaxDistance) / TileSize);
+    const int32 MaxX = FMath::FloorToInt32((Location.X + MaxDistance) / TileSize);
+    const int32 MinY = FMath::FloorToInt32((Location.Y - MaxDistance) / TileSize);
+    const int32 MaxY = FMath::FloorToInt32((Location.Y + MaxDistance) / TileSize);
+
+    double BestDistanceSquared = FMath::Square(static_cast<double>(MaxDistance));
+    bool bFound = false;
+    for (int32 TileY = MinY; TileY <= MaxY; ++TileY)
+    {
+        for (int32 TileX = MinX; TileX <= MaxX; ++TileX)
+        {
+            const FTilePtr* Tile = Tiles.Find(FIntPoint(TileX, TileY));
+            if (!Tile)
+            {
+                continue;
+            }
+
+            for (const FWorldForgeRiver& River : (*Tile)->Rivers)
+            {
+                for (const FVector& Point : River.Points)
+                {
+                    const double DistanceSquared = FVector::DistSquared2D(Location, Point);
+                    if (DistanceSquared <= BestDistanceSquared)
+                    {
+                        BestDistanceSquared = DistanceSquared;
+                        OutPoint = Point;
+                        bFound = true;
+                    }
+                }
+            }
+        }
+    }
+    return bFound;
+}
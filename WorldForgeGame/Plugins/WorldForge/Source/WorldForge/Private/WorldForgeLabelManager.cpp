@@ -0,0 +1,113 @@
+#include "WorldForgeLabelManager.h"
+#include "WorldForgeSpatialIndex.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/TextRenderComponent.h"
+#include "GameFramework/PlayerController.h"
+
+AWorldForgeLabelManager::AWorldForgeLabelManager()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    SceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
+    SetRootComponent(SceneRoot);
+}
+
+void AWorldForgeLabelManager::UpdateLabels(const FWorldForgeSpatialIndex& SpatialIndex, APlayerController* PlayerController, const TSet<FString>* SkipIds)
+{
+    if (!PlayerController || !PlayerController->PlayerCameraManager)
+    {
+        return;
+    }
+
+    const FVector ViewLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+    const FVector ViewForward = PlayerController->PlayerCameraManager->GetCameraRotation().Vector();
+    // Small margin so labels do not pop at the screen edge
+    const float CosHalfFov = FMath::Cos(FMath::DegreesToRadians(PlayerController->PlayerCameraManager->GetFOVAngle() * 0.5f + 10.0f));
+
+    // Over-fetch so off-screen candidates can be skipped without losing on-screen ones
+    TArray<const FWorldForgeSpatialEntry*> Candidates;
+    SpatialIndex.FindNearest(ViewLocation, bOnlyOnScreen ? MaxLabels * 4 : MaxLabels, MaxLabelDistance, Candidates);
+
+    TMap<FString, UTextRenderComponent*> NextLabels;
+    NextLabels.Reserve(MaxLabels);
+
+    for (const FWorldForgeSpatialEntry* Entry : Candidates)
+    {
+        if (NextLabels.Num() >= MaxLabels)
+        {
+            break;
+        }
+
+        if (SkipIds && SkipIds->Contains(Entry->Id))
+        {
+            continue;
+        }
+
+        const FVector LabelLocation = Entry->Location + FVector(0.0f, 0.0f, LabelHeight);
+        if (bOnlyOnScreen)
+        {
+            const FVector ToLabel = (LabelLocation - ViewLocation).GetSafeNormal();
+            if (FVector::DotProduct(ToLabel, ViewForward) < CosHalfFov)
+            {
+                continue;
+            }
+        }
+
+        // Keep the component a landmark already had so its text is not reset
+        UTextRenderComponent* Label = nullptr;
+        if (!ActiveLabels.RemoveAndCopyValue(Entry->Id, Label))
+        {
+            Label = AcquireLabel();
+            Label->SetText(FText::FromString(Entry->Name));
+            Label->SetVisibility(true);
+        }
+
+        Label->SetWorldLocationAndRotation(LabelLocation, (ViewLocation - LabelLocation).Rotation());
+        NextLabels.Add(Entry->Id, Label);
+    }
+
+    // Anything left over is no longer labelled
+    for (auto& Pair : ActiveLabels)
+    {
+        ReleaseLabel(Pair.Value);
+    }
+    ActiveLabels = MoveTemp(NextLabels);
+}
+
+void AWorldForgeLabelManager::ClearLabels()
+{
+    for (auto& Pair : ActiveLabels)
+    {
+        ReleaseLabel(Pair.Value);
+    }
+    ActiveLabels.Empty();
+}
+
+UTextRenderComponent* AWorldForgeLabelManager::AcquireLabel()
+{
+    if (FreeLabels.Num() > 0)
+    {
+        return FreeLabels.Pop(EAllowShrinking::No);
+    }
+
+    UTextRenderComponent* Label = NewObject<UTextRenderComponent>(this);
+    Label->SetupAttachment(SceneRoot);
+    Label->SetHorizontalAlignment(EHTA_Center);
+    Label->SetVerticalAlignment(EVRTA_TextCenter);
+    Label->SetWorldSize(LabelWorldSize);
+    Label->SetTextRenderColor(FColor::White);
+    Label->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    Label->RegisterComponent();
+
+    LabelPool.Add(Label);
+    return Label;
+}
+
+void AWorldForgeLabelManager::ReleaseLabel(UTextRenderComponent* Label)
+{
+    if (Label)
+    {
+        Label->SetVisibility(false);
+        FreeLabels.Add(Label);
+    }
+}
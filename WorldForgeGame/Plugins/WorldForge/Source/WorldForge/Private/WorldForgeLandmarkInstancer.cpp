@@ -0,0 +1,161 @@
+#include "WorldForgeLandmarkInstancer.h"
+#include "WorldForgeSettlementActor.h"
+#include "WorldForgeSubsystem.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "UObject/ConstructorHelpers.h"
+
+AWorldForgeLandmarkInstancer::AWorldForgeLandmarkInstancer()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    SceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
+    SetRootComponent(SceneRoot);
+
+    // Same placeholder mesh as AWorldForgeSettlementActor so both modes look alike
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMesh(TEXT("/Engine/BasicShapes/Cube"));
+    if (CubeMesh.Succeeded())
+    {
+        LandmarkMesh = CubeMesh.Object;
+    }
+}
+
+bool AWorldForgeLandmarkInstancer::AddLandmark(const FWorldForgeLandmark& Landmark)
+{
+    if (Handles.Contains(Landmark.Id))
+    {
+        return false;
+    }
+
+    FTypeInstances& TypeInstances = GetOrCreateTypeInstances(Landmark.Type);
+    if (!TypeInstances.Component)
+    {
+        return false;
+    }
+
+    FInstanceHandle Handle;
+    Handle.Type = Landmark.Type;
+    Handle.Transform = GetInstanceTransform(Landmark);
+
+    // Reuse a collapsed slot if one is available
+    if (TypeInstances.FreeIndices.Num() > 0)
+    {
+        Handle.InstanceIndex = TypeInstances.FreeIndices.Pop(EAllowShrinking::No);
+        TypeInstances.Component->UpdateInstanceTransform(Handle.InstanceIndex, Handle.Transform, true, true);
+    }
+    else
+    {
+        Handle.InstanceIndex = TypeInstances.Component->AddInstance(Handle.Transform, true);
+    }
+
+    const FLinearColor TypeColor = AWorldForgeSettlementActor::GetColorForType(Landmark.Type);
+    const float CustomData[3] = { TypeColor.R, TypeColor.G, TypeColor.B };
+    TypeInstances.Component->SetCustomData(Handle.InstanceIndex, MakeArrayView(CustomData, 3), true);
+
+    Handles.Add(Landmark.Id, Handle);
+    return true;
+}
+
+bool AWorldForgeLandmarkInstancer::RemoveLandmark(const FString& LandmarkId)
+{
+    FInstanceHandle Handle;
+    if (!Handles.RemoveAndCopyValue(LandmarkId, Handle))
+    {
+        return false;
+    }
+
+    if (FTypeInstances* TypeInstances = Types.Find(Handle.Type))
+    {
+        if (TypeInstances->Component)
+        {
+            FTransform Collapsed = Handle.Transform;
+            Collapsed.SetScale3D(FVector::ZeroVector);
+            TypeInstances->Component->UpdateInstanceTransform(Handle.InstanceIndex, Collapsed, true, true);
+        }
+        TypeInstances->FreeIndices.Add(Handle.InstanceIndex);
+    }
+    return true;
+}
+
+void AWorldForgeLandmarkInstancer::ClearLandmarks()
+{
+    for (auto& Pair : Types)
+    {
+        if (Pair.Value.Component)
+        {
+            Pair.Value.Component->ClearInstances();
+        }
+        Pair.Value.FreeIndices.Empty();
+    }
+    Handles.Empty();
+}
+
+void AWorldForgeLandmarkInstancer::SetLandmarkHidden(const FString& LandmarkId, bool bHidden)
+{
+    const FInstanceHandle* Handle = Handles.Find(LandmarkId);
+    FTypeInstances* TypeInstances = Handle ? Types.Find(Handle->Type) : nullptr;
+    if (!TypeInstances || !TypeInstances->Component)
+    {
+        return;
+    }
+
+    FTransform Transform = Handle->Transform;
+    if (bHidden)
+    {
+        Transform.SetScale3D(FVector::ZeroVector);
+    }
+    TypeInstances->Component->UpdateInstanceTransform(Handle->InstanceIndex, Transform, true, true);
+}
+
+AWorldForgeLandmarkInstancer::FTypeInstances& AWorldForgeLandmarkInstancer::GetOrCreateTypeInstances(EWorldForgeLandmarkType Type)
+{
+    FTypeInstances& TypeInstances = Types.FindOrAdd(Type);
+    if (TypeInstances.Component)
+    {
+        return TypeInstances;
+    }
+
+    const FName ComponentName(*FString::Printf(TEXT("LandmarkInstances_%d"), static_cast<int32>(Type)));
+    UHierarchicalInstancedStaticMeshComponent* Component = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, ComponentName);
+    Component->SetStaticMesh(LandmarkMesh);
+    Component->NumCustomDataFloats = 3;
+    Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    Component->SetCullDistances(0, FMath::RoundToInt32(AWorldForgeSettlementActor::GetLandmarkCullDistance()));
+    if (UMaterialInterface* Material = GetMaterialForType(Type))
+    {
+        Component->SetMaterial(0, Material);
+    }
+    Component->SetupAttachment(SceneRoot);
+    Component->RegisterComponent();
+
+    TypeComponents.Add(Component);
+    TypeInstances.Component = Component;
+
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Created instanced landmark component for type %d"), static_cast<int32>(Type));
+    return TypeInstances;
+}
+
+UMaterialInterface* AWorldForgeLandmarkInstancer::GetMaterialForType(EWorldForgeLandmarkType Type) const
+{
+    if (InstanceMaterial)
+    {
+        return InstanceMaterial;
+    }
+
+    // One component per type, so the type's shared tinted material colors it like the settlement actors
+    UMaterialInterface* BaseMaterial = LandmarkMesh ? LandmarkMesh->GetMaterial(0) : nullptr;
+    UGameInstance* GameInstance = GetGameInstance();
+    UWorldForgeSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<UWorldForgeSubsystem>() : nullptr;
+    return BaseMaterial && Subsystem ? Subsystem->GetLandmarkMaterial(BaseMaterial, Type) : nullptr;
+}
+
+FTransform AWorldForgeLandmarkInstancer::GetInstanceTransform(const FWorldForgeLandmark& Landmark)
+{
+    // Matches the MeshComponent offset used by AWorldForgeSettlementActor
+    return FTransform(
+        FRotator::ZeroRotator,
+        Landmark.Location + FVector(0.0f, 0.0f, 50.0f),
+        AWorldForgeSettlementActor::GetScaleForType(Landmark.Type));
+}
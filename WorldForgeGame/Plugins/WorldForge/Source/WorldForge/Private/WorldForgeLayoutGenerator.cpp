@@ -0,0 +1,272 @@
+#include "WorldForgeLayoutGenerator.h"
+#include "Math/RandomStream.h"
+#include "Misc/Crc.h"
+
+namespace WorldForgeLayout
+{
+    /** Unit meshes are 100 units on a side and centered, so lift each piece by half its height */
+    static FTransform MakePiece(const FVector2D& Position, float Yaw, const FVector& SizeInUnits)
+    {
+        return FTransform(
+            FRotator(0.0f, Yaw, 0.0f),
+            FVector(Position.X, Position.Y, SizeInUnits.Z * 0.5f),
+            SizeInUnits / 100.0f);
+    }
+
+    static FVector2D Polar(float Radius, float AngleDegrees)
+    {
+        const float Radians = FMath::DegreesToRadians(AngleDegrees);
+        return FVector2D(Radius * FMath::Cos(Radians), Radius * FMath::Sin(Radians));
+    }
+
+    /** Rule set derived from the landmark type and traits */
+    struct FRules
+    {
+        float PlazaRadius = 1000.0f;
+        float OuterRadius = 4000.0f;
+        int32 NumStreets = 4;
+        float LotSpacing = 1200.0f;
+        float HallChance = 0.1f;
+        float TempleChance = 0.05f;
+        int32 MaxTemples = 1;
+        float RuinChance = 0.0f;
+        bool bWalls = false;
+        int32 NumTowers = 0;
+        bool bCentralKeep = false;
+        bool bCentralTemple = false;
+        bool bBuildings = true;
+    };
+
+    static FRules MakeRules(const FWorldForgeLayoutParams& Params)
+    {
+        FRules Rules;
+
+        // Prosperity -> bigger, denser settlements with more halls
+        Rules.OuterRadius = 2500.0f + 3500.0f * Params.Prosperity;
+        Rules.LotSpacing = FMath::Lerp(1500.0f, 800.0f, Params.Prosperity);
+        Rules.NumStreets = 3 + FMath::RoundToInt32(Params.Prosperity * 5.0f);
+        Rules.HallChance = 0.05f + 0.25f * Params.Prosperity;
+
+        // Religiosity -> temples
+        Rules.TempleChance = 0.02f + 0.15f * Params.Religiosity;
+        Rules.MaxTemples = 1 + FMath::FloorToInt32(Params.Religiosity * 3.0f);
+
+        // Militarism -> walls and towers
+        Rules.bWalls = Params.Militarism > 0.4f;
+        Rules.NumTowers = Rules.bWalls ? 4 + FMath::RoundToInt32(Params.Militarism * 8.0f) : 0;
+
+        switch (Params.Type)
+        {
+        case EWorldForgeLandmarkType::Fortress:
+            Rules.bWalls = true;
+            Rules.bCentralKeep = true;
+            Rules.NumTowers = FMath::Max(Rules.NumTowers, 6);
+            Rules.OuterRadius *= 0.7f;
+            Rules.HallChance *= 0.5f;
+            break;
+
+        case EWorldForgeLandmarkType::Monastery:
+            Rules.bCentralTemple = true;
+            Rules.OuterRadius *= 0.6f;
+            Rules.NumStreets = FMath::Min(Rules.NumStreets, 4);
+            Rules.TempleChance *= 2.0f;
+            break;
+
+        case EWorldForgeLandmarkType::Ruin:
+            Rules.RuinChance = 0.6f;
+            Rules.bWalls = Rules.bWalls || Params.Militarism > 0.25f;
+            break;
+
+        case EWorldForgeLandmarkType::Natural:
+            Rules.bBuildings = false;
+            Rules.bWalls = false;
+            Rules.NumTowers = 0;
+            break;
+
+        default:
+            break;
+        }
+
+        return Rules;
+    }
+}
+
+FWorldForgeLayoutParams FWorldForgeLayoutParams::FromLandmark(const FWorldForgeLandmark& Landmark, const FWorldForgeState& State)
+{
+    FWorldForgeLayoutParams Params;
+    Params.Type = Landmark.Type;
+    Params.Militarism = State.Militarism;
+    Params.Prosperity = State.Prosperity;
+    Params.Religiosity = State.Religiosity;
+    Params.Seed = FWorldForgeLayoutGenerator::MakeSeed(State.Seed, Landmark.Id);
+    return Params;
+}
+
+bool FWorldForgeLayoutParams::operator==(const FWorldForgeLayoutParams& Other) const
+{
+    return Type == Other.Type
+        && Militarism == Other.Militarism
+        && Prosperity == Other.Prosperity
+        && Religiosity == Other.Religiosity
+        && Seed == Other.Seed;
+}
+
+int32 FWorldForgeSettlementLayout::NumPieces() const
+{
+    int32 Total = 0;
+    for (const TArray<FTransform>& Transforms : Pieces)
+    {
+        Total += Transforms.Num();
+    }
+    return Total;
+}
+
+uint32 FWorldForgeSettlementLayout::ComputeHash() const
+{
+    uint32 Hash = 0;
+    for (int32 PieceIndex = 0; PieceIndex < UE_ARRAY_COUNT(Pieces); ++PieceIndex)
+    {
+        Hash = FCrc::MemCrc32(&PieceIndex, sizeof(PieceIndex), Hash);
+        for (const FTransform& Transform : Pieces[PieceIndex])
+        {
+            const FVector Translation = Transform.GetTranslation();
+            const FQuat Rotation = Transform.GetRotation();
+            const FVector Scale = Transform.GetScale3D();
+            Hash = FCrc::MemCrc32(&Translation, sizeof(Translation), Hash);
+            Hash = FCrc::MemCrc32(&Rotation, sizeof(Rotation), Hash);
+            Hash = FCrc::MemCrc32(&Scale, sizeof(Scale), Hash);
+        }
+    }
+    return Hash;
+}
+
+uint32 FWorldForgeLayoutGenerator::MakeSeed(int32 WorldSeed, const FString& LandmarkId)
+{
+    // StrCrc32 is case-sensitive and stable across runs, unlike GetTypeHash(FString)
+    return HashCombine(static_cast<uint32>(WorldSeed), FCrc::StrCrc32(*LandmarkId));
+}
+
+FWorldForgeSettlementLayout FWorldForgeLayoutGenerator::Generate(const FWorldForgeLayoutParams& Params)
+{
+    using namespace WorldForgeLayout;
+
+    FWorldForgeSettlementLayout Layout;
+    FRandomStream Random(static_cast<int32>(Params.Seed));
+    const FRules Rules = MakeRules(Params);
+
+    // Natural landmarks are a loose ring of standing stones
+    if (!Rules.bBuildings)
+    {
+        const int32 NumStones = Random.RandRange(5, 11);
+        for (int32 Index = 0; Index < NumStones; ++Index)
+        {
+            const float Angle = 360.0f * Index / NumStones + Random.FRandRange(-10.0f, 10.0f);
+            const FVector Size(Random.FRandRange(150.0f, 300.0f), Random.FRandRange(150.0f, 300.0f), Random.FRandRange(300.0f, 900.0f));
+            Layout.Get(EWorldForgeLayoutPiece::Rubble).Add(MakePiece(Polar(Rules.PlazaRadius, Angle), Random.FRandRange(0.0f, 360.0f), Size));
+        }
+        return Layout;
+    }
+
+    // Central plaza
+    Layout.Get(EWorldForgeLayoutPiece::Plaza).Add(MakePiece(FVector2D::ZeroVector, 0.0f, FVector(Rules.PlazaRadius * 2.0f, Rules.PlazaRadius * 2.0f, 10.0f)));
+
+    int32 NumTemples = 0;
+    if (Rules.bCentralTemple)
+    {
+        Layout.Get(EWorldForgeLayoutPiece::Temple).Add(MakePiece(FVector2D::ZeroVector, 0.0f, FVector(1400.0f, 1400.0f, 2200.0f)));
+        ++NumTemples;
+    }
+    if (Rules.bCentralKeep)
+    {
+        Layout.Get(EWorldForgeLayoutPiece::Tower).Add(MakePiece(FVector2D::ZeroVector, 0.0f, FVector(1200.0f, 1200.0f, 3000.0f)));
+    }
+
+    // Radial streets with building lots on both sides
+    const float StreetOffset = Random.FRandRange(0.0f, 360.0f);
+    TArray<float> StreetAngles;
+    for (int32 Street = 0; Street < Rules.NumStreets; ++Street)
+    {
+        const float Angle = StreetOffset + 360.0f * Street / Rules.NumStreets + Random.FRandRange(-8.0f, 8.0f);
+        StreetAngles.Add(Angle);
+
+        for (float Distance = Rules.PlazaRadius + Rules.LotSpacing * 0.5f; Distance < Rules.OuterRadius; Distance += Rules.LotSpacing)
+        {
+            for (const float Side : { -1.0f, 1.0f })
+            {
+                // Lots thin out toward the edge of town
+                const float EdgeFalloff = Distance / Rules.OuterRadius;
+                if (Random.FRand() < EdgeFalloff * 0.35f)
+                {
+                    continue;
+                }
+
+                const FVector2D StreetPoint = Polar(Distance, Angle);
+                const FVector2D Across = Polar(1.0f, Angle + 90.0f) * Side * Random.FRandRange(450.0f, 650.0f);
+                const FVector2D LotPosition = StreetPoint + Across;
+
+                EWorldForgeLayoutPiece Piece = EWorldForgeLayoutPiece::House;
+                FVector Size(Random.FRandRange(400.0f, 700.0f), Random.FRandRange(400.0f, 600.0f), Random.FRandRange(350.0f, 550.0f));
+
+                const float Roll = Random.FRand();
+                if (NumTemples < Rules.MaxTemples && Roll < Rules.TempleChance)
+                {
+                    Piece = EWorldForgeLayoutPiece::Temple;
+                    Size = FVector(900.0f, 900.0f, 1400.0f);
+                    ++NumTemples;
+                }
+                else if (Roll < Rules.TempleChance + Rules.HallChance)
+                {
+                    Piece = EWorldForgeLayoutPiece::Hall;
+                    Size = FVector(Random.FRandRange(900.0f, 1300.0f), Random.FRandRange(600.0f, 800.0f), Random.FRandRange(500.0f, 700.0f));
+                }
+
+                if (Random.FRand() < Rules.RuinChance)
+                {
+                    // Collapsed building: low, scattered rubble instead
+                    Piece = EWorldForgeLayoutPiece::Rubble;
+                    Size.Z *= Random.FRandRange(0.15f, 0.4f);
+                }
+
+                Layout.Get(Piece).Add(MakePiece(LotPosition, Angle + Random.FRandRange(-5.0f, 5.0f), Size));
+            }
+        }
+    }
+
+    // Wall ring with gates where the streets leave town and evenly spaced towers
+    if (Rules.bWalls)
+    {
+        const float WallRadius = Rules.OuterRadius + 500.0f;
+        const float SegmentLength = 1000.0f;
+        const int32 NumSegments = FMath::Max(8, FMath::CeilToInt32(2.0f * PI * WallRadius / SegmentLength));
+        const float GateHalfWidth = FMath::RadiansToDegrees(600.0f / WallRadius);
+
+        for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+        {
+            const float Angle = StreetOffset + 360.0f * (Segment + 0.5f) / NumSegments;
+
+            bool bGate = false;
+            for (const float StreetAngle : StreetAngles)
+            {
+                if (FMath::Abs(FMath::FindDeltaAngleDegrees(Angle, StreetAngle)) < GateHalfWidth)
+                {
+                    bGate = true;
+                    break;
+                }
+            }
+            if (bGate || Random.FRand() < Rules.RuinChance * 0.5f)
+            {
+                continue;
+            }
+
+            Layout.Get(EWorldForgeLayoutPiece::Wall).Add(MakePiece(Polar(WallRadius, Angle), Angle + 90.0f, FVector(SegmentLength * 1.05f, 150.0f, 500.0f)));
+        }
+
+        for (int32 Tower = 0; Tower < Rules.NumTowers; ++Tower)
+        {
+            const float Angle = StreetOffset + 360.0f * Tower / Rules.NumTowers + 180.0f / Rules.NumTowers;
+            Layout.Get(EWorldForgeLayoutPiece::Tower).Add(MakePiece(Polar(WallRadius, Angle), 0.0f, FVector(500.0f, 500.0f, 1200.0f)));
+        }
+    }
+
+    return Layout;
+}
@@ -0,0 +1,64 @@
+#include "WorldForgeMaterialCache.h"
+#include "WorldForgeSettlementActor.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+UMaterialInterface* UWorldForgeMaterialCache::GetLandmarkMaterial(UMaterialInterface* BaseMaterial, EWorldForgeLandmarkType Type, const FString& EraId)
+{
+    if (SharedLandmarkMaterial)
+    {
+        return SharedLandmarkMaterial;
+    }
+
+    if (!BaseMaterial)
+    {
+        return nullptr;
+    }
+
+    FMaterialKey Key;
+    Key.BaseMaterial = BaseMaterial;
+    Key.Type = Type;
+    Key.EraId = EraId;
+
+    if (TObjectPtr<UMaterialInstanceDynamic>* Existing = Instances.Find(Key))
+    {
+        return *Existing;
+    }
+
+    UMaterialInstanceDynamic* DynMaterial = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+    if (!DynMaterial)
+    {
+        return BaseMaterial;
+    }
+
+    // Try common parameter names for base color
+    const FLinearColor TypeColor = AWorldForgeSettlementActor::GetColorForType(Type);
+    DynMaterial->SetVectorParameterValue(TEXT("BaseColor"), TypeColor);
+    DynMaterial->SetVectorParameterValue(TEXT("Base Color"), TypeColor);
+    DynMaterial->SetVectorParameterValue(TEXT("Color"), TypeColor);
+
+    Instances.Add(Key, DynMaterial);
+    InstanceRefs.Add(DynMaterial);
+
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Created shared material for type %d (era '%s'), %d cached"),
+           static_cast<int32>(Type), *EraId, Instances.Num());
+    return DynMaterial;
+}
+
+void UWorldForgeMaterialCache::Reset()
+{
+    Instances.Empty();
+    InstanceRefs.Empty();
+}
+
+SIZE_T UWorldForgeMaterialCache::GetMaterialMemoryBytes() const
+{
+    SIZE_T TotalBytes = 0;
+    for (const UMaterialInstanceDynamic* Instance : InstanceRefs)
+    {
+        if (Instance)
+        {
+            TotalBytes += Instance->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+        }
+    }
+    return TotalBytes;
+}
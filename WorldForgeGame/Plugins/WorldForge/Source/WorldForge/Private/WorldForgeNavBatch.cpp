@@ -0,0 +1,148 @@
+#include "WorldForgeNavBatch.h"
+#include "HAL/PlatformTime.h"
+
+void FWorldForgeNavBatch::SetTileSize(float InTileSize)
+{
+    InTileSize = FMath::Max(InTileSize, 100.0f);
+    if (InTileSize != TileSize)
+    {
+        TileSize = InTileSize;
+        Reset();
+    }
+}
+
+void FWorldForgeNavBatch::AddArea(const FBox& Bounds)
+{
+    if (!Bounds.IsValid)
+    {
+        return;
+    }
+
+    const int32 MinX = FMath::FloorToInt32(Bounds.Min.X / TileSize);
+    const int32 MinY = FMath::FloorToInt32(Bounds.Min.Y / TileSize);
+    const int32 MaxX = FMath::FloorToInt32(Bounds.Max.X / TileSize);
+    const int32 MaxY = FMath::FloorToInt32(Bounds.Max.Y / TileSize);
+    for (int32 Y = MinY; Y <= MaxY; ++Y)
+    {
+        for (int32 X = MinX; X <= MaxX; ++X)
+        {
+            DirtyTiles.Add(FIntPoint(X, Y));
+        }
+    }
+
+    MinZ = FMath::Min(MinZ, static_cast<float>(Bounds.Min.Z));
+    MaxZ = FMath::Max(MaxZ, static_cast<float>(Bounds.Max.Z));
+    LastAddTime = FPlatformTime::Seconds();
+    PendingUnbatchedTiles += (MaxX - MinX + 1) * (MaxY - MinY + 1);
+    ++Stats.PendingAreas;
+    ++Stats.TotalAreas;
+}
+
+void FWorldForgeNavBatch::Flush(TArray<FBox>& OutBoxes)
+{
+    OutBoxes.Reset();
+    if (DirtyTiles.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<FIntPoint> Tiles = DirtyTiles.Array();
+    Tiles.Sort([](const FIntPoint& A, const FIntPoint& B)
+    {
+        return A.Y != B.Y ? A.Y < B.Y : A.X < B.X;
+    });
+
+    // Runs of consecutive tiles per row; a run still open from the previous row with the same columns
+    // grows downward instead of starting a new box
+    struct FRun
+    {
+        int32 X0;
+        int32 X1;
+        int32 Y0;
+        int32 Y1;
+    };
+    TArray<FRun> Closed;
+    TMap<FIntPoint, FRun> Open;
+    TMap<FIntPoint, FRun> NextOpen;
+
+    auto CloseRow = [&]()
+    {
+        for (auto& Pair : Open)
+        {
+            Closed.Add(Pair.Value);
+        }
+        Open = MoveTemp(NextOpen);
+        NextOpen.Reset();
+    };
+
+    int32 Index = 0;
+    int32 Row = Tiles[0].Y;
+    while (Index < Tiles.Num())
+    {
+        if (Tiles[Index].Y != Row)
+        {
+            // A gap of a row closes every open run
+            CloseRow();
+            if (Tiles[Index].Y != Row + 1)
+            {
+                CloseRow();
+            }
+            Row = Tiles[Index].Y;
+        }
+
+        const int32 X0 = Tiles[Index].X;
+        int32 X1 = X0;
+        while (Index + 1 < Tiles.Num() && Tiles[Index + 1].Y == Row && Tiles[Index + 1].X == X1 + 1)
+        {
+            ++Index;
+            ++X1;
+        }
+        ++Index;
+
+        FRun Run;
+        if (Open.RemoveAndCopyValue(FIntPoint(X0, X1), Run))
+        {
+            Run.Y1 = Row;
+        }
+        else
+        {
+            Run = { X0, X1, Row, Row };
+        }
+        NextOpen.Add(FIntPoint(X0, X1), Run);
+    }
+    CloseRow();
+    CloseRow();
+
+    OutBoxes.Reserve(Closed.Num());
+    for (const FRun& Run : Closed)
+    {
+        OutBoxes.Add(FBox(
+            FVector(Run.X0 * TileSize, Run.Y0 * TileSize, MinZ),
+            FVector((Run.X1 + 1) * TileSize, (Run.Y1 + 1) * TileSize, MaxZ)));
+    }
+
+    Stats.LastAreas = Stats.PendingAreas;
+    Stats.LastTiles = DirtyTiles.Num();
+    Stats.LastBoxes = OutBoxes.Num();
+    Stats.LastUnbatchedTiles = PendingUnbatchedTiles;
+    ++Stats.Flushes;
+
+    Reset();
+}
+
+void FWorldForgeNavBatch::Reset()
+{
+    DirtyTiles.Reset();
+    MinZ = TNumericLimits<float>::Max();
+    MaxZ = TNumericLimits<float>::Lowest();
+    Stats.PendingAreas = 0;
+    PendingUnbatchedTiles = 0;
+}
+
+void FWorldForgeNavBatch::RecordRebuild(double DeferredSeconds, double RebuildSeconds)
+{
+    ++Stats.RebuildsCompleted;
+    Stats.LastDeferredSeconds = DeferredSeconds;
+    Stats.LastRebuildSeconds = RebuildSeconds;
+    Stats.MaxRebuildSeconds = FMath::Max(Stats.MaxRebuildSeconds, RebuildSeconds);
+}
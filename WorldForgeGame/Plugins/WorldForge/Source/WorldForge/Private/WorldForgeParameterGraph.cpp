@@ -0,0 +1,205 @@
+#include "WorldForgeParameterGraph.h"
+#include "WorldForgeTerritory.h"
+#include "WorldForgeRoads.h"
+#include "WorldForgeScatter.h"
+#include "WorldForgeEconomy.h"
+
+FWorldForgeParameterGraph::FWorldForgeParameterGraph()
+{
+    static const TCHAR* InputNames[] = {
+        TEXT("Militarism"), TEXT("Prosperity"), TEXT("Religiosity"), TEXT("Lawfulness"), TEXT("Openness"),
+        TEXT("Atmosphere"), TEXT("Seed"), TEXT("Era")
+    };
+    static_assert(UE_ARRAY_COUNT(InputNames) == static_cast<int32>(EWorldForgeParameterInput::Count), "Input names out of date");
+
+    // Inputs occupy the first node IDs and hold no value; rules read them through GetState
+    Nodes.SetNum(static_cast<int32>(EWorldForgeParameterInput::Count));
+    for (int32 Input = 0; Input < Nodes.Num(); ++Input)
+    {
+        Nodes[Input].Name = InputNames[Input];
+    }
+}
+
+FWorldForgeParameterGraph::FNodeId FWorldForgeParameterGraph::AddNode(FName Name, TConstArrayView<FNodeId> Dependencies, TUniquePtr<FValue> InitialValue,
+                                                                      TFunction<TUniquePtr<FValue>(const FWorldForgeParameterGraph&)> Compute)
+{
+    const FNodeId Id = Nodes.Num();
+    for (FNodeId Dependency : Dependencies)
+    {
+        checkf(Nodes.IsValidIndex(Dependency), TEXT("Parameter rule '%s' depends on an undeclared node"), *Name.ToString());
+        Nodes[Dependency].Dependents.AddUnique(Id);
+    }
+
+    FNode& Node = Nodes.AddDefaulted_GetRef();
+    Node.Name = Name;
+    Node.Compute = MoveTemp(Compute);
+    Node.Value = MoveTemp(InitialValue);
+    Node.bDirty = true;
+    ++NumDirty;
+    return Id;
+}
+
+void FWorldForgeParameterGraph::AddConsumer(FNodeId Node, FName Name, TFunction<void()> Callback)
+{
+    check(Nodes.IsValidIndex(Node));
+    Nodes[Node].Consumers.Add({ Name, MoveTemp(Callback) });
+    ++NumConsumers;
+}
+
+void FWorldForgeParameterGraph::SetState(const FWorldForgeState& InState)
+{
+    for (int32 Trait = 0; Trait < 5; ++Trait)
+    {
+        const EWorldForgeTrait TraitEnum = static_cast<EWorldForgeTrait>(Trait);
+        if (InState.GetTrait(TraitEnum) != State.GetTrait(TraitEnum))
+        {
+            State.SetTrait(TraitEnum, InState.GetTrait(TraitEnum));
+            NotifyChanged(GetTraitNode(TraitEnum));
+        }
+    }
+
+    if (InState.Atmosphere != State.Atmosphere)
+    {
+        State.Atmosphere = InState.Atmosphere;
+        NotifyChanged(GetInputNode(EWorldForgeParameterInput::Atmosphere));
+    }
+
+    if (InState.Seed != State.Seed)
+    {
+        State.Seed = InState.Seed;
+        NotifyChanged(GetInputNode(EWorldForgeParameterInput::Seed));
+    }
+
+    if (InState.Era.Id != State.Era.Id)
+    {
+        State.Era = InState.Era;
+        NotifyChanged(GetInputNode(EWorldForgeParameterInput::Era));
+    }
+}
+
+int32 FWorldForgeParameterGraph::Evaluate(int32 MaxRules)
+{
+    // Node IDs are in dependency order, so one ascending pass sees every rule after the rules it reads
+    int32 NumEvaluated = 0;
+    for (FNodeId Id = 0; Id < Nodes.Num() && NumDirty > 0 && NumEvaluated < MaxRules; ++Id)
+    {
+        FNode& Node = Nodes[Id];
+        if (!Node.bDirty)
+        {
+            continue;
+        }
+
+        Node.bDirty = false;
+        --NumDirty;
+        ++NumEvaluated;
+        ++Evaluations;
+
+        TUniquePtr<FValue> NewValue = Node.Compute(*this);
+        if (NewValue->Equals(*Node.Value))
+        {
+            ++UnchangedEvaluations;
+            continue;
+        }
+
+        Node.Value = MoveTemp(NewValue);
+        NotifyChanged(Id);
+
+        for (const FConsumer& Consumer : Nodes[Id].Consumers)
+        {
+            Consumer.Callback();
+            ++ConsumerNotifications;
+        }
+    }
+    return NumEvaluated;
+}
+
+void FWorldForgeParameterGraph::NotifyChanged(FNodeId Node)
+{
+    ++Nodes[Node].Version;
+    for (FNodeId Dependent : Nodes[Node].Dependents)
+    {
+        if (!Nodes[Dependent].bDirty)
+        {
+            Nodes[Dependent].bDirty = true;
+            ++NumDirty;
+        }
+    }
+}
+
+FWorldForgeParameterGraph::FStats FWorldForgeParameterGraph::GetStats() const
+{
+    FStats Stats;
+    Stats.NumRules = Nodes.Num() - static_cast<int32>(EWorldForgeParameterInput::Count);
+    Stats.NumConsumers = NumConsumers;
+    Stats.PendingRules = NumDirty;
+    Stats.Evaluations = Evaluations;
+    Stats.UnchangedEvaluations = UnchangedEvaluations;
+    Stats.ConsumerNotifications = ConsumerNotifications;
+    return Stats;
+}
+
+FWorldForgeParameterRules FWorldForgeParameterRules::AddDefaultRules(FWorldForgeParameterGraph& Graph)
+{
+    using FNodeId = FWorldForgeParameterGraph::FNodeId;
+    FWorldForgeParameterRules Rules;
+
+    // Fortress reach and frontier sharpness follow militarism, trading settlements' reach follows openness
+    const FNodeId TerritoryInputs[] = {
+        FWorldForgeParameterGraph::GetTraitNode(EWorldForgeTrait::Militarism),
+        FWorldForgeParameterGraph::GetTraitNode(EWorldForgeTrait::Openness)
+    };
+    Rules.Territory = Graph.AddRule<FWorldForgeTerritorySettings>(TEXT("Territory"), TerritoryInputs,
+        [](const FWorldForgeParameterGraph& G) { return FWorldForgeTerritorySettings::FromState(G.GetState()); });
+
+    // Road redundancy follows openness, bridges and width follow prosperity
+    const FNodeId RoadInputs[] = {
+        FWorldForgeParameterGraph::GetTraitNode(EWorldForgeTrait::Prosperity),
+        FWorldForgeParameterGraph::GetTraitNode(EWorldForgeTrait::Openness)
+    };
+    Rules.Roads = Graph.AddRule<FWorldForgeRoadSettings>(TEXT("Roads"), RoadInputs,
+        [](const FWorldForgeParameterGraph& G) { return FWorldForgeRoadSettings::FromState(G.GetState()); });
+
+    // Each scatter layer reads only the traits its density rule weights, plus the atmosphere and seed
+    for (int32 Layer = 0; Layer < FWorldForgeScatter::NumLayers; ++Layer)
+    {
+        const EWorldForgeScatterLayer LayerEnum = static_cast<EWorldForgeScatterLayer>(Layer);
+        const FWorldForgeScatterRule& Rule = FWorldForgeScatter::GetRule(LayerEnum);
+
+        TArray<FNodeId, TInlineAllocator<8>> Inputs;
+        for (int32 Trait = 0; Trait < UE_ARRAY_COUNT(Rule.TraitWeights); ++Trait)
+        {
+            if (Rule.TraitWeights[Trait] != 0.0f)
+            {
+                Inputs.Add(FWorldForgeParameterGraph::GetTraitNode(static_cast<EWorldForgeTrait>(Trait)));
+            }
+        }
+        Inputs.Add(FWorldForgeParameterGraph::GetInputNode(EWorldForgeParameterInput::Atmosphere));
+        Inputs.Add(FWorldForgeParameterGraph::GetInputNode(EWorldForgeParameterInput::Seed));
+
+        Rules.ScatterLayers.Add(Graph.AddRule<FWorldForgeScatterLayerParams>(*FString::Printf(TEXT("Scatter.Layer%d"), Layer), Inputs,
+            [LayerEnum](const FWorldForgeParameterGraph& G) { return FWorldForgeScatter::MakeLayer(G.GetState(), LayerEnum); }));
+    }
+
+    Rules.Scatter = Graph.AddRule<TArray<FWorldForgeScatterLayerParams>>(TEXT("Scatter"), Rules.ScatterLayers,
+        [LayerNodes = Rules.ScatterLayers](const FWorldForgeParameterGraph& G)
+        {
+            TArray<FWorldForgeScatterLayerParams> Layers;
+            for (FNodeId Node : LayerNodes)
+            {
+                Layers.Add(G.Get<FWorldForgeScatterLayerParams>(Node));
+            }
+            return Layers;
+        });
+
+    // Production and growth follow prosperity, trade volume openness, losses on the road lawfulness
+    const FNodeId EconomyInputs[] = {
+        FWorldForgeParameterGraph::GetTraitNode(EWorldForgeTrait::Prosperity),
+        FWorldForgeParameterGraph::GetTraitNode(EWorldForgeTrait::Openness),
+        FWorldForgeParameterGraph::GetTraitNode(EWorldForgeTrait::Lawfulness),
+        FWorldForgeParameterGraph::GetInputNode(EWorldForgeParameterInput::Seed)
+    };
+    Rules.Economy = Graph.AddRule<FWorldForgeEconomySettings>(TEXT("Economy"), EconomyInputs,
+        [](const FWorldForgeParameterGraph& G) { return FWorldForgeEconomySettings::FromState(G.GetState()); });
+
+    return Rules;
+}
@@ -0,0 +1,350 @@
+#include "WorldForgePaths.h"
+#include "WorldForgeRoads.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "Algo/Reverse.h"
+
+FWorldForgePathGraph::FWorldForgePathGraph(const FWorldForgeRoadNetwork& Network)
+{
+    auto GetNode = [this](const FString& Id)
+    {
+        if (const int32* Existing = NodeIndex.Find(Id))
+        {
+            return *Existing;
+        }
+        const int32 Index = Ids.Add(Id);
+        NodeIndex.Add(Id, Index);
+        return Index;
+    };
+
+    TArray<int32> RoadTo;
+    Network.ForEachRoutedRoad([&](const FString& Key, const FWorldForgeRoad& Road)
+    {
+        if (Road.Points.Num() < 2)
+        {
+            return;
+        }
+
+        FRoad& Entry = Roads.AddDefaulted_GetRef();
+        Entry.Key = Key;
+        Entry.From = GetNode(Road.FromId);
+        Entry.Points = Road.Points;
+        Entry.Cost = Road.Cost;
+        for (int32 Index = 1; Index < Road.Points.Num(); ++Index)
+        {
+            Entry.Length += FVector::Dist(Road.Points[Index - 1], Road.Points[Index]);
+        }
+        RoadTo.Add(GetNode(Road.ToId));
+    });
+
+    // Roads are two-way: one edge in each direction, bucketed by node
+    Offsets.SetNumZeroed(Ids.Num() + 1);
+    for (int32 Road = 0; Road < Roads.Num(); ++Road)
+    {
+        ++Offsets[Roads[Road].From + 1];
+        ++Offsets[RoadTo[Road] + 1];
+    }
+    for (int32 Node = 0; Node < Ids.Num(); ++Node)
+    {
+        Offsets[Node + 1] += Offsets[Node];
+    }
+
+    Edges.SetNum(Roads.Num() * 2);
+    TArray<int32> Cursor(Offsets.GetData(), Ids.Num());
+    for (int32 Road = 0; Road < Roads.Num(); ++Road)
+    {
+        Edges[Cursor[Roads[Road].From]++] = { RoadTo[Road], Road };
+        Edges[Cursor[RoadTo[Road]]++] = { Roads[Road].From, Road };
+    }
+}
+
+void FWorldForgePathGraph::Solve(const FString& FromId, TConstArrayView<FString> ToIds, TArray<FWorldForgePath>& OutPaths) const
+{
+    OutPaths.Reset();
+    OutPaths.SetNum(ToIds.Num());
+    for (int32 Index = 0; Index < ToIds.Num(); ++Index)
+    {
+        OutPaths[Index].FromId = FromId;
+        OutPaths[Index].ToId = ToIds[Index];
+    }
+
+    const int32* Source = NodeIndex.Find(FromId);
+    if (!Source)
+    {
+        return;
+    }
+
+    TArray<int32> Targets;
+    Targets.Init(INDEX_NONE, ToIds.Num());
+    TSet<int32> Unsettled;
+    for (int32 Index = 0; Index < ToIds.Num(); ++Index)
+    {
+        if (const int32* Target = NodeIndex.Find(ToIds[Index]))
+        {
+            Targets[Index] = *Target;
+            Unsettled.Add(*Target);
+        }
+    }
+
+    const int32 NumNodes = Ids.Num();
+    TArray<float> Distance;
+    Distance.Init(TNumericLimits<float>::Max(), NumNodes);
+    TArray<int32> PrevNode;
+    PrevNode.Init(INDEX_NONE, NumNodes);
+    TArray<int32> PrevRoad;
+    PrevRoad.Init(INDEX_NONE, NumNodes);
+    TArray<bool> Settled;
+    Settled.Init(false, NumNodes);
+
+    struct FOpen
+    {
+        float Distance;
+        int32 Node;
+        bool operator<(const FOpen& Other) const { return Distance < Other.Distance; }
+    };
+    TArray<FOpen> Heap;
+    Distance[*Source] = 0.0f;
+    Heap.HeapPush({ 0.0f, *Source });
+
+    while (Heap.Num() > 0 && Unsettled.Num() > 0)
+    {
+        FOpen Open;
+        Heap.HeapPop(Open, EAllowShrinking::No);
+        if (Settled[Open.Node])
+        {
+            continue;
+        }
+        Settled[Open.Node] = true;
+        Unsettled.Remove(Open.Node);
+
+        for (int32 Edge = Offsets[Open.Node]; Edge < Offsets[Open.Node + 1]; ++Edge)
+        {
+            const FEdge& Next = Edges[Edge];
+            const float Candidate = Open.Distance + Roads[Next.Road].Cost;
+            if (Candidate < Distance[Next.To])
+            {
+                Distance[Next.To] = Candidate;
+                PrevNode[Next.To] = Open.Node;
+                PrevRoad[Next.To] = Next.Road;
+                Heap.HeapPush({ Candidate, Next.To });
+            }
+        }
+    }
+
+    TArray<int32> Nodes;
+    for (int32 Index = 0; Index < ToIds.Num(); ++Index)
+    {
+        const int32 Target = Targets[Index];
+        if (Target == INDEX_NONE || !Settled[Target])
+        {
+            continue;
+        }
+
+        Nodes.Reset();
+        for (int32 Node = Target; Node != INDEX_NONE; Node = PrevNode[Node])
+        {
+            Nodes.Add(Node);
+        }
+        Algo::Reverse(Nodes);
+
+        FWorldForgePath& Path = OutPaths[Index];
+        Path.Cost = Distance[Target];
+        Path.Landmarks.Reserve(Nodes.Num());
+        Path.Landmarks.Add(Ids[Nodes[0]]);
+        for (int32 Step = 1; Step < Nodes.Num(); ++Step)
+        {
+            const FRoad& Road = Roads[PrevRoad[Nodes[Step]]];
+            Path.Landmarks.Add(Ids[Nodes[Step]]);
+            Path.RoadKeys.Add(Road.Key);
+            Path.Length += Road.Length;
+
+            // Roads are stored from their FromId; travelled the other way, the polyline is walked backwards.
+            // The joint shared with the previous road is added once.
+            const bool bForward = Road.From == Nodes[Step - 1];
+            const int32 First = Path.Points.Num() > 0 ? 1 : 0;
+            for (int32 Point = First; Point < Road.Points.Num(); ++Point)
+            {
+                Path.Points.Add(Road.Points[bForward ? Point : Road.Points.Num() - 1 - Point]);
+            }
+        }
+    }
+}
+
+FWorldForgePathBatch::FWorldForgePathBatch(TArray<FWorldForgePathQuery>&& InQueries, TSharedPtr<const FWorldForgePathGraph, ESPMode::ThreadSafe> InGraph, uint32 InGraphVersion)
+    : Queries(MoveTemp(InQueries))
+    , Graph(MoveTemp(InGraph))
+    , GraphVersion(InGraphVersion)
+    , StartTime(FPlatformTime::Seconds())
+{
+    Results.SetNum(Queries.Num());
+}
+
+void FWorldForgePathBatch::Run()
+{
+    const double RunStart = FPlatformTime::Seconds();
+
+    // One search per distinct source answers all of its targets
+    TMap<FString, TArray<int32>> BySource;
+    for (const int32 Query : Misses)
+    {
+        BySource.FindOrAdd(Queries[Query].FromId).Add(Query);
+    }
+    TArray<TPair<FString, TArray<int32>>> Groups = BySource.Array();
+
+    ParallelFor(Groups.Num(), [this, &Groups](int32 GroupIndex)
+    {
+        const TPair<FString, TArray<int32>>& Group = Groups[GroupIndex];
+        TArray<FString> ToIds;
+        ToIds.Reserve(Group.Value.Num());
+        for (const int32 Query : Group.Value)
+        {
+            ToIds.Add(Queries[Query].ToId);
+        }
+
+        TArray<FWorldForgePath> Paths;
+        Graph->Solve(Group.Key, ToIds, Paths);
+
+        // Each query index belongs to exactly one group, so groups write disjoint results
+        for (int32 Index = 0; Index < Group.Value.Num(); ++Index)
+        {
+            Results[Group.Value[Index]] = MakeShared<const FWorldForgePath, ESPMode::ThreadSafe>(MoveTemp(Paths[Index]));
+        }
+    });
+
+    SolveSeconds = FPlatformTime::Seconds() - RunStart;
+    bSolved = true;
+}
+
+TSharedRef<FWorldForgePathBatch, ESPMode::ThreadSafe> FWorldForgePathService::BeginBatch(TArray<FWorldForgePathQuery>&& Queries, const FWorldForgeRoadNetwork& Network)
+{
+    if (!Graph.IsValid() || SnapshotVersion != GraphVersion)
+    {
+        Graph = MakeShared<const FWorldForgePathGraph, ESPMode::ThreadSafe>(Network);
+        SnapshotVersion = GraphVersion;
+        ++Stats.GraphBuilds;
+    }
+
+    TSharedRef<FWorldForgePathBatch, ESPMode::ThreadSafe> Batch = MakeShared<FWorldForgePathBatch, ESPMode::ThreadSafe>(MoveTemp(Queries), Graph, GraphVersion);
+
+    ++UseCounter;
+    for (int32 Index = 0; Index < Batch->Queries.Num(); ++Index)
+    {
+        const FWorldForgePathQuery& Query = Batch->Queries[Index];
+        if (FEntry* Entry = Cache.Find(MakeKey(Query.FromId, Query.ToId)))
+        {
+            Entry->LastUsed = UseCounter;
+            Batch->Results[Index] = Entry->Path;
+            ++Stats.CacheHits;
+        }
+        else
+        {
+            Batch->Misses.Add(Index);
+        }
+    }
+
+    Stats.Queries += Batch->Queries.Num();
+    ++Stats.Batches;
+    return Batch;
+}
+
+void FWorldForgePathService::CommitBatch(FWorldForgePathBatch& Batch)
+{
+    Stats.LastBatchMs = (FPlatformTime::Seconds() - Batch.StartTime) * 1000.0;
+    Stats.LastBatchQueries = Batch.Queries.Num();
+    if (Batch.Misses.Num() == 0)
+    {
+        return;
+    }
+
+    Stats.Solved += Batch.Misses.Num();
+    Stats.SolveSeconds += Batch.SolveSeconds;
+    for (const int32 Query : Batch.Misses)
+    {
+        Stats.NotFound += Batch.Results[Query]->IsFound() ? 0 : 1;
+    }
+
+    if (Batch.GraphVersion != GraphVersion)
+    {
+        return;
+    }
+
+    for (const int32 Query : Batch.Misses)
+    {
+        const FWorldForgePathQuery& Entry = Batch.Queries[Query];
+        Cache.Add(MakeKey(Entry.FromId, Entry.ToId), { Batch.Results[Query], UseCounter });
+    }
+
+    if (Cache.Num() > Capacity)
+    {
+        Evict();
+    }
+}
+
+void FWorldForgePathService::OnRoadAdded()
+{
+    ++GraphVersion;
+    Stats.Invalidated += Cache.Num();
+    Cache.Reset();
+}
+
+void FWorldForgePathService::InvalidateRoad(const FString& RoadKey)
+{
+    ++GraphVersion;
+    RemoveWhere([&RoadKey](const FWorldForgePath& Path) { return Path.RoadKeys.Contains(RoadKey); });
+}
+
+void FWorldForgePathService::InvalidateLandmark(const FString& LandmarkId)
+{
+    ++GraphVersion;
+    RemoveWhere([&LandmarkId](const FWorldForgePath& Path)
+    {
+        return Path.FromId == LandmarkId || Path.ToId == LandmarkId || Path.Landmarks.Contains(LandmarkId);
+    });
+}
+
+void FWorldForgePathService::Clear()
+{
+    ++GraphVersion;
+    Cache.Reset();
+    Graph.Reset();
+}
+
+FString FWorldForgePathService::MakeKey(const FString& FromId, const FString& ToId)
+{
+    return FromId + TEXT(">") + ToId;
+}
+
+void FWorldForgePathService::RemoveWhere(TFunctionRef<bool(const FWorldForgePath&)> Predicate)
+{
+    for (auto It = Cache.CreateIterator(); It; ++It)
+    {
+        if (Predicate(*It.Value().Path))
+        {
+            It.RemoveCurrent();
+            ++Stats.Invalidated;
+        }
+    }
+}
+
+void FWorldForgePathService::Evict()
+{
+    TArray<uint64> Uses;
+    Uses.Reserve(Cache.Num());
+    for (const TPair<FString, FEntry>& Pair : Cache)
+    {
+        Uses.Add(Pair.Value.LastUsed);
+    }
+    Uses.Sort();
+
+    // Evicting in bulk keeps the sort off every insert; entries tied at the cutoff go too
+    const uint64 Cutoff = Uses[FMath::Min(Uses.Num() - 1, Uses.Num() / 4)];
+    const int32 Before = Cache.Num();
+    for (auto It = Cache.CreateIterator(); It; ++It)
+    {
+        if (It.Value().LastUsed <= Cutoff)
+        {
+            It.RemoveCurrent();
+        }
+    }
+    Stats.Evicted += Before - Cache.Num();
+}
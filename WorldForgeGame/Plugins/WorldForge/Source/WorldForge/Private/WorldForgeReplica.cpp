@@ -0,0 +1,315 @@
+#include "WorldForgeReplica.h"
+#include "Misc/DateTime.h"
+
+FWorldForgeHlc FWorldForgeHybridClock::Tick(int64 PhysicalMs)
+{
+    if (PhysicalMs > Last.Wall)
+    {
+        Last.Wall = PhysicalMs;
+        Last.Counter = 0;
+    }
+    else
+    {
+        ++Last.Counter;
+    }
+    Last.Node = Node;
+    return Last;
+}
+
+void FWorldForgeHybridClock::Observe(const FWorldForgeHlc& Remote, int64 PhysicalMs)
+{
+    const int64 Wall = FMath::Max3(Last.Wall, Remote.Wall, PhysicalMs);
+    if (Wall == Last.Wall && Wall == Remote.Wall)
+    {
+        Last.Counter = FMath::Max(Last.Counter, Remote.Counter) + 1;
+    }
+    else if (Wall == Last.Wall)
+    {
+        ++Last.Counter;
+    }
+    else if (Wall == Remote.Wall)
+    {
+        Last.Counter = Remote.Counter + 1;
+    }
+    else
+    {
+        Last.Counter = 0;
+    }
+    Last.Wall = Wall;
+    Last.Node = Node;
+}
+
+int64 FWorldForgeHybridClock::GetPhysicalMs()
+{
+    return (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() / ETimespan::TicksPerMillisecond;
+}
+
+FWorldForgeReplicaOp FWorldForgeReplica::MakeEra(const FWorldForgeEra& Era, const FWorldForgeHlc& Stamp)
+{
+    FWorldForgeReplicaOp Op;
+    Op.Kind = EWorldForgeReplicaOpKind::Era;
+    Op.Stamp = Stamp;
+    Op.Era = Era;
+    return Op;
+}
+
+FWorldForgeReplicaOp FWorldForgeReplica::MakeSeed(int32 Seed, const FWorldForgeHlc& Stamp)
+{
+    FWorldForgeReplicaOp Op;
+    Op.Kind = EWorldForgeReplicaOpKind::Seed;
+    Op.Stamp = Stamp;
+    Op.Seed = Seed;
+    return Op;
+}
+
+FWorldForgeReplicaOp FWorldForgeReplica::MakeTrait(EWorldForgeTrait Trait, float Value, const FWorldForgeHlc& Stamp)
+{
+    FWorldForgeReplicaOp Op;
+    Op.Kind = EWorldForgeReplicaOpKind::Trait;
+    Op.Stamp = Stamp;
+    Op.Trait = Trait;
+    Op.Value = FMath::Clamp(Value, 0.0f, 1.0f);
+    return Op;
+}
+
+FWorldForgeReplicaOp FWorldForgeReplica::MakeAtmosphere(EWorldForgeAtmosphere Atmosphere, const FWorldForgeHlc& Stamp)
+{
+    FWorldForgeReplicaOp Op;
+    Op.Kind = EWorldForgeReplicaOpKind::Atmosphere;
+    Op.Stamp = Stamp;
+    Op.Atmosphere = Atmosphere;
+    return Op;
+}
+
+FWorldForgeReplicaOp FWorldForgeReplica::MakeAdd(const FWorldForgeLandmark& Landmark, const FWorldForgeHlc& Stamp)
+{
+    FWorldForgeReplicaOp Op;
+    Op.Kind = EWorldForgeReplicaOpKind::AddLandmark;
+    Op.Stamp = Stamp;
+    Op.Landmark = Landmark;
+    return Op;
+}
+
+FWorldForgeReplicaOp FWorldForgeReplica::MakeRemove(const FString& LandmarkId, const FWorldForgeHlc& Stamp) const
+{
+    FWorldForgeReplicaOp Op;
+    Op.Kind = EWorldForgeReplicaOpKind::RemoveLandmark;
+    Op.Stamp = Stamp;
+    Op.Landmark.Id = LandmarkId;
+    if (const FLandmarkEntry* Entry = Landmarks.Find(LandmarkId))
+    {
+        // An add stamped later than the remove cannot have been seen by its author
+        for (const FWorldForgeHlc& Tag : Entry->Tags)
+        {
+            if (Tag <= Stamp)
+            {
+                Op.Tags.Add(Tag);
+            }
+        }
+    }
+    return Op;
+}
+
+bool FWorldForgeReplica::Merge(const FWorldForgeReplicaOp& Op)
+{
+    bool bChanged = false;
+    switch (Op.Kind)
+    {
+    case EWorldForgeReplicaOpKind::Era:
+        bChanged = Era.Merge(Op.Era, Op.Stamp);
+        break;
+    case EWorldForgeReplicaOpKind::Seed:
+        bChanged = Seed.Merge(Op.Seed, Op.Stamp);
+        break;
+    case EWorldForgeReplicaOpKind::Trait:
+        bChanged = Traits[static_cast<int32>(Op.Trait)].Merge(Op.Value, Op.Stamp);
+        break;
+    case EWorldForgeReplicaOpKind::Atmosphere:
+        bChanged = Atmosphere.Merge(Op.Atmosphere, Op.Stamp);
+        break;
+    case EWorldForgeReplicaOpKind::AddLandmark:
+        bChanged = MergeAdd(Op);
+        break;
+    case EWorldForgeReplicaOpKind::RemoveLandmark:
+        bChanged = MergeRemove(Op);
+        break;
+    }
+
+    ++(bChanged ? Stats.Merged : Stats.Stale);
+    return bChanged;
+}
+
+bool FWorldForgeReplica::MergeAdd(const FWorldForgeReplicaOp& Op)
+{
+    FLandmarkEntry& Entry = Landmarks.FindOrAdd(Op.Landmark.Id);
+    bool bChanged = Entry.Data.Merge(Op.Landmark, Op.Stamp);
+
+    // A tag removed before its add arrived stays removed
+    if (!Entry.Tombstones.Contains(Op.Stamp) && !Entry.Tags.Contains(Op.Stamp))
+    {
+        Entry.Tags.Add(Op.Stamp);
+        bChanged = true;
+    }
+    return bChanged;
+}
+
+bool FWorldForgeReplica::MergeRemove(const FWorldForgeReplicaOp& Op)
+{
+    // Kept even for a landmark not seen yet, so its add is removed on arrival
+    FLandmarkEntry& Entry = Landmarks.FindOrAdd(Op.Landmark.Id);
+    bool bChanged = false;
+    for (const FWorldForgeHlc& Tag : Op.Tags)
+    {
+        if (!Entry.Tombstones.Contains(Tag))
+        {
+            Entry.Tombstones.Add(Tag);
+            Entry.Tags.Remove(Tag);
+            ++Stats.Tombstones;
+            bChanged = true;
+        }
+    }
+    return bChanged;
+}
+
+void FWorldForgeReplica::Reset(const FWorldForgeState& State, const FWorldForgeHlc& Stamp)
+{
+    Era = { State.Era, Stamp };
+    Seed = { State.Seed, Stamp };
+    for (int32 Trait = 0; Trait < UE_ARRAY_COUNT(Traits); ++Trait)
+    {
+        Traits[Trait] = { State.GetTrait(static_cast<EWorldForgeTrait>(Trait)), Stamp };
+    }
+    Atmosphere = { State.Atmosphere, Stamp };
+
+    Landmarks.Reset();
+    Stats.Tombstones = 0;
+    for (const FWorldForgeLandmark& Landmark : State.Landmarks)
+    {
+        MergeAdd(MakeAdd(Landmark, Stamp));
+    }
+}
+
+bool FWorldForgeReplica::ContainsLandmark(const FString& LandmarkId) const
+{
+    const FLandmarkEntry* Entry = Landmarks.Find(LandmarkId);
+    return Entry && Entry->IsPresent();
+}
+
+const FWorldForgeLandmark* FWorldForgeReplica::FindLandmark(const FString& LandmarkId) const
+{
+    const FLandmarkEntry* Entry = Landmarks.Find(LandmarkId);
+    return Entry && Entry->IsPresent() ? &Entry->Data.Value : nullptr;
+}
+
+int32 FWorldForgeReplica::NumLandmarks() const
+{
+    int32 Num = 0;
+    for (const TPair<FString, FLandmarkEntry>& Pair : Landmarks)
+    {
+        Num += Pair.Value.IsPresent() ? 1 : 0;
+    }
+    return Num;
+}
+
+void FWorldForgeReplica::ForEachLandmark(TFunctionRef<void(const FWorldForgeLandmark&)> Visitor) const
+{
+    for (const TPair<FString, FLandmarkEntry>& Pair : Landmarks)
+    {
+        if (Pair.Value.IsPresent())
+        {
+            Visitor(Pair.Value.Data.Value);
+        }
+    }
+}
+
+void FWorldForgeReplica::ToState(FWorldForgeState& OutState) const
+{
+    OutState.Era = Era.Value;
+    OutState.Seed = Seed.Value;
+    for (int32 Trait = 0; Trait < UE_ARRAY_COUNT(Traits); ++Trait)
+    {
+        OutState.SetTrait(static_cast<EWorldForgeTrait>(Trait), Traits[Trait].Value);
+    }
+    OutState.Atmosphere = Atmosphere.Value;
+
+    OutState.Landmarks.Reset();
+    for (const TPair<FString, FLandmarkEntry>& Pair : Landmarks)
+    {
+        if (Pair.Value.IsPresent())
+        {
+            OutState.Landmarks.Add(Pair.Value.Data.Value);
+        }
+    }
+    OutState.Landmarks.Sort([](const FWorldForgeLandmark& A, const FWorldForgeLandmark& B) { return A.Id < B.Id; });
+}
+
+int32 FWorldForgeReplica::CollectTombstones(const FWorldForgeHlc& Stable)
+{
+    const int32 Dropped = DropTombstones(Stable);
+    Stats.Collected += Dropped;
+    return Dropped;
+}
+
+int32 FWorldForgeReplica::TrimTombstones(int32 MaxTombstones)
+{
+    if (Stats.Tombstones <= MaxTombstones)
+    {
+        return 0;
+    }
+
+    TArray<FWorldForgeHlc> Stamps;
+    Stamps.Reserve(Stats.Tombstones);
+    for (const TPair<FString, FLandmarkEntry>& Pair : Landmarks)
+    {
+        Stamps.Append(Pair.Value.Tombstones);
+    }
+    const int32 NumDropped = Stamps.Num() - FMath::Max(MaxTombstones, 0);
+    Stamps.Sort();
+
+    const int32 Dropped = DropTombstones(Stamps[NumDropped - 1]);
+    Stats.Evicted += Dropped;
+    return Dropped;
+}
+
+int32 FWorldForgeReplica::DropTombstones(const FWorldForgeHlc& Through)
+{
+    int32 Dropped = 0;
+    for (TMap<FString, FLandmarkEntry>::TIterator It = Landmarks.CreateIterator(); It; ++It)
+    {
+        FLandmarkEntry& Entry = It.Value();
+        Dropped += Entry.Tombstones.RemoveAllSwap([&Through](const FWorldForgeHlc& Tag) { return Tag <= Through; }, EAllowShrinking::No);
+
+        // A landmark removed everywhere leaves nothing to merge against
+        if (Entry.Tags.Num() == 0 && Entry.Tombstones.Num() == 0)
+        {
+            It.RemoveCurrent();
+        }
+    }
+    Stats.Tombstones -= Dropped;
+    return Dropped;
+}
+
+void FWorldForgeReplica::DiffScalars(const FWorldForgeState& State, TArray<FWorldForgeReplicaOp>& OutOps) const
+{
+    const FWorldForgeEra& Current = Era.Value;
+    if (State.Era.Id != Current.Id || State.Era.Name != Current.Name || State.Era.Period != Current.Period || State.Era.Description != Current.Description)
+    {
+        OutOps.Add(MakeEra(State.Era, FWorldForgeHlc()));
+    }
+    if (State.Seed != Seed.Value)
+    {
+        OutOps.Add(MakeSeed(State.Seed, FWorldForgeHlc()));
+    }
+    for (int32 Trait = 0; Trait < UE_ARRAY_COUNT(Traits); ++Trait)
+    {
+        const float Value = State.GetTrait(static_cast<EWorldForgeTrait>(Trait));
+        if (Value != Traits[Trait].Value)
+        {
+            OutOps.Add(MakeTrait(static_cast<EWorldForgeTrait>(Trait), Value, FWorldForgeHlc()));
+        }
+    }
+    if (State.Atmosphere != Atmosphere.Value)
+    {
+        OutOps.Add(MakeAtmosphere(State.Atmosphere, FWorldForgeHlc()));
+    }
+}
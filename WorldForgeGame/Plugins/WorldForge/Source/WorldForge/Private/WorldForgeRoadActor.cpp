@@ -0,0 +1,56 @@
+#include "WorldForgeRoadActor.h"
+#include "WorldForgeTerrainGenerator.h"
+#include "ProceduralMeshComponent.h"
+
+AWorldForgeRoadActor::AWorldForgeRoadActor()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    RoadMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("RoadMesh"));
+    SetRootComponent(RoadMesh);
+    RoadMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    RoadMesh->SetCastShadow(false);
+}
+
+void AWorldForgeRoadActor::SetRoad(const FString& Key, const FWorldForgeTerrainMeshData& MeshData)
+{
+    int32 Section = INDEX_NONE;
+    if (const int32* Existing = RoadSections.Find(Key))
+    {
+        Section = *Existing;
+    }
+    else
+    {
+        Section = FreeSections.Num() > 0 ? FreeSections.Pop(EAllowShrinking::No) : NextSection++;
+        RoadSections.Add(Key, Section);
+    }
+
+    RoadMesh->CreateMeshSection_LinearColor(Section, MeshData.Vertices, MeshData.Triangles, MeshData.Normals, MeshData.UVs,
+        TArray<FLinearColor>(), TArray<FProcMeshTangent>(), false);
+
+    if (RoadMaterial)
+    {
+        RoadMesh->SetMaterial(Section, RoadMaterial);
+    }
+}
+
+bool AWorldForgeRoadActor::RemoveRoad(const FString& Key)
+{
+    int32 Section = INDEX_NONE;
+    if (!RoadSections.RemoveAndCopyValue(Key, Section))
+    {
+        return false;
+    }
+
+    RoadMesh->ClearMeshSection(Section);
+    FreeSections.Add(Section);
+    return true;
+}
+
+void AWorldForgeRoadActor::ClearRoads()
+{
+    RoadMesh->ClearAllMeshSections();
+    RoadSections.Empty();
+    FreeSections.Empty();
+    NextSection = 0;
+}
@@ -0,0 +1,641 @@
+#include "WorldForgeRoads.h"
+#include "WorldForgeHeightCache.h"
+#include "WorldForgeHydrology.h"
+#include "Algo/Reverse.h"
+#include "Algo/Sort.h"
+
+namespace WorldForgeRoads
+{
+    /** Candidate neighbours per site considered for the relative neighborhood graph */
+    static constexpr int32 NearestCount = 12;
+
+    /** Roads sit just above the ground so they cover the terrain mesh */
+    static constexpr float SurfaceOffset = 15.0f;
+
+    /** Route points are kept where the path turns, and at least every this many cells */
+    static constexpr int32 MaxPointStride = 4;
+
+    static constexpr int32 OffsetX[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+    static constexpr int32 OffsetY[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+    static constexpr float StepLength[8] = { 1.0f, UE_SQRT_2, 1.0f, UE_SQRT_2, 1.0f, UE_SQRT_2, 1.0f, UE_SQRT_2 };
+
+    struct FOpenNode
+    {
+        float Cost;
+        int32 Index;
+
+        /** Min-heap order, ties broken by index so routes are deterministic */
+        struct FLower
+        {
+            bool operator()(const FOpenNode& A, const FOpenNode& B) const
+            {
+                return A.Cost < B.Cost || (A.Cost == B.Cost && A.Index < B.Index);
+            }
+        };
+    };
+
+    static int32 FindRoot(TArray<int32>& Parents, int32 Node)
+    {
+        while (Parents[Node] != Node)
+        {
+            Parents[Node] = Parents[Parents[Node]];
+            Node = Parents[Node];
+        }
+        return Node;
+    }
+
+    /** Shortest distance from From to To over the roads so far, or a value above Limit if it is longer */
+    static float BoundedDistance(const TArray<TArray<TPair<int32, float>>>& Adjacency, int32 From, int32 To, float Limit)
+    {
+        TMap<int32, float> Distances;
+        TArray<FOpenNode> Open;
+        Distances.Add(From, 0.0f);
+        Open.HeapPush({ 0.0f, From }, FOpenNode::FLower());
+
+        while (Open.Num() > 0)
+        {
+            FOpenNode Top;
+            Open.HeapPop(Top, FOpenNode::FLower(), EAllowShrinking::No);
+            if (Top.Index == To)
+            {
+                return Top.Cost;
+            }
+            if (Top.Cost > Limit)
+            {
+                break;
+            }
+            if (Top.Cost > Distances.FindChecked(Top.Index))
+            {
+                continue;
+            }
+
+            for (const TPair<int32, float>& Neighbor : Adjacency[Top.Index])
+            {
+                const float Cost = Top.Cost + Neighbor.Value;
+                float* Known = Distances.Find(Neighbor.Key);
+                if (Cost <= Limit && (!Known || Cost < *Known))
+                {
+                    Distances.Add(Neighbor.Key, Cost);
+                    Open.HeapPush({ Cost, Neighbor.Key }, FOpenNode::FLower());
+                }
+            }
+        }
+        return TNumericLimits<float>::Max();
+    }
+}
+
+FWorldForgeRoadSettings FWorldForgeRoadSettings::FromState(const FWorldForgeState& State)
+{
+    FWorldForgeRoadSettings Settings;
+    Settings.MaxDetour = FMath::Lerp(4.0f, 1.4f, State.Openness);
+    Settings.WaterCost = FMath::Lerp(20.0f, 4.0f, State.Prosperity);
+    Settings.Width = 200.0f + 300.0f * State.Prosperity;
+    return Settings;
+}
+
+bool FWorldForgeRoadSettings::operator==(const FWorldForgeRoadSettings& Other) const
+{
+    return MaxDetour == Other.MaxDetour
+        && MaxEdgeLength == Other.MaxEdgeLength
+        && CellSize == Other.CellSize
+        && MaxRouteCells == Other.MaxRouteCells
+        && SlopeCost == Other.SlopeCost
+        && WaterCost == Other.WaterCost
+        && Width == Other.Width;
+}
+
+bool FWorldForgeRoadPlanner::ConnectsType(EWorldForgeLandmarkType Type)
+{
+    return Type == EWorldForgeLandmarkType::Settlement
+        || Type == EWorldForgeLandmarkType::Fortress
+        || Type == EWorldForgeLandmarkType::Monastery;
+}
+
+void FWorldForgeRoadPlanner::BuildCandidateGraph(TConstArrayView<FVector2D> Sites, float MaxEdgeLength, TArray<FWorldForgeRoadEdge>& OutEdges)
+{
+    using namespace WorldForgeRoads;
+
+    OutEdges.Reset();
+    const int32 NumSites = Sites.Num();
+    if (NumSites < 2)
+    {
+        return;
+    }
+
+    // Bucket sites on a grid of MaxEdgeLength cells so neighbours come from the surrounding 3x3 cells
+    auto GetBucket = [MaxEdgeLength](const FVector2D& Location)
+    {
+        return FIntPoint(FMath::FloorToInt32(Location.X / MaxEdgeLength), FMath::FloorToInt32(Location.Y / MaxEdgeLength));
+    };
+    TMap<FIntPoint, TArray<int32>> Buckets;
+    for (int32 Site = 0; Site < NumSites; ++Site)
+    {
+        Buckets.FindOrAdd(GetBucket(Sites[Site])).Add(Site);
+    }
+
+    // Nearest sites within range, closest first
+    TArray<TArray<int32>> Nearest;
+    Nearest.SetNum(NumSites);
+    const double MaxLengthSquared = FMath::Square(static_cast<double>(MaxEdgeLength));
+    for (int32 Site = 0; Site < NumSites; ++Site)
+    {
+        TArray<TPair<double, int32>, TInlineAllocator<64>> InRange;
+        const FIntPoint Bucket = GetBucket(Sites[Site]);
+        for (int32 DY = -1; DY <= 1; ++DY)
+        {
+            for (int32 DX = -1; DX <= 1; ++DX)
+            {
+                if (const TArray<int32>* Others = Buckets.Find(Bucket + FIntPoint(DX, DY)))
+                {
+                    for (const int32 Other : *Others)
+                    {
+                        const double DistanceSquared = FVector2D::DistSquared(Sites[Site], Sites[Other]);
+                        if (Other != Site && DistanceSquared <= MaxLengthSquared)
+                        {
+                            InRange.Emplace(DistanceSquared, Other);
+                        }
+                    }
+                }
+            }
+        }
+
+        Algo::Sort(InRange);
+        for (int32 Index = 0; Index < FMath::Min(InRange.Num(), NearestCount); ++Index)
+        {
+            Nearest[Site].Add(InRange[Index].Value);
+        }
+    }
+
+    // Keep A-B unless some C is closer to both ends than they are to each other
+    TSet<uint64> Seen;
+    for (int32 A = 0; A < NumSites; ++A)
+    {
+        for (const int32 B : Nearest[A])
+        {
+            const uint64 Key = (static_cast<uint64>(FMath::Min(A, B)) << 32) | static_cast<uint32>(FMath::Max(A, B));
+            bool bAlreadySeen = false;
+            Seen.Add(Key, &bAlreadySeen);
+            if (bAlreadySeen)
+            {
+                continue;
+            }
+
+            const double Length = FVector2D::Distance(Sites[A], Sites[B]);
+            auto IsBlockedBy = [&](int32 C)
+            {
+                return C != A && C != B && FMath::Max(FVector2D::Distance(Sites[A], Sites[C]), FVector2D::Distance(Sites[B], Sites[C])) < Length;
+            };
+
+            if (!Nearest[A].ContainsByPredicate(IsBlockedBy) && !Nearest[B].ContainsByPredicate(IsBlockedBy))
+            {
+                OutEdges.Add({ FMath::Min(A, B), FMath::Max(A, B), static_cast<float>(Length) });
+            }
+        }
+    }
+
+    Algo::Sort(OutEdges, [](const FWorldForgeRoadEdge& Left, const FWorldForgeRoadEdge& Right)
+    {
+        return Left.Length < Right.Length || (Left.Length == Right.Length && (Left.A < Right.A || (Left.A == Right.A && Left.B < Right.B)));
+    });
+}
+
+void FWorldForgeRoadPlanner::SelectRoads(int32 NumSites, TConstArrayView<FWorldForgeRoadEdge> Candidates, float MaxDetour, TArray<FWorldForgeRoadEdge>& OutRoads)
+{
+    using namespace WorldForgeRoads;
+
+    OutRoads.Reset();
+
+    // Kruskal over candidates sorted shortest first
+    TArray<int32> Parents;
+    Parents.SetNumUninitialized(NumSites);
+    for (int32 Site = 0; Site < NumSites; ++Site)
+    {
+        Parents[Site] = Site;
+    }
+
+    TArray<TArray<TPair<int32, float>>> Adjacency;
+    Adjacency.SetNum(NumSites);
+    TArray<int32> Extra;
+    for (int32 Index = 0; Index < Candidates.Num(); ++Index)
+    {
+        const FWorldForgeRoadEdge& Edge = Candidates[Index];
+        const int32 RootA = FindRoot(Parents, Edge.A);
+        const int32 RootB = FindRoot(Parents, Edge.B);
+        if (RootA == RootB)
+        {
+            Extra.Add(Index);
+            continue;
+        }
+
+        Parents[RootA] = RootB;
+        OutRoads.Add(Edge);
+        Adjacency[Edge.A].Emplace(Edge.B, Edge.Length);
+        Adjacency[Edge.B].Emplace(Edge.A, Edge.Length);
+    }
+
+    // Greedy spanner: shortest remaining candidates first, added where the roads so far force a long detour
+    for (const int32 Index : Extra)
+    {
+        const FWorldForgeRoadEdge& Edge = Candidates[Index];
+        const float Limit = Edge.Length * MaxDetour;
+        if (BoundedDistance(Adjacency, Edge.A, Edge.B, Limit) > Limit)
+        {
+            OutRoads.Add(Edge);
+            Adjacency[Edge.A].Emplace(Edge.B, Edge.Length);
+            Adjacency[Edge.B].Emplace(Edge.A, Edge.Length);
+        }
+    }
+}
+
+bool FWorldForgeRoadPlanner::Route(const FVector& Start, const FVector& End, const FWorldForgeRoadSettings& Settings,
+                                   const FWorldForgeHeightCache* Heights, const FWorldForgeWaterMap* Water, FWorldForgeRoad& OutRoad)
+{
+    using namespace WorldForgeRoads;
+
+    OutRoad.Points.Reset();
+    OutRoad.Cost = 0.0f;
+
+    // Grid over both ends with room to go around obstacles
+    const double Length = FVector::Dist2D(Start, End);
+    float CellSize = FMath::Max(Settings.CellSize, 1.0f);
+    const double Margin = FMath::Max(Length * 0.3, 8.0 * CellSize);
+    const FVector2D Min = FVector2D(FMath::Min(Start.X, End.X), FMath::Min(Start.Y, End.Y)) - FVector2D(Margin);
+    const FVector2D Max = FVector2D(FMath::Max(Start.X, End.X), FMath::Max(Start.Y, End.Y)) + FVector2D(Margin);
+
+    int32 Width = FMath::CeilToInt32((Max.X - Min.X) / CellSize) + 1;
+    int32 Height = FMath::CeilToInt32((Max.Y - Min.Y) / CellSize) + 1;
+    if (static_cast<int64>(Width) * Height > Settings.MaxRouteCells)
+    {
+        CellSize *= FMath::Sqrt(static_cast<float>(static_cast<int64>(Width) * Height) / Settings.MaxRouteCells);
+        Width = FMath::CeilToInt32((Max.X - Min.X) / CellSize) + 1;
+        Height = FMath::CeilToInt32((Max.Y - Min.Y) / CellSize) + 1;
+    }
+    const int32 NumCells = Width * Height;
+
+    auto GetPosition = [&](int32 Cell)
+    {
+        return FVector2f(static_cast<float>(Min.X) + (Cell % Width) * CellSize, static_cast<float>(Min.Y) + (Cell / Width) * CellSize);
+    };
+
+    // Ground heights in one batched query; cells off the terrain are treated as flat
+    TArray<FVector2f> Positions;
+    Positions.SetNumUninitialized(NumCells);
+    for (int32 Cell = 0; Cell < NumCells; ++Cell)
+    {
+        Positions[Cell] = GetPosition(Cell);
+    }
+
+    TArray<float> Ground;
+    TArray<bool> bOnTerrain;
+    Ground.SetNumZeroed(NumCells);
+    bOnTerrain.SetNumZeroed(NumCells);
+    if (Heights)
+    {
+        Heights->QueryHeights(Positions, Ground, bOnTerrain);
+    }
+
+    TArray<uint8> bWater;
+    bWater.SetNumZeroed(NumCells);
+    if (Water && Water->Num() > 0)
+    {
+        for (int32 Cell = 0; Cell < NumCells; ++Cell)
+        {
+            bWater[Cell] = Water->IsWater(Positions[Cell].X, Positions[Cell].Y) ? 1 : 0;
+        }
+    }
+
+    auto GetCell = [&](const FVector& Location)
+    {
+        const int32 X = FMath::Clamp(FMath::RoundToInt32((Location.X - Min.X) / CellSize), 0, Width - 1);
+        const int32 Y = FMath::Clamp(FMath::RoundToInt32((Location.Y - Min.Y) / CellSize), 0, Height - 1);
+        return Y * Width + X;
+    };
+    const int32 StartCell = GetCell(Start);
+    const int32 GoalCell = GetCell(End);
+    const int32 GoalX = GoalCell % Width;
+    const int32 GoalY = GoalCell / Width;
+
+    // Every step costs at least its length, so straight-line distance never overestimates
+    auto Heuristic = [&](int32 Cell)
+    {
+        return FMath::Sqrt(static_cast<float>(FMath::Square(Cell % Width - GoalX) + FMath::Square(Cell / Width - GoalY))) * CellSize;
+    };
+
+    TArray<float> Costs;
+    Costs.Init(TNumericLimits<float>::Max(), NumCells);
+    TArray<int32> Parents;
+    Parents.Init(INDEX_NONE, NumCells);
+    TArray<FOpenNode> Open;
+
+    Costs[StartCell] = 0.0f;
+    Open.HeapPush({ Heuristic(StartCell), StartCell }, FOpenNode::FLower());
+    while (Open.Num() > 0)
+    {
+        FOpenNode Top;
+        Open.HeapPop(Top, FOpenNode::FLower(), EAllowShrinking::No);
+        const int32 Cell = Top.Index;
+        if (Cell == GoalCell)
+        {
+            break;
+        }
+        if (Top.Cost > Costs[Cell] + Heuristic(Cell))
+        {
+            continue;
+        }
+
+        const int32 X = Cell % Width;
+        const int32 Y = Cell / Width;
+        for (int32 Direction = 0; Direction < 8; ++Direction)
+        {
+            const int32 NX = X + OffsetX[Direction];
+            const int32 NY = Y + OffsetY[Direction];
+            if (NX < 0 || NY < 0 || NX >= Width || NY >= Height)
+            {
+                continue;
+            }
+
+            const int32 Neighbor = NY * Width + NX;
+            const float Step = StepLength[Direction] * CellSize;
+            const float Slope = bOnTerrain[Cell] && bOnTerrain[Neighbor] ? (Ground[Neighbor] - Ground[Cell]) / Step : 0.0f;
+            const float Cost = Costs[Cell] + Step * (1.0f + Settings.SlopeCost * Slope * Slope + (bWater[Neighbor] ? Settings.WaterCost : 0.0f));
+            if (Cost < Costs[Neighbor])
+            {
+                Costs[Neighbor] = Cost;
+                Parents[Neighbor] = Cell;
+                Open.HeapPush({ Cost + Heuristic(Neighbor), Neighbor }, FOpenNode::FLower());
+            }
+        }
+    }
+
+    if (Costs[GoalCell] == TNumericLimits<float>::Max())
+    {
+        return false;
+    }
+
+    TArray<int32> Path;
+    for (int32 Cell = GoalCell; Cell != INDEX_NONE; Cell = Parents[Cell])
+    {
+        Path.Add(Cell);
+    }
+    Algo::Reverse(Path);
+
+    // Keep the ends exactly, turns, and enough points in between to follow the ground
+    auto GetPoint = [&](int32 Cell, float Fallback)
+    {
+        const FVector2f Position = GetPosition(Cell);
+        return FVector(Position.X, Position.Y, bOnTerrain[Cell] ? Ground[Cell] : Fallback);
+    };
+
+    OutRoad.Points.Add(Start);
+    int32 SinceLast = 0;
+    for (int32 Index = 1; Index < Path.Num() - 1; ++Index)
+    {
+        const int32 InX = Path[Index] % Width - Path[Index - 1] % Width;
+        const int32 InY = Path[Index] / Width - Path[Index - 1] / Width;
+        const int32 OutX = Path[Index + 1] % Width - Path[Index] % Width;
+        const int32 OutY = Path[Index + 1] / Width - Path[Index] / Width;
+        if (++SinceLast >= MaxPointStride || InX != OutX || InY != OutY)
+        {
+            const float Alpha = static_cast<float>(Index) / (Path.Num() - 1);
+            OutRoad.Points.Add(GetPoint(Path[Index], FMath::Lerp(Start.Z, End.Z, Alpha)));
+            SinceLast = 0;
+        }
+    }
+    OutRoad.Points.Add(End);
+    OutRoad.Cost = Costs[GoalCell];
+    return true;
+}
+
+void FWorldForgeRoadPlanner::BuildRoadMesh(const FWorldForgeRoad& Road, float Width, FWorldForgeTerrainMeshData& OutMesh)
+{
+    using namespace WorldForgeRoads;
+
+    OutMesh = FWorldForgeTerrainMeshData();
+    const float HalfWidth = 0.5f * Width;
+    float Distance = 0.0f;
+    for (int32 Index = 0; Index < Road.Points.Num(); ++Index)
+    {
+        const FVector& Point = Road.Points[Index];
+        const FVector& Previous = Road.Points[FMath::Max(Index - 1, 0)];
+        const FVector& Next = Road.Points[FMath::Min(Index + 1, Road.Points.Num() - 1)];
+        const FVector Tangent = FVector(Next.X - Previous.X, Next.Y - Previous.Y, 0.0f).GetSafeNormal();
+        const FVector Across(-Tangent.Y, Tangent.X, 0.0f);
+
+        if (Index > 0)
+        {
+            Distance += FVector::Dist2D(Point, Previous);
+            const int32 Base = OutMesh.Vertices.Num() - 2;
+            OutMesh.Triangles.Append({ Base, Base + 2, Base + 1, Base + 1, Base + 2, Base + 3 });
+        }
+
+        const FVector Surface = Point + FVector(0.0f, 0.0f, SurfaceOffset);
+        OutMesh.Vertices.Add(Surface - Across * HalfWidth);
+        OutMesh.Vertices.Add(Surface + Across * HalfWidth);
+        OutMesh.Normals.Add(FVector::UpVector);
+        OutMesh.Normals.Add(FVector::UpVector);
+        OutMesh.UVs.Add(FVector2D(0.0f, Distance / Width));
+        OutMesh.UVs.Add(FVector2D(1.0f, Distance / Width));
+    }
+}
+
+void FWorldForgeRoadNetwork::SetSettings(const FWorldForgeRoadSettings& InSettings)
+{
+    const bool bTopologyChanged = InSettings.MaxDetour != Settings.MaxDetour || InSettings.MaxEdgeLength != Settings.MaxEdgeLength;
+    const bool bRoutingChanged = InSettings.CellSize != Settings.CellSize || InSettings.MaxRouteCells != Settings.MaxRouteCells
+        || InSettings.SlopeCost != Settings.SlopeCost || InSettings.WaterCost != Settings.WaterCost || InSettings.Width != Settings.Width;
+
+    Settings = InSettings;
+    bTopologyDirty |= bTopologyChanged;
+    if (bRoutingChanged)
+    {
+        InvalidateAll();
+    }
+}
+
+bool FWorldForgeRoadNetwork::AddSite(const FWorldForgeLandmark& Landmark)
+{
+    if (!FWorldForgeRoadPlanner::ConnectsType(Landmark.Type) || Sites.Contains(Landmark.Id))
+    {
+        return false;
+    }
+
+    Sites.Add(Landmark.Id, Landmark.Location);
+    bTopologyDirty = true;
+    return true;
+}
+
+bool FWorldForgeRoadNetwork::RemoveSite(const FString& LandmarkId)
+{
+    if (Sites.Remove(LandmarkId) == 0)
+    {
+        return false;
+    }
+
+    bTopologyDirty = true;
+    return true;
+}
+
+void FWorldForgeRoadNetwork::Clear()
+{
+    Sites.Empty();
+    bTopologyDirty = true;
+}
+
+void FWorldForgeRoadNetwork::InvalidateRegion(const FBox2D& Region)
+{
+    for (TPair<FString, FRoadState>& Pair : Roads)
+    {
+        if (Pair.Value.Bounds.Intersect(Region))
+        {
+            Pair.Value.bNeedsRoute = true;
+        }
+    }
+}
+
+void FWorldForgeRoadNetwork::InvalidateAll()
+{
+    for (TPair<FString, FRoadState>& Pair : Roads)
+    {
+        Pair.Value.bNeedsRoute = true;
+    }
+}
+
+bool FWorldForgeRoadNetwork::HasPendingChanges() const
+{
+    if (bTopologyDirty)
+    {
+        return true;
+    }
+
+    for (const TPair<FString, FRoadState>& Pair : Roads)
+    {
+        if (Pair.Value.bNeedsRoute)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FWorldForgeRoadNetwork::Update(TArray<FRouteRequest>& OutRequests, TArray<FString>& OutRemoved)
+{
+    OutRequests.Reset();
+    OutRemoved.Reset();
+
+    if (bTopologyDirty)
+    {
+        bTopologyDirty = false;
+
+        // Sorted by ID so the same landmarks always produce the same network
+        TArray<FString> Ids;
+        Sites.GenerateKeyArray(Ids);
+        Ids.Sort();
+
+        TArray<FVector2D> Locations;
+        Locations.Reserve(Ids.Num());
+        for (const FString& Id : Ids)
+        {
+            Locations.Add(FVector2D(Sites[Id]));
+        }
+
+        TArray<FWorldForgeRoadEdge> Candidates;
+        TArray<FWorldForgeRoadEdge> Selected;
+        FWorldForgeRoadPlanner::BuildCandidateGraph(Locations, Settings.MaxEdgeLength, Candidates);
+        FWorldForgeRoadPlanner::SelectRoads(Ids.Num(), Candidates, Settings.MaxDetour, Selected);
+
+        // Roads that survive keep their routes; only new ones are routed
+        TSet<FString> Keep;
+        for (const FWorldForgeRoadEdge& Edge : Selected)
+        {
+            const FString Key = MakeKey(Ids[Edge.A], Ids[Edge.B]);
+            Keep.Add(Key);
+            if (!Roads.Contains(Key))
+            {
+                const FVector& From = Sites[Ids[Edge.A]];
+                const FVector& To = Sites[Ids[Edge.B]];
+                const double Margin = FMath::Max(Edge.Length * 0.3, 8.0 * Settings.CellSize);
+
+                FRoadState& Road = Roads.Add(Key);
+                Road.FromId = Ids[Edge.A];
+                Road.ToId = Ids[Edge.B];
+                Road.Bounds = FBox2D(
+                    FVector2D(FMath::Min(From.X, To.X), FMath::Min(From.Y, To.Y)) - FVector2D(Margin),
+                    FVector2D(FMath::Max(From.X, To.X), FMath::Max(From.Y, To.Y)) + FVector2D(Margin));
+            }
+        }
+
+        for (auto It = Roads.CreateIterator(); It; ++It)
+        {
+            if (!Keep.Contains(It->Key))
+            {
+                OutRemoved.Add(It->Key);
+                It.RemoveCurrent();
+            }
+        }
+    }
+
+    for (TPair<FString, FRoadState>& Pair : Roads)
+    {
+        FRoadState& Road = Pair.Value;
+        if (!Road.bNeedsRoute)
+        {
+            continue;
+        }
+
+        Road.bNeedsRoute = false;
+        Road.Version = NextVersion++;
+
+        FRouteRequest& Request = OutRequests.AddDefaulted_GetRef();
+        Request.Key = Pair.Key;
+        Request.FromId = Road.FromId;
+        Request.ToId = Road.ToId;
+        Request.Start = Sites[Road.FromId];
+        Request.End = Sites[Road.ToId];
+        Request.Version = Road.Version;
+    }
+}
+
+bool FWorldForgeRoadNetwork::CommitRoute(const FString& Key, uint32 Version, FWorldForgeRoad&& Road)
+{
+    FRoadState* State = Roads.Find(Key);
+    if (!State || State->Version != Version)
+    {
+        return false;
+    }
+
+    State->Road = MoveTemp(Road);
+    State->bRouted = true;
+    return true;
+}
+
+const FWorldForgeRoad* FWorldForgeRoadNetwork::FindRoad(const FString& Key) const
+{
+    const FRoadState* State = Roads.Find(Key);
+    return State && State->bRouted ? &State->Road : nullptr;
+}
+
+void FWorldForgeRoadNetwork::ForEachRoutedRoad(TFunctionRef<void(const FString& Key, const FWorldForgeRoad& Road)> Visitor) const
+{
+    for (const TPair<FString, FRoadState>& Pair : Roads)
+    {
+        if (Pair.Value.bRouted)
+        {
+            Visitor(Pair.Key, Pair.Value.Road);
+        }
+    }
+}
+
+int32 FWorldForgeRoadNetwork::NumRoutedRoads() const
+{
+    int32 Count = 0;
+    for (const TPair<FString, FRoadState>& Pair : Roads)
+    {
+        Count += Pair.Value.bRouted ? 1 : 0;
+    }
+    return Count;
+}
+
+FString FWorldForgeRoadNetwork::MakeKey(const FString& A, const FString& B)
+{
+    return A < B ? A + TEXT("|") + B : B + TEXT("|") + A;
+}
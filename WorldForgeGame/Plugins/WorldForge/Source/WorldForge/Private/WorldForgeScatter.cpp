@@ -0,0 +1,400 @@
+#include "WorldForgeScatter.h"
+#include "WorldForgeHeightCache.h"
+#include "WorldForgeHydrology.h"
+
+namespace
+{
+    /** One hectare in square Unreal units */
+    constexpr float SquareUnitsPerHectare = 1.0e8f;
+
+    /** Densities are quantized to this fraction of the base density */
+    constexpr float DensityStep = 0.05f;
+
+    FWorldForgeScatterRule MakeRule(EWorldForgeScatterLayer Layer, float BaseDensity,
+                                    std::initializer_list<float> TraitWeights, std::initializer_list<float> AtmosphereScale,
+                                    float MinScale, float MaxScale, float LandmarkRadius, float MinNormalZ, float CullDistance)
+    {
+        FWorldForgeScatterRule Rule;
+        Rule.Layer = Layer;
+        Rule.BaseDensity = BaseDensity;
+        int32 Index = 0;
+        for (float Weight : TraitWeights)
+        {
+            Rule.TraitWeights[Index++] = Weight;
+        }
+        Index = 0;
+        for (float Scale : AtmosphereScale)
+        {
+            Rule.AtmosphereScale[Index++] = Scale;
+        }
+        Rule.MinScale = MinScale;
+        Rule.MaxScale = MaxScale;
+        Rule.LandmarkRadius = LandmarkRadius;
+        Rule.MinNormalZ = MinNormalZ;
+        Rule.CullDistance = CullDistance;
+        return Rule;
+    }
+
+    TArray<FWorldForgeScatterRule> MakeDefaultRules()
+    {
+        // Trait order: Militarism, Prosperity, Religiosity, Lawfulness, Openness
+        // Atmosphere order: WarTorn, Prosperous, Mysterious, Sacred, Desolate, Vibrant
+        TArray<FWorldForgeScatterRule> Rules;
+        Rules.Add(MakeRule(EWorldForgeScatterLayer::Trees, 80.0f,
+            { -0.4f, 0.5f, 0.0f, 0.0f, 0.0f }, { 0.5f, 1.1f, 1.4f, 1.0f, 0.1f, 1.3f },
+            0.8f, 1.6f, 2500.0f, 0.8f, 40000.0f));
+        Rules.Add(MakeRule(EWorldForgeScatterLayer::Shrubs, 150.0f,
+            { 0.0f, 0.3f, 0.0f, 0.0f, -0.2f }, { 0.7f, 1.0f, 1.2f, 1.0f, 0.3f, 1.5f },
+            0.3f, 0.7f, 1200.0f, 0.7f, 15000.0f));
+        Rules.Add(MakeRule(EWorldForgeScatterLayer::Rocks, 25.0f,
+            { 0.3f, -0.2f, 0.0f, 0.0f, 0.0f }, { 1.3f, 0.8f, 1.2f, 1.0f, 2.0f, 0.8f },
+            0.4f, 1.5f, 800.0f, 0.0f, 25000.0f));
+        Rules.Add(MakeRule(EWorldForgeScatterLayer::DeadTrees, 10.0f,
+            { 0.8f, -0.6f, 0.0f, 0.0f, 0.0f }, { 3.0f, 0.3f, 1.2f, 0.5f, 4.0f, 0.2f },
+            0.7f, 1.3f, 2000.0f, 0.75f, 30000.0f));
+        Rules.Add(MakeRule(EWorldForgeScatterLayer::Shrines, 0.4f,
+            { 0.0f, 0.0f, 1.5f, 0.2f, 0.0f }, { 0.5f, 1.0f, 1.5f, 3.0f, 0.6f, 1.0f },
+            1.0f, 1.4f, 3000.0f, 0.9f, 30000.0f));
+        Rules.Add(MakeRule(EWorldForgeScatterLayer::Props, 40.0f,
+            { 0.0f, 0.8f, 0.0f, 0.2f, 0.6f }, { 0.6f, 1.5f, 0.8f, 1.0f, 0.2f, 1.3f },
+            0.5f, 1.0f, 3500.0f, 0.9f, 10000.0f));
+
+        // Rocks sit in riverbeds; props gather around landmarks instead of avoiding them
+        Rules[static_cast<int32>(EWorldForgeScatterLayer::Rocks)].bAvoidWater = false;
+        Rules[static_cast<int32>(EWorldForgeScatterLayer::Props)].bNearLandmarks = true;
+        return Rules;
+    }
+}
+
+float FWorldForgeScatterRule::GetDensity(const FWorldForgeState& State) const
+{
+    float Multiplier = 1.0f;
+    for (int32 Trait = 0; Trait < 5; ++Trait)
+    {
+        Multiplier += TraitWeights[Trait] * (State.GetTrait(static_cast<EWorldForgeTrait>(Trait)) - 0.5f) * 2.0f;
+    }
+    return BaseDensity * FMath::Max(0.0f, Multiplier) * AtmosphereScale[static_cast<int32>(State.Atmosphere)];
+}
+
+bool FWorldForgeScatterLayerParams::operator==(const FWorldForgeScatterLayerParams& Other) const
+{
+    return Rule.Layer == Other.Rule.Layer && Density == Other.Density && Seed == Other.Seed;
+}
+
+const FWorldForgeScatterRule& FWorldForgeScatter::GetRule(EWorldForgeScatterLayer Layer)
+{
+    static const TArray<FWorldForgeScatterRule> Rules = MakeDefaultRules();
+    return Rules[static_cast<int32>(Layer)];
+}
+
+FWorldForgeScatterLayerParams FWorldForgeScatter::MakeLayer(const FWorldForgeState& State, EWorldForgeScatterLayer Layer)
+{
+    FWorldForgeScatterLayerParams Params;
+    Params.Rule = GetRule(Layer);
+    Params.Seed = State.Seed;
+
+    const float Step = Params.Rule.BaseDensity * DensityStep;
+    const float Density = Params.Rule.GetDensity(State);
+    Params.Density = Step > 0.0f ? FMath::RoundToFloat(Density / Step) * Step : 0.0f;
+    return Params;
+}
+
+void FWorldForgeScatter::MakeLayers(const FWorldForgeState& State, TArray<FWorldForgeScatterLayerParams>& OutLayers)
+{
+    OutLayers.Reset(NumLayers);
+    for (int32 Layer = 0; Layer < NumLayers; ++Layer)
+    {
+        OutLayers.Add(MakeLayer(State, static_cast<EWorldForgeScatterLayer>(Layer)));
+    }
+}
+
+bool FWorldForgeScatter::ExcludesScatter(EWorldForgeLandmarkType Type)
+{
+    return Type == EWorldForgeLandmarkType::Settlement
+        || Type == EWorldForgeLandmarkType::Fortress
+        || Type == EWorldForgeLandmarkType::Monastery;
+}
+
+void FWorldForgeScatter::GenerateCell(const FWorldForgeScatterLayerParams& Layer, FIntPoint Cell, const FBox2D& Bounds,
+                                      TConstArrayView<FVector2D> Landmarks, const FWorldForgeHeightCache& Heights,
+                                      const FWorldForgeWaterMap* Water, TArray<FTransform>& OutTransforms)
+{
+    OutTransforms.Reset();
+
+    const FWorldForgeScatterRule& Rule = Layer.Rule;
+    if (Layer.Density <= 0.0f || (Rule.bNearLandmarks && Landmarks.Num() == 0))
+    {
+        return;
+    }
+
+    uint32 StreamSeed = GetTypeHash(Layer.Seed);
+    StreamSeed = HashCombine(StreamSeed, GetTypeHash(static_cast<uint8>(Rule.Layer)));
+    StreamSeed = HashCombine(StreamSeed, GetTypeHash(Cell));
+    FRandomStream Stream(static_cast<int32>(StreamSeed));
+
+    const FVector2D Size = Bounds.GetSize();
+    const float Expected = Layer.Density * static_cast<float>(Size.X * Size.Y) / SquareUnitsPerHectare;
+    const int32 Count = FMath::FloorToInt32(Expected + Stream.FRand());
+    const float RadiusSquared = FMath::Square(Rule.LandmarkRadius);
+
+    OutTransforms.Reserve(Count);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        // Draw every value before any rejection so the stream stays aligned across candidates
+        const float X = static_cast<float>(Bounds.Min.X + Stream.FRand() * Size.X);
+        const float Y = static_cast<float>(Bounds.Min.Y + Stream.FRand() * Size.Y);
+        const float Yaw = Stream.FRandRange(0.0f, 360.0f);
+        const float Scale = Stream.FRandRange(Rule.MinScale, Rule.MaxScale);
+
+        bool bNearLandmark = false;
+        for (const FVector2D& Landmark : Landmarks)
+        {
+            if (FVector2D::DistSquared(Landmark, FVector2D(X, Y)) < RadiusSquared)
+            {
+                bNearLandmark = true;
+                break;
+            }
+        }
+        if (bNearLandmark != Rule.bNearLandmarks)
+        {
+            continue;
+        }
+
+        if (Rule.bAvoidWater && Water && Water->IsWater(X, Y))
+        {
+            continue;
+        }
+
+        float Height = 0.0f;
+        FVector Normal;
+        if (!Heights.QueryHeightAndNormal(X, Y, Height, Normal) || Normal.Z < Rule.MinNormalZ)
+        {
+            continue;
+        }
+
+        OutTransforms.Emplace(FRotator(0.0f, Yaw, 0.0f), FVector(X, Y, Height), FVector(Scale));
+    }
+}
+
+void FWorldForgeScatterGrid::SetGrid(int32 InCellsPerSide, float InCellSize)
+{
+    InCellsPerSide = FMath::Max(1, InCellsPerSide);
+    InCellSize = FMath::Max(1.0f, InCellSize);
+    if (InCellsPerSide == CellsPerSide && InCellSize == CellSize)
+    {
+        return;
+    }
+
+    CellsPerSide = InCellsPerSide;
+    CellSize = InCellSize;
+
+    // Start every cell at a fresh version so results requested for the old grid are dropped
+    FCellState Fresh;
+    Fresh.DirtyLayers = AllLayers;
+    for (uint32& Version : Fresh.Versions)
+    {
+        Version = NextVersion;
+    }
+    ++NextVersion;
+
+    Cells.Init(Fresh, CellsPerSide * CellsPerSide);
+    NumDirtyCells = Cells.Num();
+}
+
+void FWorldForgeScatterGrid::SetLayers(TArray<FWorldForgeScatterLayerParams>&& InLayers)
+{
+    uint32 ChangedLayers = 0;
+    if (InLayers.Num() != Layers.Num())
+    {
+        ChangedLayers = AllLayers;
+    }
+    else
+    {
+        for (int32 Layer = 0; Layer < Layers.Num(); ++Layer)
+        {
+            if (InLayers[Layer] != Layers[Layer])
+            {
+                ChangedLayers |= 1u << Layer;
+            }
+        }
+    }
+
+    if (ChangedLayers != 0)
+    {
+        Layers = MoveTemp(InLayers);
+        MarkAllDirty(ChangedLayers);
+    }
+}
+
+float FWorldForgeScatterGrid::GetMaxLandmarkRadius() const
+{
+    float MaxRadius = 0.0f;
+    for (const FWorldForgeScatterLayerParams& Layer : Layers)
+    {
+        MaxRadius = FMath::Max(MaxRadius, Layer.Rule.LandmarkRadius);
+    }
+    return MaxRadius;
+}
+
+void FWorldForgeScatterGrid::MarkRegionDirty(const FBox2D& Region, uint32 LayerMask)
+{
+    TArray<FIntPoint> RegionCells;
+    GetCellsInRegion(Region, RegionCells);
+    for (const FIntPoint& Cell : RegionCells)
+    {
+        MarkCellDirty(Cell.Y * CellsPerSide + Cell.X, LayerMask);
+    }
+}
+
+void FWorldForgeScatterGrid::GetCellsInRegion(const FBox2D& Region, TArray<FIntPoint>& OutCells) const
+{
+    OutCells.Reset();
+    if (Cells.Num() == 0)
+    {
+        return;
+    }
+
+    const float Origin = GetGridOrigin();
+    const int32 MinX = FMath::Max(0, FMath::FloorToInt32((Region.Min.X - Origin) / CellSize));
+    const int32 MinY = FMath::Max(0, FMath::FloorToInt32((Region.Min.Y - Origin) / CellSize));
+    const int32 MaxX = FMath::Min(CellsPerSide - 1, FMath::FloorToInt32((Region.Max.X - Origin) / CellSize));
+    const int32 MaxY = FMath::Min(CellsPerSide - 1, FMath::FloorToInt32((Region.Max.Y - Origin) / CellSize));
+
+    for (int32 Y = MinY; Y <= MaxY; ++Y)
+    {
+        for (int32 X = MinX; X <= MaxX; ++X)
+        {
+            OutCells.Add(FIntPoint(X, Y));
+        }
+    }
+}
+
+void FWorldForgeScatterGrid::GetNearestCells(const FVector2D& Focus, int32 MaxCells, TArray<FIntPoint>& OutCells) const
+{
+    OutCells.Reset(Cells.Num());
+    for (int32 Index = 0; Index < Cells.Num(); ++Index)
+    {
+        OutCells.Add(FIntPoint(Index % CellsPerSide, Index / CellsPerSide));
+    }
+
+    OutCells.Sort([this, &Focus](const FIntPoint& A, const FIntPoint& B)
+    {
+        return FVector2D::DistSquared(GetCellBounds(A).GetCenter(), Focus) < FVector2D::DistSquared(GetCellBounds(B).GetCenter(), Focus);
+    });
+    OutCells.SetNum(FMath::Clamp(MaxCells, 0, OutCells.Num()));
+}
+
+void FWorldForgeScatterGrid::MarkAllDirty(uint32 LayerMask)
+{
+    for (int32 Index = 0; Index < Cells.Num(); ++Index)
+    {
+        MarkCellDirty(Index, LayerMask);
+    }
+}
+
+void FWorldForgeScatterGrid::MarkCellDirty(int32 Index, uint32 LayerMask)
+{
+    FCellState& State = Cells[Index];
+    if (State.DirtyLayers == 0 && LayerMask != 0)
+    {
+        ++NumDirtyCells;
+    }
+    State.DirtyLayers |= LayerMask;
+}
+
+void FWorldForgeScatterGrid::TakeDirtyCells(const FVector2D& Focus, int32 MaxCells, TArray<FCellRequest>& OutRequests)
+{
+    OutRequests.Reset();
+    if (NumDirtyCells == 0 || MaxCells <= 0)
+    {
+        return;
+    }
+
+    TArray<int32> Dirty;
+    Dirty.Reserve(NumDirtyCells);
+    for (int32 Index = 0; Index < Cells.Num(); ++Index)
+    {
+        if (Cells[Index].DirtyLayers != 0)
+        {
+            Dirty.Add(Index);
+        }
+    }
+
+    if (Dirty.Num() > MaxCells)
+    {
+        auto DistanceToFocus = [this, &Focus](int32 Index)
+        {
+            const FIntPoint Cell(Index % CellsPerSide, Index / CellsPerSide);
+            return FVector2D::DistSquared(GetCellBounds(Cell).GetCenter(), Focus);
+        };
+        Dirty.Sort([&DistanceToFocus](int32 A, int32 B) { return DistanceToFocus(A) < DistanceToFocus(B); });
+        Dirty.SetNum(MaxCells);
+    }
+
+    for (int32 Index : Dirty)
+    {
+        FCellState& State = Cells[Index];
+        FCellRequest& Request = OutRequests.AddDefaulted_GetRef();
+        Request.Cell = FIntPoint(Index % CellsPerSide, Index / CellsPerSide);
+        Request.LayerMask = State.DirtyLayers;
+        for (int32 Layer = 0; Layer < FWorldForgeScatter::NumLayers; ++Layer)
+        {
+            if (State.DirtyLayers & (1u << Layer))
+            {
+                State.Versions[Layer] = NextVersion++;
+            }
+            Request.Versions[Layer] = State.Versions[Layer];
+        }
+
+        State.DirtyLayers = 0;
+        --NumDirtyCells;
+    }
+}
+
+bool FWorldForgeScatterGrid::ClaimCell(FIntPoint Cell, uint32 LayerMask, FCellRequest& OutRequest)
+{
+    if (Cell.X < 0 || Cell.Y < 0 || Cell.X >= CellsPerSide || Cell.Y >= CellsPerSide)
+    {
+        return false;
+    }
+
+    FCellState& State = Cells[Cell.Y * CellsPerSide + Cell.X];
+    const uint32 Claimed = State.DirtyLayers & LayerMask;
+    if (Claimed == 0)
+    {
+        return false;
+    }
+
+    OutRequest.Cell = Cell;
+    OutRequest.LayerMask = Claimed;
+    for (int32 Layer = 0; Layer < FWorldForgeScatter::NumLayers; ++Layer)
+    {
+        if (Claimed & (1u << Layer))
+        {
+            State.Versions[Layer] = NextVersion++;
+        }
+        OutRequest.Versions[Layer] = State.Versions[Layer];
+    }
+
+    State.DirtyLayers &= ~Claimed;
+    if (State.DirtyLayers == 0)
+    {
+        --NumDirtyCells;
+    }
+    return true;
+}
+
+bool FWorldForgeScatterGrid::IsCurrent(FIntPoint Cell, int32 Layer, uint32 Version) const
+{
+    if (Cell.X < 0 || Cell.Y < 0 || Cell.X >= CellsPerSide || Cell.Y >= CellsPerSide)
+    {
+        return false;
+    }
+    return Cells[Cell.Y * CellsPerSide + Cell.X].Versions[Layer] == Version;
+}
+
+FBox2D FWorldForgeScatterGrid::GetCellBounds(FIntPoint Cell) const
+{
+    const FVector2D Min(GetGridOrigin() + Cell.X * CellSize, GetGridOrigin() + Cell.Y * CellSize);
+    return FBox2D(Min, Min + FVector2D(CellSize));
+}
@@ -0,0 +1,85 @@
+#include "WorldForgeScatterActor.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "UObject/ConstructorHelpers.h"
+
+AWorldForgeScatterActor::AWorldForgeScatterActor()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    SceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
+    SetRootComponent(SceneRoot);
+
+    // Placeholder shapes per layer: trees, shrubs, rocks, dead trees, shrines, props
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> ConeMesh(TEXT("/Engine/BasicShapes/Cone"));
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> SphereMesh(TEXT("/Engine/BasicShapes/Sphere"));
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMesh(TEXT("/Engine/BasicShapes/Cube"));
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> CylinderMesh(TEXT("/Engine/BasicShapes/Cylinder"));
+
+    LayerMeshes.SetNum(FWorldForgeScatter::NumLayers);
+    LayerMeshes[static_cast<int32>(EWorldForgeScatterLayer::Trees)] = ConeMesh.Object;
+    LayerMeshes[static_cast<int32>(EWorldForgeScatterLayer::Shrubs)] = SphereMesh.Object;
+    LayerMeshes[static_cast<int32>(EWorldForgeScatterLayer::Rocks)] = SphereMesh.Object;
+    LayerMeshes[static_cast<int32>(EWorldForgeScatterLayer::DeadTrees)] = CylinderMesh.Object;
+    LayerMeshes[static_cast<int32>(EWorldForgeScatterLayer::Shrines)] = CylinderMesh.Object;
+    LayerMeshes[static_cast<int32>(EWorldForgeScatterLayer::Props)] = CubeMesh.Object;
+}
+
+void AWorldForgeScatterActor::SetInstances(EWorldForgeScatterLayer Layer, FIntPoint Cell, const TArray<FTransform>& Transforms)
+{
+    const FIntVector Key(Cell.X, Cell.Y, static_cast<int32>(Layer));
+    UHierarchicalInstancedStaticMeshComponent* Component = nullptr;
+    if (TObjectPtr<UHierarchicalInstancedStaticMeshComponent>* Existing = CellComponents.Find(Key))
+    {
+        Component = *Existing;
+        Component->ClearInstances();
+    }
+    else if (Transforms.Num() > 0)
+    {
+        Component = GetOrCreateComponent(Layer, Cell);
+    }
+
+    if (Component && Transforms.Num() > 0)
+    {
+        Component->AddInstances(Transforms, false, true);
+    }
+}
+
+void AWorldForgeScatterActor::ClearInstances()
+{
+    for (auto& Pair : CellComponents)
+    {
+        if (Pair.Value)
+        {
+            Pair.Value->ClearInstances();
+        }
+    }
+}
+
+int32 AWorldForgeScatterActor::GetInstanceCount() const
+{
+    int32 Count = 0;
+    for (const auto& Pair : CellComponents)
+    {
+        if (Pair.Value)
+        {
+            Count += Pair.Value->GetInstanceCount();
+        }
+    }
+    return Count;
+}
+
+UHierarchicalInstancedStaticMeshComponent* AWorldForgeScatterActor::GetOrCreateComponent(EWorldForgeScatterLayer Layer, FIntPoint Cell)
+{
+    const int32 LayerIndex = static_cast<int32>(Layer);
+    const FName ComponentName(*FString::Printf(TEXT("Scatter_%d_%d_%d"), LayerIndex, Cell.X, Cell.Y));
+    UHierarchicalInstancedStaticMeshComponent* Component = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, ComponentName);
+    Component->SetStaticMesh(LayerMeshes.IsValidIndex(LayerIndex) ? LayerMeshes[LayerIndex] : nullptr);
+    Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    Component->SetCullDistances(0, FMath::RoundToInt32(FWorldForgeScatter::GetRule(Layer).CullDistance));
+    Component->SetupAttachment(SceneRoot);
+    Component->RegisterComponent();
+
+    CellComponents.Add(FIntVector(Cell.X, Cell.Y, LayerIndex), Component);
+    return Component;
+}
@@ -1,10 +1,27 @@
 #include "WorldForgeSettlementActor.h"
+#include "WorldForgeSubsystem.h"
+#include "WorldForgeLayoutGenerator.h"
+#include "WorldForgeSignificance.h"
+#include "SignificanceManager.h"
+#include "Async/Async.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Components/StaticMeshComponent.h"
-#include "Components/TextRenderComponent.h"
+#include "Engine/GameInstance.h"
 #include "Engine/StaticMesh.h"
-#include "Materials/MaterialInstanceDynamic.h"
+#include "HAL/IConsoleManager.h"
+#include "Materials/MaterialInterface.h"
+#include "Tasks/Task.h"
 #include "UObject/ConstructorHelpers.h"
 
+static TAutoConsoleVariable<float> CVarLandmarkCullDistance(
+    TEXT("WorldForge.LandmarkCullDistance"),
+    300000.0f,
+    TEXT("Distance beyond which landmark meshes are not drawn (0 = never cull)"),
+    ECVF_Default);
+
+FOnSettlementActorLifetime AWorldForgeSettlementActor::OnSettlementInitialized;
+FOnSettlementActorLifetime AWorldForgeSettlementActor::OnSettlementEndPlay;
+
 AWorldForgeSettlementActor::AWorldForgeSettlementActor()
 {
     PrimaryActorTick.bCanEverTick = false;
@@ -25,14 +42,18 @@ AWorldForgeSettlementActor::AWorldForgeSettlementActor()
         MeshComponent->SetStaticMesh(CubeMesh.Object);
     }
 
-    // Create name label
-    NameLabel = CreateDefaultSubobject<UTextRenderComponent>(TEXT("NameLabel"));
-    NameLabel->SetupAttachment(SceneRoot);
-    NameLabel->SetRelativeLocation(FVector(0.0f, 0.0f, 3500.0f)); // Above the mesh
-    NameLabel->SetHorizontalAlignment(EHTA_Center);
-    NameLabel->SetVerticalAlignment(EVRTA_TextCenter);
-    NameLabel->SetWorldSize(500.0f); // Large text visible from distance
-    NameLabel->SetTextRenderColor(FColor::White);
+    // Layout piece meshes, indexed by EWorldForgeLayoutPiece
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> CylinderMesh(TEXT("/Engine/BasicShapes/Cylinder"));
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> ConeMesh(TEXT("/Engine/BasicShapes/Cone"));
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> PlaneMesh(TEXT("/Engine/BasicShapes/Plane"));
+    PieceMeshes.SetNum(static_cast<int32>(EWorldForgeLayoutPiece::Count));
+    PieceMeshes[static_cast<int32>(EWorldForgeLayoutPiece::House)] = CubeMesh.Object;
+    PieceMeshes[static_cast<int32>(EWorldForgeLayoutPiece::Hall)] = CubeMesh.Object;
+    PieceMeshes[static_cast<int32>(EWorldForgeLayoutPiece::Temple)] = ConeMesh.Object;
+    PieceMeshes[static_cast<int32>(EWorldForgeLayoutPiece::Tower)] = CylinderMesh.Object;
+    PieceMeshes[static_cast<int32>(EWorldForgeLayoutPiece::Wall)] = CubeMesh.Object;
+    PieceMeshes[static_cast<int32>(EWorldForgeLayoutPiece::Plaza)] = PlaneMesh.Object;
+    PieceMeshes[static_cast<int32>(EWorldForgeLayoutPiece::Rubble)] = CubeMesh.Object;
 }
 
 void AWorldForgeSettlementActor::BeginPlay()
@@ -40,17 +61,191 @@ void AWorldForgeSettlementActor::BeginPlay()
     Super::BeginPlay();
 }
 
+void AWorldForgeSettlementActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    OnSettlementEndPlay.Broadcast(this);
+    UnregisterSignificance();
+    Super::EndPlay(EndPlayReason);
+}
+
 void AWorldForgeSettlementActor::InitializeFromLandmark(const FWorldForgeLandmark& Landmark)
 {
     LandmarkData = Landmark;
+    UpdateVisuals();
+    RegenerateLayout();
+    RegisterSignificance();
+    OnSettlementInitialized.Broadcast(this);
+}
 
-    // Set the name label
-    if (NameLabel)
+void AWorldForgeSettlementActor::RegisterSignificance()
+{
+    UGameInstance* GameInstance = GetGameInstance();
+    const UWorldForgeSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<UWorldForgeSubsystem>() : nullptr;
+    if (Subsystem)
     {
-        NameLabel->SetText(FText::FromString(Landmark.Name));
+        SignificanceRelevance = FWorldForgeSignificance::GetRelevance(LandmarkData.Type,
+            Subsystem->GetTrait(EWorldForgeTrait::Militarism), Subsystem->GetTrait(EWorldForgeTrait::Prosperity), Subsystem->GetTrait(EWorldForgeTrait::Religiosity));
     }
 
-    UpdateVisuals();
+    USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+    if (bSignificanceRegistered || !SignificanceManager)
+    {
+        return;
+    }
+
+    // Scored in parallel by the manager; reads only this actor's own data
+    SignificanceManager->RegisterObject(this, FWorldForgeSignificance::Tag,
+        [](USignificanceManager::FManagedObjectInfo* Info, const FTransform& Viewpoint)
+        {
+            const AWorldForgeSettlementActor* Actor = CastChecked<AWorldForgeSettlementActor>(Info->GetObject());
+            const FVector TypeScale = GetScaleForType(Actor->LandmarkData.Type);
+            return FWorldForgeSignificance::Score(Viewpoint, Actor->LandmarkData.Location,
+                FMath::Max(TypeScale.X, TypeScale.Y) * 50.0f, Actor->SignificanceRelevance);
+        });
+    bSignificanceRegistered = true;
+}
+
+void AWorldForgeSettlementActor::UnregisterSignificance()
+{
+    if (!bSignificanceRegistered)
+    {
+        return;
+    }
+
+    if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+    {
+        SignificanceManager->UnregisterObject(this);
+    }
+    bSignificanceRegistered = false;
+}
+
+void AWorldForgeSettlementActor::SetSignificanceTier(EWorldForgeSignificanceTier Tier)
+{
+    if (Tier != SignificanceTier)
+    {
+        SignificanceTier = Tier;
+        ApplySignificanceTier();
+    }
+}
+
+void AWorldForgeSettlementActor::ApplySignificanceTier()
+{
+    SetActorHiddenInGame(SignificanceTier == EWorldForgeSignificanceTier::Dormant);
+
+    const bool bShadows = SignificanceTier == EWorldForgeSignificanceTier::High;
+    const bool bMinorPieces = SignificanceTier <= EWorldForgeSignificanceTier::Medium;
+    if (MeshComponent)
+    {
+        MeshComponent->SetCastShadow(bShadows);
+    }
+
+    for (int32 PieceIndex = 0; PieceIndex < LayoutComponents.Num(); ++PieceIndex)
+    {
+        if (UInstancedStaticMeshComponent* Component = LayoutComponents[PieceIndex])
+        {
+            const bool bMinor = PieceIndex == static_cast<int32>(EWorldForgeLayoutPiece::Plaza)
+                || PieceIndex == static_cast<int32>(EWorldForgeLayoutPiece::Rubble);
+            Component->SetCastShadow(bShadows);
+            Component->SetVisibility(bMinorPieces || !bMinor);
+        }
+    }
+}
+
+void AWorldForgeSettlementActor::RegenerateLayout()
+{
+    UGameInstance* GameInstance = GetGameInstance();
+    UWorldForgeSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<UWorldForgeSubsystem>() : nullptr;
+    if (!Subsystem)
+    {
+        return;
+    }
+
+    const FWorldForgeLayoutParams Params = Subsystem->MakeLayoutParams(LandmarkData);
+    const uint32 RequestId = ++LayoutRequestId;
+
+    // Landmarks of a committed outcome arrive with their layout already generated
+    FWorldForgeSettlementLayout Prepared;
+    if (Subsystem->TakePreparedLayout(LandmarkData.Id, Params, Prepared))
+    {
+        CommitLayout(Prepared);
+        return;
+    }
+
+    TWeakObjectPtr<AWorldForgeSettlementActor> WeakThis(this);
+
+    // Generation only touches plain data; the instance commit hops back to the game thread
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [Params, RequestId, WeakThis]()
+    {
+        FWorldForgeSettlementLayout Layout = FWorldForgeLayoutGenerator::Generate(Params);
+
+        AsyncTask(ENamedThreads::GameThread, [Layout = MoveTemp(Layout), RequestId, WeakThis]()
+        {
+            AWorldForgeSettlementActor* Actor = WeakThis.Get();
+            if (Actor && Actor->LayoutRequestId == RequestId)
+            {
+                Actor->CommitLayout(Layout);
+            }
+        });
+    });
+}
+
+void AWorldForgeSettlementActor::CommitLayout(const FWorldForgeSettlementLayout& Layout)
+{
+    UGameInstance* GameInstance = GetGameInstance();
+    UWorldForgeSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<UWorldForgeSubsystem>() : nullptr;
+    const FLinearColor TypeColor = GetColorForType(LandmarkData.Type);
+    const float CullDistance = GetLandmarkCullDistance();
+
+    LayoutComponents.SetNum(static_cast<int32>(EWorldForgeLayoutPiece::Count));
+    for (int32 PieceIndex = 0; PieceIndex < LayoutComponents.Num(); ++PieceIndex)
+    {
+        const TArray<FTransform>& Transforms = Layout.Pieces[PieceIndex];
+        TObjectPtr<UInstancedStaticMeshComponent>& Component = LayoutComponents[PieceIndex];
+
+        if (!Component)
+        {
+            if (Transforms.Num() == 0 || !PieceMeshes.IsValidIndex(PieceIndex) || !PieceMeshes[PieceIndex])
+            {
+                continue;
+            }
+
+            Component = NewObject<UInstancedStaticMeshComponent>(this);
+            Component->SetStaticMesh(PieceMeshes[PieceIndex]);
+            Component->SetCullDistances(0, FMath::RoundToInt32(CullDistance));
+            if (PieceIndex == static_cast<int32>(EWorldForgeLayoutPiece::Plaza))
+            {
+                Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+            }
+            if (Subsystem)
+            {
+                if (UMaterialInterface* TypeMaterial = Subsystem->GetLandmarkMaterial(PieceMeshes[PieceIndex]->GetMaterial(0), LandmarkData.Type))
+                {
+                    Component->SetMaterial(0, TypeMaterial);
+                }
+            }
+            Component->SetCustomPrimitiveDataFloat(0, TypeColor.R);
+            Component->SetCustomPrimitiveDataFloat(1, TypeColor.G);
+            Component->SetCustomPrimitiveDataFloat(2, TypeColor.B);
+            Component->SetupAttachment(SceneRoot);
+            Component->RegisterComponent();
+        }
+
+        Component->ClearInstances();
+        Component->AddInstances(Transforms, false);
+    }
+
+    LayoutHash = Layout.ComputeHash();
+    ApplySignificanceTier();
+
+    // The placeholder is only needed until real buildings exist
+    if (MeshComponent && Layout.NumPieces() > 0)
+    {
+        MeshComponent->SetVisibility(false);
+        MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("WorldForge: Settlement '%s' layout committed - %d pieces, hash %08x"),
+           *LandmarkData.Name, Layout.NumPieces(), LayoutHash);
 }
 
 void AWorldForgeSettlementActor::UpdateVisuals_Implementation()
@@ -66,23 +261,22 @@ void AWorldForgeSettlementActor::UpdateVisuals_Implementation()
 
     // Apply scale
     MeshComponent->SetRelativeScale3D(TypeScale);
+    MeshComponent->SetCullDistance(GetLandmarkCullDistance());
 
-    // Create dynamic material instance with the appropriate color
-    UMaterialInterface* BaseMaterial = MeshComponent->GetMaterial(0);
-    if (BaseMaterial)
+    // Share one material per landmark type instead of creating a dynamic instance per actor,
+    // so settlements of the same type batch together
+    UMaterialInterface* BaseMaterial = MeshComponent->GetStaticMesh() ? MeshComponent->GetStaticMesh()->GetMaterial(0) : nullptr;
+    UGameInstance* GameInstance = GetGameInstance();
+    UWorldForgeSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<UWorldForgeSubsystem>() : nullptr;
+    if (BaseMaterial && Subsystem)
     {
-        UMaterialInstanceDynamic* DynMaterial = UMaterialInstanceDynamic::Create(BaseMaterial, this);
-        if (DynMaterial)
+        if (UMaterialInterface* TypeMaterial = Subsystem->GetLandmarkMaterial(BaseMaterial, LandmarkData.Type))
         {
-            // Try common parameter names for base color
-            DynMaterial->SetVectorParameterValue(TEXT("BaseColor"), TypeColor);
-            DynMaterial->SetVectorParameterValue(TEXT("Base Color"), TypeColor);
-            DynMaterial->SetVectorParameterValue(TEXT("Color"), TypeColor);
-            MeshComponent->SetMaterial(0, DynMaterial);
+            MeshComponent->SetMaterial(0, TypeMaterial);
         }
     }
 
-    // Also try setting the mesh color directly (for simple materials)
+    // Per-primitive color for shared materials that read custom primitive data
     MeshComponent->SetCustomPrimitiveDataFloat(0, TypeColor.R);
     MeshComponent->SetCustomPrimitiveDataFloat(1, TypeColor.G);
     MeshComponent->SetCustomPrimitiveDataFloat(2, TypeColor.B);
@@ -93,7 +287,7 @@ void AWorldForgeSettlementActor::UpdateVisuals_Implementation()
            TypeColor.R, TypeColor.G, TypeColor.B);
 }
 
-FLinearColor AWorldForgeSettlementActor::GetColorForType(EWorldForgeLandmarkType Type) const
+FLinearColor AWorldForgeSettlementActor::GetColorForType(EWorldForgeLandmarkType Type)
 {
     switch (Type)
     {
@@ -117,7 +311,17 @@ FLinearColor AWorldForgeSettlementActor::GetColorForType(EWorldForgeLandmarkType
     }
 }
 
-FVector AWorldForgeSettlementActor::GetScaleForType(EWorldForgeLandmarkType Type) const
+FBox AWorldForgeSettlementActor::GetNavigationBounds(const FWorldForgeLandmark& Landmark)
+{
+    // The layout spreads a little beyond the placeholder mesh (100 units per unit of scale)
+    const FVector TypeScale = GetScaleForType(Landmark.Type);
+    const float HalfExtent = FMath::Max(TypeScale.X, TypeScale.Y) * 50.0f * 1.5f;
+    return FBox(
+        Landmark.Location - FVector(HalfExtent, HalfExtent, 500.0f),
+        Landmark.Location + FVector(HalfExtent, HalfExtent, TypeScale.Z * 100.0f));
+}
+
+FVector AWorldForgeSettlementActor::GetScaleForType(EWorldForgeLandmarkType Type)
 {
     // Default cube is 100 units - scale up to be visible in typical UE5 levels
     switch (Type)
@@ -141,3 +345,8 @@ FVector AWorldForgeSettlementActor::GetScaleForType(EWorldForgeLandmarkType Type
         return FVector(10.0f, 10.0f, 10.0f);
     }
 }
+
+float AWorldForgeSettlementActor::GetLandmarkCullDistance()
+{
+    return FMath::Max(0.0f, CVarLandmarkCullDistance.GetValueOnGameThread());
+}
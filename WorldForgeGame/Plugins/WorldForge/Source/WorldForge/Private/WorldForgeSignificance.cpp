@@ -0,0 +1,84 @@
+#include "WorldForgeSignificance.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("WorldForge"), STATGROUP_WorldForge, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Landmarks High"), STAT_WorldForgeSignificanceHigh, STATGROUP_WorldForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Landmarks Medium"), STAT_WorldForgeSignificanceMedium, STATGROUP_WorldForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Landmarks Low"), STAT_WorldForgeSignificanceLow, STATGROUP_WorldForge);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Landmarks Dormant"), STAT_WorldForgeSignificanceDormant, STATGROUP_WorldForge);
+
+const FName FWorldForgeSignificance::Tag(TEXT("WorldForge.Landmark"));
+
+namespace WorldForgeSignificance
+{
+    /** Score multiplier for landmarks behind the camera; they may come into view with a turn of the head */
+    constexpr float BehindViewScale = 0.25f;
+}
+
+float FWorldForgeSignificance::Score(const FTransform& Viewpoint, const FVector& Location, float BoundsRadius, float Relevance)
+{
+    const FVector ToLandmark = Location - Viewpoint.GetLocation();
+    const float Distance = FMath::Max(static_cast<float>(ToLandmark.Size()), BoundsRadius);
+    float Score = BoundsRadius / FMath::Max(Distance, 1.0f);
+
+    if (FVector::DotProduct(ToLandmark, Viewpoint.GetRotation().GetForwardVector()) < 0.0f)
+    {
+        Score *= WorldForgeSignificance::BehindViewScale;
+    }
+
+    return Score * Relevance;
+}
+
+float FWorldForgeSignificance::GetRelevance(EWorldForgeLandmarkType Type, float Militarism, float Prosperity, float Religiosity)
+{
+    switch (Type)
+    {
+    case EWorldForgeLandmarkType::Settlement: return 0.6f + 0.8f * Prosperity;
+    case EWorldForgeLandmarkType::Fortress: return 0.4f + Militarism;
+    case EWorldForgeLandmarkType::Monastery: return 0.4f + Religiosity;
+    case EWorldForgeLandmarkType::Ruin: return 0.3f;
+    default: return 0.2f;
+    }
+}
+
+void FWorldForgeSignificance::AssignTiers(TConstArrayView<float> SortedScores, const FWorldForgeSignificanceSettings& Settings,
+                                          TArray<EWorldForgeSignificanceTier>& OutTiers, int32 OutCounts[NumTiers])
+{
+    FMemory::Memzero(OutCounts, sizeof(int32) * NumTiers);
+    OutTiers.SetNumUninitialized(SortedScores.Num());
+
+    int32 High = 0;
+    int32 Medium = 0;
+    for (int32 Index = 0; Index < SortedScores.Num(); ++Index)
+    {
+        const float Score = SortedScores[Index];
+        EWorldForgeSignificanceTier Tier = EWorldForgeSignificanceTier::Dormant;
+
+        // Over budget, a landmark falls through to the next tier it qualifies for
+        if (Score >= Settings.HighThreshold && High < Settings.MaxHigh)
+        {
+            Tier = EWorldForgeSignificanceTier::High;
+            ++High;
+        }
+        else if (Score >= Settings.MediumThreshold && Medium < Settings.MaxMedium)
+        {
+            Tier = EWorldForgeSignificanceTier::Medium;
+            ++Medium;
+        }
+        else if (Score >= Settings.LowThreshold)
+        {
+            Tier = EWorldForgeSignificanceTier::Low;
+        }
+
+        OutTiers[Index] = Tier;
+        ++OutCounts[static_cast<int32>(Tier)];
+    }
+}
+
+void FWorldForgeSignificance::SetStats(const int32 Counts[NumTiers])
+{
+    SET_DWORD_STAT(STAT_WorldForgeSignificanceHigh, Counts[0]);
+    SET_DWORD_STAT(STAT_WorldForgeSignificanceMedium, Counts[1]);
+    SET_DWORD_STAT(STAT_WorldForgeSignificanceLow, Counts[2]);
+    SET_DWORD_STAT(STAT_WorldForgeSignificanceDormant, Counts[3]);
+}
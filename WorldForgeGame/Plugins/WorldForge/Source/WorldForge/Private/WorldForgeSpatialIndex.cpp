@@ -0,0 +1,140 @@
+#include "WorldForgeSpatialIndex.h"
+#include "Algo/Sort.h"
+
+FWorldForgeSpatialIndex::FWorldForgeSpatialIndex(float InCellSize)
+    : CellSize(FMath::Max(InCellSize, 1.0f))
+{
+}
+
+FIntPoint FWorldForgeSpatialIndex::GetCell(const FVector& Location) const
+{
+    return FIntPoint(
+        FMath::FloorToInt32(Location.X / CellSize),
+        FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+template <typename FunctorType>
+void FWorldForgeSpatialIndex::ForEachInSquare(const FVector& Location, float HalfExtent, FunctorType&& Functor) const
+{
+    const FIntPoint MinCell = GetCell(Location - FVector(HalfExtent, HalfExtent, 0.0f));
+    const FIntPoint MaxCell = GetCell(Location + FVector(HalfExtent, HalfExtent, 0.0f));
+
+    // Very large queries touch fewer map entries by walking the occupied cells instead
+    const int64 NumQueryCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+    if (NumQueryCells > Cells.Num())
+    {
+        for (const auto& Pair : Cells)
+        {
+            if (Pair.Key.X >= MinCell.X && Pair.Key.X <= MaxCell.X && Pair.Key.Y >= MinCell.Y && Pair.Key.Y <= MaxCell.Y)
+            {
+                for (const FWorldForgeSpatialEntry& Entry : Pair.Value)
+                {
+                    Functor(Entry);
+                }
+            }
+        }
+        return;
+    }
+
+    for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+    {
+        for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+        {
+            if (const TArray<FWorldForgeSpatialEntry>* Entries = Cells.Find(FIntPoint(X, Y)))
+            {
+                for (const FWorldForgeSpatialEntry& Entry : *Entries)
+                {
+                    Functor(Entry);
+                }
+            }
+        }
+    }
+}
+
+void FWorldForgeSpatialIndex::Add(const FWorldForgeLandmark& Landmark)
+{
+    Remove(Landmark.Id);
+
+    const FIntPoint Cell = GetCell(Landmark.Location);
+    FWorldForgeSpatialEntry& Entry = Cells.FindOrAdd(Cell).AddDefaulted_GetRef();
+    Entry.Id = Landmark.Id;
+    Entry.Name = Landmark.Name;
+    Entry.Type = Landmark.Type;
+    Entry.Location = Landmark.Location;
+
+    IdToCell.Add(Landmark.Id, Cell);
+}
+
+bool FWorldForgeSpatialIndex::Remove(const FString& LandmarkId)
+{
+    FIntPoint Cell;
+    if (!IdToCell.RemoveAndCopyValue(LandmarkId, Cell))
+    {
+        return false;
+    }
+
+    if (TArray<FWorldForgeSpatialEntry>* Entries = Cells.Find(Cell))
+    {
+        Entries->RemoveAllSwap([&LandmarkId](const FWorldForgeSpatialEntry& Entry) {
+            return Entry.Id == LandmarkId;
+        });
+        if (Entries->Num() == 0)
+        {
+            Cells.Remove(Cell);
+        }
+    }
+    return true;
+}
+
+void FWorldForgeSpatialIndex::Clear()
+{
+    Cells.Empty();
+    IdToCell.Empty();
+}
+
+bool FWorldForgeSpatialIndex::HasAnyWithin(const FVector& Location, float Radius) const
+{
+    const float RadiusSq = FMath::Square(Radius);
+    bool bFound = false;
+    ForEachInSquare(Location, Radius, [&](const FWorldForgeSpatialEntry& Entry)
+    {
+        if (!bFound && FVector::DistSquared(Location, Entry.Location) < RadiusSq)
+        {
+            bFound = true;
+        }
+    });
+    return bFound;
+}
+
+void FWorldForgeSpatialIndex::QueryRadius(const FVector& Location, float Radius, TArray<const FWorldForgeSpatialEntry*>& OutEntries) const
+{
+    const float RadiusSq = FMath::Square(Radius);
+    ForEachInSquare(Location, Radius, [&](const FWorldForgeSpatialEntry& Entry)
+    {
+        if (FVector::DistSquared(Location, Entry.Location) <= RadiusSq)
+        {
+            OutEntries.Add(&Entry);
+        }
+    });
+}
+
+void FWorldForgeSpatialIndex::FindNearest(const FVector& Location, int32 MaxCount, float MaxDistance, TArray<const FWorldForgeSpatialEntry*>& OutEntries) const
+{
+    if (MaxCount <= 0)
+    {
+        return;
+    }
+
+    TArray<const FWorldForgeSpatialEntry*> Candidates;
+    QueryRadius(Location, MaxDistance, Candidates);
+
+    Algo::Sort(Candidates, [&Location](const FWorldForgeSpatialEntry* A, const FWorldForgeSpatialEntry* B) {
+        return FVector::DistSquared(Location, A->Location) < FVector::DistSquared(Location, B->Location);
+    });
+    if (Candidates.Num() > MaxCount)
+    {
+        Candidates.SetNum(MaxCount);
+    }
+
+    OutEntries.Append(Candidates);
+}
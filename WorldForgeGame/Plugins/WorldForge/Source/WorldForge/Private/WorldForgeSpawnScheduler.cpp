@@ -0,0 +1,107 @@
+#include "WorldForgeSpawnScheduler.h"
+#include "HAL/PlatformTime.h"
+
+void FWorldForgeSpawnScheduler::Enqueue(const FWorldForgeLandmark& Landmark, bool bNeedsPlacement)
+{
+    if (PendingIds.Contains(Landmark.Id))
+    {
+        return;
+    }
+
+    if (Pending.Num() == 0)
+    {
+        // Starting a new burst
+        BurstCompleted = 0;
+        BurstTotal = 0;
+    }
+
+    FPendingLandmark& Entry = Pending.AddDefaulted_GetRef();
+    Entry.Landmark = Landmark;
+    Entry.bNeedsPlacement = bNeedsPlacement;
+    Entry.Sequence = NextSequence++;
+    PendingIds.Add(Landmark.Id);
+
+    ++BurstTotal;
+    bNeedsSort = true;
+}
+
+bool FWorldForgeSpawnScheduler::Remove(const FString& LandmarkId, FWorldForgeLandmark* OutLandmark)
+{
+    if (!PendingIds.Remove(LandmarkId))
+    {
+        return false;
+    }
+
+    // RemoveAt keeps the relative order, so the queue stays sorted
+    const int32 Index = Pending.IndexOfByPredicate([&LandmarkId](const FPendingLandmark& Entry) {
+        return Entry.Landmark.Id == LandmarkId;
+    });
+    if (OutLandmark)
+    {
+        *OutLandmark = MoveTemp(Pending[Index].Landmark);
+    }
+    Pending.RemoveAt(Index, 1, EAllowShrinking::No);
+    --BurstTotal;
+    return true;
+}
+
+void FWorldForgeSpawnScheduler::Clear()
+{
+    Pending.Empty();
+    PendingIds.Empty();
+    BurstCompleted = 0;
+    BurstTotal = 0;
+    bNeedsSort = false;
+}
+
+int32 FWorldForgeSpawnScheduler::Process(const FVector& FocusLocation, double BudgetSeconds,
+                                         TFunctionRef<void(FWorldForgeLandmark& Landmark, bool bNeedsPlacement)> SpawnFunc)
+{
+    if (Pending.Num() == 0)
+    {
+        return 0;
+    }
+
+    if (bNeedsSort || FVector::DistSquared(FocusLocation, LastSortFocus) > FMath::Square(ResortDistance))
+    {
+        SortByDistance(FocusLocation);
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    int32 NumProcessed = 0;
+
+    do
+    {
+        FPendingLandmark Entry = Pending.Pop(EAllowShrinking::No);
+        PendingIds.Remove(Entry.Landmark.Id);
+
+        SpawnFunc(Entry.Landmark, Entry.bNeedsPlacement);
+        ++NumProcessed;
+        ++BurstCompleted;
+    }
+    while (Pending.Num() > 0 && (FPlatformTime::Seconds() - StartTime) < BudgetSeconds);
+
+    if (Pending.Num() == 0)
+    {
+        Pending.Shrink();
+    }
+    return NumProcessed;
+}
+
+void FWorldForgeSpawnScheduler::SortByDistance(const FVector& FocusLocation)
+{
+    // Landmarks that still need placement will be placed around the player, so treat them as nearest
+    auto DistanceKey = [&FocusLocation](const FPendingLandmark& Entry)
+    {
+        return Entry.bNeedsPlacement ? 0.0 : FVector::DistSquared(FocusLocation, Entry.Landmark.Location);
+    };
+
+    Pending.Sort([&DistanceKey](const FPendingLandmark& A, const FPendingLandmark& B) {
+        const double KeyA = DistanceKey(A);
+        const double KeyB = DistanceKey(B);
+        return KeyA != KeyB ? KeyA > KeyB : A.Sequence > B.Sequence;
+    });
+
+    LastSortFocus = FocusLocation;
+    bNeedsSort = false;
+}
@@ -0,0 +1,111 @@
+#include "WorldForgeSpeculation.h"
+#include "WorldForgeHeightCache.h"
+#include "WorldForgeHydrology.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+
+FWorldForgeSpeculation::FWorldForgeSpeculation(const FString& InDilemmaId, TArray<FWorldForgeOutcome>&& InOutcomes,
+                                               TArray<TArray<FWorldForgeOutcomeScatterCell>>&& InScatterCells, uint32 InRevision,
+                                               TSharedPtr<const FWorldForgeHeightCache, ESPMode::ThreadSafe> InHeights,
+                                               TSharedPtr<const FWorldForgeWaterMap, ESPMode::ThreadSafe> InWater)
+    : DilemmaId(InDilemmaId)
+    , Outcomes(MoveTemp(InOutcomes))
+    , Revision(InRevision)
+    , Heights(MoveTemp(InHeights))
+    , Water(MoveTemp(InWater))
+{
+    check(InScatterCells.Num() == Outcomes.Num());
+    Contents.SetNum(Outcomes.Num());
+    for (int32 Outcome = 0; Outcome < Outcomes.Num(); ++Outcome)
+    {
+        Contents[Outcome].ScatterCells = MoveTemp(InScatterCells[Outcome]);
+    }
+}
+
+void FWorldForgeSpeculation::Run()
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Layouts of every outcome's landmarks, flattened so both outcomes share the workers
+    struct FLayoutJob
+    {
+        int32 Outcome;
+        int32 Landmark;
+        FWorldForgeOutcomeContent::FLayout Result;
+    };
+    TArray<FLayoutJob> LayoutJobs;
+    for (int32 Outcome = 0; Outcome < Outcomes.Num(); ++Outcome)
+    {
+        FWorldForgeScatter::MakeLayers(Outcomes[Outcome].State, Contents[Outcome].ScatterLayers);
+        for (int32 Landmark = 0; Landmark < Outcomes[Outcome].Landmarks.Num(); ++Landmark)
+        {
+            LayoutJobs.Add({ Outcome, Landmark, {} });
+        }
+    }
+
+    ParallelFor(LayoutJobs.Num(), [this, &LayoutJobs](int32 Index)
+    {
+        if (bCancelRequested)
+        {
+            return;
+        }
+        FLayoutJob& Job = LayoutJobs[Index];
+        const FWorldForgeOutcome& Outcome = Outcomes[Job.Outcome];
+        Job.Result.Params = FWorldForgeLayoutParams::FromLandmark(Outcome.Landmarks[Job.Landmark], Outcome.State);
+        Job.Result.Layout = FWorldForgeLayoutGenerator::Generate(Job.Result.Params);
+    });
+
+    for (FLayoutJob& Job : LayoutJobs)
+    {
+        Contents[Job.Outcome].Layouts.Add(Outcomes[Job.Outcome].Landmarks[Job.Landmark].Id, MoveTemp(Job.Result));
+    }
+
+    // Scatter cells, one task per cell and outcome
+    TArray<FWorldForgeOutcomeScatterCell*> Cells;
+    TArray<const TArray<FWorldForgeScatterLayerParams>*> CellLayers;
+    for (FWorldForgeOutcomeContent& Content : Contents)
+    {
+        for (FWorldForgeOutcomeScatterCell& Cell : Content.ScatterCells)
+        {
+            Cells.Add(&Cell);
+            CellLayers.Add(&Content.ScatterLayers);
+        }
+    }
+
+    if (Heights.IsValid() && !bCancelRequested)
+    {
+        ParallelFor(Cells.Num(), [this, &Cells, &CellLayers](int32 Index)
+        {
+            if (bCancelRequested)
+            {
+                return;
+            }
+            FWorldForgeOutcomeScatterCell& Cell = *Cells[Index];
+            const TArray<FWorldForgeScatterLayerParams>& Layers = *CellLayers[Index];
+            Cell.Layers.SetNum(FWorldForgeScatter::NumLayers);
+            for (int32 Layer = 0; Layer < Layers.Num(); ++Layer)
+            {
+                if (Cell.LayerMask & (1u << Layer))
+                {
+                    FWorldForgeScatter::GenerateCell(Layers[Layer], Cell.Cell, Cell.Bounds, Cell.Landmarks,
+                                                     *Heights, Water.Get(), Cell.Layers[Layer]);
+                }
+            }
+        });
+    }
+
+    Seconds = FPlatformTime::Seconds() - StartTime;
+    bDone = true;
+}
+
+const FWorldForgeOutcome* FWorldForgeSpeculation::FindOutcome(const FString& Choice) const
+{
+    return Outcomes.FindByPredicate([&Choice](const FWorldForgeOutcome& Outcome) { return Outcome.Choice == Choice; });
+}
+
+FWorldForgeOutcomeContent* FWorldForgeSpeculation::FindContent(const FString& Choice)
+{
+    check(bDone);
+    const int32 Index = Outcomes.IndexOfByPredicate([&Choice](const FWorldForgeOutcome& Outcome) { return Outcome.Choice == Choice; });
+    return Index != INDEX_NONE ? &Contents[Index] : nullptr;
+}
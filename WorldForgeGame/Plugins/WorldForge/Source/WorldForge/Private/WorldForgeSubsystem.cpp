@@ -2,11 +2,410 @@
 #include "WorldForgeWebSocketServer.h"
 #include "WorldForgeDebugWidget.h"
 #include "WorldForgeSettlementActor.h"
+#include "WorldForgeLandmarkInstancer.h"
+#include "WorldForgeMaterialCache.h"
+#include "WorldForgeLabelManager.h"
+#include "WorldForgeLayoutGenerator.h"
+#include "WorldForgeTerrainActor.h"
+#include "WorldForgeTerritoryActor.h"
+#include "WorldForgeRoadActor.h"
+#include "WorldForgeScatterActor.h"
+#include "SignificanceManager.h"
+#include "NavigationSystem.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
 #include "Json.h"
 #include "JsonUtilities.h"
 #include "Blueprint/UserWidget.h"
 #include "TimerManager.h"
 #include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Algo/AnyOf.h"
+
+static TAutoConsoleVariable<int32> CVarLandmarkRenderMode(
+    TEXT("WorldForge.LandmarkRenderMode"),
+    0,
+    TEXT("Default landmark representation: 0 = one actor per landmark, 1 = instanced meshes with actors near the player"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSpawnBudgetMs(
+    TEXT("WorldForge.SpawnBudgetMs"),
+    2.0f,
+    TEXT("Milliseconds per frame spent spawning queued landmarks"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarTerrainResolution(
+    TEXT("WorldForge.TerrainResolution"),
+    129,
+    TEXT("Height samples per side of a terrain tile"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTerrainSampleSpacing(
+    TEXT("WorldForge.TerrainSampleSpacing"),
+    200.0f,
+    TEXT("Distance in Unreal units between terrain height samples"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarTerrainStreaming(
+    TEXT("WorldForge.TerrainStreaming"),
+    0,
+    TEXT("Stream terrain tiles around the player at startup: 0 = off, 1 = on"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarTerrainLoadRadius(
+    TEXT("WorldForge.TerrainLoadRadius"),
+    3,
+    TEXT("Terrain tiles kept loaded in each direction around the player's tile"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarTerrainMaxJobs(
+    TEXT("WorldForge.TerrainMaxJobs"),
+    4,
+    TEXT("Maximum terrain tiles generated on worker threads at once"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTerrainMemoryBudgetMB(
+    TEXT("WorldForge.TerrainMemoryBudgetMB"),
+    256.0f,
+    TEXT("Memory for resident terrain tiles before tiles outside the load radius are evicted"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarShowTerritory(
+    TEXT("WorldForge.ShowTerritory"),
+    1,
+    TEXT("Draw landmark territory borders and contested zones: 0 = off, 1 = on"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarTerritoryResolution(
+    TEXT("WorldForge.TerritoryResolution"),
+    512,
+    TEXT("Cells per side of the territory grid centered on the origin"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTerritoryCellSize(
+    TEXT("WorldForge.TerritoryCellSize"),
+    100.0f,
+    TEXT("Size in Unreal units of a territory grid cell"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarParameterRulesPerTick(
+    TEXT("WorldForge.ParameterRulesPerTick"),
+    32,
+    TEXT("Maximum trait-derived parameter rules re-evaluated per frame; the rest wait for the next frame"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarScatter(
+    TEXT("WorldForge.Scatter"),
+    1,
+    TEXT("Scatter vegetation and props over the generated terrain: 0 = off, 1 = on"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarScatterResolution(
+    TEXT("WorldForge.ScatterResolution"),
+    16,
+    TEXT("Cells per side of the scatter grid centered on the origin"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarScatterCellSize(
+    TEXT("WorldForge.ScatterCellSize"),
+    12800.0f,
+    TEXT("Size in Unreal units of a scatter cell; each cell has its own instanced components per layer"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarScatterCellsPerTick(
+    TEXT("WorldForge.ScatterCellsPerTick"),
+    16,
+    TEXT("Maximum scatter cells handed to worker threads per frame, nearest the player first"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarTraitTransitionSeconds(
+    TEXT("WorldForge.TraitTransitionSeconds"),
+    1.0f,
+    TEXT("Seconds smoothed trait values take to reach a new trait value; 0 snaps"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAtmosphereTransitionSeconds(
+    TEXT("WorldForge.AtmosphereTransitionSeconds"),
+    3.0f,
+    TEXT("Seconds an atmosphere change takes to cross-fade to the new preset; 0 snaps"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarTransitionEasing(
+    TEXT("WorldForge.TransitionEasing"),
+    -1,
+    TEXT("Easing of trait and atmosphere transitions: -1 = defaults (smooth step traits, cubic atmosphere), 0 = linear, 1 = smooth step, 2 = cubic in-out, 3 = quadratic out"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarEconomy(
+    TEXT("WorldForge.Economy"),
+    1,
+    TEXT("Simulate settlement population, production and trade: 0 = paused, 1 = running"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarEconomyRate(
+    TEXT("WorldForge.EconomyRate"),
+    10.0f,
+    TEXT("Economy simulation steps per second; the step is fixed, so results do not depend on frame rate"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarEconomyMaxStepsPerTick(
+    TEXT("WorldForge.EconomyMaxStepsPerTick"),
+    2,
+    TEXT("Maximum economy steps run in one frame; simulated time beyond that is dropped after a hitch"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSignificance(
+    TEXT("WorldForge.Significance"),
+    1,
+    TEXT("Throttle landmark actor detail and crowd updates by significance (0 = every actor at full detail)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceInterval(
+    TEXT("WorldForge.SignificanceInterval"),
+    0.1f,
+    TEXT("Seconds between significance passes"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSignificanceMaxHigh(
+    TEXT("WorldForge.SignificanceMaxHigh"),
+    8,
+    TEXT("Maximum landmark actors at full detail; the next most significant drop to Medium"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSignificanceMaxMedium(
+    TEXT("WorldForge.SignificanceMaxMedium"),
+    32,
+    TEXT("Maximum landmark actors at Medium detail; the next most significant drop to Low"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarNavBatching(
+    TEXT("WorldForge.NavBatching"),
+    1,
+    TEXT("Hold navmesh rebuilds while landmarks are spawning and rebuild the merged dirty tiles afterwards (0 = let every spawn dirty the navmesh)"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNavSettleSeconds(
+    TEXT("WorldForge.NavSettleSeconds"),
+    0.5f,
+    TEXT("Seconds without landmark spawns or removals before batched navmesh tiles are rebuilt"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNavMaxDeferSeconds(
+    TEXT("WorldForge.NavMaxDeferSeconds"),
+    10.0f,
+    TEXT("Longest navmesh rebuilds are held during a continuous burst before the tiles so far are rebuilt"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPathCacheSize(
+    TEXT("WorldForge.PathCacheSize"),
+    4096,
+    TEXT("Landmark-to-landmark paths kept cached; the least recently used are dropped beyond this"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarOutcomeScatterCells(
+    TEXT("WorldForge.OutcomeScatterCells"),
+    64,
+    TEXT("Cells nearest the player pre-generated per prepared outcome for the scatter layers its traits change"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarUndoMaxSteps(
+    TEXT("WorldForge.UndoMaxSteps"),
+    100,
+    TEXT("World-building commands kept for undo; the oldest are dropped beyond this"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarUndoMemoryKB(
+    TEXT("WorldForge.UndoMemoryKB"),
+    4096,
+    TEXT("Memory the undo history may hold in KB; the oldest steps are dropped beyond this"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarReplicaMaxTombstones(
+    TEXT("WorldForge.ReplicaMaxTombstones"),
+    65536,
+    TEXT("Removed landmark tags kept while a session lags; the oldest are dropped beyond this"),
+    ECVF_Default);
+
+namespace WorldForgeCommands
+{
+    FWorldForgeLandmark ParseLandmark(const FJsonObject& Object)
+    {
+        FWorldForgeLandmark Landmark;
+        Object.TryGetStringField(TEXT("id"), Landmark.Id);
+        Object.TryGetStringField(TEXT("name"), Landmark.Name);
+        Object.TryGetStringField(TEXT("description"), Landmark.Description);
+
+        FString TypeName;
+        if (Object.TryGetStringField(TEXT("type"), TypeName))
+        {
+            if (TypeName == TEXT("settlement")) Landmark.Type = EWorldForgeLandmarkType::Settlement;
+            else if (TypeName == TEXT("fortress")) Landmark.Type = EWorldForgeLandmarkType::Fortress;
+            else if (TypeName == TEXT("monastery")) Landmark.Type = EWorldForgeLandmarkType::Monastery;
+            else if (TypeName == TEXT("ruin")) Landmark.Type = EWorldForgeLandmarkType::Ruin;
+            else if (TypeName == TEXT("natural")) Landmark.Type = EWorldForgeLandmarkType::Natural;
+        }
+        return Landmark;
+    }
+
+    /** Overwrite the traits present in a traits object */
+    void ParseTraits(const FJsonObject& Object, FWorldForgeState& State)
+    {
+        double Value;
+        if (Object.TryGetNumberField(TEXT("militarism"), Value))
+            State.Militarism = static_cast<float>(Value);
+        if (Object.TryGetNumberField(TEXT("prosperity"), Value))
+            State.Prosperity = static_cast<float>(Value);
+        if (Object.TryGetNumberField(TEXT("religiosity"), Value))
+            State.Religiosity = static_cast<float>(Value);
+        if (Object.TryGetNumberField(TEXT("lawfulness"), Value))
+            State.Lawfulness = static_cast<float>(Value);
+        if (Object.TryGetNumberField(TEXT("openness"), Value))
+            State.Openness = static_cast<float>(Value);
+    }
+
+    bool ParseTrait(const FString& Name, EWorldForgeTrait& OutTrait)
+    {
+        if (Name == TEXT("militarism")) OutTrait = EWorldForgeTrait::Militarism;
+        else if (Name == TEXT("prosperity")) OutTrait = EWorldForgeTrait::Prosperity;
+        else if (Name == TEXT("religiosity")) OutTrait = EWorldForgeTrait::Religiosity;
+        else if (Name == TEXT("lawfulness")) OutTrait = EWorldForgeTrait::Lawfulness;
+        else if (Name == TEXT("openness")) OutTrait = EWorldForgeTrait::Openness;
+        else return false;
+        return true;
+    }
+
+    bool ParseAtmosphere(const FString& Name, EWorldForgeAtmosphere& OutAtmosphere)
+    {
+        if (Name == TEXT("war_torn")) OutAtmosphere = EWorldForgeAtmosphere::WarTorn;
+        else if (Name == TEXT("prosperous")) OutAtmosphere = EWorldForgeAtmosphere::Prosperous;
+        else if (Name == TEXT("mysterious")) OutAtmosphere = EWorldForgeAtmosphere::Mysterious;
+        else if (Name == TEXT("sacred")) OutAtmosphere = EWorldForgeAtmosphere::Sacred;
+        else if (Name == TEXT("desolate")) OutAtmosphere = EWorldForgeAtmosphere::Desolate;
+        else if (Name == TEXT("vibrant")) OutAtmosphere = EWorldForgeAtmosphere::Vibrant;
+        else return false;
+        return true;
+    }
+
+    const TCHAR* GetTraitName(EWorldForgeTrait Trait)
+    {
+        static const TCHAR* Names[] = { TEXT("militarism"), TEXT("prosperity"), TEXT("religiosity"), TEXT("lawfulness"), TEXT("openness") };
+        return Names[static_cast<int32>(Trait)];
+    }
+
+    const TCHAR* GetAtmosphereName(EWorldForgeAtmosphere Atmosphere)
+    {
+        static const TCHAR* Names[] = { TEXT("war_torn"), TEXT("prosperous"), TEXT("mysterious"), TEXT("sacred"), TEXT("desolate"), TEXT("vibrant") };
+        return Names[static_cast<int32>(Atmosphere)];
+    }
+
+    const TCHAR* GetLandmarkTypeName(EWorldForgeLandmarkType Type)
+    {
+        static const TCHAR* Names[] = { TEXT("settlement"), TEXT("fortress"), TEXT("monastery"), TEXT("ruin"), TEXT("natural") };
+        return Names[static_cast<int32>(Type)];
+    }
+
+    /** A hybrid logical clock stamp: {"wall":ms,"counter":n,"node":id} */
+    bool ParseStamp(const FJsonObject& Object, FWorldForgeHlc& OutStamp)
+    {
+        double Wall = 0.0;
+        double Counter = 0.0;
+        double Node = 0.0;
+        if (!Object.TryGetNumberField(TEXT("wall"), Wall) || !Object.TryGetNumberField(TEXT("counter"), Counter)
+            || !Object.TryGetNumberField(TEXT("node"), Node))
+        {
+            return false;
+        }
+        OutStamp.Wall = static_cast<int64>(Wall);
+        OutStamp.Counter = static_cast<uint32>(Counter);
+        OutStamp.Node = static_cast<uint32>(Node);
+        return true;
+    }
+
+    TSharedRef<FJsonObject> WriteStamp(const FWorldForgeHlc& Stamp)
+    {
+        TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+        Object->SetNumberField(TEXT("wall"), static_cast<double>(Stamp.Wall));
+        Object->SetNumberField(TEXT("counter"), Stamp.Counter);
+        Object->SetNumberField(TEXT("node"), Stamp.Node);
+        return Object;
+    }
+
+    TSharedRef<FJsonObject> WriteReplicaOp(const FWorldForgeReplicaOp& Op)
+    {
+        TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+        Object->SetObjectField(TEXT("hlc"), WriteStamp(Op.Stamp));
+        switch (Op.Kind)
+        {
+        case EWorldForgeReplicaOpKind::Era:
+        {
+            TSharedRef<FJsonObject> Era = MakeShared<FJsonObject>();
+            Era->SetStringField(TEXT("id"), Op.Era.Id);
+            Era->SetStringField(TEXT("name"), Op.Era.Name);
+            Era->SetStringField(TEXT("period"), Op.Era.Period);
+            Era->SetStringField(TEXT("description"), Op.Era.Description);
+            Object->SetStringField(TEXT("op"), TEXT("era"));
+            Object->SetObjectField(TEXT("era"), Era);
+            break;
+        }
+        case EWorldForgeReplicaOpKind::Seed:
+            Object->SetStringField(TEXT("op"), TEXT("seed"));
+            Object->SetNumberField(TEXT("seed"), Op.Seed);
+            break;
+        case EWorldForgeReplicaOpKind::Trait:
+            Object->SetStringField(TEXT("op"), TEXT("trait"));
+            Object->SetStringField(TEXT("trait"), GetTraitName(Op.Trait));
+            Object->SetNumberField(TEXT("value"), Op.Value);
+            break;
+        case EWorldForgeReplicaOpKind::Atmosphere:
+            Object->SetStringField(TEXT("op"), TEXT("atmosphere"));
+            Object->SetStringField(TEXT("atmosphere"), GetAtmosphereName(Op.Atmosphere));
+            break;
+        case EWorldForgeReplicaOpKind::AddLandmark:
+        {
+            TSharedRef<FJsonObject> Landmark = MakeShared<FJsonObject>();
+            Landmark->SetStringField(TEXT("id"), Op.Landmark.Id);
+            Landmark->SetStringField(TEXT("name"), Op.Landmark.Name);
+            Landmark->SetStringField(TEXT("type"), GetLandmarkTypeName(Op.Landmark.Type));
+            Landmark->SetStringField(TEXT("description"), Op.Landmark.Description);
+            Object->SetStringField(TEXT("op"), TEXT("add"));
+            Object->SetObjectField(TEXT("landmark"), Landmark);
+            break;
+        }
+        case EWorldForgeReplicaOpKind::RemoveLandmark:
+        {
+            TArray<TSharedPtr<FJsonValue>> Tags;
+            for (const FWorldForgeHlc& Tag : Op.Tags)
+            {
+                Tags.Add(MakeShared<FJsonValueObject>(WriteStamp(Tag)));
+            }
+            Object->SetStringField(TEXT("op"), TEXT("remove"));
+            Object->SetStringField(TEXT("id"), Op.Landmark.Id);
+            Object->SetArrayField(TEXT("tags"), Tags);
+            break;
+        }
+        }
+        return Object;
+    }
+
+    /** The edit that writes a field change's new value */
+    FWorldForgeReplicaOp MakeFieldOp(const FWorldForgeUndoFieldChange& Change, const FWorldForgeHlc& Stamp)
+    {
+        switch (Change.Field)
+        {
+        case EWorldForgeUndoField::Era:
+            return FWorldForgeReplica::MakeEra(Change.NewEra, Stamp);
+        case EWorldForgeUndoField::Seed:
+            return FWorldForgeReplica::MakeSeed(Change.NewSeed, Stamp);
+        case EWorldForgeUndoField::Atmosphere:
+            return FWorldForgeReplica::MakeAtmosphere(Change.NewAtmosphere, Stamp);
+        default:
+            return FWorldForgeReplica::MakeTrait(Change.Trait, Change.NewValue, Stamp);
+        }
+    }
+}
 
 void UWorldForgeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -17,6 +416,21 @@ void UWorldForgeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     WebSocketServer = NewObject<UWorldForgeWebSocketServer>(this);
     WebSocketServer->Initialize(this);
 
+    MaterialCache = NewObject<UWorldForgeMaterialCache>(this);
+
+    InitializeParameters();
+    Transitions.Reset(WorldState);
+    Replica.Reset(WorldState, TickReplicaClock());
+
+    LandmarkRenderMode = CVarLandmarkRenderMode.GetValueOnGameThread() == 1
+        ? EWorldForgeLandmarkRenderMode::Instanced
+        : EWorldForgeLandmarkRenderMode::Actors;
+
+    if (CVarTerrainStreaming.GetValueOnGameThread() != 0)
+    {
+        SetTerrainStreamingEnabled(true);
+    }
+
     // Auto-start server in development
 #if WITH_EDITOR
     StartServer();
@@ -31,6 +445,7 @@ void UWorldForgeSubsystem::Deinitialize()
     bWantsDebugWidget = false;
     HideDebugWidget();
     StopServer();
+    DiscardOutcomes();
 
     if (WebSocketServer)
     {
@@ -50,6 +465,70 @@ void UWorldForgeSubsystem::Tick(float DeltaTime)
         UE_LOG(LogTemp, Log, TEXT("WorldForge: Tick - attempting to show debug widget"));
         ShowDebugWidget();
     }
+
+    if (SpawnScheduler.HasPending())
+    {
+        ProcessSpawnQueue();
+    }
+
+    if (LandmarkRenderMode == EWorldForgeLandmarkRenderMode::Instanced)
+    {
+        PromotionTimer += DeltaTime;
+        if (PromotionTimer >= PromotionInterval)
+        {
+            PromotionTimer = 0.0f;
+            UpdateActorPromotion();
+        }
+    }
+
+    if (bTerrainStreaming)
+    {
+        UpdateTerrainStreaming();
+    }
+
+    UpdateSignificance(DeltaTime);
+
+    // Only the rules downstream of a changed trait are re-evaluated, within a per-frame cap
+    Parameters.SetState(WorldState);
+    if (Parameters.HasPendingEvaluations())
+    {
+        Parameters.Evaluate(FMath::Max(1, CVarParameterRulesPerTick.GetValueOnGameThread()));
+    }
+
+    // Generation reads the target values above; only presentation reads the eased ones
+    RetargetTransitions();
+    Transitions.Advance(DeltaTime);
+
+    UpdateTerritory();
+    UpdateRoads();
+    UpdateScatter();
+    UpdateEconomy(DeltaTime);
+
+    if (HistoryJob.IsValid())
+    {
+        UpdateHistoryProgress();
+    }
+
+    if (NavBatch.HasPending() || bNavBuildLocked || bNavRebuildInFlight)
+    {
+        UpdateNavigation();
+    }
+
+    LabelUpdateTimer += DeltaTime;
+    if (LabelUpdateTimer >= LabelUpdateInterval)
+    {
+        LabelUpdateTimer = 0.0f;
+        UpdateLabels();
+    }
+
+    TombstoneTimer += DeltaTime;
+    if (TombstoneTimer >= TombstoneInterval)
+    {
+        TombstoneTimer = 0.0f;
+        CollectReplicaTombstones();
+    }
+
+    FlushReplicaDelta();
 }
 
 void UWorldForgeSubsystem::StartServer(int32 Port)
@@ -126,7 +605,7 @@ void UWorldForgeSubsystem::ShowDebugWidget()
     if (DebugWidget)
     {
         DebugWidget->AddToViewport(100); // High Z-order to appear on top
-        DebugWidget->UpdateWorldState(WorldState);
+        DebugWidget->UpdateWorldState(GetPublishedState());
         DebugWidget->SetConnectionStatus(IsServerRunning());
         UE_LOG(LogTemp, Log, TEXT("WorldForge: Debug widget created and added to viewport"));
         bWantsDebugWidget = false; // Stop polling
@@ -154,13 +633,52 @@ bool UWorldForgeSubsystem::IsDebugWidgetVisible() const
 
 void UWorldForgeSubsystem::SetWorldState(const FWorldForgeState& NewState)
 {
-    WorldState = NewState;
-    OnWorldStateChanged.Broadcast(WorldState);
+    // Diffed before anything changes, so the landmarks that leave are still found and torn down
+    FWorldForgeLandmarkStore Incoming;
+    for (const FWorldForgeLandmark& Landmark : NewState.Landmarks)
+    {
+        Incoming.Set(Landmark);
+    }
+    FWorldForgeLandmarkDiff Diff;
+    FWorldForgeLandmarkStore::Diff(LandmarkStore, Incoming, Diff);
+
+    // Only the scalars that differ are written; other sessions see them on flush
+    TArray<FWorldForgeUndoFieldChange> Fields;
+    FWorldForgeUndoFieldChange::Diff(FWorldForgeUndoScalars::Make(WorldState), FWorldForgeUndoScalars::Make(NewState), Fields);
+    for (const FWorldForgeUndoFieldChange& Change : Fields)
+    {
+        Change.ApplyTo(WorldState, false);
+    }
+
+    // Landmarks go through the same paths as commands, so actors, indices and the replica follow;
+    // a changed landmark is replaced under its ID
+    for (const FWorldForgeLandmark& Landmark : Diff.Removed)
+    {
+        RemoveLandmarkNoBroadcast(Landmark.Id);
+    }
+    for (const FWorldForgeLandmarkDiff::FChange& Change : Diff.Changed)
+    {
+        RemoveLandmarkNoBroadcast(Change.Before.Id);
+        SpawnScheduler.Remove(Change.After.Id);
+        AddLandmarkNoBroadcast(Change.After);
+    }
+    for (const FWorldForgeLandmark& Landmark : Diff.Added)
+    {
+        SpawnScheduler.Remove(Landmark.Id);
+        AddLandmarkNoBroadcast(Landmark);
+    }
+
+    // Steps recorded against the old landmarks no longer apply
+    UndoHistory.Clear();
+    PendingUndoSteps.Reset();
+
+    RetargetTransitions();
+    OnWorldStateChanged.Broadcast(GetPublishedState());
 
     // Update debug widget if visible
     if (DebugWidget)
     {
-        DebugWidget->UpdateWorldState(WorldState);
+        DebugWidget->UpdateWorldState(GetPublishedState());
     }
 }
 
@@ -172,16 +690,17 @@ float UWorldForgeSubsystem::GetTrait(EWorldForgeTrait Trait) const
 void UWorldForgeSubsystem::SetTrait(EWorldForgeTrait Trait, float Value)
 {
     WorldState.SetTrait(Trait, Value);
-    OnWorldStateChanged.Broadcast(WorldState);
+    RetargetTransitions();
+    OnWorldStateChanged.Broadcast(GetPublishedState());
 
     // Update debug widget if visible
     if (DebugWidget)
     {
-        DebugWidget->UpdateWorldState(WorldState);
+        DebugWidget->UpdateWorldState(GetPublishedState());
     }
 }
 
-void UWorldForgeSubsystem::ProcessCommand(const FString& CommandJson)
+void UWorldForgeSubsystem::ProcessCommand(const FString& CommandJson, int32 SessionId)
 {
     TSharedPtr<FJsonObject> JsonObject;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(CommandJson);
@@ -202,6 +721,36 @@ void UWorldForgeSubsystem::ProcessCommand(const FString& CommandJson)
     UE_LOG(LogTemp, Log, TEXT("WorldForge: Processing command: %s"), *CommandType);
     OnCommandReceived.Broadcast(CommandType, CommandJson);
 
+    // Edits are ordered by the sender's clock, so a stale edit loses to a newer one however late it arrives
+    const TSharedPtr<FJsonObject>* StampObj;
+    if (JsonObject->TryGetObjectField(TEXT("hlc"), StampObj) && WorldForgeCommands::ParseStamp(**StampObj, CommandStamp))
+    {
+        ReplicaClock.Observe(CommandStamp, FWorldForgeHybridClock::GetPhysicalMs());
+    }
+    else
+    {
+        CommandStamp = TickReplicaClock();
+    }
+    if (SessionId != 0)
+    {
+        // A session sends in order, so nothing it stamped earlier is still on its way
+        FWorldForgeHlc& SessionStamp = SessionStamps.FindOrAdd(SessionId);
+        if (SessionStamp < CommandStamp)
+        {
+            SessionStamp = CommandStamp;
+        }
+    }
+
+    // Commands that change the world are recorded for undo
+    const bool bUndoable = CommandType == TEXT("SET_ERA") || CommandType == TEXT("SET_TRAIT")
+        || CommandType == TEXT("SET_ATMOSPHERE") || CommandType == TEXT("SPAWN_SETTLEMENT")
+        || CommandType == TEXT("DESTROY_SETTLEMENT") || CommandType == TEXT("SYNC_WORLD_STATE")
+        || CommandType == TEXT("COMMIT_OUTCOME");
+    if (bUndoable)
+    {
+        BeginUndoStep(CommandType);
+    }
+
     // Route to appropriate handler
     if (CommandType == TEXT("SET_ERA"))
     {
@@ -219,14 +768,48 @@ void UWorldForgeSubsystem::ProcessCommand(const FString& CommandJson)
     {
         HandleSpawnSettlement(JsonObject);
     }
+    else if (CommandType == TEXT("DESTROY_SETTLEMENT"))
+    {
+        HandleDestroySettlement(JsonObject);
+    }
     else if (CommandType == TEXT("SYNC_WORLD_STATE"))
     {
         HandleSyncWorldState(JsonObject);
     }
+    else if (CommandType == TEXT("SIMULATE_HISTORY"))
+    {
+        HandleSimulateHistory(JsonObject);
+    }
+    else if (CommandType == TEXT("CANCEL_HISTORY"))
+    {
+        CancelHistory();
+    }
+    else if (CommandType == TEXT("PREPARE_OUTCOMES"))
+    {
+        HandlePrepareOutcomes(JsonObject);
+    }
+    else if (CommandType == TEXT("COMMIT_OUTCOME"))
+    {
+        HandleCommitOutcome(JsonObject);
+    }
+    else if (CommandType == TEXT("UNDO"))
+    {
+        Undo();
+    }
+    else if (CommandType == TEXT("REDO"))
+    {
+        Redo();
+    }
     else
     {
         UE_LOG(LogTemp, Warning, TEXT("WorldForge: Unknown command type: %s"), *CommandType);
     }
+
+    if (bUndoable)
+    {
+        EndUndoStep();
+    }
+    FlushReplicaDelta(SessionId);
 }
 
 void UWorldForgeSubsystem::HandleSetEra(const TSharedPtr<FJsonObject>& Data)
@@ -240,9 +823,11 @@ void UWorldForgeSubsystem::HandleSetEra(const TSharedPtr<FJsonObject>& Data)
         (*EraObj)->TryGetStringField(TEXT("period"), Era.Period);
         (*EraObj)->TryGetStringField(TEXT("description"), Era.Description);
 
-        WorldState.Era = Era;
-        OnWorldStateChanged.Broadcast(WorldState);
-        UE_LOG(LogTemp, Log, TEXT("WorldForge: Era set to %s"), *Era.Name);
+        if (MergeReplicaOp(FWorldForgeReplica::MakeEra(Era, CommandStamp)))
+        {
+            OnWorldStateChanged.Broadcast(GetPublishedState());
+            UE_LOG(LogTemp, Log, TEXT("WorldForge: Era set to %s"), *Era.Name);
+        }
     }
 }
 
@@ -255,19 +840,18 @@ void UWorldForgeSubsystem::HandleSetTrait(const TSharedPtr<FJsonObject>& Data)
         Data->TryGetNumberField(TEXT("value"), Value))
     {
         EWorldForgeTrait Trait;
-        if (TraitName == TEXT("militarism")) Trait = EWorldForgeTrait::Militarism;
-        else if (TraitName == TEXT("prosperity")) Trait = EWorldForgeTrait::Prosperity;
-        else if (TraitName == TEXT("religiosity")) Trait = EWorldForgeTrait::Religiosity;
-        else if (TraitName == TEXT("lawfulness")) Trait = EWorldForgeTrait::Lawfulness;
-        else if (TraitName == TEXT("openness")) Trait = EWorldForgeTrait::Openness;
-        else
+        if (!WorldForgeCommands::ParseTrait(TraitName, Trait))
         {
             UE_LOG(LogTemp, Warning, TEXT("WorldForge: Unknown trait: %s"), *TraitName);
             return;
         }
 
-        SetTrait(Trait, static_cast<float>(Value));
-        UE_LOG(LogTemp, Log, TEXT("WorldForge: Trait %s set to %f"), *TraitName, Value);
+        if (MergeReplicaOp(FWorldForgeReplica::MakeTrait(Trait, static_cast<float>(Value), CommandStamp)))
+        {
+            RetargetTransitions();
+            BroadcastWorldStateChanged();
+            UE_LOG(LogTemp, Log, TEXT("WorldForge: Trait %s set to %f"), *TraitName, Value);
+        }
     }
 }
 
@@ -277,21 +861,18 @@ void UWorldForgeSubsystem::HandleSetAtmosphere(const TSharedPtr<FJsonObject>& Da
     if (Data->TryGetStringField(TEXT("atmosphere"), AtmosphereName))
     {
         EWorldForgeAtmosphere Atmosphere;
-        if (AtmosphereName == TEXT("war_torn")) Atmosphere = EWorldForgeAtmosphere::WarTorn;
-        else if (AtmosphereName == TEXT("prosperous")) Atmosphere = EWorldForgeAtmosphere::Prosperous;
-        else if (AtmosphereName == TEXT("mysterious")) Atmosphere = EWorldForgeAtmosphere::Mysterious;
-        else if (AtmosphereName == TEXT("sacred")) Atmosphere = EWorldForgeAtmosphere::Sacred;
-        else if (AtmosphereName == TEXT("desolate")) Atmosphere = EWorldForgeAtmosphere::Desolate;
-        else if (AtmosphereName == TEXT("vibrant")) Atmosphere = EWorldForgeAtmosphere::Vibrant;
-        else
+        if (!WorldForgeCommands::ParseAtmosphere(AtmosphereName, Atmosphere))
         {
             UE_LOG(LogTemp, Warning, TEXT("WorldForge: Unknown atmosphere: %s"), *AtmosphereName);
             return;
         }
 
-        WorldState.Atmosphere = Atmosphere;
-        OnWorldStateChanged.Broadcast(WorldState);
-        UE_LOG(LogTemp, Log, TEXT("WorldForge: Atmosphere set to %s"), *AtmosphereName);
+        if (MergeReplicaOp(FWorldForgeReplica::MakeAtmosphere(Atmosphere, CommandStamp)))
+        {
+            RetargetTransitions();
+            OnWorldStateChanged.Broadcast(GetPublishedState());
+            UE_LOG(LogTemp, Log, TEXT("WorldForge: Atmosphere set to %s"), *AtmosphereName);
+        }
     }
 }
 
@@ -304,49 +885,37 @@ void UWorldForgeSubsystem::HandleSpawnSettlement(const TSharedPtr<FJsonObject>&
         return;
     }
 
-    FWorldForgeLandmark Landmark;
-    (*SettlementObj)->TryGetStringField(TEXT("id"), Landmark.Id);
-    (*SettlementObj)->TryGetStringField(TEXT("name"), Landmark.Name);
-    (*SettlementObj)->TryGetStringField(TEXT("description"), Landmark.Description);
-
-    FString TypeName;
-    if ((*SettlementObj)->TryGetStringField(TEXT("type"), TypeName))
-    {
-        if (TypeName == TEXT("settlement")) Landmark.Type = EWorldForgeLandmarkType::Settlement;
-        else if (TypeName == TEXT("fortress")) Landmark.Type = EWorldForgeLandmarkType::Fortress;
-        else if (TypeName == TEXT("monastery")) Landmark.Type = EWorldForgeLandmarkType::Monastery;
-        else if (TypeName == TEXT("ruin")) Landmark.Type = EWorldForgeLandmarkType::Ruin;
-        else if (TypeName == TEXT("natural")) Landmark.Type = EWorldForgeLandmarkType::Natural;
-    }
+    const FWorldForgeLandmark Landmark = WorldForgeCommands::ParseLandmark(**SettlementObj);
 
     // Check for duplicate
-    if (SpawnedActors.Contains(Landmark.Id))
+    if (ContainsLandmark(Landmark.Id) || SpawnScheduler.Contains(Landmark.Id))
     {
         UE_LOG(LogTemp, Warning, TEXT("WorldForge: Settlement '%s' already exists, skipping"), *Landmark.Id);
         return;
     }
 
-    // Find spawn location
-    Landmark.Location = FindValidSpawnLocation();
-
-    // Add to world state
-    WorldState.Landmarks.Add(Landmark);
-
-    // Spawn the actor
-    AWorldForgeSettlementActor* SpawnedActor = SpawnSettlementActor(Landmark);
-    if (SpawnedActor)
+    // Placement and spawning happen in Tick within the per-frame spawn budget
+    if (MergeReplicaOp(FWorldForgeReplica::MakeAdd(Landmark, CommandStamp)) && SpawnScheduler.Contains(Landmark.Id))
     {
-        SpawnedActors.Add(Landmark.Id, SpawnedActor);
-        UE_LOG(LogTemp, Log, TEXT("WorldForge: Spawned settlement '%s' at %s"),
-               *Landmark.Name, *Landmark.Location.ToString());
+        UE_LOG(LogTemp, Log, TEXT("WorldForge: Queued settlement '%s' (%d pending)"),
+               *Landmark.Name, SpawnScheduler.GetPendingCount());
     }
+}
 
-    OnWorldStateChanged.Broadcast(WorldState);
+void UWorldForgeSubsystem::HandleDestroySettlement(const TSharedPtr<FJsonObject>& Data)
+{
+    FString LandmarkId;
+    if (!Data->TryGetStringField(TEXT("settlementId"), LandmarkId))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldForge: DESTROY_SETTLEMENT missing settlementId"));
+        return;
+    }
 
-    // Update debug widget
-    if (DebugWidget)
+    // Removes the adds the sender could have seen; one made concurrently elsewhere survives
+    if (MergeReplicaOp(Replica.MakeRemove(LandmarkId, CommandStamp)))
     {
-        DebugWidget->UpdateWorldState(WorldState);
+        BroadcastWorldStateChanged();
+        UE_LOG(LogTemp, Log, TEXT("WorldForge: Destroyed settlement '%s'"), *LandmarkId);
     }
 }
 
@@ -355,58 +924,193 @@ void UWorldForgeSubsystem::HandleSyncWorldState(const TSharedPtr<FJsonObject>& D
     const TSharedPtr<FJsonObject>* StateObj;
     if (Data->TryGetObjectField(TEXT("state"), StateObj))
     {
+        // Each field is merged on its own, so a full-state sync only overwrites fields no one has written since
+        int32 NumMerged = 0;
+
         // Parse era
         const TSharedPtr<FJsonObject>* EraObj;
         if ((*StateObj)->TryGetObjectField(TEXT("era"), EraObj))
         {
-            (*EraObj)->TryGetStringField(TEXT("id"), WorldState.Era.Id);
-            (*EraObj)->TryGetStringField(TEXT("name"), WorldState.Era.Name);
-            (*EraObj)->TryGetStringField(TEXT("period"), WorldState.Era.Period);
-            (*EraObj)->TryGetStringField(TEXT("description"), WorldState.Era.Description);
+            FWorldForgeEra Era = WorldState.Era;
+            (*EraObj)->TryGetStringField(TEXT("id"), Era.Id);
+            (*EraObj)->TryGetStringField(TEXT("name"), Era.Name);
+            (*EraObj)->TryGetStringField(TEXT("period"), Era.Period);
+            (*EraObj)->TryGetStringField(TEXT("description"), Era.Description);
+            NumMerged += MergeReplicaOp(FWorldForgeReplica::MakeEra(Era, CommandStamp)) ? 1 : 0;
         }
 
-        // Parse traits
-        const TSharedPtr<FJsonObject>* TraitsObj;
-        if ((*StateObj)->TryGetObjectField(TEXT("traits"), TraitsObj))
+        // Parse seed
+        int32 Seed;
+        if ((*StateObj)->TryGetNumberField(TEXT("seed"), Seed))
+        {
+            NumMerged += MergeReplicaOp(FWorldForgeReplica::MakeSeed(Seed, CommandStamp)) ? 1 : 0;
+        }
+
+        // Parse traits and atmosphere
+        NumMerged += MergeTraitsAndAtmosphere(**StateObj);
+
+        if (NumMerged > 0)
+        {
+            RetargetTransitions();
+            BroadcastWorldStateChanged();
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge: World state synchronized (%d fields merged)"), NumMerged);
+    }
+}
+
+int32 UWorldForgeSubsystem::MergeTraitsAndAtmosphere(const FJsonObject& Object)
+{
+    int32 NumMerged = 0;
+
+    const TSharedPtr<FJsonObject>* TraitsObj;
+    if (Object.TryGetObjectField(TEXT("traits"), TraitsObj))
+    {
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : (*TraitsObj)->Values)
         {
+            EWorldForgeTrait Trait;
             double Value;
-            if ((*TraitsObj)->TryGetNumberField(TEXT("militarism"), Value))
-                WorldState.Militarism = static_cast<float>(Value);
-            if ((*TraitsObj)->TryGetNumberField(TEXT("prosperity"), Value))
-                WorldState.Prosperity = static_cast<float>(Value);
-            if ((*TraitsObj)->TryGetNumberField(TEXT("religiosity"), Value))
-                WorldState.Religiosity = static_cast<float>(Value);
-            if ((*TraitsObj)->TryGetNumberField(TEXT("lawfulness"), Value))
-                WorldState.Lawfulness = static_cast<float>(Value);
-            if ((*TraitsObj)->TryGetNumberField(TEXT("openness"), Value))
-                WorldState.Openness = static_cast<float>(Value);
-        }
-
-        // Parse atmosphere
+            if (WorldForgeCommands::ParseTrait(Field.Key, Trait) && Field.Value->TryGetNumber(Value))
+            {
+                NumMerged += MergeReplicaOp(FWorldForgeReplica::MakeTrait(Trait, static_cast<float>(Value), CommandStamp)) ? 1 : 0;
+            }
+        }
+    }
+
+    FString AtmosphereName;
+    EWorldForgeAtmosphere Atmosphere;
+    if (Object.TryGetStringField(TEXT("atmosphere"), AtmosphereName)
+        && WorldForgeCommands::ParseAtmosphere(AtmosphereName, Atmosphere))
+    {
+        NumMerged += MergeReplicaOp(FWorldForgeReplica::MakeAtmosphere(Atmosphere, CommandStamp)) ? 1 : 0;
+    }
+    return NumMerged;
+}
+
+void UWorldForgeSubsystem::HandleSimulateHistory(const TSharedPtr<FJsonObject>& Data)
+{
+    int32 Years = 0;
+    if (!Data->TryGetNumberField(TEXT("years"), Years) || Years <= 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldForge: SIMULATE_HISTORY needs a positive 'years' field"));
+        return;
+    }
+
+    SimulateHistory(Years);
+}
+
+void UWorldForgeSubsystem::HandlePrepareOutcomes(const TSharedPtr<FJsonObject>& Data)
+{
+    FString DilemmaId;
+    const TArray<TSharedPtr<FJsonValue>>* OutcomeValues;
+    if (!Data->TryGetStringField(TEXT("dilemmaId"), DilemmaId) || !Data->TryGetArrayField(TEXT("outcomes"), OutcomeValues))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldForge: PREPARE_OUTCOMES needs 'dilemmaId' and 'outcomes' fields"));
+        return;
+    }
+
+    TArray<FWorldForgeOutcome> Outcomes;
+    for (const TSharedPtr<FJsonValue>& Value : *OutcomeValues)
+    {
+        const TSharedPtr<FJsonObject>* OutcomeObj;
+        if (!Value->TryGetObject(OutcomeObj))
+        {
+            continue;
+        }
+
+        // Each outcome starts from the current world, without copying its landmarks
+        FWorldForgeOutcome& Outcome = Outcomes.AddDefaulted_GetRef();
+        (*OutcomeObj)->TryGetStringField(TEXT("choice"), Outcome.Choice);
+        Outcome.State.Era = WorldState.Era;
+        Outcome.State.Seed = WorldState.Seed;
+        Outcome.State.Militarism = WorldState.Militarism;
+        Outcome.State.Prosperity = WorldState.Prosperity;
+        Outcome.State.Religiosity = WorldState.Religiosity;
+        Outcome.State.Lawfulness = WorldState.Lawfulness;
+        Outcome.State.Openness = WorldState.Openness;
+        Outcome.State.Atmosphere = WorldState.Atmosphere;
+
+        const TSharedPtr<FJsonObject>* TraitsObj;
+        if ((*OutcomeObj)->TryGetObjectField(TEXT("traits"), TraitsObj))
+        {
+            WorldForgeCommands::ParseTraits(**TraitsObj, Outcome.State);
+        }
+
         FString AtmosphereName;
-        if ((*StateObj)->TryGetStringField(TEXT("atmosphere"), AtmosphereName))
+        if ((*OutcomeObj)->TryGetStringField(TEXT("atmosphere"), AtmosphereName))
+        {
+            WorldForgeCommands::ParseAtmosphere(AtmosphereName, Outcome.State.Atmosphere);
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* LandmarkValues;
+        if ((*OutcomeObj)->TryGetArrayField(TEXT("landmarks"), LandmarkValues))
         {
-            if (AtmosphereName == TEXT("war_torn")) WorldState.Atmosphere = EWorldForgeAtmosphere::WarTorn;
-            else if (AtmosphereName == TEXT("prosperous")) WorldState.Atmosphere = EWorldForgeAtmosphere::Prosperous;
-            else if (AtmosphereName == TEXT("mysterious")) WorldState.Atmosphere = EWorldForgeAtmosphere::Mysterious;
-            else if (AtmosphereName == TEXT("sacred")) WorldState.Atmosphere = EWorldForgeAtmosphere::Sacred;
-            else if (AtmosphereName == TEXT("desolate")) WorldState.Atmosphere = EWorldForgeAtmosphere::Desolate;
-            else if (AtmosphereName == TEXT("vibrant")) WorldState.Atmosphere = EWorldForgeAtmosphere::Vibrant;
+            for (const TSharedPtr<FJsonValue>& LandmarkValue : *LandmarkValues)
+            {
+                const TSharedPtr<FJsonObject>* LandmarkObj;
+                if (LandmarkValue->TryGetObject(LandmarkObj))
+                {
+                    Outcome.Landmarks.Add(WorldForgeCommands::ParseLandmark(**LandmarkObj));
+                }
+            }
         }
+    }
 
-        OnWorldStateChanged.Broadcast(WorldState);
+    PrepareOutcomes(DilemmaId, MoveTemp(Outcomes));
+}
 
-        // Update debug widget
-        if (DebugWidget)
+void UWorldForgeSubsystem::HandleCommitOutcome(const TSharedPtr<FJsonObject>& Data)
+{
+    FString DilemmaId;
+    FString Choice;
+    if (!Data->TryGetStringField(TEXT("dilemmaId"), DilemmaId) || !Data->TryGetStringField(TEXT("choice"), Choice))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldForge: COMMIT_OUTCOME needs 'dilemmaId' and 'choice' fields"));
+        return;
+    }
+
+    if (CommitOutcome(DilemmaId, Choice))
+    {
+        return;
+    }
+
+    // The outcomes were discarded or never arrived; the choice is applied as the client sent it, each field
+    // and landmark merged as SET_TRAIT and SPAWN_SETTLEMENT would
+    const int32 NumMerged = MergeTraitsAndAtmosphere(*Data);
+    if (NumMerged > 0)
+    {
+        RetargetTransitions();
+    }
+
+    int32 NumQueued = 0;
+    const TArray<TSharedPtr<FJsonValue>>* LandmarkValues;
+    if (Data->TryGetArrayField(TEXT("landmarks"), LandmarkValues))
+    {
+        for (const TSharedPtr<FJsonValue>& LandmarkValue : *LandmarkValues)
         {
-            DebugWidget->UpdateWorldState(WorldState);
+            const TSharedPtr<FJsonObject>* LandmarkObj;
+            if (!LandmarkValue->TryGetObject(LandmarkObj))
+            {
+                continue;
+            }
+            const FWorldForgeLandmark Landmark = WorldForgeCommands::ParseLandmark(**LandmarkObj);
+            if (!ContainsLandmark(Landmark.Id) && !SpawnScheduler.Contains(Landmark.Id)
+                && MergeReplicaOp(FWorldForgeReplica::MakeAdd(Landmark, CommandStamp)) && SpawnScheduler.Contains(Landmark.Id))
+            {
+                ++NumQueued;
+            }
         }
+    }
 
-        UE_LOG(LogTemp, Log, TEXT("WorldForge: World state synchronized"));
+    if (NumMerged > 0)
+    {
+        BroadcastWorldStateChanged();
     }
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Applied unprepared outcome '%s' of dilemma '%s' (%d fields merged, %d landmarks queued)"),
+           *Choice, *DilemmaId, NumMerged, NumQueued);
 }
 
-FVector UWorldForgeSubsystem::FindValidSpawnLocation()
+FVector UWorldForgeSubsystem::FindValidSpawnLocation(EWorldForgeLandmarkType Type, TConstArrayView<FVector> Reserved)
 {
     UWorld* World = GetWorld();
     if (!World)
@@ -415,7 +1119,7 @@ FVector UWorldForgeSubsystem::FindValidSpawnLocation()
     }
 
     const float HeightOffset = 50.0f; // Slight offset above ground
-    const int32 MaxAttempts = 50;
+    constexpr int32 MaxAttempts = 50;
     const float LocalSpawnRadius = 1000.0f; // Spawn within 10 meters of player
 
     // Try to spawn near the player
@@ -426,36 +1130,57 @@ FVector UWorldForgeSubsystem::FindValidSpawnLocation()
         SpawnCenter = PC->GetPawn()->GetActorLocation();
     }
 
+    // Generate every candidate up front so ground heights come from one batched terrain query
+    TArray<FVector2f, TInlineAllocator<MaxAttempts>> Candidates;
     for (int32 Attempt = 0; Attempt < MaxAttempts; ++Attempt)
     {
-        // Generate random XY within bounds around player/origin
-        FVector TestLocation;
-        TestLocation.X = SpawnCenter.X + FMath::RandRange(-LocalSpawnRadius, LocalSpawnRadius);
-        TestLocation.Y = SpawnCenter.Y + FMath::RandRange(-LocalSpawnRadius, LocalSpawnRadius);
-        TestLocation.Z = SpawnCenter.Z + HeightOffset;
+        Candidates.Emplace(
+            static_cast<float>(SpawnCenter.X + FMath::RandRange(-LocalSpawnRadius, LocalSpawnRadius)),
+            static_cast<float>(SpawnCenter.Y + FMath::RandRange(-LocalSpawnRadius, LocalSpawnRadius)));
+    }
+
+    float GroundHeights[MaxAttempts];
+    bool bOnTerrain[MaxAttempts];
+    HeightCache->QueryHeights(Candidates, MakeArrayView(GroundHeights, MaxAttempts), MakeArrayView(bOnTerrain, MaxAttempts));
+    const bool bHasTerrain = !HeightCache->IsEmpty();
 
-        // Line trace down to find ground
-        FHitResult HitResult;
-        FVector TraceStart = TestLocation + FVector(0, 0, 1000.0f);
-        FVector TraceEnd = TestLocation - FVector(0, 0, 5000.0f);
+    for (int32 Attempt = 0; Attempt < MaxAttempts; ++Attempt)
+    {
+        FVector TestLocation(Candidates[Attempt].X, Candidates[Attempt].Y, SpawnCenter.Z + HeightOffset);
 
-        if (World->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_WorldStatic))
+        if (bOnTerrain[Attempt])
         {
-            TestLocation = HitResult.ImpactPoint + FVector(0, 0, HeightOffset);
+            TestLocation.Z = GroundHeights[Attempt] + HeightOffset;
         }
-
-        // Check minimum distance from existing settlements
-        bool bTooClose = false;
-        for (const auto& Pair : SpawnedActors)
+        else if (!bHasTerrain)
         {
-            if (Pair.Value && FVector::Dist(TestLocation, Pair.Value->GetActorLocation()) < MinimumSpawnDistance)
+            // Levels without generated terrain still need a trace against their own geometry
+            FHitResult HitResult;
+            FVector TraceStart = TestLocation + FVector(0, 0, 1000.0f);
+            FVector TraceEnd = TestLocation - FVector(0, 0, 5000.0f);
+
+            if (World->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_WorldStatic))
             {
-                bTooClose = true;
-                break;
+                TestLocation = HitResult.ImpactPoint + FVector(0, 0, HeightOffset);
             }
         }
 
-        if (!bTooClose)
+        // Natural landmarks (springs, falls, fords) sit on a nearby river when there is one
+        FVector RiverPoint;
+        if (Type == EWorldForgeLandmarkType::Natural && WaterMap->FindNearestRiverPoint(TestLocation, RiverSnapDistance, RiverPoint))
+        {
+            float RiverBed;
+            TestLocation.X = RiverPoint.X;
+            TestLocation.Y = RiverPoint.Y;
+            TestLocation.Z = (HeightCache->QueryHeight(static_cast<float>(RiverPoint.X), static_cast<float>(RiverPoint.Y), RiverBed) ? RiverBed : RiverPoint.Z) + HeightOffset;
+        }
+
+        // Check minimum distance from existing settlements
+        const bool bReserved = Algo::AnyOf(Reserved, [&TestLocation, this](const FVector& Location)
+        {
+            return FVector::DistSquared(Location, TestLocation) < FMath::Square(MinimumSpawnDistance);
+        });
+        if (!bReserved && !SpatialIndex.HasAnyWithin(TestLocation, MinimumSpawnDistance))
         {
             return TestLocation;
         }
@@ -470,6 +1195,11 @@ FVector UWorldForgeSubsystem::FindValidSpawnLocation()
     );
 }
 
+bool UWorldForgeSubsystem::QueryTerrainHeight(const FVector& Location, float& OutHeight, FVector& OutNormal) const
+{
+    return HeightCache->QueryHeightAndNormal(static_cast<float>(Location.X), static_cast<float>(Location.Y), OutHeight, OutNormal);
+}
+
 AWorldForgeSettlementActor* UWorldForgeSubsystem::SpawnSettlementActor(const FWorldForgeLandmark& Landmark)
 {
     UWorld* World = GetWorld();
@@ -501,39 +1231,2044 @@ AWorldForgeSettlementActor* UWorldForgeSubsystem::SpawnSettlementActor(const FWo
     return Actor;
 }
 
-bool UWorldForgeSubsystem::DestroySettlement(const FString& LandmarkId)
+bool UWorldForgeSubsystem::AddLandmark(const FWorldForgeLandmark& Landmark)
+{
+    return AddLandmarks({ Landmark }) > 0;
+}
+
+int32 UWorldForgeSubsystem::AddLandmarks(const TArray<FWorldForgeLandmark>& Landmarks)
 {
-    if (TObjectPtr<AWorldForgeSettlementActor>* ActorPtr = SpawnedActors.Find(LandmarkId))
+    int32 NumAdded = 0;
+    for (const FWorldForgeLandmark& Landmark : Landmarks)
     {
-        if (*ActorPtr)
+        if (AddLandmarkNoBroadcast(Landmark))
         {
-            (*ActorPtr)->Destroy();
+            ++NumAdded;
         }
-        SpawnedActors.Remove(LandmarkId);
-
-        // Remove from world state
-        WorldState.Landmarks.RemoveAll([&LandmarkId](const FWorldForgeLandmark& L) {
-            return L.Id == LandmarkId;
-        });
+    }
 
-        OnWorldStateChanged.Broadcast(WorldState);
-        UE_LOG(LogTemp, Log, TEXT("WorldForge: Destroyed settlement '%s'"), *LandmarkId);
-        return true;
+    // Broadcast once per batch; listeners receive a copy of the full state
+    if (NumAdded > 0)
+    {
+        BroadcastWorldStateChanged();
     }
-    return false;
+    return NumAdded;
 }
 
-void UWorldForgeSubsystem::DestroyAllSettlements()
+void UWorldForgeSubsystem::QueueLandmarks(const TArray<FWorldForgeLandmark>& Landmarks)
 {
-    for (auto& Pair : SpawnedActors)
+    for (const FWorldForgeLandmark& Landmark : Landmarks)
     {
-        if (Pair.Value)
+        if (!ContainsLandmark(Landmark.Id))
         {
-            Pair.Value->Destroy();
+            EnqueueLandmark(Landmark, false);
         }
     }
-    SpawnedActors.Empty();
-    WorldState.Landmarks.Empty();
-    OnWorldStateChanged.Broadcast(WorldState);
+}
+
+void UWorldForgeSubsystem::EnqueueLandmark(const FWorldForgeLandmark& Landmark, bool bNeedsPlacement)
+{
+    SpawnScheduler.Enqueue(Landmark, bNeedsPlacement);
+
+    // Recorded now and completed by AddLandmarkNoBroadcast once placed
+    if (UndoHistory.IsRecording())
+    {
+        UndoHistory.RecordAdded(Landmark, false);
+        PendingUndoSteps.Add(Landmark.Id, UndoHistory.GetOpenSerial());
+    }
+}
+
+bool UWorldForgeSubsystem::CancelQueuedLandmark(const FString& LandmarkId)
+{
+    FWorldForgeLandmark Landmark;
+    if (!SpawnScheduler.Remove(LandmarkId, &Landmark))
+    {
+        return false;
+    }
+
+    uint32 Origin = 0;
+    PendingUndoSteps.RemoveAndCopyValue(LandmarkId, Origin);
+    UndoHistory.RecordCancelled(Origin, Landmark);
+    return true;
+}
+
+bool UWorldForgeSubsystem::AddLandmarkNoBroadcast(const FWorldForgeLandmark& Landmark)
+{
+    if (ContainsLandmark(Landmark.Id))
+    {
+        return false;
+    }
+
+    ++ContentRevision;
+    LandmarkStore.Set(Landmark);
+    SpatialIndex.Add(Landmark);
+    Territory.AddSite(Landmark);
+    Roads.AddSite(Landmark);
+    Economy.AddSettlement(Landmark);
+    MarkScatterAroundLandmark(Landmark);
+    MarkNavigationDirty(Landmark);
+    CreateLandmarkRepresentation(Landmark);
+
+    if (!Replica.ContainsLandmark(Landmark.Id))
+    {
+        RecordReplicaOp(FWorldForgeReplica::MakeAdd(Landmark, TickReplicaClock()));
+    }
+
+    uint32 Serial = 0;
+    if (PendingUndoSteps.RemoveAndCopyValue(Landmark.Id, Serial))
+    {
+        UndoHistory.RecordPlaced(Serial, Landmark);
+    }
+    else
+    {
+        UndoHistory.RecordAdded(Landmark, true);
+    }
+    return true;
+}
+
+const FWorldForgeState& UWorldForgeSubsystem::GetPublishedState() const
+{
+    // The scalars are copied every time; the landmark list only when a landmark was added or removed
+    TArray<FWorldForgeLandmark> Landmarks = MoveTemp(PublishedState.Landmarks);
+    PublishedState = WorldState;
+    PublishedState.Landmarks = MoveTemp(Landmarks);
+    if (PublishedRevision != ContentRevision)
+    {
+        LandmarkStore.ToArray(PublishedState.Landmarks);
+        PublishedRevision = ContentRevision;
+    }
+    return PublishedState;
+}
+
+void UWorldForgeSubsystem::BroadcastWorldStateChanged()
+{
+    OnWorldStateChanged.Broadcast(GetPublishedState());
+
+    // Update debug widget
+    if (DebugWidget)
+    {
+        DebugWidget->UpdateWorldState(GetPublishedState());
+    }
+}
+
+void UWorldForgeSubsystem::ProcessSpawnQueue()
+{
+    const double BudgetSeconds = FMath::Max(0.0f, CVarSpawnBudgetMs.GetValueOnGameThread()) / 1000.0;
+
+    const int32 NumSpawned = SpawnScheduler.Process(GetPlayerLocation(), BudgetSeconds,
+        [this](FWorldForgeLandmark& Landmark, bool bNeedsPlacement)
+        {
+            if (bNeedsPlacement)
+            {
+                Landmark.Location = FindValidSpawnLocation(Landmark.Type);
+            }
+
+            if (AddLandmarkNoBroadcast(Landmark))
+            {
+                UE_LOG(LogTemp, Verbose, TEXT("WorldForge: Spawned settlement '%s' at %s"),
+                       *Landmark.Name, *Landmark.Location.ToString());
+            }
+        });
+
+    if (NumSpawned == 0)
+    {
+        return;
+    }
+
+    BroadcastWorldStateChanged();
+
+    const int32 Completed = SpawnScheduler.GetBurstCompleted();
+    const int32 Total = SpawnScheduler.GetBurstTotal();
+    OnSpawnProgress.Broadcast(Completed, Total);
+
+    if (WebSocketServer)
+    {
+        WebSocketServer->SendMessage(FString::Printf(
+            TEXT("{\"type\":\"SPAWN_PROGRESS\",\"completed\":%d,\"total\":%d,\"pending\":%d}"),
+            Completed, Total, SpawnScheduler.GetPendingCount()));
+    }
+
+    if (!SpawnScheduler.HasPending())
+    {
+        UE_LOG(LogTemp, Log, TEXT("WorldForge: Spawn queue drained (%d landmarks)"), Total);
+    }
+}
+
+FVector UWorldForgeSubsystem::GetPlayerLocation() const
+{
+    UWorld* World = GetWorld();
+    APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+    if (PC && PC->GetPawn())
+    {
+        return PC->GetPawn()->GetActorLocation();
+    }
+    return FVector::ZeroVector;
+}
+
+bool UWorldForgeSubsystem::DestroySettlement(const FString& LandmarkId)
+{
+    if (CancelQueuedLandmark(LandmarkId))
+    {
+        if (Replica.ContainsLandmark(LandmarkId))
+        {
+            RecordReplicaOp(Replica.MakeRemove(LandmarkId, TickReplicaClock()));
+        }
+        UE_LOG(LogTemp, Log, TEXT("WorldForge: Cancelled queued settlement '%s'"), *LandmarkId);
+        return true;
+    }
+
+    if (!RemoveLandmarkNoBroadcast(LandmarkId))
+    {
+        return false;
+    }
+
+    OnWorldStateChanged.Broadcast(GetPublishedState());
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Destroyed settlement '%s'"), *LandmarkId);
+    return true;
+}
+
+bool UWorldForgeSubsystem::RemoveLandmarkNoBroadcast(const FString& LandmarkId)
+{
+    const FWorldForgeLandmark* Landmark = LandmarkStore.Find(LandmarkId);
+    if (!Landmark)
+    {
+        return false;
+    }
+
+    ++ContentRevision;
+    UndoHistory.RecordRemoved(*Landmark);
+    if (Replica.ContainsLandmark(LandmarkId))
+    {
+        RecordReplicaOp(Replica.MakeRemove(LandmarkId, TickReplicaClock()));
+    }
+    DestroyLandmarkRepresentation(LandmarkId);
+    SpatialIndex.Remove(LandmarkId);
+    Territory.RemoveSite(LandmarkId);
+    Roads.RemoveSite(LandmarkId);
+    PathService.InvalidateLandmark(LandmarkId);
+    Economy.RemoveSettlement(LandmarkId);
+    MarkScatterAroundLandmark(*Landmark);
+    MarkNavigationDirty(*Landmark);
+    LandmarkStore.Remove(LandmarkId);
+    return true;
+}
+
+void UWorldForgeSubsystem::DestroyAllSettlements()
+{
+    ++ContentRevision;
+    SpawnScheduler.Clear();
+    SpatialIndex.Clear();
+    Territory.ClearSites();
+    Roads.Clear();
+    PathService.Clear();
+    Economy.Clear();
+    Scatter.MarkAllDirty();
+    PendingUndoSteps.Reset();
+    LandmarkStore.ForEach([this](const FWorldForgeLandmark& Landmark)
+    {
+        UndoHistory.RecordRemoved(Landmark);
+        MarkNavigationDirty(Landmark);
+    });
+    DestroyAllLandmarkRepresentations();
+    if (LabelManager)
+    {
+        LabelManager->ClearLabels();
+    }
+    LandmarkStore.Reset();
+    WorldState.Economy = Economy.GetMetrics();
+
+    // Queued landmarks included
+    TArray<FString> Removed;
+    Replica.ForEachLandmark([&Removed](const FWorldForgeLandmark& Landmark) { Removed.Add(Landmark.Id); });
+    for (const FString& LandmarkId : Removed)
+    {
+        RecordReplicaOp(Replica.MakeRemove(LandmarkId, TickReplicaClock()));
+    }
+    OnWorldStateChanged.Broadcast(GetPublishedState());
     UE_LOG(LogTemp, Log, TEXT("WorldForge: Destroyed all settlements"));
 }
+
+bool UWorldForgeSubsystem::Undo()
+{
+    const FWorldForgeUndoStep* Step = UndoHistory.Undo();
+    if (!Step)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldForge: Nothing to undo"));
+        return false;
+    }
+    ApplyUndoStep(*Step, true);
+    return true;
+}
+
+bool UWorldForgeSubsystem::Redo()
+{
+    const FWorldForgeUndoStep* Step = UndoHistory.Redo();
+    if (!Step)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldForge: Nothing to redo"));
+        return false;
+    }
+    ApplyUndoStep(*Step, false);
+    return true;
+}
+
+void UWorldForgeSubsystem::BeginUndoStep(const FString& Label)
+{
+    UndoHistory.SetLimits(CVarUndoMaxSteps.GetValueOnGameThread(),
+                          static_cast<SIZE_T>(FMath::Max(0, CVarUndoMemoryKB.GetValueOnGameThread())) * 1024);
+    UndoHistory.BeginStep(Label, WorldState);
+}
+
+void UWorldForgeSubsystem::EndUndoStep()
+{
+    UndoHistory.EndStep(WorldState);
+    SendUndoState();
+}
+
+void UWorldForgeSubsystem::ApplyUndoStep(const FWorldForgeUndoStep& Step, bool bReverse)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    if (bReverse)
+    {
+        // Landmarks still queued are cancelled; landmarks a replacement removed come back after
+        for (int32 Index = Step.Added.Num() - 1; Index >= 0; --Index)
+        {
+            const FString& LandmarkId = Step.Added[Index].Landmark.Id;
+            if (SpawnScheduler.Remove(LandmarkId))
+            {
+                PendingUndoSteps.Remove(LandmarkId);
+                RecordReplicaOp(Replica.MakeRemove(LandmarkId, TickReplicaClock()));
+            }
+            else
+            {
+                RemoveLandmarkNoBroadcast(LandmarkId);
+            }
+        }
+        for (const FWorldForgeLandmark& Landmark : Step.Removed)
+        {
+            AddLandmarkNoBroadcast(Landmark);
+        }
+        for (const FWorldForgeUndoStep::FCancelled& Entry : Step.Cancelled)
+        {
+            // Placed from scratch, and completes the step that first queued it
+            if (!ContainsLandmark(Entry.Landmark.Id) && !SpawnScheduler.Contains(Entry.Landmark.Id))
+            {
+                SpawnScheduler.Enqueue(Entry.Landmark, true);
+                if (Entry.Origin != 0)
+                {
+                    PendingUndoSteps.Add(Entry.Landmark.Id, Entry.Origin);
+                }
+                RecordReplicaOp(FWorldForgeReplica::MakeAdd(Entry.Landmark, TickReplicaClock()));
+            }
+        }
+        Step.ApplyFields(WorldState, true);
+    }
+    else
+    {
+        for (const FWorldForgeLandmark& Landmark : Step.Removed)
+        {
+            RemoveLandmarkNoBroadcast(Landmark.Id);
+        }
+        for (const FWorldForgeUndoStep::FCancelled& Entry : Step.Cancelled)
+        {
+            // Cancelled again, or destroyed if it was placed after the undo
+            if (SpawnScheduler.Remove(Entry.Landmark.Id))
+            {
+                PendingUndoSteps.Remove(Entry.Landmark.Id);
+                if (Replica.ContainsLandmark(Entry.Landmark.Id))
+                {
+                    RecordReplicaOp(Replica.MakeRemove(Entry.Landmark.Id, TickReplicaClock()));
+                }
+            }
+            else
+            {
+                RemoveLandmarkNoBroadcast(Entry.Landmark.Id);
+            }
+        }
+        for (const FWorldForgeUndoStep::FAdded& Entry : Step.Added)
+        {
+            if (Entry.bPlaced)
+            {
+                AddLandmarkNoBroadcast(Entry.Landmark);
+            }
+            else if (!SpawnScheduler.Contains(Entry.Landmark.Id))
+            {
+                // Undone before it was placed: it is placed again from scratch
+                SpawnScheduler.Enqueue(Entry.Landmark, true);
+                PendingUndoSteps.Add(Entry.Landmark.Id, Step.Serial);
+                RecordReplicaOp(FWorldForgeReplica::MakeAdd(Entry.Landmark, TickReplicaClock()));
+            }
+        }
+        Step.ApplyFields(WorldState, false);
+    }
+
+    if (Step.HasScalarChanges())
+    {
+        RetargetTransitions();
+    }
+    BroadcastWorldStateChanged();
+
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: %s %s in %.2f ms (%d landmarks)"),
+           bReverse ? TEXT("Undid") : TEXT("Redid"), *Step.Label, (FPlatformTime::Seconds() - StartTime) * 1000.0,
+           LandmarkStore.Num());
+    SendUndoState();
+}
+
+void UWorldForgeSubsystem::SendUndoState()
+{
+    if (!WebSocketServer)
+    {
+        return;
+    }
+
+    const FWorldForgeUndoHistory::FStats Stats = UndoHistory.GetStats();
+    WebSocketServer->SendMessage(FString::Printf(
+        TEXT("{\"type\":\"UNDO_STATE\",\"undo\":%d,\"redo\":%d,\"bytes\":%llu,\"evicted\":%d}"),
+        Stats.UndoSteps, Stats.RedoSteps, static_cast<uint64>(Stats.Bytes), Stats.Evicted + Stats.Oversized));
+}
+
+FWorldForgeHlc UWorldForgeSubsystem::TickReplicaClock()
+{
+    return ReplicaClock.Tick(FWorldForgeHybridClock::GetPhysicalMs());
+}
+
+void UWorldForgeSubsystem::CollectReplicaTombstones()
+{
+    TArray<int32> SessionIds;
+    if (WebSocketServer)
+    {
+        WebSocketServer->GetSessionIds(SessionIds);
+    }
+    for (TMap<int32, FWorldForgeHlc>::TIterator It = SessionStamps.CreateIterator(); It; ++It)
+    {
+        if (!SessionIds.Contains(It.Key()))
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    // Stable up to the oldest stamp any connected session sent; a session that sent none holds it back
+    bool bStable = true;
+    FWorldForgeHlc Stable = ReplicaClock.GetLast();
+    for (const int32 SessionId : SessionIds)
+    {
+        const FWorldForgeHlc* SessionStamp = SessionStamps.Find(SessionId);
+        if (!SessionStamp)
+        {
+            bStable = false;
+            break;
+        }
+        if (*SessionStamp < Stable)
+        {
+            Stable = *SessionStamp;
+        }
+    }
+
+    const int32 Collected = bStable ? Replica.CollectTombstones(Stable) : 0;
+    const int32 Evicted = Replica.TrimTombstones(FMath::Max(0, CVarReplicaMaxTombstones.GetValueOnGameThread()));
+    if (Collected > 0 || Evicted > 0)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("WorldForge: Dropped %d stable and %d evicted tombstones, %d held"),
+               Collected, Evicted, Replica.GetStats().Tombstones);
+    }
+}
+
+bool UWorldForgeSubsystem::MergeReplicaOp(const FWorldForgeReplicaOp& Op)
+{
+    const FString& LandmarkId = Op.Landmark.Id;
+    const bool bWasPresent = Replica.ContainsLandmark(LandmarkId);
+    if (!Replica.Merge(Op))
+    {
+        UE_LOG(LogTemp, Log, TEXT("WorldForge: Ignored an edit from node %u, superseded or already merged"), Op.Stamp.Node);
+        return false;
+    }
+    ReplicaDelta.Add(Op);
+
+    switch (Op.Kind)
+    {
+    case EWorldForgeReplicaOpKind::Era:
+        WorldState.Era = Op.Era;
+        break;
+    case EWorldForgeReplicaOpKind::Seed:
+        WorldState.Seed = Op.Seed;
+        break;
+    case EWorldForgeReplicaOpKind::Trait:
+        WorldState.SetTrait(Op.Trait, Op.Value);
+        break;
+    case EWorldForgeReplicaOpKind::Atmosphere:
+        WorldState.Atmosphere = Op.Atmosphere;
+        break;
+    case EWorldForgeReplicaOpKind::AddLandmark:
+        // Later data for a landmark already spawned is merged but not respawned
+        if (!bWasPresent && !ContainsLandmark(LandmarkId) && !SpawnScheduler.Contains(LandmarkId))
+        {
+            EnqueueLandmark(*Replica.FindLandmark(LandmarkId), true);
+        }
+        break;
+    case EWorldForgeReplicaOpKind::RemoveLandmark:
+        if (bWasPresent && !Replica.ContainsLandmark(LandmarkId))
+        {
+            if (!CancelQueuedLandmark(LandmarkId))
+            {
+                RemoveLandmarkNoBroadcast(LandmarkId);
+            }
+        }
+        break;
+    }
+    return true;
+}
+
+void UWorldForgeSubsystem::RecordReplicaOp(const FWorldForgeReplicaOp& Op)
+{
+    if (Replica.Merge(Op))
+    {
+        ReplicaDelta.Add(Op);
+    }
+}
+
+void UWorldForgeSubsystem::FlushReplicaDelta(int32 OriginSession)
+{
+    // Traits, atmosphere and era changed by Blueprints, undo, outcomes or history since the last flush
+    TArray<FWorldForgeReplicaOp> LocalOps;
+    Replica.DiffScalars(WorldState, LocalOps);
+    if (LocalOps.Num() > 0)
+    {
+        const FWorldForgeHlc Stamp = TickReplicaClock();
+        for (FWorldForgeReplicaOp& Op : LocalOps)
+        {
+            Op.Stamp = Stamp;
+            RecordReplicaOp(Op);
+        }
+    }
+
+    if (ReplicaDelta.Num() == 0)
+    {
+        return;
+    }
+
+    if (WebSocketServer)
+    {
+        TArray<TSharedPtr<FJsonValue>> Ops;
+        Ops.Reserve(ReplicaDelta.Num());
+        for (const FWorldForgeReplicaOp& Op : ReplicaDelta)
+        {
+            Ops.Add(MakeShared<FJsonValueObject>(WorldForgeCommands::WriteReplicaOp(Op)));
+        }
+        TSharedRef<FJsonObject> Message = MakeShared<FJsonObject>();
+        Message->SetStringField(TEXT("type"), TEXT("WORLD_DELTA"));
+        Message->SetNumberField(TEXT("origin"), OriginSession);
+        Message->SetArrayField(TEXT("ops"), Ops);
+
+        FString Json;
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+        FJsonSerializer::Serialize(Message, Writer);
+        WebSocketServer->SendMessage(Json);
+    }
+    ReplicaDelta.Reset();
+}
+
+void UWorldForgeSubsystem::SetLandmarkRenderMode(EWorldForgeLandmarkRenderMode NewMode)
+{
+    if (NewMode == LandmarkRenderMode)
+    {
+        return;
+    }
+
+    DestroyAllLandmarkRepresentations();
+    LandmarkRenderMode = NewMode;
+    PromotionTimer = 0.0f;
+
+    LandmarkStore.ForEach([this](const FWorldForgeLandmark& Landmark) { CreateLandmarkRepresentation(Landmark); });
+
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Landmark render mode set to %s (%d landmarks rebuilt)"),
+           NewMode == EWorldForgeLandmarkRenderMode::Instanced ? TEXT("Instanced") : TEXT("Actors"),
+           LandmarkStore.Num());
+}
+
+UMaterialInterface* UWorldForgeSubsystem::GetLandmarkMaterial(UMaterialInterface* BaseMaterial, EWorldForgeLandmarkType Type)
+{
+    return MaterialCache ? MaterialCache->GetLandmarkMaterial(BaseMaterial, Type, WorldState.Era.Id) : BaseMaterial;
+}
+
+FWorldForgeLayoutParams UWorldForgeSubsystem::MakeLayoutParams(const FWorldForgeLandmark& Landmark) const
+{
+    return FWorldForgeLayoutParams::FromLandmark(Landmark, WorldState);
+}
+
+bool UWorldForgeSubsystem::TakePreparedLayout(const FString& LandmarkId, const FWorldForgeLayoutParams& Params, FWorldForgeSettlementLayout& OutLayout)
+{
+    FWorldForgeOutcomeContent::FLayout Prepared;
+    if (!PreparedLayouts.RemoveAndCopyValue(LandmarkId, Prepared) || Prepared.Params != Params)
+    {
+        return false;
+    }
+    OutLayout = MoveTemp(Prepared.Layout);
+    return true;
+}
+
+bool UWorldForgeSubsystem::ContainsLandmark(const FString& LandmarkId) const
+{
+    return SpawnedActors.Contains(LandmarkId) || (Instancer && Instancer->ContainsLandmark(LandmarkId));
+}
+
+void UWorldForgeSubsystem::CreateLandmarkRepresentation(const FWorldForgeLandmark& Landmark)
+{
+    if (LandmarkRenderMode == EWorldForgeLandmarkRenderMode::Instanced)
+    {
+        // Actors near the player are promoted on the next promotion pass
+        if (AWorldForgeLandmarkInstancer* LandmarkInstancer = GetOrCreateInstancer())
+        {
+            LandmarkInstancer->AddLandmark(Landmark);
+        }
+        return;
+    }
+
+    if (AWorldForgeSettlementActor* SpawnedActor = SpawnSettlementActor(Landmark))
+    {
+        SpawnedActors.Add(Landmark.Id, SpawnedActor);
+    }
+}
+
+void UWorldForgeSubsystem::DestroyLandmarkRepresentation(const FString& LandmarkId)
+{
+    TObjectPtr<AWorldForgeSettlementActor> Actor;
+    if (SpawnedActors.RemoveAndCopyValue(LandmarkId, Actor) && Actor)
+    {
+        Actor->Destroy();
+    }
+
+    if (Instancer)
+    {
+        Instancer->RemoveLandmark(LandmarkId);
+    }
+}
+
+void UWorldForgeSubsystem::DestroyAllLandmarkRepresentations()
+{
+    for (auto& Pair : SpawnedActors)
+    {
+        if (Pair.Value)
+        {
+            Pair.Value->Destroy();
+        }
+    }
+    SpawnedActors.Empty();
+
+    if (Instancer)
+    {
+        Instancer->ClearLandmarks();
+    }
+}
+
+AWorldForgeLandmarkInstancer* UWorldForgeSubsystem::GetOrCreateInstancer()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    // The instancer belongs to a single world; recreate it after a map change
+    if (Instancer && Instancer->GetWorld() == World && IsValid(Instancer))
+    {
+        return Instancer;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    Instancer = World->SpawnActor<AWorldForgeLandmarkInstancer>(
+        AWorldForgeLandmarkInstancer::StaticClass(),
+        FVector::ZeroVector,
+        FRotator::ZeroRotator,
+        SpawnParams
+    );
+
+    if (!Instancer)
+    {
+        UE_LOG(LogTemp, Error, TEXT("WorldForge: Failed to spawn landmark instancer"));
+    }
+    return Instancer;
+}
+
+void UWorldForgeSubsystem::UpdateActorPromotion()
+{
+    UWorld* World = GetWorld();
+    if (!World || !Instancer)
+    {
+        return;
+    }
+
+    APlayerController* PC = World->GetFirstPlayerController();
+    if (!PC || !PC->GetPawn())
+    {
+        return;
+    }
+
+    const FVector PlayerLocation = PC->GetPawn()->GetActorLocation();
+    // Hysteresis so landmarks on the boundary do not flip every pass
+    const float DemoteDistSq = FMath::Square(ActorPromotionRadius * 1.2f);
+
+    // Only actors already spawned can be demoted, and only landmarks in range promoted
+    for (TMap<FString, TObjectPtr<AWorldForgeSettlementActor>>::TIterator It = SpawnedActors.CreateIterator(); It; ++It)
+    {
+        const FWorldForgeLandmark* Landmark = LandmarkStore.Find(It.Key());
+        if (Landmark && FVector::DistSquared(PlayerLocation, Landmark->Location) <= DemoteDistSq)
+        {
+            continue;
+        }
+        if (It.Value())
+        {
+            It.Value()->Destroy();
+        }
+        Instancer->SetLandmarkHidden(It.Key(), false);
+        It.RemoveCurrent();
+    }
+
+    TArray<const FWorldForgeSpatialEntry*> InRange;
+    SpatialIndex.QueryRadius(PlayerLocation, ActorPromotionRadius, InRange);
+    for (const FWorldForgeSpatialEntry* Entry : InRange)
+    {
+        if (SpawnedActors.Contains(Entry->Id))
+        {
+            continue;
+        }
+        const FWorldForgeLandmark* Landmark = LandmarkStore.Find(Entry->Id);
+        if (!Landmark)
+        {
+            continue;
+        }
+        if (AWorldForgeSettlementActor* Actor = SpawnSettlementActor(*Landmark))
+        {
+            SpawnedActors.Add(Entry->Id, Actor);
+            Instancer->SetLandmarkHidden(Entry->Id, true);
+        }
+    }
+}
+
+void UWorldForgeSubsystem::UpdateLabels()
+{
+    UWorld* World = GetWorld();
+    APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+    if (!PC)
+    {
+        return;
+    }
+
+    // The label manager belongs to a single world; recreate it after a map change
+    if (!LabelManager || !IsValid(LabelManager) || LabelManager->GetWorld() != World)
+    {
+        if (SpatialIndex.Num() == 0)
+        {
+            return;
+        }
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        LabelManager = World->SpawnActor<AWorldForgeLabelManager>(
+            AWorldForgeLabelManager::StaticClass(),
+            FVector::ZeroVector,
+            FRotator::ZeroRotator,
+            SpawnParams
+        );
+
+        if (!LabelManager)
+        {
+            return;
+        }
+    }
+
+    LabelManager->UpdateLabels(SpatialIndex, PC, &LowSignificanceLandmarks);
+}
+
+void UWorldForgeSubsystem::MarkNavigationDirty(const FWorldForgeLandmark& Landmark)
+{
+    if (CVarNavBatching.GetValueOnGameThread() == 0)
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    UNavigationSystemV1* NavSys = World ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+    if (NavSys && !bNavBuildLocked)
+    {
+        // Taken before the representation is created: registering each new actor's components would
+        // otherwise dirty the navmesh one settlement at a time
+        NavSys->AddNavigationBuildLock(ENavigationBuildLock::Custom);
+        bNavBuildLocked = true;
+        NavLockTime = FPlatformTime::Seconds();
+    }
+
+    // Tiles are counted in the navmesh's own tile size, so merged boxes line up with real tiles
+    if (!NavBatch.HasPending())
+    {
+        if (const ARecastNavMesh* NavMesh = NavSys ? Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance()) : nullptr)
+        {
+            NavBatch.SetTileSize(NavMesh->GetTileSizeUU());
+        }
+    }
+
+    NavBatch.AddArea(AWorldForgeSettlementActor::GetNavigationBounds(Landmark));
+}
+
+void UWorldForgeSubsystem::UpdateNavigation()
+{
+    UWorld* World = GetWorld();
+    UNavigationSystemV1* NavSys = World ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+    if (!NavSys)
+    {
+        // No navigation in this world; nothing will ever consume the tiles
+        NavBatch.Reset();
+        bNavBuildLocked = false;
+        bNavRebuildInFlight = false;
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+
+    if (NavBatch.HasPending())
+    {
+        const bool bBurstActive = SpawnScheduler.HasPending() || HistoryJob.IsValid();
+        const bool bSettled = !bBurstActive && Now - NavBatch.GetLastAddTime() >= CVarNavSettleSeconds.GetValueOnGameThread();
+        const bool bHeldTooLong = Now - NavLockTime >= CVarNavMaxDeferSeconds.GetValueOnGameThread();
+        if (!bSettled && !bHeldTooLong)
+        {
+            return;
+        }
+
+        TArray<FBox> Boxes;
+        NavBatch.Flush(Boxes);
+        NavSys->RemoveNavigationBuildLock(ENavigationBuildLock::Custom, ELockRemovalRebuildAction::NoRebuild);
+        NavSys->AddDirtyAreas(Boxes, ENavigationDirtyFlag::All);
+        bNavBuildLocked = false;
+        bNavRebuildInFlight = true;
+        bNavRebuildSeenBusy = false;
+        NavFlushTime = Now;
+        NavDeferredSeconds = Now - NavLockTime;
+
+        const FWorldForgeNavBatch::FStats& Stats = NavBatch.GetStats();
+        UE_LOG(LogTemp, Log, TEXT("WorldForge: Navmesh batch of %d landmark changes: %d tiles in %d boxes (%d tile rebuilds unbatched), held %.2f s"),
+               Stats.LastAreas, Stats.LastTiles, Stats.LastBoxes, Stats.LastUnbatchedTiles, NavDeferredSeconds);
+        return;
+    }
+
+    if (bNavBuildLocked)
+    {
+        // Batching was switched off mid-burst; release the hold
+        NavSys->RemoveNavigationBuildLock(ENavigationBuildLock::Custom, ELockRemovalRebuildAction::NoRebuild);
+        bNavBuildLocked = false;
+    }
+
+    if (bNavRebuildInFlight)
+    {
+        // Dirty areas are picked up on the navigation system's next tick, so idle right after the flush is not done yet
+        const bool bBusy = NavSys->IsNavigationBuildInProgress();
+        bNavRebuildSeenBusy |= bBusy;
+        if (!bBusy && (bNavRebuildSeenBusy || Now - NavFlushTime > 1.0))
+        {
+            bNavRebuildInFlight = false;
+            NavBatch.RecordRebuild(NavDeferredSeconds, Now - NavFlushTime);
+            UE_LOG(LogTemp, Log, TEXT("WorldForge: Navmesh batch rebuilt in %.2f s"), Now - NavFlushTime);
+        }
+    }
+}
+
+void UWorldForgeSubsystem::UpdateSignificance(float DeltaTime)
+{
+    UWorld* World = GetWorld();
+    USignificanceManager* SignificanceManager = World ? USignificanceManager::Get(World) : nullptr;
+    if (!SignificanceManager || CVarSignificance.GetValueOnGameThread() == 0)
+    {
+        ResetSignificance();
+        return;
+    }
+
+    SignificanceTimer += DeltaTime;
+    if (SignificanceTimer < CVarSignificanceInterval.GetValueOnGameThread() || SpawnedActors.Num() == 0)
+    {
+        return;
+    }
+    SignificanceTimer = 0.0f;
+
+    APlayerController* PC = World->GetFirstPlayerController();
+    if (!PC || !PC->PlayerCameraManager)
+    {
+        return;
+    }
+
+    // Gameplay relevance follows the traits, so it is only recomputed when they change
+    const FVector Traits(GetTrait(EWorldForgeTrait::Militarism), GetTrait(EWorldForgeTrait::Prosperity), GetTrait(EWorldForgeTrait::Religiosity));
+    if (Traits != SignificanceTraits)
+    {
+        SignificanceTraits = Traits;
+        for (auto& Pair : SpawnedActors)
+        {
+            if (Pair.Value)
+            {
+                Pair.Value->SetSignificanceRelevance(FWorldForgeSignificance::GetRelevance(
+                    Pair.Value->GetLandmarkData().Type, Traits.X, Traits.Y, Traits.Z));
+            }
+        }
+    }
+
+    const FTransform Viewpoint(PC->PlayerCameraManager->GetCameraRotation(), PC->PlayerCameraManager->GetCameraLocation());
+    SignificanceManager->Update(TArrayView<const FTransform>(&Viewpoint, 1));
+
+    // Sorted by significance during Update
+    const TArray<USignificanceManager::FManagedObjectInfo*>& Objects = SignificanceManager->GetManagedObjects(FWorldForgeSignificance::Tag);
+    TArray<float> Scores;
+    Scores.Reserve(Objects.Num());
+    for (const USignificanceManager::FManagedObjectInfo* Info : Objects)
+    {
+        Scores.Add(Info->GetSignificance());
+    }
+
+    FWorldForgeSignificanceSettings Settings;
+    Settings.MaxHigh = FMath::Max(0, CVarSignificanceMaxHigh.GetValueOnGameThread());
+    Settings.MaxMedium = FMath::Max(0, CVarSignificanceMaxMedium.GetValueOnGameThread());
+
+    TArray<EWorldForgeSignificanceTier> Tiers;
+    FWorldForgeSignificance::AssignTiers(Scores, Settings, Tiers, SignificanceTierCounts);
+    FWorldForgeSignificance::SetStats(SignificanceTierCounts);
+
+    LowSignificanceLandmarks.Reset();
+    for (int32 Index = 0; Index < Objects.Num(); ++Index)
+    {
+        AWorldForgeSettlementActor* Actor = Cast<AWorldForgeSettlementActor>(Objects[Index]->GetObject());
+        if (!Actor)
+        {
+            continue;
+        }
+
+        Actor->SetSignificanceTier(Tiers[Index]);
+        if (Tiers[Index] >= EWorldForgeSignificanceTier::Low)
+        {
+            LowSignificanceLandmarks.Add(Actor->GetLandmarkId());
+        }
+    }
+}
+
+void UWorldForgeSubsystem::ResetSignificance()
+{
+    if (LowSignificanceLandmarks.Num() == 0 && SignificanceTierCounts[0] == 0 && SignificanceTierCounts[1] == 0)
+    {
+        return;
+    }
+
+    for (auto& Pair : SpawnedActors)
+    {
+        if (Pair.Value)
+        {
+            Pair.Value->SetSignificanceTier(EWorldForgeSignificanceTier::High);
+        }
+    }
+    LowSignificanceLandmarks.Empty();
+    FMemory::Memzero(SignificanceTierCounts);
+    FWorldForgeSignificance::SetStats(SignificanceTierCounts);
+}
+
+FString UWorldForgeSubsystem::GetTerritoryOwnerAt(const FVector& Location) const
+{
+    const FString* Owner = Territory.GetOwnerAt(static_cast<float>(Location.X), static_cast<float>(Location.Y));
+    return Owner ? *Owner : FString();
+}
+
+bool UWorldForgeSubsystem::IsTerritoryContestedAt(const FVector& Location) const
+{
+    return Territory.IsContestedAt(static_cast<float>(Location.X), static_cast<float>(Location.Y));
+}
+
+void UWorldForgeSubsystem::UpdateTerritory()
+{
+    FWorldForgeTerritorySettings Settings = Parameters.Get<FWorldForgeTerritorySettings>(ParameterRules.Territory);
+    Settings.Resolution = FMath::Max(1, CVarTerritoryResolution.GetValueOnGameThread());
+    Settings.CellSize = FMath::Max(1.0f, CVarTerritoryCellSize.GetValueOnGameThread());
+
+    // Chunk coordinates only line up while the grid keeps its shape
+    const FWorldForgeTerritorySettings& Current = Territory.GetSettings();
+    if ((Settings.Resolution != Current.Resolution || Settings.CellSize != Current.CellSize) && TerritoryActor)
+    {
+        TerritoryActor->ClearChunks();
+    }
+    Territory.SetSettings(Settings);
+
+    const bool bShow = CVarShowTerritory.GetValueOnGameThread() != 0;
+    if (bShow != bTerritoryVisible)
+    {
+        bTerritoryVisible = bShow;
+        if (TerritoryActor)
+        {
+            TerritoryActor->ClearChunks();
+        }
+        if (bShow)
+        {
+            const float HalfExtent = 0.5f * Settings.Resolution * Settings.CellSize;
+            Territory.MarkRegionDirty(FBox2D(FVector2D(-HalfExtent), FVector2D(HalfExtent)));
+        }
+    }
+
+    if (!Territory.HasPendingChanges())
+    {
+        return;
+    }
+
+    TArray<FIntPoint> DirtyChunks;
+    Territory.Update(DirtyChunks);
+
+    // No overlay is spawned until some landmark claims territory
+    AWorldForgeTerritoryActor* Overlay = bShow && (TerritoryActor || Territory.NumSites() > 0) ? GetOrCreateTerritoryActor() : nullptr;
+    if (!Overlay)
+    {
+        return;
+    }
+
+    FWorldForgeTerritoryMeshData MeshData;
+    for (const FIntPoint& Chunk : DirtyChunks)
+    {
+        Territory.BuildChunkMesh(Chunk, HeightCache->IsEmpty() ? nullptr : &HeightCache.Get(), MeshData);
+        Overlay->SetChunk(Chunk, MeshData);
+    }
+}
+
+AWorldForgeTerritoryActor* UWorldForgeSubsystem::GetOrCreateTerritoryActor()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    // The overlay belongs to a single world; recreate it after a map change
+    if (TerritoryActor && TerritoryActor->GetWorld() == World && IsValid(TerritoryActor))
+    {
+        return TerritoryActor;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    TerritoryActor = World->SpawnActor<AWorldForgeTerritoryActor>(
+        AWorldForgeTerritoryActor::StaticClass(),
+        FVector::ZeroVector,
+        FRotator::ZeroRotator,
+        SpawnParams
+    );
+
+    if (!TerritoryActor)
+    {
+        UE_LOG(LogTemp, Error, TEXT("WorldForge: Failed to spawn territory actor"));
+        return nullptr;
+    }
+
+    // A new overlay starts empty; draw everything on the next update
+    const FWorldForgeTerritorySettings& Settings = Territory.GetSettings();
+    const float HalfExtent = 0.5f * Settings.Resolution * Settings.CellSize;
+    Territory.MarkRegionDirty(FBox2D(FVector2D(-HalfExtent), FVector2D(HalfExtent)));
+    return TerritoryActor;
+}
+
+void UWorldForgeSubsystem::UpdateRoads()
+{
+    if (!Roads.HasPendingChanges())
+    {
+        return;
+    }
+
+    TArray<FWorldForgeRoadNetwork::FRouteRequest> Requests;
+    TArray<FString> Removed;
+    Roads.Update(Requests, Removed);
+
+    for (const FString& Key : Removed)
+    {
+        PathService.InvalidateRoad(Key);
+    }
+
+    if (RoadActor)
+    {
+        for (const FString& Key : Removed)
+        {
+            RoadActor->RemoveRoad(Key);
+        }
+    }
+
+    // Each road is routed on its own task, so a batch of new roads spreads across the workers
+    const FWorldForgeRoadSettings Settings = Roads.GetSettings();
+    TWeakObjectPtr<UWorldForgeSubsystem> WeakThis(this);
+    for (FWorldForgeRoadNetwork::FRouteRequest& Request : Requests)
+    {
+        UE::Tasks::Launch(UE_SOURCE_LOCATION, [Request = MoveTemp(Request), Settings, Heights = HeightCache, Water = WaterMap, WeakThis]()
+        {
+            FWorldForgeRoad Road;
+            Road.FromId = Request.FromId;
+            Road.ToId = Request.ToId;
+            if (!FWorldForgeRoadPlanner::Route(Request.Start, Request.End, Settings, &Heights.Get(), &Water.Get(), Road))
+            {
+                return;
+            }
+
+            FWorldForgeTerrainMeshData MeshData;
+            FWorldForgeRoadPlanner::BuildRoadMesh(Road, Settings.Width, MeshData);
+
+            AsyncTask(ENamedThreads::GameThread, [Key = Request.Key, Version = Request.Version, Road = MoveTemp(Road), MeshData = MoveTemp(MeshData), WeakThis]() mutable
+            {
+                if (UWorldForgeSubsystem* Subsystem = WeakThis.Get())
+                {
+                    Subsystem->CommitRoad(Key, Version, MoveTemp(Road), MeshData);
+                }
+            });
+        });
+    }
+
+    if (Requests.Num() > 0 || Removed.Num() > 0)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("WorldForge: Routing %d roads, removed %d (%d roads between %d landmarks)"),
+               Requests.Num(), Removed.Num(), Roads.NumRoads(), Roads.NumSites());
+    }
+}
+
+void UWorldForgeSubsystem::CommitRoad(const FString& Key, uint32 Version, FWorldForgeRoad&& Road, const FWorldForgeTerrainMeshData& MeshData)
+{
+    AWorldForgeRoadActor* Actor = GetOrCreateRoadActor();
+    const bool bRerouted = Roads.FindRoad(Key) != nullptr;
+    if (!Roads.CommitRoute(Key, Version, MoveTemp(Road)))
+    {
+        return;
+    }
+
+    // A re-routed road (terrain changed under it) only affects the paths over it; a new one may shorten any
+    if (bRerouted)
+    {
+        PathService.InvalidateRoad(Key);
+    }
+    else
+    {
+        PathService.OnRoadAdded();
+    }
+
+    if (Actor)
+    {
+        Actor->SetRoad(Key, MeshData);
+    }
+}
+
+void UWorldForgeSubsystem::RequestPaths(TArray<FWorldForgePathQuery> Queries, TFunction<void(const TArray<FWorldForgePathPtr>&)> OnComplete)
+{
+    PathService.SetCapacity(CVarPathCacheSize.GetValueOnGameThread());
+    TSharedRef<FWorldForgePathBatch, ESPMode::ThreadSafe> Batch = PathService.BeginBatch(MoveTemp(Queries), Roads);
+    if (Batch->IsSolved())
+    {
+        PathService.CommitBatch(*Batch);
+        OnComplete(Batch->GetResults());
+        return;
+    }
+
+    TWeakObjectPtr<UWorldForgeSubsystem> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [Batch, OnComplete = MoveTemp(OnComplete), WeakThis]() mutable
+    {
+        Batch->Run();
+
+        AsyncTask(ENamedThreads::GameThread, [Batch, OnComplete = MoveTemp(OnComplete), WeakThis]()
+        {
+            if (UWorldForgeSubsystem* Subsystem = WeakThis.Get())
+            {
+                Subsystem->PathService.CommitBatch(*Batch);
+
+                const FWorldForgePathService::FStats& Stats = Subsystem->PathService.GetStats();
+                UE_LOG(LogTemp, Verbose, TEXT("WorldForge: Path batch of %d queries in %.2f ms; cache hit rate %.1f%%, %.0f solved/s"),
+                       Stats.LastBatchQueries, Stats.LastBatchMs, Stats.GetHitRate() * 100.0f, Stats.GetSolvedPerSecond());
+
+                OnComplete(Batch->GetResults());
+            }
+        });
+    });
+}
+
+AWorldForgeRoadActor* UWorldForgeSubsystem::GetOrCreateRoadActor()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    // Roads belong to a single world; recreate the actor after a map change
+    if (RoadActor && RoadActor->GetWorld() == World && IsValid(RoadActor))
+    {
+        return RoadActor;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    RoadActor = World->SpawnActor<AWorldForgeRoadActor>(
+        AWorldForgeRoadActor::StaticClass(),
+        FVector::ZeroVector,
+        FRotator::ZeroRotator,
+        SpawnParams
+    );
+
+    if (!RoadActor)
+    {
+        UE_LOG(LogTemp, Error, TEXT("WorldForge: Failed to spawn road actor"));
+        return nullptr;
+    }
+
+    // A replacement actor starts empty; route everything again so existing roads reappear
+    if (Roads.NumRoutedRoads() > 0)
+    {
+        Roads.InvalidateAll();
+    }
+    return RoadActor;
+}
+
+void UWorldForgeSubsystem::RetargetTransitions()
+{
+    FWorldForgeTransitions::FSettings Settings;
+    Settings.TraitSeconds = FMath::Max(0.0f, CVarTraitTransitionSeconds.GetValueOnGameThread());
+    Settings.AtmosphereSeconds = FMath::Max(0.0f, CVarAtmosphereTransitionSeconds.GetValueOnGameThread());
+
+    const int32 Easing = CVarTransitionEasing.GetValueOnGameThread();
+    if (Easing >= 0 && Easing <= static_cast<int32>(EWorldForgeEasing::EaseOutQuad))
+    {
+        Settings.TraitEasing = static_cast<EWorldForgeEasing>(Easing);
+        Settings.AtmosphereEasing = static_cast<EWorldForgeEasing>(Easing);
+    }
+
+    // Only channels whose target changed restart, so calling this every tick is cheap
+    Transitions.SetSettings(Settings);
+    Transitions.SetTargets(WorldState);
+}
+
+void UWorldForgeSubsystem::InitializeParameters()
+{
+    ParameterRules = FWorldForgeParameterRules::AddDefaultRules(Parameters);
+
+    // Territory merges its grid CVars every tick, so it reads the memoized settings in UpdateTerritory instead
+    Parameters.AddConsumer(ParameterRules.Roads, TEXT("Roads"), [this]()
+    {
+        Roads.SetSettings(Parameters.Get<FWorldForgeRoadSettings>(ParameterRules.Roads));
+    });
+
+    // Scatter marks only the layers whose resolved parameters changed
+    Parameters.AddConsumer(ParameterRules.Scatter, TEXT("Scatter"), [this]()
+    {
+        Scatter.SetLayers(CopyTemp(Parameters.Get<TArray<FWorldForgeScatterLayerParams>>(ParameterRules.Scatter)));
+    });
+
+    // A seed change restarts the economy; trait changes only alter the rates of the running simulation
+    Parameters.AddConsumer(ParameterRules.Economy, TEXT("Economy"), [this]()
+    {
+        Economy.SetSettings(Parameters.Get<FWorldForgeEconomySettings>(ParameterRules.Economy));
+    });
+
+    Parameters.SetState(WorldState);
+    Parameters.Evaluate();
+}
+
+int32 UWorldForgeSubsystem::GetScatterInstanceCount() const
+{
+    return ScatterActor ? ScatterActor->GetInstanceCount() : 0;
+}
+
+void UWorldForgeSubsystem::UpdateScatter()
+{
+    const bool bEnabled = CVarScatter.GetValueOnGameThread() != 0;
+    if (bEnabled != bScatterEnabled)
+    {
+        bScatterEnabled = bEnabled;
+        if (ScatterActor)
+        {
+            ScatterActor->ClearInstances();
+        }
+        Scatter.MarkAllDirty();
+    }
+    if (!bEnabled)
+    {
+        return;
+    }
+
+    // A new grid starts with every cell dirty; the old partitions no longer line up with it
+    const int32 CellsPerSide = FMath::Max(1, CVarScatterResolution.GetValueOnGameThread());
+    const float CellSize = FMath::Max(1.0f, CVarScatterCellSize.GetValueOnGameThread());
+    if ((CellsPerSide != Scatter.GetCellsPerSide() || CellSize != Scatter.GetCellSize()) && ScatterActor)
+    {
+        ScatterActor->ClearInstances();
+    }
+    Scatter.SetGrid(CellsPerSide, CellSize);
+
+    if (!Scatter.HasPendingChanges())
+    {
+        return;
+    }
+
+    TArray<FWorldForgeScatterGrid::FCellRequest> Requests;
+    if (HeightCache->IsEmpty())
+    {
+        // Nothing to place on: drop the dirty cells, which are marked again as terrain tiles arrive
+        Scatter.TakeDirtyCells(FVector2D::ZeroVector, MAX_int32, Requests);
+        if (ScatterActor)
+        {
+            ScatterActor->ClearInstances();
+        }
+        return;
+    }
+
+    Scatter.TakeDirtyCells(FVector2D(GetPlayerLocation()), CVarScatterCellsPerTick.GetValueOnGameThread(), Requests);
+
+    const TArray<FWorldForgeScatterLayerParams>& CurrentLayers = Scatter.GetLayers();
+    const float LandmarkRadius = Scatter.GetMaxLandmarkRadius();
+    TWeakObjectPtr<UWorldForgeSubsystem> WeakThis(this);
+    TArray<const FWorldForgeSpatialEntry*> Entries;
+
+    for (const FWorldForgeScatterGrid::FCellRequest& Request : Requests)
+    {
+        // The spatial index is game-thread only, so each task gets a copy of the landmarks around its cell
+        const FBox2D Bounds = Scatter.GetCellBounds(Request.Cell);
+        const FVector2D Center = Bounds.GetCenter();
+        SpatialIndex.QueryRadius(FVector(Center, 0.0), 0.5f * Scatter.GetCellSize() * UE_SQRT_2 + LandmarkRadius, Entries);
+
+        TArray<FVector2D> Landmarks;
+        for (const FWorldForgeSpatialEntry* Entry : Entries)
+        {
+            if (FWorldForgeScatter::ExcludesScatter(Entry->Type))
+            {
+                Landmarks.Add(FVector2D(Entry->Location));
+            }
+        }
+
+        UE::Tasks::Launch(UE_SOURCE_LOCATION, [Request, Bounds, Landmarks = MoveTemp(Landmarks), CurrentLayers,
+                                               Heights = HeightCache, Water = WaterMap, WeakThis]()
+        {
+            TArray<TArray<FTransform>> LayerTransforms;
+            LayerTransforms.SetNum(FWorldForgeScatter::NumLayers);
+            for (int32 Layer = 0; Layer < CurrentLayers.Num(); ++Layer)
+            {
+                if (Request.LayerMask & (1u << Layer))
+                {
+                    FWorldForgeScatter::GenerateCell(CurrentLayers[Layer], Request.Cell, Bounds, Landmarks,
+                                                     Heights.Get(), &Water.Get(), LayerTransforms[Layer]);
+                }
+            }
+
+            AsyncTask(ENamedThreads::GameThread, [Request, LayerTransforms = MoveTemp(LayerTransforms), WeakThis]()
+            {
+                UWorldForgeSubsystem* Subsystem = WeakThis.Get();
+                if (!Subsystem)
+                {
+                    return;
+                }
+                for (int32 Layer = 0; Layer < LayerTransforms.Num(); ++Layer)
+                {
+                    if (Request.LayerMask & (1u << Layer))
+                    {
+                        Subsystem->CommitScatterLayer(Request.Cell, Layer, Request.Versions[Layer], LayerTransforms[Layer]);
+                    }
+                }
+            });
+        });
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("WorldForge: Scattering %d cells"), Requests.Num());
+}
+
+void UWorldForgeSubsystem::CommitScatterLayer(FIntPoint Cell, int32 Layer, uint32 Version, const TArray<FTransform>& Transforms)
+{
+    if (!bScatterEnabled || !Scatter.IsCurrent(Cell, Layer, Version) || (Transforms.Num() == 0 && !ScatterActor))
+    {
+        return;
+    }
+
+    if (AWorldForgeScatterActor* Actor = GetOrCreateScatterActor())
+    {
+        Actor->SetInstances(static_cast<EWorldForgeScatterLayer>(Layer), Cell, Transforms);
+    }
+}
+
+void UWorldForgeSubsystem::MarkScatterAroundLandmark(const FWorldForgeLandmark& Landmark)
+{
+    if (!FWorldForgeScatter::ExcludesScatter(Landmark.Type))
+    {
+        return;
+    }
+
+    const FVector2D Location(Landmark.Location);
+    const FVector2D Extent(Scatter.GetMaxLandmarkRadius());
+    Scatter.MarkRegionDirty(FBox2D(Location - Extent, Location + Extent));
+}
+
+AWorldForgeScatterActor* UWorldForgeSubsystem::GetOrCreateScatterActor()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    // Scatter belongs to a single world; recreate the actor after a map change
+    if (ScatterActor && ScatterActor->GetWorld() == World && IsValid(ScatterActor))
+    {
+        return ScatterActor;
+    }
+
+    const bool bReplacing = ScatterActor != nullptr;
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    ScatterActor = World->SpawnActor<AWorldForgeScatterActor>(
+        AWorldForgeScatterActor::StaticClass(),
+        FVector::ZeroVector,
+        FRotator::ZeroRotator,
+        SpawnParams
+    );
+
+    if (!ScatterActor)
+    {
+        UE_LOG(LogTemp, Error, TEXT("WorldForge: Failed to spawn scatter actor"));
+        return nullptr;
+    }
+
+    // A replacement actor starts empty; regenerate everything so existing cells reappear
+    if (bReplacing)
+    {
+        Scatter.MarkAllDirty();
+    }
+    return ScatterActor;
+}
+
+void UWorldForgeSubsystem::UpdateEconomy(float DeltaTime)
+{
+    if (CVarEconomy.GetValueOnGameThread() == 0 || Economy.IsEmpty())
+    {
+        return;
+    }
+
+    const float StepSeconds = 1.0f / FMath::Max(0.1f, CVarEconomyRate.GetValueOnGameThread());
+    const int32 NumSteps = Economy.Advance(DeltaTime, StepSeconds, FMath::Max(1, CVarEconomyMaxStepsPerTick.GetValueOnGameThread()));
+    if (NumSteps == 0)
+    {
+        return;
+    }
+
+    // Not broadcast: listeners would receive a full state copy at the simulation rate
+    WorldState.Economy = Economy.GetMetrics();
+
+    const FWorldForgeEconomy::FStats& Stats = Economy.GetStats();
+    UE_LOG(LogTemp, VeryVerbose, TEXT("WorldForge: Economy ran %d step(s) over %d settlements and %d routes, last %.3f ms"),
+           NumSteps, Economy.Num(), Economy.NumTradeRoutes(), Stats.LastStepMs);
+}
+
+bool UWorldForgeSubsystem::GetSettlementEconomy(const FString& LandmarkId, float& OutPopulation, float& OutFood, float& OutGoods, float& OutWealth) const
+{
+    const int32 Index = Economy.FindIndex(LandmarkId);
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+
+    OutPopulation = Economy.GetPopulation(Index);
+    OutFood = Economy.GetFood(Index);
+    OutGoods = Economy.GetGoods(Index);
+    OutWealth = Economy.GetWealth(Index);
+    return true;
+}
+
+void UWorldForgeSubsystem::ResetEconomy()
+{
+    Economy.Reset();
+    WorldState.Economy = Economy.GetMetrics();
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Economy reset (%d settlements)"), Economy.Num());
+}
+
+bool UWorldForgeSubsystem::SimulateHistory(int32 Years)
+{
+    if (HistoryJob.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldForge: History simulation already running (%d of %d years)"),
+               HistoryJob->GetYearsCompleted(), HistoryJob->GetYears());
+        return false;
+    }
+
+    constexpr int32 MaxYears = 10000;
+    Years = FMath::Clamp(Years, 1, MaxYears);
+
+    // The worker owns a snapshot; landmarks spawned or destroyed meanwhile are reconciled in CommitHistory
+    TSharedRef<FWorldForgeHistoryJob, ESPMode::ThreadSafe> Job = MakeShared<FWorldForgeHistoryJob, ESPMode::ThreadSafe>(GetSnapshot(), Years, WaterMap);
+    HistoryJob = Job;
+    ReportedHistoryYears = 0;
+
+    TWeakObjectPtr<UWorldForgeSubsystem> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job, WeakThis]()
+    {
+        Job->Run();
+
+        AsyncTask(ENamedThreads::GameThread, [Job, WeakThis]()
+        {
+            if (UWorldForgeSubsystem* Subsystem = WeakThis.Get())
+            {
+                Subsystem->CommitHistory(Job);
+            }
+        });
+    });
+
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Simulating %d years of history from %d landmarks"), Years, LandmarkStore.Num());
+    return true;
+}
+
+void UWorldForgeSubsystem::CancelHistory()
+{
+    if (HistoryJob.IsValid())
+    {
+        HistoryJob->Cancel();
+        UE_LOG(LogTemp, Log, TEXT("WorldForge: Cancelling history simulation at year %d of %d"),
+               HistoryJob->GetYearsCompleted(), HistoryJob->GetYears());
+    }
+}
+
+float UWorldForgeSubsystem::GetHistoryProgress() const
+{
+    return HistoryJob.IsValid() ? static_cast<float>(HistoryJob->GetYearsCompleted()) / HistoryJob->GetYears() : 0.0f;
+}
+
+void UWorldForgeSubsystem::UpdateHistoryProgress()
+{
+    const int32 YearsCompleted = HistoryJob->GetYearsCompleted();
+    if (YearsCompleted == ReportedHistoryYears)
+    {
+        return;
+    }
+    ReportedHistoryYears = YearsCompleted;
+
+    OnHistoryProgress.Broadcast(YearsCompleted, HistoryJob->GetYears());
+    if (WebSocketServer)
+    {
+        WebSocketServer->SendMessage(FString::Printf(
+            TEXT("{\"type\":\"HISTORY_PROGRESS\",\"completed\":%d,\"total\":%d}"),
+            YearsCompleted, HistoryJob->GetYears()));
+    }
+}
+
+void UWorldForgeSubsystem::CommitHistory(const TSharedRef<FWorldForgeHistoryJob, ESPMode::ThreadSafe>& Job)
+{
+    if (HistoryJob != Job)
+    {
+        return;
+    }
+    UpdateHistoryProgress();
+    HistoryJob.Reset();
+
+    if (Job->IsCancelled())
+    {
+        UE_LOG(LogTemp, Log, TEXT("WorldForge: History simulation cancelled after %d of %d years"), Job->GetYearsCompleted(), Job->GetYears());
+        if (WebSocketServer)
+        {
+            WebSocketServer->SendMessage(FString::Printf(
+                TEXT("{\"type\":\"HISTORY_COMPLETE\",\"cancelled\":true,\"years\":%d}"), Job->GetYearsCompleted()));
+        }
+        return;
+    }
+
+    const FWorldForgeHistoryDelta& Delta = Job->GetDelta();
+    BeginUndoStep(TEXT("SIMULATE_HISTORY"));
+
+    // A landmark destroyed while the simulation ran stays destroyed rather than coming back changed
+    TSet<FString> Gone;
+    for (const FString& LandmarkId : Delta.Removed)
+    {
+        if (CancelQueuedLandmark(LandmarkId))
+        {
+            if (Replica.ContainsLandmark(LandmarkId))
+            {
+                RecordReplicaOp(Replica.MakeRemove(LandmarkId, TickReplicaClock()));
+            }
+        }
+        else if (!RemoveLandmarkNoBroadcast(LandmarkId))
+        {
+            Gone.Add(LandmarkId);
+        }
+    }
+
+    TArray<FWorldForgeLandmark> Added = Delta.Added;
+    Added.RemoveAll([&Gone](const FWorldForgeLandmark& Landmark) { return Gone.Contains(Landmark.Id); });
+
+    // New sites inherit their founder's height; put them on the generated terrain where there is one
+    TArray<FVector2f> Positions;
+    Positions.Reserve(Added.Num());
+    for (const FWorldForgeLandmark& Landmark : Added)
+    {
+        Positions.Emplace(static_cast<float>(Landmark.Location.X), static_cast<float>(Landmark.Location.Y));
+    }
+    TArray<float> Heights;
+    TArray<bool> bOnTerrain;
+    Heights.SetNumZeroed(Added.Num());
+    bOnTerrain.SetNumZeroed(Added.Num());
+    HeightCache->QueryHeights(Positions, Heights, bOnTerrain);
+    for (int32 Index = 0; Index < Added.Num(); ++Index)
+    {
+        if (bOnTerrain[Index])
+        {
+            Added[Index].Location.Z = Heights[Index] + 50.0f;
+        }
+    }
+
+    QueueLandmarks(Added);
+    EndUndoStep();
+
+    // Added landmarks broadcast as they spawn; the removals go out together
+    if (Gone.Num() < Delta.Removed.Num())
+    {
+        BroadcastWorldStateChanged();
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Simulated %d years in %.2f s (%.0f years/s): %d founded, %d ruined, %d resettled; queued %d landmarks, replaced %d"),
+           Delta.YearsSimulated, Job->GetSeconds(), Job->GetSeconds() > 0.0 ? Delta.YearsSimulated / Job->GetSeconds() : 0.0,
+           Delta.Founded, Delta.Ruined, Delta.Resettled, Added.Num(), Delta.Removed.Num() - Gone.Num());
+
+    if (WebSocketServer)
+    {
+        WebSocketServer->SendMessage(FString::Printf(
+            TEXT("{\"type\":\"HISTORY_COMPLETE\",\"cancelled\":false,\"years\":%d,\"added\":%d,\"removed\":%d}"),
+            Delta.YearsSimulated, Added.Num(), Delta.Removed.Num() - Gone.Num()));
+    }
+}
+
+void UWorldForgeSubsystem::PrepareOutcomes(const FString& DilemmaId, TArray<FWorldForgeOutcome>&& Outcomes)
+{
+    DiscardOutcomes();
+
+    const bool bScatter = bScatterEnabled && !HeightCache->IsEmpty();
+    const TArray<FWorldForgeScatterLayerParams>& CurrentLayers = Scatter.GetLayers();
+    const float LandmarkRadius = Scatter.GetMaxLandmarkRadius();
+    const FVector2D PlayerLocation(GetPlayerLocation());
+    const int32 MaxNearestCells = FMath::Max(0, CVarOutcomeScatterCells.GetValueOnGameThread());
+
+    TArray<TArray<FWorldForgeOutcomeScatterCell>> ScatterCells;
+    ScatterCells.SetNum(Outcomes.Num());
+    TArray<const FWorldForgeSpatialEntry*> Entries;
+    TArray<FIntPoint> RegionCells;
+
+    const FWorldForgeUndoScalars Current = FWorldForgeUndoScalars::Make(WorldState);
+    for (int32 Index = 0; Index < Outcomes.Num(); ++Index)
+    {
+        FWorldForgeOutcome& Outcome = Outcomes[Index];
+        Outcome.Landmarks.RemoveAll([this](const FWorldForgeLandmark& Landmark) { return ContainsLandmark(Landmark.Id); });
+        Outcome.Fields.Reset();
+        FWorldForgeUndoFieldChange::Diff(Current, FWorldForgeUndoScalars::Make(Outcome.State), Outcome.Fields);
+
+        // Placement needs the spatial index and traces, so it happens here; an outcome's own landmarks keep apart too
+        TArray<FVector> Reserved;
+        TArray<FVector2D> Excluders;
+        for (FWorldForgeLandmark& Landmark : Outcome.Landmarks)
+        {
+            Landmark.Location = FindValidSpawnLocation(Landmark.Type, Reserved);
+            Reserved.Add(Landmark.Location);
+            if (FWorldForgeScatter::ExcludesScatter(Landmark.Type))
+            {
+                Excluders.Add(FVector2D(Landmark.Location));
+            }
+        }
+
+        if (!bScatter)
+        {
+            continue;
+        }
+
+        // Every layer of the cells the new landmarks clear, and the layers the outcome's traits change near the player
+        TMap<FIntPoint, uint32> CellMasks;
+        for (const FVector2D& Location : Excluders)
+        {
+            Scatter.GetCellsInRegion(FBox2D(Location - FVector2D(LandmarkRadius), Location + FVector2D(LandmarkRadius)), RegionCells);
+            for (const FIntPoint& Cell : RegionCells)
+            {
+                CellMasks.Add(Cell, FWorldForgeScatterGrid::AllLayers);
+            }
+        }
+
+        TArray<FWorldForgeScatterLayerParams> OutcomeLayers;
+        FWorldForgeScatter::MakeLayers(Outcome.State, OutcomeLayers);
+        uint32 ChangedLayers = 0;
+        for (int32 Layer = 0; Layer < OutcomeLayers.Num(); ++Layer)
+        {
+            if (!CurrentLayers.IsValidIndex(Layer) || CurrentLayers[Layer] != OutcomeLayers[Layer])
+            {
+                ChangedLayers |= 1u << Layer;
+            }
+        }
+        if (ChangedLayers != 0)
+        {
+            Scatter.GetNearestCells(PlayerLocation, MaxNearestCells, RegionCells);
+            for (const FIntPoint& Cell : RegionCells)
+            {
+                CellMasks.FindOrAdd(Cell) |= ChangedLayers;
+            }
+        }
+
+        for (const TPair<FIntPoint, uint32>& CellMask : CellMasks)
+        {
+            FWorldForgeOutcomeScatterCell& Cell = ScatterCells[Index].AddDefaulted_GetRef();
+            Cell.Cell = CellMask.Key;
+            Cell.LayerMask = CellMask.Value;
+            Cell.Bounds = Scatter.GetCellBounds(CellMask.Key);
+
+            const FVector2D Center = Cell.Bounds.GetCenter();
+            const float QueryRadius = 0.5f * Scatter.GetCellSize() * UE_SQRT_2 + LandmarkRadius;
+            SpatialIndex.QueryRadius(FVector(Center, 0.0), QueryRadius, Entries);
+            for (const FWorldForgeSpatialEntry* Entry : Entries)
+            {
+                if (FWorldForgeScatter::ExcludesScatter(Entry->Type))
+                {
+                    Cell.Landmarks.Add(FVector2D(Entry->Location));
+                }
+            }
+            for (const FVector2D& Location : Excluders)
+            {
+                if (FVector2D::DistSquared(Location, Center) <= FMath::Square(QueryRadius))
+                {
+                    Cell.Landmarks.Add(Location);
+                }
+            }
+        }
+    }
+
+    TSharedRef<FWorldForgeSpeculation, ESPMode::ThreadSafe> Job = MakeShared<FWorldForgeSpeculation, ESPMode::ThreadSafe>(
+        DilemmaId, MoveTemp(Outcomes), MoveTemp(ScatterCells), ContentRevision, HeightCache, WaterMap);
+    Speculation = Job;
+
+    TWeakObjectPtr<UWorldForgeSubsystem> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job, WeakThis]()
+    {
+        Job->Run();
+
+        AsyncTask(ENamedThreads::GameThread, [Job, WeakThis]()
+        {
+            if (UWorldForgeSubsystem* Subsystem = WeakThis.Get())
+            {
+                Subsystem->OnOutcomesPrepared(Job);
+            }
+        });
+    });
+
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Preparing outcomes of dilemma '%s'"), *DilemmaId);
+}
+
+bool UWorldForgeSubsystem::IsPreparedLocationCurrent(const FWorldForgeLandmark& Landmark) const
+{
+    if (SpatialIndex.HasAnyWithin(Landmark.Location, MinimumSpawnDistance))
+    {
+        return false;
+    }
+
+    // The same offset FindValidSpawnLocation puts above the ground, within a little of a regenerated tile
+    constexpr float HeightOffset = 50.0f;
+    constexpr float HeightTolerance = 10.0f;
+    float Height;
+    return !HeightCache->QueryHeight(static_cast<float>(Landmark.Location.X), static_cast<float>(Landmark.Location.Y), Height)
+        || FMath::IsNearlyEqual(Height + HeightOffset, static_cast<float>(Landmark.Location.Z), HeightTolerance);
+}
+
+void UWorldForgeSubsystem::OnOutcomesPrepared(const TSharedRef<FWorldForgeSpeculation, ESPMode::ThreadSafe>& Job)
+{
+    if (Speculation != Job)
+    {
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Outcomes of dilemma '%s' prepared in %.1f ms"), *Job->GetDilemmaId(), Job->GetSeconds() * 1000.0);
+    if (WebSocketServer)
+    {
+        WebSocketServer->SendMessage(FString::Printf(
+            TEXT("{\"type\":\"OUTCOMES_READY\",\"dilemmaId\":\"%s\",\"ms\":%.1f}"),
+            *Job->GetDilemmaId().ReplaceCharWithEscapedChar(), Job->GetSeconds() * 1000.0));
+    }
+}
+
+bool UWorldForgeSubsystem::CommitOutcome(const FString& DilemmaId, const FString& Choice)
+{
+    if (!Speculation.IsValid() || Speculation->GetDilemmaId() != DilemmaId)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldForge: Outcomes of dilemma '%s' were not prepared"), *DilemmaId);
+        return false;
+    }
+
+    const TSharedRef<FWorldForgeSpeculation, ESPMode::ThreadSafe> Job = Speculation.ToSharedRef();
+    const FWorldForgeOutcome* Outcome = Job->FindOutcome(Choice);
+    if (!Outcome)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldForge: Dilemma '%s' has no prepared outcome '%s'"), *DilemmaId, *Choice);
+        return false;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    Speculation.Reset();
+
+    // Only the fields the choice changes, each merged like SET_TRAIT, so edits made since it was prepared stay
+    for (const FWorldForgeUndoFieldChange& Change : Outcome->Fields)
+    {
+        MergeReplicaOp(WorldForgeCommands::MakeFieldOp(Change, CommandStamp));
+    }
+    RetargetTransitions();
+
+    // Content is used if the worker finished under the traits the world now has; scatter only if no landmark or
+    // terrain tile changed since it started
+    TArray<FWorldForgeUndoFieldChange> Drift;
+    FWorldForgeUndoFieldChange::Diff(FWorldForgeUndoScalars::Make(Outcome->State), FWorldForgeUndoScalars::Make(WorldState), Drift);
+    FWorldForgeOutcomeContent* Content = Job->IsDone() && Drift.Num() == 0 ? Job->FindContent(Choice) : nullptr;
+    const bool bUseScatter = Content && bScatterEnabled && Job->GetRevision() == ContentRevision;
+    if (bUseScatter)
+    {
+        Scatter.SetLayers(CopyTemp(Content->ScatterLayers));
+    }
+
+    // Locations were found against the landmarks and terrain of the revision the preparation started at
+    TArray<FWorldForgeLandmark> Placed;
+    TArray<FWorldForgeLandmark> Stale;
+    if (Job->GetRevision() == ContentRevision)
+    {
+        Placed = Outcome->Landmarks;
+    }
+    else
+    {
+        for (const FWorldForgeLandmark& Landmark : Outcome->Landmarks)
+        {
+            (IsPreparedLocationCurrent(Landmark) ? Placed : Stale).Add(Landmark);
+        }
+    }
+
+    if (Content)
+    {
+        // Settlement actors spawned below take their layouts from here instead of generating them
+        PreparedLayouts = MoveTemp(Content->Layouts);
+        for (const FWorldForgeLandmark& Landmark : Stale)
+        {
+            PreparedLayouts.Remove(Landmark.Id);
+        }
+        for (const FWorldForgeLandmark& Landmark : Placed)
+        {
+            AddLandmarkNoBroadcast(Landmark);
+        }
+        PreparedLayouts.Reset();
+    }
+    else
+    {
+        Job->Cancel();
+        QueueLandmarks(Placed);
+    }
+    for (const FWorldForgeLandmark& Landmark : Stale)
+    {
+        if (!ContainsLandmark(Landmark.Id) && !SpawnScheduler.Contains(Landmark.Id))
+        {
+            EnqueueLandmark(Landmark, true);
+        }
+    }
+    BroadcastWorldStateChanged();
+
+    int32 NumScatterLayers = 0;
+    if (bUseScatter)
+    {
+        FWorldForgeScatterGrid::FCellRequest Request;
+        for (const FWorldForgeOutcomeScatterCell& Cell : Content->ScatterCells)
+        {
+            // Skip cells of a grid resized since, and cells already regenerated
+            if (Cell.Layers.Num() != FWorldForgeScatter::NumLayers || !(Scatter.GetCellBounds(Cell.Cell) == Cell.Bounds)
+                || !Scatter.ClaimCell(Cell.Cell, Cell.LayerMask, Request))
+            {
+                continue;
+            }
+            for (int32 Layer = 0; Layer < FWorldForgeScatter::NumLayers; ++Layer)
+            {
+                if (Request.LayerMask & (1u << Layer))
+                {
+                    CommitScatterLayer(Cell.Cell, Layer, Request.Versions[Layer], Cell.Layers[Layer]);
+                    ++NumScatterLayers;
+                }
+            }
+        }
+    }
+
+    const double CommitMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Committed outcome '%s' of dilemma '%s' in %.2f ms (%s, %d landmarks, %d scatter layers pre-generated)"),
+           *Choice, *DilemmaId, CommitMs, Content ? TEXT("prepared") : TEXT("not ready, queued"),
+           Outcome->Landmarks.Num(), NumScatterLayers);
+
+    if (WebSocketServer)
+    {
+        WebSocketServer->SendMessage(FString::Printf(
+            TEXT("{\"type\":\"OUTCOME_COMMITTED\",\"dilemmaId\":\"%s\",\"choice\":\"%s\",\"prepared\":%s,\"ms\":%.2f}"),
+            *DilemmaId.ReplaceCharWithEscapedChar(), *Choice.ReplaceCharWithEscapedChar(),
+            Content ? TEXT("true") : TEXT("false"), CommitMs));
+    }
+    return true;
+}
+
+void UWorldForgeSubsystem::DiscardOutcomes()
+{
+    if (Speculation.IsValid())
+    {
+        Speculation->Cancel();
+        Speculation.Reset();
+    }
+    PreparedLayouts.Reset();
+}
+
+void UWorldForgeSubsystem::GenerateTerrain(int32 TilesPerSide)
+{
+    if (!GetOrCreateTerrainActor())
+    {
+        return;
+    }
+
+    // A fixed square replaces the streamed ring
+    bTerrainStreaming = false;
+    ClearTerrain();
+
+    const FWorldForgeTerrainParams Params = GetTerrainParams();
+    const FWorldForgeHydrologySettings HydrologySettings = FWorldForgeHydrologySettings::FromState(WorldState);
+    const int32 Resolution = FMath::Max(2, CVarTerrainResolution.GetValueOnGameThread());
+    const float SampleSpacing = FMath::Max(1.0f, CVarTerrainSampleSpacing.GetValueOnGameThread());
+    const uint32 RequestId = TerrainRequestId;
+    TWeakObjectPtr<UWorldForgeSubsystem> WeakThis(this);
+
+    TilesPerSide = FMath::Max(1, TilesPerSide);
+    const int32 FirstTile = -TilesPerSide / 2;
+    for (int32 TileY = FirstTile; TileY < FirstTile + TilesPerSide; ++TileY)
+    {
+        for (int32 TileX = FirstTile; TileX < FirstTile + TilesPerSide; ++TileX)
+        {
+            const FIntPoint Coord(TileX, TileY);
+
+            // Heights, water and mesh data are built on workers; only the section upload runs on the game thread
+            UE::Tasks::Launch(UE_SOURCE_LOCATION, [Params, HydrologySettings, Coord, Resolution, SampleSpacing, RequestId, WeakThis]()
+            {
+                FWorldForgeTerrainTileData TileData;
+                FWorldForgeHydrology::BuildTerrainTile(Params, HydrologySettings, Coord, Resolution, SampleSpacing, TileData);
+
+                AsyncTask(ENamedThreads::GameThread, [TileData = MoveTemp(TileData), RequestId, WeakThis]()
+                {
+                    UWorldForgeSubsystem* Subsystem = WeakThis.Get();
+                    if (Subsystem && Subsystem->TerrainRequestId == RequestId)
+                    {
+                        Subsystem->CommitTerrainTile(TileData);
+                    }
+                });
+            });
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Generating %dx%d terrain tiles (%d samples per side, seed %d)"),
+           TilesPerSide, TilesPerSide, Resolution, Params.Seed);
+}
+
+void UWorldForgeSubsystem::ClearTerrain()
+{
+    // Drop any tiles still being generated
+    ++TerrainRequestId;
+    ++ContentRevision;
+    HeightCache->Clear();
+    WaterMap->Clear();
+    TileStreamer.Reset();
+    Scatter.MarkAllDirty();
+
+    if (TerrainActor && IsValid(TerrainActor))
+    {
+        TerrainActor->ClearTiles();
+    }
+}
+
+void UWorldForgeSubsystem::CommitTerrainTile(const FWorldForgeTerrainTileData& TileData)
+{
+    AWorldForgeTerrainActor* Terrain = GetOrCreateTerrainActor();
+    if (!Terrain)
+    {
+        return;
+    }
+
+    ++ContentRevision;
+    Terrain->SetTile(TileData.Heightfield->Coord, TileData.Mesh, TileData.WaterMesh);
+    HeightCache->AddTile(TileData.Heightfield);
+    WaterMap->AddTile(TileData.Water);
+
+    // Drape the territory overlay, roads and scatter on the new ground
+    const FVector2D TileOrigin = TileData.Heightfield->GetOrigin();
+    const FBox2D TileBounds(TileOrigin, TileOrigin + FVector2D(TileData.Heightfield->GetSize()));
+    Territory.MarkRegionDirty(TileBounds);
+    Roads.InvalidateRegion(TileBounds);
+    Scatter.MarkRegionDirty(TileBounds);
+}
+
+void UWorldForgeSubsystem::SetTerrainStreamingEnabled(bool bEnabled)
+{
+    ClearTerrain();
+    bTerrainStreaming = bEnabled;
+
+    if (bEnabled)
+    {
+        TileStreamer.SetParams(GetTerrainParams(), FWorldForgeHydrologySettings::FromState(WorldState));
+    }
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Terrain streaming %s"), bEnabled ? TEXT("enabled") : TEXT("disabled"));
+}
+
+void UWorldForgeSubsystem::UpdateTerrainStreaming()
+{
+    AWorldForgeTerrainActor* Terrain = GetOrCreateTerrainActor();
+    if (!Terrain)
+    {
+        return;
+    }
+
+    FWorldForgeTileStreamer::FSettings Settings;
+    Settings.LoadRadius = CVarTerrainLoadRadius.GetValueOnGameThread();
+    Settings.CancelRadius = Settings.LoadRadius + 2;
+    Settings.MaxConcurrentJobs = CVarTerrainMaxJobs.GetValueOnGameThread();
+    Settings.MemoryBudgetBytes = static_cast<int64>(CVarTerrainMemoryBudgetMB.GetValueOnGameThread() * 1024.0f * 1024.0f);
+    Settings.Resolution = CVarTerrainResolution.GetValueOnGameThread();
+    Settings.SampleSpacing = CVarTerrainSampleSpacing.GetValueOnGameThread();
+    TileStreamer.SetSettings(Settings);
+
+    UWorld* World = GetWorld();
+    APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+    const FVector ViewDirection = PC ? PC->GetControlRotation().Vector() : FVector::ZeroVector;
+
+    TileStreamer.Update(GetPlayerLocation(), ViewDirection,
+        [this](const FWorldForgeTerrainTileData& TileData)
+        {
+            CommitTerrainTile(TileData);
+        },
+        [this, Terrain](FIntPoint Coord)
+        {
+            ++ContentRevision;
+            Terrain->RemoveTile(Coord);
+            HeightCache->RemoveTile(Coord);
+            WaterMap->RemoveTile(Coord);
+        });
+}
+
+AWorldForgeTerrainActor* UWorldForgeSubsystem::GetOrCreateTerrainActor()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    // The terrain belongs to a single world; recreate it after a map change
+    if (TerrainActor && TerrainActor->GetWorld() == World && IsValid(TerrainActor))
+    {
+        return TerrainActor;
+    }
+
+    HeightCache->Clear();
+    WaterMap->Clear();
+    TileStreamer.Reset();
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    TerrainActor = World->SpawnActor<AWorldForgeTerrainActor>(
+        AWorldForgeTerrainActor::StaticClass(),
+        FVector::ZeroVector,
+        FRotator::ZeroRotator,
+        SpawnParams
+    );
+
+    if (!TerrainActor)
+    {
+        UE_LOG(LogTemp, Error, TEXT("WorldForge: Failed to spawn terrain actor"));
+    }
+    return TerrainActor;
+}
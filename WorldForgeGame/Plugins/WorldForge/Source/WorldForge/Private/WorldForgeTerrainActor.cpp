@@ -0,0 +1,76 @@
+#include "WorldForgeTerrainActor.h"
+#include "WorldForgeTerrainGenerator.h"
+#include "ProceduralMeshComponent.h"
+
+AWorldForgeTerrainActor::AWorldForgeTerrainActor()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    TerrainMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("TerrainMesh"));
+    SetRootComponent(TerrainMesh);
+
+    // Collision is cooked off the game thread so placement traces can hit new tiles without a hitch
+    TerrainMesh->bUseAsyncCooking = true;
+    TerrainMesh->SetCollisionProfileName(TEXT("BlockAll"));
+
+    WaterMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("WaterMesh"));
+    WaterMesh->SetupAttachment(TerrainMesh);
+    WaterMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    WaterMesh->SetCastShadow(false);
+}
+
+void AWorldForgeTerrainActor::SetTile(FIntPoint Coord, const FWorldForgeTerrainMeshData& MeshData, const FWorldForgeTerrainMeshData& WaterMeshData)
+{
+    int32 Section = INDEX_NONE;
+    if (const int32* Existing = TileSections.Find(Coord))
+    {
+        Section = *Existing;
+    }
+    else
+    {
+        Section = FreeSections.Num() > 0 ? FreeSections.Pop(EAllowShrinking::No) : NextSection++;
+        TileSections.Add(Coord, Section);
+    }
+
+    TerrainMesh->CreateMeshSection_LinearColor(Section, MeshData.Vertices, MeshData.Triangles, MeshData.Normals, MeshData.UVs,
+        TArray<FLinearColor>(), TArray<FProcMeshTangent>(), true);
+
+    if (TerrainMaterial)
+    {
+        TerrainMesh->SetMaterial(Section, TerrainMaterial);
+    }
+
+    WaterMesh->ClearMeshSection(Section);
+    if (WaterMeshData.Vertices.Num() > 0)
+    {
+        WaterMesh->CreateMeshSection_LinearColor(Section, WaterMeshData.Vertices, WaterMeshData.Triangles, WaterMeshData.Normals, WaterMeshData.UVs,
+            TArray<FLinearColor>(), TArray<FProcMeshTangent>(), false);
+        if (WaterMaterial)
+        {
+            WaterMesh->SetMaterial(Section, WaterMaterial);
+        }
+    }
+}
+
+bool AWorldForgeTerrainActor::RemoveTile(FIntPoint Coord)
+{
+    int32 Section = INDEX_NONE;
+    if (!TileSections.RemoveAndCopyValue(Coord, Section))
+    {
+        return false;
+    }
+
+    TerrainMesh->ClearMeshSection(Section);
+    WaterMesh->ClearMeshSection(Section);
+    FreeSections.Add(Section);
+    return true;
+}
+
+void AWorldForgeTerrainActor::ClearTiles()
+{
+    TerrainMesh->ClearAllMeshSections();
+    WaterMesh->ClearAllMeshSections();
+    TileSections.Empty();
+    FreeSections.Empty();
+    NextSection = 0;
+}
@@ -0,0 +1,313 @@
+#include "WorldForgeTerrainGenerator.h"
+#include "Math/VectorRegister.h"
+#include "Async/ParallelFor.h"
+
+namespace WorldForgeTerrain
+{
+    // Hash constants (odd, well mixed). Signed copies are used by the vector path, whose
+    // 32-bit integer multiply wraps exactly like the unsigned scalar multiply.
+    static constexpr uint32 PrimeX = 0x27d4eb2du;
+    static constexpr uint32 PrimeY = 0x165667b1u;
+    static constexpr uint32 Mix = 0x2c1b3c6du;
+    static constexpr uint32 OctaveSalt = 0x9e3779b9u;
+    static constexpr float HashToUnit = 1.0f / 16777216.0f;
+
+    static uint32 OctaveSeed(const FWorldForgeTerrainParams& Params, int32 Octave)
+    {
+        return static_cast<uint32>(Params.Seed) + OctaveSalt * static_cast<uint32>(Octave + 1);
+    }
+
+    /** Lattice value in [0, 1) */
+    static float Hash(int32 X, int32 Y, uint32 Seed)
+    {
+        uint32 H = (static_cast<uint32>(X) * PrimeX) ^ (static_cast<uint32>(Y) * PrimeY) ^ Seed;
+        H ^= H >> 15;
+        H *= Mix;
+        H ^= H >> 12;
+        return static_cast<float>(static_cast<int32>(H & 0xffffffu)) * HashToUnit;
+    }
+
+    /** Smoothstep-interpolated value noise in [-1, 1] */
+    static float ValueNoise(float X, float Y, uint32 Seed)
+    {
+        const float X0 = FMath::FloorToFloat(X);
+        const float Y0 = FMath::FloorToFloat(Y);
+        const int32 IX = static_cast<int32>(X0);
+        const int32 IY = static_cast<int32>(Y0);
+        const float FX = X - X0;
+        const float FY = Y - Y0;
+        const float SX = FX * FX * (3.0f - (FX + FX));
+        const float SY = FY * FY * (3.0f - (FY + FY));
+
+        const float H00 = Hash(IX, IY, Seed);
+        const float H10 = Hash(IX + 1, IY, Seed);
+        const float H01 = Hash(IX, IY + 1, Seed);
+        const float H11 = Hash(IX + 1, IY + 1, Seed);
+
+        const float Top = H00 + (H10 - H00) * SX;
+        const float Bottom = H01 + (H11 - H01) * SX;
+        const float Value = Top + (Bottom - Top) * SY;
+        return Value * 2.0f - 1.0f;
+    }
+
+    /** Shaping applied to the normalized [0, 1] fractal sum */
+    static float Shape(const FWorldForgeTerrainParams& Params, float Height)
+    {
+        // Flatten: blend toward a cubic that keeps lowlands near zero
+        Height = Height + (Height * Height * Height - Height) * Params.Flatten;
+
+        if (Params.TerraceSteps > 0.0f)
+        {
+            const float Terraced = FMath::FloorToFloat(Height * Params.TerraceSteps) / Params.TerraceSteps;
+            Height = Height + (Terraced - Height) * Params.TerraceBlend;
+        }
+        return Height * Params.Amplitude;
+    }
+
+    // ---- Vector path: four adjacent samples of a row per iteration ----
+
+    static VectorRegister4Float VectorHash(const VectorRegister4Int& X, const VectorRegister4Int& Y, const VectorRegister4Int& Seed)
+    {
+        VectorRegister4Int H = VectorIntXor(
+            VectorIntXor(VectorIntMultiply(X, VectorIntSet1(static_cast<int32>(PrimeX))), VectorIntMultiply(Y, VectorIntSet1(static_cast<int32>(PrimeY)))),
+            Seed);
+        H = VectorIntXor(H, VectorShiftRightImmLogical(H, 15));
+        H = VectorIntMultiply(H, VectorIntSet1(static_cast<int32>(Mix)));
+        H = VectorIntXor(H, VectorShiftRightImmLogical(H, 12));
+        H = VectorIntAnd(H, VectorIntSet1(0xffffff));
+        return VectorMultiply(VectorIntToFloat(H), VectorSetFloat1(HashToUnit));
+    }
+
+    static VectorRegister4Float VectorValueNoise(const VectorRegister4Float& X, const VectorRegister4Float& Y, const VectorRegister4Int& Seed)
+    {
+        const VectorRegister4Float X0 = VectorFloor(X);
+        const VectorRegister4Float Y0 = VectorFloor(Y);
+        const VectorRegister4Int IX = VectorFloatToInt(X0);
+        const VectorRegister4Int IY = VectorFloatToInt(Y0);
+        const VectorRegister4Int One = VectorIntSet1(1);
+        const VectorRegister4Int IX1 = VectorIntAdd(IX, One);
+        const VectorRegister4Int IY1 = VectorIntAdd(IY, One);
+
+        const VectorRegister4Float Three = VectorSetFloat1(3.0f);
+        const VectorRegister4Float FX = VectorSubtract(X, X0);
+        const VectorRegister4Float FY = VectorSubtract(Y, Y0);
+        const VectorRegister4Float SX = VectorMultiply(VectorMultiply(FX, FX), VectorSubtract(Three, VectorAdd(FX, FX)));
+        const VectorRegister4Float SY = VectorMultiply(VectorMultiply(FY, FY), VectorSubtract(Three, VectorAdd(FY, FY)));
+
+        const VectorRegister4Float H00 = VectorHash(IX, IY, Seed);
+        const VectorRegister4Float H10 = VectorHash(IX1, IY, Seed);
+        const VectorRegister4Float H01 = VectorHash(IX, IY1, Seed);
+        const VectorRegister4Float H11 = VectorHash(IX1, IY1, Seed);
+
+        // Separate multiply and add (no fused multiply-add) so results match the scalar path
+        const VectorRegister4Float Top = VectorAdd(H00, VectorMultiply(VectorSubtract(H10, H00), SX));
+        const VectorRegister4Float Bottom = VectorAdd(H01, VectorMultiply(VectorSubtract(H11, H01), SX));
+        const VectorRegister4Float Value = VectorAdd(Top, VectorMultiply(VectorSubtract(Bottom, Top), SY));
+        return VectorSubtract(VectorMultiply(Value, VectorSetFloat1(2.0f)), VectorOne());
+    }
+}
+
+FWorldForgeTerrainParams FWorldForgeTerrainParams::FromState(const FWorldForgeState& State)
+{
+    FWorldForgeTerrainParams Params;
+    Params.Seed = State.Seed;
+
+    // Militarism -> rugged, broken ground; prosperity -> gentle, farmable land
+    Params.Amplitude = 2000.0f + 4000.0f * State.Militarism;
+    Params.Persistence = 0.4f + 0.2f * State.Militarism;
+    Params.Ridged = 0.5f * State.Militarism;
+    Params.Flatten = 0.6f * State.Prosperity;
+
+    switch (State.Atmosphere)
+    {
+    case EWorldForgeAtmosphere::Desolate:
+        // Eroded badlands: ridged, stepped mesas
+        Params.Ridged = FMath::Max(Params.Ridged, 0.8f);
+        Params.TerraceSteps = 6.0f;
+        Params.TerraceBlend = 0.7f;
+        Params.Flatten *= 0.25f;
+        break;
+
+    case EWorldForgeAtmosphere::Prosperous:
+        // Fertile plains: low, smooth rolling hills
+        Params.Amplitude *= 0.5f;
+        Params.Flatten = FMath::Max(Params.Flatten, 0.8f);
+        Params.Ridged *= 0.25f;
+        Params.Octaves = 4;
+        break;
+
+    case EWorldForgeAtmosphere::WarTorn:
+        Params.Ridged = FMath::Max(Params.Ridged, 0.5f);
+        Params.Persistence = FMath::Max(Params.Persistence, 0.55f);
+        break;
+
+    case EWorldForgeAtmosphere::Mysterious:
+        // Tall, tightly packed peaks
+        Params.Amplitude *= 1.5f;
+        Params.BaseFrequency *= 1.75f;
+        break;
+
+    default:
+        break;
+    }
+
+    return Params;
+}
+
+float FWorldForgeTerrainGenerator::SampleHeight(const FWorldForgeTerrainParams& Params, float WorldX, float WorldY)
+{
+    using namespace WorldForgeTerrain;
+
+    float Frequency = Params.BaseFrequency;
+    float Amplitude = 1.0f;
+    float Sum = 0.0f;
+    float Total = 0.0f;
+
+    for (int32 Octave = 0; Octave < Params.Octaves; ++Octave)
+    {
+        const float Noise = ValueNoise(WorldX * Frequency, WorldY * Frequency, OctaveSeed(Params, Octave));
+
+        // Ridged noise folds the signal around zero into sharp crests
+        const float Ridge = 1.0f - FMath::Abs(Noise);
+        const float Ridged = Ridge * Ridge * 2.0f - 1.0f;
+        const float Blended = Noise + (Ridged - Noise) * Params.Ridged;
+
+        Sum = Sum + Blended * Amplitude;
+        Total = Total + Amplitude;
+        Frequency = Frequency * Params.Lacunarity;
+        Amplitude = Amplitude * Params.Persistence;
+    }
+
+    const float Normalized = Total > 0.0f ? (Sum / Total) * 0.5f + 0.5f : 0.5f;
+    return Shape(Params, Normalized);
+}
+
+void FWorldForgeTerrainGenerator::GenerateRowVectorized(const FWorldForgeTerrainParams& Params, float WorldX, float WorldY, float SampleSpacing, int32 Count, float* OutHeights)
+{
+    using namespace WorldForgeTerrain;
+
+    const int32 VectorCount = Count & ~3;
+    const VectorRegister4Float Y = VectorSetFloat1(WorldY);
+    const VectorRegister4Float Lane = MakeVectorRegisterFloat(0.0f, 1.0f, 2.0f, 3.0f);
+    const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+    const VectorRegister4Float RidgedBlend = VectorSetFloat1(Params.Ridged);
+
+    for (int32 Index = 0; Index < VectorCount; Index += 4)
+    {
+        // Same expression as the scalar path: WorldX + Index * Spacing per lane
+        const VectorRegister4Float X = VectorAdd(VectorSetFloat1(WorldX), VectorMultiply(VectorAdd(VectorSetFloat1(static_cast<float>(Index)), Lane), VectorSetFloat1(SampleSpacing)));
+
+        float Frequency = Params.BaseFrequency;
+        float Amplitude = 1.0f;
+        float Total = 0.0f;
+        VectorRegister4Float Sum = VectorZero();
+
+        for (int32 Octave = 0; Octave < Params.Octaves; ++Octave)
+        {
+            const VectorRegister4Float Frequency4 = VectorSetFloat1(Frequency);
+            const VectorRegister4Int Seed = VectorIntSet1(static_cast<int32>(OctaveSeed(Params, Octave)));
+            const VectorRegister4Float Noise = VectorValueNoise(VectorMultiply(X, Frequency4), VectorMultiply(Y, Frequency4), Seed);
+
+            const VectorRegister4Float Ridge = VectorSubtract(VectorOne(), VectorAbs(Noise));
+            const VectorRegister4Float Ridged = VectorSubtract(VectorMultiply(VectorMultiply(Ridge, Ridge), VectorSetFloat1(2.0f)), VectorOne());
+            const VectorRegister4Float Blended = VectorAdd(Noise, VectorMultiply(VectorSubtract(Ridged, Noise), RidgedBlend));
+
+            Sum = VectorAdd(Sum, VectorMultiply(Blended, VectorSetFloat1(Amplitude)));
+            Total = Total + Amplitude;
+            Frequency = Frequency * Params.Lacunarity;
+            Amplitude = Amplitude * Params.Persistence;
+        }
+
+        VectorRegister4Float Normalized = Half;
+        if (Total > 0.0f)
+        {
+            Normalized = VectorAdd(VectorMultiply(VectorDivide(Sum, VectorSetFloat1(Total)), Half), Half);
+        }
+
+        // Shaping has a data-dependent floor for terraces; it is cheap next to the noise, so reuse the scalar code
+        alignas(16) float Heights[4];
+        VectorStoreAligned(Normalized, Heights);
+        for (int32 LaneIndex = 0; LaneIndex < 4; ++LaneIndex)
+        {
+            OutHeights[Index + LaneIndex] = Shape(Params, Heights[LaneIndex]);
+        }
+    }
+
+    for (int32 Index = VectorCount; Index < Count; ++Index)
+    {
+        OutHeights[Index] = SampleHeight(Params, WorldX + static_cast<float>(Index) * SampleSpacing, WorldY);
+    }
+}
+
+void FWorldForgeTerrainGenerator::GenerateTile(const FWorldForgeTerrainParams& Params, FIntPoint Coord, int32 Resolution, float SampleSpacing, FWorldForgeHeightfieldTile& OutTile)
+{
+    OutTile.Coord = Coord;
+    OutTile.Resolution = FMath::Max(Resolution, 2);
+    OutTile.SampleSpacing = SampleSpacing;
+    OutTile.Heights.SetNumUninitialized(OutTile.Resolution * OutTile.Resolution);
+
+    const FVector2D Origin = OutTile.GetOrigin();
+    for (int32 Row = 0; Row < OutTile.Resolution; ++Row)
+    {
+        const float WorldY = static_cast<float>(Origin.Y) + static_cast<float>(Row) * SampleSpacing;
+        GenerateRowVectorized(Params, static_cast<float>(Origin.X), WorldY, SampleSpacing, OutTile.Resolution, &OutTile.Heights[Row * OutTile.Resolution]);
+    }
+}
+
+void FWorldForgeTerrainGenerator::GenerateRegion(const FWorldForgeTerrainParams& Params, const FVector2D& Origin, int32 Width, int32 Height, float SampleSpacing, TArray<float>& OutHeights, bool bParallel)
+{
+    OutHeights.SetNumUninitialized(Width * Height);
+    ParallelFor(Height, [&](int32 Row)
+    {
+        const float WorldY = static_cast<float>(Origin.Y) + static_cast<float>(Row) * SampleSpacing;
+        GenerateRowVectorized(Params, static_cast<float>(Origin.X), WorldY, SampleSpacing, Width, &OutHeights[Row * Width]);
+    }, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+}
+
+void FWorldForgeTerrainGenerator::BuildMeshData(const FWorldForgeHeightfieldTile& Tile, FWorldForgeTerrainMeshData& OutMesh)
+{
+    const int32 Resolution = Tile.Resolution;
+    const float Spacing = Tile.SampleSpacing;
+    const int32 NumVertices = Resolution * Resolution;
+    const int32 NumQuads = (Resolution - 1) * (Resolution - 1);
+    const FVector2D Origin = Tile.GetOrigin();
+
+    OutMesh.Vertices.SetNumUninitialized(NumVertices);
+    OutMesh.Normals.SetNumUninitialized(NumVertices);
+    OutMesh.UVs.SetNumUninitialized(NumVertices);
+    OutMesh.Triangles.Reset(NumQuads * 6);
+
+    for (int32 Y = 0; Y < Resolution; ++Y)
+    {
+        for (int32 X = 0; X < Resolution; ++X)
+        {
+            const int32 Index = Y * Resolution + X;
+            OutMesh.Vertices[Index] = FVector(Origin.X + X * Spacing, Origin.Y + Y * Spacing, Tile.GetHeight(X, Y));
+            OutMesh.UVs[Index] = FVector2D(static_cast<float>(X) / (Resolution - 1), static_cast<float>(Y) / (Resolution - 1));
+
+            // Central differences, one-sided at the tile border
+            const int32 X0 = FMath::Max(X - 1, 0);
+            const int32 X1 = FMath::Min(X + 1, Resolution - 1);
+            const int32 Y0 = FMath::Max(Y - 1, 0);
+            const int32 Y1 = FMath::Min(Y + 1, Resolution - 1);
+            const float DX = (Tile.GetHeight(X1, Y) - Tile.GetHeight(X0, Y)) / ((X1 - X0) * Spacing);
+            const float DY = (Tile.GetHeight(X, Y1) - Tile.GetHeight(X, Y0)) / ((Y1 - Y0) * Spacing);
+            OutMesh.Normals[Index] = FVector(-DX, -DY, 1.0f).GetSafeNormal();
+        }
+    }
+
+    for (int32 Y = 0; Y < Resolution - 1; ++Y)
+    {
+        for (int32 X = 0; X < Resolution - 1; ++X)
+        {
+            const int32 Index = Y * Resolution + X;
+            OutMesh.Triangles.Add(Index);
+            OutMesh.Triangles.Add(Index + Resolution);
+            OutMesh.Triangles.Add(Index + 1);
+
+            OutMesh.Triangles.Add(Index + 1);
+            OutMesh.Triangles.Add(Index + Resolution);
+            OutMesh.Triangles.Add(Index + Resolution + 1);
+        }
+    }
+}
@@ -0,0 +1,584 @@
+#include "WorldForgeTerritory.h"
+#include "WorldForgeHeightCache.h"
+#include "Async/ParallelFor.h"
+
+namespace WorldForgeTerritory
+{
+    /** Height of the border overlay above the terrain */
+    static constexpr float OverlayOffset = 30.0f;
+
+    static constexpr int32 NeighborX[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+    static constexpr int32 NeighborY[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+
+    /** Lower weighted distance wins; exact ties go to the lower site index so results are deterministic */
+    static bool IsBetter(float Score, int32 Site, float BestScore, int32 BestSite)
+    {
+        return Score < BestScore || (Score == BestScore && Site < BestSite);
+    }
+}
+
+FWorldForgeTerritorySettings FWorldForgeTerritorySettings::FromState(const FWorldForgeState& State)
+{
+    FWorldForgeTerritorySettings Settings;
+    Settings.TypeStrength[static_cast<int32>(EWorldForgeLandmarkType::Settlement)] = 0.6f + 0.8f * State.Openness;
+    Settings.TypeStrength[static_cast<int32>(EWorldForgeLandmarkType::Fortress)] = 0.6f + 0.9f * State.Militarism;
+    Settings.TypeStrength[static_cast<int32>(EWorldForgeLandmarkType::Monastery)] = 0.7f;
+    Settings.TypeStrength[static_cast<int32>(EWorldForgeLandmarkType::Ruin)] = 0.25f;
+    Settings.TypeStrength[static_cast<int32>(EWorldForgeLandmarkType::Natural)] = 0.0f;
+    Settings.ContestedRatio = 0.05f + 0.2f * State.Militarism;
+    return Settings;
+}
+
+bool FWorldForgeTerritorySettings::operator==(const FWorldForgeTerritorySettings& Other) const
+{
+    for (int32 Type = 0; Type < UE_ARRAY_COUNT(TypeStrength); ++Type)
+    {
+        if (TypeStrength[Type] != Other.TypeStrength[Type])
+        {
+            return false;
+        }
+    }
+    return Resolution == Other.Resolution
+        && CellSize == Other.CellSize
+        && BaseReach == Other.BaseReach
+        && ContestedRatio == Other.ContestedRatio;
+}
+
+void FWorldForgeTerritoryMap::SetSettings(const FWorldForgeTerritorySettings& InSettings)
+{
+    FWorldForgeTerritorySettings NewSettings = InSettings;
+    NewSettings.Resolution = FMath::Max(1, NewSettings.Resolution);
+    NewSettings.CellSize = FMath::Max(1.0f, NewSettings.CellSize);
+    if (NewSettings == Settings)
+    {
+        return;
+    }
+
+    // Strengths change every site's reach, so nothing short of a rebuild is correct
+    Settings = NewSettings;
+    for (FSite& Site : Sites)
+    {
+        Site.Strength = FMath::Max(Settings.GetStrength(Site.Type), UE_KINDA_SMALL_NUMBER);
+    }
+    bNeedsRebuild = true;
+}
+
+bool FWorldForgeTerritoryMap::AddSite(const FWorldForgeLandmark& Landmark)
+{
+    const float Strength = Settings.GetStrength(Landmark.Type);
+    if (Strength <= 0.0f || SiteIndices.Contains(Landmark.Id))
+    {
+        return false;
+    }
+
+    FSite Site;
+    Site.Id = Landmark.Id;
+    Site.Location = FVector2f(static_cast<float>(Landmark.Location.X), static_cast<float>(Landmark.Location.Y));
+    Site.Type = Landmark.Type;
+    Site.Strength = Strength;
+    Site.Color = FLinearColor::MakeFromHSV8(static_cast<uint8>(GetTypeHash(Landmark.Id)), 180, 230);
+
+    const int32 Index = Sites.Add(MoveTemp(Site));
+    SiteIndices.Add(Landmark.Id, Index);
+    PendingAdds.Add(Index);
+    return true;
+}
+
+bool FWorldForgeTerritoryMap::RemoveSite(const FString& LandmarkId)
+{
+    int32 Index = INDEX_NONE;
+    if (!SiteIndices.RemoveAndCopyValue(LandmarkId, Index))
+    {
+        return false;
+    }
+
+    // A site that was never applied owns no cells
+    if (PendingAdds.Remove(Index) > 0)
+    {
+        Sites.RemoveAt(Index);
+        return true;
+    }
+
+    Sites[Index].bRemoved = true;
+    PendingRemoves.Add(Index);
+    return true;
+}
+
+void FWorldForgeTerritoryMap::ClearSites()
+{
+    Sites.Empty();
+    SiteIndices.Empty();
+    PendingAdds.Reset();
+    PendingRemoves.Reset();
+
+    for (int32& Owner : Owners)
+    {
+        Owner = INDEX_NONE;
+    }
+    FMemory::Memzero(Contested.GetData(), Contested.Num());
+    MarkRectDirty({ FIntPoint(0, 0), FIntPoint(Settings.Resolution, Settings.Resolution) });
+}
+
+bool FWorldForgeTerritoryMap::HasPendingChanges() const
+{
+    return bNeedsRebuild || PendingAdds.Num() > 0 || PendingRemoves.Num() > 0 || DirtyChunks.Num() > 0;
+}
+
+void FWorldForgeTerritoryMap::Update(TArray<FIntPoint>& OutDirtyChunks)
+{
+    const int32 NumCells = Settings.Resolution * Settings.Resolution;
+    if (Owners.Num() != NumCells)
+    {
+        bNeedsRebuild = true;
+    }
+
+    if (!bNeedsRebuild)
+    {
+        // Each incremental change visits the cells in its reach a few times; once that adds up to
+        // more than the grid, a jump flooding rebuild is cheaper
+        int64 Work = 0;
+        for (const int32 Index : PendingAdds)
+        {
+            Work += GetReachRect(Sites[Index]).Area();
+        }
+        for (const int32 Index : PendingRemoves)
+        {
+            Work += GetReachRect(Sites[Index]).Area();
+        }
+        bNeedsRebuild = Work > NumCells;
+    }
+
+    if (bNeedsRebuild)
+    {
+        Rebuild();
+    }
+    else if (PendingAdds.Num() > 0 || PendingRemoves.Num() > 0)
+    {
+        TArray<FCellRect, TInlineAllocator<8>> Changed;
+        for (const int32 Index : PendingRemoves)
+        {
+            const FCellRect Rect = GetReachRect(Sites[Index]);
+            ReassignCells(Index, Rect);
+            Changed.Add(Rect);
+        }
+        FreeRemovedSites();
+
+        for (const int32 Index : PendingAdds)
+        {
+            const FCellRect Rect = GetReachRect(Sites[Index]);
+            ApplySite(Index, Rect);
+            Changed.Add(Rect);
+        }
+        PendingAdds.Reset();
+
+        // Contested flags and borders depend on neighbouring owners, so they change one cell further out
+        for (const FCellRect& Rect : Changed)
+        {
+            if (Rect.IsEmpty())
+            {
+                continue;
+            }
+
+            const FCellRect Grown = {
+                FIntPoint(FMath::Max(Rect.Min.X - 1, 0), FMath::Max(Rect.Min.Y - 1, 0)),
+                FIntPoint(FMath::Min(Rect.Max.X + 1, Settings.Resolution), FMath::Min(Rect.Max.Y + 1, Settings.Resolution))
+            };
+            UpdateContested(Grown);
+            MarkRectDirty(Grown);
+        }
+    }
+
+    OutDirtyChunks = DirtyChunks.Array();
+    DirtyChunks.Reset();
+}
+
+void FWorldForgeTerritoryMap::Rebuild()
+{
+    using namespace WorldForgeTerritory;
+
+    FreeRemovedSites();
+    PendingAdds.Reset();
+    bNeedsRebuild = false;
+
+    const int32 Resolution = Settings.Resolution;
+    const int32 NumCells = Resolution * Resolution;
+    Owners.Init(INDEX_NONE, NumCells);
+    Contested.Init(0, NumCells);
+    MarkRectDirty({ FIntPoint(0, 0), FIntPoint(Resolution, Resolution) });
+
+    if (Sites.Num() == 0)
+    {
+        return;
+    }
+
+    // Seed each site's own cell, then let every cell adopt the best site seen at its neighbours
+    // Step cells away, halving Step each pass (with an extra pass of 1 first to reduce errors)
+    TArray<int32> Current;
+    Current.Init(INDEX_NONE, NumCells);
+    for (auto It = Sites.CreateConstIterator(); It; ++It)
+    {
+        // Sites off the grid that reach onto it seed the nearest cell instead
+        if (GetReachRect(*It).IsEmpty())
+        {
+            continue;
+        }
+        FIntPoint Cell;
+        GetCell(It->Location.X, It->Location.Y, Cell);
+        Cell.X = FMath::Clamp(Cell.X, 0, Resolution - 1);
+        Cell.Y = FMath::Clamp(Cell.Y, 0, Resolution - 1);
+
+        int32& Seed = Current[Cell.Y * Resolution + Cell.X];
+        if (Seed == INDEX_NONE || IsBetter(GetScore(It.GetIndex(), Cell.X, Cell.Y), It.GetIndex(), GetScore(Seed, Cell.X, Cell.Y), Seed))
+        {
+            Seed = It.GetIndex();
+        }
+    }
+
+    TArray<int32, TInlineAllocator<16>> Steps = { 1 };
+    for (int32 Step = static_cast<int32>(FMath::RoundUpToPowerOfTwo(Resolution)) / 2; Step >= 1; Step /= 2)
+    {
+        Steps.Add(Step);
+    }
+
+    TArray<int32> Next;
+    Next.SetNumUninitialized(NumCells);
+    for (const int32 Step : Steps)
+    {
+        ParallelFor(Resolution, [&](int32 Y)
+        {
+            for (int32 X = 0; X < Resolution; ++X)
+            {
+                int32 Best = Current[Y * Resolution + X];
+                float BestScore = Best != INDEX_NONE ? GetScore(Best, X, Y) : TNumericLimits<float>::Max();
+
+                for (int32 Direction = 0; Direction < 8; ++Direction)
+                {
+                    const int32 NX = X + NeighborX[Direction] * Step;
+                    const int32 NY = Y + NeighborY[Direction] * Step;
+                    if (NX < 0 || NY < 0 || NX >= Resolution || NY >= Resolution)
+                    {
+                        continue;
+                    }
+
+                    const int32 Candidate = Current[NY * Resolution + NX];
+                    if (Candidate == INDEX_NONE || Candidate == Best)
+                    {
+                        continue;
+                    }
+
+                    const float Score = GetScore(Candidate, X, Y);
+                    if (IsBetter(Score, Candidate, BestScore, Best))
+                    {
+                        Best = Candidate;
+                        BestScore = Score;
+                    }
+                }
+                Next[Y * Resolution + X] = Best;
+            }
+        });
+        Swap(Current, Next);
+    }
+
+    // Cells out of every site's reach stay unclaimed
+    ParallelFor(Resolution, [&](int32 Y)
+    {
+        for (int32 X = 0; X < Resolution; ++X)
+        {
+            const int32 Site = Current[Y * Resolution + X];
+            if (Site != INDEX_NONE && GetScore(Site, X, Y) <= Settings.BaseReach)
+            {
+                Owners[Y * Resolution + X] = Site;
+            }
+        }
+    });
+
+    UpdateContested({ FIntPoint(0, 0), FIntPoint(Resolution, Resolution) });
+}
+
+void FWorldForgeTerritoryMap::MarkRegionDirty(const FBox2D& Region)
+{
+    const float Origin = GetGridOrigin();
+    const FCellRect Rect = {
+        FIntPoint(
+            FMath::Clamp(FMath::FloorToInt32((static_cast<float>(Region.Min.X) - Origin) / Settings.CellSize), 0, Settings.Resolution),
+            FMath::Clamp(FMath::FloorToInt32((static_cast<float>(Region.Min.Y) - Origin) / Settings.CellSize), 0, Settings.Resolution)),
+        FIntPoint(
+            FMath::Clamp(FMath::FloorToInt32((static_cast<float>(Region.Max.X) - Origin) / Settings.CellSize) + 1, 0, Settings.Resolution),
+            FMath::Clamp(FMath::FloorToInt32((static_cast<float>(Region.Max.Y) - Origin) / Settings.CellSize) + 1, 0, Settings.Resolution))
+    };
+    MarkRectDirty(Rect);
+}
+
+const FString* FWorldForgeTerritoryMap::GetOwnerAt(float X, float Y) const
+{
+    FIntPoint Cell;
+    return GetCell(X, Y, Cell) ? GetCellOwner(Cell.Y * Settings.Resolution + Cell.X) : nullptr;
+}
+
+bool FWorldForgeTerritoryMap::IsContestedAt(float X, float Y) const
+{
+    FIntPoint Cell;
+    if (!GetCell(X, Y, Cell))
+    {
+        return false;
+    }
+
+    const int32 Index = Cell.Y * Settings.Resolution + Cell.X;
+    return Contested.IsValidIndex(Index) && Contested[Index] != 0 && GetCellOwner(Index) != nullptr;
+}
+
+const FString* FWorldForgeTerritoryMap::GetCellOwner(int32 Cell) const
+{
+    const int32 Owner = Owners.IsValidIndex(Cell) ? Owners[Cell] : INDEX_NONE;
+
+    // Removed sites give up their cells immediately, even before Update reassigns them
+    if (Owner == INDEX_NONE || !Sites.IsValidIndex(Owner) || Sites[Owner].bRemoved)
+    {
+        return nullptr;
+    }
+    return &Sites[Owner].Id;
+}
+
+void FWorldForgeTerritoryMap::BuildChunkMesh(FIntPoint Chunk, const FWorldForgeHeightCache* Heights, FWorldForgeTerritoryMeshData& OutMesh) const
+{
+    using namespace WorldForgeTerritory;
+
+    OutMesh = FWorldForgeTerritoryMeshData();
+
+    const int32 Resolution = Settings.Resolution;
+    if (Owners.Num() != Resolution * Resolution)
+    {
+        return;
+    }
+
+    const float Origin = GetGridOrigin();
+    const int32 MinX = Chunk.X * ChunkCells;
+    const int32 MinY = Chunk.Y * ChunkCells;
+    const int32 MaxX = FMath::Min(MinX + ChunkCells, Resolution);
+    const int32 MaxY = FMath::Min(MinY + ChunkCells, Resolution);
+
+    for (int32 Y = MinY; Y < MaxY; ++Y)
+    {
+        for (int32 X = MinX; X < MaxX; ++X)
+        {
+            const int32 Owner = Owners[Y * Resolution + X];
+            if (Owner == INDEX_NONE)
+            {
+                continue;
+            }
+
+            // Only borders (including the edge of the grid) and contested cells are drawn
+            const bool bContested = Contested[Y * Resolution + X] != 0;
+            bool bBorder = X == 0 || Y == 0 || X == Resolution - 1 || Y == Resolution - 1;
+            for (int32 Direction = 0; Direction < 8 && !bBorder; Direction += 2)
+            {
+                bBorder = Owners[(Y + NeighborY[Direction]) * Resolution + X + NeighborX[Direction]] != Owner;
+            }
+            if (!bBorder && !bContested)
+            {
+                continue;
+            }
+
+            const FVector2f Center = GetCellCenter(X, Y);
+            float Ground = 0.0f;
+            if (Heights)
+            {
+                Heights->QueryHeight(Center.X, Center.Y, Ground);
+            }
+
+            const float Z = Ground + OverlayOffset;
+            const float X0 = Origin + X * Settings.CellSize;
+            const float Y0 = Origin + Y * Settings.CellSize;
+            const int32 First = OutMesh.Vertices.Num();
+            OutMesh.Vertices.Add(FVector(X0, Y0, Z));
+            OutMesh.Vertices.Add(FVector(X0, Y0 + Settings.CellSize, Z));
+            OutMesh.Vertices.Add(FVector(X0 + Settings.CellSize, Y0, Z));
+            OutMesh.Vertices.Add(FVector(X0 + Settings.CellSize, Y0 + Settings.CellSize, Z));
+            OutMesh.Triangles.Append({ First, First + 1, First + 2, First + 2, First + 1, First + 3 });
+
+            const FLinearColor Color = bContested ? FMath::Lerp(Sites[Owner].Color, FLinearColor::Red, 0.6f) : Sites[Owner].Color;
+            OutMesh.Colors.Append({ Color, Color, Color, Color });
+        }
+    }
+}
+
+FVector2f FWorldForgeTerritoryMap::GetCellCenter(int32 X, int32 Y) const
+{
+    const float Origin = GetGridOrigin();
+    return FVector2f(Origin + (X + 0.5f) * Settings.CellSize, Origin + (Y + 0.5f) * Settings.CellSize);
+}
+
+bool FWorldForgeTerritoryMap::GetCell(float X, float Y, FIntPoint& OutCell) const
+{
+    const float Origin = GetGridOrigin();
+    OutCell.X = FMath::FloorToInt32((X - Origin) / Settings.CellSize);
+    OutCell.Y = FMath::FloorToInt32((Y - Origin) / Settings.CellSize);
+    return OutCell.X >= 0 && OutCell.Y >= 0 && OutCell.X < Settings.Resolution && OutCell.Y < Settings.Resolution;
+}
+
+float FWorldForgeTerritoryMap::GetScore(int32 SiteIndex, int32 X, int32 Y) const
+{
+    const FSite& Site = Sites[SiteIndex];
+    return FVector2f::Distance(GetCellCenter(X, Y), Site.Location) / Site.Strength;
+}
+
+FWorldForgeTerritoryMap::FCellRect FWorldForgeTerritoryMap::GetReachRect(const FSite& Site) const
+{
+    const float Origin = GetGridOrigin();
+    const float Reach = Settings.BaseReach * Site.Strength;
+    return {
+        FIntPoint(
+            FMath::Clamp(FMath::FloorToInt32((Site.Location.X - Reach - Origin) / Settings.CellSize), 0, Settings.Resolution),
+            FMath::Clamp(FMath::FloorToInt32((Site.Location.Y - Reach - Origin) / Settings.CellSize), 0, Settings.Resolution)),
+        FIntPoint(
+            FMath::Clamp(FMath::FloorToInt32((Site.Location.X + Reach - Origin) / Settings.CellSize) + 1, 0, Settings.Resolution),
+            FMath::Clamp(FMath::FloorToInt32((Site.Location.Y + Reach - Origin) / Settings.CellSize) + 1, 0, Settings.Resolution))
+    };
+}
+
+void FWorldForgeTerritoryMap::ApplySite(int32 SiteIndex, const FCellRect& Rect)
+{
+    using namespace WorldForgeTerritory;
+
+    if (Rect.IsEmpty())
+    {
+        return;
+    }
+
+    const int32 Resolution = Settings.Resolution;
+    ParallelFor(Rect.Max.Y - Rect.Min.Y, [&](int32 Row)
+    {
+        const int32 Y = Rect.Min.Y + Row;
+        for (int32 X = Rect.Min.X; X < Rect.Max.X; ++X)
+        {
+            const float Score = GetScore(SiteIndex, X, Y);
+            if (Score > Settings.BaseReach)
+            {
+                continue;
+            }
+
+            int32& Owner = Owners[Y * Resolution + X];
+            if (Owner == INDEX_NONE || IsBetter(Score, SiteIndex, GetScore(Owner, X, Y), Owner))
+            {
+                Owner = SiteIndex;
+            }
+        }
+    });
+}
+
+void FWorldForgeTerritoryMap::ReassignCells(int32 RemovedIndex, const FCellRect& Rect)
+{
+    using namespace WorldForgeTerritory;
+
+    if (Rect.IsEmpty())
+    {
+        return;
+    }
+
+    // Only sites whose reach overlaps the removed site's can take over its cells
+    TArray<int32> Candidates;
+    for (auto It = Sites.CreateConstIterator(); It; ++It)
+    {
+        if (It->bRemoved)
+        {
+            continue;
+        }
+
+        const FCellRect Reach = GetReachRect(*It);
+        if (Reach.Min.X < Rect.Max.X && Reach.Max.X > Rect.Min.X && Reach.Min.Y < Rect.Max.Y && Reach.Max.Y > Rect.Min.Y)
+        {
+            Candidates.Add(It.GetIndex());
+        }
+    }
+
+    const int32 Resolution = Settings.Resolution;
+    ParallelFor(Rect.Max.Y - Rect.Min.Y, [&](int32 Row)
+    {
+        const int32 Y = Rect.Min.Y + Row;
+        for (int32 X = Rect.Min.X; X < Rect.Max.X; ++X)
+        {
+            int32& Owner = Owners[Y * Resolution + X];
+            if (Owner != RemovedIndex)
+            {
+                continue;
+            }
+
+            int32 Best = INDEX_NONE;
+            float BestScore = Settings.BaseReach;
+            for (const int32 Candidate : Candidates)
+            {
+                const float Score = GetScore(Candidate, X, Y);
+                if (Score <= Settings.BaseReach && (Best == INDEX_NONE || IsBetter(Score, Candidate, BestScore, Best)))
+                {
+                    Best = Candidate;
+                    BestScore = Score;
+                }
+            }
+            Owner = Best;
+        }
+    });
+}
+
+void FWorldForgeTerritoryMap::UpdateContested(const FCellRect& Rect)
+{
+    using namespace WorldForgeTerritory;
+
+    if (Rect.IsEmpty())
+    {
+        return;
+    }
+
+    const int32 Resolution = Settings.Resolution;
+    ParallelFor(Rect.Max.Y - Rect.Min.Y, [&](int32 Row)
+    {
+        const int32 Y = Rect.Min.Y + Row;
+        for (int32 X = Rect.Min.X; X < Rect.Max.X; ++X)
+        {
+            const int32 Owner = Owners[Y * Resolution + X];
+            uint8 bContested = 0;
+            if (Owner != INDEX_NONE)
+            {
+                // A rival holding a neighbouring cell that is nearly as strong here contests it
+                const float Threshold = GetScore(Owner, X, Y) * (1.0f + Settings.ContestedRatio);
+                for (int32 Direction = 0; Direction < 8 && !bContested; ++Direction)
+                {
+                    const int32 NX = X + NeighborX[Direction];
+                    const int32 NY = Y + NeighborY[Direction];
+                    if (NX < 0 || NY < 0 || NX >= Resolution || NY >= Resolution)
+                    {
+                        continue;
+                    }
+
+                    const int32 Rival = Owners[NY * Resolution + NX];
+                    bContested = Rival != INDEX_NONE && Rival != Owner && GetScore(Rival, X, Y) <= Threshold;
+                }
+            }
+            Contested[Y * Resolution + X] = bContested;
+        }
+    });
+}
+
+void FWorldForgeTerritoryMap::MarkRectDirty(const FCellRect& Rect)
+{
+    if (Rect.IsEmpty())
+    {
+        return;
+    }
+
+    for (int32 ChunkY = Rect.Min.Y / ChunkCells; ChunkY <= (Rect.Max.Y - 1) / ChunkCells; ++ChunkY)
+    {
+        for (int32 ChunkX = Rect.Min.X / ChunkCells; ChunkX <= (Rect.Max.X - 1) / ChunkCells; ++ChunkX)
+        {
+            DirtyChunks.Add(FIntPoint(ChunkX, ChunkY));
+        }
+    }
+}
+
+void FWorldForgeTerritoryMap::FreeRemovedSites()
+{
+    for (const int32 Index : PendingRemoves)
+    {
+        Sites.RemoveAt(Index);
+    }
+    PendingRemoves.Reset();
+}
@@ -0,0 +1,51 @@
+#include "WorldForgeTerritoryActor.h"
+#include "WorldForgeTerritory.h"
+#include "ProceduralMeshComponent.h"
+#include "Materials/MaterialInterface.h"
+#include "UObject/ConstructorHelpers.h"
+
+AWorldForgeTerritoryActor::AWorldForgeTerritoryActor()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    OverlayMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("OverlayMesh"));
+    SetRootComponent(OverlayMesh);
+    OverlayMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    OverlayMesh->SetCastShadow(false);
+
+    static ConstructorHelpers::FObjectFinder<UMaterialInterface> VertexColorMaterial(TEXT("/Engine/EngineDebugMaterials/VertexColorMaterial"));
+    if (VertexColorMaterial.Succeeded())
+    {
+        OverlayMaterial = VertexColorMaterial.Object;
+    }
+}
+
+void AWorldForgeTerritoryActor::SetChunk(FIntPoint Chunk, const FWorldForgeTerritoryMeshData& MeshData)
+{
+    const int32* Existing = ChunkSections.Find(Chunk);
+    if (MeshData.Vertices.Num() == 0)
+    {
+        if (Existing)
+        {
+            OverlayMesh->ClearMeshSection(*Existing);
+        }
+        return;
+    }
+
+    // Chunks keep their section once created; the grid is small enough that sections are never freed
+    const int32 Section = Existing ? *Existing : ChunkSections.Add(Chunk, NextSection++);
+    OverlayMesh->CreateMeshSection_LinearColor(Section, MeshData.Vertices, MeshData.Triangles, TArray<FVector>(), TArray<FVector2D>(),
+        MeshData.Colors, TArray<FProcMeshTangent>(), false);
+
+    if (OverlayMaterial)
+    {
+        OverlayMesh->SetMaterial(Section, OverlayMaterial);
+    }
+}
+
+void AWorldForgeTerritoryActor::ClearChunks()
+{
+    OverlayMesh->ClearAllMeshSections();
+    ChunkSections.Empty();
+    NextSection = 0;
+}
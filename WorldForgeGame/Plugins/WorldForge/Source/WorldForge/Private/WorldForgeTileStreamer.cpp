@@ -0,0 +1,286 @@
+#include "WorldForgeTileStreamer.h"
+#include "HAL/PlatformTime.h"
+#include "Tasks/Task.h"
+
+namespace WorldForgeTileStreaming
+{
+    static int64 EstimateMeshBytes(const FWorldForgeTerrainMeshData& MeshData)
+    {
+        return static_cast<int64>(MeshData.Vertices.GetAllocatedSize())
+            + MeshData.Normals.GetAllocatedSize()
+            + MeshData.UVs.GetAllocatedSize()
+            + MeshData.Triangles.GetAllocatedSize();
+    }
+
+    /** Approximate memory for a tile: heights and water plus the mesh data uploaded for them */
+    static int64 EstimateTileBytes(const FWorldForgeTerrainTileData& Data)
+    {
+        return static_cast<int64>(Data.Heightfield->GetAllocatedSize())
+            + (Data.Water.IsValid() ? Data.Water->GetAllocatedSize() : 0)
+            + EstimateMeshBytes(Data.Mesh)
+            + EstimateMeshBytes(Data.WaterMesh);
+    }
+}
+
+FWorldForgeTileStreamer::FWorldForgeTileStreamer()
+    : Completed(MakeShared<FCompletedQueue, ESPMode::ThreadSafe>())
+{
+}
+
+FWorldForgeTileStreamer::~FWorldForgeTileStreamer()
+{
+    Reset();
+}
+
+void FWorldForgeTileStreamer::SetSettings(const FSettings& NewSettings)
+{
+    const bool bTileShapeChanged = NewSettings.Resolution != Settings.Resolution
+        || NewSettings.SampleSpacing != Settings.SampleSpacing;
+
+    Settings = NewSettings;
+    Settings.Resolution = FMath::Max(2, Settings.Resolution);
+    Settings.SampleSpacing = FMath::Max(1.0f, Settings.SampleSpacing);
+    Settings.LoadRadius = FMath::Max(0, Settings.LoadRadius);
+    Settings.CancelRadius = FMath::Max(Settings.LoadRadius, Settings.CancelRadius);
+    Settings.MaxConcurrentJobs = FMath::Max(1, Settings.MaxConcurrentJobs);
+
+    if (bTileShapeChanged)
+    {
+        Reset();
+    }
+}
+
+void FWorldForgeTileStreamer::SetParams(const FWorldForgeTerrainParams& NewParams, const FWorldForgeHydrologySettings& NewHydrologySettings)
+{
+    Params = NewParams;
+    HydrologySettings = NewHydrologySettings;
+    Reset();
+}
+
+void FWorldForgeTileStreamer::Reset()
+{
+    for (auto& Pair : InFlight)
+    {
+        Pair.Value.bCancelled->store(true);
+    }
+    InFlight.Empty();
+    Resident.Empty();
+    WantedSince.Empty();
+    LastPlayerTile.Reset();
+    ResidentBytes = 0;
+    PendingTiles = 0;
+    ++Generation;
+
+    // Anything already posted belongs to the old generation
+    FCompletedTile Discarded;
+    while (Completed->Dequeue(Discarded))
+    {
+    }
+}
+
+FWorldForgeTileStreamer::FTilePtr FWorldForgeTileStreamer::FindTile(FIntPoint Coord) const
+{
+    const FResidentTile* Found = Resident.Find(Coord);
+    return Found ? Found->Tile : FTilePtr();
+}
+
+FIntPoint FWorldForgeTileStreamer::GetTileCoord(const FVector& Location) const
+{
+    const float TileSize = GetTileSize();
+    return FIntPoint(
+        FMath::FloorToInt32(Location.X / TileSize),
+        FMath::FloorToInt32(Location.Y / TileSize));
+}
+
+void FWorldForgeTileStreamer::Update(const FVector& PlayerLocation, const FVector& ViewDirection,
+                                     TFunctionRef<void(const FWorldForgeTerrainTileData& TileData)> OnLoaded,
+                                     TFunctionRef<void(FIntPoint Coord)> OnEvicted)
+{
+    const double Now = FPlatformTime::Seconds();
+    const FIntPoint PlayerTile = GetTileCoord(PlayerLocation);
+
+    // Commit finished tiles that are still wanted
+    FCompletedTile Result;
+    while (Completed->Dequeue(Result))
+    {
+        if (Result.Generation != Generation || !InFlight.Remove(Result.Coord))
+        {
+            continue;
+        }
+
+        const FIntPoint Coord = Result.Coord;
+        FResidentTile& Entry = Resident.Add(Coord);
+        Entry.Tile = Result.Data.Heightfield;
+        Entry.Bytes = WorldForgeTileStreaming::EstimateTileBytes(Result.Data);
+        Entry.LastUsed = Now;
+        ResidentBytes += Entry.Bytes;
+
+        double RequestedAt = Now;
+        if (WantedSince.RemoveAndCopyValue(Coord, RequestedAt))
+        {
+            const double Latency = Now - RequestedAt;
+            TotalLatencySeconds += Latency;
+            MaxLatencySeconds = FMath::Max(MaxLatencySeconds, Latency);
+            ++LatencySamples;
+        }
+        ++TilesLoaded;
+
+        OnLoaded(Result.Data);
+    }
+
+    // A miss is entering a tile that is not ready yet
+    if (!LastPlayerTile.IsSet() || LastPlayerTile.GetValue() != PlayerTile)
+    {
+        ++TileEntries;
+        if (!Resident.Contains(PlayerTile))
+        {
+            ++TileMisses;
+        }
+        LastPlayerTile = PlayerTile;
+    }
+
+    // Jobs for tiles the player has moved well away from are no longer worth finishing
+    for (auto It = InFlight.CreateIterator(); It; ++It)
+    {
+        if (TileDistance(It.Key(), PlayerTile) > Settings.CancelRadius)
+        {
+            CancelJob(It);
+        }
+    }
+    for (auto It = WantedSince.CreateIterator(); It; ++It)
+    {
+        if (TileDistance(It.Key(), PlayerTile) > Settings.LoadRadius)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    // Collect missing tiles in the load radius and order them: nearest first, in front of the player before behind
+    struct FCandidate
+    {
+        FIntPoint Coord;
+        float Priority;
+    };
+    TArray<FCandidate> Candidates;
+
+    const float TileSize = GetTileSize();
+    const FVector2D PlayerPosition(PlayerLocation.X, PlayerLocation.Y);
+    const FVector2D Forward = FVector2D(ViewDirection.X, ViewDirection.Y).GetSafeNormal();
+
+    for (int32 Y = PlayerTile.Y - Settings.LoadRadius; Y <= PlayerTile.Y + Settings.LoadRadius; ++Y)
+    {
+        for (int32 X = PlayerTile.X - Settings.LoadRadius; X <= PlayerTile.X + Settings.LoadRadius; ++X)
+        {
+            const FIntPoint Coord(X, Y);
+            if (FResidentTile* Entry = Resident.Find(Coord))
+            {
+                Entry->LastUsed = Now;
+                continue;
+            }
+
+            WantedSince.FindOrAdd(Coord, Now);
+            if (InFlight.Contains(Coord))
+            {
+                continue;
+            }
+
+            const FVector2D Center((X + 0.5f) * TileSize, (Y + 0.5f) * TileSize);
+            const FVector2D ToTile = Center - PlayerPosition;
+            const float Distance = ToTile.Size() / TileSize;
+            const float Facing = Forward.IsNearlyZero() ? 0.0f : FVector2D::DotProduct(ToTile.GetSafeNormal(), Forward);
+            Candidates.Add({ Coord, Distance * (1.0f - Settings.ViewDirectionWeight * 0.5f * Facing) });
+        }
+    }
+
+    Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.Priority < B.Priority; });
+
+    int32 Launched = 0;
+    for (const FCandidate& Candidate : Candidates)
+    {
+        if (InFlight.Num() >= Settings.MaxConcurrentJobs)
+        {
+            break;
+        }
+        LaunchJob(Candidate.Coord);
+        ++Launched;
+    }
+    PendingTiles = Candidates.Num() - Launched;
+
+    EvictOverBudget(PlayerTile, OnEvicted);
+}
+
+void FWorldForgeTileStreamer::LaunchJob(FIntPoint Coord)
+{
+    FJob& Job = InFlight.Add(Coord);
+
+    UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [Params = Params, HydrologySettings = HydrologySettings, Coord, Resolution = Settings.Resolution, SampleSpacing = Settings.SampleSpacing,
+         bCancelled = Job.bCancelled, CompletedQueue = Completed, JobGeneration = Generation]()
+    {
+        if (bCancelled->load())
+        {
+            return;
+        }
+
+        FCompletedTile Result;
+        Result.Generation = JobGeneration;
+        Result.Coord = Coord;
+        FWorldForgeHydrology::BuildTerrainTile(Params, HydrologySettings, Coord, Resolution, SampleSpacing, Result.Data);
+        if (!bCancelled->load())
+        {
+            CompletedQueue->Enqueue(MoveTemp(Result));
+        }
+    });
+}
+
+void FWorldForgeTileStreamer::CancelJob(TMap<FIntPoint, FJob>::TIterator& It)
+{
+    It.Value().bCancelled->store(true);
+    It.RemoveCurrent();
+    ++JobsCancelled;
+}
+
+void FWorldForgeTileStreamer::EvictOverBudget(FIntPoint PlayerTile, TFunctionRef<void(FIntPoint Coord)> OnEvicted)
+{
+    while (ResidentBytes > Settings.MemoryBudgetBytes)
+    {
+        // Least recently used tile outside the load radius; tiles around the player are never evicted
+        const FIntPoint* Oldest = nullptr;
+        double OldestTime = TNumericLimits<double>::Max();
+        for (const auto& Pair : Resident)
+        {
+            if (Pair.Value.LastUsed < OldestTime && TileDistance(Pair.Key, PlayerTile) > Settings.LoadRadius)
+            {
+                Oldest = &Pair.Key;
+                OldestTime = Pair.Value.LastUsed;
+            }
+        }
+        if (!Oldest)
+        {
+            break;
+        }
+
+        const FIntPoint Coord = *Oldest;
+        ResidentBytes -= Resident.FindChecked(Coord).Bytes;
+        Resident.Remove(Coord);
+        ++TilesEvicted;
+        OnEvicted(Coord);
+    }
+}
+
+FWorldForgeTileStreamingStats FWorldForgeTileStreamer::GetStats() const
+{
+    FWorldForgeTileStreamingStats Stats;
+    Stats.ResidentTiles = Resident.Num();
+    Stats.InFlightJobs = InFlight.Num();
+    Stats.PendingTiles = PendingTiles;
+    Stats.ResidentBytes = ResidentBytes;
+    Stats.TilesLoaded = TilesLoaded;
+    Stats.TilesEvicted = TilesEvicted;
+    Stats.JobsCancelled = JobsCancelled;
+    Stats.AverageLatencyMs = LatencySamples > 0 ? static_cast<float>(TotalLatencySeconds / LatencySamples * 1000.0) : 0.0f;
+    Stats.MaxLatencyMs = static_cast<float>(MaxLatencySeconds * 1000.0);
+    Stats.TileEntries = TileEntries;
+    Stats.TileMisses = TileMisses;
+    return Stats;
+}
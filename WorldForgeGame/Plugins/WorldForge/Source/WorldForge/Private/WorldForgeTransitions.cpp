@@ -0,0 +1,178 @@
+#include "WorldForgeTransitions.h"
+
+namespace
+{
+    constexpr int32 NumAtmospheres = 6;
+    constexpr int32 NumAtmosphereChannels = FWorldForgeTransitions::NumChannels - FWorldForgeTransitions::FirstAtmosphereChannel;
+
+    /** Preset look per atmosphere: fog density, fog color RGB, sun intensity, saturation, wind */
+    constexpr float AtmosphereLooks[NumAtmospheres][NumAtmosphereChannels - NumAtmospheres] = {
+        { 0.05f,  0.45f, 0.38f, 0.32f, 0.6f,  0.7f,  0.6f },    // WarTorn
+        { 0.01f,  0.75f, 0.82f, 0.9f,  1.1f,  1.1f,  0.3f },    // Prosperous
+        { 0.08f,  0.35f, 0.42f, 0.55f, 0.5f,  0.8f,  0.2f },    // Mysterious
+        { 0.02f,  0.95f, 0.88f, 0.7f,  1.2f,  0.95f, 0.1f },    // Sacred
+        { 0.03f,  0.7f,  0.6f,  0.45f, 1.3f,  0.5f,  0.8f },    // Desolate
+        { 0.015f, 0.6f,  0.8f,  0.95f, 1.15f, 1.3f,  0.4f }     // Vibrant
+    };
+
+    /** Full atmosphere rows (one-hot weights followed by the look), built once */
+    struct FAtmosphereTable
+    {
+        float Rows[NumAtmospheres][NumAtmosphereChannels];
+
+        FAtmosphereTable()
+        {
+            for (int32 Atmosphere = 0; Atmosphere < NumAtmospheres; ++Atmosphere)
+            {
+                for (int32 Weight = 0; Weight < NumAtmospheres; ++Weight)
+                {
+                    Rows[Atmosphere][Weight] = Weight == Atmosphere ? 1.0f : 0.0f;
+                }
+                for (int32 Look = 0; Look < NumAtmosphereChannels - NumAtmospheres; ++Look)
+                {
+                    Rows[Atmosphere][NumAtmospheres + Look] = AtmosphereLooks[Atmosphere][Look];
+                }
+            }
+        }
+    };
+
+    const FAtmosphereTable& GetAtmosphereTable()
+    {
+        static const FAtmosphereTable Table;
+        return Table;
+    }
+}
+
+FWorldForgeTransitions::FWorldForgeTransitions()
+{
+    Reset(FWorldForgeState());
+}
+
+void FWorldForgeTransitions::Reset(const FWorldForgeState& State)
+{
+    for (int32 Trait = 0; Trait < NumTraitChannels; ++Trait)
+    {
+        Target[Trait] = State.GetTrait(static_cast<EWorldForgeTrait>(Trait));
+    }
+
+    TargetAtmosphere = State.Atmosphere;
+    const TConstArrayView<float> Preset = GetAtmospherePreset(TargetAtmosphere);
+    for (int32 Channel = FirstAtmosphereChannel; Channel < NumChannels; ++Channel)
+    {
+        Target[Channel] = Preset[Channel - FirstAtmosphereChannel];
+    }
+
+    for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+    {
+        Start[Channel] = Target[Channel];
+        Current[Channel] = Target[Channel];
+        Progress[Channel] = 1.0f;
+        Rate[Channel] = 0.0f;
+        Easing[Channel] = EWorldForgeEasing::Linear;
+    }
+    NumActive = 0;
+}
+
+void FWorldForgeTransitions::SetTargets(const FWorldForgeState& State)
+{
+    for (int32 Trait = 0; Trait < NumTraitChannels; ++Trait)
+    {
+        const float Value = State.GetTrait(static_cast<EWorldForgeTrait>(Trait));
+        if (Value != Target[Trait])
+        {
+            Retarget(Trait, Value, Settings.TraitSeconds, Settings.TraitEasing);
+        }
+    }
+
+    if (State.Atmosphere != TargetAtmosphere)
+    {
+        // Cross-fade from wherever the blend is now, so a change mid-fade blends three presets smoothly
+        TargetAtmosphere = State.Atmosphere;
+        const TConstArrayView<float> Preset = GetAtmospherePreset(TargetAtmosphere);
+        for (int32 Channel = FirstAtmosphereChannel; Channel < NumChannels; ++Channel)
+        {
+            Retarget(Channel, Preset[Channel - FirstAtmosphereChannel], Settings.AtmosphereSeconds, Settings.AtmosphereEasing);
+        }
+    }
+}
+
+void FWorldForgeTransitions::Retarget(int32 Channel, float NewTarget, float Seconds, EWorldForgeEasing ChannelEasing)
+{
+    const bool bWasActive = Rate[Channel] > 0.0f;
+
+    Target[Channel] = NewTarget;
+    if (Seconds <= 0.0f)
+    {
+        Start[Channel] = NewTarget;
+        Current[Channel] = NewTarget;
+        Progress[Channel] = 1.0f;
+        Rate[Channel] = 0.0f;
+        NumActive -= bWasActive ? 1 : 0;
+        return;
+    }
+
+    Start[Channel] = Current[Channel];
+    Progress[Channel] = 0.0f;
+    Rate[Channel] = 1.0f / Seconds;
+    Easing[Channel] = ChannelEasing;
+    NumActive += bWasActive ? 0 : 1;
+}
+
+bool FWorldForgeTransitions::Advance(float DeltaSeconds)
+{
+    if (NumActive == 0)
+    {
+        return false;
+    }
+
+    // One branch-light pass over the packed channels; channels at rest have a zero rate and stay put
+    int32 StillActive = 0;
+    for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+    {
+        if (Rate[Channel] == 0.0f)
+        {
+            continue;
+        }
+
+        const float Alpha = FMath::Min(Progress[Channel] + DeltaSeconds * Rate[Channel], 1.0f);
+        Progress[Channel] = Alpha;
+        Current[Channel] = FMath::Lerp(Start[Channel], Target[Channel], Ease(Easing[Channel], Alpha));
+
+        if (Alpha >= 1.0f)
+        {
+            Current[Channel] = Target[Channel];
+            Rate[Channel] = 0.0f;
+        }
+        else
+        {
+            ++StillActive;
+        }
+    }
+
+    NumActive = StillActive;
+    return NumActive > 0;
+}
+
+TConstArrayView<float> FWorldForgeTransitions::GetAtmospherePreset(EWorldForgeAtmosphere Atmosphere)
+{
+    const int32 Index = FMath::Clamp(static_cast<int32>(Atmosphere), 0, NumAtmospheres - 1);
+    return MakeArrayView(GetAtmosphereTable().Rows[Index], NumAtmosphereChannels);
+}
+
+float FWorldForgeTransitions::Ease(EWorldForgeEasing Easing, float Alpha)
+{
+    switch (Easing)
+    {
+    case EWorldForgeEasing::SmoothStep:
+        return Alpha * Alpha * (3.0f - 2.0f * Alpha);
+    case EWorldForgeEasing::EaseInOutCubic:
+        return Alpha < 0.5f
+            ? 4.0f * Alpha * Alpha * Alpha
+            : 1.0f - FMath::Cube(-2.0f * Alpha + 2.0f) * 0.5f;
+    case EWorldForgeEasing::EaseOutQuad:
+        return 1.0f - (1.0f - Alpha) * (1.0f - Alpha);
+    case EWorldForgeEasing::Linear:
+    default:
+        return Alpha;
+    }
+}
@@ -0,0 +1,288 @@
+#include "WorldForgeUndo.h"
+
+namespace WorldForgeUndo
+{
+    SIZE_T GetLandmarkSize(const FWorldForgeLandmark& Landmark)
+    {
+        return Landmark.Id.GetAllocatedSize() + Landmark.Name.GetAllocatedSize() + Landmark.Description.GetAllocatedSize();
+    }
+
+    SIZE_T GetEraSize(const FWorldForgeEra& Era)
+    {
+        return Era.Id.GetAllocatedSize() + Era.Name.GetAllocatedSize() + Era.Period.GetAllocatedSize() + Era.Description.GetAllocatedSize();
+    }
+}
+
+FWorldForgeUndoScalars FWorldForgeUndoScalars::Make(const FWorldForgeState& State)
+{
+    FWorldForgeUndoScalars Scalars;
+    Scalars.Era = State.Era;
+    Scalars.Seed = State.Seed;
+    for (int32 Trait = 0; Trait < UE_ARRAY_COUNT(Scalars.Traits); ++Trait)
+    {
+        Scalars.Traits[Trait] = State.GetTrait(static_cast<EWorldForgeTrait>(Trait));
+    }
+    Scalars.Atmosphere = State.Atmosphere;
+    return Scalars;
+}
+
+void FWorldForgeUndoFieldChange::ApplyTo(FWorldForgeState& State, bool bReverse) const
+{
+    switch (Field)
+    {
+    case EWorldForgeUndoField::Era:
+        State.Era = bReverse ? OldEra : NewEra;
+        break;
+    case EWorldForgeUndoField::Seed:
+        State.Seed = bReverse ? OldSeed : NewSeed;
+        break;
+    case EWorldForgeUndoField::Trait:
+        State.SetTrait(Trait, bReverse ? OldValue : NewValue);
+        break;
+    case EWorldForgeUndoField::Atmosphere:
+        State.Atmosphere = bReverse ? OldAtmosphere : NewAtmosphere;
+        break;
+    }
+}
+
+void FWorldForgeUndoFieldChange::Diff(const FWorldForgeUndoScalars& Before, const FWorldForgeUndoScalars& After, TArray<FWorldForgeUndoFieldChange>& OutChanges)
+{
+    if (Before.Era.Id != After.Era.Id || Before.Era.Name != After.Era.Name || Before.Era.Period != After.Era.Period || Before.Era.Description != After.Era.Description)
+    {
+        FWorldForgeUndoFieldChange& Change = OutChanges.AddDefaulted_GetRef();
+        Change.Field = EWorldForgeUndoField::Era;
+        Change.OldEra = Before.Era;
+        Change.NewEra = After.Era;
+    }
+    if (Before.Seed != After.Seed)
+    {
+        FWorldForgeUndoFieldChange& Change = OutChanges.AddDefaulted_GetRef();
+        Change.Field = EWorldForgeUndoField::Seed;
+        Change.OldSeed = Before.Seed;
+        Change.NewSeed = After.Seed;
+    }
+    for (int32 Trait = 0; Trait < UE_ARRAY_COUNT(Before.Traits); ++Trait)
+    {
+        if (Before.Traits[Trait] != After.Traits[Trait])
+        {
+            FWorldForgeUndoFieldChange& Change = OutChanges.AddDefaulted_GetRef();
+            Change.Field = EWorldForgeUndoField::Trait;
+            Change.Trait = static_cast<EWorldForgeTrait>(Trait);
+            Change.OldValue = Before.Traits[Trait];
+            Change.NewValue = After.Traits[Trait];
+        }
+    }
+    if (Before.Atmosphere != After.Atmosphere)
+    {
+        FWorldForgeUndoFieldChange& Change = OutChanges.AddDefaulted_GetRef();
+        Change.Field = EWorldForgeUndoField::Atmosphere;
+        Change.OldAtmosphere = Before.Atmosphere;
+        Change.NewAtmosphere = After.Atmosphere;
+    }
+}
+
+void FWorldForgeUndoStep::ApplyFields(FWorldForgeState& State, bool bReverse) const
+{
+    for (const FWorldForgeUndoFieldChange& Change : Fields)
+    {
+        Change.ApplyTo(State, bReverse);
+    }
+}
+
+SIZE_T FWorldForgeUndoStep::GetAllocatedSize() const
+{
+    SIZE_T Size = sizeof(FWorldForgeUndoStep) + Label.GetAllocatedSize() + Fields.GetAllocatedSize()
+        + Added.GetAllocatedSize() + Removed.GetAllocatedSize() + Cancelled.GetAllocatedSize();
+    for (const FWorldForgeUndoFieldChange& Change : Fields)
+    {
+        Size += WorldForgeUndo::GetEraSize(Change.OldEra) + WorldForgeUndo::GetEraSize(Change.NewEra);
+    }
+    for (const FAdded& Entry : Added)
+    {
+        Size += WorldForgeUndo::GetLandmarkSize(Entry.Landmark);
+    }
+    for (const FWorldForgeLandmark& Landmark : Removed)
+    {
+        Size += WorldForgeUndo::GetLandmarkSize(Landmark);
+    }
+    for (const FCancelled& Entry : Cancelled)
+    {
+        Size += WorldForgeUndo::GetLandmarkSize(Entry.Landmark);
+    }
+    return Size;
+}
+
+void FWorldForgeUndoHistory::SetLimits(int32 InMaxSteps, SIZE_T InMaxBytes)
+{
+    MaxSteps = FMath::Max(InMaxSteps, 1);
+    MaxBytes = InMaxBytes;
+    Trim();
+}
+
+void FWorldForgeUndoHistory::BeginStep(const FString& Label, const FWorldForgeState& State)
+{
+    check(!Open.IsSet());
+    Open.Emplace();
+    Open->Label = Label;
+    Open->Serial = NextSerial++;
+    OpenScalars = FWorldForgeUndoScalars::Make(State);
+}
+
+void FWorldForgeUndoHistory::EndStep(const FWorldForgeState& State)
+{
+    check(Open.IsSet());
+    FWorldForgeUndoStep Step = MoveTemp(Open.GetValue());
+    Open.Reset();
+
+    FWorldForgeUndoFieldChange::Diff(OpenScalars, FWorldForgeUndoScalars::Make(State), Step.Fields);
+    OpenScalars = FWorldForgeUndoScalars();
+    if (Step.IsEmpty())
+    {
+        return;
+    }
+
+    // A new change makes the undone steps unreachable
+    Steps.SetNum(Cursor);
+    Steps.Add(MoveTemp(Step));
+    Cursor = Steps.Num();
+    Trim();
+}
+
+void FWorldForgeUndoHistory::RecordAdded(const FWorldForgeLandmark& Landmark, bool bPlaced)
+{
+    if (Open.IsSet())
+    {
+        Open->Added.Add({ Landmark, bPlaced });
+    }
+}
+
+void FWorldForgeUndoHistory::RecordRemoved(const FWorldForgeLandmark& Landmark)
+{
+    if (!Open.IsSet())
+    {
+        return;
+    }
+
+    // Created and destroyed by the same step: nothing to reverse
+    const int32 Index = Open->Added.IndexOfByPredicate([&Landmark](const FWorldForgeUndoStep::FAdded& Entry) { return Entry.Landmark.Id == Landmark.Id; });
+    if (Index != INDEX_NONE)
+    {
+        Open->Added.RemoveAt(Index);
+        return;
+    }
+    Open->Removed.Add(Landmark);
+}
+
+void FWorldForgeUndoHistory::RecordPlaced(uint32 Serial, const FWorldForgeLandmark& Landmark)
+{
+    if (FWorldForgeUndoStep* Step = FindStep(Serial))
+    {
+        for (FWorldForgeUndoStep::FAdded& Entry : Step->Added)
+        {
+            if (Entry.Landmark.Id == Landmark.Id)
+            {
+                Entry.Landmark = Landmark;
+                Entry.bPlaced = true;
+                return;
+            }
+        }
+    }
+}
+
+void FWorldForgeUndoHistory::RecordCancelled(uint32 Origin, const FWorldForgeLandmark& Landmark)
+{
+    const auto IsLandmark = [&Landmark](const FWorldForgeUndoStep::FAdded& Entry) { return Entry.Landmark.Id == Landmark.Id; };
+
+    // Queued and cancelled by the same step: nothing to reverse
+    if (Open.IsSet() && Open->Serial == Origin)
+    {
+        Open->Added.RemoveAll(IsLandmark);
+        return;
+    }
+
+    if (Open.IsSet())
+    {
+        Open->Cancelled.Add({ Landmark, Origin });
+    }
+    else if (FWorldForgeUndoStep* Step = FindStep(Origin))
+    {
+        Step->Added.RemoveAll(IsLandmark);
+    }
+}
+
+FWorldForgeUndoStep* FWorldForgeUndoHistory::Undo()
+{
+    check(!Open.IsSet());
+    return CanUndo() ? &Steps[--Cursor] : nullptr;
+}
+
+FWorldForgeUndoStep* FWorldForgeUndoHistory::Redo()
+{
+    check(!Open.IsSet());
+    return CanRedo() ? &Steps[Cursor++] : nullptr;
+}
+
+void FWorldForgeUndoHistory::Clear()
+{
+    Steps.Reset();
+    Cursor = 0;
+}
+
+FWorldForgeUndoHistory::FStats FWorldForgeUndoHistory::GetStats() const
+{
+    FStats Stats;
+    Stats.UndoSteps = Cursor;
+    Stats.RedoSteps = Steps.Num() - Cursor;
+    Stats.Evicted = Evicted;
+    Stats.Oversized = Oversized;
+    for (const FWorldForgeUndoStep& Step : Steps)
+    {
+        Stats.Bytes += Step.GetAllocatedSize();
+    }
+    return Stats;
+}
+
+FWorldForgeUndoStep* FWorldForgeUndoHistory::FindStep(uint32 Serial)
+{
+    if (Open.IsSet() && Open->Serial == Serial)
+    {
+        return &Open.GetValue();
+    }
+    return Steps.FindByPredicate([Serial](const FWorldForgeUndoStep& Step) { return Step.Serial == Serial; });
+}
+
+void FWorldForgeUndoHistory::Trim()
+{
+    if (Steps.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<SIZE_T> Sizes;
+    Sizes.Reserve(Steps.Num());
+    SIZE_T Bytes = 0;
+    for (const FWorldForgeUndoStep& Step : Steps)
+    {
+        Bytes += Sizes.Add_GetRef(Step.GetAllocatedSize());
+    }
+
+    if (Sizes.Last() > MaxBytes)
+    {
+        ++Oversized;
+        Evicted += Steps.Num() - 1;
+        Clear();
+        return;
+    }
+
+    int32 NumDropped = 0;
+    while (Steps.Num() - NumDropped > MaxSteps || Bytes > MaxBytes)
+    {
+        Bytes -= Sizes[NumDropped++];
+    }
+    if (NumDropped > 0)
+    {
+        Steps.RemoveAt(0, NumDropped);
+        Cursor = FMath::Max(0, Cursor - NumDropped);
+        Evicted += NumDropped;
+    }
+}
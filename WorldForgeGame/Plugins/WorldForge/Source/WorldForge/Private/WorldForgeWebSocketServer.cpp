@@ -4,6 +4,7 @@
 #include "Sockets.h"
 #include "Networking.h"
 #include "Async/Async.h"
+#include "Misc/ScopeLock.h"
 
 void UWorldForgeWebSocketServer::Initialize(UWorldForgeSubsystem* InOwner)
 {
@@ -58,7 +59,7 @@ bool UWorldForgeWebSocketServer::StartServer(int32 Port)
         return false;
     }
 
-    if (!ListenerSocket->Listen(1))
+    if (!ListenerSocket->Listen(8))
     {
         UE_LOG(LogTemp, Error, TEXT("WorldForge: Failed to listen on port %d"), Port);
         SocketSubsystem->DestroySocket(ListenerSocket);
@@ -89,12 +90,13 @@ void UWorldForgeWebSocketServer::StopServer()
     ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
     if (SocketSubsystem)
     {
-        if (ClientSocket)
+        FScopeLock Lock(&SessionsLock);
+        for (FSession& Session : Sessions)
         {
-            ClientSocket->Close();
-            SocketSubsystem->DestroySocket(ClientSocket);
-            ClientSocket = nullptr;
+            Session.Socket->Close();
+            SocketSubsystem->DestroySocket(Session.Socket);
         }
+        Sessions.Reset();
 
         if (ListenerSocket)
         {
@@ -112,74 +114,84 @@ uint32 UWorldForgeWebSocketServer::Run()
 {
     TArray<uint8> ReceiveBuffer;
     ReceiveBuffer.SetNumUninitialized(65536);
-    FString PartialMessage;
 
     while (!bShouldStop)
     {
         // Check for new connections
-        if (!ClientSocket && ListenerSocket)
+        bool bHasPendingConnection = false;
+        while (ListenerSocket && ListenerSocket->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
         {
-            bool bHasPendingConnection = false;
-            if (ListenerSocket->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
+            FSocket* ClientSocket = ListenerSocket->Accept(TEXT("WorldForge Client"));
+            if (!ClientSocket)
             {
-                ClientSocket = ListenerSocket->Accept(TEXT("WorldForge Client"));
-                if (ClientSocket)
-                {
-                    ClientSocket->SetNonBlocking(true);
-                    UE_LOG(LogTemp, Log, TEXT("WorldForge: Client connected"));
-
-                    // Send welcome message
-                    FString Welcome = TEXT("{\"type\":\"CONNECTED\",\"message\":\"WorldForge UE5 Ready\"}\n");
-                    int32 BytesSent = 0;
-                    ClientSocket->Send((uint8*)TCHAR_TO_UTF8(*Welcome), Welcome.Len(), BytesSent);
-                }
+                break;
             }
+            ClientSocket->SetNonBlocking(true);
+
+            FScopeLock Lock(&SessionsLock);
+            FSession& Session = Sessions.AddDefaulted_GetRef();
+            Session.Id = NextSessionId++;
+            Session.Socket = ClientSocket;
+            UE_LOG(LogTemp, Log, TEXT("WorldForge: Client connected (session %d, %d connected)"), Session.Id, Sessions.Num());
+
+            // Send welcome message
+            SendTo(Session, FString::Printf(
+                TEXT("{\"type\":\"CONNECTED\",\"message\":\"WorldForge UE5 Ready\",\"session\":%d}"), Session.Id));
         }
 
-        // Read from client
-        if (ClientSocket)
+        // Write queued messages and read from clients
         {
-            uint32 PendingDataSize = 0;
-            if (ClientSocket->HasPendingData(PendingDataSize) && PendingDataSize > 0)
+            FScopeLock Lock(&SessionsLock);
+            for (int32 Index = Sessions.Num() - 1; Index >= 0; --Index)
             {
-                int32 BytesRead = 0;
-                if (ClientSocket->Recv(ReceiveBuffer.GetData(), ReceiveBuffer.Num() - 1, BytesRead))
+                FSession& Session = Sessions[Index];
+                if (!FlushOutgoing(Session))
                 {
-                    if (BytesRead > 0)
-                    {
-                        ReceiveBuffer[BytesRead] = 0;
-                        FString ReceivedStr = UTF8_TO_TCHAR((char*)ReceiveBuffer.GetData());
-                        PartialMessage += ReceivedStr;
+                    DropSession(Index, TEXT("send failed"));
+                    continue;
+                }
+                if (Session.Outgoing.Num() > MaxOutgoingBytes)
+                {
+                    DropSession(Index, TEXT("not reading"));
+                    continue;
+                }
 
-                        // Process complete lines (messages end with newline)
-                        int32 NewlineIndex;
-                        while (PartialMessage.FindChar('\n', NewlineIndex))
-                        {
-                            FString CompleteLine = PartialMessage.Left(NewlineIndex).TrimStartAndEnd();
-                            PartialMessage = PartialMessage.Mid(NewlineIndex + 1);
-
-                            if (!CompleteLine.IsEmpty())
-                            {
-                                // Process on game thread
-                                AsyncTask(ENamedThreads::GameThread, [this, CompleteLine]()
-                                {
-                                    ProcessReceivedData(CompleteLine);
-                                });
-                            }
-                        }
-                    }
+                uint32 PendingDataSize = 0;
+                if (!Session.Socket->HasPendingData(PendingDataSize) || PendingDataSize == 0)
+                {
+                    continue;
                 }
-                else
+
+                int32 BytesRead = 0;
+                if (!Session.Socket->Recv(ReceiveBuffer.GetData(), ReceiveBuffer.Num() - 1, BytesRead))
                 {
                     // Connection lost
-                    UE_LOG(LogTemp, Log, TEXT("WorldForge: Client disconnected"));
-                    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-                    if (SocketSubsystem)
+                    DropSession(Index, TEXT("disconnected"));
+                    continue;
+                }
+                if (BytesRead <= 0)
+                {
+                    continue;
+                }
+
+                ReceiveBuffer[BytesRead] = 0;
+                Session.PartialMessage += UTF8_TO_TCHAR((char*)ReceiveBuffer.GetData());
+
+                // Process complete lines (messages end with newline)
+                int32 NewlineIndex;
+                while (Session.PartialMessage.FindChar('\n', NewlineIndex))
+                {
+                    FString CompleteLine = Session.PartialMessage.Left(NewlineIndex).TrimStartAndEnd();
+                    Session.PartialMessage = Session.PartialMessage.Mid(NewlineIndex + 1);
+
+                    if (!CompleteLine.IsEmpty())
                     {
-                        SocketSubsystem->DestroySocket(ClientSocket);
+                        // Process on game thread
+                        AsyncTask(ENamedThreads::GameThread, [this, SessionId = Session.Id, CompleteLine]()
+                        {
+                            ProcessReceivedData(SessionId, CompleteLine);
+                        });
                     }
-                    ClientSocket = nullptr;
-                    PartialMessage.Empty();
                 }
             }
         }
@@ -191,24 +203,93 @@ uint32 UWorldForgeWebSocketServer::Run()
     return 0;
 }
 
-void UWorldForgeWebSocketServer::ProcessReceivedData(const FString& Data)
+void UWorldForgeWebSocketServer::ProcessReceivedData(int32 SessionId, const FString& Data)
 {
-    UE_LOG(LogTemp, Log, TEXT("WorldForge: Received: %s"), *Data);
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Received from session %d: %s"), SessionId, *Data);
 
     // Forward to subsystem
     if (Owner)
     {
-        Owner->ProcessCommand(Data);
+        Owner->ProcessCommand(Data, SessionId);
     }
 
     // Broadcast to delegate
     OnMessageReceived.ExecuteIfBound(Data);
 
     // Send acknowledgment
-    if (ClientSocket)
+    SendMessageTo(SessionId, TEXT("{\"type\":\"ACK\",\"status\":\"ok\"}"));
+}
+
+bool UWorldForgeWebSocketServer::SendMessage(const FString& Message)
+{
+    FScopeLock Lock(&SessionsLock);
+    bool bSent = false;
+    for (FSession& Session : Sessions)
+    {
+        bSent |= SendTo(Session, Message);
+    }
+    return bSent;
+}
+
+bool UWorldForgeWebSocketServer::SendMessageTo(int32 SessionId, const FString& Message)
+{
+    FScopeLock Lock(&SessionsLock);
+    FSession* Session = Sessions.FindByPredicate([SessionId](const FSession& Entry) { return Entry.Id == SessionId; });
+    return Session && SendTo(*Session, Message);
+}
+
+int32 UWorldForgeWebSocketServer::GetNumSessions() const
+{
+    FScopeLock Lock(&SessionsLock);
+    return Sessions.Num();
+}
+
+void UWorldForgeWebSocketServer::GetSessionIds(TArray<int32>& OutIds) const
+{
+    FScopeLock Lock(&SessionsLock);
+    OutIds.Reset(Sessions.Num());
+    for (const FSession& Session : Sessions)
+    {
+        OutIds.Add(Session.Id);
+    }
+}
+
+bool UWorldForgeWebSocketServer::SendTo(FSession& Session, const FString& Message)
+{
+    // Queued whole, so a partial write never splits a line between messages
+    FTCHARToUTF8 Utf8(*(Message + TEXT("\n")));
+    Session.Outgoing.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    return true;
+}
+
+bool UWorldForgeWebSocketServer::FlushOutgoing(FSession& Session)
+{
+    while (Session.Outgoing.Num() > 0)
     {
-        FString Ack = TEXT("{\"type\":\"ACK\",\"status\":\"ok\"}\n");
         int32 BytesSent = 0;
-        ClientSocket->Send((uint8*)TCHAR_TO_UTF8(*Ack), Ack.Len(), BytesSent);
+        if (!Session.Socket->Send(Session.Outgoing.GetData(), Session.Outgoing.Num(), BytesSent))
+        {
+            ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+            return SocketSubsystem && SocketSubsystem->GetLastErrorCode() == SE_EWOULDBLOCK;
+        }
+        if (BytesSent <= 0)
+        {
+            // The socket buffer is full; the rest goes out on a later pass
+            return true;
+        }
+        Session.Outgoing.RemoveAt(0, BytesSent, EAllowShrinking::No);
+    }
+    return true;
+}
+
+void UWorldForgeWebSocketServer::DropSession(int32 Index, const TCHAR* Reason)
+{
+    FSession& Session = Sessions[Index];
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Client disconnected (session %d, %s)"), Session.Id, Reason);
+    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    if (SocketSubsystem)
+    {
+        SocketSubsystem->DestroySocket(Session.Socket);
     }
+    Sessions.RemoveAt(Index);
 }
@@ -0,0 +1,238 @@
+#include "WorldForgeWorldStore.h"
+
+const FWorldForgeLandmark* FWorldForgeLandmarkStore::Find(const FString& Id) const
+{
+    if (!Root.IsValid())
+    {
+        return nullptr;
+    }
+
+    const FChunkPtr& Chunk = Root->Chunks[GetChunkIndex(Id, Root->Chunks.Num())];
+    return Chunk.IsValid()
+        ? Chunk->Landmarks.FindByPredicate([&Id](const FWorldForgeLandmark& Landmark) { return Landmark.Id == Id; })
+        : nullptr;
+}
+
+void FWorldForgeLandmarkStore::Set(const FWorldForgeLandmark& Landmark)
+{
+    FRoot& MutableRoot = GetMutableRoot();
+    FChunk& Chunk = GetMutableChunk(MutableRoot, GetChunkIndex(Landmark.Id, MutableRoot.Chunks.Num()));
+    if (FWorldForgeLandmark* Existing = Chunk.Landmarks.FindByPredicate([&Landmark](const FWorldForgeLandmark& Entry) { return Entry.Id == Landmark.Id; }))
+    {
+        *Existing = Landmark;
+        return;
+    }
+
+    Chunk.Landmarks.Add(Landmark);
+    ++MutableRoot.Num;
+    if (MutableRoot.Num > MutableRoot.Chunks.Num() * MaxAverageChunkSize)
+    {
+        Rehash(MutableRoot.Chunks.Num() * 2);
+    }
+}
+
+bool FWorldForgeLandmarkStore::Remove(const FString& Id)
+{
+    if (!Contains(Id))
+    {
+        return false;
+    }
+
+    FRoot& MutableRoot = GetMutableRoot();
+    FChunk& Chunk = GetMutableChunk(MutableRoot, GetChunkIndex(Id, MutableRoot.Chunks.Num()));
+    Chunk.Landmarks.RemoveAllSwap([&Id](const FWorldForgeLandmark& Landmark) { return Landmark.Id == Id; });
+    --MutableRoot.Num;
+    return true;
+}
+
+void FWorldForgeLandmarkStore::Reset()
+{
+    Root.Reset();
+}
+
+void FWorldForgeLandmarkStore::ForEach(TFunctionRef<void(const FWorldForgeLandmark&)> Visitor) const
+{
+    if (!Root.IsValid())
+    {
+        return;
+    }
+
+    for (const FChunkPtr& Chunk : Root->Chunks)
+    {
+        if (Chunk.IsValid())
+        {
+            for (const FWorldForgeLandmark& Landmark : Chunk->Landmarks)
+            {
+                Visitor(Landmark);
+            }
+        }
+    }
+}
+
+void FWorldForgeLandmarkStore::ToArray(TArray<FWorldForgeLandmark>& OutLandmarks) const
+{
+    OutLandmarks.Reset(Num());
+    ForEach([&OutLandmarks](const FWorldForgeLandmark& Landmark) { OutLandmarks.Add(Landmark); });
+}
+
+void FWorldForgeLandmarkStore::Diff(const FWorldForgeLandmarkStore& Old, const FWorldForgeLandmarkStore& New, FWorldForgeLandmarkDiff& OutDiff)
+{
+    OutDiff = FWorldForgeLandmarkDiff();
+    if (Old.Root == New.Root)
+    {
+        return;
+    }
+
+    // Landmarks of Old that New no longer has, or has changed
+    auto CompareChunk = [&OutDiff, &New](const TArray<FWorldForgeLandmark>& OldLandmarks)
+    {
+        for (const FWorldForgeLandmark& Before : OldLandmarks)
+        {
+            const FWorldForgeLandmark* After = New.Find(Before.Id);
+            if (!After)
+            {
+                OutDiff.Removed.Add(Before);
+            }
+            else if (!IsSameLandmark(Before, *After))
+            {
+                OutDiff.Changed.Add({ Before, *After });
+            }
+        }
+    };
+    auto CollectAdded = [&OutDiff, &Old](const TArray<FWorldForgeLandmark>& NewLandmarks)
+    {
+        for (const FWorldForgeLandmark& After : NewLandmarks)
+        {
+            if (!Old.Contains(After.Id))
+            {
+                OutDiff.Added.Add(After);
+            }
+        }
+    };
+
+    static const TArray<FWorldForgeLandmark> NoLandmarks;
+    const int32 OldChunks = Old.NumChunks();
+    const int32 NewChunks = New.NumChunks();
+
+    if (OldChunks == NewChunks)
+    {
+        // Same hashing on both sides: a landmark sits in the same chunk in both, and shared chunks are equal
+        for (int32 Index = 0; Index < OldChunks; ++Index)
+        {
+            const FChunkPtr& OldChunk = Old.Root->Chunks[Index];
+            const FChunkPtr& NewChunk = New.Root->Chunks[Index];
+            if (OldChunk == NewChunk)
+            {
+                continue;
+            }
+            CompareChunk(OldChunk.IsValid() ? OldChunk->Landmarks : NoLandmarks);
+            CollectAdded(NewChunk.IsValid() ? NewChunk->Landmarks : NoLandmarks);
+        }
+        return;
+    }
+
+    // Across a rehash or from an empty store nothing is shared
+    if (Old.Root.IsValid())
+    {
+        for (const FChunkPtr& Chunk : Old.Root->Chunks)
+        {
+            CompareChunk(Chunk.IsValid() ? Chunk->Landmarks : NoLandmarks);
+        }
+    }
+    if (New.Root.IsValid())
+    {
+        for (const FChunkPtr& Chunk : New.Root->Chunks)
+        {
+            CollectAdded(Chunk.IsValid() ? Chunk->Landmarks : NoLandmarks);
+        }
+    }
+}
+
+bool FWorldForgeLandmarkStore::IsSameLandmark(const FWorldForgeLandmark& A, const FWorldForgeLandmark& B)
+{
+    return A.Id == B.Id && A.Type == B.Type && A.Location == B.Location && A.Name == B.Name && A.Description == B.Description;
+}
+
+int32 FWorldForgeLandmarkStore::GetChunkIndex(const FString& Id, int32 NumChunks)
+{
+    // Chunk counts are powers of two
+    return static_cast<int32>(GetTypeHash(Id) & static_cast<uint32>(NumChunks - 1));
+}
+
+FWorldForgeLandmarkStore::FRoot& FWorldForgeLandmarkStore::GetMutableRoot()
+{
+    if (!Root.IsValid())
+    {
+        Root = MakeShared<FRoot, ESPMode::ThreadSafe>();
+        Root->Chunks.SetNum(InitialChunks);
+    }
+    else if (!Root.IsUnique())
+    {
+        // The copy shares every chunk with the original until they are written
+        Root = MakeShared<FRoot, ESPMode::ThreadSafe>(*Root);
+        ++Stats.TableCopies;
+    }
+    return *Root;
+}
+
+FWorldForgeLandmarkStore::FChunk& FWorldForgeLandmarkStore::GetMutableChunk(FRoot& MutableRoot, int32 Index)
+{
+    FChunkPtr& Chunk = MutableRoot.Chunks[Index];
+    if (!Chunk.IsValid())
+    {
+        Chunk = MakeShared<FChunk, ESPMode::ThreadSafe>();
+    }
+    else if (!Chunk.IsUnique())
+    {
+        Chunk = MakeShared<FChunk, ESPMode::ThreadSafe>(*Chunk);
+        ++Stats.ChunkCopies;
+    }
+    return *Chunk;
+}
+
+void FWorldForgeLandmarkStore::Rehash(int32 NumChunks)
+{
+    TSharedPtr<FRoot, ESPMode::ThreadSafe> NewRoot = MakeShared<FRoot, ESPMode::ThreadSafe>();
+    NewRoot->Chunks.SetNum(NumChunks);
+    for (FChunkPtr& Chunk : NewRoot->Chunks)
+    {
+        Chunk = MakeShared<FChunk, ESPMode::ThreadSafe>();
+    }
+
+    ForEach([&NewRoot, NumChunks](const FWorldForgeLandmark& Landmark)
+    {
+        NewRoot->Chunks[GetChunkIndex(Landmark.Id, NumChunks)]->Landmarks.Add(Landmark);
+    });
+    NewRoot->Num = Num();
+
+    Root = MoveTemp(NewRoot);
+    ++Stats.Rehashes;
+}
+
+FWorldForgeWorldSnapshot FWorldForgeWorldSnapshot::Make(const FWorldForgeState& State, const FWorldForgeLandmarkStore& Landmarks)
+{
+    FWorldForgeWorldSnapshot Snapshot;
+    Snapshot.Era = State.Era;
+    Snapshot.Seed = State.Seed;
+    Snapshot.Militarism = State.Militarism;
+    Snapshot.Prosperity = State.Prosperity;
+    Snapshot.Religiosity = State.Religiosity;
+    Snapshot.Lawfulness = State.Lawfulness;
+    Snapshot.Openness = State.Openness;
+    Snapshot.Atmosphere = State.Atmosphere;
+    Snapshot.Landmarks = Landmarks;
+    return Snapshot;
+}
+
+void FWorldForgeWorldSnapshot::ToState(FWorldForgeState& OutState) const
+{
+    OutState.Era = Era;
+    OutState.Seed = Seed;
+    OutState.Militarism = Militarism;
+    OutState.Prosperity = Prosperity;
+    OutState.Religiosity = Religiosity;
+    OutState.Lawfulness = Lawfulness;
+    OutState.Openness = Openness;
+    OutState.Atmosphere = Atmosphere;
+    Landmarks.ToArray(OutState.Landmarks);
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+
+/**
+ * Economy rates derived from the world traits.
+ */
+struct WORLDFORGE_API FWorldForgeEconomySettings
+{
+    /** Initial populations and productivity are drawn from the seed; changing it restarts the simulation */
+    int32 Seed = 0;
+
+    /** Multiplier on food and goods production */
+    float ProductionScale = 1.0f;
+
+    /** Logistic population growth per step while fed */
+    float GrowthRate = 0.002f;
+
+    /** Fraction of the price gap traded per step over a route; 0 closes every route */
+    float TradeRate = 0.05f;
+
+    /** Fraction of every shipment lost to banditry */
+    float TradeLoss = 0.15f;
+
+    /** Settlements farther apart than this do not trade directly */
+    float TradeRange = 20000.0f;
+
+    /** Prosperity drives production and growth, openness trade volume, lawfulness the share lost on the road */
+    static FWorldForgeEconomySettings FromState(const FWorldForgeState& State);
+
+    bool operator==(const FWorldForgeEconomySettings& Other) const;
+    bool operator!=(const FWorldForgeEconomySettings& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Population, production and stockpiles of every settlement, fortress and monastery, and food and goods
+ * trade between neighbours (the same relative neighbourhood graph roads are planned from).
+ *
+ * State is kept as structure-of-arrays and advanced in fixed steps. Each step runs three ParallelFor
+ * passes: production and growth per settlement, shipments per trade route from the resulting prices, and
+ * applying each settlement's shipments in a fixed order through a compact adjacency list. No pass writes
+ * what another element of the same pass reads, and settlements are kept sorted by ID, so results depend
+ * only on the seed, the set of settlements and the number of steps - not on thread count or on the order
+ * settlements were added in.
+ *
+ * Adding or removing settlements takes effect on the next step. Game thread only.
+ */
+class WORLDFORGE_API FWorldForgeEconomy
+{
+public:
+    struct FStats
+    {
+        /** Duration of the last step and the running average, including any topology rebuild */
+        double LastStepMs = 0.0;
+        double AverageStepMs = 0.0;
+        double MaxStepMs = 0.0;
+
+        /** Times the settlement order and trade routes were rebuilt after adds or removes */
+        int32 TopologyRebuilds = 0;
+    };
+
+    /** A seed change resets every settlement to its initial state */
+    void SetSettings(const FWorldForgeEconomySettings& InSettings);
+    const FWorldForgeEconomySettings& GetSettings() const { return Settings; }
+
+    /** Returns false for duplicates and landmark types without an economy (ruins, natural sites) */
+    bool AddSettlement(const FWorldForgeLandmark& Landmark);
+    bool RemoveSettlement(const FString& LandmarkId);
+    void Clear();
+
+    /** Return every settlement to its seeded initial state */
+    void Reset();
+
+    /**
+     * Run as many fixed steps as the elapsed time calls for, at most MaxSteps; time beyond that is dropped
+     * so a hitch does not snowball. Returns the number of steps run.
+     */
+    int32 Advance(float DeltaSeconds, float StepSeconds, int32 MaxSteps);
+
+    /** Run one step. bParallel = false runs the same passes on the calling thread. */
+    void Step(bool bParallel = true);
+
+    int32 Num() const { return Ids.Num(); }
+    int32 NumTradeRoutes() const { return EdgeA.Num(); }
+    bool IsEmpty() const { return Ids.Num() == 0; }
+
+    /** Index of a settlement for the per-settlement getters, valid until the next add, remove or step */
+    int32 FindIndex(const FString& LandmarkId) const;
+    const FString& GetId(int32 Index) const { return Ids[Index]; }
+    float GetPopulation(int32 Index) const { return Population[Index]; }
+    float GetFood(int32 Index) const { return Food[Index]; }
+    float GetGoods(int32 Index) const { return Goods[Index]; }
+    float GetWealth(int32 Index) const { return Wealth[Index]; }
+
+    const FWorldForgeEconomyMetrics& GetMetrics() const { return Metrics; }
+    const FStats& GetStats() const { return Stats; }
+
+    /** Hash of every settlement's state, for checking determinism */
+    uint32 GetChecksum() const;
+
+private:
+    FWorldForgeEconomySettings Settings;
+
+    // Per settlement, sorted by Id
+    TArray<FString> Ids;
+    TArray<FVector2D> Locations;
+    TArray<EWorldForgeLandmarkType> Types;
+    TArray<float> Capacity;
+    TArray<float> Productivity;
+    TArray<float> Population;
+    TArray<float> Food;
+    TArray<float> Goods;
+    TArray<float> Wealth;
+
+    /** Scratch of the production pass: prices, and how much each route may ship or spend */
+    TArray<float> FoodPrice;
+    TArray<float> GoodsPrice;
+    TArray<float> FoodExport;
+    TArray<float> GoodsExport;
+    TArray<float> Budget;
+    TArray<uint8> Starving;
+
+    // Per trade route: endpoints, capacity from distance, and signed shipments of the last step (positive A -> B)
+    TArray<int32> EdgeA;
+    TArray<int32> EdgeB;
+    TArray<float> EdgeCapacity;
+    TArray<float> FoodFlow;
+    TArray<float> GoodsFlow;
+
+    /** Routes of each settlement: AdjacencyEdges[AdjacencyOffsets[i] .. AdjacencyOffsets[i + 1]) */
+    TArray<int32> AdjacencyOffsets;
+    TArray<int32> AdjacencyEdges;
+
+    TMap<FString, int32> IdToIndex;
+
+    /** Set by adds, removes and range changes; the next step sorts the settlements and rebuilds the routes */
+    bool bTopologyDirty = false;
+
+    float Accumulator = 0.0f;
+    FWorldForgeEconomyMetrics Metrics;
+    FStats Stats;
+
+    /** Sort the settlements by Id and rebuild the trade routes and adjacency */
+    void RebuildTopology();
+
+    void InitializeSettlement(int32 Index);
+    void UpdateMetrics();
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTerrainGenerator.h"
+
+/**
+ * CPU-side terrain height and normal queries over generated heightfield tiles.
+ * Replaces physics traces for placement: lookups are bilinear samples of the cached heights and
+ * never touch the physics scene. Tiles are immutable once added, and the tile map is guarded by a
+ * reader/writer lock, so queries are safe from any thread while the game thread adds and evicts tiles.
+ */
+class WORLDFORGE_API FWorldForgeHeightCache
+{
+public:
+    using FTilePtr = TSharedPtr<const FWorldForgeHeightfieldTile, ESPMode::ThreadSafe>;
+
+    /** Add or replace a tile. All tiles must share one size; a tile of another size clears the cache. */
+    void AddTile(const FTilePtr& Tile);
+
+    bool RemoveTile(FIntPoint Coord);
+
+    void Clear();
+
+    int32 Num() const;
+    bool IsEmpty() const { return Num() == 0; }
+
+    /** Terrain height at a world position. Returns false if no tile covers it. */
+    bool QueryHeight(float X, float Y, float& OutHeight) const;
+
+    /** Terrain height and surface normal at a world position. Returns false if no tile covers it. */
+    bool QueryHeightAndNormal(float X, float Y, float& OutHeight, FVector& OutNormal) const;
+
+    /**
+     * Heights for many positions under one lock. Runs of four positions on the same tile are sampled
+     * with vector instructions unless bAllowVectorized is false (the scalar path gives identical results).
+     * OutHeights and OutFound must be as long as Positions; OutFound is false where no tile covers a position.
+     * @return Number of positions that were covered
+     */
+    int32 QueryHeights(TConstArrayView<FVector2f> Positions, TArrayView<float> OutHeights, TArrayView<bool> OutFound,
+                       bool bAllowVectorized = true) const;
+
+private:
+    mutable FRWLock Lock;
+    TMap<FIntPoint, FTilePtr> Tiles;
+
+    /** World size of every tile, from the first tile added */
+    float TileSize = 0.0f;
+    float InverseTileSize = 0.0f;
+
+    /** Tile covering a position; caller holds the lock */
+    const FWorldForgeHeightfieldTile* FindTile(float X, float Y) const;
+};
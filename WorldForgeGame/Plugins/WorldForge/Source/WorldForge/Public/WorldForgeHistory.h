@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+#include "WorldForgeWorldStore.h"
+#include <atomic>
+
+class FWorldForgeWaterMap;
+
+/**
+ * Landmark changes produced by a history simulation, applied through the normal destroy and spawn path.
+ * A landmark whose type changed (a settlement fallen to ruin, a ruin resettled) is removed and re-added
+ * under the same ID.
+ */
+struct WORLDFORGE_API FWorldForgeHistoryDelta
+{
+    TArray<FWorldForgeLandmark> Added;
+    TArray<FString> Removed;
+    int32 YearsSimulated = 0;
+
+    /** Events over the simulated years, including ones later undone (a town founded and ruined again) */
+    int32 Founded = 0;
+    int32 Ruined = 0;
+    int32 Resettled = 0;
+};
+
+/**
+ * Compact year-by-year model of a civilization, built from a world state: settlements grow, found new
+ * settlements, fortresses and monasteries nearby, and fall to ruin through war and famine; ruins may be
+ * resettled. Rates follow the traits.
+ *
+ * Sites are kept as structure-of-arrays. Each year runs a ParallelFor over the sites drawing from a
+ * counter-based random stream keyed on (seed, site, year), then accepts new sites in site order against
+ * a crowding grid, so a run is deterministic for a given state and year count regardless of threads.
+ * Not thread-safe; one model is owned by one worker.
+ */
+class WORLDFORGE_API FWorldForgeHistoryModel
+{
+public:
+    /** @param Water Optional; new sites are not founded on rivers */
+    explicit FWorldForgeHistoryModel(const FWorldForgeState& State, const FWorldForgeWaterMap* Water = nullptr);
+
+    /** Advance one year. bParallel = false runs the site pass on the calling thread. */
+    void SimulateYear(bool bParallel = true);
+
+    int32 GetYear() const { return Year; }
+    int32 NumSites() const { return Keys.Num(); }
+    int32 NumSites(EWorldForgeLandmarkType Type) const;
+
+    /** Changes between the landmarks the model was built from and the current sites */
+    FWorldForgeHistoryDelta MakeDelta() const;
+
+    /** Hash of every site's type, location and population */
+    uint32 GetChecksum() const;
+
+private:
+    float Militarism;
+    float Prosperity;
+    float Religiosity;
+    float Lawfulness;
+    float Openness;
+    int32 Seed;
+    const FWorldForgeWaterMap* Water;
+
+    /** Landmarks the model was built from; site I < Original.Num() started as Original[I] */
+    TArray<FWorldForgeLandmark> Original;
+
+    // Per site
+    TArray<uint32> Keys;
+    TArray<FVector> Locations;
+    TArray<EWorldForgeLandmarkType> Types;
+    TArray<float> Population;
+    TArray<int32> FoundedYear;
+
+    /** Site pass output: what happened to the site this year, and a site it founds, if any */
+    TArray<uint8> Events;
+    TArray<uint8> BirthTypes;
+    TArray<FVector> BirthLocations;
+
+    /** Every site's key, so founded sites get unique IDs */
+    TSet<uint32> UsedKeys;
+
+    /** Live sites per crowding cell */
+    TMap<FIntPoint, int32> Crowding;
+
+    int32 Year = 0;
+    int32 Founded = 0;
+    int32 Ruined = 0;
+    int32 Resettled = 0;
+
+    void AddSite(uint32 Key, const FVector& Location, EWorldForgeLandmarkType Type, float InPopulation);
+
+    /** Uniform [0, 1) draw for a site and year; Salt separates the draws of one site */
+    float Random(int32 Site, uint32 Salt) const;
+};
+
+/**
+ * A history simulation running on a worker thread, shared between the worker and the game thread.
+ * The game thread polls progress and may cancel; the worker checks for cancellation every year.
+ * The job holds a snapshot of the world and builds its model on the worker, so starting one costs
+ * the game thread nothing per landmark.
+ */
+class WORLDFORGE_API FWorldForgeHistoryJob
+{
+public:
+    FWorldForgeHistoryJob(const FWorldForgeWorldSnapshot& InSnapshot, int32 InYears, TSharedPtr<const FWorldForgeWaterMap, ESPMode::ThreadSafe> InWater);
+
+    /** Simulate every year, or until cancelled. Worker thread. */
+    void Run();
+
+    void Cancel() { bCancelRequested = true; }
+    bool IsCancelled() const { return bCancelRequested; }
+    bool IsDone() const { return bDone; }
+
+    int32 GetYears() const { return Years; }
+    int32 GetYearsCompleted() const { return YearsCompleted; }
+    double GetSeconds() const { return Seconds; }
+
+    /** The delta once IsDone; empty if cancelled */
+    const FWorldForgeHistoryDelta& GetDelta() const { check(bDone); return Delta; }
+
+private:
+    TSharedPtr<const FWorldForgeWaterMap, ESPMode::ThreadSafe> Water;
+    FWorldForgeWorldSnapshot Snapshot;
+    int32 Years;
+    double Seconds = 0.0;
+    FWorldForgeHistoryDelta Delta;
+
+    std::atomic<int32> YearsCompleted{ 0 };
+    std::atomic<bool> bCancelRequested{ false };
+    std::atomic<bool> bDone{ false };
+};
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+#include "WorldForgeTerrainGenerator.h"
+
+/**
+ * How wet the world is and how much drainage makes a river, derived from the world traits.
+ */
+struct WORLDFORGE_API FWorldForgeHydrologySettings
+{
+    /** Water contributed by each cell */
+    float Rainfall = 1.0f;
+
+    /** Accumulated water above which a cell is part of a river */
+    float RiverThreshold = 600.0f;
+
+    /** Rivers keep every Nth cell as a spline point */
+    int32 SplineStride = 4;
+
+    /** River branches shorter than this many cells are dropped */
+    int32 MinRiverCells = 12;
+
+    /** Prosperity brings a wetter climate, openness more navigable waterways, Desolate dries everything up */
+    static FWorldForgeHydrologySettings FromState(const FWorldForgeState& State);
+};
+
+/**
+ * A river as a polyline from its source downstream. Flow is the accumulated water at each point.
+ */
+struct WORLDFORGE_API FWorldForgeRiver
+{
+    TArray<FVector> Points;
+    TArray<float> Flow;
+};
+
+/**
+ * Full hydrology result for a grid of heights.
+ * Flow directions are D8 codes (0-7 = E, SE, S, SW, W, NW, N, NE) or NoFlow for outlets on the border.
+ */
+struct WORLDFORGE_API FWorldForgeHydrologyGrid
+{
+    static constexpr uint8 NoFlow = 0xff;
+
+    int32 Width = 0;
+    int32 Height = 0;
+    float SampleSpacing = 100.0f;
+    FVector2D Origin = FVector2D::ZeroVector;
+
+    /** Heights with every depression filled so water can always reach the border */
+    TArray<float> Filled;
+    TArray<uint8> FlowDirection;
+    TArray<float> Accumulation;
+
+    /** 1 where a cell carries a river */
+    TArray<uint8> WaterMask;
+    TArray<FWorldForgeRiver> Rivers;
+};
+
+/**
+ * Hydrology for one terrain tile, cropped from a computation over the tile plus an apron of
+ * neighbouring samples so rivers line up across tile borders.
+ */
+struct WORLDFORGE_API FWorldForgeWaterTile
+{
+    FIntPoint Coord = FIntPoint::ZeroValue;
+    int32 Resolution = 0;
+    float SampleSpacing = 100.0f;
+
+    /** Resolution * Resolution, matching the heightfield tile's samples */
+    TArray<uint8> WaterMask;
+    TArray<FWorldForgeRiver> Rivers;
+
+    float GetSize() const { return (Resolution - 1) * SampleSpacing; }
+    FVector2D GetOrigin() const { return FVector2D(Coord.X * GetSize(), Coord.Y * GetSize()); }
+    SIZE_T GetAllocatedSize() const;
+};
+
+/**
+ * Everything generated for one terrain tile on a worker: heights, water and the meshes for both.
+ */
+struct WORLDFORGE_API FWorldForgeTerrainTileData
+{
+    TSharedPtr<const FWorldForgeHeightfieldTile, ESPMode::ThreadSafe> Heightfield;
+    TSharedPtr<const FWorldForgeWaterTile, ESPMode::ThreadSafe> Water;
+    FWorldForgeTerrainMeshData Mesh;
+    FWorldForgeTerrainMeshData WaterMesh;
+};
+
+/**
+ * Drainage network generation: priority-flood depression filling, D8 flow directions,
+ * parallel flow accumulation and river extraction. All functions are pure and thread-safe.
+ */
+class WORLDFORGE_API FWorldForgeHydrology
+{
+public:
+    /** Run every stage over a grid of heights */
+    static void Compute(TArray<float> Heights, int32 Width, int32 Height, float SampleSpacing, const FVector2D& Origin,
+                        const FWorldForgeHydrologySettings& Settings, FWorldForgeHydrologyGrid& OutGrid);
+
+    /**
+     * Raise every cell that has no downhill path to the border to its spill level (Priority-Flood).
+     * Large grids are filled in parallel blocks that are stitched through a graph of block perimeter cells.
+     */
+    static void FillDepressions(TArray<float>& Heights, int32 Width, int32 Height);
+
+    /** Steepest-descent neighbour of every cell, in parallel; flat filled areas drain toward their spill point */
+    static void ComputeFlowDirections(const TArray<float>& Filled, int32 Width, int32 Height, TArray<uint8>& OutDirections);
+
+    /** Water reaching every cell from upstream, in parallel. Deterministic regardless of thread count. */
+    static void AccumulateFlow(const TArray<uint8>& Directions, int32 Width, int32 Height, float Rainfall, TArray<float>& OutAccumulation);
+
+    /** Water mask and river polylines from the accumulation */
+    static void ExtractRivers(FWorldForgeHydrologyGrid& Grid, const FWorldForgeHydrologySettings& Settings);
+
+    /** Hydrology for a terrain tile, computed over the tile plus ApronSamples on each side */
+    static void ComputeTile(const FWorldForgeTerrainParams& TerrainParams, const FWorldForgeHydrologySettings& Settings,
+                            FIntPoint Coord, int32 Resolution, float SampleSpacing, int32 ApronSamples, FWorldForgeWaterTile& OutTile);
+
+    /** Heights, water and meshes for a streamed or generated terrain tile */
+    static void BuildTerrainTile(const FWorldForgeTerrainParams& TerrainParams, const FWorldForgeHydrologySettings& Settings,
+                                 FIntPoint Coord, int32 Resolution, float SampleSpacing, FWorldForgeTerrainTileData& OutData);
+
+    /** Flat ribbon mesh along a tile's rivers, widening with flow */
+    static void BuildRiverMeshData(const FWorldForgeWaterTile& Tile, FWorldForgeTerrainMeshData& OutMesh);
+};
+
+/**
+ * Thread-safe water queries over the water tiles of the loaded terrain, for placement.
+ */
+class WORLDFORGE_API FWorldForgeWaterMap
+{
+public:
+    using FTilePtr = TSharedPtr<const FWorldForgeWaterTile, ESPMode::ThreadSafe>;
+
+    void AddTile(const FTilePtr& Tile);
+    bool RemoveTile(FIntPoint Coord);
+    void Clear();
+    int32 Num() const;
+
+    /** True if the nearest water mask sample to the position is a river */
+    bool IsWater(float X, float Y) const;
+
+    /** Nearest river point within MaxDistance (2D). Returns false if there is none. */
+    bool FindNearestRiverPoint(const FVector& Location, float MaxDistance, FVector& OutPoint) const;
+
+private:
+    mutable FRWLock Lock;
+    TMap<FIntPoint, FTilePtr> Tiles;
+    float TileSize = 0.0f;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "WorldForgeLabelManager.generated.h"
+
+class APlayerController;
+class UTextRenderComponent;
+class FWorldForgeSpatialIndex;
+
+/**
+ * Shows landmark names for the nearest on-screen landmarks only.
+ * Owns a small pool of text render components that are reassigned as the player moves,
+ * instead of every settlement carrying its own always-on label.
+ */
+UCLASS(NotBlueprintable)
+class WORLDFORGE_API AWorldForgeLabelManager : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AWorldForgeLabelManager();
+
+    /** Reassign pooled labels to the landmarks nearest the player's view, skipping any in SkipIds */
+    void UpdateLabels(const FWorldForgeSpatialIndex& SpatialIndex, APlayerController* PlayerController, const TSet<FString>* SkipIds = nullptr);
+
+    /** Hide and release every label */
+    void ClearLabels();
+
+    int32 GetVisibleLabelCount() const { return ActiveLabels.Num(); }
+
+    /** Maximum number of labels shown at once */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WorldForge|Labels")
+    int32 MaxLabels = 32;
+
+    /** Landmarks farther than this never get a label */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WorldForge|Labels")
+    float MaxLabelDistance = 60000.0f;
+
+    /** Only label landmarks inside the camera's field of view */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WorldForge|Labels")
+    bool bOnlyOnScreen = true;
+
+    /** Height of the label above the landmark location */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WorldForge|Labels")
+    float LabelHeight = 3500.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WorldForge|Labels")
+    float LabelWorldSize = 500.0f;
+
+private:
+    UPROPERTY(VisibleAnywhere, Category = "Components")
+    TObjectPtr<USceneComponent> SceneRoot;
+
+    /** Every label component created so far */
+    UPROPERTY()
+    TArray<TObjectPtr<UTextRenderComponent>> LabelPool;
+
+    /** Pooled labels not currently assigned */
+    TArray<UTextRenderComponent*> FreeLabels;
+
+    /** Labels currently shown, by landmark ID */
+    TMap<FString, UTextRenderComponent*> ActiveLabels;
+
+    UTextRenderComponent* AcquireLabel();
+    void ReleaseLabel(UTextRenderComponent* Label);
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "WorldForgeTypes.h"
+#include "WorldForgeLandmarkInstancer.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+
+/**
+ * Renders landmarks as per-type hierarchical instanced meshes.
+ * Used by the WorldForge subsystem in Instanced render mode so that very large
+ * landmark counts do not each need a full AWorldForgeSettlementActor.
+ *
+ * Per-instance custom data layout: [0..2] = type color RGB.
+ */
+UCLASS(NotBlueprintable)
+class WORLDFORGE_API AWorldForgeLandmarkInstancer : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AWorldForgeLandmarkInstancer();
+
+    /** Add an instance for the landmark. Returns false if it is already present. */
+    bool AddLandmark(const FWorldForgeLandmark& Landmark);
+
+    /** Remove the instance for the landmark. Returns false if it is not present. */
+    bool RemoveLandmark(const FString& LandmarkId);
+
+    /** Remove every instance */
+    void ClearLandmarks();
+
+    /** Hide or show a landmark's instance (used while a full actor represents it) */
+    void SetLandmarkHidden(const FString& LandmarkId, bool bHidden);
+
+    bool ContainsLandmark(const FString& LandmarkId) const { return Handles.Contains(LandmarkId); }
+
+    int32 GetLandmarkCount() const { return Handles.Num(); }
+
+    /**
+     * Material applied to every instanced component. Should read PerInstanceCustomData 0-2
+     * for the type color; when unset each type's component uses the subsystem's shared material
+     * for that type, tinted like the settlement actors.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WorldForge")
+    TObjectPtr<UMaterialInterface> InstanceMaterial;
+
+private:
+    /** Location of a landmark's instance inside the per-type components */
+    struct FInstanceHandle
+    {
+        EWorldForgeLandmarkType Type = EWorldForgeLandmarkType::Settlement;
+        int32 InstanceIndex = INDEX_NONE;
+        FTransform Transform;
+    };
+
+    /** Per-type instance bookkeeping. Freed slots are collapsed and reused instead of removed,
+     *  because removing from a HISM reorders instance indices. */
+    struct FTypeInstances
+    {
+        UHierarchicalInstancedStaticMeshComponent* Component = nullptr;
+        TArray<int32> FreeIndices;
+    };
+
+    UPROPERTY(VisibleAnywhere, Category = "Components")
+    TObjectPtr<USceneComponent> SceneRoot;
+
+    UPROPERTY()
+    TObjectPtr<UStaticMesh> LandmarkMesh;
+
+    /** Instanced components, one per landmark type, created on first use */
+    UPROPERTY()
+    TArray<TObjectPtr<UHierarchicalInstancedStaticMeshComponent>> TypeComponents;
+
+    TMap<EWorldForgeLandmarkType, FTypeInstances> Types;
+    TMap<FString, FInstanceHandle> Handles;
+
+    FTypeInstances& GetOrCreateTypeInstances(EWorldForgeLandmarkType Type);
+
+    /** InstanceMaterial, or the cached per-type material from UWorldForgeMaterialCache */
+    UMaterialInterface* GetMaterialForType(EWorldForgeLandmarkType Type) const;
+
+    static FTransform GetInstanceTransform(const FWorldForgeLandmark& Landmark);
+};
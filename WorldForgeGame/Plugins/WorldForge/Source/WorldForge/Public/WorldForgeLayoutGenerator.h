@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+
+/**
+ * Kinds of pieces a settlement layout is built from.
+ * Each kind is committed to one instanced mesh component on the settlement actor.
+ */
+enum class EWorldForgeLayoutPiece : uint8
+{
+    House,
+    Hall,
+    Temple,
+    Tower,
+    Wall,
+    Plaza,
+    Rubble,
+
+    Count
+};
+
+/**
+ * Inputs to the layout generator. Plain data so it can be copied to a worker thread.
+ */
+struct WORLDFORGE_API FWorldForgeLayoutParams
+{
+    EWorldForgeLandmarkType Type = EWorldForgeLandmarkType::Settlement;
+    float Militarism = 0.5f;
+    float Prosperity = 0.5f;
+    float Religiosity = 0.5f;
+    uint32 Seed = 0;
+
+    /** Build parameters for a landmark from the current world traits */
+    static FWorldForgeLayoutParams FromLandmark(const FWorldForgeLandmark& Landmark, const FWorldForgeState& State);
+
+    /** Same parameters generate the same layout */
+    bool operator==(const FWorldForgeLayoutParams& Other) const;
+    bool operator!=(const FWorldForgeLayoutParams& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Generated layout: piece transforms in the settlement actor's local space.
+ * Unit shapes (1m cube, cylinder, cone, plane) are scaled by each transform.
+ */
+struct WORLDFORGE_API FWorldForgeSettlementLayout
+{
+    TArray<FTransform> Pieces[static_cast<int32>(EWorldForgeLayoutPiece::Count)];
+
+    TArray<FTransform>& Get(EWorldForgeLayoutPiece Piece) { return Pieces[static_cast<int32>(Piece)]; }
+    const TArray<FTransform>& Get(EWorldForgeLayoutPiece Piece) const { return Pieces[static_cast<int32>(Piece)]; }
+
+    int32 NumPieces() const;
+
+    /** Hash of every transform, for comparing or caching layouts */
+    uint32 ComputeHash() const;
+};
+
+/**
+ * Grammar-style settlement layout generator: plaza -> radial streets -> building lots -> walls.
+ * Type and traits choose the rules (militarism adds walls and towers, prosperity densifies lots,
+ * religiosity adds temples). Pure function of its parameters, so it is safe on any thread and
+ * deterministic for a given seed.
+ */
+class WORLDFORGE_API FWorldForgeLayoutGenerator
+{
+public:
+    static FWorldForgeSettlementLayout Generate(const FWorldForgeLayoutParams& Params);
+
+    /** Stable seed for a landmark, independent of spawn order */
+    static uint32 MakeSeed(int32 WorldSeed, const FString& LandmarkId);
+};
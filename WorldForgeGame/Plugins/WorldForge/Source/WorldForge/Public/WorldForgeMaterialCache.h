@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "WorldForgeTypes.h"
+#include "WorldForgeMaterialCache.generated.h"
+
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+
+/**
+ * Shares landmark materials between settlement actors.
+ * One material instance is created per (base material, landmark type, era) instead of one per actor,
+ * so settlements of the same type keep batching together. When a shared material that reads
+ * custom primitive data is configured, no instances are created at all.
+ */
+UCLASS()
+class WORLDFORGE_API UWorldForgeMaterialCache : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * Get the material a landmark of the given type should use.
+     * Returns the shared material if set, otherwise a cached instance of BaseMaterial tinted for the type.
+     */
+    UMaterialInterface* GetLandmarkMaterial(UMaterialInterface* BaseMaterial, EWorldForgeLandmarkType Type, const FString& EraId);
+
+    /** Drop all cached instances. Actors keep the instances they already use. */
+    void Reset();
+
+    /** Number of material instances created by the cache */
+    int32 GetMaterialInstanceCount() const { return Instances.Num(); }
+
+    /** Estimated memory held by cached material instances, in bytes */
+    SIZE_T GetMaterialMemoryBytes() const;
+
+    /**
+     * Optional master material that reads the type color from custom primitive data (indices 0-2).
+     * When set it is used directly for every landmark.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WorldForge")
+    TObjectPtr<UMaterialInterface> SharedLandmarkMaterial;
+
+private:
+    struct FMaterialKey
+    {
+        TObjectKey<UMaterialInterface> BaseMaterial;
+        EWorldForgeLandmarkType Type = EWorldForgeLandmarkType::Settlement;
+        FString EraId;
+
+        bool operator==(const FMaterialKey& Other) const
+        {
+            return BaseMaterial == Other.BaseMaterial && Type == Other.Type && EraId == Other.EraId;
+        }
+
+        friend uint32 GetTypeHash(const FMaterialKey& Key)
+        {
+            return HashCombine(HashCombine(GetTypeHash(Key.BaseMaterial), GetTypeHash(Key.Type)), GetTypeHash(Key.EraId));
+        }
+    };
+
+    TMap<FMaterialKey, TObjectPtr<UMaterialInstanceDynamic>> Instances;
+
+    /** Keeps cached instances referenced for GC (TMap keys are not reflected) */
+    UPROPERTY()
+    TArray<TObjectPtr<UMaterialInstanceDynamic>> InstanceRefs;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Collects the navigation-relevant bounds of spawned and destroyed landmarks as a set of dirty navmesh
+ * tiles, and merges them into a few boxes when flushed. A bulk import of a thousand settlements then
+ * costs one rebuild of each touched tile instead of one rebuild request per settlement, and tiles two
+ * neighbouring settlements share are rebuilt once.
+ *
+ * Boxes are built greedily: each row of dirty tiles is split into runs, and runs covering the same
+ * columns in consecutive rows are merged. Game thread only.
+ */
+class WORLDFORGE_API FWorldForgeNavBatch
+{
+public:
+    struct FStats
+    {
+        /** Areas added since the last flush, and in total */
+        int32 PendingAreas = 0;
+        int32 TotalAreas = 0;
+
+        int32 Flushes = 0;
+
+        /** What the last flush submitted: areas recorded, distinct tiles, and merged boxes */
+        int32 LastAreas = 0;
+        int32 LastTiles = 0;
+        int32 LastBoxes = 0;
+
+        /** Tiles the last batch's areas would have dirtied one request at a time, counting overlaps again */
+        int32 LastUnbatchedTiles = 0;
+
+        /**
+         * Rebuilds of flushed batches that completed. Deferred is how long the batch was held while its burst
+         * ran; rebuild is from the flush until the navigation system went idle, the time agents may find the
+         * affected tiles missing or stale.
+         */
+        int32 RebuildsCompleted = 0;
+        double LastDeferredSeconds = 0.0;
+        double LastRebuildSeconds = 0.0;
+        double MaxRebuildSeconds = 0.0;
+    };
+
+    /** Navmesh tile edge length; changing it drops pending tiles, so set it before recording areas */
+    void SetTileSize(float InTileSize);
+    float GetTileSize() const { return TileSize; }
+
+    /** Record bounds whose navigation must be rebuilt */
+    void AddArea(const FBox& Bounds);
+
+    bool HasPending() const { return DirtyTiles.Num() > 0; }
+    int32 NumPendingTiles() const { return DirtyTiles.Num(); }
+
+    /** Seconds (FPlatformTime) of the last AddArea, to wait for a burst to settle */
+    double GetLastAddTime() const { return LastAddTime; }
+
+    /** Merge the pending tiles into boxes spanning every recorded height, and clear them */
+    void Flush(TArray<FBox>& OutBoxes);
+
+    /** Drop pending tiles without submitting them */
+    void Reset();
+
+    void RecordRebuild(double DeferredSeconds, double RebuildSeconds);
+
+    const FStats& GetStats() const { return Stats; }
+
+private:
+    float TileSize = 1000.0f;
+    TSet<FIntPoint> DirtyTiles;
+    float MinZ = TNumericLimits<float>::Max();
+    float MaxZ = TNumericLimits<float>::Lowest();
+    double LastAddTime = 0.0;
+    int32 PendingUnbatchedTiles = 0;
+    FStats Stats;
+};
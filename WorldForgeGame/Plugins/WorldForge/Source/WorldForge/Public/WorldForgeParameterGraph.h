@@ -0,0 +1,176 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+
+/**
+ * Inputs of the parameter graph: the parts of FWorldForgeState that generation rules read.
+ * The first five match EWorldForgeTrait.
+ */
+enum class EWorldForgeParameterInput : uint8
+{
+    Militarism,
+    Prosperity,
+    Religiosity,
+    Lawfulness,
+    Openness,
+    Atmosphere,
+    Seed,
+    Era,
+    Count
+};
+
+/**
+ * Declarative rules from world state to derived generation parameters (trait -> parameter -> consumer).
+ *
+ * Every rule declares the inputs and rules it reads. When the world state changes, only the rules
+ * downstream of the inputs that changed are marked dirty, and Evaluate recomputes them in dependency
+ * order, at most a given number per call so a burst of changes is spread over several ticks. Results
+ * are memoized: a rule whose recomputed value equals the previous one does not dirty its dependents
+ * or notify its consumers, so a slider drag on one trait only reaches the systems that read it.
+ *
+ * Rules may only read the inputs and rules they declare. Game thread only.
+ */
+class WORLDFORGE_API FWorldForgeParameterGraph
+{
+public:
+    using FNodeId = int32;
+
+    struct FStats
+    {
+        int32 NumRules = 0;
+        int32 NumConsumers = 0;
+
+        /** Rules waiting for Evaluate */
+        int32 PendingRules = 0;
+
+        /** Totals since construction */
+        int64 Evaluations = 0;
+        int64 UnchangedEvaluations = 0;
+        int64 ConsumerNotifications = 0;
+    };
+
+    FWorldForgeParameterGraph();
+
+    static FNodeId GetInputNode(EWorldForgeParameterInput Input) { return static_cast<FNodeId>(Input); }
+    static FNodeId GetTraitNode(EWorldForgeTrait Trait) { return static_cast<FNodeId>(Trait); }
+
+    /**
+     * Declare a derived parameter. Dependencies must already be declared, which keeps node IDs in
+     * dependency order. The rule is evaluated on the next Evaluate.
+     * @param Compute Reads the world state through GetState and other rules through Get
+     */
+    template <typename T>
+    FNodeId AddRule(FName Name, TConstArrayView<FNodeId> Dependencies, TFunction<T(const FWorldForgeParameterGraph&)> Compute)
+    {
+        return AddNode(Name, Dependencies, MakeUnique<TValue<T>>(),
+            [Compute = MoveTemp(Compute)](const FWorldForgeParameterGraph& Graph) -> TUniquePtr<FValue>
+            {
+                TUniquePtr<TValue<T>> Value = MakeUnique<TValue<T>>();
+                Value->Value = Compute(Graph);
+                return Value;
+            });
+    }
+
+    /** Run Callback after Node's value changes */
+    void AddConsumer(FNodeId Node, FName Name, TFunction<void()> Callback);
+
+    /** Compare the inputs with a world state; every input that changed dirties the rules reading it */
+    void SetState(const FWorldForgeState& State);
+
+    /** Recompute up to MaxRules dirty rules in dependency order. Returns the number recomputed. */
+    int32 Evaluate(int32 MaxRules = MAX_int32);
+
+    bool HasPendingEvaluations() const { return NumDirty > 0; }
+
+    /** Inputs as last passed to SetState (landmarks are not tracked) */
+    const FWorldForgeState& GetState() const { return State; }
+
+    /** Current value of a rule; T must be the type it was declared with */
+    template <typename T>
+    const T& Get(FNodeId Node) const
+    {
+        check(Nodes.IsValidIndex(Node) && Nodes[Node].Value);
+        return static_cast<const TValue<T>&>(*Nodes[Node].Value).Value;
+    }
+
+    /** Incremented each time a node's value changes */
+    uint32 GetVersion(FNodeId Node) const { return Nodes[Node].Version; }
+
+    FName GetName(FNodeId Node) const { return Nodes[Node].Name; }
+    int32 NumNodes() const { return Nodes.Num(); }
+    FStats GetStats() const;
+
+private:
+    struct FValue
+    {
+        virtual ~FValue() = default;
+        virtual bool Equals(const FValue& Other) const = 0;
+    };
+
+    template <typename T>
+    struct TValue : FValue
+    {
+        T Value{};
+
+        virtual bool Equals(const FValue& Other) const override
+        {
+            return Value == static_cast<const TValue<T>&>(Other).Value;
+        }
+    };
+
+    struct FConsumer
+    {
+        FName Name;
+        TFunction<void()> Callback;
+    };
+
+    struct FNode
+    {
+        FName Name;
+        TArray<FNodeId> Dependents;
+        TFunction<TUniquePtr<FValue>(const FWorldForgeParameterGraph&)> Compute;
+        TUniquePtr<FValue> Value;
+        TArray<FConsumer> Consumers;
+        uint32 Version = 0;
+        bool bDirty = false;
+    };
+
+    TArray<FNode> Nodes;
+    FWorldForgeState State;
+    int32 NumDirty = 0;
+    int32 NumConsumers = 0;
+    int64 Evaluations = 0;
+    int64 UnchangedEvaluations = 0;
+    int64 ConsumerNotifications = 0;
+
+    FNodeId AddNode(FName Name, TConstArrayView<FNodeId> Dependencies, TUniquePtr<FValue> InitialValue,
+                    TFunction<TUniquePtr<FValue>(const FWorldForgeParameterGraph&)> Compute);
+
+    /** Bump a node's version and dirty the rules that read it */
+    void NotifyChanged(FNodeId Node);
+};
+
+/**
+ * Rules feeding the built-in generation systems, declared by FWorldForgeParameterGraph users with AddDefaultRules.
+ */
+struct WORLDFORGE_API FWorldForgeParameterRules
+{
+    /** FWorldForgeTerritorySettings */
+    FWorldForgeParameterGraph::FNodeId Territory = INDEX_NONE;
+
+    /** FWorldForgeRoadSettings */
+    FWorldForgeParameterGraph::FNodeId Roads = INDEX_NONE;
+
+    /** FWorldForgeScatterLayerParams per EWorldForgeScatterLayer */
+    TArray<FWorldForgeParameterGraph::FNodeId> ScatterLayers;
+
+    /** TArray<FWorldForgeScatterLayerParams> of every layer */
+    FWorldForgeParameterGraph::FNodeId Scatter = INDEX_NONE;
+
+    /** FWorldForgeEconomySettings */
+    FWorldForgeParameterGraph::FNodeId Economy = INDEX_NONE;
+
+    /** Declare the rules with the traits each one reads */
+    static FWorldForgeParameterRules AddDefaultRules(FWorldForgeParameterGraph& Graph);
+};
@@ -0,0 +1,207 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+class FWorldForgeRoadNetwork;
+
+/**
+ * A route between two landmarks over the road network.
+ */
+struct WORLDFORGE_API FWorldForgePath
+{
+    FString FromId;
+    FString ToId;
+
+    /** Landmarks passed through, both endpoints included; empty when no routed roads connect the two */
+    TArray<FString> Landmarks;
+
+    /** Roads travelled, by road network key */
+    TArray<FString> RoadKeys;
+
+    /** The roads' polylines joined end to end, from FromId to ToId */
+    TArray<FVector> Points;
+
+    /** Sum of the road costs (slope and river penalties included), and the polyline length */
+    float Cost = 0.0f;
+    float Length = 0.0f;
+
+    bool IsFound() const { return Landmarks.Num() > 0; }
+};
+
+using FWorldForgePathPtr = TSharedPtr<const FWorldForgePath, ESPMode::ThreadSafe>;
+
+struct WORLDFORGE_API FWorldForgePathQuery
+{
+    FString FromId;
+    FString ToId;
+};
+
+/**
+ * Immutable snapshot of the routed roads as a graph over landmarks, in compact adjacency form.
+ * Built on the game thread, then read by any number of workers.
+ */
+class WORLDFORGE_API FWorldForgePathGraph
+{
+public:
+    /** Snapshot of every routed road; roads still waiting for a route are not travelled */
+    explicit FWorldForgePathGraph(const FWorldForgeRoadNetwork& Network);
+
+    /**
+     * Cheapest paths from one landmark to each of the targets, from a single Dijkstra search that
+     * stops once every target is settled. OutPaths receives one path per target, in order.
+     */
+    void Solve(const FString& FromId, TConstArrayView<FString> ToIds, TArray<FWorldForgePath>& OutPaths) const;
+
+    int32 NumNodes() const { return Ids.Num(); }
+    int32 NumRoads() const { return Roads.Num(); }
+
+private:
+    struct FEdge
+    {
+        int32 To = INDEX_NONE;
+        int32 Road = INDEX_NONE;
+    };
+
+    struct FRoad
+    {
+        FString Key;
+        int32 From = INDEX_NONE;
+        TArray<FVector> Points;
+        float Cost = 0.0f;
+        float Length = 0.0f;
+    };
+
+    TArray<FString> Ids;
+    TMap<FString, int32> NodeIndex;
+
+    /** Edges of node i: Edges[Offsets[i] .. Offsets[i + 1]) */
+    TArray<int32> Offsets;
+    TArray<FEdge> Edges;
+    TArray<FRoad> Roads;
+};
+
+/**
+ * One batch of path queries, shared between the game thread and the worker solving it. Cached queries
+ * are answered when the batch is created; Run solves the rest, grouped by source landmark so each
+ * distinct source costs one search, with the groups spread over the workers.
+ */
+class WORLDFORGE_API FWorldForgePathBatch
+{
+public:
+    FWorldForgePathBatch(TArray<FWorldForgePathQuery>&& InQueries, TSharedPtr<const FWorldForgePathGraph, ESPMode::ThreadSafe> InGraph, uint32 InGraphVersion);
+
+    /** Solve every query the cache could not answer. Worker thread. */
+    void Run();
+
+    /** True when nothing is left for Run */
+    bool IsSolved() const { return Misses.Num() == 0 || bSolved; }
+
+    const TArray<FWorldForgePathQuery>& GetQueries() const { return Queries; }
+
+    /** One path per query, in query order, once solved */
+    const TArray<FWorldForgePathPtr>& GetResults() const { return Results; }
+
+private:
+    friend class FWorldForgePathService;
+
+    TArray<FWorldForgePathQuery> Queries;
+    TArray<FWorldForgePathPtr> Results;
+
+    /** Indices of the queries Run solves */
+    TArray<int32> Misses;
+
+    TSharedPtr<const FWorldForgePathGraph, ESPMode::ThreadSafe> Graph;
+    uint32 GraphVersion = 0;
+    double StartTime = 0.0;
+    double SolveSeconds = 0.0;
+    std::atomic<bool> bSolved{ false };
+};
+
+/**
+ * Landmark-to-landmark path queries for caravans and patrols, answered in batches off the game thread.
+ *
+ * Paths are cached per ordered pair of landmark IDs. A cached path stays valid until the graph changes
+ * under it: a removed or re-routed road drops the paths that travel it, a removed landmark the paths
+ * that start, end or pass there, and a new road every path, since it may offer a cheaper route. Batches
+ * solved against a graph that changed while they ran are delivered but not cached. Game thread only,
+ * apart from FWorldForgePathBatch::Run.
+ */
+class WORLDFORGE_API FWorldForgePathService
+{
+public:
+    struct FStats
+    {
+        /** Queries received and answered from the cache */
+        int64 Queries = 0;
+        int64 CacheHits = 0;
+
+        /** Queries solved on workers, and those with no connecting roads */
+        int64 Solved = 0;
+        int64 NotFound = 0;
+
+        int32 Batches = 0;
+        int32 GraphBuilds = 0;
+
+        /** Cached paths dropped by graph changes, and by the capacity limit */
+        int64 Invalidated = 0;
+        int64 Evicted = 0;
+
+        /** Worker time spent solving, and the last batch from request to commit */
+        double SolveSeconds = 0.0;
+        double LastBatchMs = 0.0;
+        int32 LastBatchQueries = 0;
+
+        float GetHitRate() const { return Queries > 0 ? static_cast<float>(CacheHits) / Queries : 0.0f; }
+        double GetSolvedPerSecond() const { return SolveSeconds > 0.0 ? Solved / SolveSeconds : 0.0; }
+    };
+
+    /** Cached paths kept at most; the least recently used quarter is dropped when it is exceeded */
+    void SetCapacity(int32 InCapacity) { Capacity = FMath::Max(InCapacity, 1); }
+
+    /**
+     * Start a batch. Cached queries are answered now; the graph snapshot the rest are solved against is
+     * rebuilt from the network first if it changed since the last batch.
+     */
+    TSharedRef<FWorldForgePathBatch, ESPMode::ThreadSafe> BeginBatch(TArray<FWorldForgePathQuery>&& Queries, const FWorldForgeRoadNetwork& Network);
+
+    /** Cache a solved batch's paths, unless the graph changed while it ran */
+    void CommitBatch(FWorldForgePathBatch& Batch);
+
+    /** A road was routed for the first time */
+    void OnRoadAdded();
+
+    /** A road was removed or re-routed */
+    void InvalidateRoad(const FString& RoadKey);
+
+    /** A landmark was removed */
+    void InvalidateLandmark(const FString& LandmarkId);
+
+    /** Drop every cached path and the graph snapshot */
+    void Clear();
+
+    int32 NumCached() const { return Cache.Num(); }
+    const FStats& GetStats() const { return Stats; }
+
+private:
+    struct FEntry
+    {
+        FWorldForgePathPtr Path;
+        uint64 LastUsed = 0;
+    };
+
+    static FString MakeKey(const FString& FromId, const FString& ToId);
+
+    void RemoveWhere(TFunctionRef<bool(const FWorldForgePath&)> Predicate);
+    void Evict();
+
+    TMap<FString, FEntry> Cache;
+    int32 Capacity = 4096;
+    uint64 UseCounter = 0;
+
+    TSharedPtr<const FWorldForgePathGraph, ESPMode::ThreadSafe> Graph;
+    uint32 GraphVersion = 1;
+    uint32 SnapshotVersion = 0;
+
+    FStats Stats;
+};
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+
+/**
+ * Hybrid logical clock timestamp: wall-clock milliseconds, a counter for events within the same
+ * millisecond or behind a faster clock, and the ID of the node that made it. Ordered in that
+ * order, so any two stamps from different nodes compare unequal.
+ */
+struct WORLDFORGE_API FWorldForgeHlc
+{
+    int64 Wall = 0;
+    uint32 Counter = 0;
+    uint32 Node = 0;
+
+    bool IsSet() const { return Wall != 0 || Counter != 0; }
+
+    bool operator==(const FWorldForgeHlc& Other) const { return Wall == Other.Wall && Counter == Other.Counter && Node == Other.Node; }
+    bool operator!=(const FWorldForgeHlc& Other) const { return !(*this == Other); }
+    bool operator<(const FWorldForgeHlc& Other) const
+    {
+        if (Wall != Other.Wall) return Wall < Other.Wall;
+        if (Counter != Other.Counter) return Counter < Other.Counter;
+        return Node < Other.Node;
+    }
+    bool operator<=(const FWorldForgeHlc& Other) const { return !(Other < *this); }
+
+    friend uint32 GetTypeHash(const FWorldForgeHlc& Stamp)
+    {
+        return HashCombine(HashCombine(::GetTypeHash(Stamp.Wall), ::GetTypeHash(Stamp.Counter)), ::GetTypeHash(Stamp.Node));
+    }
+};
+
+/**
+ * Issues stamps for one node. A stamp is later than every stamp the node issued or observed before
+ * it, and stays close to wall-clock time however far the clocks of other nodes drift.
+ */
+class WORLDFORGE_API FWorldForgeHybridClock
+{
+public:
+    explicit FWorldForgeHybridClock(uint32 InNode = 0) : Node(InNode) {}
+
+    uint32 GetNode() const { return Node; }
+
+    /** The latest stamp issued or observed */
+    const FWorldForgeHlc& GetLast() const { return Last; }
+
+    /** Stamp a local event */
+    FWorldForgeHlc Tick(int64 PhysicalMs);
+
+    /** Advance past a stamp received from another node */
+    void Observe(const FWorldForgeHlc& Remote, int64 PhysicalMs);
+
+    /** Milliseconds since the Unix epoch, the physical time the clocks of all nodes share */
+    static int64 GetPhysicalMs();
+
+private:
+    uint32 Node;
+    FWorldForgeHlc Last;
+};
+
+enum class EWorldForgeReplicaOpKind : uint8
+{
+    Era,
+    Seed,
+    Trait,
+    Atmosphere,
+    AddLandmark,
+    RemoveLandmark
+};
+
+/**
+ * One change to a replica, as made by an editor and as sent to the others. Only the fields of its
+ * kind are used. An add is tagged with its own stamp; a remove lists the add tags it observed.
+ */
+struct WORLDFORGE_API FWorldForgeReplicaOp
+{
+    EWorldForgeReplicaOpKind Kind = EWorldForgeReplicaOpKind::Trait;
+    FWorldForgeHlc Stamp;
+
+    FWorldForgeEra Era;
+    int32 Seed = 0;
+    EWorldForgeTrait Trait = EWorldForgeTrait::Militarism;
+    float Value = 0.0f;
+    EWorldForgeAtmosphere Atmosphere = EWorldForgeAtmosphere::Mysterious;
+
+    /** The landmark added, or just the ID of the one removed */
+    FWorldForgeLandmark Landmark;
+    TArray<FWorldForgeHlc> Tags;
+};
+
+/**
+ * The world state as a conflict-free replicated data type, so edits made concurrently by several
+ * editors merge to the same result in any order and without a lock.
+ *
+ * Era, seed, each trait and the atmosphere are last-writer-wins registers: the write with the latest
+ * stamp wins. Landmarks are an observed-remove set: each add carries a unique tag and a remove
+ * deletes only the tags its author had seen, so an add concurrent with a remove survives it. A
+ * landmark's data is a register of its own, taken from its latest add. Merging is commutative,
+ * associative and idempotent; duplicate and out-of-order ops are harmless. Removed tags are kept
+ * as tombstones so adds delivered after their remove stay removed, until every editor is known to
+ * be past them and no such add can still be on its way.
+ */
+class WORLDFORGE_API FWorldForgeReplica
+{
+public:
+    struct FStats
+    {
+        /** Ops that changed the replica, and ops that lost to a later write or were already merged */
+        int32 Merged = 0;
+        int32 Stale = 0;
+
+        /** Tombstones held, dropped once causally stable, and dropped early by the limit */
+        int32 Tombstones = 0;
+        int32 Collected = 0;
+        int32 Evicted = 0;
+    };
+
+    static FWorldForgeReplicaOp MakeEra(const FWorldForgeEra& Era, const FWorldForgeHlc& Stamp);
+    static FWorldForgeReplicaOp MakeSeed(int32 Seed, const FWorldForgeHlc& Stamp);
+    static FWorldForgeReplicaOp MakeTrait(EWorldForgeTrait Trait, float Value, const FWorldForgeHlc& Stamp);
+    static FWorldForgeReplicaOp MakeAtmosphere(EWorldForgeAtmosphere Atmosphere, const FWorldForgeHlc& Stamp);
+    static FWorldForgeReplicaOp MakeAdd(const FWorldForgeLandmark& Landmark, const FWorldForgeHlc& Stamp);
+
+    /** Remove a landmark as seen by an editor at Stamp: the tags of this replica no later than it */
+    FWorldForgeReplicaOp MakeRemove(const FString& LandmarkId, const FWorldForgeHlc& Stamp) const;
+
+    /** Merge an op. Returns true if it changed what the replica holds. */
+    bool Merge(const FWorldForgeReplicaOp& Op);
+
+    /** Reset to a state, its fields and landmarks all written at Stamp */
+    void Reset(const FWorldForgeState& State, const FWorldForgeHlc& Stamp);
+
+    bool ContainsLandmark(const FString& LandmarkId) const;
+    const FWorldForgeLandmark* FindLandmark(const FString& LandmarkId) const;
+    int32 NumLandmarks() const;
+
+    /** The merged state, landmarks ordered by ID so equal replicas give equal states */
+    void ToState(FWorldForgeState& OutState) const;
+
+    void ForEachLandmark(TFunctionRef<void(const FWorldForgeLandmark&)> Visitor) const;
+
+    /** Unstamped ops that write the scalar fields where State differs from the replica */
+    void DiffScalars(const FWorldForgeState& State, TArray<FWorldForgeReplicaOp>& OutOps) const;
+
+    /**
+     * Drop the tombstones of tags no later than Stable, a stamp every editor has sent ops past; the adds
+     * they guard against have all arrived. Returns the number dropped.
+     */
+    int32 CollectTombstones(const FWorldForgeHlc& Stable);
+
+    /**
+     * Drop the oldest tombstones beyond MaxTombstones. An add of an evicted tag delivered later would
+     * come back. Returns the number dropped.
+     */
+    int32 TrimTombstones(int32 MaxTombstones);
+
+    const FStats& GetStats() const { return Stats; }
+
+private:
+    template <typename ValueType>
+    struct TRegister
+    {
+        ValueType Value{};
+        FWorldForgeHlc Stamp;
+
+        /** Take the value if it was written later */
+        bool Merge(const ValueType& InValue, const FWorldForgeHlc& InStamp)
+        {
+            if (InStamp <= Stamp)
+            {
+                return false;
+            }
+            Value = InValue;
+            Stamp = InStamp;
+            return true;
+        }
+    };
+
+    struct FLandmarkEntry
+    {
+        TRegister<FWorldForgeLandmark> Data;
+        TArray<FWorldForgeHlc> Tags;
+        TArray<FWorldForgeHlc> Tombstones;
+
+        bool IsPresent() const { return Tags.Num() > 0; }
+    };
+
+    TRegister<FWorldForgeEra> Era;
+    TRegister<int32> Seed;
+    TRegister<float> Traits[5];
+    TRegister<EWorldForgeAtmosphere> Atmosphere;
+    TMap<FString, FLandmarkEntry> Landmarks;
+    FStats Stats;
+
+    bool MergeAdd(const FWorldForgeReplicaOp& Op);
+    bool MergeRemove(const FWorldForgeReplicaOp& Op);
+    int32 DropTombstones(const FWorldForgeHlc& Through);
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "WorldForgeRoadActor.generated.h"
+
+class UProceduralMeshComponent;
+class UMaterialInterface;
+struct FWorldForgeTerrainMeshData;
+
+/**
+ * Renders routed roads as sections of one collision-free procedural mesh, one section per road.
+ * Mesh data is built on the routing workers; this actor only uploads it.
+ */
+UCLASS(NotBlueprintable)
+class WORLDFORGE_API AWorldForgeRoadActor : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AWorldForgeRoadActor();
+
+    /** Create or replace the section for a road */
+    void SetRoad(const FString& Key, const FWorldForgeTerrainMeshData& MeshData);
+
+    /** Remove a road's section. Returns false if the road is not present. */
+    bool RemoveRoad(const FString& Key);
+
+    /** Remove every road */
+    void ClearRoads();
+
+    int32 GetRoadCount() const { return RoadSections.Num(); }
+
+    /** Material applied to every road section; when unset the engine default material is used */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WorldForge")
+    TObjectPtr<UMaterialInterface> RoadMaterial;
+
+private:
+    UPROPERTY(VisibleAnywhere, Category = "Components")
+    TObjectPtr<UProceduralMeshComponent> RoadMesh;
+
+    /** Section index per road key. Freed sections are cleared and reused. */
+    TMap<FString, int32> RoadSections;
+    TArray<int32> FreeSections;
+    int32 NextSection = 0;
+};
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+#include "WorldForgeTerrainGenerator.h"
+
+class FWorldForgeHeightCache;
+class FWorldForgeWaterMap;
+
+/**
+ * How many roads are built and what they avoid, derived from the world traits.
+ */
+struct WORLDFORGE_API FWorldForgeRoadSettings
+{
+    /** A road is added beside the spanning tree when travel over existing roads is this many times the direct distance */
+    float MaxDetour = 2.5f;
+
+    /** Landmarks farther apart than this are never connected directly */
+    float MaxEdgeLength = 20000.0f;
+
+    /** Routing grid cell size in Unreal units; coarsened for long roads so a route stays under MaxRouteCells */
+    float CellSize = 200.0f;
+    int32 MaxRouteCells = 256 * 256;
+
+    /** Extra cost per unit of squared slope, and per unit of length through river cells */
+    float SlopeCost = 40.0f;
+    float WaterCost = 10.0f;
+
+    float Width = 300.0f;
+
+    /** Openness builds more redundant roads, prosperity builds bridges and wider roads */
+    static FWorldForgeRoadSettings FromState(const FWorldForgeState& State);
+
+    bool operator==(const FWorldForgeRoadSettings& Other) const;
+    bool operator!=(const FWorldForgeRoadSettings& Other) const { return !(*this == Other); }
+};
+
+/**
+ * A routed road between two landmarks, as a polyline following the terrain.
+ */
+struct WORLDFORGE_API FWorldForgeRoad
+{
+    FString FromId;
+    FString ToId;
+    TArray<FVector> Points;
+    float Cost = 0.0f;
+};
+
+/**
+ * Candidate edge between two sites (indices into the site array)
+ */
+struct WORLDFORGE_API FWorldForgeRoadEdge
+{
+    int32 A = INDEX_NONE;
+    int32 B = INDEX_NONE;
+    float Length = 0.0f;
+};
+
+/**
+ * Road network construction: which landmarks to connect, and the route of each road.
+ * All functions are pure and thread-safe.
+ */
+class WORLDFORGE_API FWorldForgeRoadPlanner
+{
+public:
+    /** Settlements, fortresses and monasteries are connected; ruins and natural landmarks are not */
+    static bool ConnectsType(EWorldForgeLandmarkType Type);
+
+    /** Relative neighborhood graph over the sites, limited to edges shorter than MaxEdgeLength */
+    static void BuildCandidateGraph(TConstArrayView<FVector2D> Sites, float MaxEdgeLength, TArray<FWorldForgeRoadEdge>& OutEdges);
+
+    /** Minimum spanning forest of the candidates, plus candidates whose detour over the chosen roads exceeds MaxDetour */
+    static void SelectRoads(int32 NumSites, TConstArrayView<FWorldForgeRoadEdge> Candidates, float MaxDetour, TArray<FWorldForgeRoadEdge>& OutRoads);
+
+    /**
+     * A* over a cost grid between two points, penalizing slope and river crossings.
+     * Heights and water come from the caches when they are given and cover the route; elsewhere the ground is flat.
+     */
+    static bool Route(const FVector& Start, const FVector& End, const FWorldForgeRoadSettings& Settings,
+                      const FWorldForgeHeightCache* Heights, const FWorldForgeWaterMap* Water, FWorldForgeRoad& OutRoad);
+
+    /** Flat ribbon mesh along a road */
+    static void BuildRoadMesh(const FWorldForgeRoad& Road, float Width, FWorldForgeTerrainMeshData& OutMesh);
+};
+
+/**
+ * The set of roads between the current landmarks. Adding or removing a landmark recomputes which roads
+ * exist (cheap) and only the roads that appear, or whose terrain changed, are handed out for routing.
+ * Routes are computed elsewhere and committed back with the version they were requested with, so results
+ * for superseded requests are dropped. Game thread only.
+ */
+class WORLDFORGE_API FWorldForgeRoadNetwork
+{
+public:
+    struct FRouteRequest
+    {
+        FString Key;
+        FString FromId;
+        FString ToId;
+        FVector Start = FVector::ZeroVector;
+        FVector End = FVector::ZeroVector;
+        uint32 Version = 0;
+    };
+
+    /** Topology changes take effect on the next Update; routing changes re-route every road */
+    void SetSettings(const FWorldForgeRoadSettings& InSettings);
+    const FWorldForgeRoadSettings& GetSettings() const { return Settings; }
+
+    /** Returns false for duplicates and landmark types that are not connected */
+    bool AddSite(const FWorldForgeLandmark& Landmark);
+    bool RemoveSite(const FString& LandmarkId);
+    void Clear();
+
+    /** Re-route the roads passing near a world-space box (e.g. when terrain under them changed) */
+    void InvalidateRegion(const FBox2D& Region);
+
+    /** Re-route every road */
+    void InvalidateAll();
+
+    bool HasPendingChanges() const;
+
+    /**
+     * Apply queued changes.
+     * @param OutRequests Roads to route (new, or invalidated)
+     * @param OutRemoved Keys of roads that no longer exist
+     */
+    void Update(TArray<FRouteRequest>& OutRequests, TArray<FString>& OutRemoved);
+
+    /** Store a finished route. Returns false if the road was removed or re-requested since. */
+    bool CommitRoute(const FString& Key, uint32 Version, FWorldForgeRoad&& Road);
+
+    const FWorldForgeRoad* FindRoad(const FString& Key) const;
+
+    /** Visit every road that has a route, with its key */
+    void ForEachRoutedRoad(TFunctionRef<void(const FString& Key, const FWorldForgeRoad& Road)> Visitor) const;
+
+    int32 NumSites() const { return Sites.Num(); }
+    int32 NumRoads() const { return Roads.Num(); }
+    int32 NumRoutedRoads() const;
+
+    /** Key of the road between two landmarks, independent of their order */
+    static FString MakeKey(const FString& A, const FString& B);
+
+private:
+    struct FRoadState
+    {
+        FString FromId;
+        FString ToId;
+        FBox2D Bounds;
+        uint32 Version = 0;
+        bool bNeedsRoute = true;
+        bool bRouted = false;
+        FWorldForgeRoad Road;
+    };
+
+    FWorldForgeRoadSettings Settings;
+    TMap<FString, FVector> Sites;
+    TMap<FString, FRoadState> Roads;
+    uint32 NextVersion = 1;
+    bool bTopologyDirty = false;
+};
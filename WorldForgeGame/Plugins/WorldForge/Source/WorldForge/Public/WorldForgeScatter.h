@@ -0,0 +1,176 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "WorldForgeTypes.h"
+
+class FWorldForgeHeightCache;
+class FWorldForgeWaterMap;
+
+/**
+ * Layers of scattered vegetation and props. Each layer is rendered with its own instanced meshes
+ * and regenerated independently of the others.
+ */
+enum class EWorldForgeScatterLayer : uint8
+{
+    Trees,
+    Shrubs,
+    Rocks,
+    DeadTrees,
+    Shrines,
+    Props,
+    Count
+};
+
+/**
+ * Density rule for one scatter layer. Density is instances per hectare, scaled by the traits and atmosphere.
+ */
+struct WORLDFORGE_API FWorldForgeScatterRule
+{
+    EWorldForgeScatterLayer Layer = EWorldForgeScatterLayer::Trees;
+
+    /** Instances per hectare with every trait at 0.5 */
+    float BaseDensity = 0.0f;
+
+    /** Density multiplier change per EWorldForgeTrait as the trait goes from 0.5 to 1 (negative thins the layer) */
+    float TraitWeights[5] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+    /** Density multiplier per EWorldForgeAtmosphere */
+    float AtmosphereScale[6] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+
+    float MinScale = 1.0f;
+    float MaxScale = 1.0f;
+
+    /** Instances are kept this far from landmarks that exclude scatter, or within it for props */
+    float LandmarkRadius = 0.0f;
+    bool bNearLandmarks = false;
+
+    /** Steepest ground accepted, as the minimum Z of the surface normal */
+    float MinNormalZ = 0.0f;
+
+    bool bAvoidWater = true;
+
+    /** Distance at which instances are culled */
+    float CullDistance = 20000.0f;
+
+    /** Instances per hectare for a world state */
+    float GetDensity(const FWorldForgeState& State) const;
+};
+
+/**
+ * A rule resolved against the current world state: what a worker needs to generate the layer for a cell.
+ */
+struct WORLDFORGE_API FWorldForgeScatterLayerParams
+{
+    FWorldForgeScatterRule Rule;
+    float Density = 0.0f;
+    int32 Seed = 0;
+
+    /** Parameters differ enough to change the generated instances */
+    bool operator==(const FWorldForgeScatterLayerParams& Other) const;
+    bool operator!=(const FWorldForgeScatterLayerParams& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Scatter placement. All functions are pure and thread-safe.
+ */
+class WORLDFORGE_API FWorldForgeScatter
+{
+public:
+    static constexpr int32 NumLayers = static_cast<int32>(EWorldForgeScatterLayer::Count);
+
+    /** The built-in rule for each layer */
+    static const FWorldForgeScatterRule& GetRule(EWorldForgeScatterLayer Layer);
+
+    /** One layer resolved against a world state. The density is quantized so small trait changes keep the layer. */
+    static FWorldForgeScatterLayerParams MakeLayer(const FWorldForgeState& State, EWorldForgeScatterLayer Layer);
+
+    /** Every layer resolved against a world state */
+    static void MakeLayers(const FWorldForgeState& State, TArray<FWorldForgeScatterLayerParams>& OutLayers);
+
+    /** Landmark types whose surroundings are kept clear of vegetation (and gather props) */
+    static bool ExcludesScatter(EWorldForgeLandmarkType Type);
+
+    /**
+     * Instance transforms of one layer in one cell. Candidates are drawn from a stream seeded by the world
+     * seed, layer and cell, and always consumed in the same order, so a changed landmark or density only
+     * adds or removes the instances it affects. Candidates off the cached terrain are dropped.
+     * @param Landmarks 2D locations of the landmarks near the cell that exclude scatter
+     */
+    static void GenerateCell(const FWorldForgeScatterLayerParams& Layer, FIntPoint Cell, const FBox2D& Bounds,
+                             TConstArrayView<FVector2D> Landmarks, const FWorldForgeHeightCache& Heights,
+                             const FWorldForgeWaterMap* Water, TArray<FTransform>& OutTransforms);
+};
+
+/**
+ * Which layers of which cells of a square grid centered on the origin need regenerating.
+ * Every (cell, layer) pair has a version that is bumped when it is handed out, so results for
+ * superseded requests are dropped without losing other layers of the same cell. Game thread only.
+ */
+class WORLDFORGE_API FWorldForgeScatterGrid
+{
+public:
+    struct FCellRequest
+    {
+        FIntPoint Cell = FIntPoint::ZeroValue;
+        uint32 LayerMask = 0;
+        TStaticArray<uint32, FWorldForgeScatter::NumLayers> Versions{InPlace, 0u};
+    };
+
+    static constexpr uint32 AllLayers = (1u << FWorldForgeScatter::NumLayers) - 1;
+
+    /** Resize the grid; every cell of every layer is regenerated */
+    void SetGrid(int32 InCellsPerSide, float InCellSize);
+    int32 GetCellsPerSide() const { return CellsPerSide; }
+    float GetCellSize() const { return CellSize; }
+
+    /** Replace the resolved layers; only the layers whose parameters changed are marked dirty */
+    void SetLayers(TArray<FWorldForgeScatterLayerParams>&& InLayers);
+    const TArray<FWorldForgeScatterLayerParams>& GetLayers() const { return Layers; }
+
+    /** Largest landmark radius of any layer, for sizing dirty regions around landmarks */
+    float GetMaxLandmarkRadius() const;
+
+    /** Mark the layers of the cells overlapping a world-space box dirty */
+    void MarkRegionDirty(const FBox2D& Region, uint32 LayerMask = AllLayers);
+    void MarkAllDirty(uint32 LayerMask = AllLayers);
+
+    bool HasPendingChanges() const { return NumDirtyCells > 0; }
+
+    /** Hand out up to MaxCells dirty cells, nearest to Focus first */
+    void TakeDirtyCells(const FVector2D& Focus, int32 MaxCells, TArray<FCellRequest>& OutRequests);
+
+    /**
+     * Hand out the given layers of one cell, for results generated ahead of time. Only layers that are dirty
+     * are taken; returns false if none are.
+     */
+    bool ClaimCell(FIntPoint Cell, uint32 LayerMask, FCellRequest& OutRequest);
+
+    /** Cells overlapping a world-space box */
+    void GetCellsInRegion(const FBox2D& Region, TArray<FIntPoint>& OutCells) const;
+
+    /** Up to MaxCells cells, nearest to Focus first */
+    void GetNearestCells(const FVector2D& Focus, int32 MaxCells, TArray<FIntPoint>& OutCells) const;
+
+    /** True if a result for this layer of the cell is still the latest requested */
+    bool IsCurrent(FIntPoint Cell, int32 Layer, uint32 Version) const;
+
+    FBox2D GetCellBounds(FIntPoint Cell) const;
+
+private:
+    struct FCellState
+    {
+        uint32 DirtyLayers = 0;
+        TStaticArray<uint32, FWorldForgeScatter::NumLayers> Versions{InPlace, 0u};
+    };
+
+    int32 CellsPerSide = 0;
+    float CellSize = 0.0f;
+    TArray<FCellState> Cells;
+    TArray<FWorldForgeScatterLayerParams> Layers;
+    int32 NumDirtyCells = 0;
+    uint32 NextVersion = 1;
+
+    float GetGridOrigin() const { return -0.5f * CellsPerSide * CellSize; }
+    void MarkCellDirty(int32 Index, uint32 LayerMask);
+};
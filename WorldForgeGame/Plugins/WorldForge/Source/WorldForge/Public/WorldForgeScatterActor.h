@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "WorldForgeScatter.h"
+#include "WorldForgeScatterActor.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/**
+ * Renders scattered vegetation and props as hierarchical instanced meshes partitioned by scatter cell:
+ * one component per layer per cell, so regenerating a cell or a layer rebuilds only its own components
+ * and distant cells are culled as a whole.
+ */
+UCLASS(NotBlueprintable)
+class WORLDFORGE_API AWorldForgeScatterActor : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AWorldForgeScatterActor();
+
+    /** Replace the instances of one layer in one cell; an empty array removes them */
+    void SetInstances(EWorldForgeScatterLayer Layer, FIntPoint Cell, const TArray<FTransform>& Transforms);
+
+    /** Remove every instance */
+    void ClearInstances();
+
+    int32 GetInstanceCount() const;
+
+    /** Mesh per EWorldForgeScatterLayer; engine basic shapes until real assets are assigned */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WorldForge")
+    TArray<TObjectPtr<UStaticMesh>> LayerMeshes;
+
+private:
+    UPROPERTY(VisibleAnywhere, Category = "Components")
+    TObjectPtr<USceneComponent> SceneRoot;
+
+    /** Instanced component per layer and cell. Emptied components are kept and reused. */
+    UPROPERTY()
+    TMap<FIntVector, TObjectPtr<UHierarchicalInstancedStaticMeshComponent>> CellComponents;
+
+    UHierarchicalInstancedStaticMeshComponent* GetOrCreateComponent(EWorldForgeScatterLayer Layer, FIntPoint Cell);
+};
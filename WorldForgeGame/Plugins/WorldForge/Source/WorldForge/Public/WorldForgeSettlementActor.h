@@ -6,13 +6,20 @@
 #include "WorldForgeSettlementActor.generated.h"
 
 class UStaticMeshComponent;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+struct FWorldForgeSettlementLayout;
 class UBillboardComponent;
 class USphereComponent;
-class UTextRenderComponent;
+
+class AWorldForgeSettlementActor;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSettlementActorLifetime, AWorldForgeSettlementActor*);
 
 /**
  * Base actor for all WorldForge landmarks/settlements.
  * Spawned by the WorldForge subsystem when SPAWN_SETTLEMENT commands are received.
+ * Name labels are drawn by AWorldForgeLabelManager for the nearest landmarks only.
  */
 UCLASS(BlueprintType, Blueprintable)
 class WORLDFORGE_API AWorldForgeSettlementActor : public AActor
@@ -30,8 +37,48 @@ public:
     UFUNCTION(BlueprintPure, Category = "WorldForge")
     FWorldForgeLandmark GetLandmarkData() const { return LandmarkData; }
 
+    const FString& GetLandmarkId() const { return LandmarkData.Id; }
+
+    /** Get color for landmark type */
+    static FLinearColor GetColorForType(EWorldForgeLandmarkType Type);
+
+    /** Get scale for landmark type */
+    static FVector GetScaleForType(EWorldForgeLandmarkType Type);
+
+    /** Bounds a landmark's buildings and crowds can occupy, for navmesh rebuilds */
+    static FBox GetNavigationBounds(const FWorldForgeLandmark& Landmark);
+
+    /** Distance beyond which landmark meshes are culled (0 = never), from WorldForge.LandmarkCullDistance */
+    static float GetLandmarkCullDistance();
+
+    /** Generate the building layout on a worker thread; the result is committed on the game thread */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge")
+    void RegenerateLayout();
+
+    /** Hash of the committed layout (0 until one is committed), for comparing layouts between runs */
+    UFUNCTION(BlueprintPure, Category = "WorldForge")
+    int32 GetLayoutHash() const { return static_cast<int32>(LayoutHash); }
+
+    /** Detail tier assigned from the actor's significance; High until the first significance pass */
+    UFUNCTION(BlueprintPure, Category = "WorldForge")
+    EWorldForgeSignificanceTier GetSignificanceTier() const { return SignificanceTier; }
+
+    /** Show or hide detail for a tier. Called by the subsystem after each significance pass. */
+    void SetSignificanceTier(EWorldForgeSignificanceTier Tier);
+
+    /** Gameplay weight on the significance score, from the landmark type and the traits */
+    void SetSignificanceRelevance(float Relevance) { SignificanceRelevance = Relevance; }
+
+    /**
+     * Fired once an actor has its landmark data, and when it leaves play (destroyed, demoted to an
+     * instance, or the world tears down), so systems can tie content to a settlement's lifetime.
+     */
+    static FOnSettlementActorLifetime OnSettlementInitialized;
+    static FOnSettlementActorLifetime OnSettlementEndPlay;
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     // ========== Components ==========
 
@@ -39,13 +86,17 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     TObjectPtr<USceneComponent> SceneRoot;
 
-    /** Visual representation mesh */
+    /** Placeholder mesh shown until the generated layout is committed */
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     TObjectPtr<UStaticMeshComponent> MeshComponent;
 
-    /** Text label showing settlement name */
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-    TObjectPtr<UTextRenderComponent> NameLabel;
+    /** Meshes for each EWorldForgeLayoutPiece, indexed by piece kind */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "WorldForge|Layout")
+    TArray<TObjectPtr<UStaticMesh>> PieceMeshes;
+
+    /** One instanced component per layout piece kind, created when a layout is committed */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UInstancedStaticMeshComponent>> LayoutComponents;
 
     // ========== Data ==========
 
@@ -57,10 +108,22 @@ protected:
     UFUNCTION(BlueprintNativeEvent, Category = "WorldForge")
     void UpdateVisuals();
 
+    /** Replace the layout instances with a generated layout. Game thread only. */
+    void CommitLayout(const FWorldForgeSettlementLayout& Layout);
+
 private:
-    /** Get color for landmark type */
-    FLinearColor GetColorForType(EWorldForgeLandmarkType Type) const;
+    /** Incremented per request so results of superseded generations are dropped */
+    uint32 LayoutRequestId = 0;
 
-    /** Get scale for landmark type */
-    FVector GetScaleForType(EWorldForgeLandmarkType Type) const;
+    uint32 LayoutHash = 0;
+
+    EWorldForgeSignificanceTier SignificanceTier = EWorldForgeSignificanceTier::High;
+    float SignificanceRelevance = 1.0f;
+    bool bSignificanceRegistered = false;
+
+    /** Register with the world's significance manager, if it has one */
+    void RegisterSignificance();
+    void UnregisterSignificance();
+
+    void ApplySignificanceTier();
 };
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+
+/**
+ * Per-frame tier budgets and score thresholds.
+ */
+struct WORLDFORGE_API FWorldForgeSignificanceSettings
+{
+    /** At most this many landmarks are High, and this many more Medium; the rest drop a tier */
+    int32 MaxHigh = 8;
+    int32 MaxMedium = 32;
+
+    /** Minimum score for each tier; below LowThreshold a landmark is Dormant */
+    float HighThreshold = 0.15f;
+    float MediumThreshold = 0.04f;
+    float LowThreshold = 0.005f;
+};
+
+/**
+ * Scoring and tiering of landmark actors registered with the engine's significance manager.
+ *
+ * A landmark's score is its projected size (bounds radius over distance), reduced when it is behind the
+ * camera, times a gameplay relevance from its type and the traits: fortresses matter more in a
+ * militaristic world, monasteries in a religious one. Tiers are then handed out in score order under
+ * the per-tier budgets, so the number of full-detail landmarks stays bounded however many are near.
+ */
+class WORLDFORGE_API FWorldForgeSignificance
+{
+public:
+    /** Tag landmark actors are registered under */
+    static const FName Tag;
+
+    static constexpr int32 NumTiers = 4;
+
+    static float Score(const FTransform& Viewpoint, const FVector& Location, float BoundsRadius, float Relevance);
+
+    static float GetRelevance(EWorldForgeLandmarkType Type, float Militarism, float Prosperity, float Religiosity);
+
+    /**
+     * Tier per score, for scores sorted in descending order. OutCounts receives the landmarks per tier.
+     */
+    static void AssignTiers(TConstArrayView<float> SortedScores, const FWorldForgeSignificanceSettings& Settings,
+                            TArray<EWorldForgeSignificanceTier>& OutTiers, int32 OutCounts[NumTiers]);
+
+    /** Publish tier counts to "stat WorldForge" */
+    static void SetStats(const int32 Counts[NumTiers]);
+};
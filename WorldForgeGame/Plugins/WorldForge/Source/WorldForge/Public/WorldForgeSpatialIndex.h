@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+
+/**
+ * Entry stored in the landmark spatial index
+ */
+struct FWorldForgeSpatialEntry
+{
+    FString Id;
+    FString Name;
+    EWorldForgeLandmarkType Type = EWorldForgeLandmarkType::Settlement;
+    FVector Location = FVector::ZeroVector;
+};
+
+/**
+ * Uniform 2D grid over landmark locations (XY only).
+ * Answers radius and nearest-N queries without scanning every landmark.
+ * Entry pointers returned by queries are only valid until the next Add or Remove.
+ */
+class WORLDFORGE_API FWorldForgeSpatialIndex
+{
+public:
+    explicit FWorldForgeSpatialIndex(float InCellSize = 5000.0f);
+
+    void Add(const FWorldForgeLandmark& Landmark);
+    bool Remove(const FString& LandmarkId);
+    void Clear();
+
+    int32 Num() const { return IdToCell.Num(); }
+
+    /** True if any landmark lies within Radius of Location */
+    bool HasAnyWithin(const FVector& Location, float Radius) const;
+
+    /** Collect every landmark within Radius of Location (unordered) */
+    void QueryRadius(const FVector& Location, float Radius, TArray<const FWorldForgeSpatialEntry*>& OutEntries) const;
+
+    /** Collect up to MaxCount landmarks within MaxDistance of Location, nearest first */
+    void FindNearest(const FVector& Location, int32 MaxCount, float MaxDistance, TArray<const FWorldForgeSpatialEntry*>& OutEntries) const;
+
+private:
+    float CellSize;
+    TMap<FIntPoint, TArray<FWorldForgeSpatialEntry>> Cells;
+    TMap<FString, FIntPoint> IdToCell;
+
+    FIntPoint GetCell(const FVector& Location) const;
+
+    /** Visit every entry in the cells overlapping the square around Location */
+    template <typename FunctorType>
+    void ForEachInSquare(const FVector& Location, float HalfExtent, FunctorType&& Functor) const;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+
+/**
+ * Queue of landmarks waiting to be spawned.
+ * The subsystem drains it a little every frame within a time budget, nearest to the player first,
+ * so a burst of SPAWN_SETTLEMENT commands appears progressively instead of freezing a frame.
+ */
+class WORLDFORGE_API FWorldForgeSpawnScheduler
+{
+public:
+    /** Queue a landmark. bNeedsPlacement means its location is chosen when it is spawned. */
+    void Enqueue(const FWorldForgeLandmark& Landmark, bool bNeedsPlacement);
+
+    bool Contains(const FString& LandmarkId) const { return PendingIds.Contains(LandmarkId); }
+
+    /** Drop a pending landmark, copying it to OutLandmark if given. Returns false if it was not queued. */
+    bool Remove(const FString& LandmarkId, FWorldForgeLandmark* OutLandmark = nullptr);
+
+    void Clear();
+
+    /**
+     * Spawn pending landmarks nearest to FocusLocation first until BudgetSeconds have elapsed.
+     * At least one landmark is processed per call so the queue always drains.
+     * @return Number of landmarks handed to SpawnFunc
+     */
+    int32 Process(const FVector& FocusLocation, double BudgetSeconds,
+                  TFunctionRef<void(FWorldForgeLandmark& Landmark, bool bNeedsPlacement)> SpawnFunc);
+
+    bool HasPending() const { return Pending.Num() > 0; }
+    int32 GetPendingCount() const { return Pending.Num(); }
+
+    /** Landmarks spawned / queued since the queue was last empty */
+    int32 GetBurstCompleted() const { return BurstCompleted; }
+    int32 GetBurstTotal() const { return BurstTotal; }
+
+private:
+    struct FPendingLandmark
+    {
+        FWorldForgeLandmark Landmark;
+        bool bNeedsPlacement = false;
+        /** Enqueue order, keeps equally distant landmarks first-in first-out */
+        uint64 Sequence = 0;
+    };
+
+    /** Sorted farthest-first so the nearest landmark is popped from the back */
+    TArray<FPendingLandmark> Pending;
+    TSet<FString> PendingIds;
+
+    FVector LastSortFocus = FVector::ZeroVector;
+    bool bNeedsSort = false;
+    uint64 NextSequence = 0;
+
+    int32 BurstCompleted = 0;
+    int32 BurstTotal = 0;
+
+    /** Re-sort when the focus moves farther than this */
+    static constexpr float ResortDistance = 1000.0f;
+
+    void SortByDistance(const FVector& FocusLocation);
+};
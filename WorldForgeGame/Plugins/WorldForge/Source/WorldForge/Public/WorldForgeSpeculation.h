@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+#include "WorldForgeLayoutGenerator.h"
+#include "WorldForgeScatter.h"
+#include "WorldForgeUndo.h"
+#include <atomic>
+
+class FWorldForgeHeightCache;
+class FWorldForgeWaterMap;
+
+/**
+ * One of a dilemma's outcomes as the client will apply it: the traits and atmosphere after the choice,
+ * and the landmarks it founds, placed when the outcome was prepared.
+ */
+struct WORLDFORGE_API FWorldForgeOutcome
+{
+    FString Choice;
+
+    /** The world after the choice; its landmark list is not used */
+    FWorldForgeState State;
+
+    /** The fields State changes against the world the outcome was prepared from; committing writes only these */
+    TArray<FWorldForgeUndoFieldChange> Fields;
+
+    TArray<FWorldForgeLandmark> Landmarks;
+};
+
+/**
+ * A scatter cell to pre-generate for an outcome, with the landmarks around it that keep it clear,
+ * the outcome's own among them. Copied from game-thread state when the outcome is prepared.
+ */
+struct WORLDFORGE_API FWorldForgeOutcomeScatterCell
+{
+    FIntPoint Cell = FIntPoint::ZeroValue;
+    FBox2D Bounds = FBox2D(ForceInit);
+    uint32 LayerMask = 0;
+    TArray<FVector2D> Landmarks;
+
+    /** Instance transforms per layer, filled by the worker for the layers in LayerMask */
+    TArray<TArray<FTransform>> Layers;
+};
+
+/**
+ * Content pre-generated for one outcome.
+ */
+struct WORLDFORGE_API FWorldForgeOutcomeContent
+{
+    struct FLayout
+    {
+        FWorldForgeLayoutParams Params;
+        FWorldForgeSettlementLayout Layout;
+    };
+
+    /** Settlement layouts under the outcome's traits, by landmark ID */
+    TMap<FString, FLayout> Layouts;
+
+    /** Scatter layers under the outcome's traits, and the cells generated with them */
+    TArray<FWorldForgeScatterLayerParams> ScatterLayers;
+    TArray<FWorldForgeOutcomeScatterCell> ScatterCells;
+};
+
+/**
+ * Both outcomes of the dilemma on screen, pre-generated on a worker while the player decides, so the
+ * chosen one can be committed without waiting for layouts or scatter. Shared between the worker and the
+ * game thread; the game thread reads the content only once IsDone, and discards the job on commit or
+ * when the next dilemma is prepared.
+ */
+class WORLDFORGE_API FWorldForgeSpeculation
+{
+public:
+    FWorldForgeSpeculation(const FString& InDilemmaId, TArray<FWorldForgeOutcome>&& InOutcomes,
+                           TArray<TArray<FWorldForgeOutcomeScatterCell>>&& InScatterCells, uint32 InRevision,
+                           TSharedPtr<const FWorldForgeHeightCache, ESPMode::ThreadSafe> InHeights,
+                           TSharedPtr<const FWorldForgeWaterMap, ESPMode::ThreadSafe> InWater);
+
+    /** Generate every outcome's layouts and scatter cells, each stage in parallel. Worker thread. */
+    void Run();
+
+    void Cancel() { bCancelRequested = true; }
+    bool IsDone() const { return bDone; }
+
+    const FString& GetDilemmaId() const { return DilemmaId; }
+
+    /** Landmark and terrain revision of the subsystem when the outcomes were prepared */
+    uint32 GetRevision() const { return Revision; }
+
+    /** Seconds the worker took, once done */
+    double GetSeconds() const { return Seconds; }
+
+    const FWorldForgeOutcome* FindOutcome(const FString& Choice) const;
+
+    /** The outcome's content once IsDone; null for unknown choices */
+    FWorldForgeOutcomeContent* FindContent(const FString& Choice);
+
+private:
+    FString DilemmaId;
+    TArray<FWorldForgeOutcome> Outcomes;
+    TArray<FWorldForgeOutcomeContent> Contents;
+    uint32 Revision = 0;
+    TSharedPtr<const FWorldForgeHeightCache, ESPMode::ThreadSafe> Heights;
+    TSharedPtr<const FWorldForgeWaterMap, ESPMode::ThreadSafe> Water;
+    double Seconds = 0.0;
+
+    std::atomic<bool> bCancelRequested{ false };
+    std::atomic<bool> bDone{ false };
+};
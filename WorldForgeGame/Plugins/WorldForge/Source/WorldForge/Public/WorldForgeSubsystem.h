@@ -3,11 +3,40 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "WorldForgeTypes.h"
+#include "WorldForgeSpawnScheduler.h"
+#include "WorldForgeSpatialIndex.h"
+#include "WorldForgeWorldStore.h"
+#include "WorldForgeTerrainGenerator.h"
+#include "WorldForgeTileStreamer.h"
+#include "WorldForgeHeightCache.h"
+#include "WorldForgeHydrology.h"
+#include "WorldForgeTerritory.h"
+#include "WorldForgeRoads.h"
+#include "WorldForgeScatter.h"
+#include "WorldForgeParameterGraph.h"
+#include "WorldForgeTransitions.h"
+#include "WorldForgeEconomy.h"
+#include "WorldForgeSignificance.h"
+#include "WorldForgeNavBatch.h"
+#include "WorldForgePaths.h"
+#include "WorldForgeSpeculation.h"
+#include "WorldForgeHistory.h"
+#include "WorldForgeUndo.h"
+#include "WorldForgeReplica.h"
 #include "WorldForgeSubsystem.generated.h"
 
 class UWorldForgeWebSocketServer;
 class UWorldForgeDebugWidget;
 class AWorldForgeSettlementActor;
+class AWorldForgeLandmarkInstancer;
+class AWorldForgeLabelManager;
+class AWorldForgeTerrainActor;
+class AWorldForgeTerritoryActor;
+class AWorldForgeRoadActor;
+class AWorldForgeScatterActor;
+class UWorldForgeMaterialCache;
+class UMaterialInterface;
+struct FWorldForgeLayoutParams;
 
 /**
  * Main subsystem for WorldForge functionality.
@@ -26,7 +55,23 @@ public:
     // FTickableGameObject interface
     virtual void Tick(float DeltaTime) override;
     virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UWorldForgeSubsystem, STATGROUP_Tickables); }
-    virtual bool IsTickable() const override { return bWantsDebugWidget && !DebugWidget; }
+    virtual bool IsTickable() const override
+    {
+        return (bWantsDebugWidget && !DebugWidget)
+            || LandmarkRenderMode == EWorldForgeLandmarkRenderMode::Instanced
+            || SpawnScheduler.HasPending()
+            || SpatialIndex.Num() > 0
+            || bTerrainStreaming
+            || Territory.HasPendingChanges()
+            || Roads.HasPendingChanges()
+            || Scatter.HasPendingChanges()
+            || Parameters.HasPendingEvaluations()
+            || Transitions.IsActive()
+            || !Economy.IsEmpty()
+            || HistoryJob.IsValid()
+            || NavBatch.HasPending()
+            || bNavRebuildInFlight;
+    }
     virtual bool IsTickableInEditor() const override { return true; }
 
     // WebSocket Server Control
@@ -50,12 +95,19 @@ public:
     bool IsDebugWidgetVisible() const;
 
     // World State
+    /** The state with its landmarks expanded from the store; copies every landmark, prefer GetSnapshot in C++ */
     UFUNCTION(BlueprintPure, Category = "WorldForge")
-    FWorldForgeState GetWorldState() const { return WorldState; }
+    FWorldForgeState GetWorldState() const { return GetPublishedState(); }
 
     UFUNCTION(BlueprintCallable, Category = "WorldForge")
     void SetWorldState(const FWorldForgeState& NewState);
 
+    /** The world with its landmarks shared rather than copied; constant time however many landmarks there are */
+    FWorldForgeWorldSnapshot GetSnapshot() const { return FWorldForgeWorldSnapshot::Make(WorldState, LandmarkStore); }
+
+    /** The world's landmarks by ID, in shared chunks */
+    const FWorldForgeLandmarkStore& GetLandmarkStore() const { return LandmarkStore; }
+
     // Trait Accessors
     UFUNCTION(BlueprintPure, Category = "WorldForge")
     float GetTrait(EWorldForgeTrait Trait) const;
@@ -63,9 +115,41 @@ public:
     UFUNCTION(BlueprintCallable, Category = "WorldForge")
     void SetTrait(EWorldForgeTrait Trait, float Value);
 
+    // Transitions
+    /** Eased value of a trait, atmosphere weight or atmosphere look channel; moves toward the world state over time */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Transitions")
+    float GetTransitionValue(EWorldForgeTransitionChannel Channel) const { return Transitions.GetValue(Channel); }
+
+    /** Eased trait value, for visuals that should not snap when the trait is set */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Transitions")
+    float GetSmoothedTrait(EWorldForgeTrait Trait) const { return Transitions.GetTrait(Trait); }
+
+    /** How much of an atmosphere preset is blended in, 0 to 1; the weights of all presets sum to 1 */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Transitions")
+    float GetAtmosphereWeight(EWorldForgeAtmosphere Atmosphere) const { return Transitions.GetAtmosphereWeight(Atmosphere); }
+
+    /** Every eased channel at once, indexed by EWorldForgeTransitionChannel */
+    const FWorldForgeTransitions& GetTransitions() const { return Transitions; }
+
     // Settlement/Landmark Management
     UFUNCTION(BlueprintPure, Category = "WorldForge|Landmarks")
-    int32 GetSpawnedLandmarkCount() const { return SpawnedActors.Num(); }
+    int32 GetSpawnedLandmarkCount() const { return LandmarkStore.Num(); }
+
+    /** Add a landmark at its given location and create its representation. Returns false for duplicate IDs. */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Landmarks")
+    bool AddLandmark(const FWorldForgeLandmark& Landmark);
+
+    /** Batched AddLandmark that broadcasts OnWorldStateChanged once. Returns the number added. */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Landmarks")
+    int32 AddLandmarks(const TArray<FWorldForgeLandmark>& Landmarks);
+
+    /** Queue landmarks (at their given locations) to be spawned over the next frames, nearest first */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Landmarks")
+    void QueueLandmarks(const TArray<FWorldForgeLandmark>& Landmarks);
+
+    /** Number of landmarks waiting in the spawn queue */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Landmarks")
+    int32 GetPendingSpawnCount() const { return SpawnScheduler.GetPendingCount(); }
 
     UFUNCTION(BlueprintCallable, Category = "WorldForge|Landmarks")
     bool DestroySettlement(const FString& LandmarkId);
@@ -73,6 +157,219 @@ public:
     UFUNCTION(BlueprintCallable, Category = "WorldForge|Landmarks")
     void DestroyAllSettlements();
 
+    /** Switch how landmarks in the current world are represented. Existing landmarks are rebuilt. */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Landmarks")
+    void SetLandmarkRenderMode(EWorldForgeLandmarkRenderMode NewMode);
+
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Landmarks")
+    EWorldForgeLandmarkRenderMode GetLandmarkRenderMode() const { return LandmarkRenderMode; }
+
+    /** Shared material for a landmark type in the current era (see UWorldForgeMaterialCache) */
+    UMaterialInterface* GetLandmarkMaterial(UMaterialInterface* BaseMaterial, EWorldForgeLandmarkType Type);
+
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Landmarks")
+    UWorldForgeMaterialCache* GetMaterialCache() const { return MaterialCache; }
+
+    /** Layout generator inputs for a landmark under the current traits and seed */
+    FWorldForgeLayoutParams MakeLayoutParams(const FWorldForgeLandmark& Landmark) const;
+
+    /** The layout pre-generated for a landmark by a committed outcome, if it was generated with these parameters */
+    bool TakePreparedLayout(const FString& LandmarkId, const FWorldForgeLayoutParams& Params, FWorldForgeSettlementLayout& OutLayout);
+
+    /** Grid index over landmark locations, kept in sync with the landmark store */
+    const FWorldForgeSpatialIndex& GetSpatialIndex() const { return SpatialIndex; }
+
+    /** Label manager for the current world, if labels have been shown */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Landmarks")
+    AWorldForgeLabelManager* GetLabelManager() const { return LabelManager; }
+
+    // Territory
+    /** ID of the landmark whose territory covers a location, or empty if it is unclaimed */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Territory")
+    FString GetTerritoryOwnerAt(const FVector& Location) const;
+
+    /** True if a location is claimed but a rival landmark's influence is nearly as strong there */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Territory")
+    bool IsTerritoryContestedAt(const FVector& Location) const;
+
+    /** Influence map over the landmarks, kept in sync with the landmark store */
+    const FWorldForgeTerritoryMap& GetTerritory() const { return Territory; }
+
+    // Roads
+    /** Number of roads between landmarks, routed or not */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Roads")
+    int32 GetRoadCount() const { return Roads.NumRoads(); }
+
+    /** Route every road again on worker threads, e.g. after the terrain changed */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Roads")
+    void RerouteRoads() { Roads.InvalidateAll(); }
+
+    /** Which landmarks are connected and the routes computed so far */
+    const FWorldForgeRoadNetwork& GetRoadNetwork() const { return Roads; }
+
+    // Generation parameters
+    /** Rules deriving each system's parameters from the traits; only rules downstream of a changed trait are re-evaluated */
+    const FWorldForgeParameterGraph& GetParameters() const { return Parameters; }
+
+    // Scatter
+    /** Number of vegetation and prop instances currently placed */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Scatter")
+    int32 GetScatterInstanceCount() const;
+
+    /** Regenerate every scatter cell on worker threads */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Scatter")
+    void RegenerateScatter() { Scatter.MarkAllDirty(); }
+
+    /** Which layers of which scatter cells are waiting to be regenerated */
+    const FWorldForgeScatterGrid& GetScatterGrid() const { return Scatter; }
+
+    // Economy
+    /** Totals of the settlement economy simulation, also mirrored in WorldState.Economy */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Economy")
+    FWorldForgeEconomyMetrics GetEconomyMetrics() const { return Economy.GetMetrics(); }
+
+    /** Simulated state of one settlement. Returns false for unknown IDs and landmarks without an economy. */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Economy")
+    bool GetSettlementEconomy(const FString& LandmarkId, float& OutPopulation, float& OutFood, float& OutGoods, float& OutWealth) const;
+
+    /** Restart every settlement from its seeded initial state */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Economy")
+    void ResetEconomy();
+
+    /** Per-settlement arrays and step timings of the economy simulation */
+    const FWorldForgeEconomy& GetEconomy() const { return Economy; }
+
+    // Significance
+    /** Landmark actors in a tier after the last significance pass; also shown by "stat WorldForge" */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Significance")
+    int32 GetSignificanceTierCount(EWorldForgeSignificanceTier Tier) const { return SignificanceTierCounts[static_cast<int32>(Tier)]; }
+
+    // Navigation
+    /** Dirty navmesh tiles waiting for the current spawn burst to settle, and rebuild timings */
+    const FWorldForgeNavBatch& GetNavBatch() const { return NavBatch; }
+
+    /** True while a flushed batch is still being rebuilt */
+    bool IsNavRebuildInProgress() const { return bNavRebuildInFlight; }
+
+    // Paths
+    /**
+     * Cheapest road routes between pairs of landmarks, for caravans and patrols. Cached pairs are answered
+     * at once; the rest are solved together on a worker. OnComplete runs on the game thread with one path
+     * per query, in query order; pairs no routed roads connect get a path that is not found.
+     */
+    void RequestPaths(TArray<FWorldForgePathQuery> Queries, TFunction<void(const TArray<FWorldForgePathPtr>&)> OnComplete);
+
+    /** Path cache and query statistics */
+    const FWorldForgePathService& GetPathService() const { return PathService; }
+
+    // Outcomes
+    /**
+     * Place each outcome's landmarks now and pre-generate their layouts and the scatter around them, and under
+     * the outcome's traits, on a worker. Outcomes prepared for an earlier dilemma are discarded.
+     */
+    void PrepareOutcomes(const FString& DilemmaId, TArray<FWorldForgeOutcome>&& Outcomes);
+
+    /**
+     * Apply a prepared outcome's landmarks and the traits and atmosphere it changes, and discard the others.
+     * Those fields are merged under the stamp of the command being processed; the others keep any edits made
+     * since the outcome was prepared. Landmarks spawn at once with their pre-generated content if it is
+     * ready and still matches the world's traits, and through the spawn queue otherwise.
+     * Returns false for a dilemma or choice that was not prepared.
+     */
+    bool CommitOutcome(const FString& DilemmaId, const FString& Choice);
+
+    /** True while prepared outcomes are waiting for a choice */
+    bool HasPreparedOutcomes() const { return Speculation.IsValid(); }
+
+    // Undo
+    /**
+     * Reverse the last world-building command: its trait, atmosphere and era changes, and the landmarks it
+     * created or destroyed. Only those landmarks are touched. Returns false if there is nothing to undo.
+     */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Undo")
+    bool Undo();
+
+    /** Apply the last undone command again. Returns false if there is nothing to redo. */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Undo")
+    bool Redo();
+
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Undo")
+    bool CanUndo() const { return UndoHistory.CanUndo(); }
+
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Undo")
+    bool CanRedo() const { return UndoHistory.CanRedo(); }
+
+    /** Recorded steps and the memory they hold */
+    const FWorldForgeUndoHistory& GetUndoHistory() const { return UndoHistory; }
+
+    // Collaboration
+    /**
+     * The world as merged from every connected editor. Commands stamped with an editor's hybrid logical
+     * clock are merged into it, so concurrent edits converge without a lock: the latest write to a field
+     * wins, and a landmark survives a removal that did not see it added. Changes made here rather than
+     * by a command are stamped locally. What changed is sent to every session as WORLD_DELTA.
+     */
+    const FWorldForgeReplica& GetReplica() const { return Replica; }
+
+    // History
+    /**
+     * Fast-forward the civilization by a number of years on a worker thread. When it finishes, ruined and
+     * resettled landmarks are destroyed and re-added and new ones are queued for spawning.
+     * Returns false if a simulation is already running.
+     */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|History")
+    bool SimulateHistory(int32 Years);
+
+    /** Stop the running history simulation; none of its changes are applied */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|History")
+    void CancelHistory();
+
+    UFUNCTION(BlueprintPure, Category = "WorldForge|History")
+    bool IsSimulatingHistory() const { return HistoryJob.IsValid(); }
+
+    /** Share of the running simulation's years completed, 0 when none is running */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|History")
+    float GetHistoryProgress() const;
+
+    // Terrain
+    /** Generate TilesPerSide x TilesPerSide heightfield tiles centered on the origin from the current traits */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Terrain")
+    void GenerateTerrain(int32 TilesPerSide = 4);
+
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Terrain")
+    void ClearTerrain();
+
+    /** Number of terrain tiles committed to the terrain actor */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Terrain")
+    int32 GetTerrainTileCount() const { return HeightCache->Num(); }
+
+    /** Terrain height and normal under a location, from the cached tiles. Returns false off the generated terrain. */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Terrain")
+    bool QueryTerrainHeight(const FVector& Location, float& OutHeight, FVector& OutNormal) const;
+
+    /** Height queries over the generated terrain. Thread-safe, so it can be captured by placement tasks. */
+    TSharedRef<const FWorldForgeHeightCache, ESPMode::ThreadSafe> GetHeightCache() const { return HeightCache; }
+
+    /** River and water mask queries over the generated terrain. Thread-safe. */
+    TSharedRef<const FWorldForgeWaterMap, ESPMode::ThreadSafe> GetWaterMap() const { return WaterMap; }
+
+    /** True if a river runs through the location on the generated terrain */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Terrain")
+    bool IsWaterAt(const FVector& Location) const { return WaterMap->IsWater(static_cast<float>(Location.X), static_cast<float>(Location.Y)); }
+
+    /** Stream terrain tiles around the player instead of a fixed square. Enabling restarts the ring from the current traits. */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Terrain")
+    void SetTerrainStreamingEnabled(bool bEnabled);
+
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Terrain")
+    bool IsTerrainStreamingEnabled() const { return bTerrainStreaming; }
+
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Terrain")
+    FWorldForgeTileStreamingStats GetTerrainStreamingStats() const { return TileStreamer.GetStats(); }
+
+    /** Terrain noise parameters for the current traits and seed */
+    FWorldForgeTerrainParams GetTerrainParams() const { return FWorldForgeTerrainParams::FromState(WorldState); }
+
     // Events
     UPROPERTY(BlueprintAssignable, Category = "WorldForge")
     FOnWorldStateChanged OnWorldStateChanged;
@@ -83,8 +380,17 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "WorldForge")
     FOnConnectionStatusChanged OnConnectionStatusChanged;
 
-    // Process incoming command from WebSocket
-    void ProcessCommand(const FString& CommandJson);
+    /** Fired each frame the spawn queue makes progress */
+    UPROPERTY(BlueprintAssignable, Category = "WorldForge|Landmarks")
+    FOnSpawnProgress OnSpawnProgress;
+
+    /** Fired each frame a history simulation advances, and once more when it finishes */
+    UPROPERTY(BlueprintAssignable, Category = "WorldForge|History")
+    FOnHistoryProgress OnHistoryProgress;
+
+    // Process incoming command from WebSocket; SessionId is the sending session, 0 for local commands.
+    // The WORLD_DELTA it produces names that session as its origin. Undo history is shared by all sessions.
+    void ProcessCommand(const FString& CommandJson, int32 SessionId = 0);
 
 private:
     UPROPERTY()
@@ -93,9 +399,21 @@ private:
     UPROPERTY()
     TObjectPtr<UWorldForgeDebugWidget> DebugWidget;
 
+    UPROPERTY()
+    TObjectPtr<UWorldForgeMaterialCache> MaterialCache;
+
+    /** Everything but the landmarks, which live in LandmarkStore; its landmark list stays empty */
     UPROPERTY()
     FWorldForgeState WorldState;
 
+    /**
+     * WorldState with the landmarks expanded into its list, for Blueprints, OnWorldStateChanged and the debug
+     * widget. The list is rebuilt only when ContentRevision moved since it was last built.
+     */
+    const FWorldForgeState& GetPublishedState() const;
+    mutable FWorldForgeState PublishedState;
+    mutable uint32 PublishedRevision = MAX_uint32;
+
     /** Flag to indicate we want to show the debug widget (polls until successful) */
     bool bWantsDebugWidget = false;
 
@@ -104,7 +422,14 @@ private:
     void HandleSetTrait(const TSharedPtr<FJsonObject>& Data);
     void HandleSetAtmosphere(const TSharedPtr<FJsonObject>& Data);
     void HandleSpawnSettlement(const TSharedPtr<FJsonObject>& Data);
+    void HandleDestroySettlement(const TSharedPtr<FJsonObject>& Data);
     void HandleSyncWorldState(const TSharedPtr<FJsonObject>& Data);
+    void HandleSimulateHistory(const TSharedPtr<FJsonObject>& Data);
+    void HandlePrepareOutcomes(const TSharedPtr<FJsonObject>& Data);
+    void HandleCommitOutcome(const TSharedPtr<FJsonObject>& Data);
+
+    /** Merge a command's "traits" object and "atmosphere" field under its stamp; returns the number that won */
+    int32 MergeTraitsAndAtmosphere(const FJsonObject& Object);
 
     // Settlement spawning
     UPROPERTY()
@@ -116,9 +441,284 @@ private:
     /** Spawn radius from world origin */
     float SpawnRadius = 5000.0f;
 
-    /** Find a valid spawn location that doesn't overlap with existing settlements */
-    FVector FindValidSpawnLocation();
+    /**
+     * Find a valid spawn location that doesn't overlap with existing settlements, nor with Reserved locations
+     * not spawned yet. Natural landmarks prefer rivers.
+     */
+    FVector FindValidSpawnLocation(EWorldForgeLandmarkType Type = EWorldForgeLandmarkType::Settlement, TConstArrayView<FVector> Reserved = {});
 
     /** Spawn a settlement actor with the given landmark data */
     AWorldForgeSettlementActor* SpawnSettlementActor(const FWorldForgeLandmark& Landmark);
+
+    /** Landmarks waiting to be spawned, drained in Tick within a per-frame budget */
+    FWorldForgeSpawnScheduler SpawnScheduler;
+
+    /** Spawn queued landmarks for this frame and report progress */
+    void ProcessSpawnQueue();
+
+    /** Add a landmark and its representation without broadcasting the state change */
+    bool AddLandmarkNoBroadcast(const FWorldForgeLandmark& Landmark);
+
+    /** Destroy a spawned landmark and its representation without broadcasting the state change */
+    bool RemoveLandmarkNoBroadcast(const FString& LandmarkId);
+
+    /** Queue a landmark for spawning, recording it in the open undo step */
+    void EnqueueLandmark(const FWorldForgeLandmark& Landmark, bool bNeedsPlacement);
+
+    /** Take a landmark out of the spawn queue before it is placed, recording it in the open undo step */
+    bool CancelQueuedLandmark(const FString& LandmarkId);
+
+    /** Broadcast OnWorldStateChanged and refresh the debug widget */
+    void BroadcastWorldStateChanged();
+
+    /** Location the player is at, or the origin when there is no pawn */
+    FVector GetPlayerLocation() const;
+
+    // Landmark representation
+    EWorldForgeLandmarkRenderMode LandmarkRenderMode = EWorldForgeLandmarkRenderMode::Actors;
+
+    UPROPERTY()
+    TObjectPtr<AWorldForgeLandmarkInstancer> Instancer;
+
+    /** In Instanced mode, landmarks within this distance of the player get a full actor */
+    float ActorPromotionRadius = 10000.0f;
+
+    /** Seconds between promotion/demotion passes in Instanced mode */
+    float PromotionInterval = 0.25f;
+    float PromotionTimer = 0.0f;
+
+    bool ContainsLandmark(const FString& LandmarkId) const;
+    void CreateLandmarkRepresentation(const FWorldForgeLandmark& Landmark);
+    void DestroyLandmarkRepresentation(const FString& LandmarkId);
+    void DestroyAllLandmarkRepresentations();
+    AWorldForgeLandmarkInstancer* GetOrCreateInstancer();
+
+    /** Swap instances near the player for full actors and back */
+    void UpdateActorPromotion();
+
+    /** The world's landmarks by ID, in copy-on-write chunks for snapshots; the only copy the subsystem keeps */
+    FWorldForgeLandmarkStore LandmarkStore;
+
+    // Spatial queries and labels
+    FWorldForgeSpatialIndex SpatialIndex;
+
+    UPROPERTY()
+    TObjectPtr<AWorldForgeLabelManager> LabelManager;
+
+    /** Seconds between label reassignment passes */
+    float LabelUpdateInterval = 0.2f;
+    float LabelUpdateTimer = 0.0f;
+
+    void UpdateLabels();
+
+    // Territory
+    FWorldForgeTerritoryMap Territory;
+
+    UPROPERTY()
+    TObjectPtr<AWorldForgeTerritoryActor> TerritoryActor;
+
+    /** Whether the overlay was drawn last update, so toggling it on redraws every chunk */
+    bool bTerritoryVisible = false;
+
+    /** Apply queued territory changes and re-render the chunks they touched */
+    void UpdateTerritory();
+
+    AWorldForgeTerritoryActor* GetOrCreateTerritoryActor();
+
+    // Roads
+    FWorldForgeRoadNetwork Roads;
+
+    UPROPERTY()
+    TObjectPtr<AWorldForgeRoadActor> RoadActor;
+
+    /** Recompute which roads exist and route new or invalidated ones on worker tasks */
+    void UpdateRoads();
+
+    /** Store a finished route and upload its mesh, unless the road changed since it was requested */
+    void CommitRoad(const FString& Key, uint32 Version, FWorldForgeRoad&& Road, const FWorldForgeTerrainMeshData& MeshData);
+
+    AWorldForgeRoadActor* GetOrCreateRoadActor();
+
+    // Generation parameters
+    FWorldForgeParameterGraph Parameters;
+    FWorldForgeParameterRules ParameterRules;
+
+    /** Declare the parameter rules and the systems consuming them */
+    void InitializeParameters();
+
+    // Transitions
+    FWorldForgeTransitions Transitions;
+
+    // Economy
+    FWorldForgeEconomy Economy;
+
+    /** Run the economy's fixed steps due this frame and copy its metrics into the world state */
+    void UpdateEconomy(float DeltaTime);
+
+    // Significance
+    float SignificanceTimer = 0.0f;
+    int32 SignificanceTierCounts[FWorldForgeSignificance::NumTiers] = {};
+
+    /** Militarism, prosperity and religiosity the actors' relevance was last computed from */
+    FVector SignificanceTraits = FVector(-1.0f);
+
+    /** Landmarks whose actors are in the Low or Dormant tier; they get no label */
+    TSet<FString> LowSignificanceLandmarks;
+
+    /** Score landmark actors through the world's significance manager and hand out tiers under the budgets */
+    void UpdateSignificance(float DeltaTime);
+
+    /** Return every actor to full detail, when significance is switched off */
+    void ResetSignificance();
+
+    // Navigation
+    FWorldForgeNavBatch NavBatch;
+
+    /** Whether navmesh building is held for a burst, and whether a flushed batch is being rebuilt */
+    bool bNavBuildLocked = false;
+    bool bNavRebuildInFlight = false;
+    bool bNavRebuildSeenBusy = false;
+    double NavLockTime = 0.0;
+    double NavFlushTime = 0.0;
+    double NavDeferredSeconds = 0.0;
+
+    /** Record a spawned or destroyed landmark's bounds for the next navmesh rebuild */
+    void MarkNavigationDirty(const FWorldForgeLandmark& Landmark);
+
+    /** Hold navmesh building during a spawn burst, then submit the merged tiles once it settles */
+    void UpdateNavigation();
+
+    // Paths
+    FWorldForgePathService PathService;
+
+    // Undo
+    FWorldForgeUndoHistory UndoHistory;
+
+    /** Queued landmarks by ID, with the serial of the undo step that queued them */
+    TMap<FString, uint32> PendingUndoSteps;
+
+    /** Record the changes made until EndUndoStep as one step */
+    void BeginUndoStep(const FString& Label);
+    void EndUndoStep();
+
+    /** Reverse a step, or apply it again */
+    void ApplyUndoStep(const FWorldForgeUndoStep& Step, bool bReverse);
+
+    /** Report the undo and redo depth and memory to the connected client */
+    void SendUndoState();
+
+    // Collaboration
+    FWorldForgeReplica Replica;
+    FWorldForgeHybridClock ReplicaClock;
+
+    /** Stamp of the command being processed: the sender's, or a local one if it sent none */
+    FWorldForgeHlc CommandStamp;
+
+    /** Ops merged since the last WORLD_DELTA */
+    TArray<FWorldForgeReplicaOp> ReplicaDelta;
+
+    FWorldForgeHlc TickReplicaClock();
+
+    /** Latest stamp received from each session */
+    TMap<int32, FWorldForgeHlc> SessionStamps;
+
+    /** Seconds between tombstone collection passes */
+    float TombstoneInterval = 1.0f;
+    float TombstoneTimer = 0.0f;
+
+    /** Drop the replica's tombstones every connected session has sent past, and any beyond the limit */
+    void CollectReplicaTombstones();
+
+    /** Merge an editor's op and apply it to the world if it wins. Returns true if it did. */
+    bool MergeReplicaOp(const FWorldForgeReplicaOp& Op);
+
+    /** Merge a change already made to the world */
+    void RecordReplicaOp(const FWorldForgeReplicaOp& Op);
+
+    /**
+     * Stamp local changes to the scalar state and send what merged since the last call, tagged with the
+     * session whose command caused it (0 for changes made in the game)
+     */
+    void FlushReplicaDelta(int32 OriginSession = 0);
+
+    // Outcomes
+    TSharedPtr<FWorldForgeSpeculation, ESPMode::ThreadSafe> Speculation;
+
+    /** Bumped whenever landmarks or terrain change; prepared scatter is only used at the revision it was generated for */
+    uint32 ContentRevision = 0;
+
+    /** Layouts of a committed outcome, taken by its settlement actors as they are spawned */
+    TMap<FString, FWorldForgeOutcomeContent::FLayout> PreparedLayouts;
+
+    /**
+     * Whether a location found when outcomes were prepared still keeps clear of the spawned landmarks and sits
+     * on the ground of the current terrain
+     */
+    bool IsPreparedLocationCurrent(const FWorldForgeLandmark& Landmark) const;
+
+    /** Report a finished preparation to the connected client */
+    void OnOutcomesPrepared(const TSharedRef<FWorldForgeSpeculation, ESPMode::ThreadSafe>& Job);
+
+    /** Discard the prepared outcomes, stopping their worker if it is still running */
+    void DiscardOutcomes();
+
+    // History
+    TSharedPtr<FWorldForgeHistoryJob, ESPMode::ThreadSafe> HistoryJob;
+
+    /** Years of the running simulation last reported to listeners */
+    int32 ReportedHistoryYears = 0;
+
+    /** Report the running simulation's progress to listeners and the connected client */
+    void UpdateHistoryProgress();
+
+    /** Apply a finished simulation's landmark changes through the destroy and spawn paths */
+    void CommitHistory(const TSharedRef<FWorldForgeHistoryJob, ESPMode::ThreadSafe>& Job);
+
+    /** Retarget the eased channels at the world state with the current duration and easing settings */
+    void RetargetTransitions();
+
+    // Scatter
+    FWorldForgeScatterGrid Scatter;
+
+    UPROPERTY()
+    TObjectPtr<AWorldForgeScatterActor> ScatterActor;
+
+    /** Whether scatter was enabled last update, so toggling it regenerates or clears every cell */
+    bool bScatterEnabled = false;
+
+    /** Generate the dirty layers of the cells nearest the player on worker tasks */
+    void UpdateScatter();
+
+    /** Upload the instances of one layer of a cell, unless the layer was re-requested since */
+    void CommitScatterLayer(FIntPoint Cell, int32 Layer, uint32 Version, const TArray<FTransform>& Transforms);
+
+    /** Mark the cells around a landmark dirty, for the layers it excludes or attracts */
+    void MarkScatterAroundLandmark(const FWorldForgeLandmark& Landmark);
+
+    AWorldForgeScatterActor* GetOrCreateScatterActor();
+
+    // Terrain
+    UPROPERTY()
+    TObjectPtr<AWorldForgeTerrainActor> TerrainActor;
+
+    /** Generated heightfields, kept for CPU-side height queries */
+    TSharedRef<FWorldForgeHeightCache, ESPMode::ThreadSafe> HeightCache = MakeShared<FWorldForgeHeightCache, ESPMode::ThreadSafe>();
+
+    /** Rivers and water mask of the generated tiles */
+    TSharedRef<FWorldForgeWaterMap, ESPMode::ThreadSafe> WaterMap = MakeShared<FWorldForgeWaterMap, ESPMode::ThreadSafe>();
+
+    /** Natural landmarks within this distance of a river are moved onto it */
+    float RiverSnapDistance = 5000.0f;
+
+    /** Incremented per GenerateTerrain call so tiles from superseded requests are dropped */
+    uint32 TerrainRequestId = 0;
+
+    /** Streams tiles around the player when bTerrainStreaming is set */
+    FWorldForgeTileStreamer TileStreamer;
+    bool bTerrainStreaming = false;
+
+    void UpdateTerrainStreaming();
+
+    AWorldForgeTerrainActor* GetOrCreateTerrainActor();
+    void CommitTerrainTile(const FWorldForgeTerrainTileData& TileData);
 };
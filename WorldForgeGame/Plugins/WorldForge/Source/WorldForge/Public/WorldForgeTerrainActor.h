@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "WorldForgeTerrainActor.generated.h"
+
+class UProceduralMeshComponent;
+class UMaterialInterface;
+struct FWorldForgeTerrainMeshData;
+
+/**
+ * Renders generated heightfield tiles as sections of one procedural mesh, with each tile's
+ * rivers in the same section of a second, collision-free water mesh.
+ * Mesh data is built off the game thread; this actor only uploads it.
+ */
+UCLASS(NotBlueprintable)
+class WORLDFORGE_API AWorldForgeTerrainActor : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AWorldForgeTerrainActor();
+
+    /** Create or replace the sections for a tile */
+    void SetTile(FIntPoint Coord, const FWorldForgeTerrainMeshData& MeshData, const FWorldForgeTerrainMeshData& WaterMeshData);
+
+    /** Remove a tile's section. Returns false if the tile is not present. */
+    bool RemoveTile(FIntPoint Coord);
+
+    /** Remove every tile */
+    void ClearTiles();
+
+    bool ContainsTile(FIntPoint Coord) const { return TileSections.Contains(Coord); }
+
+    int32 GetTileCount() const { return TileSections.Num(); }
+
+    /** Material applied to every terrain section; when unset the engine default material is used */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WorldForge")
+    TObjectPtr<UMaterialInterface> TerrainMaterial;
+
+    /** Material applied to river sections */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WorldForge")
+    TObjectPtr<UMaterialInterface> WaterMaterial;
+
+private:
+    UPROPERTY(VisibleAnywhere, Category = "Components")
+    TObjectPtr<UProceduralMeshComponent> TerrainMesh;
+
+    UPROPERTY(VisibleAnywhere, Category = "Components")
+    TObjectPtr<UProceduralMeshComponent> WaterMesh;
+
+    /** Section index per tile, shared by both meshes. Freed sections are cleared and reused. */
+    TMap<FIntPoint, int32> TileSections;
+    TArray<int32> FreeSections;
+    int32 NextSection = 0;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+
+/**
+ * Noise parameters for the heightfield, derived from the world traits and atmosphere.
+ */
+struct WORLDFORGE_API FWorldForgeTerrainParams
+{
+    int32 Seed = 0;
+
+    /** Number of noise octaves summed per sample */
+    int32 Octaves = 6;
+
+    /** Frequency of the first octave, in cycles per Unreal unit */
+    float BaseFrequency = 1.0f / 40000.0f;
+
+    float Lacunarity = 2.0f;
+    float Persistence = 0.5f;
+
+    /** Peak height in Unreal units */
+    float Amplitude = 3000.0f;
+
+    /** 0 = smooth rolling noise, 1 = fully ridged (eroded badlands) */
+    float Ridged = 0.0f;
+
+    /** 0 = unchanged, 1 = strongly flattened lowlands (fertile plains) */
+    float Flatten = 0.0f;
+
+    /** Number of terrace steps (0 = none) and how strongly they apply */
+    float TerraceSteps = 0.0f;
+    float TerraceBlend = 0.0f;
+
+    /** Derive terrain character from the world (e.g. Desolate -> badlands, Prosperous -> plains) */
+    static FWorldForgeTerrainParams FromState(const FWorldForgeState& State);
+};
+
+/**
+ * A square grid of height samples. Adjacent tiles share their border samples.
+ */
+struct WORLDFORGE_API FWorldForgeHeightfieldTile
+{
+    FIntPoint Coord = FIntPoint::ZeroValue;
+
+    /** Samples per side (quads per side + 1) */
+    int32 Resolution = 0;
+
+    /** Distance between samples in Unreal units */
+    float SampleSpacing = 100.0f;
+
+    /** Row-major heights, Resolution * Resolution */
+    TArray<float> Heights;
+
+    float GetSize() const { return (Resolution - 1) * SampleSpacing; }
+    FVector2D GetOrigin() const { return FVector2D(Coord.X * GetSize(), Coord.Y * GetSize()); }
+    float GetHeight(int32 X, int32 Y) const { return Heights[Y * Resolution + X]; }
+    SIZE_T GetAllocatedSize() const { return Heights.GetAllocatedSize(); }
+};
+
+/**
+ * Renderable mesh for one heightfield tile, built off the game thread.
+ */
+struct WORLDFORGE_API FWorldForgeTerrainMeshData
+{
+    TArray<FVector> Vertices;
+    TArray<int32> Triangles;
+    TArray<FVector> Normals;
+    TArray<FVector2D> UVs;
+};
+
+/**
+ * CPU heightfield generator built from multi-octave value noise.
+ * Rows are evaluated four samples at a time with the engine's portable vector intrinsics
+ * (SSE on x64, NEON on ARM); the scalar path produces identical results and is used for row tails.
+ * All functions are pure and thread-safe.
+ */
+class WORLDFORGE_API FWorldForgeTerrainGenerator
+{
+public:
+    /** Fill a tile's heights. Deterministic for a given Params and Coord. */
+    static void GenerateTile(const FWorldForgeTerrainParams& Params, FIntPoint Coord, int32 Resolution, float SampleSpacing, FWorldForgeHeightfieldTile& OutTile);
+
+    /** Fill a Width x Height grid of heights starting at Origin, optionally spreading rows across workers */
+    static void GenerateRegion(const FWorldForgeTerrainParams& Params, const FVector2D& Origin, int32 Width, int32 Height, float SampleSpacing, TArray<float>& OutHeights, bool bParallel = false);
+
+    /** Scalar reference for a single world position */
+    static float SampleHeight(const FWorldForgeTerrainParams& Params, float WorldX, float WorldY);
+
+    /** Build mesh data for a tile, in terrain actor space (tile origin included) */
+    static void BuildMeshData(const FWorldForgeHeightfieldTile& Tile, FWorldForgeTerrainMeshData& OutMesh);
+
+private:
+    static void GenerateRowVectorized(const FWorldForgeTerrainParams& Params, float WorldX, float WorldY, float SampleSpacing, int32 Count, float* OutHeights);
+};
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+
+class FWorldForgeHeightCache;
+
+/**
+ * Grid extent and how far each landmark type reaches, derived from the world traits.
+ */
+struct WORLDFORGE_API FWorldForgeTerritorySettings
+{
+    /** Cells per side of the square grid centered on the origin */
+    int32 Resolution = 512;
+
+    /** Cell size in Unreal units */
+    float CellSize = 100.0f;
+
+    /** Distance a landmark of strength 1 claims; strength scales it */
+    float BaseReach = 4000.0f;
+
+    /** A cell is contested when a rival's weighted distance is within this fraction of the owner's */
+    float ContestedRatio = 0.1f;
+
+    /** Strength per EWorldForgeLandmarkType. Types with zero strength claim no territory. */
+    float TypeStrength[5] = { 1.0f, 1.0f, 0.7f, 0.25f, 0.0f };
+
+    float GetStrength(EWorldForgeLandmarkType Type) const { return TypeStrength[static_cast<int32>(Type)]; }
+
+    /** Militarism extends fortresses and sharpens frontiers, openness extends trading settlements */
+    static FWorldForgeTerritorySettings FromState(const FWorldForgeState& State);
+
+    bool operator==(const FWorldForgeTerritorySettings& Other) const;
+    bool operator!=(const FWorldForgeTerritorySettings& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Border overlay for one chunk of the territory grid, with a vertex color per owner.
+ */
+struct WORLDFORGE_API FWorldForgeTerritoryMeshData
+{
+    TArray<FVector> Vertices;
+    TArray<int32> Triangles;
+    TArray<FLinearColor> Colors;
+};
+
+/**
+ * Which landmark controls each cell of a grid: a multiplicatively weighted Voronoi diagram where a
+ * landmark's weighted distance to a cell is its distance divided by its strength, and cells beyond
+ * every landmark's reach are unclaimed.
+ *
+ * A full rebuild runs jump flooding (1+JFA) over the grid in parallel. Added and removed landmarks are
+ * queued and applied by Update, which only recomputes the cells within their reach, so a spawn costs a
+ * few thousand cells instead of the whole grid. Game thread only.
+ */
+class WORLDFORGE_API FWorldForgeTerritoryMap
+{
+public:
+    /** Cells per side of a render chunk */
+    static constexpr int32 ChunkCells = 32;
+
+    /** Replace the settings; the next Update rebuilds the whole grid if they changed */
+    void SetSettings(const FWorldForgeTerritorySettings& InSettings);
+    const FWorldForgeTerritorySettings& GetSettings() const { return Settings; }
+
+    /** Queue a landmark. Returns false for duplicate IDs and landmark types that claim no territory. */
+    bool AddSite(const FWorldForgeLandmark& Landmark);
+
+    /** Queue a landmark's removal. Returns false if it is not a site. */
+    bool RemoveSite(const FString& LandmarkId);
+
+    /** Remove every site; the next Update clears the grid */
+    void ClearSites();
+
+    int32 NumSites() const { return SiteIndices.Num(); }
+
+    /** True if Update has queued sites or dirty chunks to process */
+    bool HasPendingChanges() const;
+
+    /**
+     * Apply queued changes, incrementally where that is cheaper than a full rebuild.
+     * @param OutDirtyChunks Chunks whose contents changed since the last Update
+     */
+    void Update(TArray<FIntPoint>& OutDirtyChunks);
+
+    /** Recompute every cell from the current sites with jump flooding */
+    void Rebuild();
+
+    /** Mark the chunks overlapping a world-space box for re-rendering (e.g. when terrain under them changed) */
+    void MarkRegionDirty(const FBox2D& Region);
+
+    /** Landmark owning the cell under a world position, or null if it is unclaimed or off the grid */
+    const FString* GetOwnerAt(float X, float Y) const;
+
+    /** True if the cell under a world position is claimed and a rival is nearly as strong there */
+    bool IsContestedAt(float X, float Y) const;
+
+    /** Owner of a cell by index (row-major), or null if unclaimed */
+    const FString* GetCellOwner(int32 Cell) const;
+
+    int32 GetChunksPerSide() const { return FMath::DivideAndRoundUp(Settings.Resolution, ChunkCells); }
+
+    /** Quads over border and contested cells of a chunk, draped on the cached terrain when there is any */
+    void BuildChunkMesh(FIntPoint Chunk, const FWorldForgeHeightCache* Heights, FWorldForgeTerritoryMeshData& OutMesh) const;
+
+private:
+    struct FSite
+    {
+        FString Id;
+        FVector2f Location;
+        EWorldForgeLandmarkType Type = EWorldForgeLandmarkType::Settlement;
+        float Strength = 1.0f;
+        FLinearColor Color;
+        bool bRemoved = false;
+    };
+
+    /** Cell rectangle, inclusive min and exclusive max */
+    struct FCellRect
+    {
+        FIntPoint Min;
+        FIntPoint Max;
+
+        bool IsEmpty() const { return Min.X >= Max.X || Min.Y >= Max.Y; }
+        int64 Area() const { return IsEmpty() ? 0 : static_cast<int64>(Max.X - Min.X) * (Max.Y - Min.Y); }
+    };
+
+    FWorldForgeTerritorySettings Settings;
+
+    TSparseArray<FSite> Sites;
+    TMap<FString, int32> SiteIndices;
+
+    TArray<int32> PendingAdds;
+    TArray<int32> PendingRemoves;
+    bool bNeedsRebuild = false;
+
+    /** Site index per cell, INDEX_NONE where unclaimed */
+    TArray<int32> Owners;
+    TArray<uint8> Contested;
+
+    TSet<FIntPoint> DirtyChunks;
+
+    float GetGridOrigin() const { return -0.5f * Settings.Resolution * Settings.CellSize; }
+    FVector2f GetCellCenter(int32 X, int32 Y) const;
+    bool GetCell(float X, float Y, FIntPoint& OutCell) const;
+
+    /** Weighted distance from a site to a cell center (lower wins) */
+    float GetScore(int32 SiteIndex, int32 X, int32 Y) const;
+
+    /** Cells a site can claim */
+    FCellRect GetReachRect(const FSite& Site) const;
+
+    /** Give the cells of Rect that Site beats to it */
+    void ApplySite(int32 SiteIndex, const FCellRect& Rect);
+
+    /** Reassign the cells of Rect owned by a removed site to the best live site */
+    void ReassignCells(int32 RemovedIndex, const FCellRect& Rect);
+
+    /** Recompute contested flags for the cells of Rect */
+    void UpdateContested(const FCellRect& Rect);
+
+    void MarkRectDirty(const FCellRect& Rect);
+    void FreeRemovedSites();
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "WorldForgeTerritoryActor.generated.h"
+
+class UProceduralMeshComponent;
+class UMaterialInterface;
+struct FWorldForgeTerritoryMeshData;
+
+/**
+ * Renders territory borders and contested zones as vertex-colored sections of one procedural mesh,
+ * one section per chunk of the territory grid so updates only re-upload the chunks that changed.
+ */
+UCLASS(NotBlueprintable)
+class WORLDFORGE_API AWorldForgeTerritoryActor : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AWorldForgeTerritoryActor();
+
+    /** Create or replace a chunk's section; an empty mesh clears it */
+    void SetChunk(FIntPoint Chunk, const FWorldForgeTerritoryMeshData& MeshData);
+
+    /** Remove every chunk */
+    void ClearChunks();
+
+    int32 GetChunkCount() const { return ChunkSections.Num(); }
+
+    /** Material for the overlay; it should use vertex color. Defaults to the engine's vertex color material. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WorldForge")
+    TObjectPtr<UMaterialInterface> OverlayMaterial;
+
+private:
+    UPROPERTY(VisibleAnywhere, Category = "Components")
+    TObjectPtr<UProceduralMeshComponent> OverlayMesh;
+
+    /** Section index per chunk */
+    TMap<FIntPoint, int32> ChunkSections;
+    int32 NextSection = 0;
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "WorldForgeTypes.h"
+#include "WorldForgeTerrainGenerator.h"
+#include "WorldForgeHydrology.h"
+#include <atomic>
+
+/**
+ * Keeps a ring of generated terrain tiles (heights, water and meshes) around the player.
+ * Missing tiles are generated on worker tasks, nearest and in front of the player first, with a cap on
+ * concurrent jobs. Jobs for tiles that leave the cancel radius are cancelled, and resident tiles outside
+ * the load radius are evicted least recently used first once the memory budget is exceeded.
+ * Game thread only; workers hand results back through a queue drained in Update.
+ */
+class WORLDFORGE_API FWorldForgeTileStreamer
+{
+public:
+    using FTilePtr = TSharedPtr<const FWorldForgeHeightfieldTile, ESPMode::ThreadSafe>;
+
+    struct FSettings
+    {
+        /** Tiles within this many tiles of the player's tile are loaded */
+        int32 LoadRadius = 3;
+
+        /** In-flight jobs for tiles farther than this are cancelled */
+        int32 CancelRadius = 5;
+
+        int32 MaxConcurrentJobs = 4;
+
+        /** Resident tiles beyond the load radius are evicted while this is exceeded */
+        int64 MemoryBudgetBytes = 256ll * 1024 * 1024;
+
+        /** 0 = distance only, 1 = tiles behind the player wait until those in front are loaded */
+        float ViewDirectionWeight = 0.5f;
+
+        int32 Resolution = 129;
+        float SampleSpacing = 200.0f;
+    };
+
+    FWorldForgeTileStreamer();
+    ~FWorldForgeTileStreamer();
+
+    /** Apply new settings. Changing resolution or spacing drops every tile. */
+    void SetSettings(const FSettings& NewSettings);
+    const FSettings& GetSettings() const { return Settings; }
+
+    /** Use new terrain and hydrology parameters. Drops every tile so the ring regenerates. */
+    void SetParams(const FWorldForgeTerrainParams& NewParams, const FWorldForgeHydrologySettings& NewHydrologySettings);
+
+    /**
+     * Commit finished tiles, cancel and schedule jobs for the player's position and evict over budget.
+     * OnLoaded receives each finished tile; OnEvicted each tile dropped from memory.
+     */
+    void Update(const FVector& PlayerLocation, const FVector& ViewDirection,
+                TFunctionRef<void(const FWorldForgeTerrainTileData& TileData)> OnLoaded,
+                TFunctionRef<void(FIntPoint Coord)> OnEvicted);
+
+    /** Cancel every job and forget every tile without callbacks (the caller clears what it committed) */
+    void Reset();
+
+    bool IsResident(FIntPoint Coord) const { return Resident.Contains(Coord); }
+    FTilePtr FindTile(FIntPoint Coord) const;
+
+    float GetTileSize() const { return (Settings.Resolution - 1) * Settings.SampleSpacing; }
+    FIntPoint GetTileCoord(const FVector& Location) const;
+
+    FWorldForgeTileStreamingStats GetStats() const;
+
+private:
+    struct FResidentTile
+    {
+        FTilePtr Tile;
+        int64 Bytes = 0;
+        double LastUsed = 0.0;
+    };
+
+    struct FJob
+    {
+        TSharedRef<std::atomic<bool>, ESPMode::ThreadSafe> bCancelled = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+    };
+
+    struct FCompletedTile
+    {
+        uint32 Generation = 0;
+        FIntPoint Coord;
+        FWorldForgeTerrainTileData Data;
+    };
+
+    using FCompletedQueue = TQueue<FCompletedTile, EQueueMode::Mpsc>;
+
+    FSettings Settings;
+    FWorldForgeTerrainParams Params;
+    FWorldForgeHydrologySettings HydrologySettings;
+
+    TMap<FIntPoint, FResidentTile> Resident;
+    TMap<FIntPoint, FJob> InFlight;
+
+    /** When each wanted but not yet resident tile entered the load radius, for latency */
+    TMap<FIntPoint, double> WantedSince;
+
+    /** Shared with workers so results can be posted after the streamer is reset or destroyed */
+    TSharedRef<FCompletedQueue, ESPMode::ThreadSafe> Completed;
+
+    /** Bumped by Reset so results from older jobs are discarded */
+    uint32 Generation = 0;
+
+    TOptional<FIntPoint> LastPlayerTile;
+
+    int64 ResidentBytes = 0;
+    int32 PendingTiles = 0;
+    int32 TilesLoaded = 0;
+    int32 TilesEvicted = 0;
+    int32 JobsCancelled = 0;
+    double TotalLatencySeconds = 0.0;
+    double MaxLatencySeconds = 0.0;
+    int32 LatencySamples = 0;
+    int32 TileEntries = 0;
+    int32 TileMisses = 0;
+
+    void LaunchJob(FIntPoint Coord);
+    void CancelJob(TMap<FIntPoint, FJob>::TIterator& It);
+    void EvictOverBudget(FIntPoint PlayerTile, TFunctionRef<void(FIntPoint Coord)> OnEvicted);
+
+    static int32 TileDistance(FIntPoint A, FIntPoint B) { return FMath::Max(FMath::Abs(A.X - B.X), FMath::Abs(A.Y - B.Y)); }
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+
+/**
+ * Current and target values of every EWorldForgeTransitionChannel, eased over time.
+ *
+ * Channels are stored as packed arrays (start, target, current, progress) and advanced together in one
+ * pass per tick, so consumers read the interpolated values with an array lookup instead of each running
+ * its own timeline. Retargeting a channel mid-transition starts from its current value, so nothing pops.
+ *
+ * Atmosphere changes cross-fade every atmosphere channel toward a row of a precomputed preset table
+ * (one-hot preset weight plus the preset's look), so blending two presets is a single vector lerp.
+ * Game thread only.
+ */
+class WORLDFORGE_API FWorldForgeTransitions
+{
+public:
+    static constexpr int32 NumChannels = static_cast<int32>(EWorldForgeTransitionChannel::Count);
+    static constexpr int32 NumTraitChannels = 5;
+    static constexpr int32 FirstAtmosphereChannel = static_cast<int32>(EWorldForgeTransitionChannel::WarTornWeight);
+
+    struct FSettings
+    {
+        float TraitSeconds = 1.0f;
+        float AtmosphereSeconds = 3.0f;
+        EWorldForgeEasing TraitEasing = EWorldForgeEasing::SmoothStep;
+        EWorldForgeEasing AtmosphereEasing = EWorldForgeEasing::EaseInOutCubic;
+    };
+
+    FWorldForgeTransitions();
+
+    void SetSettings(const FSettings& InSettings) { Settings = InSettings; }
+    const FSettings& GetSettings() const { return Settings; }
+
+    /** Jump every channel to the values of a state */
+    void Reset(const FWorldForgeState& State);
+
+    /** Start transitions toward a state's traits and atmosphere; channels whose target is unchanged keep running */
+    void SetTargets(const FWorldForgeState& State);
+
+    /** Advance every running channel. Returns false once nothing is left to interpolate. */
+    bool Advance(float DeltaSeconds);
+
+    bool IsActive() const { return NumActive > 0; }
+
+    float GetValue(EWorldForgeTransitionChannel Channel) const { return Current[static_cast<int32>(Channel)]; }
+    float GetTrait(EWorldForgeTrait Trait) const { return Current[static_cast<int32>(Trait)]; }
+    float GetAtmosphereWeight(EWorldForgeAtmosphere Atmosphere) const { return Current[FirstAtmosphereChannel + static_cast<int32>(Atmosphere)]; }
+
+    /** Every channel's current value, indexed by EWorldForgeTransitionChannel */
+    TConstArrayView<float> GetValues() const { return MakeArrayView(Current); }
+
+    /** Preset row (weights and look) an atmosphere transitions toward, indexed from FirstAtmosphereChannel */
+    static TConstArrayView<float> GetAtmospherePreset(EWorldForgeAtmosphere Atmosphere);
+
+    static float Ease(EWorldForgeEasing Easing, float Alpha);
+
+private:
+    FSettings Settings;
+
+    float Start[NumChannels];
+    float Target[NumChannels];
+    float Current[NumChannels];
+
+    /** Progress in [0, 1] and its rate per second; 0 rate means the channel is at rest */
+    float Progress[NumChannels];
+    float Rate[NumChannels];
+    EWorldForgeEasing Easing[NumChannels];
+
+    EWorldForgeAtmosphere TargetAtmosphere = EWorldForgeAtmosphere::Mysterious;
+    int32 NumActive = 0;
+
+    void Retarget(int32 Channel, float NewTarget, float Seconds, EWorldForgeEasing ChannelEasing);
+};
@@ -30,6 +30,47 @@ enum class EWorldForgeAtmosphere : uint8
     Vibrant       UMETA(DisplayName = "Vibrant")
 };
 
+/**
+ * Easing curves for trait and atmosphere transitions
+ */
+UENUM(BlueprintType)
+enum class EWorldForgeEasing : uint8
+{
+    Linear        UMETA(DisplayName = "Linear"),
+    SmoothStep    UMETA(DisplayName = "Smooth Step"),
+    EaseInOutCubic UMETA(DisplayName = "Ease In-Out Cubic"),
+    EaseOutQuad   UMETA(DisplayName = "Ease Out Quad")
+};
+
+/**
+ * Smoothly interpolated world values, sampled with UWorldForgeSubsystem::GetTransitionValue.
+ * The first five match EWorldForgeTrait. Atmosphere weights say how much of each preset is blended in
+ * (they sum to 1); the remaining channels are the blended atmosphere look.
+ */
+UENUM(BlueprintType)
+enum class EWorldForgeTransitionChannel : uint8
+{
+    Militarism          UMETA(DisplayName = "Militarism"),
+    Prosperity          UMETA(DisplayName = "Prosperity"),
+    Religiosity         UMETA(DisplayName = "Religiosity"),
+    Lawfulness          UMETA(DisplayName = "Lawfulness"),
+    Openness            UMETA(DisplayName = "Openness"),
+    WarTornWeight       UMETA(DisplayName = "War Torn Weight"),
+    ProsperousWeight    UMETA(DisplayName = "Prosperous Weight"),
+    MysteriousWeight    UMETA(DisplayName = "Mysterious Weight"),
+    SacredWeight        UMETA(DisplayName = "Sacred Weight"),
+    DesolateWeight      UMETA(DisplayName = "Desolate Weight"),
+    VibrantWeight       UMETA(DisplayName = "Vibrant Weight"),
+    FogDensity          UMETA(DisplayName = "Fog Density"),
+    FogColorR           UMETA(DisplayName = "Fog Color R"),
+    FogColorG           UMETA(DisplayName = "Fog Color G"),
+    FogColorB           UMETA(DisplayName = "Fog Color B"),
+    SunIntensity        UMETA(DisplayName = "Sun Intensity"),
+    Saturation          UMETA(DisplayName = "Saturation"),
+    WindStrength        UMETA(DisplayName = "Wind Strength"),
+    Count               UMETA(Hidden)
+};
+
 /**
  * Landmark types for world generation
  */
@@ -43,6 +84,35 @@ enum class EWorldForgeLandmarkType : uint8
     Natural       UMETA(DisplayName = "Natural")
 };
 
+/**
+ * How spawned landmarks are represented in the world
+ */
+UENUM(BlueprintType)
+enum class EWorldForgeLandmarkRenderMode : uint8
+{
+    /** One AWorldForgeSettlementActor per landmark */
+    Actors        UMETA(DisplayName = "Actors"),
+
+    /** Per-type instanced meshes, full actors only near the player */
+    Instanced     UMETA(DisplayName = "Instanced")
+};
+
+/**
+ * Update rate and detail of a landmark actor, from its significance to the viewer
+ */
+UENUM(BlueprintType)
+enum class EWorldForgeSignificanceTier : uint8
+{
+    /** Full detail, updated every frame */
+    High          UMETA(DisplayName = "High"),
+    /** No shadows, reduced crowd rate */
+    Medium        UMETA(DisplayName = "Medium"),
+    /** Minor pieces hidden, no label, crowds at the lowest rate */
+    Low           UMETA(DisplayName = "Low"),
+    /** Hidden and not simulated */
+    Dormant       UMETA(DisplayName = "Dormant")
+};
+
 /**
  * Era information
  */
@@ -88,6 +158,45 @@ struct WORLDFORGE_API FWorldForgeLandmark
     FVector Location;
 };
 
+/**
+ * Aggregate results of the settlement economy simulation, refreshed after every simulation step
+ */
+USTRUCT(BlueprintType)
+struct WORLDFORGE_API FWorldForgeEconomyMetrics
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    int32 Settlements = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    int32 TradeRoutes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    float TotalPopulation = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    float TotalFood = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    float TotalGoods = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    float TotalWealth = 0.0f;
+
+    /** Food and goods shipped over all trade routes in the last step, before losses to banditry */
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    float TradeVolume = 0.0f;
+
+    /** Settlements that could not feed their population in the last step */
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    int32 StarvingSettlements = 0;
+
+    /** Steps simulated since the economy was last reset */
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    int64 Steps = 0;
+};
+
 /**
  * Complete world state
  */
@@ -99,6 +208,10 @@ struct WORLDFORGE_API FWorldForgeState
     UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "WorldForge")
     FWorldForgeEra Era;
 
+    /** Seed for deterministic generation (layouts, terrain) */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "WorldForge")
+    int32 Seed = 0;
+
     UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "WorldForge")
     float Militarism = 0.5f;
 
@@ -120,6 +233,10 @@ struct WORLDFORGE_API FWorldForgeState
     UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "WorldForge")
     TArray<FWorldForgeLandmark> Landmarks;
 
+    /** Settlement economy results; refreshed at the simulation rate without an OnWorldStateChanged broadcast */
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    FWorldForgeEconomyMetrics Economy;
+
     // Helper to get trait by enum
     float GetTrait(EWorldForgeTrait Trait) const
     {
@@ -149,7 +266,54 @@ struct WORLDFORGE_API FWorldForgeState
     }
 };
 
+/**
+ * Terrain tile streaming counters, for tuning the load radius, job cap and memory budget
+ */
+USTRUCT(BlueprintType)
+struct WORLDFORGE_API FWorldForgeTileStreamingStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    int32 ResidentTiles = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    int32 InFlightJobs = 0;
+
+    /** Tiles in the load radius that are neither resident nor being generated */
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    int32 PendingTiles = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    int64 ResidentBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    int32 TilesLoaded = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    int32 TilesEvicted = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    int32 JobsCancelled = 0;
+
+    /** Time from a tile entering the load radius to it being committed */
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    float AverageLatencyMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    float MaxLatencyMs = 0.0f;
+
+    /** Times the player entered a tile, and how many of those tiles were not resident yet */
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    int32 TileEntries = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "WorldForge")
+    int32 TileMisses = 0;
+};
+
 // Delegate declarations
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWorldStateChanged, const FWorldForgeState&, NewState);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCommandReceived, const FString&, CommandType, const FString&, CommandData);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnConnectionStatusChanged, bool, bConnected);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSpawnProgress, int32, Completed, int32, Total);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHistoryProgress, int32, YearsCompleted, int32, Years);
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+
+/**
+ * The parts of the world state a command can change besides landmarks, as captured when a step opens.
+ */
+struct WORLDFORGE_API FWorldForgeUndoScalars
+{
+    FWorldForgeEra Era;
+    int32 Seed = 0;
+    float Traits[5] = { 0.5f, 0.5f, 0.5f, 0.5f, 0.5f };
+    EWorldForgeAtmosphere Atmosphere = EWorldForgeAtmosphere::Mysterious;
+
+    static FWorldForgeUndoScalars Make(const FWorldForgeState& State);
+};
+
+enum class EWorldForgeUndoField : uint8
+{
+    Era,
+    Seed,
+    Trait,
+    Atmosphere
+};
+
+/**
+ * One scalar a step changed, with its value on either side. Only the members of its field are used,
+ * so undoing it leaves the fields other commands changed since alone.
+ */
+struct WORLDFORGE_API FWorldForgeUndoFieldChange
+{
+    EWorldForgeUndoField Field = EWorldForgeUndoField::Trait;
+    EWorldForgeTrait Trait = EWorldForgeTrait::Militarism;
+
+    FWorldForgeEra OldEra;
+    FWorldForgeEra NewEra;
+    int32 OldSeed = 0;
+    int32 NewSeed = 0;
+    float OldValue = 0.0f;
+    float NewValue = 0.0f;
+    EWorldForgeAtmosphere OldAtmosphere = EWorldForgeAtmosphere::Mysterious;
+    EWorldForgeAtmosphere NewAtmosphere = EWorldForgeAtmosphere::Mysterious;
+
+    /** Write the old value (undo) or the new one (redo) to its field */
+    void ApplyTo(FWorldForgeState& State, bool bReverse) const;
+
+    /** The fields that differ between two captures */
+    static void Diff(const FWorldForgeUndoScalars& Before, const FWorldForgeUndoScalars& After, TArray<FWorldForgeUndoFieldChange>& OutChanges);
+};
+
+/**
+ * What one command changed, kept as the data needed to reverse it: the scalar fields it changed, the
+ * landmarks it created, the landmarks it destroyed with their data, and the queued landmarks it cancelled.
+ * Undo destroys Added, restores Removed and queues Cancelled again; redo does the opposite. A landmark
+ * replaced under the same ID is in both Added and Removed.
+ */
+struct WORLDFORGE_API FWorldForgeUndoStep
+{
+    struct FAdded
+    {
+        FWorldForgeLandmark Landmark;
+
+        /** False while the landmark waits in the spawn queue for a location; redo queues it again */
+        bool bPlaced = false;
+    };
+
+    struct FCancelled
+    {
+        FWorldForgeLandmark Landmark;
+
+        /** Serial of the step that queued it, which completes when undo queues it again and it is placed */
+        uint32 Origin = 0;
+    };
+
+    FString Label;
+    uint32 Serial = 0;
+
+    TArray<FWorldForgeUndoFieldChange> Fields;
+    TArray<FAdded> Added;
+    TArray<FWorldForgeLandmark> Removed;
+    TArray<FCancelled> Cancelled;
+
+    bool HasScalarChanges() const { return Fields.Num() > 0; }
+    bool IsEmpty() const { return Fields.Num() == 0 && Added.Num() == 0 && Removed.Num() == 0 && Cancelled.Num() == 0; }
+
+    /** Restore the old values of the changed fields (undo) or their new ones (redo) */
+    void ApplyFields(FWorldForgeState& State, bool bReverse) const;
+
+    /** Bytes held by the step, strings included */
+    SIZE_T GetAllocatedSize() const;
+};
+
+/**
+ * Bounded undo and redo of world-building commands.
+ *
+ * A step is opened before a command runs and closed after it; the subsystem reports every landmark
+ * created or destroyed in between, and the scalar state is compared at both ends. Landmarks a step
+ * queues are recorded when queued and completed when placed, which may be several frames later.
+ * Opening a new step drops the steps that were undone. The oldest steps are dropped beyond the step
+ * and memory limits; a step larger than the memory limit on its own clears the history, since no
+ * step before it could be reached. Game thread only.
+ */
+class WORLDFORGE_API FWorldForgeUndoHistory
+{
+public:
+    struct FStats
+    {
+        int32 UndoSteps = 0;
+        int32 RedoSteps = 0;
+        SIZE_T Bytes = 0;
+
+        /** Steps dropped by the limits, and steps that were too large to keep */
+        int32 Evicted = 0;
+        int32 Oversized = 0;
+    };
+
+    void SetLimits(int32 InMaxSteps, SIZE_T InMaxBytes);
+
+    /** Open a step; changes recorded until EndStep belong to it. Steps do not nest. */
+    void BeginStep(const FString& Label, const FWorldForgeState& State);
+
+    /** Close the open step. It is kept if it changed anything. */
+    void EndStep(const FWorldForgeState& State);
+
+    bool IsRecording() const { return Open.IsSet(); }
+
+    /** Serial of the open step, to complete its queued landmarks later; 0 when none is open */
+    uint32 GetOpenSerial() const { return Open.IsSet() ? Open->Serial : 0; }
+
+    void RecordAdded(const FWorldForgeLandmark& Landmark, bool bPlaced);
+    void RecordRemoved(const FWorldForgeLandmark& Landmark);
+
+    /** A landmark a step queued was placed and spawned; no-op if the step is gone */
+    void RecordPlaced(uint32 Serial, const FWorldForgeLandmark& Landmark);
+
+    /**
+     * A landmark step Origin queued was taken out of the queue before it was placed. The open step records it;
+     * with none open the cancellation cannot be undone, so step Origin stops queuing it on redo.
+     */
+    void RecordCancelled(uint32 Origin, const FWorldForgeLandmark& Landmark);
+
+    bool CanUndo() const { return Cursor > 0; }
+    bool CanRedo() const { return Cursor < Steps.Num(); }
+
+    /** The step to reverse, now on the redo side; null if there is none */
+    FWorldForgeUndoStep* Undo();
+
+    /** The step to apply again, now on the undo side; null if there is none */
+    FWorldForgeUndoStep* Redo();
+
+    void Clear();
+
+    FStats GetStats() const;
+
+private:
+    /** Steps before Cursor can be undone, steps from Cursor on redone */
+    TArray<FWorldForgeUndoStep> Steps;
+    int32 Cursor = 0;
+    TOptional<FWorldForgeUndoStep> Open;
+    FWorldForgeUndoScalars OpenScalars;
+    uint32 NextSerial = 1;
+
+    int32 MaxSteps = 100;
+    SIZE_T MaxBytes = 4 * 1024 * 1024;
+    int32 Evicted = 0;
+    int32 Oversized = 0;
+
+    FWorldForgeUndoStep* FindStep(uint32 Serial);
+    void Trim();
+};
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "HAL/Runnable.h"
+#include "HAL/CriticalSection.h"
 #include "Sockets.h"
 #include "WorldForgeWebSocketServer.generated.h"
 
@@ -15,6 +16,7 @@ DECLARE_DELEGATE_OneParam(FOnWorldForgeMessage, const FString&);
 /**
  * TCP Server for receiving commands from the WorldForge Electron app.
  * Uses simple TCP with JSON messages (one JSON object per line).
+ * Several clients may be connected at once; each is a session with its own ID.
  */
 UCLASS()
 class WORLDFORGE_API UWorldForgeWebSocketServer : public UObject, public FRunnable
@@ -29,6 +31,20 @@ public:
     void StopServer();
     bool IsRunning() const { return bIsRunning; }
 
+    /**
+     * Queue a JSON message for every connected client (newline is appended). The server thread writes it
+     * out, however many sends that takes. Game thread only.
+     */
+    bool SendMessage(const FString& Message);
+
+    /** Queue a JSON message for one session. Game thread only. */
+    bool SendMessageTo(int32 SessionId, const FString& Message);
+
+    int32 GetNumSessions() const;
+
+    /** IDs of the connected sessions */
+    void GetSessionIds(TArray<int32>& OutIds) const;
+
     FOnWorldForgeMessage OnMessageReceived;
 
     // FRunnable interface
@@ -40,13 +56,39 @@ private:
     UPROPERTY()
     TObjectPtr<UWorldForgeSubsystem> Owner;
 
+    struct FSession
+    {
+        int32 Id = 0;
+        FSocket* Socket = nullptr;
+        FString PartialMessage;
+
+        /** Bytes queued for the client and not yet accepted by the socket */
+        TArray<uint8> Outgoing;
+    };
+
+    /** Sessions with more than this queued are not reading and are dropped */
+    static constexpr int32 MaxOutgoingBytes = 16 * 1024 * 1024;
+
     FSocket* ListenerSocket = nullptr;
-    FSocket* ClientSocket = nullptr;
     FRunnableThread* Thread = nullptr;
 
+    /** Accepted and dropped on the server thread, sent to on the game thread */
+    TArray<FSession> Sessions;
+    mutable FCriticalSection SessionsLock;
+    int32 NextSessionId = 1;
+
     bool bIsRunning = false;
     bool bShouldStop = false;
     int32 ServerPort = 8765;
 
-    void ProcessReceivedData(const FString& Data);
+    void ProcessReceivedData(int32 SessionId, const FString& Data);
+
+    /** Append a message to a session's queue. SessionsLock must be held. */
+    static bool SendTo(FSession& Session, const FString& Message);
+
+    /** Write as much of a session's queue as the socket accepts. False on a connection error. */
+    static bool FlushOutgoing(FSession& Session);
+
+    /** Close and remove a session. SessionsLock must be held. */
+    void DropSession(int32 Index, const TCHAR* Reason);
 };
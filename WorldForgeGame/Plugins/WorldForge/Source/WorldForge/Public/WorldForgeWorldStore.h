@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldForgeTypes.h"
+
+/**
+ * Landmarks that differ between two stores. Removed holds the old values and Changed both, so a diff
+ * can be applied in either direction.
+ */
+struct WORLDFORGE_API FWorldForgeLandmarkDiff
+{
+    struct FChange
+    {
+        FWorldForgeLandmark Before;
+        FWorldForgeLandmark After;
+    };
+
+    TArray<FWorldForgeLandmark> Added;
+    TArray<FWorldForgeLandmark> Removed;
+    TArray<FChange> Changed;
+
+    bool IsEmpty() const { return Added.Num() == 0 && Removed.Num() == 0 && Changed.Num() == 0; }
+    int32 Num() const { return Added.Num() + Removed.Num() + Changed.Num(); }
+};
+
+/**
+ * Landmarks by ID in reference-counted, immutable chunks, so copies share storage.
+ *
+ * Landmarks are bucketed into chunks by a hash of their ID; the store itself is one shared pointer to
+ * a table of chunk pointers. Copying a store copies that pointer. A write copies the table and the
+ * one chunk it touches if another store still shares them, and writes in place otherwise, so a store
+ * that was never copied pays nothing extra. Two stores forked from each other diff by skipping every
+ * chunk they still share; the cost follows the chunks that changed, not the landmark count.
+ *
+ * The chunk count doubles as the store grows, which rehashes every landmark into fresh chunks; stores
+ * on either side of a rehash still diff correctly, by comparing every landmark. Iteration order
+ * follows the chunks, not insertion. Stores may be copied to and read on any thread; each one is
+ * written by one thread at a time.
+ */
+class WORLDFORGE_API FWorldForgeLandmarkStore
+{
+public:
+    struct FStats
+    {
+        /** Chunk tables and chunks copied because another store shared them */
+        int32 TableCopies = 0;
+        int32 ChunkCopies = 0;
+        int32 Rehashes = 0;
+    };
+
+    int32 Num() const { return Root.IsValid() ? Root->Num : 0; }
+    int32 NumChunks() const { return Root.IsValid() ? Root->Chunks.Num() : 0; }
+
+    const FWorldForgeLandmark* Find(const FString& Id) const;
+    bool Contains(const FString& Id) const { return Find(Id) != nullptr; }
+
+    /** Add a landmark, or replace the one with the same ID */
+    void Set(const FWorldForgeLandmark& Landmark);
+
+    bool Remove(const FString& Id);
+    void Reset();
+
+    void ForEach(TFunctionRef<void(const FWorldForgeLandmark&)> Visitor) const;
+
+    /** Every landmark as a flat array */
+    void ToArray(TArray<FWorldForgeLandmark>& OutLandmarks) const;
+
+    /** True if both stores are the same version: nothing written to either since one was copied from the other */
+    bool IsSameVersion(const FWorldForgeLandmarkStore& Other) const { return Root == Other.Root; }
+
+    /** Landmarks added, removed and changed going from Old to New */
+    static void Diff(const FWorldForgeLandmarkStore& Old, const FWorldForgeLandmarkStore& New, FWorldForgeLandmarkDiff& OutDiff);
+
+    static bool IsSameLandmark(const FWorldForgeLandmark& A, const FWorldForgeLandmark& B);
+
+    /** Copies made by writes to this store, carried over to its copies */
+    const FStats& GetStats() const { return Stats; }
+
+private:
+    struct FChunk
+    {
+        TArray<FWorldForgeLandmark> Landmarks;
+    };
+    using FChunkPtr = TSharedPtr<FChunk, ESPMode::ThreadSafe>;
+
+    struct FRoot
+    {
+        TArray<FChunkPtr> Chunks;
+        int32 Num = 0;
+    };
+
+    /** Chunks a store starts with, and the average chunk size that doubles them */
+    static constexpr int32 InitialChunks = 16;
+    static constexpr int32 MaxAverageChunkSize = 32;
+
+    TSharedPtr<FRoot, ESPMode::ThreadSafe> Root;
+    FStats Stats;
+
+    static int32 GetChunkIndex(const FString& Id, int32 NumChunks);
+
+    /** The table, copied first if it is shared */
+    FRoot& GetMutableRoot();
+
+    /** A chunk of the mutable table, copied first if it is shared */
+    FChunk& GetMutableChunk(FRoot& MutableRoot, int32 Index);
+
+    void Rehash(int32 NumChunks);
+};
+
+/**
+ * Everything in FWorldForgeState that generation reads, with the landmarks in a shared store: taking
+ * one costs the same however many landmarks there are. For undo, previews, checkpoints and
+ * handing the world to workers.
+ */
+struct WORLDFORGE_API FWorldForgeWorldSnapshot
+{
+    FWorldForgeEra Era;
+    int32 Seed = 0;
+    float Militarism = 0.5f;
+    float Prosperity = 0.5f;
+    float Religiosity = 0.5f;
+    float Lawfulness = 0.5f;
+    float Openness = 0.5f;
+    EWorldForgeAtmosphere Atmosphere = EWorldForgeAtmosphere::Mysterious;
+    FWorldForgeLandmarkStore Landmarks;
+
+    /** Copy the state's scalar fields; the landmarks come from the caller's store */
+    static FWorldForgeWorldSnapshot Make(const FWorldForgeState& State, const FWorldForgeLandmarkStore& Landmarks);
+
+    /** Expand into a plain state, landmarks included */
+    void ToState(FWorldForgeState& OutState) const;
+};
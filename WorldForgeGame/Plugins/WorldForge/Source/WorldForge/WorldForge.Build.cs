@@ -24,7 +24,10 @@ public class WorldForge : ModuleRules
             {
                 "Slate",
                 "SlateCore",
-                "UMG"
+                "UMG",
+                "ProceduralMeshComponent",
+                "SignificanceManager",
+                "NavigationSystem"
             }
         );
     }
@@ -0,0 +1,65 @@
+#include "WorldForgeCrowdActor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "UObject/ConstructorHelpers.h"
+
+AWorldForgeCrowdActor::AWorldForgeCrowdActor()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    SceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
+    SetRootComponent(SceneRoot);
+
+    // Placeholder figures until real crowd assets are assigned
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> CylinderMesh(TEXT("/Engine/BasicShapes/Cylinder"));
+
+    static const TCHAR* Names[] = { TEXT("Patrols"), TEXT("Processions"), TEXT("Markets"), TEXT("Villagers") };
+    static_assert(UE_ARRAY_COUNT(Names) == static_cast<int32>(EWorldForgeCrowdBehavior::Count), "One component per behavior");
+
+    for (const TCHAR* Name : Names)
+    {
+        UInstancedStaticMeshComponent* Component = CreateDefaultSubobject<UInstancedStaticMeshComponent>(Name);
+        Component->SetStaticMesh(CylinderMesh.Object);
+        Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        Component->SetCastShadow(false);
+        Component->SetupAttachment(SceneRoot);
+        BehaviorComponents.Add(Component);
+    }
+}
+
+void AWorldForgeCrowdActor::SetInstances(EWorldForgeCrowdBehavior Behavior, const TArray<FTransform>& Transforms)
+{
+    UInstancedStaticMeshComponent* Component = BehaviorComponents[static_cast<int32>(Behavior)];
+    if (!Component)
+    {
+        return;
+    }
+
+    if (Component->GetInstanceCount() == Transforms.Num())
+    {
+        if (Transforms.Num() > 0)
+        {
+            Component->BatchUpdateInstancesTransforms(0, Transforms, true, true);
+        }
+        return;
+    }
+
+    Component->ClearInstances();
+    if (Transforms.Num() > 0)
+    {
+        Component->AddInstances(Transforms, false, true);
+    }
+}
+
+int32 AWorldForgeCrowdActor::GetInstanceCount() const
+{
+    int32 Count = 0;
+    for (const UInstancedStaticMeshComponent* Component : BehaviorComponents)
+    {
+        if (Component)
+        {
+            Count += Component->GetInstanceCount();
+        }
+    }
+    return Count;
+}
@@ -0,0 +1,118 @@
+// Console commands for measuring WorldForge crowd simulation costs.
+// Each command logs its results with the "WorldForge Bench:" prefix.
+
+#include "WorldForgeCrowdTypes.h"
+#include "WorldForgeCrowdProcessors.h"
+#include "MassEntityManager.h"
+#include "MassExecutor.h"
+#include "MassProcessingTypes.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/Package.h"
+
+namespace WorldForgeCrowdBenchmarks
+{
+    /**
+     * WorldForge.Bench.Crowd [Agents] [Frames] - per-frame cost of the crowd processors on a standalone
+     * entity manager, with and without distance tiers. Needs no level, settlements or rendering.
+     */
+    static void BenchCrowd(const TArray<FString>& Args)
+    {
+        const int32 NumAgents = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 50000;
+        const int32 NumFrames = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 300;
+        const float DeltaTime = 1.0f / 60.0f;
+
+        // Settlements of the default size on a grid around the viewer at the origin
+        const int32 AgentsPerSettlement = 200;
+        const int32 NumSettlements = FMath::DivideAndRoundUp(NumAgents, AgentsPerSettlement);
+        const int32 GridSize = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(NumSettlements)));
+        const float Spacing = 8000.0f;
+        const FWorldForgeCrowdComposition Composition = FWorldForgeCrowdComposition::Make(EWorldForgeLandmarkType::Settlement, 0.6f, 0.7f, 0.5f, AgentsPerSettlement);
+
+        auto Run = [&](bool bTiers, double& OutCreateMs, int32 OutTiers[4], int32& OutUpdatedPerFrame) -> double
+        {
+            TSharedRef<FMassEntityManager> EntityManager = MakeShareable(new FMassEntityManager(GetTransientPackage()));
+            EntityManager->Initialize();
+
+            const FMassArchetypeHandle Archetype = EntityManager->CreateArchetype({
+                FWorldForgeCrowdAgentFragment::StaticStruct(),
+                FWorldForgeCrowdLocationFragment::StaticStruct(),
+                FWorldForgeCrowdLODFragment::StaticStruct() });
+
+            TStrongObjectPtr<UWorldForgeCrowdLODProcessor> LODProcessor(NewObject<UWorldForgeCrowdLODProcessor>());
+            TStrongObjectPtr<UWorldForgeCrowdMovementProcessor> MovementProcessor(NewObject<UWorldForgeCrowdMovementProcessor>());
+            TStrongObjectPtr<UWorldForgeCrowdRepresentationProcessor> RepresentationProcessor(NewObject<UWorldForgeCrowdRepresentationProcessor>());
+            LODProcessor->CallInitialize(GetTransientPackage(), EntityManager);
+            MovementProcessor->CallInitialize(GetTransientPackage(), EntityManager);
+            RepresentationProcessor->CallInitialize(GetTransientPackage(), EntityManager);
+            if (!bTiers)
+            {
+                LODProcessor->TierDistances[0] = LODProcessor->TierDistances[1] = LODProcessor->TierDistances[2] = UE_MAX_FLT;
+            }
+
+            // Create every agent the way the crowd subsystem does, one batch per settlement
+            double StartTime = FPlatformTime::Seconds();
+            TArray<FMassEntityHandle> Entities;
+            int32 Created = 0;
+            for (int32 Settlement = 0; Settlement < NumSettlements; ++Settlement)
+            {
+                const FVector Center(((Settlement % GridSize) - GridSize * 0.5f) * Spacing, ((Settlement / GridSize) - GridSize * 0.5f) * Spacing, 0.0f);
+                const int32 Count = FMath::Min(Composition.Total(), NumAgents - Created);
+
+                Entities.Reset();
+                TSharedRef<FMassEntityManager::FEntityCreationContext> CreationContext = EntityManager->BatchCreateEntities(Archetype, Count, Entities);
+                int32 Behavior = 0;
+                int32 BehaviorStart = 0;
+                for (int32 Index = 0; Index < Entities.Num(); ++Index)
+                {
+                    while (Index >= BehaviorStart + Composition.Counts[Behavior])
+                    {
+                        BehaviorStart += Composition.Counts[Behavior];
+                        ++Behavior;
+                    }
+                    FWorldForgeCrowdAgentFragment& Agent = EntityManager->GetFragmentDataChecked<FWorldForgeCrowdAgentFragment>(Entities[Index]);
+                    Agent = FWorldForgeCrowdMotion::MakeAgent(static_cast<EWorldForgeCrowdBehavior>(Behavior), Center, 1500.0f, static_cast<uint32>(Settlement), Index - BehaviorStart);
+                    FWorldForgeCrowdLocationFragment& Location = EntityManager->GetFragmentDataChecked<FWorldForgeCrowdLocationFragment>(Entities[Index]);
+                    FWorldForgeCrowdMotion::Evaluate(Agent, Location.Location, Location.Yaw);
+                    EntityManager->GetFragmentDataChecked<FWorldForgeCrowdLODFragment>(Entities[Index]).FrameOffset = static_cast<uint8>(Index & 0xFF);
+                }
+                Created += Entities.Num();
+            }
+            OutCreateMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+            UMassProcessor* const ProcessorList[] = { LODProcessor.Get(), MovementProcessor.Get(), RepresentationProcessor.Get() };
+            int64 Updated = 0;
+            StartTime = FPlatformTime::Seconds();
+            for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+            {
+                FMassProcessingContext ProcessingContext(EntityManager, DeltaTime);
+                UE::Mass::Executor::RunProcessorsView(ProcessorList, ProcessingContext);
+                Updated += MovementProcessor->GetLastUpdated();
+            }
+            const double FrameMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumFrames;
+
+            OutUpdatedPerFrame = static_cast<int32>(Updated / NumFrames);
+            for (int32 Tier = 0; Tier < 4; ++Tier)
+            {
+                OutTiers[Tier] = RepresentationProcessor->GetTierCount(static_cast<EWorldForgeCrowdLOD>(Tier));
+            }
+            return FrameMs;
+        };
+
+        double CreateMs, FlatCreateMs;
+        int32 Tiers[4], FlatTiers[4];
+        int32 Updated, FlatUpdated;
+        const double TieredMs = Run(true, CreateMs, Tiers, Updated);
+        const double FlatMs = Run(false, FlatCreateMs, FlatTiers, FlatUpdated);
+
+        UE_LOG(LogTemp, Log, TEXT("WorldForge Bench: Crowd, %d agents in %d settlements: created in %.1f ms; tiered %.3f ms/frame (high %d, medium %d, low %d, off %d; %d moved per frame) vs all high %.3f ms/frame (%d moved per frame), %.1fx"),
+               NumAgents, NumSettlements, CreateMs, TieredMs, Tiers[0], Tiers[1], Tiers[2], Tiers[3], Updated,
+               FlatMs, FlatUpdated, TieredMs > 0.0 ? FlatMs / TieredMs : 0.0);
+    }
+
+    static FAutoConsoleCommandWithArgs BenchCrowdCommand(
+        TEXT("WorldForge.Bench.Crowd"),
+        TEXT("Run the crowd processors headless over synthetic settlements, with and without distance tiers. Usage: WorldForge.Bench.Crowd [Agents] [Frames]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchCrowd));
+}
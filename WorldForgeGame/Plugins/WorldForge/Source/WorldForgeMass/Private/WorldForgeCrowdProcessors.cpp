@@ -0,0 +1,149 @@
+#include "WorldForgeCrowdProcessors.h"
+#include "MassExecutionContext.h"
+#include <atomic>
+
+namespace WorldForgeCrowd
+{
+    /** Frames between updates per tier; Off agents are never moved */
+    constexpr uint32 TierIntervals[3] = { 1, 4, 16 };
+
+    /** Cylinder scaled to roughly a person: 40 units across, 180 tall, standing on the agent's location */
+    const FVector AgentScale(0.4f, 0.4f, 1.8f);
+    const FVector AgentPivot(0.0f, 0.0f, 90.0f);
+}
+
+// ========== LOD ==========
+
+UWorldForgeCrowdLODProcessor::UWorldForgeCrowdLODProcessor()
+    : EntityQuery(*this)
+{
+    bAutoRegisterWithProcessingPhases = false;
+    ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+}
+
+void UWorldForgeCrowdLODProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+    EntityQuery.AddRequirement<FWorldForgeCrowdLocationFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FWorldForgeCrowdLODFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void UWorldForgeCrowdLODProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    const FVector Viewer = ViewerLocation;
+    const float HighSq = FMath::Square(TierDistances[0]);
+    const float MediumSq = FMath::Square(TierDistances[1]);
+    const float LowSq = FMath::Square(TierDistances[2]);
+
+    EntityQuery.ParallelForEachEntityChunk(Context, [Viewer, HighSq, MediumSq, LowSq](FMassExecutionContext& ChunkContext)
+    {
+        const TConstArrayView<FWorldForgeCrowdLocationFragment> Locations = ChunkContext.GetFragmentView<FWorldForgeCrowdLocationFragment>();
+        const TArrayView<FWorldForgeCrowdLODFragment> LODs = ChunkContext.GetMutableFragmentView<FWorldForgeCrowdLODFragment>();
+
+        for (int32 Index = 0; Index < ChunkContext.GetNumEntities(); ++Index)
+        {
+            const float DistSq = FVector::DistSquared2D(Locations[Index].Location, Viewer);
+            const EWorldForgeCrowdLOD DistanceTier = DistSq < HighSq ? EWorldForgeCrowdLOD::High
+                : DistSq < MediumSq ? EWorldForgeCrowdLOD::Medium
+                : DistSq < LowSq ? EWorldForgeCrowdLOD::Low
+                : EWorldForgeCrowdLOD::Off;
+            LODs[Index].Tier = FMath::Max(DistanceTier, LODs[Index].MaxTier);
+        }
+    });
+}
+
+// ========== Movement ==========
+
+UWorldForgeCrowdMovementProcessor::UWorldForgeCrowdMovementProcessor()
+    : EntityQuery(*this)
+{
+    bAutoRegisterWithProcessingPhases = false;
+    ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+}
+
+void UWorldForgeCrowdMovementProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+    EntityQuery.AddRequirement<FWorldForgeCrowdAgentFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FWorldForgeCrowdLocationFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FWorldForgeCrowdLODFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void UWorldForgeCrowdMovementProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    const float DeltaTime = Context.GetDeltaTimeSeconds();
+    const uint32 CurrentFrame = Frame++;
+    std::atomic<int32> Updated{ 0 };
+
+    EntityQuery.ParallelForEachEntityChunk(Context, [DeltaTime, CurrentFrame, &Updated](FMassExecutionContext& ChunkContext)
+    {
+        const TArrayView<FWorldForgeCrowdAgentFragment> Agents = ChunkContext.GetMutableFragmentView<FWorldForgeCrowdAgentFragment>();
+        const TArrayView<FWorldForgeCrowdLocationFragment> Locations = ChunkContext.GetMutableFragmentView<FWorldForgeCrowdLocationFragment>();
+        const TArrayView<FWorldForgeCrowdLODFragment> LODs = ChunkContext.GetMutableFragmentView<FWorldForgeCrowdLODFragment>();
+
+        int32 ChunkUpdated = 0;
+        for (int32 Index = 0; Index < ChunkContext.GetNumEntities(); ++Index)
+        {
+            FWorldForgeCrowdLODFragment& LOD = LODs[Index];
+            LOD.PendingSeconds += DeltaTime;
+
+            if (LOD.Tier == EWorldForgeCrowdLOD::Off
+                || (CurrentFrame + LOD.FrameOffset) % WorldForgeCrowd::TierIntervals[static_cast<int32>(LOD.Tier)] != 0)
+            {
+                continue;
+            }
+
+            FWorldForgeCrowdAgentFragment& Agent = Agents[Index];
+            Agent.Time += LOD.PendingSeconds;
+            LOD.PendingSeconds = 0.0f;
+            FWorldForgeCrowdMotion::Evaluate(Agent, Locations[Index].Location, Locations[Index].Yaw);
+            ++ChunkUpdated;
+        }
+        Updated += ChunkUpdated;
+    });
+
+    LastUpdated = Updated;
+}
+
+// ========== Representation ==========
+
+UWorldForgeCrowdRepresentationProcessor::UWorldForgeCrowdRepresentationProcessor()
+    : EntityQuery(*this)
+{
+    bAutoRegisterWithProcessingPhases = false;
+    bRequiresGameThreadExecution = true;
+    ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+}
+
+void UWorldForgeCrowdRepresentationProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+    EntityQuery.AddRequirement<FWorldForgeCrowdAgentFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FWorldForgeCrowdLocationFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FWorldForgeCrowdLODFragment>(EMassFragmentAccess::ReadOnly);
+}
+
+void UWorldForgeCrowdRepresentationProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    for (TArray<FTransform>& Behavior : Transforms)
+    {
+        Behavior.Reset();
+    }
+    FMemory::Memzero(TierCounts);
+
+    EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& ChunkContext)
+    {
+        const TConstArrayView<FWorldForgeCrowdAgentFragment> Agents = ChunkContext.GetFragmentView<FWorldForgeCrowdAgentFragment>();
+        const TConstArrayView<FWorldForgeCrowdLocationFragment> Locations = ChunkContext.GetFragmentView<FWorldForgeCrowdLocationFragment>();
+        const TConstArrayView<FWorldForgeCrowdLODFragment> LODs = ChunkContext.GetFragmentView<FWorldForgeCrowdLODFragment>();
+
+        for (int32 Index = 0; Index < ChunkContext.GetNumEntities(); ++Index)
+        {
+            ++TierCounts[static_cast<int32>(LODs[Index].Tier)];
+            if (LODs[Index].Tier == EWorldForgeCrowdLOD::Off)
+            {
+                continue;
+            }
+
+            Transforms[static_cast<int32>(Agents[Index].Behavior)].Emplace(
+                FRotator(0.0f, Locations[Index].Yaw, 0.0f), Locations[Index].Location + WorldForgeCrowd::AgentPivot, WorldForgeCrowd::AgentScale);
+        }
+    });
+}
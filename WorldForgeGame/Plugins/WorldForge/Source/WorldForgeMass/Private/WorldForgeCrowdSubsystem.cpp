@@ -0,0 +1,419 @@
+#include "WorldForgeCrowdSubsystem.h"
+#include "WorldForgeCrowdActor.h"
+#include "WorldForgeCrowdProcessors.h"
+#include "WorldForgeSettlementActor.h"
+#include "WorldForgeSubsystem.h"
+#include "MassEntitySubsystem.h"
+#include "MassEntityManager.h"
+#include "MassExecutor.h"
+#include "MassProcessingTypes.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Crc.h"
+
+static TAutoConsoleVariable<bool> CVarCrowds(
+    TEXT("WorldForge.Crowds"),
+    true,
+    TEXT("Populate settlement actors with ambient Mass crowds"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCrowdAgentsPerSettlement(
+    TEXT("WorldForge.CrowdAgentsPerSettlement"),
+    200,
+    TEXT("Crowd agents of an ordinary settlement; fortresses, monasteries and ruins get fewer"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCrowdSpawnBudget(
+    TEXT("WorldForge.CrowdSpawnBudget"),
+    2000,
+    TEXT("Maximum crowd agents created per frame"),
+    ECVF_Default);
+
+bool UWorldForgeCrowdSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UWorldForgeCrowdSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    Collection.InitializeDependency<UMassEntitySubsystem>();
+
+    FMassEntityManager* EntityManager = GetEntityManager();
+    if (!EntityManager)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldForge: Mass entity subsystem unavailable, crowds disabled"));
+        return;
+    }
+
+    Archetype = EntityManager->CreateArchetype({
+        FWorldForgeCrowdAgentFragment::StaticStruct(),
+        FWorldForgeCrowdLocationFragment::StaticStruct(),
+        FWorldForgeCrowdLODFragment::StaticStruct() });
+
+    LODProcessor = NewObject<UWorldForgeCrowdLODProcessor>(this);
+    MovementProcessor = NewObject<UWorldForgeCrowdMovementProcessor>(this);
+    RepresentationProcessor = NewObject<UWorldForgeCrowdRepresentationProcessor>(this);
+    LODProcessor->CallInitialize(this, EntityManager->AsShared());
+    MovementProcessor->CallInitialize(this, EntityManager->AsShared());
+    RepresentationProcessor->CallInitialize(this, EntityManager->AsShared());
+
+    InitializedHandle = AWorldForgeSettlementActor::OnSettlementInitialized.AddUObject(this, &UWorldForgeCrowdSubsystem::HandleSettlementInitialized);
+    EndPlayHandle = AWorldForgeSettlementActor::OnSettlementEndPlay.AddUObject(this, &UWorldForgeCrowdSubsystem::HandleSettlementEndPlay);
+
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Crowd subsystem initialized"));
+}
+
+void UWorldForgeCrowdSubsystem::Deinitialize()
+{
+    AWorldForgeSettlementActor::OnSettlementInitialized.Remove(InitializedHandle);
+    AWorldForgeSettlementActor::OnSettlementEndPlay.Remove(EndPlayHandle);
+
+    for (auto& Pair : Crowds)
+    {
+        DespawnCrowd(Pair.Value);
+    }
+    Crowds.Empty();
+    SpawnQueue.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UWorldForgeCrowdSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UWorldForgeCrowdSubsystem, STATGROUP_Tickables);
+}
+
+FMassEntityManager* UWorldForgeCrowdSubsystem::GetEntityManager() const
+{
+    UWorld* World = GetWorld();
+    UMassEntitySubsystem* EntitySubsystem = World ? World->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+    return EntitySubsystem ? &EntitySubsystem->GetMutableEntityManager() : nullptr;
+}
+
+int32 UWorldForgeCrowdSubsystem::GetPendingAgentCount() const
+{
+    int32 Pending = 0;
+    for (const FString& LandmarkId : SpawnQueue)
+    {
+        if (const FSettlementCrowd* Crowd = Crowds.Find(LandmarkId))
+        {
+            Pending += Crowd->Composition.Total() - Crowd->Entities.Num();
+        }
+    }
+    return Pending;
+}
+
+int32 UWorldForgeCrowdSubsystem::GetSettlementAgentCount(const FString& LandmarkId) const
+{
+    const FSettlementCrowd* Crowd = Crowds.Find(LandmarkId);
+    return Crowd ? Crowd->Entities.Num() : 0;
+}
+
+void UWorldForgeCrowdSubsystem::HandleSettlementInitialized(AWorldForgeSettlementActor* Actor)
+{
+    if (!Actor || Actor->GetWorld() != GetWorld() || !Archetype.IsValid())
+    {
+        return;
+    }
+
+    UpdateCompositions();
+    const FWorldForgeLandmark Landmark = Actor->GetLandmarkData();
+
+    // Re-initializing an actor (new landmark data) rebuilds its crowd from scratch
+    FSettlementCrowd& Crowd = Crowds.FindOrAdd(Landmark.Id);
+    DespawnCrowd(Crowd);
+
+    const FVector TypeScale = AWorldForgeSettlementActor::GetScaleForType(Landmark.Type);
+    Crowd.Actor = Actor;
+    Crowd.Type = Landmark.Type;
+    Crowd.Center = Landmark.Location;
+    // Around the landmark mesh (100 units per unit of scale) rather than inside it
+    Crowd.Radius = FMath::Max(TypeScale.X, TypeScale.Y) * 50.0f * 1.5f;
+    Crowd.Key = FCrc::StrCrc32(*Landmark.Id);
+    Crowd.Composition = FWorldForgeCrowdComposition::Make(Landmark.Type, Militarism, Prosperity, Religiosity, AgentsPerSettlement);
+
+    SpawnQueue.AddUnique(Landmark.Id);
+}
+
+void UWorldForgeCrowdSubsystem::HandleSettlementEndPlay(AWorldForgeSettlementActor* Actor)
+{
+    if (!Actor || Actor->GetWorld() != GetWorld())
+    {
+        return;
+    }
+
+    const FString LandmarkId = Actor->GetLandmarkData().Id;
+    FSettlementCrowd* Crowd = Crowds.Find(LandmarkId);
+    // Another actor may have taken over the landmark already (demote and re-promote in one pass)
+    if (!Crowd || (Crowd->Actor.IsValid() && Crowd->Actor.Get() != Actor))
+    {
+        return;
+    }
+
+    DespawnCrowd(*Crowd);
+    Crowds.Remove(LandmarkId);
+    SpawnQueue.Remove(LandmarkId);
+}
+
+void UWorldForgeCrowdSubsystem::DespawnCrowd(FSettlementCrowd& Crowd)
+{
+    if (Crowd.Entities.Num() == 0)
+    {
+        return;
+    }
+
+    if (FMassEntityManager* EntityManager = GetEntityManager())
+    {
+        EntityManager->BatchDestroyEntities(Crowd.Entities);
+    }
+    AgentCount -= Crowd.Entities.Num();
+    Crowd.Entities.Reset();
+}
+
+void UWorldForgeCrowdSubsystem::RepopulateAll()
+{
+    for (auto& Pair : Crowds)
+    {
+        DespawnCrowd(Pair.Value);
+        SpawnQueue.AddUnique(Pair.Key);
+    }
+}
+
+void UWorldForgeCrowdSubsystem::UpdateCompositions()
+{
+    UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+    const UWorldForgeSubsystem* WorldForge = GameInstance ? GameInstance->GetSubsystem<UWorldForgeSubsystem>() : nullptr;
+
+    const float NewMilitarism = WorldForge ? WorldForge->GetTrait(EWorldForgeTrait::Militarism) : 0.5f;
+    const float NewProsperity = WorldForge ? WorldForge->GetTrait(EWorldForgeTrait::Prosperity) : 0.5f;
+    const float NewReligiosity = WorldForge ? WorldForge->GetTrait(EWorldForgeTrait::Religiosity) : 0.5f;
+    const int32 NewAgents = FMath::Max(CVarCrowdAgentsPerSettlement.GetValueOnGameThread(), 0);
+
+    if (NewMilitarism == Militarism && NewProsperity == Prosperity && NewReligiosity == Religiosity && NewAgents == AgentsPerSettlement)
+    {
+        return;
+    }
+    Militarism = NewMilitarism;
+    Prosperity = NewProsperity;
+    Religiosity = NewReligiosity;
+    AgentsPerSettlement = NewAgents;
+
+    // Small trait moves often round to the same counts; only settlements whose mix changed respawn
+    int32 Changed = 0;
+    for (auto& Pair : Crowds)
+    {
+        const FWorldForgeCrowdComposition Composition = FWorldForgeCrowdComposition::Make(Pair.Value.Type, Militarism, Prosperity, Religiosity, AgentsPerSettlement);
+        if (Composition != Pair.Value.Composition)
+        {
+            DespawnCrowd(Pair.Value);
+            Pair.Value.Composition = Composition;
+            SpawnQueue.AddUnique(Pair.Key);
+            ++Changed;
+        }
+    }
+
+    if (Changed > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("WorldForge: Re-populating %d settlement crowds"), Changed);
+    }
+}
+
+int32 UWorldForgeCrowdSubsystem::SpawnQueued(int32 Budget)
+{
+    FMassEntityManager* EntityManager = GetEntityManager();
+    if (!EntityManager || !Archetype.IsValid())
+    {
+        return 0;
+    }
+
+    int32 Spawned = 0;
+    int32 QueueIndex = 0;
+    TArray<FMassEntityHandle> NewEntities;
+
+    for (; QueueIndex < SpawnQueue.Num() && Spawned < Budget; ++QueueIndex)
+    {
+        FSettlementCrowd* Crowd = Crowds.Find(SpawnQueue[QueueIndex]);
+        if (!Crowd)
+        {
+            continue;
+        }
+
+        const int32 First = Crowd->Entities.Num();
+        const int32 Count = FMath::Min(Crowd->Composition.Total() - First, Budget - Spawned);
+        if (Count <= 0)
+        {
+            continue;
+        }
+
+        NewEntities.Reset();
+        {
+            // Observers fire when the creation context goes out of scope, after the fragments are filled in
+            TSharedRef<FMassEntityManager::FEntityCreationContext> CreationContext = EntityManager->BatchCreateEntities(Archetype, Count, NewEntities);
+
+            // Agent N of the crowd is the (N - behavior start)-th agent of its behavior, in composition order
+            int32 Behavior = 0;
+            int32 BehaviorStart = 0;
+            for (int32 Index = 0; Index < NewEntities.Num(); ++Index)
+            {
+                const int32 AgentIndex = First + Index;
+                while (AgentIndex >= BehaviorStart + Crowd->Composition.Counts[Behavior])
+                {
+                    BehaviorStart += Crowd->Composition.Counts[Behavior];
+                    ++Behavior;
+                }
+
+                const FMassEntityHandle Entity = NewEntities[Index];
+                FWorldForgeCrowdAgentFragment& Agent = EntityManager->GetFragmentDataChecked<FWorldForgeCrowdAgentFragment>(Entity);
+                Agent = FWorldForgeCrowdMotion::MakeAgent(static_cast<EWorldForgeCrowdBehavior>(Behavior), Crowd->Center, Crowd->Radius, Crowd->Key, AgentIndex - BehaviorStart);
+
+                FWorldForgeCrowdLocationFragment& Location = EntityManager->GetFragmentDataChecked<FWorldForgeCrowdLocationFragment>(Entity);
+                FWorldForgeCrowdMotion::Evaluate(Agent, Location.Location, Location.Yaw);
+
+                FWorldForgeCrowdLODFragment& LOD = EntityManager->GetFragmentDataChecked<FWorldForgeCrowdLODFragment>(Entity);
+                LOD.FrameOffset = static_cast<uint8>(AgentIndex & 0xFF);
+                LOD.MaxTier = Crowd->MaxTier;
+            }
+        }
+
+        Crowd->Entities.Append(NewEntities);
+        Spawned += NewEntities.Num();
+        AgentCount += NewEntities.Num();
+
+        // Stop on a partially spawned crowd so it stays at the head of the queue
+        if (Crowd->Entities.Num() < Crowd->Composition.Total())
+        {
+            break;
+        }
+    }
+
+    SpawnQueue.RemoveAt(0, QueueIndex);
+    return Spawned;
+}
+
+void UWorldForgeCrowdSubsystem::UpdateSignificance()
+{
+    FMassEntityManager* EntityManager = GetEntityManager();
+    if (!EntityManager)
+    {
+        return;
+    }
+
+    for (auto& Pair : Crowds)
+    {
+        FSettlementCrowd& Crowd = Pair.Value;
+        const AWorldForgeSettlementActor* Actor = Crowd.Actor.Get();
+        if (!Actor)
+        {
+            continue;
+        }
+
+        // Significance tiers map one to one onto crowd tiers, Dormant onto Off
+        const EWorldForgeCrowdLOD MaxTier = static_cast<EWorldForgeCrowdLOD>(Actor->GetSignificanceTier());
+        if (MaxTier == Crowd.MaxTier)
+        {
+            continue;
+        }
+
+        Crowd.MaxTier = MaxTier;
+        for (const FMassEntityHandle& Entity : Crowd.Entities)
+        {
+            EntityManager->GetFragmentDataChecked<FWorldForgeCrowdLODFragment>(Entity).MaxTier = MaxTier;
+        }
+    }
+}
+
+void UWorldForgeCrowdSubsystem::RunProcessors(float DeltaTime)
+{
+    FMassEntityManager* EntityManager = GetEntityManager();
+    if (!EntityManager || AgentCount == 0)
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    APlayerController* PC = World->GetFirstPlayerController();
+    if (PC && PC->PlayerCameraManager)
+    {
+        LODProcessor->ViewerLocation = PC->PlayerCameraManager->GetCameraLocation();
+    }
+    else if (PC && PC->GetPawn())
+    {
+        LODProcessor->ViewerLocation = PC->GetPawn()->GetActorLocation();
+    }
+
+    UMassProcessor* const ProcessorList[] = { LODProcessor, MovementProcessor, RepresentationProcessor };
+    FMassProcessingContext ProcessingContext(EntityManager->AsShared(), DeltaTime);
+    UE::Mass::Executor::RunProcessorsView(ProcessorList, ProcessingContext);
+}
+
+void UWorldForgeCrowdSubsystem::UpdateRepresentation()
+{
+    UWorld* World = GetWorld();
+    if (!CrowdActor)
+    {
+        if (AgentCount == 0)
+        {
+            return;
+        }
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        CrowdActor = World->SpawnActor<AWorldForgeCrowdActor>(AWorldForgeCrowdActor::StaticClass(), FTransform::Identity, SpawnParams);
+        if (!CrowdActor)
+        {
+            return;
+        }
+    }
+
+    static const TArray<FTransform> NoTransforms;
+    for (int32 Behavior = 0; Behavior < static_cast<int32>(EWorldForgeCrowdBehavior::Count); ++Behavior)
+    {
+        const EWorldForgeCrowdBehavior CrowdBehavior = static_cast<EWorldForgeCrowdBehavior>(Behavior);
+        CrowdActor->SetInstances(CrowdBehavior, AgentCount > 0 ? RepresentationProcessor->GetTransforms(CrowdBehavior) : NoTransforms);
+    }
+}
+
+void UWorldForgeCrowdSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (!Archetype.IsValid())
+    {
+        return;
+    }
+
+    const bool bWantEnabled = CVarCrowds.GetValueOnGameThread();
+    if (bWantEnabled != bEnabled)
+    {
+        bEnabled = bWantEnabled;
+        if (bEnabled)
+        {
+            RepopulateAll();
+        }
+        else
+        {
+            for (auto& Pair : Crowds)
+            {
+                DespawnCrowd(Pair.Value);
+            }
+            SpawnQueue.Empty();
+            UpdateRepresentation();
+        }
+    }
+
+    if (!bEnabled)
+    {
+        return;
+    }
+
+    UpdateCompositions();
+    SpawnQueued(FMath::Max(CVarCrowdSpawnBudget.GetValueOnGameThread(), 1));
+    UpdateSignificance();
+    RunProcessors(DeltaTime);
+    UpdateRepresentation();
+}
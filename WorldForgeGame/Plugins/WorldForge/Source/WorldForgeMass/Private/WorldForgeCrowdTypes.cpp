@@ -0,0 +1,173 @@
+#include "WorldForgeCrowdTypes.h"
+
+namespace WorldForgeCrowd
+{
+    float GetTypeScale(EWorldForgeLandmarkType Type)
+    {
+        switch (Type)
+        {
+        case EWorldForgeLandmarkType::Settlement: return 1.0f;
+        case EWorldForgeLandmarkType::Fortress: return 0.6f;
+        case EWorldForgeLandmarkType::Monastery: return 0.4f;
+        case EWorldForgeLandmarkType::Ruin: return 0.05f;
+        default: return 0.0f;
+        }
+    }
+}
+
+int32 FWorldForgeCrowdComposition::Total() const
+{
+    int32 Sum = 0;
+    for (int32 Count : Counts)
+    {
+        Sum += Count;
+    }
+    return Sum;
+}
+
+bool FWorldForgeCrowdComposition::operator==(const FWorldForgeCrowdComposition& Other) const
+{
+    return FMemory::Memcmp(Counts, Other.Counts, sizeof(Counts)) == 0;
+}
+
+FWorldForgeCrowdComposition FWorldForgeCrowdComposition::Make(EWorldForgeLandmarkType Type, float Militarism, float Prosperity, float Religiosity, int32 AgentsPerSettlement)
+{
+    FWorldForgeCrowdComposition Composition;
+
+    const int32 Total = FMath::RoundToInt32(AgentsPerSettlement * WorldForgeCrowd::GetTypeScale(Type));
+    if (Total <= 0)
+    {
+        return Composition;
+    }
+
+    // Ruins are only ever wandered through
+    if (Type == EWorldForgeLandmarkType::Ruin)
+    {
+        Composition.Counts[static_cast<int32>(EWorldForgeCrowdBehavior::Villager)] = Total;
+        return Composition;
+    }
+
+    float Weights[static_cast<int32>(EWorldForgeCrowdBehavior::Count)];
+    Weights[static_cast<int32>(EWorldForgeCrowdBehavior::Patrol)] = (0.2f + Militarism) * (Type == EWorldForgeLandmarkType::Fortress ? 2.0f : 1.0f);
+    Weights[static_cast<int32>(EWorldForgeCrowdBehavior::Procession)] = Religiosity * (Type == EWorldForgeLandmarkType::Monastery ? 2.0f : 1.0f);
+    Weights[static_cast<int32>(EWorldForgeCrowdBehavior::Market)] = Type == EWorldForgeLandmarkType::Settlement ? Prosperity : 0.2f * Prosperity;
+    Weights[static_cast<int32>(EWorldForgeCrowdBehavior::Villager)] = 0.5f;
+
+    float WeightSum = 0.0f;
+    for (float Weight : Weights)
+    {
+        WeightSum += Weight;
+    }
+
+    // Largest remainder, so the counts always add up to Total
+    int32 Assigned = 0;
+    float Remainders[static_cast<int32>(EWorldForgeCrowdBehavior::Count)];
+    for (int32 Behavior = 0; Behavior < static_cast<int32>(EWorldForgeCrowdBehavior::Count); ++Behavior)
+    {
+        const float Exact = Total * Weights[Behavior] / WeightSum;
+        Composition.Counts[Behavior] = FMath::FloorToInt32(Exact);
+        Remainders[Behavior] = Exact - Composition.Counts[Behavior];
+        Assigned += Composition.Counts[Behavior];
+    }
+    for (; Assigned < Total; ++Assigned)
+    {
+        int32 Best = 0;
+        for (int32 Behavior = 1; Behavior < static_cast<int32>(EWorldForgeCrowdBehavior::Count); ++Behavior)
+        {
+            if (Remainders[Behavior] > Remainders[Best])
+            {
+                Best = Behavior;
+            }
+        }
+        ++Composition.Counts[Best];
+        Remainders[Best] = -1.0f;
+    }
+
+    return Composition;
+}
+
+FWorldForgeCrowdAgentFragment FWorldForgeCrowdMotion::MakeAgent(EWorldForgeCrowdBehavior Behavior, const FVector& Center, float SettlementRadius, uint32 SettlementKey, int32 Index)
+{
+    FRandomStream Random(static_cast<int32>(HashCombine(HashCombine(SettlementKey, GetTypeHash(static_cast<uint8>(Behavior))), GetTypeHash(Index))));
+
+    FWorldForgeCrowdAgentFragment Agent;
+    Agent.Behavior = Behavior;
+    Agent.Anchor = Center;
+    Agent.Time = Random.FRandRange(0.0f, 600.0f);
+
+    switch (Behavior)
+    {
+    case EWorldForgeCrowdBehavior::Patrol:
+        // Along the walls, in squads spaced around the perimeter
+        Agent.Radius = SettlementRadius * Random.FRandRange(0.9f, 1.0f);
+        Agent.Phase = (Index / 4) * 1.3f + (Index % 4) * 0.02f;
+        Agent.Speed = 160.0f;
+        break;
+
+    case EWorldForgeCrowdBehavior::Procession:
+        // One file on a ring around the temple, closely spaced
+        Agent.Radius = SettlementRadius * 0.35f;
+        Agent.Phase = Index * 0.08f;
+        Agent.Speed = 50.0f;
+        break;
+
+    case EWorldForgeCrowdBehavior::Market:
+        Agent.Anchor += FVector(Random.FRandRange(-0.15f, 0.15f), Random.FRandRange(-0.15f, 0.15f), 0.0f) * SettlementRadius;
+        Agent.Radius = SettlementRadius * Random.FRandRange(0.05f, 0.15f);
+        Agent.Phase = Random.FRandRange(0.0f, 2.0f * PI);
+        Agent.Speed = 70.0f;
+        break;
+
+    default:
+        Agent.Anchor += FVector(Random.FRandRange(-0.6f, 0.6f), Random.FRandRange(-0.6f, 0.6f), 0.0f) * SettlementRadius;
+        Agent.Radius = SettlementRadius * Random.FRandRange(0.1f, 0.3f);
+        Agent.Phase = Random.FRandRange(0.0f, 2.0f * PI);
+        Agent.Speed = Random.FRandRange(90.0f, 130.0f);
+        break;
+    }
+
+    return Agent;
+}
+
+void FWorldForgeCrowdMotion::Evaluate(const FWorldForgeCrowdAgentFragment& Agent, FVector& OutLocation, float& OutYaw)
+{
+    const float Radius = FMath::Max(Agent.Radius, 1.0f);
+    FVector2D Offset;
+    FVector2D Velocity;
+
+    switch (Agent.Behavior)
+    {
+    case EWorldForgeCrowdBehavior::Patrol:
+    case EWorldForgeCrowdBehavior::Procession:
+    {
+        // Constant speed around a circle
+        const float Angle = Agent.Phase + Agent.Time * Agent.Speed / Radius;
+        float Sin, Cos;
+        FMath::SinCos(&Sin, &Cos, Angle);
+        Offset = FVector2D(Cos, Sin) * Radius;
+        Velocity = FVector2D(-Sin, Cos);
+        break;
+    }
+
+    case EWorldForgeCrowdBehavior::Market:
+    {
+        // Figure-of-eight between stalls
+        const float T = Agent.Phase + Agent.Time * Agent.Speed / Radius;
+        Offset = FVector2D(FMath::Sin(T), FMath::Sin(2.0f * T) * 0.5f) * Radius;
+        Velocity = FVector2D(FMath::Cos(T), FMath::Cos(2.0f * T));
+        break;
+    }
+
+    default:
+    {
+        // Two incommensurate frequencies, so the path never visibly repeats
+        const float T = Agent.Phase + Agent.Time * Agent.Speed / Radius;
+        Offset = FVector2D(FMath::Sin(T) + 0.5f * FMath::Sin(2.7f * T + 1.0f), FMath::Cos(1.3f * T) + 0.5f * FMath::Cos(3.1f * T)) * (Radius / 1.5f);
+        Velocity = FVector2D(FMath::Cos(T) + 1.35f * FMath::Cos(2.7f * T + 1.0f), -1.3f * FMath::Sin(1.3f * T) - 1.55f * FMath::Sin(3.1f * T));
+        break;
+    }
+    }
+
+    OutLocation = Agent.Anchor + FVector(Offset, 0.0f);
+    OutYaw = FMath::RadiansToDegrees(FMath::Atan2(Velocity.Y, Velocity.X));
+}
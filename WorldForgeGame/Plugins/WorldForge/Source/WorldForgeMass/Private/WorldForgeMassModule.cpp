@@ -0,0 +1,17 @@
+#include "WorldForgeMassModule.h"
+
+#define LOCTEXT_NAMESPACE "FWorldForgeMassModule"
+
+void FWorldForgeMassModule::StartupModule()
+{
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Mass module started"));
+}
+
+void FWorldForgeMassModule::ShutdownModule()
+{
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: Mass module shutdown"));
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FWorldForgeMassModule, WorldForgeMass)
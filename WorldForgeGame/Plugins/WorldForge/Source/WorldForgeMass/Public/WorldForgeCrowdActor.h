@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "WorldForgeCrowdTypes.h"
+#include "WorldForgeCrowdActor.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/**
+ * Draws every crowd agent as an instance, one instanced mesh component per behavior, so a settlement
+ * full of agents costs a handful of draw calls rather than an actor each.
+ */
+UCLASS(NotBlueprintable)
+class WORLDFORGEMASS_API AWorldForgeCrowdActor : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AWorldForgeCrowdActor();
+
+    /** Replace the instances of one behavior. Updates in place while the count is unchanged. */
+    void SetInstances(EWorldForgeCrowdBehavior Behavior, const TArray<FTransform>& Transforms);
+
+    int32 GetInstanceCount() const;
+
+private:
+    UPROPERTY(VisibleAnywhere, Category = "Components")
+    TObjectPtr<USceneComponent> SceneRoot;
+
+    /** Instanced component per EWorldForgeCrowdBehavior */
+    UPROPERTY(VisibleAnywhere, Category = "Components")
+    TArray<TObjectPtr<UInstancedStaticMeshComponent>> BehaviorComponents;
+};
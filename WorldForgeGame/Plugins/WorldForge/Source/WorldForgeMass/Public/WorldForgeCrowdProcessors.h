@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "WorldForgeCrowdTypes.h"
+#include "WorldForgeCrowdProcessors.generated.h"
+
+/**
+ * Assigns every agent a simulation tier from its distance to the viewer, capped by its settlement's
+ * significance. The crowd subsystem runs the crowd processors itself, in the order LOD, movement,
+ * representation, rather than through the Mass simulation phases, so crowds need no MassGameplay
+ * setup in the level.
+ */
+UCLASS()
+class WORLDFORGEMASS_API UWorldForgeCrowdLODProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UWorldForgeCrowdLODProcessor();
+
+    FVector ViewerLocation = FVector::ZeroVector;
+
+    /** Upper distance of the High, Medium and Low tiers; agents beyond the last are Off */
+    float TierDistances[3] = { 5000.0f, 20000.0f, 60000.0f };
+
+protected:
+    virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+};
+
+/**
+ * Moves agents along their routes, in parallel over chunks. High agents are updated every frame, Medium
+ * every 4th and Low every 16th, staggered per agent; skipped time is banked and applied on the next
+ * update, so reduced-rate agents stay on schedule.
+ */
+UCLASS()
+class WORLDFORGEMASS_API UWorldForgeCrowdMovementProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UWorldForgeCrowdMovementProcessor();
+
+    /** Agents moved by the last execution */
+    int32 GetLastUpdated() const { return LastUpdated; }
+
+protected:
+    virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+    uint32 Frame = 0;
+    int32 LastUpdated = 0;
+};
+
+/**
+ * Gathers the transforms of visible agents per behavior, for the crowd actor's instanced meshes.
+ */
+UCLASS()
+class WORLDFORGEMASS_API UWorldForgeCrowdRepresentationProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UWorldForgeCrowdRepresentationProcessor();
+
+    /** Instance transforms of the last execution, per behavior */
+    const TArray<FTransform>& GetTransforms(EWorldForgeCrowdBehavior Behavior) const { return Transforms[static_cast<int32>(Behavior)]; }
+
+    /** Agents per tier in the last execution */
+    int32 GetTierCount(EWorldForgeCrowdLOD Tier) const { return TierCounts[static_cast<int32>(Tier)]; }
+
+protected:
+    virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+    TArray<FTransform> Transforms[static_cast<int32>(EWorldForgeCrowdBehavior::Count)];
+    int32 TierCounts[4] = {};
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassEntityTypes.h"
+#include "MassArchetypeTypes.h"
+#include "WorldForgeCrowdTypes.h"
+#include "WorldForgeCrowdSubsystem.generated.h"
+
+class AWorldForgeCrowdActor;
+class AWorldForgeSettlementActor;
+class UWorldForgeCrowdLODProcessor;
+class UWorldForgeCrowdMovementProcessor;
+class UWorldForgeCrowdRepresentationProcessor;
+struct FMassEntityManager;
+
+/**
+ * Ambient crowds around settlement actors: guards on patrol where militarism is high, processions where
+ * religiosity is, market crowds where prosperity is. Agents are Mass entities, spawned when a settlement
+ * actor is initialized and destroyed when it leaves play, moved by the crowd processors with distance
+ * tiers and drawn as instances through one AWorldForgeCrowdActor.
+ *
+ * Spawning is spread over frames under a budget; trait changes re-populate settlements whose
+ * composition changed. A settlement's significance tier caps how often its agents are updated, and
+ * Dormant settlements' agents are neither moved nor drawn. Game worlds only.
+ */
+UCLASS()
+class WORLDFORGEMASS_API UWorldForgeCrowdSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Live agents */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Crowds")
+    int32 GetAgentCount() const { return AgentCount; }
+
+    /** Agents still waiting for spawn budget */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Crowds")
+    int32 GetPendingAgentCount() const;
+
+    /** Agents of one settlement; 0 if it has no crowd */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|Crowds")
+    int32 GetSettlementAgentCount(const FString& LandmarkId) const;
+
+    /** Despawn and re-populate every settlement */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|Crowds")
+    void RepopulateAll();
+
+private:
+    struct FSettlementCrowd
+    {
+        TWeakObjectPtr<AWorldForgeSettlementActor> Actor;
+        EWorldForgeLandmarkType Type = EWorldForgeLandmarkType::Settlement;
+        FVector Center = FVector::ZeroVector;
+        float Radius = 1000.0f;
+        uint32 Key = 0;
+        FWorldForgeCrowdComposition Composition;
+
+        /** Significance cap applied to the spawned agents */
+        EWorldForgeCrowdLOD MaxTier = EWorldForgeCrowdLOD::High;
+
+        /** Spawned so far, in composition order; the crowd is complete at Composition.Total() */
+        TArray<FMassEntityHandle> Entities;
+    };
+
+    TMap<FString, FSettlementCrowd> Crowds;
+
+    /** Settlements with agents left to spawn, in arrival order */
+    TArray<FString> SpawnQueue;
+
+    FMassArchetypeHandle Archetype;
+
+    UPROPERTY()
+    TObjectPtr<UWorldForgeCrowdLODProcessor> LODProcessor;
+
+    UPROPERTY()
+    TObjectPtr<UWorldForgeCrowdMovementProcessor> MovementProcessor;
+
+    UPROPERTY()
+    TObjectPtr<UWorldForgeCrowdRepresentationProcessor> RepresentationProcessor;
+
+    UPROPERTY()
+    TObjectPtr<AWorldForgeCrowdActor> CrowdActor;
+
+    /** Traits and agent count the current compositions were made from */
+    float Militarism = -1.0f;
+    float Prosperity = -1.0f;
+    float Religiosity = -1.0f;
+    int32 AgentsPerSettlement = -1;
+
+    int32 AgentCount = 0;
+    bool bEnabled = true;
+
+    FDelegateHandle InitializedHandle;
+    FDelegateHandle EndPlayHandle;
+
+    void HandleSettlementInitialized(AWorldForgeSettlementActor* Actor);
+    void HandleSettlementEndPlay(AWorldForgeSettlementActor* Actor);
+
+    FMassEntityManager* GetEntityManager() const;
+
+    /** Re-read traits and settings; settlements whose composition changed are despawned and queued */
+    void UpdateCompositions();
+
+    /** Spawn queued agents, at most Budget; returns the number spawned */
+    int32 SpawnQueued(int32 Budget);
+
+    /** Cap each crowd's tiers by its settlement actor's significance tier */
+    void UpdateSignificance();
+
+    void DespawnCrowd(FSettlementCrowd& Crowd);
+
+    void RunProcessors(float DeltaTime);
+
+    void UpdateRepresentation();
+};
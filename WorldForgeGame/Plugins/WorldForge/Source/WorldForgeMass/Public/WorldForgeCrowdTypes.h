@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "WorldForgeTypes.h"
+#include "WorldForgeCrowdTypes.generated.h"
+
+/**
+ * What an ambient agent does; the share of each follows the world traits
+ */
+UENUM(BlueprintType)
+enum class EWorldForgeCrowdBehavior : uint8
+{
+    /** Walks the settlement's perimeter (militarism) */
+    Patrol       UMETA(DisplayName = "Patrol"),
+    /** Files slowly around the settlement's center in a line (religiosity) */
+    Procession   UMETA(DisplayName = "Procession"),
+    /** Mills around the market square (prosperity) */
+    Market       UMETA(DisplayName = "Market"),
+    /** Wanders between homes */
+    Villager     UMETA(DisplayName = "Villager"),
+    Count        UMETA(Hidden)
+};
+
+/**
+ * Simulation tiers by distance to the viewer. Lower tiers are updated less often; Off agents are
+ * neither moved nor drawn.
+ */
+enum class EWorldForgeCrowdLOD : uint8
+{
+    High,
+    Medium,
+    Low,
+    Off
+};
+
+/**
+ * Where and how an agent moves. Positions are a closed-form function of the agent's own clock, so an
+ * agent updated every 16th frame lands exactly where one updated every frame would.
+ */
+USTRUCT()
+struct WORLDFORGEMASS_API FWorldForgeCrowdAgentFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    /** Center of the agent's route: settlement center, market square or perimeter center */
+    FVector Anchor = FVector::ZeroVector;
+
+    float Radius = 1000.0f;
+
+    /** Offset along the route in radians, so agents of one settlement spread out */
+    float Phase = 0.0f;
+
+    /** Walking speed in Unreal units per second */
+    float Speed = 120.0f;
+
+    /** Agent clock, advanced by the time since its last update */
+    float Time = 0.0f;
+
+    EWorldForgeCrowdBehavior Behavior = EWorldForgeCrowdBehavior::Villager;
+};
+
+/**
+ * Current agent location and facing, written by the movement processor
+ */
+USTRUCT()
+struct WORLDFORGEMASS_API FWorldForgeCrowdLocationFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    FVector Location = FVector::ZeroVector;
+    float Yaw = 0.0f;
+};
+
+/**
+ * Simulation tier and the time accumulated since the agent was last moved
+ */
+USTRUCT()
+struct WORLDFORGEMASS_API FWorldForgeCrowdLODFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    EWorldForgeCrowdLOD Tier = EWorldForgeCrowdLOD::High;
+
+    /** Best tier the agent may have, from its settlement's significance */
+    EWorldForgeCrowdLOD MaxTier = EWorldForgeCrowdLOD::High;
+
+    /** Staggers reduced-rate updates so a tier's agents do not all move on the same frame */
+    uint8 FrameOffset = 0;
+
+    float PendingSeconds = 0.0f;
+};
+
+/**
+ * How many agents of each behavior a landmark gets, from its type and the traits.
+ */
+struct WORLDFORGEMASS_API FWorldForgeCrowdComposition
+{
+    int32 Counts[static_cast<int32>(EWorldForgeCrowdBehavior::Count)] = {};
+
+    int32 Total() const;
+
+    /**
+     * Fortresses favor patrols and monasteries processions; ruins get a few wanderers and natural sites none.
+     * @param AgentsPerSettlement Agents of an ordinary settlement; other types are scaled from it
+     */
+    static FWorldForgeCrowdComposition Make(EWorldForgeLandmarkType Type, float Militarism, float Prosperity, float Religiosity, int32 AgentsPerSettlement);
+
+    bool operator==(const FWorldForgeCrowdComposition& Other) const;
+    bool operator!=(const FWorldForgeCrowdComposition& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Closed-form agent routes shared by the movement processor and the benchmark.
+ */
+struct WORLDFORGEMASS_API FWorldForgeCrowdMotion
+{
+    /** Route parameters for the Index-th agent of a behavior at a settlement; deterministic per key */
+    static FWorldForgeCrowdAgentFragment MakeAgent(EWorldForgeCrowdBehavior Behavior, const FVector& Center, float SettlementRadius, uint32 SettlementKey, int32 Index);
+
+    /** Location and yaw of an agent at its current clock */
+    static void Evaluate(const FWorldForgeCrowdAgentFragment& Agent, FVector& OutLocation, float& OutYaw);
+};
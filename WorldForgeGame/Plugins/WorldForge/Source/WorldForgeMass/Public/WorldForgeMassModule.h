@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+/**
+ * Mass Entity integration for WorldForge: ambient crowds of instanced agents populating settlements,
+ * simulated by Mass processors in distance-based LOD tiers.
+ */
+class FWorldForgeMassModule : public IModuleInterface
+{
+public:
+    /** IModuleInterface implementation */
+    virtual void StartupModule() override;
+    virtual void ShutdownModule() override;
+};
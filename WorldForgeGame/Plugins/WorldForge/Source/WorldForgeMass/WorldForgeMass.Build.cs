@@ -0,0 +1,20 @@
+using UnrealBuildTool;
+
+public class WorldForgeMass : ModuleRules
+{
+    public WorldForgeMass(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "CoreUObject",
+                "Engine",
+                "MassEntity",
+                "WorldForge"
+            }
+        );
+    }
+}
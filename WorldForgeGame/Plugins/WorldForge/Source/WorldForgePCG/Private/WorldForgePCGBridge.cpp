@@ -0,0 +1,226 @@
+#include "WorldForgePCGBridge.h"
+#include "WorldForgePCGNodes.h"
+#include "WorldForgeSubsystem.h"
+#include "PCGComponent.h"
+#include "PCGGraph.h"
+#include "PCGNode.h"
+#include "PCGSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+static TAutoConsoleVariable<float> CVarPCGRefreshInterval(
+    TEXT("WorldForge.PCGRefreshInterval"),
+    0.25f,
+    TEXT("Seconds between PCG refreshes; world state changes within one interval are batched into one regeneration"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarPCGLandmarkPadding(
+    TEXT("WorldForge.PCGLandmarkPadding"),
+    5000.0f,
+    TEXT("A landmark change regenerates PCG components whose grid bounds come within this distance of it"),
+    ECVF_Default);
+
+namespace
+{
+    UWorldForgeSubsystem* GetWorldForgeSubsystem(const UWorld* World)
+    {
+        const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+        return GameInstance ? GameInstance->GetSubsystem<UWorldForgeSubsystem>() : nullptr;
+    }
+
+    bool StateSettingsDiffer(const FWorldForgeState& A, const FWorldForgeState& B)
+    {
+        return A.Militarism != B.Militarism || A.Prosperity != B.Prosperity || A.Religiosity != B.Religiosity
+            || A.Lawfulness != B.Lawfulness || A.Openness != B.Openness || A.Atmosphere != B.Atmosphere
+            || A.Seed != B.Seed || A.Era.Id != B.Era.Id;
+    }
+}
+
+bool UWorldForgePCGBridge::ShouldCreateSubsystem(UObject* Outer) const
+{
+    const UWorld* World = Cast<UWorld>(Outer);
+    return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UWorldForgePCGBridge::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    UWorldForgeSubsystem* WorldForge = GetWorldForgeSubsystem(&InWorld);
+    if (!WorldForge)
+    {
+        return;
+    }
+
+    // Components generate from the current state on their own at begin play; only later changes are diffed
+    StateSnapshot = WorldForge->GetWorldState();
+    for (const FWorldForgeLandmark& Landmark : StateSnapshot.Landmarks)
+    {
+        LandmarkSnapshot.Add(Landmark.Id, Landmark.Location);
+    }
+    StateSnapshot.Landmarks.Empty();
+
+    WorldForge->OnWorldStateChanged.AddDynamic(this, &UWorldForgePCGBridge::HandleWorldStateChanged);
+}
+
+void UWorldForgePCGBridge::Deinitialize()
+{
+    if (UWorldForgeSubsystem* WorldForge = GetWorldForgeSubsystem(GetWorld()))
+    {
+        WorldForge->OnWorldStateChanged.RemoveDynamic(this, &UWorldForgePCGBridge::HandleWorldStateChanged);
+    }
+    Super::Deinitialize();
+}
+
+void UWorldForgePCGBridge::RefreshAll()
+{
+    bRefreshAll = true;
+}
+
+void UWorldForgePCGBridge::HandleWorldStateChanged(const FWorldForgeState& NewState)
+{
+    if (StateSettingsDiffer(NewState, StateSnapshot))
+    {
+        bStateDirty = true;
+    }
+    StateSnapshot.Era = NewState.Era;
+    StateSnapshot.Seed = NewState.Seed;
+    StateSnapshot.Militarism = NewState.Militarism;
+    StateSnapshot.Prosperity = NewState.Prosperity;
+    StateSnapshot.Religiosity = NewState.Religiosity;
+    StateSnapshot.Lawfulness = NewState.Lawfulness;
+    StateSnapshot.Openness = NewState.Openness;
+    StateSnapshot.Atmosphere = NewState.Atmosphere;
+
+    // Added and moved landmarks mark their new location, removed and moved ones their old location
+    TMap<FString, FVector> Current;
+    Current.Reserve(NewState.Landmarks.Num());
+    for (const FWorldForgeLandmark& Landmark : NewState.Landmarks)
+    {
+        Current.Add(Landmark.Id, Landmark.Location);
+        const FVector* Previous = LandmarkSnapshot.Find(Landmark.Id);
+        if (!Previous || !Previous->Equals(Landmark.Location))
+        {
+            DirtyLocations.Add(Landmark.Location);
+            if (Previous)
+            {
+                DirtyLocations.Add(*Previous);
+            }
+        }
+    }
+    for (const TPair<FString, FVector>& Pair : LandmarkSnapshot)
+    {
+        if (!Current.Contains(Pair.Key))
+        {
+            DirtyLocations.Add(Pair.Value);
+        }
+    }
+    LandmarkSnapshot = MoveTemp(Current);
+}
+
+void UWorldForgePCGBridge::Tick(float DeltaTime)
+{
+    if (!bStateDirty && !bRefreshAll && DirtyLocations.Num() == 0)
+    {
+        return;
+    }
+
+    RefreshTimer += DeltaTime;
+    if (RefreshTimer < CVarPCGRefreshInterval.GetValueOnGameThread())
+    {
+        return;
+    }
+    RefreshTimer = 0.0f;
+
+    UWorld* World = GetWorld();
+    const float Padding = CVarPCGLandmarkPadding.GetValueOnGameThread();
+    TMap<const UPCGGraph*, uint8> GraphUsage;
+    int32 NumConsidered = 0;
+    int32 NumRegenerated = 0;
+
+    for (UPCGComponent* Component : TObjectRange<UPCGComponent>())
+    {
+        // A partitioned component is only the parent of its local components, which are refreshed individually
+        if (!IsValid(Component) || Component->GetWorld() != World || Component->IsPartitioned())
+        {
+            continue;
+        }
+
+        const UPCGGraph* Graph = Component->GetGraph();
+        const uint8* CachedUsage = GraphUsage.Find(Graph);
+        const uint8 Usage = CachedUsage ? *CachedUsage : GraphUsage.Add(Graph, GetGraphUsage(Graph));
+        if (Usage == UsesNone)
+        {
+            continue;
+        }
+        ++NumConsidered;
+
+        bool bAffected = bRefreshAll || (bStateDirty && (Usage & UsesState));
+        if (!bAffected && (Usage & UsesLandmarks) && DirtyLocations.Num() > 0)
+        {
+            const FBox Bounds = Component->GetGridBounds().ExpandBy(FVector(Padding, Padding, 0.0));
+            for (const FVector& Location : DirtyLocations)
+            {
+                if (Location.X >= Bounds.Min.X && Location.X <= Bounds.Max.X && Location.Y >= Bounds.Min.Y && Location.Y <= Bounds.Max.Y)
+                {
+                    bAffected = true;
+                    break;
+                }
+            }
+        }
+
+        if (bAffected)
+        {
+            RegenerateComponent(Component);
+            ++NumRegenerated;
+        }
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("WorldForge: PCG refresh regenerated %d of %d WorldForge components (state %s, %d landmark changes)"),
+           NumRegenerated, NumConsidered, bStateDirty ? TEXT("changed") : TEXT("unchanged"), DirtyLocations.Num());
+
+    RegeneratedCount += NumRegenerated;
+    DirtyLocations.Reset();
+    bStateDirty = false;
+    bRefreshAll = false;
+}
+
+uint8 UWorldForgePCGBridge::GetGraphUsage(const UPCGGraph* Graph)
+{
+    uint8 Usage = UsesNone;
+    if (!Graph)
+    {
+        return Usage;
+    }
+
+    // Top-level nodes only; graphs that read WorldForge data inside a subgraph should call RefreshAll
+    for (const UPCGNode* Node : Graph->GetNodes())
+    {
+        const UPCGSettings* Settings = Node ? Node->GetSettings() : nullptr;
+        if (Cast<UPCGWorldForgeLandmarksSettings>(Settings))
+        {
+            Usage |= UsesLandmarks;
+        }
+        else if (Cast<UPCGWorldForgeStateSettings>(Settings))
+        {
+            Usage |= UsesState;
+        }
+    }
+    return Usage;
+}
+
+void UWorldForgePCGBridge::RegenerateComponent(UPCGComponent* Component)
+{
+    if (Component->IsManagedByRuntimeGenSystem())
+    {
+        if (UPCGSubsystem* PCGSubsystem = UPCGSubsystem::GetInstance(GetWorld()))
+        {
+            PCGSubsystem->RefreshRuntimeGenComponent(Component);
+        }
+        return;
+    }
+
+    Component->GenerateLocal(/*bForce=*/true);
+}
@@ -0,0 +1,17 @@
+#include "WorldForgePCGModule.h"
+
+#define LOCTEXT_NAMESPACE "FWorldForgePCGModule"
+
+void FWorldForgePCGModule::StartupModule()
+{
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: PCG module started"));
+}
+
+void FWorldForgePCGModule::ShutdownModule()
+{
+    UE_LOG(LogTemp, Log, TEXT("WorldForge: PCG module shutdown"));
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FWorldForgePCGModule, WorldForgePCG)
@@ -0,0 +1,196 @@
+#include "WorldForgePCGNodes.h"
+#include "WorldForgeSubsystem.h"
+#include "WorldForgeScatter.h"
+#include "PCGComponent.h"
+#include "PCGContext.h"
+#include "PCGPin.h"
+#include "Data/PCGPointData.h"
+#include "PCGParamData.h"
+#include "Metadata/PCGMetadata.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+#define LOCTEXT_NAMESPACE "WorldForgePCGNodes"
+
+namespace WorldForgePCG
+{
+    /** Subsystem of the game instance running the component's world, or null outside a game world */
+    static UWorldForgeSubsystem* GetSubsystem(const UPCGComponent* Component)
+    {
+        const UWorld* World = Component ? Component->GetWorld() : nullptr;
+        const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+        return GameInstance ? GameInstance->GetSubsystem<UWorldForgeSubsystem>() : nullptr;
+    }
+
+    static const TCHAR* GetScatterLayerName(int32 Layer)
+    {
+        static const TCHAR* Names[] = { TEXT("Trees"), TEXT("Shrubs"), TEXT("Rocks"), TEXT("DeadTrees"), TEXT("Shrines"), TEXT("Props") };
+        static_assert(UE_ARRAY_COUNT(Names) == FWorldForgeScatter::NumLayers, "Scatter layer names out of date");
+        return Names[Layer];
+    }
+}
+
+#if WITH_EDITOR
+FText UPCGWorldForgeLandmarksSettings::GetDefaultNodeTitle() const
+{
+    return LOCTEXT("LandmarksNodeTitle", "WorldForge Landmarks");
+}
+
+FText UPCGWorldForgeLandmarksSettings::GetNodeTooltipText() const
+{
+    return LOCTEXT("LandmarksNodeTooltip", "Points for the WorldForge landmarks inside the component bounds, with their ID, name and type as attributes.");
+}
+#endif
+
+TArray<FPCGPinProperties> UPCGWorldForgeLandmarksSettings::OutputPinProperties() const
+{
+    TArray<FPCGPinProperties> PinProperties;
+    PinProperties.Emplace(PCGPinConstants::DefaultOutputLabel, EPCGDataType::Point);
+    return PinProperties;
+}
+
+FPCGElementPtr UPCGWorldForgeLandmarksSettings::CreateElement() const
+{
+    return MakeShared<FPCGWorldForgeLandmarksElement>();
+}
+
+bool FPCGWorldForgeLandmarksElement::ExecuteInternal(FPCGContext* Context) const
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FPCGWorldForgeLandmarksElement::Execute);
+
+    const UPCGWorldForgeLandmarksSettings* Settings = Context->GetInputSettings<UPCGWorldForgeLandmarksSettings>();
+    check(Settings);
+
+    UPCGPointData* PointData = FPCGContext::NewObject_AnyThread<UPCGPointData>(Context);
+    Context->OutputData.TaggedData.Emplace_GetRef().Data = PointData;
+
+    const UPCGComponent* Component = Context->SourceComponent.Get();
+    const UWorldForgeSubsystem* Subsystem = WorldForgePCG::GetSubsystem(Component);
+    if (!Subsystem)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("WorldForge: PCG landmarks node has no WorldForge subsystem; outputting no points"));
+        return true;
+    }
+
+    const bool bIncludeType[] = { Settings->bIncludeSettlements, Settings->bIncludeFortresses, Settings->bIncludeMonasteries,
+                                  Settings->bIncludeRuins, Settings->bIncludeNatural };
+
+    // Partition cells only look up the landmarks around their own bounds
+    TArray<FWorldForgeSpatialEntry> Landmarks;
+    if (Settings->bClipToComponentBounds && Component)
+    {
+        const FBox Bounds = Component->GetGridBounds();
+        const FVector2D Min(Bounds.Min);
+        const FVector2D Max(Bounds.Max);
+
+        TArray<const FWorldForgeSpatialEntry*> Entries;
+        Subsystem->GetSpatialIndex().QueryRadius(Bounds.GetCenter(), static_cast<float>(0.5 * FVector2D::Distance(Min, Max)), Entries);
+        for (const FWorldForgeSpatialEntry* Entry : Entries)
+        {
+            if (Entry->Location.X >= Min.X && Entry->Location.X < Max.X && Entry->Location.Y >= Min.Y && Entry->Location.Y < Max.Y)
+            {
+                Landmarks.Add(*Entry);
+            }
+        }
+
+        // Entries come back unordered; sort so the points (and anything seeded from them) are stable
+        Landmarks.Sort([](const FWorldForgeSpatialEntry& A, const FWorldForgeSpatialEntry& B) { return A.Id < B.Id; });
+    }
+    else
+    {
+        for (const FWorldForgeLandmark& Landmark : Subsystem->GetWorldState().Landmarks)
+        {
+            Landmarks.Add({ Landmark.Id, Landmark.Name, Landmark.Type, Landmark.Location });
+        }
+    }
+
+    UPCGMetadata* Metadata = PointData->Metadata;
+    FPCGMetadataAttribute<FString>* IdAttribute = Metadata->CreateAttribute<FString>(TEXT("LandmarkId"), FString(), false, true);
+    FPCGMetadataAttribute<FString>* NameAttribute = Metadata->CreateAttribute<FString>(TEXT("LandmarkName"), FString(), false, true);
+    FPCGMetadataAttribute<int32>* TypeAttribute = Metadata->CreateAttribute<int32>(TEXT("LandmarkType"), 0, false, true);
+
+    const FVector Extent(Settings->PointExtent);
+    TArray<FPCGPoint>& Points = PointData->GetMutablePoints();
+    Points.Reserve(Landmarks.Num());
+    for (const FWorldForgeSpatialEntry& Landmark : Landmarks)
+    {
+        if (!bIncludeType[static_cast<int32>(Landmark.Type)])
+        {
+            continue;
+        }
+
+        FPCGPoint& Point = Points.Emplace_GetRef(FTransform(Landmark.Location), 1.0f, static_cast<int32>(GetTypeHash(Landmark.Id)));
+        Point.BoundsMin = -Extent;
+        Point.BoundsMax = Extent;
+        Point.MetadataEntry = Metadata->AddEntry();
+        IdAttribute->SetValue(Point.MetadataEntry, Landmark.Id);
+        NameAttribute->SetValue(Point.MetadataEntry, Landmark.Name);
+        TypeAttribute->SetValue(Point.MetadataEntry, static_cast<int32>(Landmark.Type));
+    }
+
+    return true;
+}
+
+#if WITH_EDITOR
+FText UPCGWorldForgeStateSettings::GetDefaultNodeTitle() const
+{
+    return LOCTEXT("StateNodeTitle", "WorldForge State");
+}
+
+FText UPCGWorldForgeStateSettings::GetNodeTooltipText() const
+{
+    return LOCTEXT("StateNodeTooltip", "The WorldForge traits, atmosphere, seed and era, and the scatter density per layer, as an attribute set.");
+}
+#endif
+
+TArray<FPCGPinProperties> UPCGWorldForgeStateSettings::OutputPinProperties() const
+{
+    TArray<FPCGPinProperties> PinProperties;
+    PinProperties.Emplace(PCGPinConstants::DefaultOutputLabel, EPCGDataType::Param);
+    return PinProperties;
+}
+
+FPCGElementPtr UPCGWorldForgeStateSettings::CreateElement() const
+{
+    return MakeShared<FPCGWorldForgeStateElement>();
+}
+
+bool FPCGWorldForgeStateElement::ExecuteInternal(FPCGContext* Context) const
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FPCGWorldForgeStateElement::Execute);
+
+    UPCGParamData* ParamData = FPCGContext::NewObject_AnyThread<UPCGParamData>(Context);
+    Context->OutputData.TaggedData.Emplace_GetRef().Data = ParamData;
+
+    // Outside a game world the defaults of FWorldForgeState are output, so graphs still preview in the editor
+    const UWorldForgeSubsystem* Subsystem = WorldForgePCG::GetSubsystem(Context->SourceComponent.Get());
+    const FWorldForgeState State = Subsystem ? Subsystem->GetWorldState() : FWorldForgeState();
+
+    UPCGMetadata* Metadata = ParamData->Metadata;
+    const PCGMetadataEntryKey Entry = Metadata->AddEntry();
+
+    static const TCHAR* TraitNames[] = { TEXT("Militarism"), TEXT("Prosperity"), TEXT("Religiosity"), TEXT("Lawfulness"), TEXT("Openness") };
+    for (int32 Trait = 0; Trait < UE_ARRAY_COUNT(TraitNames); ++Trait)
+    {
+        const float Value = State.GetTrait(static_cast<EWorldForgeTrait>(Trait));
+        Metadata->CreateAttribute<float>(TraitNames[Trait], Value, true, false)->SetValue(Entry, Value);
+    }
+
+    const int32 Atmosphere = static_cast<int32>(State.Atmosphere);
+    Metadata->CreateAttribute<int32>(TEXT("Atmosphere"), Atmosphere, false, false)->SetValue(Entry, Atmosphere);
+    Metadata->CreateAttribute<int32>(TEXT("Seed"), State.Seed, false, false)->SetValue(Entry, State.Seed);
+    Metadata->CreateAttribute<FString>(TEXT("EraId"), State.Era.Id, false, false)->SetValue(Entry, State.Era.Id);
+
+    // Same density rules as the built-in scatter, so PCG-authored vegetation follows the traits identically
+    TArray<FWorldForgeScatterLayerParams> Layers;
+    FWorldForgeScatter::MakeLayers(State, Layers);
+    for (int32 Layer = 0; Layer < Layers.Num(); ++Layer)
+    {
+        const FName Name(*FString::Printf(TEXT("%sDensity"), WorldForgePCG::GetScatterLayerName(Layer)));
+        Metadata->CreateAttribute<float>(Name, Layers[Layer].Density, true, false)->SetValue(Entry, Layers[Layer].Density);
+    }
+
+    return true;
+}
+
+#undef LOCTEXT_NAMESPACE
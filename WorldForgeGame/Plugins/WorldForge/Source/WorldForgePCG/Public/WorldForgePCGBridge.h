@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldForgeTypes.h"
+#include "WorldForgePCGBridge.generated.h"
+
+class UPCGComponent;
+class UPCGGraph;
+
+/**
+ * Keeps PCG generation in step with live WorldForge state changes (protocol commands, spawns, destroys)
+ * without regenerating the whole map. Changes are diffed against the last seen state and batched; then
+ * only the PCG components whose graphs use a WorldForge node and are affected are regenerated:
+ *   - trait, atmosphere, seed or era changes regenerate components that use the WorldForge State node
+ *   - landmark changes regenerate components using the WorldForge Landmarks node whose grid bounds
+ *     (plus a padding) contain an added, removed or moved landmark
+ *
+ * Partitioned graphs are refreshed per local component, so only the touched partition cells regenerate.
+ * Runtime-generated components are refreshed through the PCG subsystem. Game worlds only, including
+ * dedicated servers; nothing here depends on rendering.
+ */
+UCLASS()
+class WORLDFORGEPCG_API UWorldForgePCGBridge : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UWorldForgePCGBridge, STATGROUP_Tickables); }
+
+    /** Regenerate every WorldForge-driven PCG component on the next tick */
+    UFUNCTION(BlueprintCallable, Category = "WorldForge|PCG")
+    void RefreshAll();
+
+    /** PCG components regenerated since begin play */
+    UFUNCTION(BlueprintPure, Category = "WorldForge|PCG")
+    int32 GetRegeneratedCount() const { return RegeneratedCount; }
+
+private:
+    UFUNCTION()
+    void HandleWorldStateChanged(const FWorldForgeState& NewState);
+
+    /** Which WorldForge nodes a graph uses */
+    enum EGraphUsage : uint8
+    {
+        UsesNone = 0,
+        UsesLandmarks = 1 << 0,
+        UsesState = 1 << 1
+    };
+
+    static uint8 GetGraphUsage(const UPCGGraph* Graph);
+
+    void RegenerateComponent(UPCGComponent* Component);
+
+    /** Last seen landmark locations and state, for diffing */
+    TMap<FString, FVector> LandmarkSnapshot;
+    FWorldForgeState StateSnapshot;
+
+    /** Changes waiting for the next refresh */
+    TArray<FVector> DirtyLocations;
+    bool bStateDirty = false;
+    bool bRefreshAll = false;
+
+    float RefreshTimer = 0.0f;
+    int32 RegeneratedCount = 0;
+};
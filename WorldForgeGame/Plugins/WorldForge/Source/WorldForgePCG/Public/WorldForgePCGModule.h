@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+/**
+ * PCG integration for WorldForge: graph nodes that read the world state, and the bridge that
+ * regenerates the PCG components affected by live world state changes.
+ */
+class FWorldForgePCGModule : public IModuleInterface
+{
+public:
+    /** IModuleInterface implementation */
+    virtual void StartupModule() override;
+    virtual void ShutdownModule() override;
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PCGSettings.h"
+#include "WorldForgePCGNodes.generated.h"
+
+/**
+ * Landmarks from the running WorldForge subsystem as PCG points.
+ * With bClipToComponentBounds (the default) each partition cell of a partitioned or hierarchical graph
+ * only receives the landmarks inside its own grid bounds, found through the subsystem's spatial index.
+ *
+ * Point attributes: LandmarkId (string), LandmarkName (string), LandmarkType (int, EWorldForgeLandmarkType).
+ */
+UCLASS(BlueprintType, ClassGroup = (Procedural))
+class WORLDFORGEPCG_API UPCGWorldForgeLandmarksSettings : public UPCGSettings
+{
+    GENERATED_BODY()
+
+public:
+#if WITH_EDITOR
+    virtual FName GetDefaultNodeName() const override { return FName(TEXT("WorldForgeLandmarks")); }
+    virtual FText GetDefaultNodeTitle() const override;
+    virtual FText GetNodeTooltipText() const override;
+    virtual EPCGSettingsType GetType() const override { return EPCGSettingsType::Spatial; }
+#endif
+
+protected:
+    virtual TArray<FPCGPinProperties> InputPinProperties() const override { return TArray<FPCGPinProperties>(); }
+    virtual TArray<FPCGPinProperties> OutputPinProperties() const override;
+    virtual FPCGElementPtr CreateElement() const override;
+
+public:
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings", meta = (PCG_Overridable))
+    bool bIncludeSettlements = true;
+
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings", meta = (PCG_Overridable))
+    bool bIncludeFortresses = true;
+
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings", meta = (PCG_Overridable))
+    bool bIncludeMonasteries = true;
+
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings", meta = (PCG_Overridable))
+    bool bIncludeRuins = true;
+
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings", meta = (PCG_Overridable))
+    bool bIncludeNatural = true;
+
+    /** Only output landmarks inside the executing component's grid bounds */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings", meta = (PCG_Overridable))
+    bool bClipToComponentBounds = true;
+
+    /** Half size of each output point's bounds */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings", meta = (PCG_Overridable, ClampMin = "0"))
+    float PointExtent = 500.0f;
+};
+
+/**
+ * World traits, atmosphere, seed and era from the running WorldForge subsystem as a single-entry attribute set,
+ * together with the scatter density the trait rules resolve to for each scatter layer.
+ *
+ * Attributes: Militarism, Prosperity, Religiosity, Lawfulness, Openness (float), Atmosphere (int,
+ * EWorldForgeAtmosphere), Seed (int), EraId (string), and <Layer>Density (float, instances per hectare).
+ */
+UCLASS(BlueprintType, ClassGroup = (Procedural))
+class WORLDFORGEPCG_API UPCGWorldForgeStateSettings : public UPCGSettings
+{
+    GENERATED_BODY()
+
+public:
+#if WITH_EDITOR
+    virtual FName GetDefaultNodeName() const override { return FName(TEXT("WorldForgeState")); }
+    virtual FText GetDefaultNodeTitle() const override;
+    virtual FText GetNodeTooltipText() const override;
+    virtual EPCGSettingsType GetType() const override { return EPCGSettingsType::Param; }
+#endif
+
+protected:
+    virtual TArray<FPCGPinProperties> InputPinProperties() const override { return TArray<FPCGPinProperties>(); }
+    virtual TArray<FPCGPinProperties> OutputPinProperties() const override;
+    virtual FPCGElementPtr CreateElement() const override;
+};
+
+/**
+ * Both elements read the game-thread subsystem and depend on state outside the graph,
+ * so they run on the main thread and are never cached.
+ */
+class FPCGWorldForgeLandmarksElement : public IPCGElement
+{
+public:
+    virtual bool CanExecuteOnlyOnMainThread(FPCGContext* Context) const override { return true; }
+    virtual bool IsCacheable(const UPCGSettings* InSettings) const override { return false; }
+
+protected:
+    virtual bool ExecuteInternal(FPCGContext* Context) const override;
+};
+
+class FPCGWorldForgeStateElement : public IPCGElement
+{
+public:
+    virtual bool CanExecuteOnlyOnMainThread(FPCGContext* Context) const override { return true; }
+    virtual bool IsCacheable(const UPCGSettings* InSettings) const override { return false; }
+
+protected:
+    virtual bool ExecuteInternal(FPCGContext* Context) const override;
+};
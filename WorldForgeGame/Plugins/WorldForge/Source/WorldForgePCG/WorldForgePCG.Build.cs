@@ -0,0 +1,20 @@
+using UnrealBuildTool;
+
+public class WorldForgePCG : ModuleRules
+{
+    public WorldForgePCG(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "CoreUObject",
+                "Engine",
+                "PCG",
+                "WorldForge"
+            }
+        );
+    }
+}
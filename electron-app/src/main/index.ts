@@ -7,6 +7,8 @@ import Anthropic from '@anthropic-ai/sdk'
 import Replicate from 'replicate'
 import { config } from 'dotenv'
 import { getSeededPlaceholderFilename } from '../shared/placeholder-images'
+import { HybridClock, randomNodeId } from '../shared/hlc'
+import type { WorldDelta } from '../shared/types'
 
 // ============================================================================
 // Configuration
@@ -73,6 +75,10 @@ let anthropic: Anthropic | null = null
 let replicate: Replicate | null = null
 let useMockImages = false
 let ue5Socket: net.Socket | null = null
+let ue5Received = ''
+
+/** Stamps this client's edits; UE5 merges edits from several clients by these stamps */
+const ue5Clock = new HybridClock(randomNodeId())
 
 // ============================================================================
 // Service Initialization
@@ -330,6 +336,34 @@ async function handleGenerateImage(
   }
 }
 
+// ============================================================================
+// UE5 Bridge
+// ============================================================================
+
+/**
+ * Advance the clock past the stamps of merged edits UE5 sends, so later local edits win over them,
+ * and forward the edits to the renderer so its world matches UE5's
+ */
+function observeUE5Stamps(data: string): void {
+  ue5Received += data
+  const lines = ue5Received.split('\n')
+  ue5Received = lines.pop() ?? ''
+
+  for (const line of lines) {
+    try {
+      const message = JSON.parse(line) as Partial<WorldDelta>
+      if (message.type === 'WORLD_DELTA') {
+        for (const op of message.ops ?? []) {
+          if (op.hlc) ue5Clock.observe(op.hlc)
+        }
+        mainWindow?.webContents.send('ue5:world-delta', message)
+      }
+    } catch {
+      // Not JSON; nothing to observe
+    }
+  }
+}
+
 // ============================================================================
 // IPC Handlers
 // ============================================================================
@@ -369,12 +403,14 @@ function registerIpcHandlers(): void {
       socket.connect(port, host, () => {
         clearTimeout(timeout)
         ue5Socket = socket
+        ue5Received = ''
         console.log('Connected to UE5')
         resolve({ success: true })
       })
 
       socket.on('data', (data) => {
         console.log('UE5 response:', data.toString())
+        observeUE5Stamps(data.toString())
       })
 
       socket.on('error', (err) => {
@@ -397,7 +433,8 @@ function registerIpcHandlers(): void {
     }
 
     try {
-      const json = JSON.stringify(command) + '\n'
+      // Stamped so UE5 can merge it with concurrent edits from other clients
+      const json = JSON.stringify({ ...command, hlc: ue5Clock.tick() }) + '\n'
       console.log('Sending to UE5:', json.trim())
       ue5Socket.write(json)
       return { success: true }
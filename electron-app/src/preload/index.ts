@@ -1,4 +1,5 @@
-import { contextBridge, ipcRenderer } from 'electron'
+import { contextBridge, ipcRenderer, type IpcRendererEvent } from 'electron'
+import type { WorldDelta } from '../shared/types'
 
 // ============================================================================
 // Types
@@ -66,6 +67,13 @@ const worldforgeAPI = {
   sendToUE5: (command: object): Promise<UE5Result> =>
     ipcRenderer.invoke('ue5:send-command', command),
 
+  /** Listen for the edits UE5 merged; returns a function that stops listening */
+  onWorldDelta: (listener: (delta: WorldDelta) => void): (() => void) => {
+    const handler = (_event: IpcRendererEvent, delta: WorldDelta) => listener(delta)
+    ipcRenderer.on('ue5:world-delta', handler)
+    return () => ipcRenderer.removeListener('ue5:world-delta', handler)
+  },
+
   // Platform info
   platform: process.platform,
 }
@@ -3,7 +3,10 @@ import { render, screen, fireEvent } from '@testing-library/react'
 import App from './App'
 import { useWorldStore } from './stores/worldStore'
 import { useDebugStore } from './stores/debugStore'
-import { mockEra } from '../test/fixtures'
+import { useUE5BridgeStore } from './services/ue5-bridge'
+import { mockEra, mockDilemma } from '../test/fixtures'
+import { mockWorldforge } from '../test/setup'
+import type { WorldDelta } from '../shared/types'
 
 // Mock child components to isolate App testing
 vi.mock('./components/EraSelector', () => ({
@@ -35,6 +38,7 @@ describe('App', () => {
     vi.clearAllMocks()
     useWorldStore.getState().resetWorld()
     useDebugStore.setState({ logs: [], nextId: 1 })
+    useUE5BridgeStore.getState()._reset()
   })
 
   describe('initial rendering', () => {
@@ -203,6 +207,49 @@ describe('App', () => {
     })
   })
 
+  describe('UE5 sync', () => {
+    beforeEach(() => {
+      useUE5BridgeStore.setState({ status: 'connected' })
+      mockWorldforge.sendToUE5.mockResolvedValue({ success: true })
+    })
+
+    it('should send only the traits the user changed', () => {
+      render(<App />)
+      useWorldStore.getState().updateTraits({ militarism: 0.8 })
+
+      expect(mockWorldforge.sendToUE5).toHaveBeenCalledTimes(1)
+      expect(mockWorldforge.sendToUE5).toHaveBeenCalledWith({ type: 'SET_TRAIT', trait: 'militarism', value: 0.8 })
+    })
+
+    it('should send an atmosphere change on its own', () => {
+      render(<App />)
+      useWorldStore.getState().setAtmosphere('sacred')
+
+      expect(mockWorldforge.sendToUE5).toHaveBeenCalledTimes(1)
+      expect(mockWorldforge.sendToUE5).toHaveBeenCalledWith({ type: 'SET_ATMOSPHERE', atmosphere: 'sacred' })
+    })
+
+    it('should leave a tarot choice to its COMMIT_OUTCOME', () => {
+      render(<App />)
+      useWorldStore.getState().recordChoice(mockDilemma, 'A')
+
+      expect(mockWorldforge.sendToUE5).not.toHaveBeenCalled()
+    })
+
+    it('should merge deltas from UE5 without sending them back', () => {
+      render(<App />)
+      const listener = mockWorldforge.onWorldDelta.mock.calls[0][0] as (delta: WorldDelta) => void
+      listener({
+        type: 'WORLD_DELTA',
+        origin: 2,
+        ops: [{ hlc: { wall: 1, counter: 0, node: 3 }, op: 'trait', trait: 'prosperity', value: 0.1 }],
+      })
+
+      expect(useWorldStore.getState().traits.prosperity).toBe(0.1)
+      expect(mockWorldforge.sendToUE5).not.toHaveBeenCalled()
+    })
+  })
+
   describe('ErrorBoundary', () => {
     // ErrorBoundary is difficult to test directly, but we can verify it renders children
     it('should render children when no error occurs', () => {
@@ -157,41 +157,47 @@ function App() {
   // --------------------------------------------------------------------------
 
   useEffect(() => {
-    // Subscribe to worldStore changes and sync to UE5
+    // Subscribe to worldStore changes and send the fields the user changed to UE5
     const unsubscribe = useWorldStore.subscribe((state, prevState) => {
-      const { syncWorldState } = useUE5BridgeStore.getState()
-      const ue5Status = useUE5BridgeStore.getState().status
+      const { sendCommand, setTrait, setAtmosphere, status } = useUE5BridgeStore.getState()
 
-      // Only sync if connected to UE5
-      if (ue5Status !== 'connected') return
+      // Only sync if connected to UE5, and never echo back edits UE5 sent; a choice goes as its COMMIT_OUTCOME,
+      // so undo reverses it in one step
+      if (status !== 'connected' || state.changeSource !== 'local') return
 
-      // Check if traits changed
-      const traitsChanged = Object.keys(state.traits).some(
-        (key) => state.traits[key as keyof typeof state.traits] !== prevState.traits[key as keyof typeof prevState.traits]
-      )
+      // A whole-world sync would overwrite fields other designers edited since, so each field is sent on its own
+      if (state.era && state.era.id !== prevState.era?.id) {
+        debugLog.info(`Era changed to ${state.era.name}, syncing to UE5`)
+        sendCommand({ type: 'SET_ERA', era: state.era })
+      }
+
+      for (const trait of Object.keys(state.traits) as (keyof typeof state.traits)[]) {
+        if (state.traits[trait] !== prevState.traits[trait]) {
+          setTrait(trait, state.traits[trait])
+        }
+      }
 
-      // Check if atmosphere changed
-      const atmosphereChanged = state.atmosphere !== prevState.atmosphere
-
-      // Check if era changed
-      const eraChanged = state.era?.id !== prevState.era?.id
-
-      if (traitsChanged || atmosphereChanged || eraChanged) {
-        debugLog.info('World state changed, syncing to UE5')
-        syncWorldState({
-          era: state.era,
-          traits: state.traits,
-          atmosphere: state.atmosphere,
-          choices: state.choices,
-          factions: state.factions,
-          landmarks: state.landmarks,
-        })
+      if (state.atmosphere !== prevState.atmosphere) {
+        setAtmosphere(state.atmosphere)
       }
     })
 
     return () => unsubscribe()
   }, [])
 
+  // --------------------------------------------------------------------------
+  // Merge world edits from UE5
+  // --------------------------------------------------------------------------
+
+  useEffect(() => {
+    // Edits by other designers, undo and redo reach this client only through UE5's deltas
+    const unsubscribe = window.worldforge?.onWorldDelta((delta) => {
+      useWorldStore.getState().applyWorldDelta(delta.ops)
+    })
+
+    return () => unsubscribe?.()
+  }, [])
+
   // --------------------------------------------------------------------------
   // Navigation Handlers
   // --------------------------------------------------------------------------
@@ -1,7 +1,8 @@
 import { describe, it, expect, vi, beforeEach } from 'vitest'
-import { render, screen, waitFor } from '@testing-library/react'
+import { render, screen, waitFor, fireEvent } from '@testing-library/react'
 import { TarotSpread } from './TarotSpread'
 import { useWorldStore } from '../stores/worldStore'
+import { useUE5BridgeStore } from '../services/ue5-bridge'
 import { mockEra, mockDilemma } from '../../test/fixtures'
 import { mockWorldforge } from '../../test/setup'
 
@@ -17,6 +18,7 @@ describe('TarotSpread', () => {
   beforeEach(() => {
     vi.clearAllMocks()
     useWorldStore.getState().resetWorld()
+    useUE5BridgeStore.getState()._reset()
     ;(generateDilemma as ReturnType<typeof vi.fn>).mockResolvedValue(mockDilemma)
     ;(generateImage as ReturnType<typeof vi.fn>).mockResolvedValue(null)
   })
@@ -169,6 +171,33 @@ describe('TarotSpread', () => {
     })
   })
 
+  describe('choosing', () => {
+    it('should send the choice as a single COMMIT_OUTCOME with what it changes', async () => {
+      useWorldStore.getState().setEra(mockEra)
+      useUE5BridgeStore.setState({ status: 'connected' })
+      mockWorldforge.sendToUE5.mockResolvedValue({ success: true })
+
+      render(<TarotSpread />)
+      await waitFor(() => {
+        expect(screen.getAllByText('The Conqueror').length).toBeGreaterThan(0)
+      })
+      mockWorldforge.sendToUE5.mockClear()
+
+      fireEvent.click(screen.getAllByText('The Conqueror')[0].closest('.card-flip')!)
+      fireEvent.click(screen.getAllByText('Choose This Path')[0])
+
+      expect(mockWorldforge.sendToUE5).toHaveBeenCalledTimes(1)
+      expect(mockWorldforge.sendToUE5).toHaveBeenCalledWith({
+        type: 'COMMIT_OUTCOME',
+        dilemmaId: mockDilemma.id,
+        choice: 'A',
+        traits: { militarism: 0.75, prosperity: 0.45 },
+        atmosphere: 'war_torn',
+        landmarks: [],
+      })
+    })
+  })
+
   describe('service calls', () => {
     it('should call generateDilemma with correct parameters', async () => {
       useWorldStore.getState().setEra(mockEra)
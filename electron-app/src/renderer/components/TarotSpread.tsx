@@ -1,10 +1,10 @@
 import { useState, useEffect } from 'react'
 import { TarotCard } from './TarotCard'
-import { useWorldStore } from '../stores/worldStore'
+import { useWorldStore, resolveChoice } from '../stores/worldStore'
 import { generateDilemma, generateImage } from '../services/claude'
 import { debugLog } from '../stores/debugStore'
 import { useUE5BridgeStore } from '../services/ue5-bridge'
-import type { TarotDilemma, Landmark } from '../../shared/types'
+import type { TarotDilemma, TarotChoice, OutcomeBranch, CommittedOutcome, WorldTraits } from '../../shared/types'
 import { v4 as uuidv4 } from 'uuid'
 
 // ============================================================================
@@ -143,31 +143,51 @@ async function generateChoiceImages(
 }
 
 // ============================================================================
-// Landmark Spawning
+// Outcomes
 // ============================================================================
 
+/** Give every landmark of both choices its ID up front, so prepared and committed landmarks match */
+function withLandmarkIds(dilemma: TarotDilemma): TarotDilemma {
+  const assignIds = (choice: TarotChoice): TarotChoice => ({
+    ...choice,
+    landmarks: choice.landmarks?.map((landmark) => ({ ...landmark, id: landmark.id || uuidv4() })),
+  })
+  return { ...dilemma, choiceA: assignIds(dilemma.choiceA), choiceB: assignIds(dilemma.choiceB) }
+}
+
 /**
- * Spawn landmarks from a choice's structured landmark data.
+ * Ask UE5 to pre-generate both outcomes while the player decides, so the chosen one appears
+ * without waiting for generation. Returns false when UE5 is not connected.
  */
-function spawnLandmarks(landmarks: Landmark[] | undefined): void {
-  if (!landmarks || landmarks.length === 0) return
-
-  const { spawnSettlement, status } = useUE5BridgeStore.getState()
+function prepareOutcomes(dilemma: TarotDilemma): boolean {
+  const { prepareOutcomes: sendPrepare, status } = useUE5BridgeStore.getState()
+  if (status !== 'connected') return false
+
+  const { traits, atmosphere } = useWorldStore.getState()
+  const outcomes: OutcomeBranch[] = (['A', 'B'] as const).map((choice) => {
+    const choiceData = choice === 'A' ? dilemma.choiceA : dilemma.choiceB
+    return { choice, ...resolveChoice(traits, atmosphere, choiceData), landmarks: choiceData.landmarks ?? [] }
+  })
+
+  debugLog.info(`Preparing outcomes of dilemma ${dilemma.id}`)
+  sendPrepare(dilemma.id, outcomes)
+  return true
+}
 
-  // Only spawn if connected to UE5
-  if (status !== 'connected') {
-    debugLog.info('UE5 not connected, skipping landmark spawning')
-    return
-  }
+/** What a choice changes in the current world; call before recording it */
+function commitFor(dilemma: TarotDilemma, choice: 'A' | 'B'): CommittedOutcome {
+  const { traits, atmosphere } = useWorldStore.getState()
+  const choiceData = choice === 'A' ? dilemma.choiceA : dilemma.choiceB
+  const resolved = resolveChoice(traits, atmosphere, choiceData)
+  const changedTraits = (Object.keys(resolved.traits) as (keyof WorldTraits)[]).filter(
+    (trait) => resolved.traits[trait] !== traits[trait]
+  )
 
-  for (const landmark of landmarks) {
-    // Add unique ID if not present (Claude may not include it)
-    const landmarkWithId: Landmark = {
-      ...landmark,
-      id: landmark.id || uuidv4(),
-    }
-    debugLog.info(`Spawning landmark: ${landmarkWithId.name} (${landmarkWithId.type})`)
-    spawnSettlement(landmarkWithId)
+  return {
+    choice,
+    traits: Object.fromEntries(changedTraits.map((trait) => [trait, resolved.traits[trait]])),
+    ...(resolved.atmosphere !== atmosphere && { atmosphere: resolved.atmosphere }),
+    landmarks: choiceData.landmarks ?? [],
   }
 }
 
@@ -182,6 +202,7 @@ export function TarotSpread() {
   const [isLoading, setIsLoading] = useState(false)
   const [error, setError] = useState<string | null>(null)
   const [images, setImages] = useState<ImageState>({ imageA: null, imageB: null })
+  const [preparedDilemmaId, setPreparedDilemmaId] = useState<string | null>(null)
 
   const cardNumber = choices.length + 1
 
@@ -198,8 +219,9 @@ export function TarotSpread() {
     setImages({ imageA: null, imageB: null })
 
     try {
-      const dilemma = await generateDilemma(era.id, traits, cardNumber)
+      const dilemma = withLandmarkIds(await generateDilemma(era.id, traits, cardNumber))
       setCurrentDilemma(dilemma)
+      setPreparedDilemmaId(prepareOutcomes(dilemma) ? dilemma.id : null)
 
       // Generate images in background (don't block card display)
       generateChoiceImages(
@@ -230,11 +252,20 @@ export function TarotSpread() {
     if (selectedChoice || !currentDilemma) return
 
     setSelectedChoice(choice)
+    const outcome = commitFor(currentDilemma, choice)
     recordChoice(currentDilemma, choice)
 
-    // Spawn landmarks from the selected choice
-    const selectedChoiceData = choice === 'A' ? currentDilemma.choiceA : currentDilemma.choiceB
-    spawnLandmarks(selectedChoiceData.landmarks)
+    // The whole choice is one COMMIT_OUTCOME, and so one undo step. UE5 applies the pre-generated
+    // outcome if it has it, and what the choice changes otherwise.
+    const { commitOutcome, status } = useUE5BridgeStore.getState()
+    if (status === 'connected') {
+      if (preparedDilemmaId !== currentDilemma.id) {
+        debugLog.info('Outcomes were not prepared, UE5 applies the choice as sent')
+      }
+      commitOutcome(currentDilemma.id, outcome)
+    } else {
+      debugLog.info('UE5 not connected, skipping outcome commit')
+    }
 
     // Auto-advance to next card after brief delay
     setTimeout(() => {
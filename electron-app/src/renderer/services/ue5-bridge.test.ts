@@ -209,6 +209,74 @@ describe('UE5Bridge', () => {
     })
   })
 
+  describe('prepareOutcomes', () => {
+    it('should send PREPARE_OUTCOMES command', async () => {
+      mockWorldforge.connectToUE5.mockResolvedValue({ success: true })
+      mockWorldforge.sendToUE5.mockResolvedValue({ success: true })
+
+      const outcomes = [
+        { choice: 'A' as const, traits: mockWorldState.traits, atmosphere: 'sacred' as const, landmarks: [] },
+        { choice: 'B' as const, traits: mockWorldState.traits, atmosphere: 'war_torn' as const, landmarks: [] },
+      ]
+      await ue5Bridge.connect()
+      await ue5Bridge.prepareOutcomes('dilemma-1', outcomes)
+
+      expect(mockWorldforge.sendToUE5).toHaveBeenCalledWith({
+        type: 'PREPARE_OUTCOMES',
+        dilemmaId: 'dilemma-1',
+        outcomes,
+      })
+    })
+  })
+
+  describe('commitOutcome', () => {
+    it('should send COMMIT_OUTCOME command', async () => {
+      mockWorldforge.connectToUE5.mockResolvedValue({ success: true })
+      mockWorldforge.sendToUE5.mockResolvedValue({ success: true })
+
+      await ue5Bridge.connect()
+      await ue5Bridge.commitOutcome('dilemma-1', { choice: 'B', traits: { religiosity: 0.9 }, atmosphere: 'sacred', landmarks: [] })
+
+      expect(mockWorldforge.sendToUE5).toHaveBeenCalledWith({
+        type: 'COMMIT_OUTCOME',
+        dilemmaId: 'dilemma-1',
+        choice: 'B',
+        traits: { religiosity: 0.9 },
+        atmosphere: 'sacred',
+        landmarks: [],
+      })
+    })
+  })
+
+  describe('destroySettlement', () => {
+    it('should send DESTROY_SETTLEMENT command', async () => {
+      mockWorldforge.connectToUE5.mockResolvedValue({ success: true })
+      mockWorldforge.sendToUE5.mockResolvedValue({ success: true })
+
+      await ue5Bridge.connect()
+      await ue5Bridge.destroySettlement('settlement-1')
+
+      expect(mockWorldforge.sendToUE5).toHaveBeenCalledWith({
+        type: 'DESTROY_SETTLEMENT',
+        settlementId: 'settlement-1',
+      })
+    })
+  })
+
+  describe('undo and redo', () => {
+    it('should send UNDO and REDO commands', async () => {
+      mockWorldforge.connectToUE5.mockResolvedValue({ success: true })
+      mockWorldforge.sendToUE5.mockResolvedValue({ success: true })
+
+      await ue5Bridge.connect()
+      await ue5Bridge.undo()
+      await ue5Bridge.redo()
+
+      expect(mockWorldforge.sendToUE5).toHaveBeenNthCalledWith(1, { type: 'UNDO' })
+      expect(mockWorldforge.sendToUE5).toHaveBeenNthCalledWith(2, { type: 'REDO' })
+    })
+  })
+
   describe('subscribe', () => {
     it('should call listener immediately with current state', () => {
       const listener = vi.fn()
@@ -1,5 +1,5 @@
 import { create } from 'zustand'
-import type { UE5Command, WorldState, Landmark } from '../../shared/types'
+import type { UE5Command, WorldState, Landmark, OutcomeBranch, CommittedOutcome } from '../../shared/types'
 import { debugLog } from '../stores/debugStore'
 
 // ============================================================================
@@ -38,6 +38,12 @@ interface UE5BridgeStore extends UE5BridgeState {
   setTrait: (trait: keyof WorldState['traits'], value: number) => Promise<boolean>
   setAtmosphere: (atmosphere: WorldState['atmosphere']) => Promise<boolean>
   spawnSettlement: (settlement: Landmark) => Promise<boolean>
+  destroySettlement: (settlementId: string) => Promise<boolean>
+  prepareOutcomes: (dilemmaId: string, outcomes: OutcomeBranch[]) => Promise<boolean>
+  /** UE5 applies the choice's traits, atmosphere and landmarks itself when its outcomes were not prepared */
+  commitOutcome: (dilemmaId: string, outcome: CommittedOutcome) => Promise<boolean>
+  undo: () => Promise<boolean>
+  redo: () => Promise<boolean>
 
   // For testing - reset state
   _reset: () => void
@@ -122,6 +128,30 @@ export const useUE5BridgeStore = create<UE5BridgeStore>((set, get) => ({
     return get().sendCommand({ type: 'SPAWN_SETTLEMENT', settlement })
   },
 
+  destroySettlement: async (settlementId) => {
+    debugLog.info(`Destroying settlement: ${settlementId}`)
+    return get().sendCommand({ type: 'DESTROY_SETTLEMENT', settlementId })
+  },
+
+  prepareOutcomes: async (dilemmaId, outcomes) => {
+    return get().sendCommand({ type: 'PREPARE_OUTCOMES', dilemmaId, outcomes })
+  },
+
+  commitOutcome: async (dilemmaId, outcome) => {
+    debugLog.info(`Committing outcome ${outcome.choice} of dilemma ${dilemmaId}`)
+    return get().sendCommand({ type: 'COMMIT_OUTCOME', dilemmaId, ...outcome })
+  },
+
+  undo: async () => {
+    debugLog.info('Undoing last world change')
+    return get().sendCommand({ type: 'UNDO' })
+  },
+
+  redo: async () => {
+    debugLog.info('Redoing world change')
+    return get().sendCommand({ type: 'REDO' })
+  },
+
   // --------------------------------------------------------------------------
   // Testing Helper
   // --------------------------------------------------------------------------
@@ -190,6 +220,14 @@ export const ue5Bridge = {
     useUE5BridgeStore.getState().setAtmosphere(atmosphere),
   spawnSettlement: (settlement: Landmark) =>
     useUE5BridgeStore.getState().spawnSettlement(settlement),
+  destroySettlement: (settlementId: string) =>
+    useUE5BridgeStore.getState().destroySettlement(settlementId),
+  prepareOutcomes: (dilemmaId: string, outcomes: OutcomeBranch[]) =>
+    useUE5BridgeStore.getState().prepareOutcomes(dilemmaId, outcomes),
+  commitOutcome: (dilemmaId: string, outcome: CommittedOutcome) =>
+    useUE5BridgeStore.getState().commitOutcome(dilemmaId, outcome),
+  undo: () => useUE5BridgeStore.getState().undo(),
+  redo: () => useUE5BridgeStore.getState().redo(),
   getStatus: () => useUE5BridgeStore.getState().status,
   getLastError: () => useUE5BridgeStore.getState().lastError,
   subscribe: (listener: (state: UE5BridgeState) => void) => {
@@ -147,6 +147,11 @@ describe('worldStore', () => {
       expect(useWorldStore.getState().atmosphere).toBe('vibrant')
     })
 
+    it('should mark the change as a choice, which UE5 receives as one commit', () => {
+      useWorldStore.getState().recordChoice(mockDilemma, 'B')
+      expect(useWorldStore.getState().changeSource).toBe('choice')
+    })
+
     it('should clamp trait effects to 0-1 range', () => {
       useWorldStore.getState().updateTraits({ militarism: 0.95 })
       useWorldStore.getState().recordChoice(mockDilemma, 'A') // +0.15 would be 1.1
@@ -220,6 +225,42 @@ describe('worldStore', () => {
     })
   })
 
+  describe('applyWorldDelta', () => {
+    const hlc = { wall: 1, counter: 0, node: 7 }
+    const landmark: Landmark = { id: 'l', name: 'L', type: 'ruin', description: 'test' }
+
+    it('should merge trait and atmosphere edits', () => {
+      useWorldStore.getState().applyWorldDelta([
+        { hlc, op: 'trait', trait: 'militarism', value: 0.9 },
+        { hlc, op: 'atmosphere', atmosphere: 'war_torn' },
+      ])
+
+      const state = useWorldStore.getState()
+      expect(state.traits.militarism).toBe(0.9)
+      expect(state.traits.prosperity).toBe(0.5)
+      expect(state.atmosphere).toBe('war_torn')
+    })
+
+    it('should add and remove landmarks', () => {
+      useWorldStore.getState().applyWorldDelta([{ hlc, op: 'add', landmark }])
+      expect(useWorldStore.getState().landmarks).toEqual([landmark])
+
+      useWorldStore.getState().applyWorldDelta([{ hlc, op: 'add', landmark }])
+      expect(useWorldStore.getState().landmarks).toEqual([landmark])
+
+      useWorldStore.getState().applyWorldDelta([{ hlc, op: 'remove', id: 'l', tags: [hlc] }])
+      expect(useWorldStore.getState().landmarks).toEqual([])
+    })
+
+    it('should mark the change as remote until the next local edit', () => {
+      useWorldStore.getState().applyWorldDelta([{ hlc, op: 'trait', trait: 'openness', value: 0.2 }])
+      expect(useWorldStore.getState().changeSource).toBe('remote')
+
+      useWorldStore.getState().updateTraits({ openness: 0.4 })
+      expect(useWorldStore.getState().changeSource).toBe('local')
+    })
+  })
+
   describe('exportWorldState', () => {
     it('should return current world state', () => {
       useWorldStore.getState().setEra(mockEra)
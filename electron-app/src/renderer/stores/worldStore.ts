@@ -1,5 +1,5 @@
 import { create } from 'zustand'
-import type { Era, WorldTraits, WorldState, TarotDilemma, Faction, Landmark, Atmosphere } from '../../shared/types'
+import type { Era, WorldTraits, WorldState, TarotDilemma, TarotChoice, Faction, Landmark, Atmosphere, WorldDeltaOp } from '../../shared/types'
 
 // ============================================================================
 // Constants
@@ -64,11 +64,58 @@ function applyTraitEffects(
   return newTraits
 }
 
+/** Traits and atmosphere the world would have after a choice, without recording it */
+export function resolveChoice(
+  traits: WorldTraits,
+  atmosphere: Atmosphere,
+  choice: TarotChoice
+): { traits: WorldTraits; atmosphere: Atmosphere } {
+  const updatedTraits = applyTraitEffects(traits, choice.traitEffects)
+  return { traits: updatedTraits, atmosphere: determineAtmosphere(updatedTraits, atmosphere) }
+}
+
+/** Merge the edits UE5 accepted into a world; UE5 already resolved their order, so each simply applies */
+function applyDeltaOps(state: WorldState, ops: WorldDeltaOp[]): Partial<WorldState> {
+  let traits = state.traits
+  let atmosphere = state.atmosphere
+  let landmarks = state.landmarks
+
+  for (const op of ops) {
+    switch (op.op) {
+      case 'trait':
+        traits = { ...traits, [op.trait]: clampTrait(op.value) }
+        break
+      case 'atmosphere':
+        atmosphere = op.atmosphere
+        break
+      case 'add':
+        landmarks = [...landmarks.filter((landmark) => landmark.id !== op.landmark.id), op.landmark]
+        break
+      case 'remove':
+        landmarks = landmarks.filter((landmark) => landmark.id !== op.id)
+        break
+      // Eras are picked from the era list, which UE5 does not know; the seed is UE5's own
+      case 'era':
+      case 'seed':
+        break
+    }
+  }
+
+  return { traits, atmosphere, landmarks }
+}
+
 // ============================================================================
 // Store Interface
 // ============================================================================
 
+/**
+ * Where the last change came from: the user here, a tarot choice UE5 applies as one COMMIT_OUTCOME,
+ * or UE5 merging edits that are already in its world
+ */
+export type ChangeSource = 'local' | 'choice' | 'remote'
+
 interface WorldStore extends WorldState {
+  changeSource: ChangeSource
   setEra: (era: Era) => void
   updateTraits: (traits: Partial<WorldTraits>) => void
   /** Record a choice. Timestamp is injectable for testing (defaults to Date.now()). */
@@ -77,6 +124,8 @@ interface WorldStore extends WorldState {
   addLandmark: (landmark: Landmark) => void
   setAtmosphere: (atmosphere: Atmosphere) => void
   resetWorld: () => void
+  /** Merge edits UE5 broadcast, from this client or others */
+  applyWorldDelta: (ops: WorldDeltaOp[]) => void
   exportWorldState: () => WorldState
 }
 
@@ -95,6 +144,7 @@ const INITIAL_STATE: WorldState = {
 
 export const useWorldStore = create<WorldStore>((set, get) => ({
   ...INITIAL_STATE,
+  changeSource: 'local',
 
   setEra: (era) => {
     const traitsWithEraDefaults = { ...DEFAULT_TRAITS, ...era.baseTraits }
@@ -105,6 +155,7 @@ export const useWorldStore = create<WorldStore>((set, get) => ({
       factions: [],
       landmarks: [],
       atmosphere: 'mysterious',
+      changeSource: 'local',
     })
   },
 
@@ -118,6 +169,7 @@ export const useWorldStore = create<WorldStore>((set, get) => ({
       )
       return {
         traits: { ...state.traits, ...clampedUpdates } as WorldTraits,
+        changeSource: 'local',
       }
     })
   },
@@ -134,6 +186,7 @@ export const useWorldStore = create<WorldStore>((set, get) => ({
         traits: updatedTraits,
         choices: [...state.choices, choiceRecord],
         atmosphere: newAtmosphere,
+        changeSource: 'choice',
       }
     })
   },
@@ -141,21 +194,27 @@ export const useWorldStore = create<WorldStore>((set, get) => ({
   addFaction: (faction) => {
     set((state) => ({
       factions: [...state.factions, faction],
+      changeSource: 'local',
     }))
   },
 
   addLandmark: (landmark) => {
     set((state) => ({
       landmarks: [...state.landmarks, landmark],
+      changeSource: 'local',
     }))
   },
 
   setAtmosphere: (atmosphere) => {
-    set({ atmosphere })
+    set({ atmosphere, changeSource: 'local' })
   },
 
   resetWorld: () => {
-    set(INITIAL_STATE)
+    set({ ...INITIAL_STATE, changeSource: 'local' })
+  },
+
+  applyWorldDelta: (ops) => {
+    set((state) => ({ ...applyDeltaOps(state, ops), changeSource: 'remote' }))
   },
 
   exportWorldState: () => {
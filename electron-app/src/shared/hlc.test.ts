@@ -0,0 +1,52 @@
+import { describe, it, expect } from 'vitest'
+import { HybridClock, compareHlc, randomNodeId } from './hlc'
+
+describe('hlc', () => {
+  describe('compareHlc', () => {
+    it('should order by wall time, then counter, then node', () => {
+      expect(compareHlc({ wall: 1, counter: 5, node: 9 }, { wall: 2, counter: 0, node: 1 })).toBeLessThan(0)
+      expect(compareHlc({ wall: 2, counter: 1, node: 1 }, { wall: 2, counter: 0, node: 9 })).toBeGreaterThan(0)
+      expect(compareHlc({ wall: 2, counter: 1, node: 1 }, { wall: 2, counter: 1, node: 2 })).toBeLessThan(0)
+      expect(compareHlc({ wall: 2, counter: 1, node: 1 }, { wall: 2, counter: 1, node: 1 })).toBe(0)
+    })
+  })
+
+  describe('randomNodeId', () => {
+    it('should return a positive 32-bit ID', () => {
+      const node = randomNodeId()
+      expect(node).toBeGreaterThan(0)
+      expect(node).toBeLessThanOrEqual(0xffffffff)
+    })
+  })
+
+  describe('HybridClock', () => {
+    it('should follow wall-clock time', () => {
+      let now = 1000
+      const clock = new HybridClock(7, () => now)
+      expect(clock.tick()).toEqual({ wall: 1000, counter: 0, node: 7 })
+      now = 1005
+      expect(clock.tick()).toEqual({ wall: 1005, counter: 0, node: 7 })
+    })
+
+    it('should count up within the same millisecond or when time goes back', () => {
+      let now = 1000
+      const clock = new HybridClock(7, () => now)
+      const first = clock.tick()
+      const second = clock.tick()
+      now = 900
+      const third = clock.tick()
+      expect(compareHlc(second, first)).toBeGreaterThan(0)
+      expect(compareHlc(third, second)).toBeGreaterThan(0)
+      expect(third.wall).toBe(1000)
+    })
+
+    it('should stamp after an observed stamp from a faster clock', () => {
+      const clock = new HybridClock(1, () => 1000)
+      const remote = { wall: 5000, counter: 3, node: 2 }
+      clock.observe(remote)
+      const next = clock.tick()
+      expect(compareHlc(next, remote)).toBeGreaterThan(0)
+      expect(next.wall).toBe(5000)
+    })
+  })
+})
@@ -0,0 +1,62 @@
+/**
+ * Hybrid logical clock for stamping edits sent to UE5
+ *
+ * UE5 merges concurrent edits from several clients by these stamps: the latest
+ * write to a field wins. A stamp is later than every stamp this client issued or
+ * observed, and stays close to wall-clock time.
+ */
+
+/** Wall-clock milliseconds, a counter within the same millisecond, and the issuing node */
+export interface Hlc {
+  wall: number
+  counter: number
+  node: number
+}
+
+/** Order two stamps: negative if a is earlier, positive if later, 0 if equal */
+export function compareHlc(a: Hlc, b: Hlc): number {
+  if (a.wall !== b.wall) return a.wall - b.wall
+  if (a.counter !== b.counter) return a.counter - b.counter
+  return a.node - b.node
+}
+
+/** A random node ID, so stamps from different clients never tie */
+export function randomNodeId(): number {
+  return Math.floor(Math.random() * 0xfffffffe) + 1
+}
+
+export class HybridClock {
+  private last: Hlc
+
+  constructor(
+    readonly node: number,
+    private readonly now: () => number = Date.now
+  ) {
+    this.last = { wall: 0, counter: 0, node }
+  }
+
+  /** Stamp a local edit */
+  tick(): Hlc {
+    const physical = this.now()
+    if (physical > this.last.wall) {
+      this.last = { wall: physical, counter: 0, node: this.node }
+    } else {
+      this.last = { wall: this.last.wall, counter: this.last.counter + 1, node: this.node }
+    }
+    return this.last
+  }
+
+  /** Advance past a stamp received from UE5 or another client */
+  observe(remote: Hlc): void {
+    const wall = Math.max(this.last.wall, remote.wall, this.now())
+    let counter = 0
+    if (wall === this.last.wall && wall === remote.wall) {
+      counter = Math.max(this.last.counter, remote.counter) + 1
+    } else if (wall === this.last.wall) {
+      counter = this.last.counter + 1
+    } else if (wall === remote.wall) {
+      counter = remote.counter + 1
+    }
+    this.last = { wall, counter, node: this.node }
+  }
+}
@@ -210,5 +210,55 @@ describe('Type Definitions', () => {
       }
       expect(command.type).toBe('SYNC_WORLD_STATE')
     })
+
+    it('should support SIMULATE_HISTORY and CANCEL_HISTORY commands', () => {
+      const simulate: UE5Command = { type: 'SIMULATE_HISTORY', years: 300 }
+      const cancel: UE5Command = { type: 'CANCEL_HISTORY' }
+      expect(simulate.type).toBe('SIMULATE_HISTORY')
+      expect(cancel.type).toBe('CANCEL_HISTORY')
+    })
+
+    it('should support PREPARE_OUTCOMES and COMMIT_OUTCOME commands', () => {
+      const prepare: UE5Command = {
+        type: 'PREPARE_OUTCOMES',
+        dilemmaId: 'dilemma-1',
+        outcomes: [
+          {
+            choice: 'A',
+            traits: {
+              militarism: 0.7,
+              prosperity: 0.5,
+              religiosity: 0.5,
+              lawfulness: 0.5,
+              openness: 0.5,
+            },
+            atmosphere: 'war_torn',
+            landmarks: [],
+          },
+        ],
+      }
+      const commit: UE5Command = {
+        type: 'COMMIT_OUTCOME',
+        dilemmaId: 'dilemma-1',
+        choice: 'A',
+        traits: { militarism: 0.7 },
+        atmosphere: 'war_torn',
+        landmarks: [],
+      }
+      expect(prepare.type).toBe('PREPARE_OUTCOMES')
+      expect(commit.type).toBe('COMMIT_OUTCOME')
+    })
+
+    it('should support UNDO and REDO commands', () => {
+      const undo: UE5Command = { type: 'UNDO' }
+      const redo: UE5Command = { type: 'REDO' }
+      expect(undo.type).toBe('UNDO')
+      expect(redo.type).toBe('REDO')
+    })
+
+    it('should support DESTROY_SETTLEMENT command', () => {
+      const command: UE5Command = { type: 'DESTROY_SETTLEMENT', settlementId: 'settlement-1' }
+      expect(command.type).toBe('DESTROY_SETTLEMENT')
+    })
   })
 })
@@ -1,3 +1,5 @@
+import type { Hlc } from './hlc'
+
 // ============================================================================
 // World Traits
 // ============================================================================
@@ -121,12 +123,55 @@ export interface WorldState {
 // UE5 Integration
 // ============================================================================
 
+/** An edit UE5 merged, stamped with the hybrid logical clock time it was made at */
+export type WorldDeltaOp = { hlc: Hlc } & (
+  | { op: 'era'; era: Pick<Era, 'id' | 'name' | 'period' | 'description'> }
+  | { op: 'seed'; seed: number }
+  | { op: 'trait'; trait: keyof WorldTraits; value: number }
+  | { op: 'atmosphere'; atmosphere: Atmosphere }
+  | { op: 'add'; landmark: Landmark }
+  | { op: 'remove'; id: string; tags: Hlc[] }
+)
+
+/** The edits UE5 merged while handling one command, sent to every client */
+export interface WorldDelta {
+  type: 'WORLD_DELTA'
+  /** Session whose command caused the edits, 0 for edits UE5 made itself */
+  origin: number
+  ops: WorldDeltaOp[]
+}
+
+/** A dilemma choice as UE5 pre-generates it: the world after the choice and the landmarks it founds */
+export interface OutcomeBranch {
+  choice: 'A' | 'B'
+  traits: WorldTraits
+  atmosphere: Atmosphere
+  landmarks: Landmark[]
+}
+
+/** The choice the player made and what it changes, so UE5 can apply it even without prepared outcomes */
+export interface CommittedOutcome {
+  choice: 'A' | 'B'
+  /** Only the traits the choice changes, at their values after it */
+  traits: Partial<WorldTraits>
+  /** Present when the choice changes the atmosphere */
+  atmosphere?: Atmosphere
+  landmarks: Landmark[]
+}
+
 /** Commands that can be sent to Unreal Engine 5 */
 export type UE5Command =
   | { type: 'SET_ERA'; era: Era }
   | { type: 'SET_TRAIT'; trait: keyof WorldTraits; value: number }
   | { type: 'SPAWN_SETTLEMENT'; settlement: Landmark }
+  | { type: 'DESTROY_SETTLEMENT'; settlementId: string }
   | { type: 'SET_ATMOSPHERE'; atmosphere: Atmosphere }
   | { type: 'ADD_FACTION'; faction: Faction }
   | { type: 'PLACE_LANDMARK'; landmark: Landmark }
   | { type: 'SYNC_WORLD_STATE'; state: WorldState }
+  | { type: 'SIMULATE_HISTORY'; years: number }
+  | { type: 'CANCEL_HISTORY' }
+  | { type: 'PREPARE_OUTCOMES'; dilemmaId: string; outcomes: OutcomeBranch[] }
+  | ({ type: 'COMMIT_OUTCOME'; dilemmaId: string } & CommittedOutcome)
+  | { type: 'UNDO' }
+  | { type: 'REDO' }
@@ -8,6 +8,7 @@ export const mockWorldforge = {
   getServicesStatus: vi.fn().mockResolvedValue({ claude: true, replicate: true, mockImages: true }),
   connectToUE5: vi.fn(),
   sendToUE5: vi.fn(),
+  onWorldDelta: vi.fn(() => () => {}),
   platform: 'darwin',
 }
 